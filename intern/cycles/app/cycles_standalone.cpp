@@ -22,6 +22,7 @@
 #include "render/integrator.h"
 #include "render/scene.h"
 #include "render/session.h"
+#include "render/stats.h"
 
 #include "util/util_args.h"
 #include "util/util_foreach.h"
@@ -53,6 +54,8 @@ struct Options {
   SessionParams session_params;
   bool quiet;
   bool show_help, interactive, pause;
+  bool benchmark;
+  double load_time;
   string output_path;
 } options;
 
@@ -129,7 +132,10 @@ static void scene_init()
   options.scene = new Scene(options.scene_params, options.session->device);
 
   /* Read XML */
-  xml_read_file(options.scene, options.filepath.c_str());
+  {
+    scoped_timer timer(&options.load_time);
+    xml_read_file(options.scene, options.filepath.c_str());
+  }
 
   /* Camera width/height override? */
   if (!(options.width == 0 || options.height == 0)) {
@@ -161,10 +167,56 @@ static void session_init()
   scene_init();
   options.session->scene = options.scene;
 
+  if (options.benchmark) {
+    options.scene->enable_update_stats();
+  }
+
   options.session->reset(session_buffer_params(), options.session_params.samples);
   options.session->start();
 }
 
+static void benchmark_print_times(const char *category, const UpdateTimeStats &stats)
+{
+  foreach (const NamedTimeEntry &entry, stats.times.entries) {
+    printf("%s\t%s\t%f\n", category, entry.name.c_str(), entry.time);
+  }
+}
+
+/* Tab separated category, name and value per line, for tracking performance across versions. */
+static void benchmark_print()
+{
+  Session *session = options.session;
+  Scene *scene = session->scene;
+
+  double total_time, render_time;
+  session->progress.get_time(total_time, render_time);
+  const int samples = options.session_params.samples;
+  const double pixel_samples = (double)options.width * options.height * samples;
+
+  printf("\n");
+  printf("load\txml_read_file\t%f\n", options.load_time);
+
+  const SceneUpdateStats *stats = scene->update_stats;
+  if (stats) {
+    benchmark_print_times("scene", stats->scene);
+    benchmark_print_times("geometry", stats->geometry);
+    benchmark_print_times("bvh", stats->bvh);
+    benchmark_print_times("image", stats->image);
+    benchmark_print_times("light", stats->light);
+    benchmark_print_times("object", stats->object);
+    benchmark_print_times("svm", stats->svm);
+    benchmark_print_times("osl", stats->osl);
+  }
+
+  printf("render\ttotal_time\t%f\n", total_time);
+  printf("render\trender_time\t%f\n", render_time);
+  printf("render\tsamples\t%d\n", samples);
+  if (render_time > 0.0) {
+    printf("render\tsamples_per_second\t%f\n", samples / render_time);
+    printf("render\tpixel_samples_per_second\t%f\n", pixel_samples / render_time);
+  }
+}
+
 static void session_exit()
 {
   if (options.session) {
@@ -370,6 +422,8 @@ static void options_parse(int argc, const char **argv)
   options.filepath = "";
   options.session = NULL;
   options.quiet = false;
+  options.benchmark = false;
+  options.load_time = 0.0;
 
   /* device names */
   string device_names = "";
@@ -411,6 +465,9 @@ static void options_parse(int argc, const char **argv)
              "--quiet",
              &options.quiet,
              "In background mode, don't print progress messages",
+             "--benchmark",
+             &options.benchmark,
+             "In background mode, print a breakdown of load, update and render times",
              "--samples %d",
              &options.session_params.samples,
              "Number of samples to render",
@@ -550,6 +607,9 @@ int main(int argc, const char **argv)
 #endif
     session_init();
     options.session->wait();
+    if (options.benchmark) {
+      benchmark_print();
+    }
     session_exit();
 #ifdef WITH_CYCLES_STANDALONE_GUI
   }
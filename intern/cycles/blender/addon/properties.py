@@ -397,6 +397,12 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         min=0.0, max=1.0,
         default=0.01,
     )
+    use_light_tree: BoolProperty(
+        name="Light Tree",
+        description="Sample mesh lights using a tree that takes the distance and orientation of the emitters "
+        "into account, instead of only their area (slower to build, but less noise in scenes with many mesh lights)",
+        default=False,
+    )
 
     use_adaptive_sampling: BoolProperty(
         name="Use Adaptive Sampling",
@@ -693,6 +699,12 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         default=0,
         min=0, max=16,
     )
+    debug_bvh_curve_leaf_size: IntProperty(
+        name="Hair Leaf Size",
+        description="Maximum number of hair segments in a BVH leaf, higher values use less memory in cost of render time",
+        default=1,
+        min=1, max=8,
+    )
     tile_order: EnumProperty(
         name="Tile Order",
         description="Tile order for rendering",
@@ -800,6 +812,15 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         items=enum_texture_limit
     )
 
+    texture_cache_size: IntProperty(
+        name="Texture Cache Size",
+        description="Maximum memory used by image textures in megabytes, 0 for no limit. "
+        "With Open Shading Language, file textures are loaded as tiles on demand within this size. "
+        "Otherwise the largest images are scaled down until all images fit",
+        min=0, max=1048576,
+        default=0,
+    )
+
     ao_bounces: IntProperty(
         name="AO Bounces",
         default=0,
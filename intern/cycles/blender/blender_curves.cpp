@@ -844,6 +844,11 @@ void BlenderSync::sync_hair(BL::Depsgraph b_depsgraph, BL::Object b_ob, Hair *ha
     }
   }
 
+  /* Moving keys only needs the BVH to be refit, changing the number of curve segments needs a
+   * rebuild. */
+  const bool num_keys_changed = (hair->get_curve_keys().size() !=
+                                 new_hair.get_curve_keys().size());
+
   /* update original sockets */
 
   for (const SocketType &socket : new_hair.type->inputs) {
@@ -862,9 +867,7 @@ void BlenderSync::sync_hair(BL::Depsgraph b_depsgraph, BL::Object b_ob, Hair *ha
 
   /* tag update */
 
-  /* Compares curve_keys rather than strands in order to handle quick hair
-   * adjustments in dynamic BVH - other methods could probably do this better. */
-  const bool rebuild = (hair->curve_keys_is_modified() || hair->curve_radius_is_modified());
+  const bool rebuild = num_keys_changed || hair->curve_first_key_is_modified();
 
   hair->tag_update(scene, rebuild);
 }
@@ -225,7 +225,6 @@ void BlenderSession::reset_session(BL::BlendData &b_data, BL::Depsgraph &b_depsg
   }
 
   session->progress.reset();
-  scene->reset();
 
   session->tile_manager.set_tile_order(session_params.tile_order);
 
@@ -234,15 +233,25 @@ void BlenderSession::reset_session(BL::BlendData &b_data, BL::Depsgraph &b_depsg
    */
   session->stats.mem_peak = session->stats.mem_used;
 
-  /* There is no single depsgraph to use for the entire render.
-   * See note on create_session().
-   */
-  /* sync object should be re-created */
-  delete sync;
-  sync = new BlenderSync(b_engine, b_data, b_scene, scene, !background, session->progress);
-
   BL::SpaceView3D b_null_space_view3d(PointerRNA_NULL);
   BL::RegionView3D b_null_region_view3d(PointerRNA_NULL);
+
+  if (!is_new_session && b_engine.is_depsgraph_reused()) {
+    /* The depsgraph is kept from the previous frame of an animation, so the synced scene is
+     * still valid and only the data tagged for update since has to be synced again. */
+    sync->sync_recalc(b_depsgraph, b_null_space_view3d);
+  }
+  else {
+    scene->reset();
+
+    /* There is no single depsgraph to use for the entire render.
+     * See note on create_session().
+     */
+    /* sync object should be re-created */
+    delete sync;
+    sync = new BlenderSync(b_engine, b_data, b_scene, scene, !background, session->progress);
+  }
+
   BufferParams buffer_params = BlenderSync::get_buffer_params(b_render,
                                                               b_null_space_view3d,
                                                               b_null_region_view3d,
@@ -41,6 +41,8 @@
 #include "util/util_opengl.h"
 #include "util/util_openimagedenoise.h"
 
+#include "BLI_timeit.hh"
+
 CCL_NAMESPACE_BEGIN
 
 static const char *cryptomatte_prefix = "Crypto";
@@ -226,22 +228,30 @@ void BlenderSync::sync_data(BL::RenderSettings &b_render,
                             void **python_thread_state)
 {
   scoped_timer timer;
+  ::blender::timeit::ScopedProfileZone profile_zone("Cycles Sync");
 
   BL::ViewLayer b_view_layer = b_depsgraph.view_layer_eval();
 
   sync_view_layer(b_v3d, b_view_layer);
   sync_integrator();
   sync_film(b_v3d);
-  sync_shaders(b_depsgraph, b_v3d);
+  {
+    ::blender::timeit::ScopedProfileZone profile_zone_shaders("Cycles Sync Shaders");
+    sync_shaders(b_depsgraph, b_v3d);
+  }
   sync_images();
 
   geometry_synced.clear(); /* use for objects and motion sync */
 
   if (scene->need_motion() == Scene::MOTION_PASS || scene->need_motion() == Scene::MOTION_NONE ||
       scene->camera->get_motion_position() == Camera::MOTION_POSITION_CENTER) {
+    ::blender::timeit::ScopedProfileZone profile_zone_objects("Cycles Sync Objects");
     sync_objects(b_depsgraph, b_v3d);
   }
-  sync_motion(b_render, b_depsgraph, b_v3d, b_override, width, height, python_thread_state);
+  {
+    ::blender::timeit::ScopedProfileZone profile_zone_motion("Cycles Sync Motion");
+    sync_motion(b_render, b_depsgraph, b_v3d, b_override, width, height, python_thread_state);
+  }
 
   geometry_synced.clear();
 
@@ -316,6 +326,7 @@ void BlenderSync::sync_integrator()
   integrator->set_sample_all_lights_direct(get_boolean(cscene, "sample_all_lights_direct"));
   integrator->set_sample_all_lights_indirect(get_boolean(cscene, "sample_all_lights_indirect"));
   integrator->set_light_sampling_threshold(get_float(cscene, "light_sampling_threshold"));
+  integrator->set_use_light_tree(get_boolean(cscene, "use_light_tree"));
 
   SamplingPattern sampling_pattern = (SamplingPattern)get_enum(
       cscene, "sampling_pattern", SAMPLING_NUM_PATTERNS, SAMPLING_PATTERN_SOBOL);
@@ -772,7 +783,15 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene, bool background)
   else if (shadingsystem == 1)
     params.shadingsystem = SHADINGSYSTEM_OSL;
 
-  if (background || DebugFlags().viewport_static_bvh)
+  if (background && params.shadingsystem != SHADINGSYSTEM_OSL)
+    params.persistent_data = r.use_persistent_data();
+  else
+    params.persistent_data = false;
+
+  /* With persistent data the scene is kept between frames. Use a BVH with an instance per object
+   * then, so that moving objects only rebuilds the top level while the geometry BVHs are reused,
+   * instead of rebuilding the whole flattened BVH every frame. */
+  if ((background && !params.persistent_data) || DebugFlags().viewport_static_bvh)
     params.bvh_type = SceneParams::BVH_STATIC;
   else
     params.bvh_type = SceneParams::BVH_DYNAMIC;
@@ -780,17 +799,13 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene, bool background)
   params.use_bvh_spatial_split = RNA_boolean_get(&cscene, "debug_use_spatial_splits");
   params.use_bvh_unaligned_nodes = RNA_boolean_get(&cscene, "debug_use_hair_bvh");
   params.num_bvh_time_steps = RNA_int_get(&cscene, "debug_bvh_time_steps");
+  params.bvh_curve_leaf_size = RNA_int_get(&cscene, "debug_bvh_curve_leaf_size");
 
   PointerRNA csscene = RNA_pointer_get(&b_scene.ptr, "cycles_curves");
   params.hair_subdivisions = get_int(csscene, "subdivisions");
   params.hair_shape = (CurveShapeType)get_enum(
       csscene, "shape", CURVE_NUM_SHAPE_TYPES, CURVE_THICK);
 
-  if (background && params.shadingsystem != SHADINGSYSTEM_OSL)
-    params.persistent_data = r.use_persistent_data();
-  else
-    params.persistent_data = false;
-
   int texture_limit;
   if (background) {
     texture_limit = RNA_enum_get(&cscene, "texture_limit_render");
@@ -804,6 +819,7 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene, bool background)
   else {
     params.texture_limit = 0;
   }
+  params.texture_cache_size = get_int(cscene, "texture_cache_size");
 
   params.bvh_layout = DebugFlags().cpu.bvh_layout;
 
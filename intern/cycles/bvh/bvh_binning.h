@@ -70,6 +70,21 @@ class BVHObjectBinning : public BVHRange {
 
   enum { MAX_BINS = 32 };
   enum { LOG_BLOCK_SIZE = 2 };
+  /* Number of references per block when binning large ranges in parallel. */
+  enum { PARALLEL_BINNING_SIZE = 65536 };
+
+  /* Bins of a block of references. */
+  struct BVHObjectBins {
+    BoundBox bounds[MAX_BINS][4];
+    int4 count[MAX_BINS];
+  };
+
+  /* Maps the references in [begin, end) to bins, overwriting the given bins. */
+  void bin_references(const BVHReference *prims,
+                      size_t begin,
+                      size_t end,
+                      BoundBox bin_bounds[][4],
+                      int4 bin_count[]) const;
 
   /* computes the bin numbers for each dimension for a box. */
   __forceinline int4 get_bin(const BoundBox &box) const
@@ -29,6 +29,7 @@
 #include "render/scene.h"
 
 #include "util/util_algorithm.h"
+#include "util/util_atomic.h"
 #include "util/util_foreach.h"
 #include "util/util_logging.h"
 #include "util/util_progress.h"
@@ -59,6 +60,8 @@ BVHBuild::BVHBuild(const vector<Object *> &objects_,
       unaligned_heuristic(objects_)
 {
   spatial_min_overlap = 0.0f;
+  spatial_max_references = 0;
+  spatial_num_references = 0;
 }
 
 BVHBuild::~BVHBuild()
@@ -388,6 +391,9 @@ BVHNode *BVHBuild::run()
   }
 
   spatial_min_overlap = root.bounds().safe_area() * params.spatial_split_alpha;
+  spatial_max_references = references.size() +
+                           (size_t)(references.size() * max(params.spatial_split_budget, 0.0f));
+  spatial_num_references = references.size();
   spatial_free_index = 0;
 
   need_prim_time = params.num_motion_curve_steps > 0 || params.num_motion_triangle_steps > 0;
@@ -568,6 +574,13 @@ bool BVHBuild::range_within_max_leaf_size(const BVHRange &range,
          (num_motion_curves <= params.max_motion_curve_leaf_size);
 }
 
+bool BVHBuild::spatial_split_within_budget(const BVHRange &range) const
+{
+  /* A split duplicates at most all references of the range. Other threads may split at the same
+   * time, so the budget can be exceeded slightly, but it stays bounded. */
+  return spatial_num_references + range.size() <= spatial_max_references;
+}
+
 /* multithreaded binning builder */
 BVHNode *BVHBuild::build_node(const BVHObjectBinning &range, int level)
 {
@@ -718,7 +731,11 @@ BVHNode *BVHBuild::build_node(const BVHRange &range,
     split.split(this, left, right, range);
   }
 
-  progress_total += left.size() + right.size() - range.size();
+  const size_t num_new_references = left.size() + right.size() - range.size();
+  if (num_new_references) {
+    atomic_add_and_fetch_z(&spatial_num_references, num_new_references);
+  }
+  progress_total += num_new_references;
 
   BoundBox bounds;
   if (do_unalinged_split) {
@@ -738,6 +755,10 @@ BVHNode *BVHBuild::build_node(const BVHRange &range,
                                           references.begin() + right.end());
     right.set_start(0);
 
+    /* Nothing past the left range is used anymore, drop it so references added by splits of
+     * the left node are appended instead of moving the stale ones. */
+    references.resize(left.end());
+
     BVHNode *leftnode = build_node(left, references, level + 1, storage);
 
     /* Build right node. */
@@ -749,12 +770,15 @@ BVHNode *BVHBuild::build_node(const BVHRange &range,
     /* Threaded build. */
     inner = new InnerNode(bounds);
 
-    vector<BVHReference> left_references(references.begin() + left.start(),
-                                         references.begin() + left.end());
     vector<BVHReference> right_references(references.begin() + right.start(),
                                           references.begin() + right.end());
     right.set_start(0);
 
+    /* The left node takes over the references of this node, so only the right ones are copied
+     * and the memory of the full range is released as soon as the left node is done. */
+    references.resize(left.end());
+    vector<BVHReference> left_references = std::move(references);
+
     /* Create tasks for left and right nodes, using copy for most arguments and
      * move for reference to avoid memory copies. */
     task_pool.push([=, refs = std::move(left_references)]() mutable {
@@ -84,6 +84,9 @@ class BVHBuild {
   bool range_within_max_leaf_size(const BVHRange &range,
                                   const vector<BVHReference> &references) const;
 
+  /* Check whether splitting the range could stay within the spatial split budget. */
+  bool spatial_split_within_budget(const BVHRange &range) const;
+
   /* Threads. */
   enum { THREAD_TASK_SIZE = 4096 };
   void thread_build_node(InnerNode *node, int child, const BVHObjectBinning &range, int level);
@@ -126,6 +129,8 @@ class BVHBuild {
 
   /* Spatial splitting. */
   float spatial_min_overlap;
+  size_t spatial_max_references;
+  size_t spatial_num_references;
   enumerable_thread_specific<BVHSpatialStorage> spatial_storage;
   size_t spatial_free_index;
   thread_spin_lock spatial_spin_lock;
@@ -48,6 +48,10 @@ class BVHParams {
   /* spatial split area threshold */
   bool use_spatial_split;
   float spatial_split_alpha;
+  /* Maximum number of references spatial splits are allowed to add, relative to the number of
+   * primitives. Bounds the memory usage and build time for scenes with many large overlapping
+   * primitives. */
+  float spatial_split_budget;
 
   /* Unaligned nodes creation threshold */
   float unaligned_split_threshold;
@@ -98,6 +102,7 @@ class BVHParams {
   {
     use_spatial_split = true;
     spatial_split_alpha = 1e-5f;
+    spatial_split_budget = 1.0f;
 
     unaligned_split_threshold = 0.7f;
 
@@ -1947,6 +1947,12 @@ void CUDADevice::render(DeviceTask &task, RenderTile &rtile, device_vector<WorkT
     rtile.sample = sample + wtile->num_samples;
     task.update_progress(&rtile, rtile.w * rtile.h * wtile->num_samples);
 
+    if (rtile.stealing_state == RenderTile::CAN_BE_STOLEN && rtile.sample < end_sample &&
+        task.get_tile_stolen(rtile)) {
+      rtile.stealing_state = RenderTile::WAS_STOLEN;
+      break;
+    }
+
     if (task.get_cancel()) {
       if (task.need_finish_queue == false)
         break;
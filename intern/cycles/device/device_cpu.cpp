@@ -932,7 +932,7 @@ class CPUDevice : public Device {
           break;
       }
 
-      if (tile.stealing_state == RenderTile::CAN_BE_STOLEN && task.get_tile_stolen()) {
+      if (tile.stealing_state == RenderTile::CAN_BE_STOLEN && task.get_tile_stolen(tile)) {
         tile.stealing_state = RenderTile::WAS_STOLEN;
         break;
       }
@@ -1255,14 +1255,17 @@ class CPUDevice : public Device {
 
     /* OpenImageDenoise: we can only denoise with one thread at a time, so to
      * avoid waiting with mutex locks in the denoiser, we let only a single
-     * thread acquire denoising tiles. */
+     * thread acquire denoising tiles. The other threads keep path tracing, so
+     * finished tiles are denoised while the rest of the frame renders. */
     uint tile_types = task.tile_types;
     bool hold_denoise_lock = false;
     if ((tile_types & RenderTile::DENOISE) && task.denoising.type == DENOISER_OPENIMAGEDENOISE) {
-      if (!oidn_task_lock.try_lock()) {
-        tile_types &= ~RenderTile::DENOISE;
+      if (oidn_task_lock.try_lock()) {
         hold_denoise_lock = true;
       }
+      else {
+        tile_types &= ~RenderTile::DENOISE;
+      }
     }
 
     RenderTile tile;
@@ -14,12 +14,15 @@
  * limitations under the License.
  */
 
+#include <limits.h>
+
 #include "device/device_network.h"
 #include "device/device.h"
 #include "device/device_intern.h"
 
 #include "util/util_foreach.h"
 #include "util/util_logging.h"
+#include "util/util_murmurhash.h"
 
 #if defined(WITH_NETWORK)
 
@@ -50,6 +53,12 @@ class NetworkDevice : public Device {
 
   thread_mutex rpc_lock;
 
+  /* Size and content hash of the read-only buffers as last sent to the server. The server keeps
+   * its own copy of every buffer, so scene data that did not change between device updates does
+   * not have to be sent over the network again. */
+  typedef map<device_ptr, pair<size_t, uint32_t>> HashMap;
+  HashMap mem_hash;
+
   virtual bool show_samples() const
   {
     return false;
@@ -111,6 +120,24 @@ class NetworkDevice : public Device {
   {
     thread_scoped_lock lock(rpc_lock);
 
+    /* Only buffers the kernels never write to can be skipped, the contents of others may have
+     * changed on the server since they were sent. */
+    const size_t data_size = mem.memory_size();
+    if (mem.device_pointer && (mem.type == MEM_READ_ONLY || mem.type == MEM_TEXTURE) &&
+        data_size <= INT_MAX) {
+      const pair<size_t, uint32_t> hash(data_size,
+                                        util_murmur_hash3(mem.host_pointer, (int)data_size, 0));
+      pair<HashMap::iterator, bool> hash_ins = mem_hash.insert(
+          HashMap::value_type(mem.device_pointer, hash));
+
+      if (!hash_ins.second) {
+        if (hash_ins.first->second == hash) {
+          return;
+        }
+        hash_ins.first->second = hash;
+      }
+    }
+
     RPCSend snd(socket, &error_func, "mem_copy_to");
 
     snd.add(mem);
@@ -141,6 +168,9 @@ class NetworkDevice : public Device {
   {
     thread_scoped_lock lock(rpc_lock);
 
+    /* The server copy no longer matches the host data. */
+    mem_hash.erase(mem.device_pointer);
+
     RPCSend snd(socket, &error_func, "mem_zero");
 
     snd.add(mem);
@@ -157,6 +187,7 @@ class NetworkDevice : public Device {
       snd.add(mem);
       snd.write();
 
+      mem_hash.erase(mem.device_pointer);
       mem.device_pointer = 0;
     }
   }
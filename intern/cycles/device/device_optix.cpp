@@ -762,6 +762,13 @@ class OptiXDevice : public CUDADevice {
 
       if (task.get_cancel() && !task.need_finish_queue)
         return;  // Cancel rendering
+
+      // Release the tile to a faster device waiting for work
+      if (rtile.stealing_state == RenderTile::CAN_BE_STOLEN && rtile.sample < end_sample &&
+          task.get_tile_stolen(rtile)) {
+        rtile.stealing_state = RenderTile::WAS_STOLEN;
+        break;
+      }
     }
 
     // Finalize adaptive sampling
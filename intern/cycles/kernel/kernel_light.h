@@ -15,6 +15,7 @@
  */
 
 #include "kernel_light_background.h"
+#include "kernel_light_tree.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -328,12 +329,30 @@ ccl_device_inline bool triangle_world_space_vertices(
   return has_motion;
 }
 
-ccl_device_inline float triangle_light_pdf_area(KernelGlobals *kg,
-                                                const float3 Ng,
+/* Probability of picking the triangle from the light distribution, divided by its area. The area
+ * is the one the distribution was computed from, so the center frame area for motion blur. */
+ccl_device_inline float triangle_light_distribution_pdf(
+    KernelGlobals *kg, const float3 P, int object, int prim, float area)
+{
+  if (kernel_data.integrator.use_light_tree) {
+    if (UNLIKELY(area == 0.0f)) {
+      return 0.0f;
+    }
+    const int index = light_tree_triangle_index(kg, object, prim);
+    if (index < 0) {
+      return 0.0f;
+    }
+    return kernel_data.integrator.light_tree_weight * light_tree_pdf(kg, P, index) / area;
+  }
+
+  return kernel_data.integrator.pdf_triangles;
+}
+
+ccl_device_inline float triangle_light_pdf_area(const float3 Ng,
                                                 const float3 I,
-                                                float t)
+                                                float t,
+                                                float pdf)
 {
-  float pdf = kernel_data.integrator.pdf_triangles;
   float cos_pi = fabsf(dot(Ng, I));
 
   if (cos_pi == 0.0f)
@@ -358,10 +377,21 @@ ccl_device_forceinline float triangle_light_pdf(KernelGlobals *kg, ShaderData *s
   const float3 N = cross(e0, e1);
   const float distance_to_plane = fabsf(dot(N, sd->I * t)) / dot(N, N);
 
+  /* sd contains the point on the light source
+   * calculate Px, the point that we're shading */
+  const float3 Px = sd->P + sd->I * t;
+
+  float area_pre = 0.5f * len(N);
+  if (has_motion) {
+    /* get the center frame vertices, this is what the PDF was calculated from */
+    float3 V_pre[3];
+    triangle_world_space_vertices(kg, sd->object, sd->prim, -1.0f, V_pre);
+    area_pre = triangle_area(V_pre[0], V_pre[1], V_pre[2]);
+  }
+  const float pdf_triangle = triangle_light_distribution_pdf(
+      kg, Px, sd->object, sd->prim, area_pre);
+
   if (longest_edge_squared > distance_to_plane * distance_to_plane) {
-    /* sd contains the point on the light source
-     * calculate Px, the point that we're shading */
-    const float3 Px = sd->P + sd->I * t;
     const float3 v0_p = V[0] - Px;
     const float3 v1_p = V[1] - Px;
     const float3 v2_p = V[2] - Px;
@@ -375,26 +405,17 @@ ccl_device_forceinline float triangle_light_pdf(KernelGlobals *kg, ShaderData *s
     const float gamma = fast_acosf(dot(u02, u12));
     const float solid_angle = alpha + beta + gamma - M_PI_F;
 
-    /* pdf_triangles is calculated over triangle area, but we're not sampling over its area */
+    /* pdf_triangle is calculated over triangle area, but we're not sampling over its area */
     if (UNLIKELY(solid_angle == 0.0f)) {
       return 0.0f;
     }
     else {
-      float area = 1.0f;
-      if (has_motion) {
-        /* get the center frame vertices, this is what the PDF was calculated from */
-        triangle_world_space_vertices(kg, sd->object, sd->prim, -1.0f, V);
-        area = triangle_area(V[0], V[1], V[2]);
-      }
-      else {
-        area = 0.5f * len(N);
-      }
-      const float pdf = area * kernel_data.integrator.pdf_triangles;
+      const float pdf = area_pre * pdf_triangle;
       return pdf / solid_angle;
     }
   }
   else {
-    float pdf = triangle_light_pdf_area(kg, sd->Ng, sd->I, t);
+    float pdf = triangle_light_pdf_area(sd->Ng, sd->I, t, pdf_triangle);
     if (has_motion) {
       const float area = 0.5f * len(N);
       if (UNLIKELY(area == 0.0f)) {
@@ -402,9 +423,7 @@ ccl_device_forceinline float triangle_light_pdf(KernelGlobals *kg, ShaderData *s
       }
       /* scale the PDF.
        * area = the area the sample was taken from
-       * area_pre = the are from which pdf_triangles was calculated from */
-      triangle_world_space_vertices(kg, sd->object, sd->prim, -1.0f, V);
-      const float area_pre = triangle_area(V[0], V[1], V[2]);
+       * area_pre = the are from which pdf_triangle was calculated from */
       pdf = pdf * area_pre / area;
     }
     return pdf;
@@ -418,7 +437,8 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals *kg,
                                                   float randv,
                                                   float time,
                                                   LightSample *ls,
-                                                  const float3 P)
+                                                  const float3 P,
+                                                  const float pdf_triangle)
 {
   /* A naive heuristic to decide between costly solid angle sampling
    * and simple area sampling, comparing the distance to the triangle plane
@@ -531,7 +551,7 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals *kg,
 
     ls->P = P + ls->D * ls->t;
 
-    /* pdf_triangles is calculated over triangle area, but we're sampling over solid angle */
+    /* pdf_triangle is calculated over triangle area, but we're sampling over solid angle */
     if (UNLIKELY(solid_angle == 0.0f)) {
       ls->pdf = 0.0f;
       return;
@@ -542,7 +562,7 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals *kg,
         triangle_world_space_vertices(kg, object, prim, -1.0f, V);
         area = triangle_area(V[0], V[1], V[2]);
       }
-      const float pdf = area * kernel_data.integrator.pdf_triangles;
+      const float pdf = area * pdf_triangle;
       ls->pdf = pdf / solid_angle;
     }
   }
@@ -564,11 +584,11 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals *kg,
     ls->P = u * V[0] + v * V[1] + t * V[2];
     /* compute incoming direction, distance and pdf */
     ls->D = normalize_len(ls->P - P, &ls->t);
-    ls->pdf = triangle_light_pdf_area(kg, ls->Ng, -ls->D, ls->t);
+    ls->pdf = triangle_light_pdf_area(ls->Ng, -ls->D, ls->t, pdf_triangle);
     if (has_motion && area != 0.0f) {
       /* scale the PDF.
        * area = the area the sample was taken from
-       * area_pre = the are from which pdf_triangles was calculated from */
+       * area_pre = the are from which pdf_triangle was calculated from */
       triangle_world_space_vertices(kg, object, prim, -1.0f, V);
       const float area_pre = triangle_area(V[0], V[1], V[2]);
       ls->pdf = ls->pdf * area_pre / area;
@@ -634,7 +654,22 @@ ccl_device_noinline bool light_sample(KernelGlobals *kg,
 {
   if (lamp < 0) {
     /* sample index */
-    int index = light_distribution_sample(kg, &randu);
+    int index;
+    float pdf_tree = 0.0f;
+    const float light_tree_weight = kernel_data.integrator.light_tree_weight;
+
+    if (kernel_data.integrator.use_light_tree && randu < light_tree_weight) {
+      /* The light tree picks the triangles, with the same total probability as the
+       * distribution so the lamps are still picked uniformly. */
+      randu = randu / light_tree_weight;
+      index = light_tree_sample(kg, P, &randu, &pdf_tree);
+      if (index < 0) {
+        return false;
+      }
+    }
+    else {
+      index = light_distribution_sample(kg, &randu);
+    }
 
     /* fetch light data */
     const ccl_global KernelLightDistribution *kdistribution = &kernel_tex_fetch(
@@ -645,7 +680,23 @@ ccl_device_noinline bool light_sample(KernelGlobals *kg,
       int object = kdistribution->mesh_light.object_id;
       int shader_flag = kdistribution->mesh_light.shader_flag;
 
-      triangle_light_sample(kg, prim, object, randu, randv, time, ls, P);
+      float pdf_triangle = kernel_data.integrator.pdf_triangles;
+      if (kernel_data.integrator.use_light_tree) {
+        if (pdf_tree == 0.0f) {
+          /* Rounding put the random number on a triangle of the light distribution. */
+          return false;
+        }
+        /* Probability per area, using the area the tree was built from. */
+        float3 V[3];
+        triangle_world_space_vertices(kg, object, prim, -1.0f, V);
+        const float area = triangle_area(V[0], V[1], V[2]);
+        if (UNLIKELY(area == 0.0f)) {
+          return false;
+        }
+        pdf_triangle = light_tree_weight * pdf_tree / area;
+      }
+
+      triangle_light_sample(kg, prim, object, randu, randv, time, ls, P, pdf_triangle);
       ls->shader |= shader_flag;
       return (ls->pdf > 0.0f);
     }
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+CCL_NAMESPACE_BEGIN
+
+/* Light Tree
+ *
+ * Picks one of the emissive triangles by walking down a BVH over them, choosing children
+ * proportional to an estimate of their contribution to the shading point. The estimate only has
+ * to be conservative, it must not be zero for a child that can contribute. See "Importance
+ * Sampling of Many Lights with Adaptive Tree Splitting" by Conty Estevez and Kulla. */
+
+ccl_device float light_tree_node_importance(KernelGlobals *kg, const float3 P, int node_index)
+{
+  const ccl_global KernelLightTreeNode *knode = &kernel_tex_fetch(__light_tree_nodes, node_index);
+  if (knode->energy == 0.0f) {
+    return 0.0f;
+  }
+
+  const float3 bbox_min = make_float3(knode->bbox_min[0], knode->bbox_min[1], knode->bbox_min[2]);
+  const float3 bbox_max = make_float3(knode->bbox_max[0], knode->bbox_max[1], knode->bbox_max[2]);
+  const float3 centroid = 0.5f * (bbox_min + bbox_max);
+  const float radius_squared = 0.25f * len_squared(bbox_max - bbox_min);
+
+  const float3 D = P - centroid;
+  const float distance_squared = len_squared(D);
+  if (distance_squared <= radius_squared) {
+    /* Inside the bounding sphere, any orientation is possible. */
+    return knode->energy / max(radius_squared, 1e-8f);
+  }
+
+  /* Angle between the direction to the shading point and the normals, up to their sign. */
+  const float3 axis = make_float3(knode->axis[0], knode->axis[1], knode->axis[2]);
+  const float distance = sqrtf(distance_squared);
+  const float theta = safe_acosf(fabsf(dot(axis, D)) / distance);
+  /* Angle subtended by the bounding sphere. */
+  const float theta_u = safe_asinf(sqrtf(radius_squared) / distance);
+  const float theta_i = max(theta - knode->theta_o - theta_u, 0.0f);
+
+  return knode->energy * max(cosf(theta_i), 0.0f) / distance_squared;
+}
+
+/* Returns the light distribution index of the picked triangle, or -1 when no triangle contributes
+ * to the shading point. The random number is rescaled for reuse. */
+ccl_device int light_tree_sample(KernelGlobals *kg, const float3 P, float *randu, float *pdf)
+{
+  int node_index = 0;
+  float r = *randu;
+  *pdf = 1.0f;
+
+  while (true) {
+    const int child_index = kernel_tex_fetch(__light_tree_nodes, node_index).child_index;
+    if (child_index < 0) {
+      *randu = r;
+      return ~child_index;
+    }
+
+    const int left = node_index + 1;
+    const int right = child_index;
+    const float importance_left = light_tree_node_importance(kg, P, left);
+    const float importance_right = light_tree_node_importance(kg, P, right);
+    const float importance = importance_left + importance_right;
+    if (importance == 0.0f) {
+      *pdf = 0.0f;
+      return -1;
+    }
+
+    const float pdf_left = importance_left / importance;
+    if (r < pdf_left) {
+      node_index = left;
+      r = r / pdf_left;
+      *pdf *= pdf_left;
+    }
+    else {
+      const float pdf_right = importance_right / importance;
+      node_index = right;
+      r = min((r - pdf_left) / pdf_right, 1.0f - FLT_EPSILON);
+      *pdf *= pdf_right;
+    }
+  }
+}
+
+/* Probability of light_tree_sample picking the triangle with the given light distribution index,
+ * computed by walking up from its leaf. */
+ccl_device float light_tree_pdf(KernelGlobals *kg, const float3 P, int index)
+{
+  int node_index = (int)kernel_tex_fetch(__light_tree_leaf, index);
+  if (node_index < 0) {
+    return 0.0f;
+  }
+
+  float pdf = 1.0f;
+  while (node_index != 0) {
+    const int parent_index = kernel_tex_fetch(__light_tree_nodes, node_index).parent_index;
+    const int left = parent_index + 1;
+    const int right = kernel_tex_fetch(__light_tree_nodes, parent_index).child_index;
+    const int sibling = (node_index == left) ? right : left;
+
+    const float importance_node = light_tree_node_importance(kg, P, node_index);
+    const float importance_sibling = light_tree_node_importance(kg, P, sibling);
+    const float importance = importance_node + importance_sibling;
+    if (importance == 0.0f) {
+      return 0.0f;
+    }
+
+    pdf *= importance_node / importance;
+    node_index = parent_index;
+  }
+
+  return pdf;
+}
+
+/* Light distribution index of a triangle, or -1 if it is not emissive. */
+ccl_device int light_tree_triangle_index(KernelGlobals *kg, int object, int prim)
+{
+  int first = (int)kernel_tex_fetch(__light_tree_object_offset, object);
+  int last = (int)kernel_tex_fetch(__light_tree_object_offset, object + 1);
+
+  /* The triangles of an object are ordered by primitive. */
+  while (first < last) {
+    const int middle = (first + last) >> 1;
+    const int middle_prim = kernel_tex_fetch(__light_distribution, middle).prim;
+    if (middle_prim == prim) {
+      return middle;
+    }
+    else if (middle_prim < prim) {
+      first = middle + 1;
+    }
+    else {
+      last = middle;
+    }
+  }
+
+  return -1;
+}
+
+CCL_NAMESPACE_END
@@ -1389,7 +1389,9 @@ typedef struct KernelIntegrator {
 
   int max_closures;
 
-  int pad1, pad2;
+  /* light tree */
+  int use_light_tree;
+  float light_tree_weight;
 } KernelIntegrator;
 static_assert_align(KernelIntegrator, 16);
 
@@ -1548,6 +1550,22 @@ typedef struct KernelLightDistribution {
 } KernelLightDistribution;
 static_assert_align(KernelLightDistribution, 16);
 
+/* Node of the light tree, a BVH over the emissive triangles. Interior nodes store their left child
+ * right after themselves, leaves store the complement of the light distribution index. */
+typedef struct KernelLightTreeNode {
+  float bbox_min[3];
+  float energy;
+  float bbox_max[3];
+  /* Half angle of the cone bounding the emitter normals. Triangles emit from both sides, so the
+   * cone bounds the normals up to their sign. */
+  float theta_o;
+  float axis[3];
+  int child_index;
+  int parent_index;
+  int pad1, pad2, pad3;
+} KernelLightTreeNode;
+static_assert_align(KernelLightTreeNode, 16);
+
 typedef struct KernelParticle {
   int index;
   float age;
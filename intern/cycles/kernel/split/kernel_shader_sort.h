@@ -16,6 +16,43 @@
 
 CCL_NAMESPACE_BEGIN
 
+#ifdef __KERNEL_CPU__
+/* Stable bottom-up merge sort of the block indices by shader. On the CPU a single thread handles a
+ * whole block, so a serial sort is used instead of the bitonic network. */
+ccl_device void kernel_shader_sort_block_cpu(const uint *local_value, ushort *local_index)
+{
+  ushort temp_index[SHADER_SORT_BLOCK_SIZE];
+  ushort *src = local_index;
+  ushort *dst = temp_index;
+
+  for (int width = 1; width < SHADER_SORT_BLOCK_SIZE; width <<= 1) {
+    for (int begin = 0; begin < SHADER_SORT_BLOCK_SIZE; begin += 2 * width) {
+      const int middle = min(begin + width, SHADER_SORT_BLOCK_SIZE);
+      const int end = min(begin + 2 * width, SHADER_SORT_BLOCK_SIZE);
+      int i = begin, j = middle;
+      for (int k = begin; k < end; k++) {
+        if (i < middle && (j >= end || local_value[src[i]] <= local_value[src[j]])) {
+          dst[k] = src[i++];
+        }
+        else {
+          dst[k] = src[j++];
+        }
+      }
+    }
+
+    ushort *swap_index = src;
+    src = dst;
+    dst = swap_index;
+  }
+
+  if (src != local_index) {
+    for (int i = 0; i < SHADER_SORT_BLOCK_SIZE; i++) {
+      local_index[i] = src[i];
+    }
+  }
+}
+#endif
+
 ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSortLocals *locals)
 {
 #ifndef __KERNEL_CUDA__
@@ -54,7 +91,6 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
   }
   ccl_barrier(CCL_LOCAL_MEM_FENCE);
 
-  /* skip sorting for cpu split kernel */
 #  ifdef __KERNEL_OPENCL__
 
   /* bitonic sort */
@@ -77,6 +113,9 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
       }
     }
   }
+#  elif defined(__KERNEL_CPU__)
+  /* Group rays by shader, so rays evaluating the same shader nodes run after each other. */
+  kernel_shader_sort_block_cpu(local_value, local_index);
 #  endif /* __KERNEL_OPENCL__ */
 
   /* copy to destination */
@@ -27,9 +27,19 @@ ccl_device void svm_node_math(KernelGlobals *kg,
   uint a_stack_offset, b_stack_offset, c_stack_offset;
   svm_unpack_node_uchar3(inputs_stack_offsets, &a_stack_offset, &b_stack_offset, &c_stack_offset);
 
-  float a = stack_load_float(stack, a_stack_offset);
-  float b = stack_load_float(stack, b_stack_offset);
-  float c = stack_load_float(stack, c_stack_offset);
+  float a, b, c;
+  if (stack_valid(a_stack_offset) && stack_valid(b_stack_offset) && stack_valid(c_stack_offset)) {
+    a = stack_load_float(stack, a_stack_offset);
+    b = stack_load_float(stack, b_stack_offset);
+    c = stack_load_float(stack, c_stack_offset);
+  }
+  else {
+    /* Unlinked inputs are stored in an extra node. */
+    uint4 defaults = read_node(kg, offset);
+    a = stack_load_float_default(stack, a_stack_offset, defaults.x);
+    b = stack_load_float_default(stack, b_stack_offset, defaults.y);
+    c = stack_load_float_default(stack, c_stack_offset, defaults.z);
+  }
   float result = svm_math((NodeMathType)type, a, b, c);
 
   stack_store_float(stack, result_stack_offset, result);
@@ -126,6 +126,8 @@ RenderTile::RenderTile()
 
   buffers = NULL;
   stealing_state = NO_STEALING;
+  device_num = 0;
+  acquire_time = 0.0;
 }
 
 /* Render Buffers */
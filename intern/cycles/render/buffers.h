@@ -149,6 +149,10 @@ class RenderTile {
   typedef enum { NO_STEALING = 0, CAN_BE_STOLEN = 1, WAS_STOLEN = 2 } StealingState;
   StealingState stealing_state;
 
+  /* Device rendering the tile and the time it got the tile, used to estimate its throughput. */
+  int device_num;
+  double acquire_time;
+
   RenderBuffers *buffers;
 
   RenderTile();
@@ -74,6 +74,12 @@ Geometry::Geometry(const NodeType *node_type, const Type type)
   attr_map_offset = 0;
   optix_prim_offset = 0;
   prim_offset = 0;
+
+  attr_float_offset = 0;
+  attr_float2_offset = 0;
+  attr_float3_offset = 0;
+  attr_uchar4_offset = 0;
+  need_update_packed = true;
 }
 
 Geometry::~Geometry()
@@ -230,6 +236,7 @@ void Geometry::compute_bvh(
                                     params->use_bvh_unaligned_nodes;
       bparams.num_motion_triangle_steps = params->num_bvh_time_steps;
       bparams.num_motion_curve_steps = params->num_bvh_time_steps;
+      bparams.max_curve_leaf_size = params->bvh_curve_leaf_size;
       bparams.bvh_type = params->bvh_type;
       bparams.curve_subdivisions = params->curve_subdivisions();
 
@@ -285,6 +292,7 @@ GeometryManager::GeometryManager()
 {
   need_update = true;
   need_flags_update = true;
+  packed_arrays_valid = false;
 }
 
 GeometryManager::~GeometryManager()
@@ -568,7 +576,8 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
                                                       Attribute *mattr,
                                                       AttributePrimitive prim,
                                                       TypeDesc &type,
-                                                      AttributeDescriptor &desc)
+                                                      AttributeDescriptor &desc,
+                                                      bool copy_data)
 {
   if (mattr) {
     /* store element and type */
@@ -592,8 +601,10 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
       offset = attr_uchar4_offset;
 
       assert(attr_uchar4.size() >= offset + size);
-      for (size_t k = 0; k < size; k++) {
-        attr_uchar4[offset + k] = data[k];
+      if (copy_data) {
+        for (size_t k = 0; k < size; k++) {
+          attr_uchar4[offset + k] = data[k];
+        }
       }
       attr_uchar4_offset += size;
     }
@@ -602,8 +613,10 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
       offset = attr_float_offset;
 
       assert(attr_float.size() >= offset + size);
-      for (size_t k = 0; k < size; k++) {
-        attr_float[offset + k] = data[k];
+      if (copy_data) {
+        for (size_t k = 0; k < size; k++) {
+          attr_float[offset + k] = data[k];
+        }
       }
       attr_float_offset += size;
     }
@@ -612,8 +625,10 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
       offset = attr_float2_offset;
 
       assert(attr_float2.size() >= offset + size);
-      for (size_t k = 0; k < size; k++) {
-        attr_float2[offset + k] = data[k];
+      if (copy_data) {
+        for (size_t k = 0; k < size; k++) {
+          attr_float2[offset + k] = data[k];
+        }
       }
       attr_float2_offset += size;
     }
@@ -622,8 +637,10 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
       offset = attr_float3_offset;
 
       assert(attr_float3.size() >= offset + size * 3);
-      for (size_t k = 0; k < size * 3; k++) {
-        attr_float3[offset + k] = (&tfm->x)[k];
+      if (copy_data) {
+        for (size_t k = 0; k < size * 3; k++) {
+          attr_float3[offset + k] = (&tfm->x)[k];
+        }
       }
       attr_float3_offset += size * 3;
     }
@@ -632,8 +649,10 @@ void GeometryManager::update_attribute_element_offset(Geometry *geom,
       offset = attr_float3_offset;
 
       assert(attr_float3.size() >= offset + size);
-      for (size_t k = 0; k < size; k++) {
-        attr_float3[offset + k] = data[k];
+      if (copy_data) {
+        for (size_t k = 0; k < size; k++) {
+          attr_float3[offset + k] = data[k];
+        }
       }
       attr_float3_offset += size;
     }
@@ -793,6 +812,14 @@ void GeometryManager::device_update_attributes(Device *device,
     }
   }
 
+  /* Arrays of the same size still hold the attributes of the previous update, only geometry that
+   * was modified or moved in them has to be copied again. */
+  const bool copy_all = dscene->attributes_float.size() != attr_float_size ||
+                        dscene->attributes_float2.size() != attr_float2_size ||
+                        dscene->attributes_float3.size() != attr_float3_size ||
+                        dscene->attributes_uchar4.size() != attr_uchar4_size;
+  bool attributes_modified = copy_all;
+
   dscene->attributes_float.alloc(attr_float_size);
   dscene->attributes_float2.alloc(attr_float2_size);
   dscene->attributes_float3.alloc(attr_float3_size);
@@ -808,6 +835,18 @@ void GeometryManager::device_update_attributes(Device *device,
     Geometry *geom = scene->geometry[i];
     AttributeRequestSet &attributes = geom_attributes[i];
 
+    const bool copy_data = copy_all || geom->need_update_packed ||
+                           geom->attr_float_offset != attr_float_offset ||
+                           geom->attr_float2_offset != attr_float2_offset ||
+                           geom->attr_float3_offset != attr_float3_offset ||
+                           geom->attr_uchar4_offset != attr_uchar4_offset;
+    attributes_modified |= copy_data;
+
+    geom->attr_float_offset = attr_float_offset;
+    geom->attr_float2_offset = attr_float2_offset;
+    geom->attr_float3_offset = attr_float3_offset;
+    geom->attr_uchar4_offset = attr_uchar4_offset;
+
     /* todo: we now store std and name attributes from requests even if
      * they actually refer to the same mesh attributes, optimize */
     foreach (AttributeRequest &req, attributes.requests) {
@@ -824,7 +863,8 @@ void GeometryManager::device_update_attributes(Device *device,
                                       attr,
                                       ATTR_PRIM_GEOMETRY,
                                       req.type,
-                                      req.desc);
+                                      req.desc,
+                                      copy_data);
 
       if (geom->is_mesh()) {
         Mesh *mesh = static_cast<Mesh *>(geom);
@@ -842,7 +882,8 @@ void GeometryManager::device_update_attributes(Device *device,
                                         subd_attr,
                                         ATTR_PRIM_SUBD,
                                         req.subd_type,
-                                        req.subd_desc);
+                                        req.subd_desc,
+                                        copy_data);
       }
 
       if (progress.get_cancel())
@@ -850,6 +891,7 @@ void GeometryManager::device_update_attributes(Device *device,
     }
   }
 
+  /* Object attributes are few and stored after all geometry, copy them every time. */
   for (size_t i = 0; i < scene->objects.size(); i++) {
     Object *object = scene->objects[i];
     AttributeRequestSet &attributes = object_attributes[i];
@@ -857,6 +899,7 @@ void GeometryManager::device_update_attributes(Device *device,
 
     foreach (AttributeRequest &req, attributes.requests) {
       Attribute *attr = values.find(req);
+      attributes_modified = true;
 
       update_attribute_element_offset(object->geometry,
                                       dscene->attributes_float,
@@ -870,7 +913,8 @@ void GeometryManager::device_update_attributes(Device *device,
                                       attr,
                                       ATTR_PRIM_GEOMETRY,
                                       req.type,
-                                      req.desc);
+                                      req.desc,
+                                      true);
 
       /* object attributes don't care about subdivision */
       req.subd_type = req.type;
@@ -893,17 +937,19 @@ void GeometryManager::device_update_attributes(Device *device,
   /* copy to device */
   progress.set_status("Updating Mesh", "Copying Attributes to device");
 
-  if (dscene->attributes_float.size()) {
-    dscene->attributes_float.copy_to_device();
-  }
-  if (dscene->attributes_float2.size()) {
-    dscene->attributes_float2.copy_to_device();
-  }
-  if (dscene->attributes_float3.size()) {
-    dscene->attributes_float3.copy_to_device();
-  }
-  if (dscene->attributes_uchar4.size()) {
-    dscene->attributes_uchar4.copy_to_device();
+  if (attributes_modified) {
+    if (dscene->attributes_float.size()) {
+      dscene->attributes_float.copy_to_device();
+    }
+    if (dscene->attributes_float2.size()) {
+      dscene->attributes_float2.copy_to_device();
+    }
+    if (dscene->attributes_float3.size()) {
+      dscene->attributes_float3.copy_to_device();
+    }
+    if (dscene->attributes_uchar4.size()) {
+      dscene->attributes_uchar4.copy_to_device();
+    }
   }
 
   if (progress.get_cancel())
@@ -914,8 +960,10 @@ void GeometryManager::device_update_attributes(Device *device,
   scene->object_manager->device_update_mesh_offsets(device, dscene, scene);
 }
 
-void GeometryManager::mesh_calc_offset(Scene *scene)
+bool GeometryManager::mesh_calc_offset(Scene *scene)
 {
+  bool offsets_modified = false;
+
   size_t vert_size = 0;
   size_t tri_size = 0;
 
@@ -932,6 +980,12 @@ void GeometryManager::mesh_calc_offset(Scene *scene)
     if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
       Mesh *mesh = static_cast<Mesh *>(geom);
 
+      if (mesh->vert_offset != vert_size || mesh->prim_offset != tri_size ||
+          mesh->patch_offset != patch_size || mesh->face_offset != face_size ||
+          mesh->corner_offset != corner_size || mesh->optix_prim_offset != optix_prim_size) {
+        offsets_modified = true;
+      }
+
       mesh->vert_offset = vert_size;
       mesh->prim_offset = tri_size;
 
@@ -948,6 +1002,9 @@ void GeometryManager::mesh_calc_offset(Scene *scene)
 
         /* patch tables are stored in same array so include them in patch_size */
         if (mesh->patch_table) {
+          if (mesh->patch_table_offset != patch_size) {
+            offsets_modified = true;
+          }
           mesh->patch_table_offset = patch_size;
           patch_size += mesh->patch_table->total_size();
         }
@@ -962,6 +1019,11 @@ void GeometryManager::mesh_calc_offset(Scene *scene)
     else if (geom->is_hair()) {
       Hair *hair = static_cast<Hair *>(geom);
 
+      if (hair->curvekey_offset != curve_key_size || hair->prim_offset != curve_size ||
+          hair->optix_prim_offset != optix_prim_size) {
+        offsets_modified = true;
+      }
+
       hair->curvekey_offset = curve_key_size;
       hair->prim_offset = curve_size;
 
@@ -972,6 +1034,8 @@ void GeometryManager::mesh_calc_offset(Scene *scene)
       optix_prim_size += hair->num_segments();
     }
   }
+
+  return offsets_modified;
 }
 
 void GeometryManager::device_update_mesh(
@@ -1042,6 +1106,13 @@ void GeometryManager::device_update_mesh(
     /* normals */
     progress.set_status("Updating Mesh", "Computing normals");
 
+    /* Arrays of the same size still hold the meshes of the previous update, only modified meshes
+     * have to be packed again. */
+    const bool pack_all = dscene->tri_shader.size() != tri_size ||
+                          dscene->tri_vnormal.size() != vert_size;
+    bool meshes_modified = pack_all;
+    bool tri_vindex_modified = pack_all;
+
     uint *tri_shader = dscene->tri_shader.alloc(tri_size);
     float4 *vnormal = dscene->tri_vnormal.alloc(vert_size);
     uint4 *tri_vindex = dscene->tri_vindex.alloc(tri_size);
@@ -1051,14 +1122,28 @@ void GeometryManager::device_update_mesh(
     foreach (Geometry *geom, scene->geometry) {
       if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
         Mesh *mesh = static_cast<Mesh *>(geom);
-        mesh->pack_shaders(scene, &tri_shader[mesh->prim_offset]);
-        mesh->pack_normals(&vnormal[mesh->vert_offset]);
-        mesh->pack_verts(tri_prim_index,
-                         &tri_vindex[mesh->prim_offset],
-                         &tri_patch[mesh->prim_offset],
-                         &tri_patch_uv[mesh->vert_offset],
-                         mesh->vert_offset,
-                         mesh->prim_offset);
+        if (pack_all || mesh->need_update_packed) {
+          mesh->pack_shaders(scene, &tri_shader[mesh->prim_offset]);
+          mesh->pack_normals(&vnormal[mesh->vert_offset]);
+          mesh->pack_verts(tri_prim_index,
+                           &tri_vindex[mesh->prim_offset],
+                           &tri_patch[mesh->prim_offset],
+                           &tri_patch_uv[mesh->vert_offset],
+                           mesh->vert_offset,
+                           mesh->prim_offset);
+          meshes_modified = true;
+          tri_vindex_modified = true;
+        }
+        else {
+          /* The triangle location in the BVH changes whenever it is rebuilt. */
+          for (size_t i = 0; i < mesh->num_triangles(); i++) {
+            const uint prim_index = tri_prim_index[i + mesh->prim_offset];
+            if (tri_vindex[i + mesh->prim_offset].w != prim_index) {
+              tri_vindex[i + mesh->prim_offset].w = prim_index;
+              tri_vindex_modified = true;
+            }
+          }
+        }
         if (progress.get_cancel())
           return;
       }
@@ -1067,42 +1152,56 @@ void GeometryManager::device_update_mesh(
     /* vertex coordinates */
     progress.set_status("Updating Mesh", "Copying Mesh to device");
 
-    dscene->tri_shader.copy_to_device();
-    dscene->tri_vnormal.copy_to_device();
-    dscene->tri_vindex.copy_to_device();
-    dscene->tri_patch.copy_to_device();
-    dscene->tri_patch_uv.copy_to_device();
+    if (meshes_modified) {
+      dscene->tri_shader.copy_to_device();
+      dscene->tri_vnormal.copy_to_device();
+      dscene->tri_patch.copy_to_device();
+      dscene->tri_patch_uv.copy_to_device();
+    }
+    if (tri_vindex_modified) {
+      dscene->tri_vindex.copy_to_device();
+    }
   }
 
   if (curve_size != 0) {
     progress.set_status("Updating Mesh", "Copying Strands to device");
 
+    const bool pack_all = dscene->curve_keys.size() != curve_key_size ||
+                          dscene->curves.size() != curve_size;
+    bool curves_modified = pack_all;
+
     float4 *curve_keys = dscene->curve_keys.alloc(curve_key_size);
     float4 *curves = dscene->curves.alloc(curve_size);
 
     foreach (Geometry *geom, scene->geometry) {
-      if (geom->is_hair()) {
+      if (geom->is_hair() && (pack_all || geom->need_update_packed)) {
         Hair *hair = static_cast<Hair *>(geom);
         hair->pack_curves(scene,
                           &curve_keys[hair->curvekey_offset],
                           &curves[hair->prim_offset],
                           hair->curvekey_offset);
+        curves_modified = true;
         if (progress.get_cancel())
           return;
       }
     }
 
-    dscene->curve_keys.copy_to_device();
-    dscene->curves.copy_to_device();
+    if (curves_modified) {
+      dscene->curve_keys.copy_to_device();
+      dscene->curves.copy_to_device();
+    }
   }
 
   if (patch_size != 0) {
     progress.set_status("Updating Mesh", "Copying Patches to device");
 
+    const bool pack_all = dscene->patches.size() != patch_size;
+    bool patches_modified = pack_all;
+
     uint *patch_data = dscene->patches.alloc(patch_size);
 
     foreach (Geometry *geom, scene->geometry) {
-      if (geom->is_mesh()) {
+      if (geom->is_mesh() && (pack_all || geom->need_update_packed)) {
         Mesh *mesh = static_cast<Mesh *>(geom);
         mesh->pack_patches(&patch_data[mesh->patch_offset],
                            mesh->vert_offset,
@@ -1114,12 +1213,15 @@ void GeometryManager::device_update_mesh(
                                                     mesh->patch_table_offset);
         }
 
+        patches_modified = true;
         if (progress.get_cancel())
           return;
       }
     }
 
-    dscene->patches.copy_to_device();
+    if (patches_modified) {
+      dscene->patches.copy_to_device();
+    }
   }
 
   if (for_displacement) {
@@ -1157,6 +1259,7 @@ void GeometryManager::device_update_bvh(Device *device,
                                 scene->params.use_bvh_unaligned_nodes;
   bparams.num_motion_triangle_steps = scene->params.num_bvh_time_steps;
   bparams.num_motion_curve_steps = scene->params.num_bvh_time_steps;
+  bparams.max_curve_leaf_size = scene->params.bvh_curve_leaf_size;
   bparams.bvh_type = scene->params.bvh_type;
   bparams.curve_subdivisions = scene->params.curve_subdivisions();
 
@@ -1435,6 +1538,10 @@ void GeometryManager::device_update(Device *device,
         dicing_camera->get_full_width(), dicing_camera->get_full_height(), 1);
     dicing_camera->update(scene);
 
+    /* Meshes are tessellated independently of each other, so do that in parallel. Scenes with
+     * adaptive subdivision often have many subdivided meshes of similar cost. */
+    TaskPool pool;
+
     size_t i = 0;
     foreach (Geometry *geom, scene->geometry) {
       if (!(geom->is_modified() && geom->is_mesh())) {
@@ -1443,27 +1550,32 @@ void GeometryManager::device_update(Device *device,
 
       Mesh *mesh = static_cast<Mesh *>(geom);
       if (mesh->need_tesselation()) {
-        string msg = "Tessellating ";
-        if (mesh->name == "")
-          msg += string_printf("%u/%u", (uint)(i + 1), (uint)total_tess_needed);
-        else
-          msg += string_printf(
-              "%s %u/%u", mesh->name.c_str(), (uint)(i + 1), (uint)total_tess_needed);
+        mesh->subd_params->camera = dicing_camera;
 
-        progress.set_status("Updating Mesh", msg);
+        pool.push([mesh, i, total_tess_needed, &progress] {
+          if (progress.get_cancel()) {
+            return;
+          }
 
-        mesh->subd_params->camera = dicing_camera;
-        DiagSplit dsplit(*mesh->subd_params);
-        mesh->tessellate(&dsplit);
+          string msg = "Tessellating ";
+          if (mesh->name == "")
+            msg += string_printf("%u/%u", (uint)(i + 1), (uint)total_tess_needed);
+          else
+            msg += string_printf(
+                "%s %u/%u", mesh->name.c_str(), (uint)(i + 1), (uint)total_tess_needed);
 
-        i++;
+          progress.set_status("Updating Mesh", msg);
 
-        if (progress.get_cancel()) {
-          return;
-        }
+          DiagSplit dsplit(*mesh->subd_params);
+          mesh->tessellate(&dsplit);
+        });
+
+        i++;
       }
     }
 
+    pool.wait_work();
+
     if (progress.get_cancel()) {
       return;
     }
@@ -1484,9 +1596,23 @@ void GeometryManager::device_update(Device *device,
   }
 
   /* Device update. */
-  device_free(device, dscene);
+  device_free_bvh(device, dscene);
+
+  /* Only copy the modified geometry into the packed arrays when everything else is still at the
+   * same location in them and refers to the same shaders. Displacement evaluates with different
+   * contents of the arrays, so always pack everything in that case. */
+  const bool offsets_modified = mesh_calc_offset(scene);
+  const bool pack_modified_only = packed_arrays_valid && !offsets_modified &&
+                                  !true_displacement_used && packed_shaders == scene->shaders;
+  if (!pack_modified_only) {
+    device_free(device, dscene);
+  }
+  packed_arrays_valid = false;
+
+  foreach (Geometry *geom, scene->geometry) {
+    geom->need_update_packed = !pack_modified_only || geom->is_modified();
+  }
 
-  mesh_calc_offset(scene);
   if (true_displacement_used) {
     scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
@@ -1572,12 +1698,22 @@ void GeometryManager::device_update(Device *device,
       }
     });
     TaskPool pool;
+    thread_mutex stats_mutex;
 
     size_t i = 0;
     foreach (Geometry *geom, scene->geometry) {
       if (geom->is_modified()) {
-        pool.push(function_bind(
-            &Geometry::compute_bvh, geom, device, dscene, &scene->params, &progress, i, num_bvh));
+        pool.push([=, &progress, &stats_mutex] {
+          scoped_callback_timer timer([=, &stats_mutex](double time) {
+            if (scene->update_stats) {
+              const string name = geom->name.empty() ? string_printf("%u", (uint)i) :
+                                                       geom->name.string();
+              thread_scoped_lock lock(stats_mutex);
+              scene->update_stats->bvh.times.add_entry({name, time});
+            }
+          });
+          geom->compute_bvh(device, dscene, &scene->params, &progress, i, num_bvh);
+        });
         if (geom->need_build_bvh(bvh_layout)) {
           i++;
         }
@@ -1639,6 +1775,8 @@ void GeometryManager::device_update(Device *device,
   }
 
   need_update = false;
+  packed_arrays_valid = true;
+  packed_shaders = scene->shaders;
 
   if (true_displacement_used) {
     /* Re-tag flags for update, so they're re-evaluated
@@ -1651,7 +1789,7 @@ void GeometryManager::device_update(Device *device,
   }
 }
 
-void GeometryManager::device_free(Device *device, DeviceScene *dscene)
+void GeometryManager::device_free_bvh(Device *device, DeviceScene *dscene)
 {
 #ifdef WITH_EMBREE
   if (dscene->data.bvh.scene) {
@@ -1671,19 +1809,7 @@ void GeometryManager::device_free(Device *device, DeviceScene *dscene)
   dscene->prim_index.free();
   dscene->prim_object.free();
   dscene->prim_time.free();
-  dscene->tri_shader.free();
-  dscene->tri_vnormal.free();
-  dscene->tri_vindex.free();
-  dscene->tri_patch.free();
-  dscene->tri_patch_uv.free();
-  dscene->curves.free();
-  dscene->curve_keys.free();
-  dscene->patches.free();
   dscene->attributes_map.free();
-  dscene->attributes_float.free();
-  dscene->attributes_float2.free();
-  dscene->attributes_float3.free();
-  dscene->attributes_uchar4.free();
 
   /* Signal for shaders like displacement not to do ray tracing. */
   dscene->data.bvh.bvh_layout = BVH_LAYOUT_NONE;
@@ -1701,6 +1827,26 @@ void GeometryManager::device_free(Device *device, DeviceScene *dscene)
 #endif
 }
 
+void GeometryManager::device_free(Device *device, DeviceScene *dscene)
+{
+  device_free_bvh(device, dscene);
+
+  dscene->tri_shader.free();
+  dscene->tri_vnormal.free();
+  dscene->tri_vindex.free();
+  dscene->tri_patch.free();
+  dscene->tri_patch_uv.free();
+  dscene->curves.free();
+  dscene->curve_keys.free();
+  dscene->patches.free();
+  dscene->attributes_float.free();
+  dscene->attributes_float2.free();
+  dscene->attributes_float3.free();
+  dscene->attributes_uchar4.free();
+
+  packed_arrays_valid = false;
+}
+
 void GeometryManager::tag_update(Scene *scene)
 {
   need_update = true;
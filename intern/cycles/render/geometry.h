@@ -83,12 +83,20 @@ class Geometry : public Node {
   size_t prim_offset;
   size_t optix_prim_offset;
 
+  /* Start of the geometry data in the packed attribute arrays. */
+  size_t attr_float_offset;
+  size_t attr_float2_offset;
+  size_t attr_float3_offset;
+  size_t attr_uchar4_offset;
+
   /* Shader Properties */
   bool has_volume;         /* Set in the device_update_flags(). */
   bool has_surface_bssrdf; /* Set in the device_update_flags(). */
 
   /* Update Flags */
   bool need_update_rebuild;
+  /* Geometry has to be copied into the packed device arrays (only valid during update). */
+  bool need_update_packed;
 
   /* Index into scene->geometry (only valid during update) */
   size_t index;
@@ -194,8 +202,9 @@ class GeometryManager {
                              vector<AttributeRequestSet> &geom_attributes,
                              vector<AttributeRequestSet> &object_attributes);
 
-  /* Compute verts/triangles/curves offsets in global arrays. */
-  void mesh_calc_offset(Scene *scene);
+  /* Compute verts/triangles/curves offsets in global arrays, returns true if any offset changed
+   * since the previous update. */
+  bool mesh_calc_offset(Scene *scene);
 
   void device_update_object(Device *device, DeviceScene *dscene, Scene *scene, Progress &progress);
 
@@ -216,6 +225,15 @@ class GeometryManager {
 
   void device_update_volume_images(Device *device, Scene *scene, Progress &progress);
 
+  /* Free the BVH and the arrays packed along with it, which are rebuilt on every update. */
+  void device_free_bvh(Device *device, DeviceScene *dscene);
+
+  /* Packed geometry and attribute arrays of the previous update are complete, so only modified
+   * geometry has to be copied into them as long as the offsets in the arrays are unchanged. */
+  bool packed_arrays_valid;
+  /* Shaders at the time of the previous update, the packed shader indices refer to them. */
+  vector<Shader *> packed_shaders;
+
  private:
   static void update_attribute_element_offset(Geometry *geom,
                                               device_vector<float> &attr_float,
@@ -229,7 +247,8 @@ class GeometryManager {
                                               Attribute *mattr,
                                               AttributePrimitive prim,
                                               TypeDesc &type,
-                                              AttributeDescriptor &desc);
+                                              AttributeDescriptor &desc,
+                                              bool copy_data);
 };
 
 CCL_NAMESPACE_END
@@ -85,6 +85,34 @@ const char *name_from_type(ImageDataType type)
   return "";
 }
 
+/* Size of a pixel in device memory, zero for types that can't be scaled down. */
+size_t pixel_size_from_type(ImageDataType type)
+{
+  switch (type) {
+    case IMAGE_DATA_TYPE_FLOAT4:
+      return sizeof(float4);
+    case IMAGE_DATA_TYPE_BYTE4:
+      return sizeof(uchar4);
+    case IMAGE_DATA_TYPE_HALF4:
+      return sizeof(half4);
+    case IMAGE_DATA_TYPE_FLOAT:
+      return sizeof(float);
+    case IMAGE_DATA_TYPE_BYTE:
+      return sizeof(uchar);
+    case IMAGE_DATA_TYPE_HALF:
+      return sizeof(half);
+    case IMAGE_DATA_TYPE_USHORT4:
+      return sizeof(ushort4);
+    case IMAGE_DATA_TYPE_USHORT:
+      return sizeof(uint16_t);
+    case IMAGE_DATA_TYPE_NANOVDB_FLOAT:
+    case IMAGE_DATA_TYPE_NANOVDB_FLOAT3:
+    case IMAGE_DATA_NUM_TYPES:
+      return 0;
+  }
+  return 0;
+}
+
 }  // namespace
 
 /* Image Handle */
@@ -446,6 +474,7 @@ int ImageManager::add_image_slot(ImageLoader *loader,
   img->need_metadata = true;
   img->need_load = !(osl_texture_system && !img->loader->osl_filepath().empty());
   img->builtin = builtin;
+  img->cache_texture_limit = 0;
   img->users = 1;
   img->mem = NULL;
 
@@ -656,7 +685,11 @@ void ImageManager::device_load_image(Device *device, Scene *scene, int slot, Pro
 
   progress->set_status("Updating Images", "Loading " + img->loader->name());
 
-  const int texture_limit = scene->params.texture_limit;
+  int texture_limit = scene->params.texture_limit;
+  if (img->cache_texture_limit > 0) {
+    texture_limit = (texture_limit > 0) ? min(texture_limit, img->cache_texture_limit) :
+                                          img->cache_texture_limit;
+  }
 
   load_image_metadata(img);
   ImageDataType type = img->metadata.type;
@@ -808,6 +841,86 @@ void ImageManager::device_free_image(Device *, int slot)
   images[slot] = NULL;
 }
 
+void ImageManager::device_update_cache_limits(Scene *scene)
+{
+  /* Fit the images into the texture cache size by scaling down the largest images first, by a
+   * factor of two at a time. Images that are already on the device count at their current size. */
+  const size_t cache_size = (size_t)scene->params.texture_cache_size * 1024 * 1024;
+  size_t total_size = 0;
+  vector<Image *> scalable_images;
+  vector<int> num_halvings;
+
+  for (size_t slot = 0; slot < images.size(); slot++) {
+    Image *img = images[slot];
+    if (img == NULL || img->users == 0) {
+      continue;
+    }
+    if (!img->need_load) {
+      if (img->mem) {
+        total_size += img->mem->memory_size();
+      }
+      continue;
+    }
+
+    img->cache_texture_limit = 0;
+    load_image_metadata(img);
+    const ImageMetaData &metadata = img->metadata;
+    const size_t pixel_size = pixel_size_from_type(metadata.type);
+    if (pixel_size == 0) {
+      continue;
+    }
+    total_size += pixel_size * metadata.width * metadata.height * metadata.depth;
+    scalable_images.push_back(img);
+    num_halvings.push_back(0);
+  }
+
+  if (total_size <= cache_size) {
+    return;
+  }
+
+  VLOG(1) << "Image textures need " << string_human_readable_size(total_size)
+          << ", scaling down to fit the texture cache size of "
+          << string_human_readable_size(cache_size) << ".";
+
+  while (total_size > cache_size) {
+    /* Find the largest image that can still be scaled down. */
+    int largest = -1;
+    size_t largest_size = 0;
+    for (int i = 0; i < scalable_images.size(); i++) {
+      const ImageMetaData &metadata = scalable_images[i]->metadata;
+      const size_t max_size = max(max(metadata.width, metadata.height), metadata.depth);
+      if ((max_size >> num_halvings[i]) <= 1) {
+        continue;
+      }
+      const size_t size = (pixel_size_from_type(metadata.type) * metadata.width *
+                           metadata.height * metadata.depth) >>
+                          (num_halvings[i] * ((metadata.depth > 1) ? 3 : 2));
+      if (size > largest_size) {
+        largest = i;
+        largest_size = size;
+      }
+    }
+
+    if (largest == -1) {
+      break;
+    }
+
+    const bool is_3d = scalable_images[largest]->metadata.depth > 1;
+    total_size -= largest_size - (largest_size >> (is_3d ? 3 : 2));
+    num_halvings[largest]++;
+  }
+
+  for (int i = 0; i < scalable_images.size(); i++) {
+    if (num_halvings[i] > 0) {
+      const ImageMetaData &metadata = scalable_images[i]->metadata;
+      const int max_size = max(max(metadata.width, metadata.height), metadata.depth);
+      /* Round up so file_load_image stops at exactly this many halvings. */
+      scalable_images[i]->cache_texture_limit = (max_size + (1 << num_halvings[i]) - 1) >>
+                                                num_halvings[i];
+    }
+  }
+}
+
 void ImageManager::device_update(Device *device, Scene *scene, Progress &progress)
 {
   if (!need_update) {
@@ -820,6 +933,10 @@ void ImageManager::device_update(Device *device, Scene *scene, Progress &progres
     }
   });
 
+  if (scene->params.texture_cache_size > 0) {
+    device_update_cache_limits(scene);
+  }
+
   TaskPool pool;
   for (size_t slot = 0; slot < images.size(); slot++) {
     Image *img = images[slot];
@@ -858,6 +975,10 @@ void ImageManager::device_load_builtin(Device *device, Scene *scene, Progress &p
     return;
   }
 
+  if (scene->params.texture_cache_size > 0) {
+    device_update_cache_limits(scene);
+  }
+
   TaskPool pool;
   for (size_t slot = 0; slot < images.size(); slot++) {
     Image *img = images[slot];
@@ -200,6 +200,8 @@ class ImageManager {
     bool need_metadata;
     bool need_load;
     bool builtin;
+    /* Resolution limit to fit the texture cache size, zero for no limit. */
+    int cache_texture_limit;
 
     string mem_name;
     device_texture *mem;
@@ -227,6 +229,7 @@ class ImageManager {
   template<TypeDesc::BASETYPE FileFormat, typename StorageType>
   bool file_load_image(Image *img, int texture_limit);
 
+  void device_update_cache_limits(Scene *scene);
   void device_load_image(Device *device, Scene *scene, int slot, Progress *progress);
   void device_free_image(Device *device, int slot);
 
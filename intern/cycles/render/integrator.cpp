@@ -79,6 +79,7 @@ NODE_DEFINE(Integrator)
   SOCKET_BOOLEAN(sample_all_lights_direct, "Sample All Lights Direct", true);
   SOCKET_BOOLEAN(sample_all_lights_indirect, "Sample All Lights Indirect", true);
   SOCKET_FLOAT(light_sampling_threshold, "Light Sampling Threshold", 0.05f);
+  SOCKET_BOOLEAN(use_light_tree, "Use Light Tree", false);
 
   static NodeEnum method_enum;
   method_enum.insert("path", PATH);
@@ -280,6 +281,10 @@ void Integrator::tag_update(Scene *scene)
       break;
     }
   }
+  /* The light tree is built along with the light distribution. */
+  if (use_light_tree_is_modified()) {
+    scene->light_manager->tag_update(scene);
+  }
   tag_modified();
 }
 
@@ -20,6 +20,7 @@
 #include "render/film.h"
 #include "render/graph.h"
 #include "render/integrator.h"
+#include "render/light_tree.h"
 #include "render/mesh.h"
 #include "render/nodes.h"
 #include "render/object.h"
@@ -334,10 +335,25 @@ void LightManager::device_update_distribution(Device *,
   size_t offset = 0;
   int j = 0;
 
+  /* Light tree over the triangles, which also needs to find the distribution index of a triangle
+   * from its object and primitive for multiple importance sampling. The triangles of each object
+   * are stored contiguously in the distribution, ordered by primitive. */
+  const bool use_light_tree = scene->integrator->get_use_light_tree() && num_triangles > 0;
+  vector<LightTreePrimitive> light_tree_prims;
+  uint *object_offset = NULL;
+  if (use_light_tree) {
+    light_tree_prims.reserve(num_triangles);
+    object_offset = dscene->light_tree_object_offset.alloc(scene->objects.size() + 1);
+  }
+
   foreach (Object *object, scene->objects) {
     if (progress.get_cancel())
       return;
 
+    if (use_light_tree) {
+      object_offset[j] = offset;
+    }
+
     if (!object_usable_as_light(object)) {
       j++;
       continue;
@@ -394,13 +410,29 @@ void LightManager::device_update_distribution(Device *,
           p3 = transform_point(&tfm, p3);
         }
 
-        totarea += triangle_area(p1, p2, p3);
+        const float area = triangle_area(p1, p2, p3);
+        totarea += area;
+
+        if (use_light_tree) {
+          LightTreePrimitive prim;
+          prim.bounds = BoundBox(p1);
+          prim.bounds.grow(p2);
+          prim.bounds.grow(p3);
+          prim.axis = safe_normalize(cross(p2 - p1, p3 - p1));
+          prim.energy = area;
+          prim.index = offset - 1;
+          light_tree_prims.push_back(prim);
+        }
       }
     }
 
     j++;
   }
 
+  if (use_light_tree) {
+    object_offset[j] = offset;
+  }
+
   float trianglearea = totarea;
 
   /* point lights */
@@ -495,6 +527,28 @@ void LightManager::device_update_distribution(Device *,
     /* CDF */
     dscene->light_distribution.copy_to_device();
 
+    /* Light tree, picks the triangles with the same total probability as the distribution. */
+    kintegrator->use_light_tree = use_light_tree && trianglearea > 0.0f;
+    kintegrator->light_tree_weight = (num_lights) ? 0.5f : 1.0f;
+
+    if (kintegrator->use_light_tree) {
+      LightTree light_tree(light_tree_prims, num_triangles);
+      VLOG(1) << "Light tree with " << light_tree.nodes.size() << " nodes.";
+
+      KernelLightTreeNode *nodes = dscene->light_tree_nodes.alloc(light_tree.nodes.size());
+      memcpy(
+          nodes, light_tree.nodes.data(), sizeof(KernelLightTreeNode) * light_tree.nodes.size());
+      int *leaf = dscene->light_tree_leaf.alloc(num_triangles);
+      memcpy(leaf, light_tree.leaf.data(), sizeof(int) * num_triangles);
+
+      dscene->light_tree_nodes.copy_to_device();
+      dscene->light_tree_leaf.copy_to_device();
+      dscene->light_tree_object_offset.copy_to_device();
+    }
+    else {
+      dscene->light_tree_object_offset.free();
+    }
+
     /* Portals */
     if (num_portals > 0) {
       kbackground->portal_offset = light_index;
@@ -512,12 +566,14 @@ void LightManager::device_update_distribution(Device *,
   }
   else {
     dscene->light_distribution.free();
+    dscene->light_tree_object_offset.free();
 
     kintegrator->num_distribution = 0;
     kintegrator->num_all_lights = 0;
     kintegrator->pdf_triangles = 0.0f;
     kintegrator->pdf_lights = 0.0f;
     kintegrator->use_lamp_mis = false;
+    kintegrator->use_light_tree = false;
 
     kbackground->num_portals = 0;
     kbackground->portal_offset = 0;
@@ -1005,6 +1061,9 @@ void LightManager::device_update(Device *device,
 void LightManager::device_free(Device *, DeviceScene *dscene, const bool free_background)
 {
   dscene->light_distribution.free();
+  dscene->light_tree_nodes.free();
+  dscene->light_tree_leaf.free();
+  dscene->light_tree_object_offset.free();
   dscene->lights.free();
   if (free_background) {
     dscene->light_background_marginal_cdf.free();
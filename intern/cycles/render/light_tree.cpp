@@ -0,0 +1,174 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "render/light_tree.h"
+
+#include "util/util_algorithm.h"
+#include "util/util_math.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Bounding cone of the emitter normals, up to their sign. */
+struct LightTreeCone {
+  float3 axis;
+  float theta_o;
+};
+
+static LightTreeCone light_tree_cone_merge(const LightTreeCone &a, const LightTreeCone &b)
+{
+  /* The normals are only bounded up to their sign, so flip the second cone towards the first. */
+  LightTreeCone c0 = a;
+  LightTreeCone c1 = b;
+  if (dot(c0.axis, c1.axis) < 0.0f) {
+    c1.axis = -c1.axis;
+  }
+  if (c1.theta_o > c0.theta_o) {
+    swap(c0, c1);
+  }
+
+  const float theta_d = safe_acosf(dot(c0.axis, c1.axis));
+  if (min(theta_d + c1.theta_o, M_PI_F) <= c0.theta_o) {
+    /* The wider cone already contains the other one. */
+    return c0;
+  }
+
+  LightTreeCone result;
+  result.theta_o = 0.5f * (c0.theta_o + theta_d + c1.theta_o);
+  if (result.theta_o >= M_PI_2_F) {
+    /* A half angle of 90 degrees covers all normals up to their sign. */
+    result.axis = c0.axis;
+    result.theta_o = M_PI_2_F;
+    return result;
+  }
+
+  /* Rotate the axis of the wider cone towards the other one. */
+  const float theta_r = result.theta_o - c0.theta_o;
+  const float3 ortho = safe_normalize(c1.axis - dot(c0.axis, c1.axis) * c0.axis);
+  result.axis = normalize(c0.axis * cosf(theta_r) + ortho * sinf(theta_r));
+  return result;
+}
+
+static BoundBox light_tree_node_bounds(const KernelLightTreeNode &knode)
+{
+  return BoundBox(make_float3(knode.bbox_min[0], knode.bbox_min[1], knode.bbox_min[2]),
+                  make_float3(knode.bbox_max[0], knode.bbox_max[1], knode.bbox_max[2]));
+}
+
+static LightTreeCone light_tree_node_cone(const KernelLightTreeNode &knode)
+{
+  LightTreeCone cone;
+  cone.axis = make_float3(knode.axis[0], knode.axis[1], knode.axis[2]);
+  cone.theta_o = knode.theta_o;
+  return cone;
+}
+
+LightTree::LightTree(vector<LightTreePrimitive> &prims, int num_distribution)
+{
+  leaf.resize(num_distribution, -1);
+
+  if (prims.empty()) {
+    return;
+  }
+
+  nodes.reserve(prims.size() * 2 - 1);
+  build_node(prims, 0, prims.size(), -1);
+}
+
+int LightTree::build_node(vector<LightTreePrimitive> &prims, int begin, int end, int parent)
+{
+  const int node_index = nodes.size();
+  nodes.push_back(KernelLightTreeNode());
+
+  BoundBox bounds = BoundBox::empty;
+  LightTreeCone cone;
+  float energy;
+  int child_index;
+
+  if (end - begin == 1) {
+    /* Leaf node with a single emitter. */
+    const LightTreePrimitive &prim = prims[begin];
+    bounds = prim.bounds;
+    cone.axis = prim.axis;
+    cone.theta_o = 0.0f;
+    energy = prim.energy;
+    child_index = ~prim.index;
+    leaf[prim.index] = node_index;
+  }
+  else {
+    /* Split at the median of the centroids along the largest axis. */
+    BoundBox centroid_bounds = BoundBox::empty;
+    for (int i = begin; i < end; i++) {
+      centroid_bounds.grow(prims[i].bounds.center());
+    }
+    const float3 extent = centroid_bounds.size();
+    const int dim = (extent.x >= extent.y && extent.x >= extent.z) ? 0 :
+                    (extent.y >= extent.z)                         ? 1 :
+                                                                     2;
+    const int middle = (begin + end) / 2;
+    std::nth_element(prims.begin() + begin,
+                     prims.begin() + middle,
+                     prims.begin() + end,
+                     [dim](const LightTreePrimitive &a, const LightTreePrimitive &b) {
+                       return a.bounds.center()[dim] < b.bounds.center()[dim];
+                     });
+
+    /* The left child directly follows this node. */
+    const int left = build_node(prims, begin, middle, node_index);
+    const int right = build_node(prims, middle, end, node_index);
+
+    const KernelLightTreeNode &knode_left = nodes[left];
+    const KernelLightTreeNode &knode_right = nodes[right];
+    bounds.grow(light_tree_node_bounds(knode_left));
+    bounds.grow(light_tree_node_bounds(knode_right));
+    /* Degenerate triangles have no energy nor a meaningful normal, don't let them widen the
+     * cone. */
+    if (knode_left.energy == 0.0f) {
+      cone = light_tree_node_cone(knode_right);
+    }
+    else if (knode_right.energy == 0.0f) {
+      cone = light_tree_node_cone(knode_left);
+    }
+    else {
+      cone = light_tree_cone_merge(light_tree_node_cone(knode_left),
+                                   light_tree_node_cone(knode_right));
+    }
+
+    energy = knode_left.energy + knode_right.energy;
+    child_index = right;
+  }
+
+  KernelLightTreeNode &knode = nodes[node_index];
+  knode.bbox_min[0] = bounds.min.x;
+  knode.bbox_min[1] = bounds.min.y;
+  knode.bbox_min[2] = bounds.min.z;
+  knode.energy = energy;
+  knode.bbox_max[0] = bounds.max.x;
+  knode.bbox_max[1] = bounds.max.y;
+  knode.bbox_max[2] = bounds.max.z;
+  knode.theta_o = cone.theta_o;
+  knode.axis[0] = cone.axis.x;
+  knode.axis[1] = cone.axis.y;
+  knode.axis[2] = cone.axis.z;
+  knode.child_index = child_index;
+  knode.parent_index = parent;
+  knode.pad1 = 0;
+  knode.pad2 = 0;
+  knode.pad3 = 0;
+
+  return node_index;
+}
+
+CCL_NAMESPACE_END
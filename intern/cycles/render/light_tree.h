@@ -0,0 +1,58 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LIGHT_TREE_H__
+#define __LIGHT_TREE_H__
+
+#include "kernel/kernel_types.h"
+
+#include "util/util_boundbox.h"
+#include "util/util_types.h"
+#include "util/util_vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Emitter as seen by the light tree builder. */
+struct LightTreePrimitive {
+  BoundBox bounds;
+  /* Normal of the emitter, the sign is ignored since triangles emit from both sides. */
+  float3 axis;
+  float energy;
+  /* Index into the light distribution. */
+  int index;
+};
+
+/* Light Tree
+ *
+ * Binary tree over the emissive triangles, used to pick an emitter proportional to an estimate
+ * of its contribution to the shading point based on distance and orientation, as opposed to the
+ * flat light distribution which only takes the area into account. */
+class LightTree {
+ public:
+  LightTree(vector<LightTreePrimitive> &prims, int num_distribution);
+
+  /* Nodes in depth first order, the root is the first node. */
+  vector<KernelLightTreeNode> nodes;
+  /* Leaf node for every light distribution index, -1 when the emitter is not in the tree. */
+  vector<int> leaf;
+
+ protected:
+  int build_node(vector<LightTreePrimitive> &prims, int begin, int end, int parent);
+};
+
+CCL_NAMESPACE_END
+
+#endif /* __LIGHT_TREE_H__ */
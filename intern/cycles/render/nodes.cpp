@@ -6071,9 +6071,11 @@ void MathNode::compile(SVMCompiler &compiler)
   ShaderInput *value3_in = input("Value3");
   ShaderOutput *value_out = output("Value");
 
-  int value1_stack_offset = compiler.stack_assign(value1_in);
-  int value2_stack_offset = compiler.stack_assign(value2_in);
-  int value3_stack_offset = compiler.stack_assign(value3_in);
+  /* Constant inputs are embedded in the node instead of being pushed onto the stack by separate
+   * value nodes, which saves interpreter dispatches in math heavy procedural shaders. */
+  int value1_stack_offset = compiler.stack_assign_if_linked(value1_in);
+  int value2_stack_offset = compiler.stack_assign_if_linked(value2_in);
+  int value3_stack_offset = compiler.stack_assign_if_linked(value3_in);
   int value_stack_offset = compiler.stack_assign(value_out);
 
   compiler.add_node(
@@ -6081,6 +6083,11 @@ void MathNode::compile(SVMCompiler &compiler)
       math_type,
       compiler.encode_uchar4(value1_stack_offset, value2_stack_offset, value3_stack_offset),
       value_stack_offset);
+
+  if (!value1_in->link || !value2_in->link || !value3_in->link) {
+    compiler.add_node(
+        __float_as_int(value1), __float_as_int(value2), __float_as_int(value3), SVM_STACK_INVALID);
+  }
 }
 
 void MathNode::compile(OSLCompiler &compiler)
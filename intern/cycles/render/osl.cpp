@@ -112,6 +112,15 @@ void OSLShaderManager::device_update(Device *device,
   /* set texture system */
   scene->image_manager->set_osl_texture_system((void *)ts);
 
+  /* File textures are loaded as tiles on demand by the texture system, with mipmap levels chosen
+   * from the ray differentials. The cache size bounds the memory used for them. */
+  if (scene->params.texture_cache_size > 0) {
+    ts->attribute("max_memory_MB", (float)scene->params.texture_cache_size);
+  }
+  else {
+    ts->attribute("max_memory_MB", 16384.0f);
+  }
+
   /* create shaders */
   OSLGlobals *og = (OSLGlobals *)device->osl_memory();
   Shader *background_shader = scene->background->get_shader(scene);
@@ -201,9 +210,6 @@ void OSLShaderManager::texture_system_init()
     ts_shared->attribute("automip", 1);
     ts_shared->attribute("autotile", 64);
     ts_shared->attribute("gray_to_rgb", 1);
-
-    /* effectively unlimited for now, until we support proper mipmap lookups */
-    ts_shared->attribute("max_memory_MB", 16384);
   }
 
   ts = ts_shared;
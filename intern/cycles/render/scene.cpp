@@ -76,6 +76,9 @@ DeviceScene::DeviceScene(Device *device)
       lights(device, "__lights", MEM_GLOBAL),
       light_background_marginal_cdf(device, "__light_background_marginal_cdf", MEM_GLOBAL),
       light_background_conditional_cdf(device, "__light_background_conditional_cdf", MEM_GLOBAL),
+      light_tree_nodes(device, "__light_tree_nodes", MEM_GLOBAL),
+      light_tree_leaf(device, "__light_tree_leaf", MEM_GLOBAL),
+      light_tree_object_offset(device, "__light_tree_object_offset", MEM_GLOBAL),
       particles(device, "__particles", MEM_GLOBAL),
       svm_nodes(device, "__svm_nodes", MEM_GLOBAL),
       shaders(device, "__shaders", MEM_GLOBAL),
@@ -419,6 +422,58 @@ void Scene::collect_statistics(RenderStats *stats)
 {
   geometry_manager->collect_statistics(this, stats);
   image_manager->collect_statistics(stats);
+
+  stats->device.mem_used = device->stats.mem_used;
+  stats->device.mem_peak = device->stats.mem_peak;
+
+  /* Device memory of the packed scene arrays, empty arrays are skipped. */
+  const device_memory *arrays[] = {&dscene.bvh_nodes,
+                                   &dscene.bvh_leaf_nodes,
+                                   &dscene.object_node,
+                                   &dscene.prim_tri_index,
+                                   &dscene.prim_tri_verts,
+                                   &dscene.prim_type,
+                                   &dscene.prim_visibility,
+                                   &dscene.prim_index,
+                                   &dscene.prim_object,
+                                   &dscene.prim_time,
+                                   &dscene.tri_shader,
+                                   &dscene.tri_vnormal,
+                                   &dscene.tri_vindex,
+                                   &dscene.tri_patch,
+                                   &dscene.tri_patch_uv,
+                                   &dscene.curves,
+                                   &dscene.curve_keys,
+                                   &dscene.patches,
+                                   &dscene.objects,
+                                   &dscene.object_motion_pass,
+                                   &dscene.object_motion,
+                                   &dscene.object_flag,
+                                   &dscene.object_volume_step,
+                                   &dscene.camera_motion,
+                                   &dscene.attributes_map,
+                                   &dscene.attributes_float,
+                                   &dscene.attributes_float2,
+                                   &dscene.attributes_float3,
+                                   &dscene.attributes_uchar4,
+                                   &dscene.light_distribution,
+                                   &dscene.lights,
+                                   &dscene.light_background_marginal_cdf,
+                                   &dscene.light_background_conditional_cdf,
+                                   &dscene.light_tree_nodes,
+                                   &dscene.light_tree_leaf,
+                                   &dscene.light_tree_object_offset,
+                                   &dscene.particles,
+                                   &dscene.svm_nodes,
+                                   &dscene.shaders,
+                                   &dscene.lookup_table,
+                                   &dscene.sample_pattern_lut,
+                                   &dscene.ies_lights};
+  for (const device_memory *mem : arrays) {
+    if (mem->device_size) {
+      stats->device.arrays.add_entry(NamedSizeEntry(mem->name, mem->device_size));
+    }
+  }
 }
 
 void Scene::enable_update_stats()
@@ -496,7 +551,9 @@ bool Scene::update(Progress &progress, bool &kernel_switch_needed)
     }
 
     /* Load render kernels, before device update where we upload data to the GPU. */
+    double kernel_time = time_dt();
     bool new_kernels_needed = load_kernels(progress, false);
+    kernel_time = time_dt() - kernel_time;
 
     progress.set_status("Updating Scene");
     MEM_GUARDED_CALL(&progress, device_update, device, progress);
@@ -509,10 +566,17 @@ bool Scene::update(Progress &progress, bool &kernel_switch_needed)
     }
     if (new_kernels_needed || kernel_switch_needed) {
       progress.set_kernel_status("Compiling render kernels");
+      const double wait_time = time_dt();
       device->wait_for_availability(loaded_kernel_features);
+      kernel_time += time_dt() - wait_time;
       progress.set_kernel_status("");
     }
 
+    /* Added after the device update, which clears the statistics when it starts. */
+    if (update_stats) {
+      update_stats->scene.times.add_entry({"load_kernels", kernel_time});
+    }
+
     return true;
   }
   return false;
@@ -112,6 +112,9 @@ class DeviceScene {
   device_vector<KernelLight> lights;
   device_vector<float2> light_background_marginal_cdf;
   device_vector<float2> light_background_conditional_cdf;
+  device_vector<KernelLightTreeNode> light_tree_nodes;
+  device_vector<int> light_tree_leaf;
+  device_vector<uint> light_tree_object_offset;
 
   /* particles */
   device_vector<KernelParticle> particles;
@@ -172,10 +175,14 @@ class SceneParams {
   bool use_bvh_spatial_split;
   bool use_bvh_unaligned_nodes;
   int num_bvh_time_steps;
+  /* Maximum number of curve segments in a BVH leaf, higher values use less memory. */
+  int bvh_curve_leaf_size;
   int hair_subdivisions;
   CurveShapeType hair_shape;
   bool persistent_data;
   int texture_limit;
+  /* Memory budget for image textures in megabytes, zero for no limit. */
+  int texture_cache_size;
 
   bool background;
 
@@ -187,10 +194,12 @@ class SceneParams {
     use_bvh_spatial_split = false;
     use_bvh_unaligned_nodes = true;
     num_bvh_time_steps = 0;
+    bvh_curve_leaf_size = 1;
     hair_subdivisions = 3;
     hair_shape = CURVE_RIBBON;
     persistent_data = false;
     texture_limit = 0;
+    texture_cache_size = 0;
     background = true;
   }
 
@@ -201,8 +210,10 @@ class SceneParams {
              use_bvh_spatial_split == params.use_bvh_spatial_split &&
              use_bvh_unaligned_nodes == params.use_bvh_unaligned_nodes &&
              num_bvh_time_steps == params.num_bvh_time_steps &&
+             bvh_curve_leaf_size == params.bvh_curve_leaf_size &&
              hair_subdivisions == params.hair_subdivisions && hair_shape == params.hair_shape &&
-             persistent_data == params.persistent_data && texture_limit == params.texture_limit);
+             persistent_data == params.persistent_data && texture_limit == params.texture_limit &&
+             texture_cache_size == params.texture_cache_size);
   }
 
   int curve_subdivisions()
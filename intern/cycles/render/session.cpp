@@ -387,35 +387,88 @@ bool Session::draw_cpu(BufferParams &buffer_params, DeviceDrawParams &draw_param
   return false;
 }
 
+bool Session::can_steal_from_device(int victim_num, int stealer_num)
+{
+  const TileStealingDevice &victim = stealing_devices[victim_num];
+  const TileStealingDevice &stealer = stealing_devices[stealer_num];
+
+  /* Devices that can get their tiles stolen by any GPU don't steal tiles themselves. */
+  if (stealer.is_cpu) {
+    return false;
+  }
+  if (victim.is_cpu) {
+    return true;
+  }
+
+  /* Moving a tile between GPUs costs a buffer copy, so only do it when the stealing device is
+   * measurably faster than the one currently rendering the tile. */
+  return victim.throughput > 0.0 && stealer.throughput > victim.throughput * 1.25;
+}
+
+bool Session::has_stealable_tiles(int stealer_num)
+{
+  for (int i = 0; i < stealing_devices.size(); i++) {
+    if (stealing_devices[i].stealable_tiles > 0 && can_steal_from_device(i, stealer_num)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Session::update_device_throughput(const RenderTile &rtile)
+{
+  const int num_samples = rtile.sample - rtile.start_sample;
+  const double render_time = time_dt() - rtile.acquire_time;
+  if (num_samples <= 0 || render_time <= 0.0) {
+    return;
+  }
+
+  /* Exponential moving average of the pixel samples per second, so the estimate follows changes
+   * in scene complexity between tiles without jumping around on a single noisy tile. */
+  const double throughput = (double)rtile.w * rtile.h * num_samples / render_time;
+  TileStealingDevice &tile_device = stealing_devices[rtile.device_num];
+  if (tile_device.throughput == 0.0) {
+    tile_device.throughput = throughput;
+  }
+  else {
+    tile_device.throughput = 0.75 * tile_device.throughput + 0.25 * throughput;
+  }
+}
+
 bool Session::steal_tile(RenderTile &rtile, Device *tile_device, thread_scoped_lock &tile_lock)
 {
-  /* Devices that can get their tiles stolen don't steal tiles themselves.
-   * Additionally, if there are no stealable tiles in flight, give up here. */
-  if (tile_device->info.type == DEVICE_CPU || stealable_tiles == 0) {
+  const int device_num = device->device_number(tile_device);
+
+  /* If there are no tiles in flight on devices slower than this one, give up here. */
+  if (!has_stealable_tiles(device_num)) {
     return false;
   }
 
   /* Wait until no other thread is trying to steal a tile. */
-  while (tile_stealing_state != NOT_STEALING && stealable_tiles > 0) {
+  while (tile_stealing_state != NOT_STEALING && has_stealable_tiles(device_num)) {
     /* Someone else is currently trying to get a tile.
      * Wait on the condition variable and try later. */
     tile_steal_cond.wait(tile_lock);
   }
   /* If another thread stole the last stealable tile in the meantime, give up. */
-  if (stealable_tiles == 0) {
+  if (!has_stealable_tiles(device_num)) {
     return false;
   }
 
   /* There are stealable tiles in flight, so signal that one should be released. */
+  stealing_device_num = device_num;
   tile_stealing_state = WAITING_FOR_TILE;
 
-  /* Wait until a device notices the signal and releases its tile. */
-  while (tile_stealing_state != GOT_TILE && stealable_tiles > 0) {
+  /* Wait until a device notices the signal and releases its tile. A tile that is already being
+   * released has to be picked up, even if the throughput estimates changed in the meantime. */
+  while (tile_stealing_state != GOT_TILE &&
+         (tile_stealing_state == RELEASING_TILE || has_stealable_tiles(device_num))) {
     tile_steal_cond.wait(tile_lock);
   }
   /* If the last stealable tile finished on its own, give up. */
   if (tile_stealing_state != GOT_TILE) {
     tile_stealing_state = NOT_STEALING;
+    tile_steal_cond.notify_all();
     return false;
   }
 
@@ -426,21 +479,35 @@ bool Session::steal_tile(RenderTile &rtile, Device *tile_device, thread_scoped_l
   rtile.stealing_state = RenderTile::NO_STEALING;
   rtile.num_samples -= (rtile.sample - rtile.start_sample);
   rtile.start_sample = rtile.sample;
+  rtile.device_num = device_num;
+  rtile.acquire_time = time_dt();
 
   tile_stealing_state = NOT_STEALING;
 
   /* Poke any threads which might be waiting for NOT_STEALING above. */
-  tile_steal_cond.notify_one();
+  tile_steal_cond.notify_all();
 
   return true;
 }
 
-bool Session::get_tile_stolen()
+bool Session::get_tile_stolen(const RenderTile &rtile)
 {
+  /* Cheap check first, this is called for every sample of a stealable tile. */
+  if (tile_stealing_state != WAITING_FOR_TILE) {
+    return false;
+  }
+
+  thread_scoped_lock tile_lock(tile_mutex);
+
+  /* Only release the tile if the waiting device is faster than the one rendering it. */
+  if (!can_steal_from_device(rtile.device_num, stealing_device_num)) {
+    return false;
+  }
+
   /* If tile_stealing_state is WAITING_FOR_TILE, atomically set it to RELEASING_TILE
    * and return true. */
   TileStealingState expected = WAITING_FOR_TILE;
-  return tile_stealing_state.compare_exchange_weak(expected, RELEASING_TILE);
+  return tile_stealing_state.compare_exchange_strong(expected, RELEASING_TILE);
 }
 
 bool Session::acquire_tile(RenderTile &rtile, Device *tile_device, uint tile_types)
@@ -458,6 +525,11 @@ bool Session::acquire_tile(RenderTile &rtile, Device *tile_device, uint tile_typ
   Tile *tile;
   int device_num = device->device_number(tile_device);
 
+  if (device_num >= stealing_devices.size()) {
+    stealing_devices.resize(device_num + 1);
+  }
+  stealing_devices[device_num].is_cpu = (tile_device->info.type == DEVICE_CPU);
+
   while (!tile_manager.next_tile(tile, device_num, tile_types)) {
     /* Wait for denoising tiles to become available */
     if ((tile_types & RenderTile::DENOISE) && !progress.get_cancel() && tile_manager.has_tiles()) {
@@ -477,13 +549,20 @@ bool Session::acquire_tile(RenderTile &rtile, Device *tile_device, uint tile_typ
   rtile.num_samples = tile_manager.state.num_samples;
   rtile.resolution = tile_manager.state.resolution_divider;
   rtile.tile_index = tile->index;
+  rtile.device_num = device_num;
+  rtile.acquire_time = time_dt();
 
   if (tile->state == Tile::DENOISE) {
     rtile.task = RenderTile::DENOISE;
   }
   else {
-    if (tile_device->info.type == DEVICE_CPU) {
-      stealable_tiles++;
+    /* CPU tiles can be stolen by any GPU. CUDA and OptiX tiles can be stolen by faster GPUs,
+     * except with adaptive sampling which needs to finalize the tile on the same device. */
+    const DeviceType device_type = tile_device->info.type;
+    if (device_type == DEVICE_CPU ||
+        (!params.adaptive_sampling && !read_bake_tile_cb &&
+         (device_type == DEVICE_CUDA || device_type == DEVICE_OPTIX))) {
+      stealing_devices[device_num].stealable_tiles++;
       rtile.stealing_state = RenderTile::CAN_BE_STOLEN;
     }
 
@@ -577,8 +656,12 @@ void Session::release_tile(RenderTile &rtile, const bool need_denoise)
 {
   thread_scoped_lock tile_lock(tile_mutex);
 
+  if (rtile.task == RenderTile::PATH_TRACE) {
+    update_device_throughput(rtile);
+  }
+
   if (rtile.stealing_state != RenderTile::NO_STEALING) {
-    stealable_tiles--;
+    stealing_devices[rtile.device_num].stealable_tiles--;
     if (rtile.stealing_state == RenderTile::WAS_STOLEN) {
       /* If the tile is being stolen, don't release it here - the new device will pick up where
        * the old one left off. */
@@ -591,8 +674,9 @@ void Session::release_tile(RenderTile &rtile, const bool need_denoise)
       tile_steal_cond.notify_all();
       return;
     }
-    else if (stealable_tiles == 0) {
-      /* If this was the last stealable tile, wake up any threads still waiting for one. */
+    else {
+      /* Wake up any threads waiting for a tile, in case this was the last one they could steal
+       * or the throughput estimates changed. */
       tile_steal_cond.notify_all();
     }
   }
@@ -904,7 +988,11 @@ void Session::reset_(BufferParams &buffer_params, int samples)
   }
 
   tile_manager.reset(buffer_params, samples);
-  stealable_tiles = 0;
+  /* Keep the throughput estimates, they remain valid across resets of the same session. */
+  foreach (TileStealingDevice &stealing_device, stealing_devices) {
+    stealing_device.stealable_tiles = 0;
+  }
+  stealing_device_num = 0;
   tile_stealing_state = NOT_STEALING;
   progress.reset_sample();
 
@@ -1162,7 +1250,7 @@ void Session::render(bool need_denoise)
   task.get_cancel = function_bind(&Progress::get_cancel, &this->progress);
   task.update_tile_sample = function_bind(&Session::update_tile_sample, this, _1);
   task.update_progress_sample = function_bind(&Progress::add_samples, &this->progress, _1, _2);
-  task.get_tile_stolen = function_bind(&Session::get_tile_stolen, this);
+  task.get_tile_stolen = function_bind(&Session::get_tile_stolen, this, _1);
   task.need_finish_queue = params.progressive_refine;
   task.integrator_branched = scene->integrator->get_method() == Integrator::BRANCHED_PATH;
 
@@ -195,7 +195,10 @@ class Session {
   bool render_need_denoise(bool &delayed);
 
   bool steal_tile(RenderTile &tile, Device *tile_device, thread_scoped_lock &tile_lock);
-  bool get_tile_stolen();
+  bool get_tile_stolen(const RenderTile &tile);
+  bool can_steal_from_device(int victim_num, int stealer_num);
+  bool has_stealable_tiles(int stealer_num);
+  void update_device_throughput(const RenderTile &tile);
   bool acquire_tile(RenderTile &tile, Device *tile_device, uint tile_types);
   void update_tile_sample(RenderTile &tile);
   void release_tile(RenderTile &tile, const bool need_denoise);
@@ -234,7 +237,21 @@ class Session {
     GOT_TILE /* A device has released a stealable tile, which is now stored in stolen_tile. */
   } TileStealingState;
   std::atomic<TileStealingState> tile_stealing_state;
-  int stealable_tiles;
+  /* Device number of the thread waiting for a tile, valid while WAITING_FOR_TILE. */
+  int stealing_device_num;
+
+  /* Per-device tile stealing state, indexed by the multi-device number. The throughput is an
+   * estimate of the path traced pixel samples per second, zero until the first tile finished. */
+  struct TileStealingDevice {
+    TileStealingDevice() : stealable_tiles(0), is_cpu(false), throughput(0.0)
+    {
+    }
+
+    int stealable_tiles;
+    bool is_cpu;
+    double throughput;
+  };
+  vector<TileStealingDevice> stealing_devices;
 
   /* progressive refine */
   bool update_progressive_refine(bool cancel);
@@ -252,6 +252,24 @@ string ImageStats::full_report(int indent_level)
   return result;
 }
 
+/* Device statistics. */
+
+DeviceStats::DeviceStats() : mem_used(0), mem_peak(0)
+{
+}
+
+string DeviceStats::full_report(int indent_level)
+{
+  const string indent(indent_level * kIndentNumSpaces, ' ');
+  string result = "";
+  result += string_printf("%sMemory used: %s (peak %s)\n",
+                          indent.c_str(),
+                          string_human_readable_size(mem_used).c_str(),
+                          string_human_readable_size(mem_peak).c_str());
+  result += indent + "Scene arrays:\n" + arrays.full_report(indent_level + 1);
+  return result;
+}
+
 /* Overall statistics. */
 
 RenderStats::RenderStats()
@@ -334,6 +352,7 @@ string RenderStats::full_report()
   string result = "";
   result += "Mesh statistics:\n" + mesh.full_report(1);
   result += "Image statistics:\n" + image.full_report(1);
+  result += "Device statistics:\n" + device.full_report(1);
   if (has_profiling) {
     result += "Kernel statistics:\n" + kernel.full_report(1);
     result += "Shader statistics:\n" + shaders.full_report(1);
@@ -363,6 +382,7 @@ string SceneUpdateStats::full_report()
   string result = "";
   result += "Scene:\n" + scene.full_report(1);
   result += "Geometry:\n" + geometry.full_report(1);
+  result += "BVH:\n" + bvh.full_report(1);
   result += "Light:\n" + light.full_report(1);
   result += "Object:\n" + object.full_report(1);
   result += "Image:\n" + image.full_report(1);
@@ -381,6 +401,7 @@ string SceneUpdateStats::full_report()
 void SceneUpdateStats::clear()
 {
   geometry.times.clear();
+  bvh.times.clear();
   image.times.clear();
   light.times.clear();
   object.times.clear();
@@ -173,6 +173,24 @@ class ImageStats {
   NamedSizeStats textures;
 };
 
+/* Statistics about memory allocated on the render device. */
+class DeviceStats {
+ public:
+  DeviceStats();
+
+  /* Generate full human-readable report. */
+  string full_report(int indent_level = 0);
+
+  /* Memory used by all device allocations when the statistics were collected, and the peak. */
+  size_t mem_used;
+  size_t mem_peak;
+
+  /* Packed scene arrays like the BVH, triangles and attributes. These are shared by all geometry
+   * in the scene, images are accounted for in ImageStats.
+   */
+  NamedSizeStats arrays;
+};
+
 /* Render process statistics. */
 class RenderStats {
  public:
@@ -188,6 +206,7 @@ class RenderStats {
 
   MeshStats mesh;
   ImageStats image;
+  DeviceStats device;
   NamedNestedSampleStats kernel;
   NamedSampleCountStats shaders;
   NamedSampleCountStats objects;
@@ -206,6 +225,8 @@ class SceneUpdateStats {
   SceneUpdateStats();
 
   UpdateTimeStats geometry;
+  /* Per geometry BVH build, these are also part of the geometry update time. */
+  UpdateTimeStats bvh;
   UpdateTimeStats image;
   UpdateTimeStats light;
   UpdateTimeStats object;
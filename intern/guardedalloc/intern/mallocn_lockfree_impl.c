@@ -20,6 +20,7 @@
  * Memory allocation which keeps track on allocated memory counters
  */
 
+#include <pthread.h>
 #include <stdarg.h>
 #include <stdlib.h>
 #include <string.h> /* memcpy */
@@ -70,6 +71,244 @@ MEM_INLINE void update_maximum(size_t *maximum_value, size_t value)
 #endif
 }
 
+#ifdef _MSC_VER
+#  define MEM_THREAD_LOCAL __declspec(thread)
+#else
+#  define MEM_THREAD_LOCAL __thread
+#endif
+
+/* -------------------------------------------------------------------- */
+/** \name Thread Cache
+ *
+ * Small blocks are rounded up to a size class and freed blocks are kept in a per-thread free
+ * list, so that small object churn does not have to go through the system allocator.
+ * Blocks can be freed from any thread, they simply end up in the cache of the freeing thread.
+ *
+ * Changes to the counters are accumulated per thread as well and only applied to the global
+ * counters once they get large, the queries add the pending changes of all threads.
+ * \{ */
+
+#define MEM_CACHE_CLASS_SHIFT 4
+#define MEM_CACHE_CLASS_NUM 16
+/* Largest block size (excluding the #MemHead) which is handled by the cache. */
+#define MEM_CACHE_MAX_LEN ((size_t)MEM_CACHE_CLASS_NUM << MEM_CACHE_CLASS_SHIFT)
+/* Maximum number of free blocks kept per size class, half of them are released when exceeded. */
+#define MEM_CACHE_CLASS_MAX_BLOCKS 64
+/* Pending counter changes which cause a flush to the global counters. */
+#define MEM_CACHE_FLUSH_LEN ((size_t)1 << 20)
+#define MEM_CACHE_FLUSH_BLOCKS 1024u
+
+typedef struct MemFreeBlock {
+  struct MemFreeBlock *next;
+} MemFreeBlock;
+
+typedef struct MemThreadCache {
+  struct MemThreadCache *next, *prev;
+
+  MemFreeBlock *free_blocks[MEM_CACHE_CLASS_NUM];
+  unsigned int free_blocks_num[MEM_CACHE_CLASS_NUM];
+
+  /* Changes not applied to #totblock and #mem_in_use yet, using wrapping arithmetic.
+   * Only written by the owning thread, read by the queries while holding #thread_caches_lock. */
+  unsigned int totblock_delta;
+  size_t mem_in_use_delta;
+} MemThreadCache;
+
+static MemThreadCache *thread_caches = NULL;
+static pthread_mutex_t thread_caches_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t thread_cache_key;
+static pthread_once_t thread_cache_key_once = PTHREAD_ONCE_INIT;
+static bool thread_cache_key_valid = false;
+
+static MEM_THREAD_LOCAL MemThreadCache *thread_cache = NULL;
+/* Set once the cache of the thread has been destroyed on thread exit, so late allocations from
+ * other thread-local destructors don't create a new one. */
+static MEM_THREAD_LOCAL bool thread_cache_disabled = false;
+
+MEM_INLINE bool mem_cache_len_is_small(size_t len)
+{
+  return len <= MEM_CACHE_MAX_LEN;
+}
+
+MEM_INLINE unsigned int mem_cache_class_index(size_t len)
+{
+  return len ? (unsigned int)((len - 1) >> MEM_CACHE_CLASS_SHIFT) : 0;
+}
+
+/* Number of bytes to allocate for the data of a block, small blocks are rounded up to their size
+ * class so they can be reused for any length of that class. */
+MEM_INLINE size_t mem_alloc_len(size_t len)
+{
+  if (mem_cache_len_is_small(len)) {
+    return (size_t)(mem_cache_class_index(len) + 1) << MEM_CACHE_CLASS_SHIFT;
+  }
+  return len;
+}
+
+static void thread_cache_destroy(void *value)
+{
+  MemThreadCache *cache = (MemThreadCache *)value;
+
+  thread_cache = NULL;
+  thread_cache_disabled = true;
+
+  pthread_mutex_lock(&thread_caches_lock);
+  atomic_add_and_fetch_u(&totblock, cache->totblock_delta);
+  atomic_add_and_fetch_z(&mem_in_use, cache->mem_in_use_delta);
+  if (cache->prev) {
+    cache->prev->next = cache->next;
+  }
+  else {
+    thread_caches = cache->next;
+  }
+  if (cache->next) {
+    cache->next->prev = cache->prev;
+  }
+  pthread_mutex_unlock(&thread_caches_lock);
+
+  for (int i = 0; i < MEM_CACHE_CLASS_NUM; i++) {
+    MemFreeBlock *block = cache->free_blocks[i];
+    while (block) {
+      MemFreeBlock *next = block->next;
+      free(block);
+      block = next;
+    }
+  }
+  free(cache);
+}
+
+static void thread_cache_key_init(void)
+{
+  thread_cache_key_valid = (pthread_key_create(&thread_cache_key, thread_cache_destroy) == 0);
+}
+
+static MemThreadCache *thread_cache_create(void)
+{
+  pthread_once(&thread_cache_key_once, thread_cache_key_init);
+  if (!thread_cache_key_valid) {
+    thread_cache_disabled = true;
+    return NULL;
+  }
+
+  MemThreadCache *cache = (MemThreadCache *)calloc(1, sizeof(MemThreadCache));
+  if (cache == NULL) {
+    return NULL;
+  }
+
+  pthread_mutex_lock(&thread_caches_lock);
+  cache->next = thread_caches;
+  if (thread_caches) {
+    thread_caches->prev = cache;
+  }
+  thread_caches = cache;
+  pthread_mutex_unlock(&thread_caches_lock);
+
+  pthread_setspecific(thread_cache_key, cache);
+  thread_cache = cache;
+  return cache;
+}
+
+MEM_INLINE MemThreadCache *thread_cache_get(void)
+{
+  MemThreadCache *cache = thread_cache;
+  if (LIKELY(cache)) {
+    return cache;
+  }
+  if (thread_cache_disabled) {
+    return NULL;
+  }
+  return thread_cache_create();
+}
+
+static void thread_cache_flush_counters(MemThreadCache *cache)
+{
+  /* Hold the lock so the queries never count the pending changes twice. */
+  pthread_mutex_lock(&thread_caches_lock);
+  atomic_add_and_fetch_u(&totblock, cache->totblock_delta);
+  const size_t mem_in_use_new = atomic_add_and_fetch_z(&mem_in_use, cache->mem_in_use_delta);
+  cache->totblock_delta = 0;
+  cache->mem_in_use_delta = 0;
+  pthread_mutex_unlock(&thread_caches_lock);
+
+  update_maximum(&peak_mem, mem_in_use_new);
+}
+
+MEM_INLINE void thread_cache_check_counters(MemThreadCache *cache)
+{
+  /* The deltas wrap around, so check the magnitude in both directions. */
+  if (UNLIKELY((cache->mem_in_use_delta >= MEM_CACHE_FLUSH_LEN &&
+                -cache->mem_in_use_delta >= MEM_CACHE_FLUSH_LEN) ||
+               (cache->totblock_delta >= MEM_CACHE_FLUSH_BLOCKS &&
+                -cache->totblock_delta >= MEM_CACHE_FLUSH_BLOCKS))) {
+    thread_cache_flush_counters(cache);
+  }
+}
+
+/* Pop a free block of the size class of `len`, returns NULL when there is none. */
+MEM_INLINE MemHead *thread_cache_pop(MemThreadCache *cache, size_t len)
+{
+  const unsigned int index = mem_cache_class_index(len);
+  MemFreeBlock *block = cache->free_blocks[index];
+  if (block) {
+    cache->free_blocks[index] = block->next;
+    cache->free_blocks_num[index]--;
+  }
+  return (MemHead *)block;
+}
+
+static void thread_cache_push(MemThreadCache *cache, MemHead *memh, size_t len)
+{
+  const unsigned int index = mem_cache_class_index(len);
+
+  if (UNLIKELY(cache->free_blocks_num[index] >= MEM_CACHE_CLASS_MAX_BLOCKS)) {
+    /* Give half of the blocks back, keeping the most recently freed ones. */
+    MemFreeBlock *block = cache->free_blocks[index];
+    for (int i = 1; i < MEM_CACHE_CLASS_MAX_BLOCKS / 2; i++) {
+      block = block->next;
+    }
+    MemFreeBlock *release = block->next;
+    block->next = NULL;
+    cache->free_blocks_num[index] = MEM_CACHE_CLASS_MAX_BLOCKS / 2;
+    while (release) {
+      MemFreeBlock *next = release->next;
+      free(release);
+      release = next;
+    }
+  }
+
+  MemFreeBlock *block = (MemFreeBlock *)memh;
+  block->next = cache->free_blocks[index];
+  cache->free_blocks[index] = block;
+  cache->free_blocks_num[index]++;
+}
+
+MEM_INLINE void mem_counters_add(MemThreadCache *cache, size_t len)
+{
+  if (LIKELY(cache)) {
+    cache->totblock_delta++;
+    cache->mem_in_use_delta += len;
+    thread_cache_check_counters(cache);
+    return;
+  }
+  atomic_add_and_fetch_u(&totblock, 1);
+  atomic_add_and_fetch_z(&mem_in_use, len);
+  update_maximum(&peak_mem, mem_in_use);
+}
+
+MEM_INLINE void mem_counters_sub(MemThreadCache *cache, size_t len)
+{
+  if (LIKELY(cache)) {
+    cache->totblock_delta--;
+    cache->mem_in_use_delta -= len;
+    thread_cache_check_counters(cache);
+    return;
+  }
+  atomic_sub_and_fetch_u(&totblock, 1);
+  atomic_sub_and_fetch_z(&mem_in_use, len);
+}
+
+/** \} */
+
 #ifdef __GNUC__
 __attribute__((format(printf, 1, 2)))
 #endif
@@ -115,8 +354,8 @@ void MEM_lockfree_freeN(void *vmemh)
     return;
   }
 
-  atomic_sub_and_fetch_u(&totblock, 1);
-  atomic_sub_and_fetch_z(&mem_in_use, len);
+  MemThreadCache *cache = thread_cache_get();
+  mem_counters_sub(cache, len);
 
   if (UNLIKELY(malloc_debug_memset && len)) {
     memset(memh + 1, 255, len);
@@ -125,6 +364,9 @@ void MEM_lockfree_freeN(void *vmemh)
     MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
     aligned_free(MEMHEAD_REAL_PTR(memh_aligned));
   }
+  else if (cache && mem_cache_len_is_small(len)) {
+    thread_cache_push(cache, memh, len);
+  }
   else {
     free(memh);
   }
@@ -228,17 +470,24 @@ void *MEM_lockfree_recallocN_id(void *vmemh, size_t len, const char *str)
 
 void *MEM_lockfree_callocN(size_t len, const char *str)
 {
-  MemHead *memh;
+  MemHead *memh = NULL;
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)calloc(1, len + sizeof(MemHead));
+  MemThreadCache *cache = thread_cache_get();
+  if (cache && mem_cache_len_is_small(len)) {
+    memh = thread_cache_pop(cache, len);
+    if (memh) {
+      memset(memh + 1, 0, len);
+    }
+  }
+  if (memh == NULL) {
+    memh = (MemHead *)calloc(1, mem_alloc_len(len) + sizeof(MemHead));
+  }
 
   if (LIKELY(memh)) {
     memh->len = len;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    mem_counters_add(cache, len);
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -269,11 +518,17 @@ void *MEM_lockfree_calloc_arrayN(size_t len, size_t size, const char *str)
 
 void *MEM_lockfree_mallocN(size_t len, const char *str)
 {
-  MemHead *memh;
+  MemHead *memh = NULL;
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)malloc(len + sizeof(MemHead));
+  MemThreadCache *cache = thread_cache_get();
+  if (cache && mem_cache_len_is_small(len)) {
+    memh = thread_cache_pop(cache, len);
+  }
+  if (memh == NULL) {
+    memh = (MemHead *)malloc(mem_alloc_len(len) + sizeof(MemHead));
+  }
 
   if (LIKELY(memh)) {
     if (UNLIKELY(malloc_debug_memset && len)) {
@@ -281,9 +536,7 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
     }
 
     memh->len = len;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    mem_counters_add(cache, len);
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -352,9 +605,7 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
 
     memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG;
     memh->alignment = (short)alignment;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    mem_counters_add(thread_cache_get(), len);
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -381,7 +632,8 @@ void MEM_lockfree_callbackmemlist(void (*func)(void *))
 
 void MEM_lockfree_printmemlist_stats(void)
 {
-  printf("\ntotal memory len: %.3f MB\n", (double)mem_in_use / (double)(1024 * 1024));
+  printf("\ntotal memory len: %.3f MB\n",
+         (double)MEM_lockfree_get_memory_in_use() / (double)(1024 * 1024));
   printf("peak memory len: %.3f MB\n", (double)peak_mem / (double)(1024 * 1024));
   printf(
       "\nFor more detailed per-block statistics run Blender with memory debugging command line "
@@ -410,23 +662,37 @@ void MEM_lockfree_set_memory_debug(void)
 
 size_t MEM_lockfree_get_memory_in_use(void)
 {
-  return mem_in_use;
+  pthread_mutex_lock(&thread_caches_lock);
+  size_t total = mem_in_use;
+  for (MemThreadCache *cache = thread_caches; cache; cache = cache->next) {
+    total += cache->mem_in_use_delta;
+  }
+  pthread_mutex_unlock(&thread_caches_lock);
+  return total;
 }
 
 unsigned int MEM_lockfree_get_memory_blocks_in_use(void)
 {
-  return totblock;
+  pthread_mutex_lock(&thread_caches_lock);
+  unsigned int total = totblock;
+  for (MemThreadCache *cache = thread_caches; cache; cache = cache->next) {
+    total += cache->totblock_delta;
+  }
+  pthread_mutex_unlock(&thread_caches_lock);
+  return total;
 }
 
 /* dummy */
 void MEM_lockfree_reset_peak_memory(void)
 {
-  peak_mem = mem_in_use;
+  peak_mem = MEM_lockfree_get_memory_in_use();
 }
 
 size_t MEM_lockfree_get_peak_memory(void)
 {
-  return peak_mem;
+  /* The peak is only updated when counters are flushed, include the pending changes. */
+  const size_t mem_in_use_total = MEM_lockfree_get_memory_in_use();
+  return (mem_in_use_total > peak_mem) ? mem_in_use_total : peak_mem;
 }
 
 #ifndef NDEBUG
@@ -0,0 +1,73 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <thread>
+#include <vector>
+
+#include "MEM_guardedalloc.h"
+
+#include "guardedalloc_test_base.h"
+
+TEST_F(LockFreeAllocatorTest, LockfreeSmallBlockReuse)
+{
+  const size_t mem_in_use = MEM_get_memory_in_use();
+  const unsigned int blocks_in_use = MEM_get_memory_blocks_in_use();
+
+  /* Blocks of the same size class are reused, the length must still be exact. */
+  void *mem = MEM_mallocN(20, __func__);
+  EXPECT_EQ(MEM_allocN_len(mem), 20);
+  MEM_freeN(mem);
+
+  char *mem_zero = (char *)MEM_callocN(28, __func__);
+  EXPECT_EQ(MEM_allocN_len(mem_zero), 28);
+  for (int i = 0; i < 28; i++) {
+    EXPECT_EQ(mem_zero[i], 0);
+  }
+
+  mem_zero = (char *)MEM_reallocN(mem_zero, 1000);
+  EXPECT_EQ(MEM_allocN_len(mem_zero), 1000);
+  MEM_freeN(mem_zero);
+
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use);
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_in_use);
+}
+
+TEST_F(LockFreeAllocatorTest, LockfreeCountersAcrossThreads)
+{
+  const size_t mem_in_use = MEM_get_memory_in_use();
+  const unsigned int blocks_in_use = MEM_get_memory_blocks_in_use();
+
+  const int threads_num = 4;
+  const int blocks_num = 5000;
+  std::vector<void *> blocks[threads_num];
+
+  /* Allocate on some threads, free on others. */
+  std::vector<std::thread> threads;
+  for (int i = 0; i < threads_num; i++) {
+    threads.emplace_back([&blocks, i]() {
+      for (int j = 0; j < blocks_num; j++) {
+        blocks[i].push_back(MEM_mallocN((size_t)(j % 300), __func__));
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_in_use + threads_num * blocks_num);
+
+  threads.clear();
+  for (int i = 0; i < threads_num; i++) {
+    threads.emplace_back([&blocks, i]() {
+      for (void *mem : blocks[(i + 1) % threads_num]) {
+        MEM_freeN(mem);
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use);
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_in_use);
+}
@@ -631,8 +631,16 @@ def bake_guiding_$ID$(path_guiding, framenr, format_guiding, resumable):\n\
 
 const std::string fluid_file_import =
     "\n\
+# Wait for the files written by fluid_file_export_async, so that they are complete when read.\n\
+def fluid_file_export_wait_s$ID$():\n\
+    process = globals().get('fluid_file_export_process_s$ID$')\n\
+    if process is not None:\n\
+        process.join()\n\
+        globals()['fluid_file_export_process_s$ID$'] = None\n\
+\n\
 def fluid_file_import_s$ID$(dict, path, framenr, file_format, file_name=None):\n\
     mantaMsg('Fluid file import, frame: ' + str(framenr))\n\
+    fluid_file_export_wait_s$ID$()\n\
     try:\n\
         framenr = fluid_cache_get_framenr_formatted_$ID$(framenr)\n\
         # New cache: Try to load the data from a single file\n\
@@ -711,7 +719,16 @@ def fluid_file_export_s$ID$(framenr, file_format, path, dict, file_name=None, mo
     \n\
     except Exception as e:\n\
         mantaMsg('Exception in Python fluid file export: ' + str(e))\n\
-        pass # Just skip file save errors for now\n";
+        pass # Just skip file save errors for now\n\
+\n\
+# Write the files from a forked process, which keeps a copy-on-write snapshot of the grids\n\
+# while the simulation continues with the next frame. Only one write is pending at a time.\n\
+def fluid_file_export_async_s$ID$(framenr, file_format, path, dict, file_name=None):\n\
+    fluid_file_export_wait_s$ID$()\n\
+    kwargs = {'framenr': framenr, 'file_format': file_format, 'path': path, 'dict': dict, 'file_name': file_name}\n\
+    process = multiprocessing.Process(target=fluid_file_export_s$ID$, kwargs=kwargs)\n\
+    process.start()\n\
+    globals()['fluid_file_export_process_s$ID$'] = process\n";
 
 const std::string fluid_save_guiding =
     "\n\
@@ -721,7 +738,7 @@ def fluid_save_guiding_$ID$(path, framenr, file_format, resumable):\n\
     if not withMPSave or isWindows:\n\
         fluid_file_export_s$ID$(dict=dict, framenr=framenr, file_format=file_format, path=path, file_name=file_guiding_s$ID$)\n\
     else:\n\
-        fluid_cache_multiprocessing_start_$ID$(function=fluid_file_export_s$ID$, file_name=file_guiding_s$ID$, framenr=framenr, format_data=file_format, path_data=path, dict=dict, do_join=False)\n";
+        fluid_file_export_async_s$ID$(dict=dict, framenr=framenr, file_format=file_format, path=path, file_name=file_guiding_s$ID$)\n";
 
 //////////////////////////////////////////////////////////////////////
 // STANDALONE MODE
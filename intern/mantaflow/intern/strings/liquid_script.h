@@ -461,7 +461,7 @@ def liquid_save_data_$ID$(path, framenr, file_format, resumable):\n\
     if not withMPSave or isWindows:\n\
         fluid_file_export_s$ID$(dict=dict, path=path, framenr=framenr, file_format=file_format, file_name=file_data_s$ID$)\n\
     else:\n\
-        fluid_cache_multiprocessing_start_$ID$(function=fluid_file_export_s$ID$, file_name=file_data_s$ID$, framenr=framenr, format_data=file_format, path_data=path, dict=dict, do_join=False)\n";
+        fluid_file_export_async_s$ID$(dict=dict, path=path, framenr=framenr, file_format=file_format, file_name=file_data_s$ID$)\n";
 
 const std::string liquid_save_mesh =
     "\n\
@@ -471,7 +471,7 @@ def liquid_save_mesh_$ID$(path, framenr, file_format):\n\
     if not withMPSave or isWindows:\n\
          fluid_file_export_s$ID$(dict=dict, path=path, framenr=framenr, file_format=file_format, file_name=file_mesh_s$ID$)\n\
     else:\n\
-         fluid_cache_multiprocessing_start_$ID$(function=fluid_file_export_s$ID$, file_name=file_mesh_s$ID$, framenr=framenr, format_data=file_format, path_data=path, dict=dict, do_join=False)\n\
+         fluid_file_export_async_s$ID$(dict=dict, path=path, framenr=framenr, file_format=file_format, file_name=file_mesh_s$ID$)\n\
 \n\
 def liquid_save_meshvel_$ID$(path, framenr, file_format):\n\
     mantaMsg('Liquid save mesh vel')\n\
@@ -479,7 +479,7 @@ def liquid_save_meshvel_$ID$(path, framenr, file_format):\n\
     if not withMPSave or isWindows:\n\
         fluid_file_export_s$ID$(dict=dict, path=path, framenr=framenr, file_format=file_format)\n\
     else:\n\
-        fluid_cache_multiprocessing_start_$ID$(function=fluid_file_export_s$ID$, framenr=framenr, format_data=file_format, path_data=path, dict=dict, do_join=False)\n";
+        fluid_file_export_async_s$ID$(dict=dict, path=path, framenr=framenr, file_format=file_format)\n";
 
 const std::string liquid_save_particles =
     "\n\
@@ -489,7 +489,7 @@ def liquid_save_particles_$ID$(path, framenr, file_format, resumable):\n\
     if not withMPSave or isWindows:\n\
         fluid_file_export_s$ID$(dict=dict, path=path, framenr=framenr, file_format=file_format, file_name=file_particles_s$ID$)\n\
     else:\n\
-        fluid_cache_multiprocessing_start_$ID$(function=fluid_file_export_s$ID$, file_name=file_particles_s$ID$, framenr=framenr, format_data=file_format, path_data=path, dict=dict, do_join=False)\n";
+        fluid_file_export_async_s$ID$(dict=dict, path=path, framenr=framenr, file_format=file_format, file_name=file_particles_s$ID$)\n";
 
 //////////////////////////////////////////////////////////////////////
 // STANDALONE MODE
@@ -209,9 +209,30 @@ static tbool GenerateTSpaces(STSpace psTspace[],
                              const SGroup pGroups[],
                              const int iNrActiveGroups,
                              const int piTriListIn[],
+                             const int iNrTrianglesIn,
                              const float fThresCos,
                              const SMikkTSpaceContext *pContext);
 
+// Number of triangles respectively groups handled by a single task, when the application
+// provides the m_runTasks() call-back.
+#define TRIANGLES_PER_TASK 4096
+#define GROUPS_PER_TASK 1024
+
+static void RunTasks(const SMikkTSpaceContext *pContext,
+                     void (*task)(void *pTaskData, const int iTask),
+                     void *pTaskData,
+                     const int iNrTasks)
+{
+  if (pContext->m_pInterface->m_runTasks != NULL && iNrTasks > 1) {
+    pContext->m_pInterface->m_runTasks(pContext, task, pTaskData, iNrTasks);
+  }
+  else {
+    int t = 0;
+    for (t = 0; t < iNrTasks; t++)
+      task(pTaskData, t);
+  }
+}
+
 MIKK_INLINE int MakeIndex(const int iFace, const int iVert)
 {
   assert(iVert >= 0 && iVert < 4 && iFace >= 0);
@@ -396,8 +417,14 @@ tbool genTangSpace(const SMikkTSpaceContext *pContext, const float fAngularThres
   // based on fAngularThreshold. Finally a tangent space is made for
   // every resulting subgroup
   // printf("gen tspaces begin\n");
-  bRes = GenerateTSpaces(
-      psTspace, pTriInfos, pGroups, iNrActiveGroups, piTriListIn, fThresCos, pContext);
+  bRes = GenerateTSpaces(psTspace,
+                         pTriInfos,
+                         pGroups,
+                         iNrActiveGroups,
+                         piTriListIn,
+                         iNrTrianglesIn,
+                         fThresCos,
+                         pContext);
   // printf("gen tspaces end\n");
 
   // clean up
@@ -845,17 +872,26 @@ static float CalcTexArea(const SMikkTSpaceContext *pContext, const int indices[]
   return fSignedAreaSTx2 < 0 ? (-fSignedAreaSTx2) : fSignedAreaSTx2;
 }
 
-static void InitTriInfo(STriInfo pTriInfos[],
-                        const int piTriListIn[],
-                        const SMikkTSpaceContext *pContext,
-                        const int iNrTrianglesIn)
+typedef struct {
+  STriInfo *pTriInfos;
+  const int *piTriListIn;
+  const SMikkTSpaceContext *pContext;
+  int iNrTrianglesIn;
+} SInitTriInfoTaskData;
+
+// Initializes the triangle level attributes, which only depend on the triangle itself.
+static void InitTriInfoRange(STriInfo pTriInfos[],
+                             const int piTriListIn[],
+                             const SMikkTSpaceContext *pContext,
+                             const int iFirst,
+                             const int iLast)
 {
-  int f = 0, i = 0, t = 0;
+  int f = 0, i = 0;
   // pTriInfos[f].iFlag is cleared in GenerateInitialVerticesIndexList()
   // which is called before this function.
 
   // generate neighbor info list
-  for (f = 0; f < iNrTrianglesIn; f++)
+  for (f = iFirst; f < iLast; f++)
     for (i = 0; i < 3; i++) {
       pTriInfos[f].FaceNeighbors[i] = -1;
       pTriInfos[f].AssignedGroup[i] = NULL;
@@ -874,7 +910,7 @@ static void InitTriInfo(STriInfo pTriInfos[],
     }
 
   // evaluate first order derivatives
-  for (f = 0; f < iNrTrianglesIn; f++) {
+  for (f = iFirst; f < iLast; f++) {
     // initial values
     const SVec3 v1 = GetPosition(pContext, piTriListIn[f * 3 + 0]);
     const SVec3 v2 = GetPosition(pContext, piTriListIn[f * 3 + 1]);
@@ -916,6 +952,36 @@ static void InitTriInfo(STriInfo pTriInfos[],
         pTriInfos[f].iFlag &= (~GROUP_WITH_ANY);
     }
   }
+}
+
+static void InitTriInfoTask(void *pTaskData, const int iTask)
+{
+  SInitTriInfoTaskData *pData = (SInitTriInfoTaskData *)pTaskData;
+  const int iFirst = iTask * TRIANGLES_PER_TASK;
+  const int iLast = iFirst + TRIANGLES_PER_TASK < pData->iNrTrianglesIn ?
+                        iFirst + TRIANGLES_PER_TASK :
+                        pData->iNrTrianglesIn;
+  InitTriInfoRange(pData->pTriInfos, pData->piTriListIn, pData->pContext, iFirst, iLast);
+}
+
+static void InitTriInfo(STriInfo pTriInfos[],
+                        const int piTriListIn[],
+                        const SMikkTSpaceContext *pContext,
+                        const int iNrTrianglesIn)
+{
+  int t = 0;
+
+  {
+    SInitTriInfoTaskData sData;
+    sData.pTriInfos = pTriInfos;
+    sData.piTriListIn = piTriListIn;
+    sData.pContext = pContext;
+    sData.iNrTrianglesIn = iNrTrianglesIn;
+    RunTasks(pContext,
+             InitTriInfoTask,
+             &sData,
+             (iNrTrianglesIn + TRIANGLES_PER_TASK - 1) / TRIANGLES_PER_TASK);
+  }
 
   // force otherwise healthy quads to a fixed orientation
   while (t < (iNrTrianglesIn - 1)) {
@@ -1117,19 +1183,64 @@ static STSpace EvalTspace(int face_indices[],
                           const SMikkTSpaceContext *pContext,
                           const int iVertexRepresentitive);
 
-static tbool GenerateTSpaces(STSpace psTspace[],
-                             const STriInfo pTriInfos[],
-                             const SGroup pGroups[],
-                             const int iNrActiveGroups,
-                             const int piTriListIn[],
-                             const float fThresCos,
-                             const SMikkTSpaceContext *pContext)
+// Writes the tangent space of a subgroup to the corner of triangle f owned by pGroup.
+static void OutputTSpace(STSpace psTspace[],
+                         const STriInfo *pTriInfo,
+                         const int index,
+                         const SGroup *pGroup,
+                         const STSpace *pTS_in)
+{
+  const int iOffs = pTriInfo->iTSpacesOffs;
+  const int iVert = pTriInfo->vert_num[index];
+  STSpace *pTS_out = &psTspace[iOffs + iVert];
+  assert(pTS_out->iCounter < 2);
+  assert(((pTriInfo->iFlag & ORIENT_PRESERVING) != 0) == pGroup->bOrientPreservering);
+  if (pTS_out->iCounter == 1) {
+    *pTS_out = AvgTSpace(pTS_out, pTS_in);
+    pTS_out->iCounter = 2;  // update counter
+    pTS_out->bOrient = pGroup->bOrientPreservering;
+  }
+  else {
+    assert(pTS_out->iCounter == 0);
+    *pTS_out = *pTS_in;
+    pTS_out->iCounter = 1;  // update counter
+    pTS_out->bOrient = pGroup->bOrientPreservering;
+  }
+}
+
+// Index of the corner of triangle f which belongs to pGroup.
+static int GroupCornerIndex(const STriInfo *pTriInfo, const SGroup *pGroup)
+{
+  int index = -1;
+  if (pTriInfo->AssignedGroup[0] == pGroup)
+    index = 0;
+  else if (pTriInfo->AssignedGroup[1] == pGroup)
+    index = 1;
+  else if (pTriInfo->AssignedGroup[2] == pGroup)
+    index = 2;
+  assert(index >= 0 && index < 3);
+  return index;
+}
+
+// Makes the tangent spaces of the groups in the range {iFirstGroup, ..., iLastGroup-1}.
+// When pCornerTspace is NULL the results are accumulated into psTspace directly, otherwise
+// the tangent space of every group corner is stored in pCornerTspace[f * 3 + index], so they
+// can be accumulated later on in a fixed order.
+static tbool GenerateTSpacesRange(STSpace psTspace[],
+                                  STSpace pCornerTspace[],
+                                  const STriInfo pTriInfos[],
+                                  const SGroup pGroups[],
+                                  const int iFirstGroup,
+                                  const int iLastGroup,
+                                  const int piTriListIn[],
+                                  const float fThresCos,
+                                  const SMikkTSpaceContext *pContext)
 {
   STSpace *pSubGroupTspace = NULL;
   SSubGroup *pUniSubGroups = NULL;
   int *pTmpMembers = NULL;
-  int iMaxNrFaces = 0, iUniqueTspaces = 0, g = 0, i = 0;
-  for (g = 0; g < iNrActiveGroups; g++)
+  int iMaxNrFaces = 0, g = 0, i = 0;
+  for (g = iFirstGroup; g < iLastGroup; g++)
     if (iMaxNrFaces < pGroups[g].iNrFaces)
       iMaxNrFaces = pGroups[g].iNrFaces;
 
@@ -1150,8 +1261,7 @@ static tbool GenerateTSpaces(STSpace psTspace[],
     return TFALSE;
   }
 
-  iUniqueTspaces = 0;
-  for (g = 0; g < iNrActiveGroups; g++) {
+  for (g = iFirstGroup; g < iLastGroup; g++) {
     const SGroup *pGroup = &pGroups[g];
     int iUniqueSubGroups = 0, s = 0;
 
@@ -1162,13 +1272,7 @@ static tbool GenerateTSpaces(STSpace psTspace[],
       SSubGroup tmp_group;
       tbool bFound;
       SVec3 n, vOs, vOt;
-      if (pTriInfos[f].AssignedGroup[0] == pGroup)
-        index = 0;
-      else if (pTriInfos[f].AssignedGroup[1] == pGroup)
-        index = 1;
-      else if (pTriInfos[f].AssignedGroup[2] == pGroup)
-        index = 2;
-      assert(index >= 0 && index < 3);
+      index = GroupCornerIndex(&pTriInfos[f], pGroup);
 
       iVertIndex = piTriListIn[f * 3 + index];
       assert(iVertIndex == pGroup->iVertexRepresentitive);
@@ -1227,7 +1331,6 @@ static tbool GenerateTSpaces(STSpace psTspace[],
 
       // assign tangent space index
       assert(bFound || l == iUniqueSubGroups);
-      // piTempTangIndices[f*3+index] = iUniqueTspaces+l;
 
       // if no match was found we allocate a new subgroup
       if (!bFound) {
@@ -1256,30 +1359,15 @@ static tbool GenerateTSpaces(STSpace psTspace[],
       }
 
       // output tspace
-      {
-        const int iOffs = pTriInfos[f].iTSpacesOffs;
-        const int iVert = pTriInfos[f].vert_num[index];
-        STSpace *pTS_out = &psTspace[iOffs + iVert];
-        assert(pTS_out->iCounter < 2);
-        assert(((pTriInfos[f].iFlag & ORIENT_PRESERVING) != 0) == pGroup->bOrientPreservering);
-        if (pTS_out->iCounter == 1) {
-          *pTS_out = AvgTSpace(pTS_out, &pSubGroupTspace[l]);
-          pTS_out->iCounter = 2;  // update counter
-          pTS_out->bOrient = pGroup->bOrientPreservering;
-        }
-        else {
-          assert(pTS_out->iCounter == 0);
-          *pTS_out = pSubGroupTspace[l];
-          pTS_out->iCounter = 1;  // update counter
-          pTS_out->bOrient = pGroup->bOrientPreservering;
-        }
-      }
+      if (pCornerTspace != NULL)
+        pCornerTspace[f * 3 + index] = pSubGroupTspace[l];
+      else
+        OutputTSpace(psTspace, &pTriInfos[f], index, pGroup, &pSubGroupTspace[l]);
     }
 
-    // clean up and offset iUniqueTspaces
+    // clean up
     for (s = 0; s < iUniqueSubGroups; s++)
       free(pUniSubGroups[s].pTriMembers);
-    iUniqueTspaces += iUniqueSubGroups;
   }
 
   // clean up
@@ -1290,6 +1378,111 @@ static tbool GenerateTSpaces(STSpace psTspace[],
   return TTRUE;
 }
 
+typedef struct {
+  STSpace *pCornerTspace;
+  const STriInfo *pTriInfos;
+  const SGroup *pGroups;
+  int iNrActiveGroups;
+  const int *piTriListIn;
+  float fThresCos;
+  const SMikkTSpaceContext *pContext;
+  // result of every task
+  tbool *pbTaskRes;
+} SGenerateTSpacesTaskData;
+
+static void GenerateTSpacesTask(void *pTaskData, const int iTask)
+{
+  SGenerateTSpacesTaskData *pData = (SGenerateTSpacesTaskData *)pTaskData;
+  const int iFirst = iTask * GROUPS_PER_TASK;
+  const int iLast = iFirst + GROUPS_PER_TASK < pData->iNrActiveGroups ?
+                        iFirst + GROUPS_PER_TASK :
+                        pData->iNrActiveGroups;
+  pData->pbTaskRes[iTask] = GenerateTSpacesRange(NULL,
+                                                 pData->pCornerTspace,
+                                                 pData->pTriInfos,
+                                                 pData->pGroups,
+                                                 iFirst,
+                                                 iLast,
+                                                 pData->piTriListIn,
+                                                 pData->fThresCos,
+                                                 pData->pContext);
+}
+
+static tbool GenerateTSpaces(STSpace psTspace[],
+                             const STriInfo pTriInfos[],
+                             const SGroup pGroups[],
+                             const int iNrActiveGroups,
+                             const int piTriListIn[],
+                             const int iNrTrianglesIn,
+                             const float fThresCos,
+                             const SMikkTSpaceContext *pContext)
+{
+  const int iNrTasks = (iNrActiveGroups + GROUPS_PER_TASK - 1) / GROUPS_PER_TASK;
+  SGenerateTSpacesTaskData sData;
+  tbool bRes = TTRUE;
+  int g = 0, i = 0;
+
+  if (pContext->m_pInterface->m_runTasks == NULL || iNrTasks < 2) {
+    return GenerateTSpacesRange(psTspace,
+                                NULL,
+                                pTriInfos,
+                                pGroups,
+                                0,
+                                iNrActiveGroups,
+                                piTriListIn,
+                                fThresCos,
+                                pContext);
+  }
+
+  // The groups are evaluated in parallel, then their results are accumulated in the same order
+  // as the single threaded code does, averaging the corners of quads gives identical results.
+  sData.pCornerTspace = (STSpace *)malloc(sizeof(STSpace[3]) * iNrTrianglesIn);
+  sData.pbTaskRes = (tbool *)malloc(sizeof(tbool) * iNrTasks);
+  if (sData.pCornerTspace == NULL || sData.pbTaskRes == NULL) {
+    if (sData.pCornerTspace != NULL)
+      free(sData.pCornerTspace);
+    if (sData.pbTaskRes != NULL)
+      free(sData.pbTaskRes);
+    return GenerateTSpacesRange(psTspace,
+                                NULL,
+                                pTriInfos,
+                                pGroups,
+                                0,
+                                iNrActiveGroups,
+                                piTriListIn,
+                                fThresCos,
+                                pContext);
+  }
+  sData.pTriInfos = pTriInfos;
+  sData.pGroups = pGroups;
+  sData.iNrActiveGroups = iNrActiveGroups;
+  sData.piTriListIn = piTriListIn;
+  sData.fThresCos = fThresCos;
+  sData.pContext = pContext;
+
+  RunTasks(pContext, GenerateTSpacesTask, &sData, iNrTasks);
+
+  for (i = 0; i < iNrTasks; i++)
+    if (!sData.pbTaskRes[i])
+      bRes = TFALSE;
+
+  if (bRes) {
+    for (g = 0; g < iNrActiveGroups; g++) {
+      const SGroup *pGroup = &pGroups[g];
+      for (i = 0; i < pGroup->iNrFaces; i++) {
+        const int f = pGroup->pFaceIndices[i];
+        const int index = GroupCornerIndex(&pTriInfos[f], pGroup);
+        OutputTSpace(psTspace, &pTriInfos[f], index, pGroup, &sData.pCornerTspace[f * 3 + index]);
+      }
+    }
+  }
+
+  free(sData.pCornerTspace);
+  free(sData.pbTaskRes);
+
+  return bRes;
+}
+
 static STSpace EvalTspace(int face_indices[],
                           const int iFaces,
                           const int piTriListIn[],
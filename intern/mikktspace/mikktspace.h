@@ -121,6 +121,15 @@ typedef struct {
                       const tbool bIsOrientationPreserving,
                       const int iFace,
                       const int iVert);
+
+  // Optional. Calls task(pTaskData, iTask) for every iTask in the range {0, 1, ..., iNrTasks-1},
+  // in parallel where possible, and returns once all of them are done.
+  // When this call-back is set, the get call-backs above may be called from multiple threads at
+  // once. The results are identical to the ones generated without it.
+  void (*m_runTasks)(const SMikkTSpaceContext *pContext,
+                     void (*task)(void *pTaskData, const int iTask),
+                     void *pTaskData,
+                     const int iNrTasks);
 } SMikkTSpaceInterface;
 
 struct SMikkTSpaceContext {
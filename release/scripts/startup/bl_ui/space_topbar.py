@@ -249,6 +249,7 @@ class TOPBAR_MT_file_cleanup(Menu):
         layout.separator()
 
         layout.operator("outliner.orphans_purge", text="Unused Data-Blocks")
+        layout.operator("outliner.orphans_purge", text="Recursive Unused Data-Blocks").do_recursive = True
 
 
 class TOPBAR_MT_file(Menu):
@@ -613,6 +613,9 @@ class USERPREF_PT_system_memory(SystemPanel, CenterAlignMixIn, Panel):
         col.prop(edit, "undo_steps", text="Undo Steps")
         col.prop(edit, "undo_memory_limit", text="Undo Memory Limit")
         col.prop(edit, "use_global_undo")
+        sub = col.column()
+        sub.active = edit.use_global_undo and edit.undo_memory_limit != 0
+        sub.prop(edit, "use_global_undo_spill")
 
         layout.separator()
 
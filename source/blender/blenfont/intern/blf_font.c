@@ -333,16 +333,15 @@ static void blf_font_ensure_ascii_kerning(FontBLF *font,
                                           GlyphCacheBLF *gc,
                                           const FT_UInt kern_mode)
 {
-  KerningCacheBLF *kc = font->kerning_cache;
-
   font->kerning_mode = kern_mode;
 
-  if (!kc || kc->mode != kern_mode) {
-    font->kerning_cache = kc = blf_kerning_cache_find(font);
-    if (!kc) {
-      font->kerning_cache = kc = blf_kerning_cache_new(font, gc);
-    }
+  /* Kerning depends on the size, so the caches belong to the glyph cache
+   * (there is one for each kerning mode at most). */
+  KerningCacheBLF *kc = blf_kerning_cache_find(gc, kern_mode);
+  if (!kc) {
+    kc = blf_kerning_cache_new(gc, kern_mode);
   }
+  font->kerning_cache = kc;
 }
 
 /* Fast path for runs of ASCII characters. Given that common UTF-8
@@ -383,7 +382,14 @@ static void blf_font_ensure_ascii_kerning(FontBLF *font,
     if (_g_prev) { \
       FT_Vector _delta; \
       if (_c_prev < 0x80 && _c < 0x80) { \
-        _pen_x += (_font)->kerning_cache->table[_c][_c_prev]; \
+        int *_kern = &(_font)->kerning_cache->table[_c][_c_prev]; \
+        if (UNLIKELY(*_kern == BLF_KERNING_UNSET)) { \
+          *_kern = (FT_Get_Kerning( \
+                        (_font)->face, (_g_prev)->idx, (_g)->idx, _kern_mode, &(_delta)) == 0) ? \
+                       (int)_delta.x >> 6 : \
+                       0; \
+        } \
+        _pen_x += *_kern; \
       } \
       else if (FT_Get_Kerning((_font)->face, (_g_prev)->idx, (_g)->idx, _kern_mode, &(_delta)) == \
                0) { \
@@ -1297,8 +1303,6 @@ void blf_font_free(FontBLF *font)
     blf_glyph_cache_free(gc);
   }
 
-  blf_kerning_cache_clear(font);
-
   FT_Done_Face(font->face);
   if (font->filename) {
     MEM_freeN(font->filename);
@@ -1338,7 +1342,6 @@ static void blf_font_fill(FontBLF *font)
   font->dpi = 0;
   font->size = 0;
   BLI_listbase_clear(&font->cache);
-  BLI_listbase_clear(&font->kerning_caches);
   font->kerning_cache = NULL;
 #if BLF_BLUR_ENABLE
   font->blur = 0;
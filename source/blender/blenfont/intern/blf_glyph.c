@@ -55,13 +55,13 @@
 #include "BLI_math_vector.h"
 #include "BLI_strict_flags.h"
 
-KerningCacheBLF *blf_kerning_cache_find(FontBLF *font)
+KerningCacheBLF *blf_kerning_cache_find(GlyphCacheBLF *gc, unsigned int mode)
 {
   KerningCacheBLF *p;
 
-  p = (KerningCacheBLF *)font->kerning_caches.first;
+  p = (KerningCacheBLF *)gc->kerning_caches.first;
   while (p) {
-    if (p->mode == font->kerning_mode) {
+    if (p->mode == mode) {
       return p;
     }
     p = p->next;
@@ -69,50 +69,22 @@ KerningCacheBLF *blf_kerning_cache_find(FontBLF *font)
   return NULL;
 }
 
-/* Create a new glyph cache for the current kerning mode. */
-KerningCacheBLF *blf_kerning_cache_new(FontBLF *font, GlyphCacheBLF *gc)
+/* Create a new kerning cache for the glyph cache size and kerning mode.
+ * The table is filled lazily by BLF_KERNING_STEP_FAST, so only the pairs in use are looked up. */
+KerningCacheBLF *blf_kerning_cache_new(GlyphCacheBLF *gc, unsigned int mode)
 {
   KerningCacheBLF *kc;
 
-  kc = (KerningCacheBLF *)MEM_callocN(sizeof(KerningCacheBLF), "blf_kerning_cache_new");
+  kc = (KerningCacheBLF *)MEM_mallocN(sizeof(KerningCacheBLF), "blf_kerning_cache_new");
   kc->next = NULL;
   kc->prev = NULL;
-  kc->mode = font->kerning_mode;
-
-  unsigned int i, j;
-  for (i = 0; i < 0x80; i++) {
-    for (j = 0; j < 0x80; j++) {
-      GlyphBLF *g = blf_glyph_search(gc, i);
-      if (!g) {
-        FT_UInt glyph_index = FT_Get_Char_Index(font->face, i);
-        g = blf_glyph_add(font, gc, glyph_index, i);
-      }
-      /* Can fail on certain fonts */
-      GlyphBLF *g_prev = blf_glyph_search(gc, j);
-
-      FT_Vector delta = {
-          .x = 0,
-          .y = 0,
-      };
-      if (g && g_prev && FT_Get_Kerning(font->face, g_prev->idx, g->idx, kc->mode, &delta) == 0) {
-        kc->table[i][j] = (int)delta.x >> 6;
-      }
-      else {
-        kc->table[i][j] = 0;
-      }
-    }
-  }
+  kc->mode = mode;
+  copy_vn_i(&kc->table[0][0], (int)(sizeof(kc->table) / sizeof(int)), BLF_KERNING_UNSET);
 
-  BLI_addhead(&font->kerning_caches, kc);
+  BLI_addhead(&gc->kerning_caches, kc);
   return kc;
 }
 
-void blf_kerning_cache_clear(FontBLF *font)
-{
-  font->kerning_cache = NULL;
-  BLI_freelistN(&font->kerning_caches);
-}
-
 GlyphCacheBLF *blf_glyph_cache_find(FontBLF *font, unsigned int size, unsigned int dpi)
 {
   GlyphCacheBLF *p;
@@ -121,6 +93,11 @@ GlyphCacheBLF *blf_glyph_cache_find(FontBLF *font, unsigned int size, unsigned i
   while (p) {
     if (p->size == size && p->dpi == dpi && (p->bold == ((font->flags & BLF_BOLD) != 0)) &&
         (p->italic == ((font->flags & BLF_ITALIC) != 0))) {
+      /* Keep the list sorted by use, so the least recently used cache is the one freed. */
+      if (p != font->cache.first) {
+        BLI_remlink(&font->cache, p);
+        BLI_addhead(&font->cache, p);
+      }
       return p;
     }
     p = p->next;
@@ -168,6 +145,16 @@ GlyphCacheBLF *blf_glyph_cache_new(FontBLF *font)
   CLAMP_MIN(gc->glyph_height_max, 1);
 
   BLI_addhead(&font->cache, gc);
+
+  /* Caches are kept when the UI scale or zoom level changes so going back to a previous size
+   * does not render all glyphs again, only keep the most recently used ones around. */
+  if (BLI_listbase_count_at_most(&font->cache, BLF_GLYPH_CACHE_LEN_MAX + 1) >
+      BLF_GLYPH_CACHE_LEN_MAX) {
+    GlyphCacheBLF *gc_lru = font->cache.last;
+    BLI_remlink(&font->cache, gc_lru);
+    blf_glyph_cache_free(gc_lru);
+  }
+
   return gc;
 }
 
@@ -205,6 +192,13 @@ void blf_glyph_cache_clear(FontBLF *font)
 void blf_glyph_cache_free(GlyphCacheBLF *gc)
 {
   GlyphBLF *g;
+
+  /* Draw the pending glyphs while their texture still exists. */
+  if (g_batch.glyph_cache == gc) {
+    blf_batch_draw();
+    g_batch.glyph_cache = NULL;
+  }
+
   for (uint i = 0; i < ARRAY_SIZE(gc->bucket); i++) {
     while ((g = BLI_pophead(&gc->bucket[i]))) {
       blf_glyph_free(g);
@@ -216,6 +210,7 @@ void blf_glyph_cache_free(GlyphCacheBLF *gc)
   if (gc->bitmap_result) {
     MEM_freeN(gc->bitmap_result);
   }
+  BLI_freelistN(&gc->kerning_caches);
   MEM_freeN(gc);
 }
 
@@ -497,7 +492,15 @@ void blf_glyph_render(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, float x, fl
 
     if (bitmap_len > gc->bitmap_len_alloc) {
       int w = font->tex_size_max;
-      int h = bitmap_len / w + 1;
+      const int h_min = bitmap_len / w + 1;
+      int h = h_min;
+
+      /* Grow by half the current size, re-creating the texture means uploading all
+       * glyphs again, so avoid doing it for every new row. */
+      if (gc->texture) {
+        const int h_grow = GPU_texture_height(gc->texture) * 3 / 2;
+        h = max_ii(h_min, min_ii(h_grow, GPU_max_texture_layers()));
+      }
 
       gc->bitmap_len_alloc = w * h;
       gc->bitmap_result = MEM_reallocN(gc->bitmap_result, (size_t)gc->bitmap_len_alloc);
@@ -28,6 +28,9 @@
 
 #define BLF_BATCH_DRAW_LEN_MAX 2048 /* in glyph */
 
+/* Number of glyph caches (sizes) kept per font, least recently used ones are freed first. */
+#define BLF_GLYPH_CACHE_LEN_MAX 8
+
 typedef struct BatchBLF {
   struct FontBLF *font; /* can only batch glyph from the same font */
   struct GPUBatch *batch;
@@ -50,10 +53,13 @@ typedef struct KerningCacheBLF {
   FT_UInt mode;
 
   /* only cache a ascii glyph pairs. Only store the x
-   * offset we are interested in, instead of the full FT_Vector. */
+   * offset we are interested in, instead of the full FT_Vector.
+   * Pairs are looked up on first use, BLF_KERNING_UNSET until then. */
   int table[0x80][0x80];
 } KerningCacheBLF;
 
+#define BLF_KERNING_UNSET INT_MAX
+
 typedef struct GlyphCacheBLF {
   struct GlyphCacheBLF *next;
   struct GlyphCacheBLF *prev;
@@ -73,6 +79,9 @@ typedef struct GlyphCacheBLF {
   /* fast ascii lookup */
   struct GlyphBLF *glyph_ascii_table[256];
 
+  /* list of kerning caches (KerningCacheBLF) for this size, one per kerning mode. */
+  ListBase kerning_caches;
+
   /* texture array, to draw the glyphs. */
   GPUTexture *texture;
   char *bitmap_result;
@@ -221,14 +230,13 @@ typedef struct FontBLF {
   int flags;
 
   /* List of glyph caches (GlyphCacheBLF) for this font for size, dpi, bold, italic.
+   * Most recently used first, the list is kept to BLF_GLYPH_CACHE_LEN_MAX items.
    * Use blf_glyph_cache_acquire(font) and blf_glyph_cache_release(font) to access cache!
    */
   ListBase cache;
 
-  /* list of kerning cache for this font. */
-  ListBase kerning_caches;
-
-  /* current kerning cache for this font and kerning mode. */
+  /* current kerning cache, of the current glyph cache and kerning mode.
+   * Only valid after blf_font_ensure_ascii_kerning(). */
   KerningCacheBLF *kerning_cache;
 
   /* freetype2 lib handle. */
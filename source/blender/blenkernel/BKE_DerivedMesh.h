@@ -373,6 +373,8 @@ void makeDerivedMesh(struct Depsgraph *depsgraph,
                      struct BMEditMesh *em,
                      const struct CustomData_MeshMasks *dataMask);
 
+void BKE_modifier_stage_cache_free(struct Object *ob);
+
 void DM_calc_loop_tangents(DerivedMesh *dm,
                            bool calc_active_tangent,
                            const char (*tangent_names)[MAX_NAME],
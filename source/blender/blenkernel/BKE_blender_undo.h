@@ -35,6 +35,7 @@ bool BKE_memfile_undo_decode(struct MemFileUndoData *mfu,
                              const int undo_direction,
                              const bool use_old_bmain_data,
                              struct bContext *C);
+bool BKE_memfile_undo_spill(struct MemFileUndoData *mfu);
 void BKE_memfile_undo_free(struct MemFileUndoData *mfu);
 
 #ifdef __cplusplus
@@ -0,0 +1,64 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bke
+ *
+ * Gives the function system direct access to the generic attribute layers of a #CustomData, e.g.
+ * `Mesh.vdata` or `PointCloud.pdata`, without copying them.
+ */
+
+#include <memory>
+
+#include "FN_attributes_ref.hh"
+
+struct CustomData;
+
+namespace blender::bke {
+
+/**
+ * References all generic attribute layers (float, int, float2, float3 and color) of a #CustomData
+ * in a #fn::MutableAttributesRef. Layers that are referenced from other data are made local
+ * first, so that writing to the attributes does not change data that other users see.
+ *
+ * The #CustomData must not get layers added or removed while this object is in use. Layers with
+ * a name that has been used by a previous layer already are skipped.
+ */
+class CustomDataAttributes : NonCopyable, NonMovable {
+ private:
+  std::unique_ptr<fn::AttributesInfo> info_;
+  Vector<void *> buffers_;
+  int64_t size_;
+
+ public:
+  CustomDataAttributes(CustomData &custom_data, int64_t size);
+
+  const fn::AttributesInfo &info() const
+  {
+    return *info_;
+  }
+
+  fn::MutableAttributesRef attributes()
+  {
+    return fn::MutableAttributesRef(*info_, buffers_, size_);
+  }
+};
+
+const fn::CPPType *custom_data_type_to_cpp_type(int type);
+
+}  // namespace blender::bke
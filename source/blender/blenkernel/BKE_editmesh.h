@@ -83,6 +83,12 @@ typedef struct BMEditMesh {
    */
   char needs_flush_to_id;
 
+  /**
+   * Only vertex coordinates changed since the last update (set while transforming).
+   * Lets the draw cache keep the buffers which only depend on topology.
+   */
+  char is_deform_only_update;
+
 } BMEditMesh;
 
 /* editmesh.c */
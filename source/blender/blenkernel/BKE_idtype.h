@@ -171,6 +171,9 @@ typedef struct IDTypeInfo {
   /**
    * Called by `BKE_library_foreach_ID_link()` to apply a callback over all other ID usages (ID
    * pointers) of given data-block.
+   *
+   * With #IDWALK_READONLY it may be called concurrently on different IDs (see
+   * `BKE_library_foreach_ID_link_parallel()`), so it must then only read the given ID.
    */
   IDTypeForeachIDFunction foreach_id;
 
@@ -117,6 +117,9 @@ enum {
   LIB_ID_COPY_NO_ANIMDATA = 1 << 19,
   /** Mesh: Reference CD data layers instead of doing real copy - USE WITH CAUTION! */
   LIB_ID_COPY_CD_REFERENCE = 1 << 20,
+  /** Mesh: Share CD data layers with the source until either of them is modified, see #CD_SHARE.
+   */
+  LIB_ID_COPY_CD_SHARE = 1 << 21,
 
   /* *** XXX Hackish/not-so-nice specific behaviors needed for some corner cases. *** */
   /* *** Ideally we should not have those, but we need them for now... *** */
@@ -269,6 +272,9 @@ void BKE_main_id_flag_all(struct Main *bmain, const int flag, const bool value);
 
 void BKE_main_id_clear_newpoins(struct Main *bmain);
 
+void BKE_main_id_name_cache_begin(struct Main *bmain);
+void BKE_main_id_name_cache_end(struct Main *bmain);
+
 void BKE_main_id_refcount_recompute(struct Main *bmain, const bool do_linked_only);
 
 void BKE_main_lib_objects_recalc_all(struct Main *bmain);
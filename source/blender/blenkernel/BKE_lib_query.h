@@ -162,6 +162,12 @@ void BKE_lib_query_idpropertiesForeachIDLink_callback(struct IDProperty *id_prop
 /* Loop over all of the ID's this datablock links to. */
 void BKE_library_foreach_ID_link(
     struct Main *bmain, struct ID *id, LibraryIDLinkCallback callback, void *user_data, int flag);
+void BKE_library_foreach_ID_link_parallel(struct Main *bmain,
+                                          struct ID **ids,
+                                          const int ids_len,
+                                          LibraryIDLinkCallback callback,
+                                          void *user_data,
+                                          int flag);
 void BKE_library_update_ID_link_user(struct ID *id_dst, struct ID *id_src, const int cb_flag);
 
 int BKE_library_ID_use_ID(struct ID *id_user, struct ID *id_used);
@@ -178,6 +184,11 @@ void BKE_library_ID_test_usages(struct Main *bmain,
 void BKE_library_unused_linked_data_set_tag(struct Main *bmain, const bool do_init_tag);
 void BKE_library_indirectly_used_data_tag_clear(struct Main *bmain);
 
+void BKE_lib_query_unused_ids_tag(struct Main *bmain,
+                                  const int tag,
+                                  const bool do_tag_recursive,
+                                  int *r_num_tagged);
+
 #ifdef __cplusplus
 }
 #endif
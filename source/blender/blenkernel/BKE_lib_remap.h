@@ -38,6 +38,7 @@
 extern "C" {
 #endif
 
+struct GHash;
 struct wmWindowManager;
 
 /* BKE_libblock_free, delete are declared in BKE_lib_id.h for convenience. */
@@ -89,6 +90,13 @@ void BKE_libblock_remap_locked(struct Main *bmain,
 void BKE_libblock_remap(struct Main *bmain, void *old_idv, void *new_idv, const short remap_flags)
     ATTR_NONNULL(1, 2);
 
+void BKE_libblock_remap_multiple_locked(struct Main *bmain,
+                                        struct GHash *old_to_new_ids,
+                                        const short remap_flags) ATTR_NONNULL(1, 2);
+void BKE_libblock_remap_multiple(struct Main *bmain,
+                                 struct GHash *old_to_new_ids,
+                                 const short remap_flags) ATTR_NONNULL(1, 2);
+
 void BKE_libblock_unlink(struct Main *bmain,
                          void *idv,
                          const bool do_flag_never_null,
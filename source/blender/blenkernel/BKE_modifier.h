@@ -114,6 +114,13 @@ typedef enum {
 
   /** Accepts #BMesh input (without conversion). */
   eModifierTypeFlag_AcceptsBMesh = (1 << 11),
+
+  /**
+   * The result only depends on the input mesh and the settings stored in the modifier itself,
+   * so the modifier stack may reuse a previous result while neither of them changed.
+   * Modifiers that currently reference other ID's are never cached, even with this flag.
+   */
+  eModifierTypeFlag_SupportsStageCache = (1 << 12),
 } ModifierTypeFlag;
 
 typedef void (*IDWalkFunc)(void *userData, struct Object *ob, struct ID **idpoin, int cb_flag);
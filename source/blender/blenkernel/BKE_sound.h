@@ -27,6 +27,8 @@ extern "C" {
 #endif
 
 #define SOUND_WAVE_SAMPLES_PER_SECOND 250
+/* Number of reduced resolution levels of a waveform, used when drawing zoomed out. */
+#define SOUND_WAVE_LOD_LEN 10
 
 #if defined(WITH_AUDASPACE)
 #  include <AUD_Device.h>
@@ -40,6 +42,10 @@ struct bSound;
 typedef struct SoundWaveform {
   int length;
   float *data;
+  /* Every level has half the samples of the previous one, a sample holds the minimum, maximum
+   * and RMS of the samples it covers. Levels with less than two samples are NULL. */
+  int lod_length[SOUND_WAVE_LOD_LEN];
+  float *lod_data[SOUND_WAVE_LOD_LEN];
 } SoundWaveform;
 
 void BKE_sound_init_once(void);
@@ -94,6 +94,13 @@ void BKE_texture_get_value(const struct Scene *scene,
                            struct TexResult *texres,
                            bool use_color_management);
 
+void BKE_texture_get_values(const struct Scene *scene,
+                            struct Tex *texture,
+                            const float (*tex_co)[3],
+                            const int tex_co_num,
+                            struct TexResult *r_texres,
+                            bool use_color_management);
+
 void BKE_texture_fetch_images_for_pool(struct Tex *texture, struct ImagePool *pool);
 
 #ifdef __cplusplus
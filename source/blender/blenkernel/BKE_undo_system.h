@@ -130,6 +130,13 @@ typedef struct UndoType {
    */
   void (*step_free)(UndoStep *us);
 
+  /**
+   * Optional, move the data of the step out of memory (updating #UndoStep.data_size),
+   * it must be loaded back by 'step_decode'.
+   * Return false when the step has to stay in memory.
+   */
+  bool (*step_spill)(UndoStep *us);
+
   void (*step_foreach_ID_ref)(UndoStep *us,
                               UndoTypeForEachIDRefFn foreach_ID_ref_fn,
                               void *user_data);
@@ -159,6 +166,7 @@ void BKE_undosys_stack_init_from_context(UndoStack *ustack, struct bContext *C);
 UndoStep *BKE_undosys_stack_active_with_type(UndoStack *ustack, const UndoType *ut);
 UndoStep *BKE_undosys_stack_init_or_active_with_type(UndoStack *ustack, const UndoType *ut);
 void BKE_undosys_stack_limit_steps_and_memory(UndoStack *ustack, int steps, size_t memory_limit);
+void BKE_undosys_stack_spill_memory(UndoStack *ustack, size_t memory_limit);
 #define BKE_undosys_stack_limit_steps_and_memory_defaults(ustack) \
   BKE_undosys_stack_limit_steps_and_memory(ustack, U.undosteps, (size_t)U.undomemory * 1024 * 1024)
 
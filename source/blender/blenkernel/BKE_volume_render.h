@@ -44,6 +44,7 @@ typedef struct DenseFloatVolumeGrid {
 
 bool BKE_volume_grid_dense_floats(const struct Volume *volume,
                                   struct VolumeGrid *volume_grid,
+                                  const int64_t max_voxels,
                                   DenseFloatVolumeGrid *r_dense_grid);
 void BKE_volume_dense_float_grid_clear(DenseFloatVolumeGrid *dense_grid);
 
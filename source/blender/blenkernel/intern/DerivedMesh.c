@@ -38,6 +38,7 @@
 #include "BLI_array.h"
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
+#include "BLI_hash_mm2a.h"
 #include "BLI_linklist.h"
 #include "BLI_math.h"
 #include "BLI_task.h"
@@ -869,6 +870,308 @@ void BKE_mesh_wrapper_deferred_finalize(Mesh *me_eval,
   BLI_assert(me_eval->runtime.wrapper_type_finalize == 0);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Modifier Stage Cache
+ *
+ * Keeps copies of the mesh after constructive modifiers, so changing the settings of a modifier
+ * only evaluates the stack from that modifier on, instead of from the start.
+ *
+ * A stage is identified by a hash of the input mesh and a hash of the settings of all modifiers
+ * up to and including the one producing it. Only stacks whose modifiers all support
+ * #eModifierTypeFlag_SupportsStageCache (and don't reference other ID's or time) are cached.
+ * \{ */
+
+/** Memory of cached stages kept per object, the earliest stages are freed first. */
+#define MODIFIER_STAGE_CACHE_MEMORY_MAX ((size_t)512 << 20)
+
+typedef struct ModifierStageCacheItem {
+  struct ModifierStageCacheItem *next, *prev;
+  /** Position of the modifier in the (virtual) modifier list. */
+  int md_index;
+  uint input_hash;
+  uint stack_hash;
+  Mesh *mesh;
+  size_t mem_size;
+} ModifierStageCacheItem;
+
+typedef struct ModifierStageCache {
+  ListBase items;
+  size_t mem_size;
+} ModifierStageCache;
+
+static void modifier_stage_cache_item_free(ModifierStageCache *cache, ModifierStageCacheItem *item)
+{
+  BLI_remlink(&cache->items, item);
+  cache->mem_size -= item->mem_size;
+  BKE_id_free(NULL, item->mesh);
+  MEM_freeN(item);
+}
+
+void BKE_modifier_stage_cache_free(Object *ob)
+{
+  ModifierStageCache *cache = ob->runtime.modifier_stage_cache;
+  if (cache == NULL) {
+    return;
+  }
+  while (cache->items.first) {
+    modifier_stage_cache_item_free(cache, cache->items.first);
+  }
+  MEM_freeN(cache);
+  ob->runtime.modifier_stage_cache = NULL;
+}
+
+static void modifier_stage_cache_id_check_cb(void *user_data,
+                                             Object *UNUSED(ob),
+                                             ID **idpoin,
+                                             int UNUSED(cb_flag))
+{
+  if (*idpoin != NULL) {
+    *(bool *)user_data = true;
+  }
+}
+
+static bool modifier_stage_cache_is_supported(Object *ob, ModifierData *md)
+{
+  const ModifierTypeInfo *mti = BKE_modifier_get_info(md->type);
+
+  if ((mti->flags & eModifierTypeFlag_SupportsStageCache) == 0) {
+    return false;
+  }
+  if (mti->dependsOnTime && mti->dependsOnTime(md)) {
+    return false;
+  }
+  if (mti->foreachIDLink) {
+    bool has_id = false;
+    mti->foreachIDLink(md, ob, modifier_stage_cache_id_check_cb, &has_id);
+    if (has_id) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void modifier_stage_cache_hash_customdata(BLI_HashMurmur2A *mm2,
+                                                 const CustomData *data,
+                                                 const int totelem)
+{
+  BLI_hash_mm2a_add_int(mm2, totelem);
+  BLI_hash_mm2a_add_int(mm2, data->totlayer);
+  for (int i = 0; i < data->totlayer; i++) {
+    const CustomDataLayer *layer = &data->layers[i];
+    BLI_hash_mm2a_add_int(mm2, layer->type);
+    BLI_hash_mm2a_add(mm2, (const uchar *)layer->name, strlen(layer->name));
+    if (layer->data == NULL) {
+      continue;
+    }
+    if (layer->type == CD_MDEFORMVERT) {
+      /* The weights are stored outside of the layer. */
+      const MDeformVert *dvert = layer->data;
+      for (int j = 0; j < totelem; j++) {
+        BLI_hash_mm2a_add_int(mm2, dvert[j].totweight);
+        BLI_hash_mm2a_add(
+            mm2, (const uchar *)dvert[j].dw, sizeof(*dvert[j].dw) * (size_t)dvert[j].totweight);
+      }
+    }
+    else {
+      BLI_hash_mm2a_add(
+          mm2, layer->data, (size_t)CustomData_sizeof(layer->type) * (size_t)totelem);
+    }
+  }
+}
+
+/** Hash everything besides the modifiers themselves that the cached stages depend on. */
+static uint modifier_stage_cache_input_hash(const Scene *scene,
+                                            const Object *ob,
+                                            const Mesh *mesh,
+                                            const int useDeform,
+                                            const bool need_mapping)
+{
+  BLI_HashMurmur2A mm2;
+  BLI_hash_mm2a_init(&mm2, 0);
+
+  modifier_stage_cache_hash_customdata(&mm2, &mesh->vdata, mesh->totvert);
+  modifier_stage_cache_hash_customdata(&mm2, &mesh->edata, mesh->totedge);
+  modifier_stage_cache_hash_customdata(&mm2, &mesh->ldata, mesh->totloop);
+  modifier_stage_cache_hash_customdata(&mm2, &mesh->pdata, mesh->totpoly);
+  BLI_hash_mm2a_add_int(&mm2, mesh->flag);
+  BLI_hash_mm2a_add_int(&mm2, mesh->cd_flag);
+  BLI_hash_mm2a_add_int(&mm2, mesh->totcol);
+  BLI_hash_mm2a_add(&mm2, (const uchar *)&mesh->smoothresh, sizeof(mesh->smoothresh));
+
+  BLI_hash_mm2a_add(&mm2, (const uchar *)ob->obmat, sizeof(ob->obmat));
+  BLI_hash_mm2a_add_int(&mm2, ob->totcol);
+  LISTBASE_FOREACH (const bDeformGroup *, dg, &ob->defbase) {
+    BLI_hash_mm2a_add(&mm2, (const uchar *)dg->name, strlen(dg->name) + 1);
+  }
+
+  BLI_hash_mm2a_add_int(&mm2, scene->r.mode & R_SIMPLIFY);
+  BLI_hash_mm2a_add_int(&mm2, scene->r.simplify_subsurf);
+  BLI_hash_mm2a_add_int(&mm2, scene->r.simplify_subsurf_render);
+
+  BLI_hash_mm2a_add_int(&mm2, useDeform);
+  BLI_hash_mm2a_add_int(&mm2, need_mapping);
+
+  return BLI_hash_mm2a_end(&mm2);
+}
+
+static void modifier_stage_cache_hash_modifier(BLI_HashMurmur2A *mm2,
+                                               const ModifierData *md,
+                                               const CustomData_MeshMasks *mask)
+{
+  const ModifierTypeInfo *mti = BKE_modifier_get_info(md->type);
+
+  BLI_hash_mm2a_add_int(mm2, md->type);
+  BLI_hash_mm2a_add_int(mm2, md->mode);
+  /* The settings following the common header. */
+  BLI_hash_mm2a_add(mm2,
+                    (const uchar *)md + sizeof(ModifierData),
+                    (size_t)mti->structSize - sizeof(ModifierData));
+  BLI_hash_mm2a_add(mm2, (const uchar *)mask, sizeof(*mask));
+}
+
+/**
+ * Calculate the stack hash of every modifier that may use the stage cache.
+ *
+ * \return The number of leading modifiers that can be cached, the hashes are aligned with them.
+ * Zero when none of them would store a stage.
+ */
+static int modifier_stage_cache_stack_hashes(Scene *scene,
+                                             Object *ob,
+                                             ModifierData *firstmd,
+                                             const CDMaskLink *datamasks,
+                                             const int required_mode,
+                                             uint **r_stack_hashes)
+{
+  int md_len = 0;
+  bool has_stage = false;
+  for (ModifierData *md = firstmd; md; md = md->next) {
+    if (BKE_modifier_is_enabled(scene, md, required_mode)) {
+      if (!modifier_stage_cache_is_supported(ob, md)) {
+        break;
+      }
+      /* Only constructive modifiers store a stage, the result of the last one isn't kept. */
+      if (BKE_modifier_get_info(md->type)->type != eModifierTypeType_OnlyDeform && md->next) {
+        has_stage = true;
+      }
+    }
+    md_len++;
+  }
+
+  if (!has_stage) {
+    *r_stack_hashes = NULL;
+    return 0;
+  }
+
+  uint *stack_hashes = MEM_malloc_arrayN((size_t)md_len, sizeof(*stack_hashes), __func__);
+  BLI_HashMurmur2A mm2;
+  BLI_hash_mm2a_init(&mm2, 0);
+
+  ModifierData *md = firstmd;
+  const CDMaskLink *md_datamask = datamasks;
+  for (int i = 0; i < md_len; i++, md = md->next, md_datamask = md_datamask->next) {
+    modifier_stage_cache_hash_modifier(&mm2, md, &md_datamask->mask);
+    /* Finish a copy, so the hash keeps accumulating the following modifiers. */
+    BLI_HashMurmur2A mm2_stage = mm2;
+    stack_hashes[i] = BLI_hash_mm2a_end(&mm2_stage);
+  }
+
+  *r_stack_hashes = stack_hashes;
+  return md_len;
+}
+
+/**
+ * Find the deepest valid stage, stages that don't match the current stack are freed.
+ */
+static ModifierStageCacheItem *modifier_stage_cache_lookup(Object *ob,
+                                                            const uint input_hash,
+                                                            const uint *stack_hashes,
+                                                            const int stack_hashes_len)
+{
+  ModifierStageCache *cache = ob->runtime.modifier_stage_cache;
+  if (cache == NULL) {
+    return NULL;
+  }
+
+  ModifierStageCacheItem *item_best = NULL;
+  LISTBASE_FOREACH_MUTABLE (ModifierStageCacheItem *, item, &cache->items) {
+    if (item->input_hash == input_hash && item->md_index < stack_hashes_len &&
+        item->stack_hash == stack_hashes[item->md_index]) {
+      if (item_best == NULL || item->md_index > item_best->md_index) {
+        item_best = item;
+      }
+    }
+    else {
+      modifier_stage_cache_item_free(cache, item);
+    }
+  }
+  return item_best;
+}
+
+static size_t modifier_stage_cache_mesh_mem_size(const Mesh *mesh)
+{
+  size_t mem_size = 0;
+  const CustomData *datas[4] = {&mesh->vdata, &mesh->edata, &mesh->ldata, &mesh->pdata};
+  const int totelems[4] = {mesh->totvert, mesh->totedge, mesh->totloop, mesh->totpoly};
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < datas[i]->totlayer; j++) {
+      mem_size += (size_t)CustomData_sizeof(datas[i]->layers[j].type) * (size_t)totelems[i];
+    }
+  }
+  return mem_size;
+}
+
+static bool modifier_stage_cache_has_errors(ModifierData *firstmd, ModifierData *md_last)
+{
+  for (ModifierData *md = firstmd; md; md = md->next) {
+    if (md->error) {
+      return true;
+    }
+    if (md == md_last) {
+      break;
+    }
+  }
+  return false;
+}
+
+static void modifier_stage_cache_store(Object *ob,
+                                       const int md_index,
+                                       const uint input_hash,
+                                       const uint stack_hash,
+                                       Mesh *mesh)
+{
+  const size_t mem_size = modifier_stage_cache_mesh_mem_size(mesh);
+  if (mem_size > MODIFIER_STAGE_CACHE_MEMORY_MAX) {
+    return;
+  }
+
+  ModifierStageCache *cache = ob->runtime.modifier_stage_cache;
+  if (cache == NULL) {
+    cache = ob->runtime.modifier_stage_cache = MEM_callocN(sizeof(*cache), __func__);
+  }
+
+  /* Stages after this one were computed from a different stack. */
+  LISTBASE_FOREACH_MUTABLE (ModifierStageCacheItem *, item, &cache->items) {
+    if (item->md_index >= md_index) {
+      modifier_stage_cache_item_free(cache, item);
+    }
+  }
+  /* Free the earliest stages to stay within budget, deeper stages save more work. */
+  while (cache->items.first && cache->mem_size + mem_size > MODIFIER_STAGE_CACHE_MEMORY_MAX) {
+    modifier_stage_cache_item_free(cache, cache->items.first);
+  }
+
+  ModifierStageCacheItem *item = MEM_callocN(sizeof(*item), __func__);
+  item->md_index = md_index;
+  item->input_hash = input_hash;
+  item->stack_hash = stack_hash;
+  item->mesh = BKE_mesh_copy_for_eval(mesh, false);
+  item->mem_size = mem_size;
+  BLI_addtail(&cache->items, item);
+  cache->mem_size += mem_size;
+}
+
+/** \} */
+
 static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
                                 Scene *scene,
                                 Object *ob,
@@ -954,9 +1257,32 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
   /* Clear errors before evaluation. */
   BKE_modifiers_clear_errors(ob);
 
+  /* Find the deepest unchanged stage of a previous evaluation, see #ModifierStageCache.
+   * Undeformed coordinates would need the whole stack, so those aren't supported. */
+  int md_index = 0;
+  uint *stage_stack_hashes = NULL;
+  int stage_stack_hashes_len = 0;
+  uint stage_input_hash = 0;
+  ModifierStageCacheItem *stage_resume = NULL;
+  const bool need_orco = datamasks && ((datamasks->mask.vmask | final_datamask.vmask) &
+                                       (CD_MASK_ORCO | CD_MASK_CLOTH_ORCO)) != 0;
+  if (use_cache && index == -1 && !sculpt_mode && !need_orco && firstmd == ob->modifiers.first) {
+    stage_stack_hashes_len = modifier_stage_cache_stack_hashes(
+        scene, ob, firstmd, datamasks, required_mode, &stage_stack_hashes);
+  }
+  if (stage_stack_hashes_len != 0) {
+    stage_input_hash = modifier_stage_cache_input_hash(
+        scene, ob, mesh_input, useDeform, need_mapping);
+    stage_resume = modifier_stage_cache_lookup(
+        ob, stage_input_hash, stage_stack_hashes, stage_stack_hashes_len);
+  }
+  else if (use_cache) {
+    BKE_modifier_stage_cache_free(ob);
+  }
+
   /* Apply all leading deform modifiers. */
   if (useDeform) {
-    for (; md; md = md->next, md_datamask = md_datamask->next) {
+    for (; md; md = md->next, md_datamask = md_datamask->next, md_index++) {
       const ModifierTypeInfo *mti = BKE_modifier_get_info(md->type);
 
       if (!BKE_modifier_is_enabled(scene, md, required_mode)) {
@@ -1008,7 +1334,26 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
 
   /* Apply all remaining constructive and deforming modifiers. */
   bool have_non_onlydeform_modifiers_appled = false;
-  for (; md; md = md->next, md_datamask = md_datamask->next) {
+
+  if (stage_resume) {
+    /* The cached stage includes the leading deform modifiers. */
+    BLI_assert(stage_resume->md_index >= md_index);
+    MEM_SAFE_FREE(deformed_verts);
+    if (mesh_final) {
+      BKE_id_free(NULL, mesh_final);
+    }
+    while (md_index <= stage_resume->md_index) {
+      md = md->next;
+      md_datamask = md_datamask->next;
+      md_index++;
+    }
+    mesh_final = BKE_mesh_copy_for_eval(stage_resume->mesh, false);
+    mesh_final->runtime.deformed_only = false;
+    have_non_onlydeform_modifiers_appled = true;
+    isPrevDeform = false;
+  }
+
+  for (; md; md = md->next, md_datamask = md_datamask->next, md_index++) {
     const ModifierTypeInfo *mti = BKE_modifier_get_info(md->type);
 
     if (!BKE_modifier_is_enabled(scene, md, required_mode)) {
@@ -1263,6 +1608,12 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
       }
 
       mesh_final->runtime.deformed_only = false;
+
+      if (md_index < stage_stack_hashes_len && md->next &&
+          !modifier_stage_cache_has_errors(firstmd, md)) {
+        modifier_stage_cache_store(
+            ob, md_index, stage_input_hash, stage_stack_hashes[md_index], mesh_final);
+      }
     }
 
     isPrevDeform = (mti->type == eModifierTypeType_OnlyDeform);
@@ -1278,6 +1629,7 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
   }
 
   BLI_linklist_free((LinkNode *)datamasks, NULL);
+  MEM_SAFE_FREE(stage_stack_hashes);
 
   for (md = firstmd; md; md = md->next) {
     BKE_modifier_free_temporary_data(md);
@@ -1332,6 +1684,13 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
   /* Compute normals. */
   if (is_own_mesh) {
     mesh_calc_modifier_final_normals(mesh_input, &final_datamask, sculpt_dyntopo, mesh_final);
+
+    /* Only vertex positions changed, reuse the triangulation of the input mesh which is kept
+     * between evaluations, instead of triangulating the deformed mesh from scratch. */
+    if (mesh_final->mpoly == mesh_input->mpoly && mesh_final->mloop == mesh_input->mloop &&
+        mesh_final->totpoly == mesh_input->totpoly && mesh_final->totloop == mesh_input->totloop) {
+      BKE_mesh_runtime_looptri_copy_from_deform_source(mesh_final, mesh_input);
+    }
   }
   else {
     Mesh_Runtime *runtime = &mesh_input->runtime;
@@ -36,6 +36,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -587,23 +588,112 @@ static void animsys_write_orig_anim_rna(PointerRNA *ptr,
  * This performs a set of standard checks. If extra checks are required,
  * separate code should be used.
  */
+/* Minimum number of F-Curves of a list to evaluate them in parallel. */
+#define ANIMSYS_FCURVES_PARALLEL_MIN 256
+
+static bool animsys_fcurve_is_evaluated(FCurve *fcu)
+{
+  /* Check if this F-Curve doesn't belong to a muted group. */
+  if ((fcu->grp != NULL) && (fcu->grp->flag & AGRP_MUTED)) {
+    return false;
+  }
+  /* Check if this curve should be skipped. */
+  if ((fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED))) {
+    return false;
+  }
+  /* Skip empty curves, as if muted. */
+  if (BKE_fcurve_is_empty(fcu)) {
+    return false;
+  }
+  return true;
+}
+
+typedef struct AnimsysFCurvesEvalData {
+  PointerRNA *ptr;
+  const AnimationEvalContext *anim_eval_context;
+  FCurve **fcurves;
+  PathResolvedRNA *anim_rnas;
+  float *values;
+  bool *is_resolved;
+} AnimsysFCurvesEvalData;
+
+static void animsys_evaluate_fcurves_task(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  AnimsysFCurvesEvalData *data = userdata;
+  FCurve *fcu = data->fcurves[i];
+  data->is_resolved[i] = BKE_animsys_store_rna_setting(
+      data->ptr, fcu->rna_path, fcu->array_index, &data->anim_rnas[i]);
+  if (data->is_resolved[i]) {
+    data->values[i] = calculate_fcurve(&data->anim_rnas[i], fcu, data->anim_eval_context);
+  }
+}
+
+/**
+ * Resolve and evaluate all curves in parallel, then write the values in order,
+ * since writing RNA properties is not thread safe.
+ */
+static void animsys_evaluate_fcurves_parallel(PointerRNA *ptr,
+                                              ListBase *list,
+                                              const int fcurves_num,
+                                              const AnimationEvalContext *anim_eval_context,
+                                              bool flush_to_original)
+{
+  AnimsysFCurvesEvalData data = {
+      .ptr = ptr,
+      .anim_eval_context = anim_eval_context,
+      .fcurves = MEM_malloc_arrayN(fcurves_num, sizeof(*data.fcurves), __func__),
+      .anim_rnas = MEM_malloc_arrayN(fcurves_num, sizeof(*data.anim_rnas), __func__),
+      .values = MEM_malloc_arrayN(fcurves_num, sizeof(*data.values), __func__),
+      .is_resolved = MEM_malloc_arrayN(fcurves_num, sizeof(*data.is_resolved), __func__),
+  };
+
+  int i = 0;
+  LISTBASE_FOREACH (FCurve *, fcu, list) {
+    if (animsys_fcurve_is_evaluated(fcu)) {
+      data.fcurves[i++] = fcu;
+    }
+  }
+  const int fcurves_evaluated_num = i;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(
+      0, fcurves_evaluated_num, &data, animsys_evaluate_fcurves_task, &settings);
+
+  for (i = 0; i < fcurves_evaluated_num; i++) {
+    if (data.is_resolved[i]) {
+      FCurve *fcu = data.fcurves[i];
+      BKE_animsys_write_rna_setting(&data.anim_rnas[i], data.values[i]);
+      if (flush_to_original) {
+        animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, data.values[i]);
+      }
+    }
+  }
+
+  MEM_freeN(data.fcurves);
+  MEM_freeN(data.anim_rnas);
+  MEM_freeN(data.values);
+  MEM_freeN(data.is_resolved);
+}
+
 static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      ListBase *list,
                                      const AnimationEvalContext *anim_eval_context,
                                      bool flush_to_original)
 {
+  const int fcurves_num = BLI_listbase_count_at_most(list, ANIMSYS_FCURVES_PARALLEL_MIN);
+  if (fcurves_num == ANIMSYS_FCURVES_PARALLEL_MIN) {
+    animsys_evaluate_fcurves_parallel(
+        ptr, list, BLI_listbase_count(list), anim_eval_context, flush_to_original);
+    return;
+  }
+
   /* Calculate then execute each curve. */
   LISTBASE_FOREACH (FCurve *, fcu, list) {
-    /* Check if this F-Curve doesn't belong to a muted group. */
-    if ((fcu->grp != NULL) && (fcu->grp->flag & AGRP_MUTED)) {
-      continue;
-    }
-    /* Check if this curve should be skipped. */
-    if ((fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED))) {
-      continue;
-    }
-    /* Skip empty curves, as if muted. */
-    if (BKE_fcurve_is_empty(fcu)) {
+    if (!animsys_fcurve_is_evaluated(fcu)) {
       continue;
     }
     PathResolvedRNA anim_rna;
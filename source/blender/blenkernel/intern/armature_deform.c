@@ -237,6 +237,20 @@ static void pchan_bone_deform(bPoseChannel *pchan,
  * #BKE_armature_deform_coords and related functions.
  * \{ */
 
+/**
+ * Deformation of the bone used by one vertex group. The matrix and dual quaternion are copied
+ * into a contiguous array, so that the vertex loop doesn't have to reach into the pose channel
+ * and bone of every weight in the common case.
+ */
+typedef struct ArmatureGroupDeform {
+  float mat[4][4];
+  DualQuat dq;
+  /** NULL when the vertex group has no deforming bone. */
+  bPoseChannel *pchan;
+  /** The bone is a B-Bone or multiplies weights with its envelope, see #pchan_bone_deform. */
+  bool use_pchan;
+} ArmatureGroupDeform;
+
 typedef struct ArmatureUserdata {
   const Object *ob_arm;
   const Object *ob_target;
@@ -255,7 +269,7 @@ typedef struct ArmatureUserdata {
   const MDeformVert *dverts;
   int dverts_len;
 
-  bPoseChannel **pchan_from_defbase;
+  const ArmatureGroupDeform *group_deform;
   int defbase_len;
 
   float premat[4][4];
@@ -333,12 +347,21 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
     unsigned int j;
     for (j = dvert->totweight; j != 0; j--, dw++) {
       const uint index = dw->def_nr;
-      if (index < data->defbase_len && (pchan = data->pchan_from_defbase[index])) {
+      if (index < data->defbase_len && (pchan = data->group_deform[index].pchan)) {
+        const ArmatureGroupDeform *group = &data->group_deform[index];
         float weight = dw->weight;
-        Bone *bone = pchan->bone;
 
         deformed = 1;
 
+        if (!group->use_pchan) {
+          if (weight != 0.0f) {
+            pchan_deform_accumulate(&group->dq, group->mat, co, weight, vec, dq, smat);
+            contrib += weight;
+          }
+          continue;
+        }
+
+        Bone *bone = pchan->bone;
         if (bone && bone->flag & BONE_MULT_VG_ENV) {
           weight *= distfactor_to_bone(
               co, bone->arm_head, bone->arm_tail, bone->rad_head, bone->rad_tail, bone->dist);
@@ -472,7 +495,7 @@ static void armature_deform_coords_impl(const Object *ob_arm,
                                         bGPDstroke *gps_target)
 {
   bArmature *arm = ob_arm->data;
-  bPoseChannel **pchan_from_defbase = NULL;
+  ArmatureGroupDeform *group_deform = NULL;
   const MDeformVert *dverts = NULL;
   bDeformGroup *dg;
   const bool use_envelope = (deformflag & ARM_DEF_ENVELOPE) != 0;
@@ -542,19 +565,25 @@ static void armature_deform_coords_impl(const Object *ob_arm,
       }
 
       if (use_dverts) {
-        pchan_from_defbase = MEM_callocN(sizeof(*pchan_from_defbase) * defbase_len, "defnrToBone");
+        group_deform = MEM_callocN(sizeof(*group_deform) * defbase_len, "defnrToBone");
         /* TODO(sergey): Some considerations here:
          *
          * - Check whether keeping this consistent across frames gives speedup.
          */
         for (i = 0, dg = ob_target->defbase.first; dg; i++, dg = dg->next) {
-          pchan_from_defbase[i] = BKE_pose_channel_find_name(ob_arm->pose, dg->name);
+          bPoseChannel *pchan = BKE_pose_channel_find_name(ob_arm->pose, dg->name);
           /* exclude non-deforming bones */
-          if (pchan_from_defbase[i]) {
-            if (pchan_from_defbase[i]->bone->flag & BONE_NO_DEFORM) {
-              pchan_from_defbase[i] = NULL;
-            }
+          if (pchan == NULL || pchan->bone->flag & BONE_NO_DEFORM) {
+            continue;
           }
+          const Bone *bone = pchan->bone;
+          ArmatureGroupDeform *group = &group_deform[i];
+          group->pchan = pchan;
+          group->use_pchan = (bone->flag & BONE_MULT_VG_ENV) ||
+                             (bone->segments > 1 &&
+                              pchan->runtime.bbone_segments == bone->segments);
+          copy_m4_m4(group->mat, pchan->chan_mat);
+          group->dq = pchan->runtime.deform_dual_quat;
         }
       }
     }
@@ -574,7 +603,7 @@ static void armature_deform_coords_impl(const Object *ob_arm,
       .armature_def_nr = armature_def_nr,
       .dverts = dverts,
       .dverts_len = dverts_len,
-      .pchan_from_defbase = pchan_from_defbase,
+      .group_deform = group_deform,
       .defbase_len = defbase_len,
       .bmesh =
           {
@@ -608,8 +637,8 @@ static void armature_deform_coords_impl(const Object *ob_arm,
     BLI_task_parallel_range(0, vert_coords_len, &data, armature_vert_task, &settings);
   }
 
-  if (pchan_from_defbase) {
-    MEM_freeN(pchan_from_defbase);
+  if (group_deform) {
+    MEM_freeN(group_deform);
   }
 }
 
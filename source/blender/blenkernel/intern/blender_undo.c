@@ -136,6 +136,27 @@ MemFileUndoData *BKE_memfile_undo_encode(Main *bmain, MemFileUndoData *mfu_prev)
   return mfu;
 }
 
+/**
+ * Move the memfile out of memory into a file in the session temporary directory,
+ * it is loaded back when the undo step is decoded.
+ */
+bool BKE_memfile_undo_spill(MemFileUndoData *mfu)
+{
+  if (UNDO_DISK) {
+    return false;
+  }
+
+  static uint counter = 0;
+  char filename[FILE_MAX];
+  char numstr[32];
+
+  counter++;
+  BLI_snprintf(numstr, sizeof(numstr), "%u_undo.spill", counter);
+  BLI_join_dirfile(filename, sizeof(filename), BKE_tempdir_session(), numstr);
+
+  return BLO_memfile_spill(&mfu->memfile, filename);
+}
+
 void BKE_memfile_undo_free(MemFileUndoData *mfu)
 {
   BLO_memfile_free(&mfu->memfile);
@@ -153,7 +153,10 @@ static void setup_app_data(bContext *C,
   }
   /* may happen with library files - UNDO file should never have NULL curscene (but may have a
    * NULL curscreen)... */
-  else if (ELEM(NULL, bfd->curscreen, bfd->curscene)) {
+  /* Screens are not read when loading without UI (#BLO_READ_SKIP_UI), only warn if there is no
+   * scene then. */
+  else if ((bfd->curscene == NULL) ||
+           ((bfd->curscreen == NULL) && (G.fileflags & G_FILE_NO_UI) == 0)) {
     BKE_report(reports, RPT_WARNING, "Library file, loading empty scene");
     mode = LOAD_UI_OFF;
   }
@@ -2445,6 +2445,57 @@ float BKE_brush_curve_strength(const Brush *br, float p, const float len)
   return strength;
 }
 
+/* Same as #BKE_brush_curve_strength for an array of distances, the curve type is only checked
+ * once so the loops can be vectorized. */
+void BKE_brush_curve_strength_array(
+    const Brush *br, const float *dist, float *r_strength, const int count, const float len)
+{
+#define BRUSH_CURVE_ARRAY_LOOP(expr) \
+  for (int i = 0; i < count; i++) { \
+    const float p = 1.0f - dist[i] / len; \
+    r_strength[i] = (dist[i] >= len) ? 0.0f : (expr); \
+  } \
+  ((void)0)
+
+  switch (br->curve_preset) {
+    case BRUSH_CURVE_CUSTOM:
+      BRUSH_CURVE_ARRAY_LOOP(BKE_curvemapping_evaluateF(br->curve, 0, 1.0f - p));
+      break;
+    case BRUSH_CURVE_SHARP:
+      BRUSH_CURVE_ARRAY_LOOP(p * p);
+      break;
+    case BRUSH_CURVE_SMOOTH:
+      BRUSH_CURVE_ARRAY_LOOP(3.0f * p * p - 2.0f * p * p * p);
+      break;
+    case BRUSH_CURVE_SMOOTHER:
+      BRUSH_CURVE_ARRAY_LOOP(pow3f(p) * (p * (p * 6.0f - 15.0f) + 10.0f));
+      break;
+    case BRUSH_CURVE_ROOT:
+      BRUSH_CURVE_ARRAY_LOOP(sqrtf(p));
+      break;
+    case BRUSH_CURVE_LIN:
+      BRUSH_CURVE_ARRAY_LOOP(p);
+      break;
+    case BRUSH_CURVE_SPHERE:
+      BRUSH_CURVE_ARRAY_LOOP(sqrtf(2 * p - p * p));
+      break;
+    case BRUSH_CURVE_POW4:
+      BRUSH_CURVE_ARRAY_LOOP(p * p * p * p);
+      break;
+    case BRUSH_CURVE_INVSQUARE:
+      BRUSH_CURVE_ARRAY_LOOP(p * (2.0f - p));
+      break;
+    case BRUSH_CURVE_CONSTANT:
+    default:
+      for (int i = 0; i < count; i++) {
+        r_strength[i] = (dist[i] >= len) ? 0.0f : 1.0f;
+      }
+      break;
+  }
+
+#undef BRUSH_CURVE_ARRAY_LOOP
+}
+
 /* Uses the brush curve control to find a strength value between 0 and 1 */
 float BKE_brush_curve_strength_clamped(Brush *br, float p, const float len)
 {
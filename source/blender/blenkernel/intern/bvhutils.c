@@ -40,13 +40,33 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
 /* -------------------------------------------------------------------- */
 /** \name BVHCache
  * \{ */
 
+/**
+ * Geometry a shared tree was built from. Meshes only share trees while they reference the same
+ * geometry arrays, see #bvhcache_share_from_mesh.
+ */
+typedef struct BVHCacheKey {
+  const MVert *mvert;
+  const MEdge *medge;
+  const MFace *mface;
+  const MPoly *mpoly;
+  const MLoop *mloop;
+  int totvert, totedge, totface, totpoly, totloop;
+} BVHCacheKey;
+
 typedef struct BVHCacheItem {
   bool is_filled;
   BVHTree *tree;
+  /** Number of caches using the tree, NULL when the tree is not shared. */
+  int *users;
+  /** Only set in caches the tree was shared with, the tree is invalid once the geometry differs. */
+  bool has_key;
+  BVHCacheKey key;
 } BVHCacheItem;
 
 typedef struct BVHCache {
@@ -145,20 +165,133 @@ static void bvhcache_insert(BVHCache *bvh_cache, BVHTree *tree, BVHCacheType typ
   item->is_filled = true;
 }
 
+/**
+ * frees a bvhcache
+ */
+static void bvhcache_item_release(BVHCacheItem *item)
+{
+  if (item->users != NULL) {
+    if (atomic_sub_and_fetch_int32(item->users, 1) == 0) {
+      BLI_bvhtree_free(item->tree);
+      MEM_freeN(item->users);
+    }
+  }
+  else {
+    BLI_bvhtree_free(item->tree);
+  }
+  memset(item, 0, sizeof(*item));
+}
+
 /**
  * frees a bvhcache
  */
 void bvhcache_free(BVHCache *bvh_cache)
 {
   for (BVHCacheType index = 0; index < BVHTREE_MAX_ITEM; index++) {
-    BVHCacheItem *item = &bvh_cache->items[index];
-    BLI_bvhtree_free(item->tree);
-    item->tree = NULL;
+    bvhcache_item_release(&bvh_cache->items[index]);
   }
   BLI_mutex_end(&bvh_cache->mutex);
   MEM_freeN(bvh_cache);
 }
 
+static void bvhcache_key_from_mesh(BVHCacheKey *key, const Mesh *mesh)
+{
+  memset(key, 0, sizeof(*key));
+  key->mvert = mesh->mvert;
+  key->medge = mesh->medge;
+  key->mface = mesh->mface;
+  key->mpoly = mesh->mpoly;
+  key->mloop = mesh->mloop;
+  key->totvert = mesh->totvert;
+  key->totedge = mesh->totedge;
+  key->totface = mesh->totface;
+  key->totpoly = mesh->totpoly;
+  key->totloop = mesh->totloop;
+}
+
+static bool bvhcache_key_matches_mesh(const BVHCacheKey *key, const Mesh *mesh)
+{
+  BVHCacheKey mesh_key;
+  bvhcache_key_from_mesh(&mesh_key, mesh);
+  return memcmp(key, &mesh_key, sizeof(mesh_key)) == 0;
+}
+
+/**
+ * Share the trees of the mesh types of \a mesh_src with \a mesh_dst, which must not have a cache
+ * yet. This only does something when both meshes reference the same geometry arrays (e.g. after a
+ * copy with #LIB_ID_COPY_CD_REFERENCE), so the trees don't have to be built again for the copy.
+ *
+ * The trees stay valid in \a mesh_dst only as long as it keeps using these arrays, this is
+ * checked every time a tree is requested with #BKE_bvhtree_from_mesh_get.
+ */
+void bvhcache_share_from_mesh(Mesh *mesh_dst, const Mesh *mesh_src)
+{
+  BVHCache *bvh_cache_src = mesh_src->runtime.bvh_cache;
+  BLI_assert(mesh_dst->runtime.bvh_cache == NULL);
+  if (bvh_cache_src == NULL) {
+    return;
+  }
+
+  BVHCacheKey key;
+  bvhcache_key_from_mesh(&key, mesh_dst);
+  if (!bvhcache_key_matches_mesh(&key, mesh_src)) {
+    return;
+  }
+
+  BVHCache *bvh_cache_dst = NULL;
+  /* Lock the source cache, so that no tree is inserted while the counters are created. */
+  BLI_mutex_lock(&bvh_cache_src->mutex);
+  for (BVHCacheType type = 0; type < BVHTREE_FROM_EM_VERTS; type++) {
+    BVHCacheItem *item_src = &bvh_cache_src->items[type];
+    if (!item_src->is_filled) {
+      continue;
+    }
+    if (item_src->has_key && !bvhcache_key_matches_mesh(&item_src->key, mesh_src)) {
+      continue;
+    }
+    if (bvh_cache_dst == NULL) {
+      bvh_cache_dst = bvhcache_init();
+    }
+    if (item_src->tree != NULL) {
+      if (item_src->users == NULL) {
+        item_src->users = MEM_mallocN(sizeof(int), __func__);
+        *item_src->users = 1;
+      }
+      atomic_add_and_fetch_int32(item_src->users, 1);
+    }
+    BVHCacheItem *item_dst = &bvh_cache_dst->items[type];
+    item_dst->is_filled = true;
+    item_dst->tree = item_src->tree;
+    item_dst->users = item_src->users;
+    item_dst->has_key = true;
+    item_dst->key = key;
+  }
+  BLI_mutex_unlock(&bvh_cache_src->mutex);
+
+  mesh_dst->runtime.bvh_cache = bvh_cache_dst;
+}
+
+/**
+ * Remove a shared tree from the cache of \a mesh if the mesh does not use the geometry it was
+ * built from anymore, e.g. because a modifier replaced the referenced vertex coordinates.
+ */
+static void bvhcache_ensure_shared_valid(Mesh *mesh, BVHCacheType type)
+{
+  BVHCache *bvh_cache = mesh->runtime.bvh_cache;
+  if (bvh_cache == NULL) {
+    return;
+  }
+  BVHCacheItem *item = &bvh_cache->items[type];
+  if (!item->has_key || bvhcache_key_matches_mesh(&item->key, mesh)) {
+    return;
+  }
+  BLI_mutex_lock(&bvh_cache->mutex);
+  if (item->has_key && !bvhcache_key_matches_mesh(&item->key, mesh)) {
+    bvhcache_item_release(item);
+  }
+  BLI_mutex_unlock(&bvh_cache->mutex);
+}
+
 /** \} */
 /* -------------------------------------------------------------------- */
 /** \name Local Callbacks
@@ -1418,6 +1551,7 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
   BVHCache **bvh_cache_p = (BVHCache **)&mesh->runtime.bvh_cache;
   ThreadMutex *mesh_eval_mutex = (ThreadMutex *)mesh->runtime.eval_mutex;
 
+  bvhcache_ensure_shared_valid(mesh, bvh_cache_type);
   bool is_cached = bvhcache_find(bvh_cache_p, bvh_cache_type, &tree, NULL, NULL);
 
   if (is_cached && tree == NULL) {
@@ -74,6 +74,32 @@ typedef struct SelfColDetectData {
   bool collided;
 } SelfColDetectData;
 
+/* Impulses of the collision pairs are computed in parallel, then applied to the
+ * vertices in the order of the pairs. */
+typedef struct ColResponseData {
+  ClothModifierData *clmd;
+  /* NULL for self collisions. */
+  CollisionModifierData *collmd;
+  Object *collob;
+  CollPair *collisions;
+  float time_multiplier;
+  float min_distance;
+  bool is_hair;
+  /* Impulses for the vertices of each pair, #COLLISION_PAIR_VERTS_MAX per pair. */
+  float (*impulses)[3];
+  char *pair_state;
+} ColResponseData;
+
+#define COLLISION_PAIR_VERTS_MAX 6
+
+enum {
+  /* Pair isn't handled by the static response. */
+  COLLISION_PAIR_SKIP = 0,
+  /* Pair computed no impulse of its own. */
+  COLLISION_PAIR_NO_IMPULSE = 1,
+  COLLISION_PAIR_IMPULSE = 2,
+};
+
 /***********************************
  * Collision modifier code start
  ***********************************/
@@ -670,22 +696,22 @@ static void cloth_collision_impulse_vert(const float clamp_sq,
   vert->impulse_count++;
 }
 
-static int cloth_collision_response_static(ClothModifierData *clmd,
-                                           CollisionModifierData *collmd,
-                                           Object *collob,
-                                           CollPair *collpair,
-                                           uint collision_count,
-                                           const float dt)
+static void cloth_collision_response_static_cb(void *__restrict userdata,
+                                               const int index,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  int result = 0;
+  const ColResponseData *data = userdata;
+  ClothModifierData *clmd = data->clmd;
+  CollisionModifierData *collmd = data->collmd;
+  Object *collob = data->collob;
+  CollPair *collpair = &data->collisions[index];
   Cloth *cloth = clmd->clothObject;
-  const float clamp_sq = square_f(clmd->coll_parms->clamp * dt);
-  const float time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
-  const float epsilon2 = BLI_bvhtree_get_epsilon(collmd->bvhtree);
-  const float min_distance = (clmd->coll_parms->epsilon + epsilon2) * (8.0f / 9.0f);
+  const float time_multiplier = data->time_multiplier;
+  const float min_distance = data->min_distance;
+  const bool is_hair = data->is_hair;
+  int result = 0;
 
-  const bool is_hair = (clmd->hairdata != NULL);
-  for (int i = 0; i < collision_count; i++, collpair++) {
+  {
     float i1[3], i2[3], i3[3];
     float w1, w2, w3, u1, u2, u3;
     float v1[3], v2[3], relativeVelocity[3];
@@ -695,7 +721,8 @@ static int cloth_collision_response_static(ClothModifierData *clmd,
 
     /* Only handle static collisions here. */
     if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
-      continue;
+      data->pair_state[index] = COLLISION_PAIR_SKIP;
+      return;
     }
 
     /* Compute barycentric coordinates and relative "velocity" for both collision points. */
@@ -825,30 +852,27 @@ static int cloth_collision_response_static(ClothModifierData *clmd,
       result = 1;
     }
 
-    if (result) {
-      cloth_collision_impulse_vert(clamp_sq, i1, &cloth->verts[collpair->ap1]);
-      cloth_collision_impulse_vert(clamp_sq, i2, &cloth->verts[collpair->ap2]);
-      if (!is_hair) {
-        cloth_collision_impulse_vert(clamp_sq, i3, &cloth->verts[collpair->ap3]);
-      }
-    }
+    float(*impulses)[3] = &data->impulses[index * COLLISION_PAIR_VERTS_MAX];
+    copy_v3_v3(impulses[0], i1);
+    copy_v3_v3(impulses[1], i2);
+    copy_v3_v3(impulses[2], i3);
+    data->pair_state[index] = result ? COLLISION_PAIR_IMPULSE : COLLISION_PAIR_NO_IMPULSE;
   }
-
-  return result;
 }
 
-static int cloth_selfcollision_response_static(ClothModifierData *clmd,
-                                               CollPair *collpair,
-                                               uint collision_count,
-                                               const float dt)
+static void cloth_selfcollision_response_static_cb(void *__restrict userdata,
+                                                   const int index,
+                                                   const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  int result = 0;
+  const ColResponseData *data = userdata;
+  ClothModifierData *clmd = data->clmd;
+  CollPair *collpair = &data->collisions[index];
   Cloth *cloth = clmd->clothObject;
-  const float clamp_sq = square_f(clmd->coll_parms->self_clamp * dt);
-  const float time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
-  const float min_distance = (2.0f * clmd->coll_parms->selfepsilon) * (8.0f / 9.0f);
+  const float time_multiplier = data->time_multiplier;
+  const float min_distance = data->min_distance;
+  int result = 0;
 
-  for (int i = 0; i < collision_count; i++, collpair++) {
+  {
     float ia[3][3] = {{0.0f}};
     float ib[3][3] = {{0.0f}};
     float w1, w2, w3, u1, u2, u3;
@@ -856,7 +880,8 @@ static int cloth_selfcollision_response_static(ClothModifierData *clmd,
 
     /* Only handle static collisions here. */
     if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
-      continue;
+      data->pair_state[index] = COLLISION_PAIR_SKIP;
+      return;
     }
 
     /* Compute barycentric coordinates for both collision points. */
@@ -984,20 +1009,116 @@ static int cloth_selfcollision_response_static(ClothModifierData *clmd,
       result = 1;
     }
 
-    if (result) {
-      cloth_collision_impulse_vert(clamp_sq, ia[0], &cloth->verts[collpair->ap1]);
-      cloth_collision_impulse_vert(clamp_sq, ia[1], &cloth->verts[collpair->ap2]);
-      cloth_collision_impulse_vert(clamp_sq, ia[2], &cloth->verts[collpair->ap3]);
+    float(*impulses)[3] = &data->impulses[index * COLLISION_PAIR_VERTS_MAX];
+    copy_v3_v3(impulses[0], ia[0]);
+    copy_v3_v3(impulses[1], ia[1]);
+    copy_v3_v3(impulses[2], ia[2]);
+    copy_v3_v3(impulses[3], ib[0]);
+    copy_v3_v3(impulses[4], ib[1]);
+    copy_v3_v3(impulses[5], ib[2]);
+    data->pair_state[index] = result ? COLLISION_PAIR_IMPULSE : COLLISION_PAIR_NO_IMPULSE;
+  }
+}
+
+/**
+ * Compute the impulses of all pairs in parallel and merge them into the vertices.
+ * Merging happens in the order of the pairs, once a pair computed an impulse
+ * all following pairs are merged, so the result matches handling the pairs one by one.
+ */
+static int cloth_collision_response_static_exec(ColResponseData *data,
+                                                uint collision_count,
+                                                const float clamp_sq,
+                                                TaskParallelRangeFunc func)
+{
+  Cloth *cloth = data->clmd->clothObject;
+  const bool is_self = (data->collmd == NULL);
+  int result = 0;
+
+  data->impulses = MEM_mallocN(sizeof(*data->impulses) * COLLISION_PAIR_VERTS_MAX *
+                                   collision_count,
+                               __func__);
+  data->pair_state = MEM_mallocN(sizeof(*data->pair_state) * collision_count, __func__);
 
-      cloth_collision_impulse_vert(clamp_sq, ib[0], &cloth->verts[collpair->bp1]);
-      cloth_collision_impulse_vert(clamp_sq, ib[1], &cloth->verts[collpair->bp2]);
-      cloth_collision_impulse_vert(clamp_sq, ib[2], &cloth->verts[collpair->bp3]);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = true;
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(0, collision_count, data, func, &settings);
+
+  CollPair *collpair = data->collisions;
+  for (uint i = 0; i < collision_count; i++, collpair++) {
+    if (data->pair_state[i] == COLLISION_PAIR_SKIP) {
+      continue;
+    }
+    if (data->pair_state[i] == COLLISION_PAIR_IMPULSE) {
+      result = 1;
+    }
+    if (result) {
+      const float(*impulses)[3] = &data->impulses[i * COLLISION_PAIR_VERTS_MAX];
+      cloth_collision_impulse_vert(clamp_sq, impulses[0], &cloth->verts[collpair->ap1]);
+      cloth_collision_impulse_vert(clamp_sq, impulses[1], &cloth->verts[collpair->ap2]);
+      if (is_self) {
+        cloth_collision_impulse_vert(clamp_sq, impulses[2], &cloth->verts[collpair->ap3]);
+
+        cloth_collision_impulse_vert(clamp_sq, impulses[3], &cloth->verts[collpair->bp1]);
+        cloth_collision_impulse_vert(clamp_sq, impulses[4], &cloth->verts[collpair->bp2]);
+        cloth_collision_impulse_vert(clamp_sq, impulses[5], &cloth->verts[collpair->bp3]);
+      }
+      else if (!data->is_hair) {
+        cloth_collision_impulse_vert(clamp_sq, impulses[2], &cloth->verts[collpair->ap3]);
+      }
     }
   }
 
+  MEM_freeN(data->impulses);
+  MEM_freeN(data->pair_state);
+
   return result;
 }
 
+static int cloth_collision_response_static(ClothModifierData *clmd,
+                                           CollisionModifierData *collmd,
+                                           Object *collob,
+                                           CollPair *collpair,
+                                           uint collision_count,
+                                           const float dt)
+{
+  const float epsilon2 = BLI_bvhtree_get_epsilon(collmd->bvhtree);
+
+  ColResponseData data = {
+      .clmd = clmd,
+      .collmd = collmd,
+      .collob = collob,
+      .collisions = collpair,
+      .time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale),
+      .min_distance = (clmd->coll_parms->epsilon + epsilon2) * (8.0f / 9.0f),
+      .is_hair = (clmd->hairdata != NULL),
+  };
+
+  return cloth_collision_response_static_exec(&data,
+                                              collision_count,
+                                              square_f(clmd->coll_parms->clamp * dt),
+                                              cloth_collision_response_static_cb);
+}
+
+static int cloth_selfcollision_response_static(ClothModifierData *clmd,
+                                               CollPair *collpair,
+                                               uint collision_count,
+                                               const float dt)
+{
+  ColResponseData data = {
+      .clmd = clmd,
+      .collisions = collpair,
+      .time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale),
+      .min_distance = (2.0f * clmd->coll_parms->selfepsilon) * (8.0f / 9.0f),
+  };
+
+  return cloth_collision_response_static_exec(&data,
+                                              collision_count,
+                                              square_f(clmd->coll_parms->self_clamp * dt),
+                                              cloth_selfcollision_response_static_cb);
+}
+
 #ifdef __GNUC__
 #  pragma GCC diagnostic pop
 #endif
@@ -29,6 +29,7 @@
 #include <string.h>
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_curve_types.h"
@@ -258,6 +259,77 @@ static bool calc_curve_deform(
  * #BKE_curve_deform and related functions.
  * \{ */
 
+typedef struct CurveDeformUserdata {
+  const Object *ob_curve;
+  const CurveDeform *cd;
+  float (*vert_coords)[3];
+  const MDeformVert *dvert;
+  int defgrp_index;
+  bool invert_vgroup;
+  short defaxis;
+  /* The coordinates were already converted to curve space while calculating the bounds. */
+  bool is_curvespace;
+} CurveDeformUserdata;
+
+static void curve_deform_vert_task(void *__restrict userdata,
+                                   const int index,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CurveDeformUserdata *data = userdata;
+  const CurveDeform *cd = data->cd;
+  float *co = data->vert_coords[index];
+
+  if (data->dvert != NULL) {
+    const MDeformVert *dvert = &data->dvert[index];
+    const float weight = data->invert_vgroup ?
+                             1.0f - BKE_defvert_find_weight(dvert, data->defgrp_index) :
+                             BKE_defvert_find_weight(dvert, data->defgrp_index);
+    if (weight > 0.0f) {
+      float vec[3];
+      if (!data->is_curvespace) {
+        mul_m4_v3(cd->curvespace, co);
+      }
+      copy_v3_v3(vec, co);
+      calc_curve_deform(data->ob_curve, vec, data->defaxis, cd, NULL);
+      interp_v3_v3v3(co, co, vec, weight);
+      mul_m4_v3(cd->objectspace, co);
+    }
+  }
+  else {
+    if (!data->is_curvespace) {
+      mul_m4_v3(cd->curvespace, co);
+    }
+    calc_curve_deform(data->ob_curve, co, data->defaxis, cd, NULL);
+    mul_m4_v3(cd->objectspace, co);
+  }
+}
+
+static void curve_deform_verts(const Object *ob_curve,
+                               const CurveDeform *cd,
+                               float (*vert_coords)[3],
+                               const int vert_coords_len,
+                               const MDeformVert *dvert,
+                               const int defgrp_index,
+                               const bool invert_vgroup,
+                               const short defaxis,
+                               const bool is_curvespace)
+{
+  CurveDeformUserdata data = {
+      .ob_curve = ob_curve,
+      .cd = cd,
+      .vert_coords = vert_coords,
+      .dvert = dvert,
+      .defgrp_index = defgrp_index,
+      .invert_vgroup = invert_vgroup,
+      .defaxis = defaxis,
+      .is_curvespace = is_curvespace,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 512;
+  BLI_task_parallel_range(0, vert_coords_len, &data, curve_deform_vert_task, &settings);
+}
+
 static void curve_deform_coords_impl(const Object *ob_curve,
                                      const Object *ob_target,
                                      float (*vert_coords)[3],
@@ -340,9 +412,15 @@ static void curve_deform_coords_impl(const Object *ob_curve,
         }
       }
       else {
-        for (a = 0; a < vert_coords_len; a++) {
-          DEFORM_OP(&dvert[a]);
-        }
+        curve_deform_verts(ob_curve,
+                           &cd,
+                           vert_coords,
+                           vert_coords_len,
+                           dvert,
+                           defgrp_index,
+                           invert_vgroup,
+                           defaxis,
+                           false);
       }
 
 #undef DEFORM_OP
@@ -394,9 +472,15 @@ static void curve_deform_coords_impl(const Object *ob_curve,
           DEFORM_OP_MINMAX(&dvert[a]);
         }
 
-        for (a = 0; a < vert_coords_len; a++) {
-          DEFORM_OP_CLAMPED(&dvert[a]);
-        }
+        curve_deform_verts(ob_curve,
+                           &cd,
+                           vert_coords,
+                           vert_coords_len,
+                           dvert,
+                           defgrp_index,
+                           invert_vgroup,
+                           defaxis,
+                           true);
       }
     }
 
@@ -405,11 +489,8 @@ static void curve_deform_coords_impl(const Object *ob_curve,
   }
   else {
     if (cu->flag & CU_DEFORM_BOUNDS_OFF) {
-      for (a = 0; a < vert_coords_len; a++) {
-        mul_m4_v3(cd.curvespace, vert_coords[a]);
-        calc_curve_deform(ob_curve, vert_coords[a], defaxis, &cd, NULL);
-        mul_m4_v3(cd.objectspace, vert_coords[a]);
-      }
+      curve_deform_verts(
+          ob_curve, &cd, vert_coords, vert_coords_len, NULL, -1, false, defaxis, false);
     }
     else {
       for (a = 0; a < vert_coords_len; a++) {
@@ -417,11 +498,9 @@ static void curve_deform_coords_impl(const Object *ob_curve,
         minmax_v3v3_v3(cd.dmin, cd.dmax, vert_coords[a]);
       }
 
-      for (a = 0; a < vert_coords_len; a++) {
-        /* already in 'cd.curvespace', prev for loop */
-        calc_curve_deform(ob_curve, vert_coords[a], defaxis, &cd, NULL);
-        mul_m4_v3(cd.objectspace, vert_coords[a]);
-      }
+      /* already in 'cd.curvespace', prev for loop */
+      curve_deform_verts(
+          ob_curve, &cd, vert_coords, vert_coords_len, NULL, -1, false, defaxis, true);
     }
   }
 }
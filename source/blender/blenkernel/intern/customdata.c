@@ -42,6 +42,7 @@
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -61,6 +62,8 @@
 
 #include "CLG_log.h"
 
+#include "atomic_ops.h"
+
 /* only for customdata_data_transfer_interp_normal_normals */
 #include "data_transfer_intern.h"
 
@@ -174,26 +177,35 @@ typedef struct LayerTypeInfo {
   int (*layers_max)(void);
 } LayerTypeInfo;
 
-static void layerCopy_mdeformvert(const void *source, void *dest, int count)
+static void layerCopy_mdeformvert_range(void *__restrict userdata,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  int i, size = sizeof(MDeformVert);
+  MDeformVert *dvert = (MDeformVert *)userdata + i;
 
-  memcpy(dest, source, count * size);
+  if (dvert->totweight) {
+    MDeformWeight *dw = MEM_malloc_arrayN(
+        dvert->totweight, sizeof(*dw), "layerCopy_mdeformvert dw");
 
-  for (i = 0; i < count; i++) {
-    MDeformVert *dvert = POINTER_OFFSET(dest, i * size);
+    memcpy(dw, dvert->dw, dvert->totweight * sizeof(*dw));
+    dvert->dw = dw;
+  }
+  else {
+    dvert->dw = NULL;
+  }
+}
 
-    if (dvert->totweight) {
-      MDeformWeight *dw = MEM_malloc_arrayN(
-          dvert->totweight, sizeof(*dw), "layerCopy_mdeformvert dw");
+static void layerCopy_mdeformvert(const void *source, void *dest, int count)
+{
+  memcpy(dest, source, count * sizeof(MDeformVert));
 
-      memcpy(dw, dvert->dw, dvert->totweight * sizeof(*dw));
-      dvert->dw = dw;
-    }
-    else {
-      dvert->dw = NULL;
-    }
-  }
+  /* Every vertex owns its weights, so copying a layer means one allocation per vertex. This is
+   * a significant part of copying large meshes with vertex groups, do it in parallel. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (count > 10000);
+  settings.min_iter_per_thread = 4096;
+  BLI_task_parallel_range(0, count, dest, layerCopy_mdeformvert_range, &settings);
 }
 
 static void layerFree_mdeformvert(void *data, int count, int size)
@@ -2073,6 +2085,81 @@ static bool customdata_typemap_is_valid(const CustomData *data)
 }
 #endif
 
+/* -------------------------------------------------------------------- */
+/** \name Layer Data Sharing
+ *
+ * Allows multiple layers to use the same data until one of them is to be modified, for example
+ * original and copy-on-write meshes. Only layers of types which do not own additional
+ * allocations can be shared.
+ * \{ */
+
+typedef struct CustomDataLayerSharing {
+  /* Number of layers using the data. */
+  int32_t users;
+} CustomDataLayerSharing;
+
+static bool customData_layer_can_share(const CustomDataLayer *layer)
+{
+  if (layer->data == NULL || (layer->flag & (CD_FLAG_NOFREE | CD_FLAG_EXTERNAL))) {
+    return false;
+  }
+  const LayerTypeInfo *typeInfo = layerType_getInfo(layer->type);
+  return typeInfo->copy == NULL && typeInfo->free == NULL;
+}
+
+/* Add a user to the data of the given layer. Layers of different custom data can be shared
+ * from multiple threads at the same time. */
+static CustomDataLayerSharing *customData_layer_share(CustomDataLayer *layer)
+{
+  CustomDataLayerSharing *sharing = layer->sharing;
+  if (sharing == NULL) {
+    CustomDataLayerSharing *new_sharing = MEM_mallocN(sizeof(*new_sharing), __func__);
+    new_sharing->users = 1;
+    sharing = atomic_cas_ptr((void **)&layer->sharing, NULL, new_sharing);
+    if (sharing == NULL) {
+      sharing = new_sharing;
+    }
+    else {
+      MEM_freeN(new_sharing);
+    }
+  }
+  atomic_add_and_fetch_int32(&sharing->users, 1);
+  return sharing;
+}
+
+/* Stop using shared data of the layer.
+ * Returns true if the layer was the last user, in which case it is responsible for the data. */
+static bool customData_layer_unshare(CustomDataLayer *layer)
+{
+  CustomDataLayerSharing *sharing = layer->sharing;
+  layer->sharing = NULL;
+  if (atomic_sub_and_fetch_int32(&sharing->users, 1) == 0) {
+    MEM_freeN(sharing);
+    return true;
+  }
+  return false;
+}
+
+/* Make sure the layer data is not used by any other layer, so that it can be modified. */
+static void customData_layer_ensure_private(CustomDataLayer *layer)
+{
+  if (layer->sharing == NULL) {
+    return;
+  }
+  if (layer->sharing->users == 1) {
+    customData_layer_unshare(layer);
+    return;
+  }
+  void *shared_data = layer->data;
+  layer->data = MEM_dupallocN(shared_data);
+  if (customData_layer_unshare(layer)) {
+    /* Other users were freed while the data was copied. */
+    MEM_freeN(shared_data);
+  }
+}
+
+/** \} */
+
 bool CustomData_merge(const struct CustomData *source,
                       struct CustomData *dest,
                       CustomDataMask mask,
@@ -2124,6 +2211,7 @@ bool CustomData_merge(const struct CustomData *source,
       case CD_ASSIGN:
       case CD_REFERENCE:
       case CD_DUPLICATE:
+      case CD_SHARE:
         data = layer->data;
         break;
       default:
@@ -2135,8 +2223,25 @@ bool CustomData_merge(const struct CustomData *source,
       newlayer = customData_add_layer__internal(
           dest, type, CD_REFERENCE, data, totelem, layer->name);
     }
+    else if (alloctype == CD_SHARE) {
+      if (customData_layer_can_share(layer)) {
+        newlayer = customData_add_layer__internal(
+            dest, type, CD_ASSIGN, data, totelem, layer->name);
+        if (newlayer && newlayer->data == data && newlayer->sharing == NULL) {
+          newlayer->sharing = customData_layer_share(layer);
+        }
+      }
+      else {
+        newlayer = customData_add_layer__internal(
+            dest, type, CD_DUPLICATE, data, totelem, layer->name);
+      }
+    }
     else {
       newlayer = customData_add_layer__internal(dest, type, alloctype, data, totelem, layer->name);
+      if (newlayer && (alloctype == CD_ASSIGN)) {
+        /* Ownership of the data moves to the new layer, including its share. */
+        newlayer->sharing = layer->sharing;
+      }
     }
 
     if (newlayer) {
@@ -2164,6 +2269,7 @@ void CustomData_realloc(CustomData *data, int totelem)
     if (layer->flag & CD_FLAG_NOFREE) {
       continue;
     }
+    customData_layer_ensure_private(layer);
     typeInfo = layerType_getInfo(layer->type);
     layer->data = MEM_reallocN(layer->data, (size_t)totelem * typeInfo->size);
   }
@@ -2188,6 +2294,11 @@ static void customData_free_layer__internal(CustomDataLayer *layer, int totelem)
 {
   const LayerTypeInfo *typeInfo;
 
+  if (layer->sharing && !customData_layer_unshare(layer)) {
+    /* Data is still used by other layers. */
+    return;
+  }
+
   if (!(layer->flag & CD_FLAG_NOFREE) && layer->data) {
     typeInfo = layerType_getInfo(layer->type);
 
@@ -2563,6 +2674,7 @@ static CustomDataLayer *customData_add_layer__internal(CustomData *data,
   data->layers[index].type = type;
   data->layers[index].flag = flag;
   data->layers[index].data = newlayerdata;
+  data->layers[index].sharing = NULL;
 
   /* Set default name if none exists. Note we only call DATA_()  once
    * we know there is a default name, to avoid overhead of locale lookups
@@ -2763,6 +2875,9 @@ static void *customData_duplicate_referenced_layer_index(CustomData *data,
 
     layer->flag &= ~CD_FLAG_NOFREE;
   }
+  else {
+    customData_layer_ensure_private(layer);
+  }
 
   return layer->data;
 }
@@ -2807,7 +2922,7 @@ bool CustomData_is_referenced_layer(struct CustomData *data, int type)
 
   CustomDataLayer *layer = &data->layers[layer_index];
 
-  return (layer->flag & CD_FLAG_NOFREE) != 0;
+  return (layer->flag & CD_FLAG_NOFREE) != 0 || layer->sharing != NULL;
 }
 
 void CustomData_free_temporary(CustomData *data, int totelem)
@@ -2953,6 +3068,117 @@ void CustomData_copy_data(
   }
 }
 
+static void CustomData_copy_data_layer_indices(const CustomData *source,
+                                               CustomData *dest,
+                                               int src_i,
+                                               int dst_i,
+                                               const int *src_indices,
+                                               int dst_index,
+                                               int count)
+{
+  const void *src_data = source->layers[src_i].data;
+  void *dst_data = dest->layers[dst_i].data;
+
+  if (!src_data || !dst_data) {
+    if (!(src_data == NULL && dst_data == NULL)) {
+      CLOG_WARN(&LOG,
+                "null data for %s type (%p --> %p), skipping",
+                layerType_getName(source->layers[src_i].type),
+                (void *)src_data,
+                (void *)dst_data);
+    }
+    return;
+  }
+
+  const LayerTypeInfo *typeInfo = layerType_getInfo(source->layers[src_i].type);
+  const size_t size = (size_t)typeInfo->size;
+  void *dst_data_ofs = POINTER_OFFSET(dst_data, (size_t)dst_index * size);
+
+  if (typeInfo->copy) {
+    for (int i = 0; i < count; i++) {
+      typeInfo->copy(POINTER_OFFSET(src_data, (size_t)src_indices[i] * size), dst_data_ofs, 1);
+      dst_data_ofs = POINTER_OFFSET(dst_data_ofs, size);
+    }
+    return;
+  }
+
+  /* Plain data, use a constant size for the common cases so the copies are inlined. */
+#define COPY_ELEMENTS_OF_SIZE(elem_size) \
+  for (int i = 0; i < count; i++) { \
+    memcpy(POINTER_OFFSET(dst_data_ofs, (size_t)i * (elem_size)), \
+           POINTER_OFFSET(src_data, (size_t)src_indices[i] * (elem_size)), \
+           (elem_size)); \
+  } \
+  ((void)0)
+
+  switch (size) {
+    case 1:
+      COPY_ELEMENTS_OF_SIZE(1);
+      break;
+    case 4:
+      COPY_ELEMENTS_OF_SIZE(4);
+      break;
+    case 8:
+      COPY_ELEMENTS_OF_SIZE(8);
+      break;
+    case 12:
+      COPY_ELEMENTS_OF_SIZE(12);
+      break;
+    case 16:
+      COPY_ELEMENTS_OF_SIZE(16);
+      break;
+    default:
+      COPY_ELEMENTS_OF_SIZE(size);
+      break;
+  }
+
+#undef COPY_ELEMENTS_OF_SIZE
+}
+
+/**
+ * Gather variant of #CustomData_copy_data: copies the source elements at \a src_indices to the
+ * \a count consecutive destination elements starting at \a dest_index.
+ *
+ * Use this instead of calling #CustomData_copy_data for every element, the layers are only
+ * looked up once and plain data layers are copied without going through callbacks.
+ */
+void CustomData_copy_data_indices(
+    const CustomData *source, CustomData *dest, const int *src_indices, int dest_index, int count)
+{
+  if (count <= 0) {
+    return;
+  }
+
+  /* copies a layer at a time */
+  int dest_i = 0;
+  for (int src_i = 0; src_i < source->totlayer; src_i++) {
+
+    /* find the first dest layer with type >= the source type
+     * (this should work because layers are ordered by type)
+     */
+    while (dest_i < dest->totlayer && dest->layers[dest_i].type < source->layers[src_i].type) {
+      dest_i++;
+    }
+
+    /* if there are no more dest layers, we're done */
+    if (dest_i >= dest->totlayer) {
+      return;
+    }
+
+    /* if we found a matching layer, copy the data */
+    if (dest->layers[dest_i].type == source->layers[src_i].type) {
+      CustomData_copy_data_layer_indices(
+          source, dest, src_i, dest_i, src_indices, dest_index, count);
+
+      /* if there are multiple source & dest layers of the same type,
+       * we don't want to copy all source layers to the same dest, so
+       * increment dest_i
+       */
+      dest_i++;
+    }
+  }
+}
+
 void CustomData_copy_layer_type_data(const CustomData *source,
                                      CustomData *destination,
                                      int type,
@@ -3243,6 +3469,15 @@ const char *CustomData_get_layer_name(const CustomData *data, int type, int n)
   return (layer_index == -1) ? NULL : data->layers[layer_index].name;
 }
 
+static void customData_layer_set_data(CustomDataLayer *layer, void *ptr)
+{
+  if (layer->sharing) {
+    /* The previous data is handed over to the caller only when no other layers use it. */
+    customData_layer_unshare(layer);
+  }
+  layer->data = ptr;
+}
+
 void *CustomData_set_layer(const CustomData *data, int type, void *ptr)
 {
   /* get the layer index of the first layer of type */
@@ -3252,7 +3487,7 @@ void *CustomData_set_layer(const CustomData *data, int type, void *ptr)
     return NULL;
   }
 
-  data->layers[layer_index].data = ptr;
+  customData_layer_set_data(&data->layers[layer_index], ptr);
 
   return ptr;
 }
@@ -3265,7 +3500,7 @@ void *CustomData_set_layer_n(const struct CustomData *data, int type, int n, voi
     return NULL;
   }
 
-  data->layers[layer_index].data = ptr;
+  customData_layer_set_data(&data->layers[layer_index], ptr);
 
   return ptr;
 }
@@ -4245,7 +4480,9 @@ void CustomData_blend_write_prepare(CustomData *data,
         }
         write_layers_size += chunk_size;
       }
-      write_layers[j++] = *layer;
+      write_layers[j] = *layer;
+      write_layers[j].sharing = NULL;
+      j++;
     }
   }
   BLI_assert(j == data->totlayer);
@@ -5174,6 +5411,7 @@ void CustomData_blend_read(BlendDataReader *reader, CustomData *data, int count)
     }
 
     layer->flag &= ~CD_FLAG_NOFREE;
+    layer->sharing = NULL;
 
     if (CustomData_verify_versions(data, i)) {
       BLO_read_data_address(reader, &layer->data);
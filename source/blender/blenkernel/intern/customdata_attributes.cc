@@ -0,0 +1,73 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bke
+ */
+
+#include "BKE_customdata.h"
+#include "BKE_customdata_attributes.hh"
+
+#include "BLI_color.hh"
+#include "BLI_float2.hh"
+#include "BLI_float3.hh"
+
+#include "DNA_customdata_types.h"
+
+namespace blender::bke {
+
+/**
+ * Returns the type that is used to represent a single element of a generic attribute layer, or
+ * null when the layer type is not supported by the function system.
+ */
+const fn::CPPType *custom_data_type_to_cpp_type(const int type)
+{
+  switch (type) {
+    case CD_PROP_FLOAT:
+      return &fn::CPPType::get<float>();
+    case CD_PROP_FLOAT2:
+      return &fn::CPPType::get<float2>();
+    case CD_PROP_FLOAT3:
+      return &fn::CPPType::get<float3>();
+    case CD_PROP_INT32:
+      return &fn::CPPType::get<int32_t>();
+    case CD_PROP_COLOR:
+      return &fn::CPPType::get<Color4f>();
+  }
+  return nullptr;
+}
+
+CustomDataAttributes::CustomDataAttributes(CustomData &custom_data, const int64_t size)
+    : size_(size)
+{
+  fn::AttributesInfoBuilder info_builder;
+  for (const int i : IndexRange(custom_data.totlayer)) {
+    CustomDataLayer &layer = custom_data.layers[i];
+    const fn::CPPType *type = custom_data_type_to_cpp_type(layer.type);
+    if (type == nullptr) {
+      continue;
+    }
+    if (!info_builder.add(layer.name, *type)) {
+      continue;
+    }
+    void *data = CustomData_duplicate_referenced_layer_named(
+        &custom_data, layer.type, layer.name, size);
+    buffers_.append(data);
+  }
+  info_ = std::make_unique<fn::AttributesInfo>(info_builder);
+}
+
+}  // namespace blender::bke
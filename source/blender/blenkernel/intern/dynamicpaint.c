@@ -200,6 +200,8 @@ typedef struct PaintBakeData {
   /* adjacency info */
   /** current global neighbor distances and directions, if required */
   BakeAdjPoint *bNeighs;
+  /** sum of all neighbor distances, and its average */
+  double total_dist;
   double average_dist;
   /* space partitioning */
   /** space partitioning grid to optimize brush checks */
@@ -4860,11 +4862,16 @@ static void dynamicPaint_prepareAdjacencyData(DynamicPaintSurface *surface, cons
     return;
   }
 
-  if (bData->bNeighs) {
+  /* Reuse the previous frame's array, all neighbors are overwritten. */
+  const size_t bneighs_len = sData->adj_data->total_targets * sizeof(*bNeighs);
+  if (bData->bNeighs && MEM_allocN_len(bData->bNeighs) != bneighs_len) {
     MEM_freeN(bData->bNeighs);
+    bData->bNeighs = NULL;
   }
-  bNeighs = bData->bNeighs = MEM_mallocN(sData->adj_data->total_targets * sizeof(*bNeighs),
-                                         "PaintEffectBake");
+  if (!bData->bNeighs) {
+    bData->bNeighs = MEM_mallocN(bneighs_len, "PaintEffectBake");
+  }
+  bNeighs = bData->bNeighs;
   if (!bNeighs) {
     return;
   }
@@ -4878,15 +4885,15 @@ static void dynamicPaint_prepareAdjacencyData(DynamicPaintSurface *surface, cons
   /* calculate average values (single thread).
    * Note: tried to put this in threaded callback (using _reduce feature),
    * but gave ~30% slower result! */
-  bData->average_dist = 0.0;
+  bData->total_dist = 0.0;
   for (index = 0; index < sData->total_points; index++) {
     int numOfNeighs = adj_data->n_num[index];
 
     for (int i = 0; i < numOfNeighs; i++) {
-      bData->average_dist += (double)bNeighs[adj_data->n_index[index] + i].dist;
+      bData->total_dist += (double)bNeighs[adj_data->n_index[index] + i].dist;
     }
   }
-  bData->average_dist /= adj_data->total_targets;
+  bData->average_dist = bData->total_dist / adj_data->total_targets;
 }
 
 /* Find two adjacency points (closest_id) and influence (closest_d)
@@ -5721,15 +5728,13 @@ static void dynamic_paint_wave_step_cb(void *__restrict userdata,
 static void dynamicPaint_doWaveStep(DynamicPaintSurface *surface, float timescale)
 {
   PaintSurfaceData *sData = surface->data;
-  BakeAdjPoint *bNeighs = sData->bData->bNeighs;
-  int index;
   int steps, ss;
   float dt, min_dist, damp_factor;
   const float wave_speed = surface->wave_speed;
   const float wave_max_slope = (surface->wave_smoothness >= 0.01f) ?
                                    (0.5f / surface->wave_smoothness) :
                                    0.0f;
-  double average_dist = 0.0f;
+  double average_dist;
   const float canvas_size = getSurfaceDimension(sData);
   const float wave_scale = CANVAS_REL_SIZE / canvas_size;
 
@@ -5739,15 +5744,9 @@ static void dynamicPaint_doWaveStep(DynamicPaintSurface *surface, float timescal
     return;
   }
 
-  /* calculate average neigh distance (single thread) */
-  for (index = 0; index < sData->total_points; index++) {
-    int numOfNeighs = sData->adj_data->n_num[index];
-
-    for (int i = 0; i < numOfNeighs; i++) {
-      average_dist += (double)bNeighs[sData->adj_data->n_index[index] + i].dist;
-    }
-  }
-  average_dist *= (double)wave_scale / sData->adj_data->total_targets;
+  /* average neigh distance, summed when the neighbor distances were last updated */
+  average_dist = sData->bData->total_dist *
+                 ((double)wave_scale / sData->adj_data->total_targets);
 
   /* determine number of required steps */
   steps = (int)ceil((double)(WAVE_TIME_FAC * timescale * surface->wave_timescale) /
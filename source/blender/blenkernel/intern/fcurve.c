@@ -1759,26 +1759,28 @@ static float fcurve_eval_keyframes_extrapolate(
   return endpoint_bezt->vec[1][1] - (fac * dx);
 }
 
-static float fcurve_eval_keyframes_interpolate(FCurve *fcu, BezTriple *bezts, float evaltime)
+/* Threshold for finding the keyframes of the segment which contains the evaluation time.
+ *
+ * The threshold here has the following constraints:
+ * - 0.001 is too coarse:
+ *   We get artifacts with 2cm driver movements at 1BU = 1m (see T40332).
+ *
+ * - 0.00001 is too fine:
+ *   Weird errors, like selecting the wrong keyframe range (see T39207), occur.
+ *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
+ */
+#define FCURVE_EVAL_KEYFRAME_THRESH 0.0001f
+
+/**
+ * Evaluate the segment ending at keyframe \a a,
+ * as found by #BKE_fcurve_bezt_binarysearch_index_ex.
+ */
+static float fcurve_eval_keyframes_segment(
+    FCurve *fcu, BezTriple *bezts, unsigned int a, bool exact, float evaltime)
 {
   const float eps = 1.e-8f;
   BezTriple *bezt, *prevbezt;
-  unsigned int a;
-
-  /* Evaltime occurs somewhere in the middle of the curve. */
-  bool exact = false;
 
-  /* Use binary search to find appropriate keyframes...
-   *
-   * The threshold here has the following constraints:
-   * - 0.001 is too coarse:
-   *   We get artifacts with 2cm driver movements at 1BU = 1m (see T40332).
-   *
-   * - 0.00001 is too fine:
-   *   Weird errors, like selecting the wrong keyframe range (see T39207), occur.
-   *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
-   */
-  a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
   bezt = bezts + a;
 
   if (exact) {
@@ -2020,6 +2022,18 @@ static float fcurve_eval_keyframes_interpolate(FCurve *fcu, BezTriple *bezts, fl
   return 0.0f;
 }
 
+static float fcurve_eval_keyframes_interpolate(FCurve *fcu, BezTriple *bezts, float evaltime)
+{
+  /* Evaltime occurs somewhere in the middle of the curve. */
+  bool exact = false;
+
+  /* Use binary search to find appropriate keyframes. */
+  const unsigned int a = BKE_fcurve_bezt_binarysearch_index_ex(
+      bezts, evaltime, fcu->totvert, FCURVE_EVAL_KEYFRAME_THRESH, &exact);
+
+  return fcurve_eval_keyframes_segment(fcu, bezts, a, exact, evaltime);
+}
+
 /* Calculate F-Curve value for 'evaltime' using #BezTriple keyframes. */
 static float fcurve_eval_keyframes(FCurve *fcu, BezTriple *bezts, float evaltime)
 {
@@ -2124,6 +2138,71 @@ float evaluate_fcurve(FCurve *fcu, float evaltime)
   return evaluate_fcurve_ex(fcu, evaltime, 0.0);
 }
 
+/**
+ * Evaluate the F-Curve at many times, e.g. for baking or exporting.
+ *
+ * When the times are increasing, the keyframes are walked along with them instead of being
+ * searched for every time, and the modifier stack storage is only allocated once.
+ */
+void evaluate_fcurve_times(FCurve *fcu,
+                           const float *evaltimes,
+                           const int evaltimes_num,
+                           float *r_values)
+{
+  BLI_assert(fcu->driver == NULL);
+
+  if (fcu->bezt == NULL || !BLI_listbase_is_empty(&fcu->modifiers)) {
+    for (int i = 0; i < evaltimes_num; i++) {
+      r_values[i] = evaluate_fcurve_ex(fcu, evaltimes[i], 0.0f);
+    }
+    return;
+  }
+
+  BezTriple *bezts = fcu->bezt;
+  const unsigned int totvert = (unsigned int)fcu->totvert;
+  const float first_time = bezts[0].vec[1][0];
+  const float last_time = bezts[totvert - 1].vec[1][0];
+
+  /* Index of the keyframe ending the segment of the previous time. */
+  unsigned int a = 0;
+  float evaltime_prev = -FLT_MAX;
+
+  for (int i = 0; i < evaltimes_num; i++) {
+    const float evaltime = evaltimes[i];
+    float cvalue;
+
+    if (evaltime <= first_time) {
+      cvalue = fcurve_eval_keyframes_extrapolate(fcu, bezts, evaltime, 0, +1);
+    }
+    else if (last_time <= evaltime) {
+      cvalue = fcurve_eval_keyframes_extrapolate(fcu, bezts, evaltime, fcu->totvert - 1, -1);
+    }
+    else {
+      bool exact;
+      if (evaltime < evaltime_prev) {
+        a = BKE_fcurve_bezt_binarysearch_index_ex(
+            bezts, evaltime, fcu->totvert, FCURVE_EVAL_KEYFRAME_THRESH, &exact);
+      }
+      else {
+        /* Same result as the binary search, for keyframes which are not closer than the
+         * threshold to each other. */
+        while (a < totvert - 1 && bezts[a].vec[1][0] < evaltime &&
+               !IS_EQT(evaltime, bezts[a].vec[1][0], FCURVE_EVAL_KEYFRAME_THRESH)) {
+          a++;
+        }
+        exact = IS_EQT(evaltime, bezts[a].vec[1][0], FCURVE_EVAL_KEYFRAME_THRESH);
+      }
+      cvalue = fcurve_eval_keyframes_segment(fcu, bezts, a, exact, evaltime);
+    }
+
+    if (fcu->flag & FCURVE_INT_VALUES) {
+      cvalue = floorf(cvalue + 0.5f);
+    }
+    r_values[i] = cvalue;
+    evaltime_prev = evaltime;
+  }
+}
+
 float evaluate_fcurve_only_curve(FCurve *fcu, float evaltime)
 {
   /* Can be used to evaluate the (keyframed) fcurve only.
@@ -2411,6 +2490,8 @@ void BKE_fcurve_blend_read_data(BlendDataReader *reader, ListBase *fcurves)
           else {
             dtar->rna_path = NULL;
           }
+          dtar->rna_cache_type = NULL;
+          dtar->rna_cache_prop = NULL;
         }
         DRIVER_TARGETS_LOOPER_END;
       }
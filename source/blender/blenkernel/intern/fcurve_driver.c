@@ -44,6 +44,8 @@
 #include "BKE_global.h"
 #include "BKE_object.h"
 
+#include "DEG_depsgraph_query.h"
+
 #include "RNA_access.h"
 
 #include "atomic_ops.h"
@@ -129,7 +131,12 @@ static float dtar_get_prop_val(ChannelDriver *driver, DriverTarget *dtar)
   RNA_id_pointer_create(id, &id_ptr);
 
   /* Get property to read from, and get value as appropriate. */
-  if (!RNA_path_resolve_property_full(&id_ptr, dtar->rna_path, &ptr, &prop, &index)) {
+  if (dtar->rna_cache_prop != NULL && dtar->rna_cache_type == id_ptr.type) {
+    ptr = id_ptr;
+    prop = dtar->rna_cache_prop;
+    index = dtar->rna_cache_index;
+  }
+  else if (!RNA_path_resolve_property_full(&id_ptr, dtar->rna_path, &ptr, &prop, &index)) {
     /* Path couldn't be resolved. */
     if (G.debug & G_DEBUG) {
       CLOG_ERROR(&LOG,
@@ -142,6 +149,15 @@ static float dtar_get_prop_val(ChannelDriver *driver, DriverTarget *dtar)
     dtar->flag |= DTAR_FLAG_INVALID;
     return 0.0f;
   }
+  else if (DEG_is_evaluated_id(id) && ptr.data == id_ptr.data && ptr.type == id_ptr.type &&
+           !RNA_property_is_idprop(prop) && !RNA_property_is_runtime(prop)) {
+    /* Evaluated copies of the drivers are re-created whenever the original ones change, so the
+     * resolved property can be kept for the next evaluations. Only static properties of the ID
+     * itself are cached, nothing else is guaranteed to stay valid until then. */
+    dtar->rna_cache_type = id_ptr.type;
+    dtar->rna_cache_prop = prop;
+    dtar->rna_cache_index = index;
+  }
 
   if (RNA_property_array_check(prop)) {
     /* Array. */
@@ -768,6 +784,8 @@ void driver_variables_copy(ListBase *dst_vars, const ListBase *src_vars)
       if (dtar->rna_path) {
         dtar->rna_path = MEM_dupallocN(dtar->rna_path);
       }
+      dtar->rna_cache_type = NULL;
+      dtar->rna_cache_prop = NULL;
     }
     DRIVER_TARGETS_LOOPER_END;
   }
@@ -1064,6 +1082,10 @@ static bool driver_compile_simple_expr(ChannelDriver *driver)
   if (atomic_cas_ptr((void **)&driver->expr_simple, NULL, expr) != NULL) {
     BLI_expr_pylike_free(expr);
   }
+  else if (!BLI_expr_pylike_is_valid(expr)) {
+    /* Such drivers are evaluated by Python, holding the GIL, so they cannot run in parallel. */
+    CLOG_INFO(&LOG, 1, "driver expression needs Python: '%s'", driver->expression);
+  }
 
   return true;
 }
@@ -212,6 +212,31 @@ TEST(evaluate_fcurve, ExtrapolationBezierKeys)
   BKE_fcurve_free(fcu);
 }
 
+TEST(evaluate_fcurve_times, MatchesEvaluateFCurve)
+{
+  FCurve *fcu = BKE_fcurve_create();
+
+  insert_vert_fcurve(fcu, 1.0f, 7.0f, BEZT_KEYTYPE_KEYFRAME, INSERTKEY_NO_USERPREF);
+  insert_vert_fcurve(fcu, 5.0f, 13.0f, BEZT_KEYTYPE_KEYFRAME, INSERTKEY_NO_USERPREF);
+  insert_vert_fcurve(fcu, 6.0f, -2.0f, BEZT_KEYTYPE_KEYFRAME, INSERTKEY_NO_USERPREF);
+  insert_vert_fcurve(fcu, 10.0f, 4.0f, BEZT_KEYTYPE_KEYFRAME, INSERTKEY_NO_USERPREF);
+  fcu->bezt[2].ipo = BEZT_IPO_LIN;
+  fcu->extend = FCURVE_EXTRAPOLATE_LINEAR;
+
+  /* Increasing times, including times on and right next to keys, then going back in time. */
+  const float evaltimes[] = {
+      -1.0f, 1.0f, 1.5f, 4.99992f, 5.0f, 5.5f, 6.00008f, 7.25f, 10.0f, 12.0f, 3.0f, 8.0f};
+  constexpr int evaltimes_num = sizeof(evaltimes) / sizeof(*evaltimes);
+  float values[evaltimes_num];
+  evaluate_fcurve_times(fcu, evaltimes, evaltimes_num, values);
+
+  for (int i = 0; i < evaltimes_num; i++) {
+    EXPECT_NEAR(values[i], evaluate_fcurve(fcu, evaltimes[i]), EPSILON) << "at " << evaltimes[i];
+  }
+
+  BKE_fcurve_free(fcu);
+}
+
 TEST(fcurve_subdivide, BKE_fcurve_bezt_subdivide_handles)
 {
   FCurve *fcu = BKE_fcurve_create();
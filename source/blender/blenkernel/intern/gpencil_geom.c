@@ -1258,6 +1258,41 @@ void BKE_gpencil_stroke_fill_triangulate(bGPDstroke *gps)
   MEM_SAFE_FREE(uv);
 }
 
+/**
+ * Update the fill texture coordinates of a stroke whose points did not move,
+ * keeping its triangulation. Only the UV transform of the fill is taken into account,
+ * strokes without triangulation yet are triangulated.
+ * \param gps: Grease pencil stroke
+ */
+void BKE_gpencil_stroke_fill_uv_update(bGPDstroke *gps)
+{
+  if (gps->totpoints < 3) {
+    return;
+  }
+  if (gps->triangles == NULL) {
+    BKE_gpencil_stroke_fill_triangulate(gps);
+    return;
+  }
+
+  float(*points2d)[2] = MEM_mallocN(sizeof(*points2d) * gps->totpoints,
+                                    "GP Stroke temp 2d points");
+  float(*uv)[2] = MEM_mallocN(sizeof(*uv) * gps->totpoints, "GP Stroke temp 2d uv data");
+
+  int direction = 0;
+  BKE_gpencil_stroke_2d_flat(gps->points, gps->totpoints, points2d, &direction);
+
+  const float minv[2] = {-1.0f, -1.0f};
+  const float maxv[2] = {1.0f, 1.0f};
+  gpencil_calc_stroke_fill_uv(points2d, gps, minv, maxv, uv);
+
+  for (int i = 0; i < gps->totpoints; i++) {
+    copy_v2_v2(gps->points[i].uv_fill, uv[i]);
+  }
+
+  MEM_freeN(points2d);
+  MEM_freeN(uv);
+}
+
 /**
  * Update Stroke UV data.
  * \param gps: Grease pencil stroke
@@ -29,6 +29,7 @@
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -726,6 +727,65 @@ void BKE_gpencil_prepare_eval_data(Depsgraph *depsgraph, Scene *scene, Object *o
   BKE_gpencil_update_orig_pointers(ob_orig, ob);
 }
 
+typedef struct GpencilDeformStrokeData {
+  GpencilModifierData *md;
+  const GpencilModifierTypeInfo *mti;
+  Depsgraph *depsgraph;
+  Object *ob;
+  bGPDlayer *gpl;
+  bGPDframe *gpf;
+  bGPDstroke **strokes;
+} GpencilDeformStrokeData;
+
+static void gpencil_deform_stroke_task(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  GpencilDeformStrokeData *data = userdata;
+  data->mti->deformStroke(
+      data->md, data->depsgraph, data->ob, data->gpl, data->gpf, data->strokes[i]);
+}
+
+/* Strokes only deform their own points, so they are evaluated in parallel. */
+static void gpencil_deform_frame_strokes(GpencilModifierData *md,
+                                         const GpencilModifierTypeInfo *mti,
+                                         Depsgraph *depsgraph,
+                                         Object *ob,
+                                         bGPDlayer *gpl,
+                                         bGPDframe *gpf)
+{
+  const int tot_strokes = BLI_listbase_count(&gpf->strokes);
+  if (tot_strokes < 2) {
+    LISTBASE_FOREACH (bGPDstroke *, gps, &gpf->strokes) {
+      mti->deformStroke(md, depsgraph, ob, gpl, gpf, gps);
+    }
+    return;
+  }
+
+  bGPDstroke **strokes = MEM_mallocN(sizeof(*strokes) * tot_strokes, __func__);
+  int i = 0;
+  LISTBASE_FOREACH (bGPDstroke *, gps, &gpf->strokes) {
+    strokes[i++] = gps;
+  }
+
+  GpencilDeformStrokeData data = {
+      .md = md,
+      .mti = mti,
+      .depsgraph = depsgraph,
+      .ob = ob,
+      .gpl = gpl,
+      .gpf = gpf,
+      .strokes = strokes,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 8;
+  BLI_task_parallel_range(0, tot_strokes, &data, gpencil_deform_stroke_task, &settings);
+
+  MEM_freeN(strokes);
+}
+
 /** Calculate gpencil modifiers.
  * \param depsgraph: Current depsgraph
  * \param scene: Current scene
@@ -773,9 +833,7 @@ void BKE_gpencil_modifiers_calc(Depsgraph *depsgraph, Scene *scene, Object *ob)
           }
 
           if (mti->deformStroke) {
-            LISTBASE_FOREACH (bGPDstroke *, gps, &gpf->strokes) {
-              mti->deformStroke(md, depsgraph, ob, gpl, gpf, gps);
-            }
+            gpencil_deform_frame_strokes(md, mti, depsgraph, ob, gpl, gpf);
           }
         }
       }
@@ -27,6 +27,7 @@
 #include <string.h>
 
 #include "BLI_endian_switch.h"
+#include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_string.h"
@@ -474,6 +475,75 @@ void IDP_AssignID(IDProperty *prop, ID *id, const int flag)
 /** \name Group Functions (IDProperty Group API)
  * \{ */
 
+/**
+ * Groups with many children also keep a hash of them by name in `data.pointer` (unused by groups
+ * otherwise), to avoid going over the whole list on each lookup. It is only modified along with
+ * the group itself, so lookups remain safe to do from several threads.
+ *
+ * Children names can still be changed in place from outside of this API, so lookups check the
+ * names of found properties, and go over the list when the hash has no match.
+ */
+#define IDP_GROUP_HASH_LEN_MIN 32
+
+static void idp_group_hash_free(IDProperty *group)
+{
+  if (group->data.pointer != NULL) {
+    BLI_ghash_free(group->data.pointer, MEM_freeN, NULL);
+    group->data.pointer = NULL;
+  }
+}
+
+static void idp_group_hash_ensure(IDProperty *group)
+{
+  if (group->data.pointer != NULL || group->len < IDP_GROUP_HASH_LEN_MIN) {
+    return;
+  }
+
+  GHash *hash = BLI_ghash_str_new_ex(__func__, (uint)group->len);
+  LISTBASE_FOREACH (IDProperty *, loop, &group->data.group) {
+    void **key_p, **val_p;
+    /* Keep the first property in case of duplicate names, as #BLI_findstring would. */
+    if (!BLI_ghash_ensure_p_ex(hash, loop->name, &key_p, &val_p)) {
+      *key_p = BLI_strdup(loop->name);
+      *val_p = loop;
+    }
+  }
+  group->data.pointer = hash;
+}
+
+/* Call after adding \a prop to the group's list. */
+static void idp_group_hash_add(IDProperty *group, IDProperty *prop)
+{
+  if (group->data.pointer == NULL) {
+    idp_group_hash_ensure(group);
+    return;
+  }
+  BLI_ghash_reinsert(group->data.pointer, BLI_strdup(prop->name), prop, MEM_freeN, NULL);
+}
+
+/* Call before or after removing \a prop from the group's list. */
+static void idp_group_hash_remove(IDProperty *group, IDProperty *prop)
+{
+  GHash *hash = group->data.pointer;
+  if (hash == NULL) {
+    return;
+  }
+  if (BLI_ghash_lookup(hash, prop->name) == prop) {
+    BLI_ghash_remove(hash, prop->name, MEM_freeN, NULL);
+  }
+  else {
+    /* The property was renamed since it got added, the hash cannot be trusted anymore. */
+    idp_group_hash_free(group);
+  }
+}
+
+static void idp_group_replace(IDProperty *group, IDProperty *prop_old, IDProperty *prop_new)
+{
+  idp_group_hash_remove(group, prop_old);
+  BLI_insertlinkreplace(&group->data.group, prop_old, prop_new);
+  idp_group_hash_add(group, prop_new);
+}
+
 /**
  * Checks if a property with the same name as prop exists, and if so replaces it.
  */
@@ -489,6 +559,7 @@ static IDProperty *IDP_CopyGroup(const IDProperty *prop, const int flag)
   for (link = prop->data.group.first; link; link = link->next) {
     BLI_addtail(&newp->data.group, IDP_CopyProperty_ex(link, flag));
   }
+  idp_group_hash_ensure(newp);
 
   return newp;
 }
@@ -503,7 +574,7 @@ void IDP_SyncGroupValues(IDProperty *dest, const IDProperty *src)
   BLI_assert(src->type == IDP_GROUP);
 
   for (prop = src->data.group.first; prop; prop = prop->next) {
-    other = BLI_findstring(&dest->data.group, prop->name, offsetof(IDProperty, name));
+    other = IDP_GetPropertyFromGroup(dest, prop->name);
     if (other && prop->type == other->type) {
       switch (prop->type) {
         case IDP_INT:
@@ -515,7 +586,7 @@ void IDP_SyncGroupValues(IDProperty *dest, const IDProperty *src)
           IDP_SyncGroupValues(other, prop);
           break;
         default: {
-          BLI_insertlinkreplace(&dest->data.group, other, IDP_CopyProperty(prop));
+          idp_group_replace(dest, other, IDP_CopyProperty(prop));
           IDP_FreeProperty(other);
           break;
         }
@@ -536,7 +607,7 @@ void IDP_SyncGroupTypes(IDProperty *dest, const IDProperty *src, const bool do_a
       if ((prop_dst->type != prop_src->type || prop_dst->subtype != prop_src->subtype) ||
           (do_arraylen && ELEM(prop_dst->type, IDP_ARRAY, IDP_IDPARRAY) &&
            (prop_src->len != prop_dst->len))) {
-        BLI_insertlinkreplace(&dest->data.group, prop_dst, IDP_CopyProperty(prop_src));
+        idp_group_replace(dest, prop_dst, IDP_CopyProperty(prop_src));
         IDP_FreeProperty(prop_dst);
       }
       else if (prop_dst->type == IDP_GROUP) {
@@ -560,19 +631,17 @@ void IDP_ReplaceGroupInGroup(IDProperty *dest, const IDProperty *src)
   BLI_assert(src->type == IDP_GROUP);
 
   for (prop = src->data.group.first; prop; prop = prop->next) {
-    for (loop = dest->data.group.first; loop; loop = loop->next) {
-      if (STREQ(loop->name, prop->name)) {
-        BLI_insertlinkreplace(&dest->data.group, loop, IDP_CopyProperty(prop));
-        IDP_FreeProperty(loop);
-        break;
-      }
+    loop = IDP_GetPropertyFromGroup(dest, prop->name);
+    if (loop != NULL) {
+      idp_group_replace(dest, loop, IDP_CopyProperty(prop));
+      IDP_FreeProperty(loop);
     }
-
-    /* only add at end if not added yet */
-    if (loop == NULL) {
+    else {
+      /* only add at end if not added yet */
       IDProperty *copy = IDP_CopyProperty(prop);
       dest->len++;
       BLI_addtail(&dest->data.group, copy);
+      idp_group_hash_add(dest, copy);
     }
   }
 }
@@ -587,12 +656,13 @@ void IDP_ReplaceInGroup_ex(IDProperty *group, IDProperty *prop, IDProperty *prop
   BLI_assert(prop_exist == IDP_GetPropertyFromGroup(group, prop->name));
 
   if (prop_exist != NULL) {
-    BLI_insertlinkreplace(&group->data.group, prop_exist, prop);
+    idp_group_replace(group, prop_exist, prop);
     IDP_FreeProperty(prop_exist);
   }
   else {
     group->len++;
     BLI_addtail(&group->data.group, prop);
+    idp_group_hash_add(group, prop);
   }
 }
 
@@ -645,6 +715,7 @@ void IDP_MergeGroup_ex(IDProperty *dest,
         IDProperty *copy = IDP_CopyProperty_ex(prop, flag);
         dest->len++;
         BLI_addtail(&dest->data.group, copy);
+        idp_group_hash_add(dest, copy);
       }
     }
   }
@@ -676,6 +747,7 @@ bool IDP_AddToGroup(IDProperty *group, IDProperty *prop)
   if (IDP_GetPropertyFromGroup(group, prop->name) == NULL) {
     group->len++;
     BLI_addtail(&group->data.group, prop);
+    idp_group_hash_add(group, prop);
     return true;
   }
 
@@ -693,6 +765,7 @@ bool IDP_InsertToGroup(IDProperty *group, IDProperty *previous, IDProperty *pnew
   if (IDP_GetPropertyFromGroup(group, pnew->name) == NULL) {
     group->len++;
     BLI_insertlinkafter(&group->data.group, previous, pnew);
+    idp_group_hash_add(group, pnew);
     return true;
   }
 
@@ -711,6 +784,7 @@ void IDP_RemoveFromGroup(IDProperty *group, IDProperty *prop)
 
   group->len--;
   BLI_remlink(&group->data.group, prop);
+  idp_group_hash_remove(group, prop);
 }
 
 /**
@@ -726,6 +800,14 @@ IDProperty *IDP_GetPropertyFromGroup(const IDProperty *prop, const char *name)
 {
   BLI_assert(prop->type == IDP_GROUP);
 
+  GHash *hash = prop->data.pointer;
+  if (hash != NULL) {
+    IDProperty *idprop = BLI_ghash_lookup(hash, name);
+    if (idprop != NULL && STREQ(idprop->name, name)) {
+      return idprop;
+    }
+  }
+
   return (IDProperty *)BLI_findstring(&prop->data.group, name, offsetof(IDProperty, name));
 }
 /** same as above but ensure type match */
@@ -748,6 +830,7 @@ static void IDP_FreeGroup(IDProperty *prop, const bool do_id_user)
     IDP_FreePropertyContent_ex(loop, do_id_user);
   }
   BLI_freelistN(&prop->data.group);
+  idp_group_hash_free(prop);
 }
 /** \} */
 
@@ -1204,7 +1287,15 @@ void IDP_WriteProperty_OnlyData(const IDProperty *prop, BlendWriter *writer)
 
 void IDP_BlendWrite(BlendWriter *writer, const IDProperty *prop)
 {
-  BLO_write_struct(writer, IDProperty, prop);
+  if (prop->type == IDP_GROUP && prop->data.pointer != NULL) {
+    /* Do not write the runtime hash of the group. */
+    IDProperty prop_tmp = *prop;
+    prop_tmp.data.pointer = NULL;
+    BLO_write_struct_at_address(writer, IDProperty, prop, &prop_tmp);
+  }
+  else {
+    BLO_write_struct(writer, IDProperty, prop);
+  }
   IDP_WriteProperty_OnlyData(prop, writer);
 }
 
@@ -1274,6 +1365,9 @@ static void IDP_DirectLinkGroup(IDProperty *prop, BlendDataReader *reader)
   for (loop = prop->data.group.first; loop; loop = loop->next) {
     IDP_DirectLinkProperty(loop, reader);
   }
+
+  prop->data.pointer = NULL;
+  idp_group_hash_ensure(prop);
 }
 
 static void IDP_DirectLinkProperty(IDProperty *prop, BlendDataReader *reader)
@@ -0,0 +1,94 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 by Blender Foundation.
+ */
+#include "testing/testing.h"
+
+#include "BLI_string.h"
+
+#include "BKE_idprop.h"
+
+#include "DNA_ID.h"
+
+namespace blender::bke::tests {
+
+/* Enough children for the group to keep a hash of them. */
+static const int GROUP_LEN = 100;
+
+static IDProperty *idprop_group_create(void)
+{
+  IDPropertyTemplate val = {0};
+  IDProperty *group = IDP_New(IDP_GROUP, &val, "group");
+  for (int i = 0; i < GROUP_LEN; i++) {
+    char name[MAX_IDPROP_NAME];
+    BLI_snprintf(name, sizeof(name), "prop_%d", i);
+    val.i = i;
+    EXPECT_TRUE(IDP_AddToGroup(group, IDP_New(IDP_INT, &val, name)));
+  }
+  return group;
+}
+
+TEST(idprop_group, Lookup)
+{
+  IDProperty *group = idprop_group_create();
+  IDPropertyTemplate val = {0};
+
+  IDProperty *prop = IDP_GetPropertyFromGroup(group, "prop_42");
+  ASSERT_NE(prop, nullptr);
+  EXPECT_EQ(IDP_Int(prop), 42);
+  EXPECT_EQ(IDP_GetPropertyFromGroup(group, "missing"), nullptr);
+
+  /* Names must stay unique. */
+  IDProperty *prop_dup = IDP_New(IDP_INT, &val, "prop_7");
+  EXPECT_FALSE(IDP_AddToGroup(group, prop_dup));
+  IDP_FreeProperty(prop_dup);
+
+  IDP_FreeFromGroup(group, prop);
+  EXPECT_EQ(IDP_GetPropertyFromGroup(group, "prop_42"), nullptr);
+  EXPECT_EQ(group->len, GROUP_LEN - 1);
+
+  val.i = -1;
+  IDP_ReplaceInGroup(group, IDP_New(IDP_INT, &val, "prop_3"));
+  EXPECT_EQ(IDP_Int(IDP_GetPropertyFromGroup(group, "prop_3")), -1);
+
+  IDProperty *group_copy = IDP_CopyProperty(group);
+  EXPECT_EQ(IDP_Int(IDP_GetPropertyFromGroup(group_copy, "prop_3")), -1);
+  EXPECT_EQ(IDP_Int(IDP_GetPropertyFromGroup(group_copy, "prop_99")), 99);
+  EXPECT_TRUE(IDP_EqualsProperties(group, group_copy));
+
+  IDP_FreeProperty(group_copy);
+  IDP_FreeProperty(group);
+}
+
+TEST(idprop_group, LookupAfterRename)
+{
+  IDProperty *group = idprop_group_create();
+
+  /* Rename in place, bypassing the group API. */
+  IDProperty *prop = IDP_GetPropertyFromGroup(group, "prop_10");
+  BLI_strncpy(prop->name, "renamed", sizeof(prop->name));
+
+  EXPECT_EQ(IDP_GetPropertyFromGroup(group, "prop_10"), nullptr);
+  EXPECT_EQ(IDP_GetPropertyFromGroup(group, "renamed"), prop);
+
+  IDP_FreeFromGroup(group, prop);
+  EXPECT_EQ(IDP_GetPropertyFromGroup(group, "renamed"), nullptr);
+  EXPECT_EQ(IDP_Int(IDP_GetPropertyFromGroup(group, "prop_11")), 11);
+
+  IDP_FreeProperty(group);
+}
+
+}  // namespace blender::bke::tests
@@ -31,6 +31,7 @@
 #include "BLI_endian_switch.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -926,62 +927,82 @@ static void key_evaluate_relative(const int start,
         poin += start * poinsize;
         reffrom += key->elemsize * start; /* key elemsize yes! */
         from += key->elemsize * start;
+        if (weights) {
+          /* Weights are only used for meshes and lattices, which have a step of one. */
+          BLI_assert(step == 1);
+          weights += start;
+        }
 
-        for (b = start; b < end; b += step) {
-
-          weight = weights ? (*weights * icuval) : icuval;
-
-          cp = key->elemstr;
-          if (mode == KEY_MODE_BEZTRIPLE) {
-            cp = elemstr;
+        if (ELEM(GS(key->from->name), ID_ME, ID_LT)) {
+          /* Meshes and lattices only store coordinates, blend them directly and skip the
+           * elements outside of the vertex group. */
+          float(*poin_co)[3] = (float(*)[3])poin;
+          const float(*reffrom_co)[3] = (const float(*)[3])reffrom;
+          const float(*from_co)[3] = (const float(*)[3])from;
+          for (b = 0; b < end - start; b++) {
+            weight = weights ? (weights[b] * icuval) : icuval;
+            if (weight != 0.0f) {
+              rel_flerp(KEYELEM_FLOAT_LEN_COORD, poin_co[b], reffrom_co[b], from_co[b], weight);
+            }
           }
+        }
+        else {
+          for (b = start; b < end; b += step) {
 
-          ofsp = ofs;
-
-          while (cp[0]) { /* (cp[0] == amount) */
-
-            switch (cp[1]) {
-              case IPO_FLOAT:
-                rel_flerp(KEYELEM_FLOAT_LEN_COORD,
-                          (float *)poin,
-                          (float *)reffrom,
-                          (float *)from,
-                          weight);
-                break;
-              case IPO_BPOINT:
-                rel_flerp(KEYELEM_FLOAT_LEN_BPOINT,
-                          (float *)poin,
-                          (float *)reffrom,
-                          (float *)from,
-                          weight);
-                break;
-              case IPO_BEZTRIPLE:
-                rel_flerp(KEYELEM_FLOAT_LEN_BEZTRIPLE,
-                          (float *)poin,
-                          (float *)reffrom,
-                          (float *)from,
-                          weight);
-                break;
-              default:
-                /* should never happen */
-                if (freefrom) {
-                  MEM_freeN(freefrom);
-                }
-                BLI_assert(!"invalid 'cp[1]'");
-                return;
-            }
+            weight = weights ? (*weights * icuval) : icuval;
 
-            poin += *ofsp;
+            cp = key->elemstr;
+            if (mode == KEY_MODE_BEZTRIPLE) {
+              cp = elemstr;
+            }
 
-            cp += 2;
-            ofsp++;
-          }
+            ofsp = ofs;
+
+            while (cp[0]) { /* (cp[0] == amount) */
+
+              switch (cp[1]) {
+                case IPO_FLOAT:
+                  rel_flerp(KEYELEM_FLOAT_LEN_COORD,
+                            (float *)poin,
+                            (float *)reffrom,
+                            (float *)from,
+                            weight);
+                  break;
+                case IPO_BPOINT:
+                  rel_flerp(KEYELEM_FLOAT_LEN_BPOINT,
+                            (float *)poin,
+                            (float *)reffrom,
+                            (float *)from,
+                            weight);
+                  break;
+                case IPO_BEZTRIPLE:
+                  rel_flerp(KEYELEM_FLOAT_LEN_BEZTRIPLE,
+                            (float *)poin,
+                            (float *)reffrom,
+                            (float *)from,
+                            weight);
+                  break;
+                default:
+                  /* should never happen */
+                  if (freefrom) {
+                    MEM_freeN(freefrom);
+                  }
+                  BLI_assert(!"invalid 'cp[1]'");
+                  return;
+              }
+
+              poin += *ofsp;
+
+              cp += 2;
+              ofsp++;
+            }
 
-          reffrom += elemsize;
-          from += elemsize;
+            reffrom += elemsize;
+            from += elemsize;
 
-          if (weights) {
-            weights++;
+            if (weights) {
+              weights++;
+            }
           }
         }
 
@@ -1381,6 +1402,58 @@ static void keyblock_free_per_block_weights(Key *key,
   MEM_freeN(per_keyblock_weights);
 }
 
+/* Number of elements evaluated by a single task of #do_mesh_key_relative. */
+#define KEY_RELATIVE_CHUNK_SIZE 4096
+
+typedef struct KeyRelativeData {
+  int tot;
+  char *out;
+  Key *key;
+  KeyBlock *actkb;
+  float **per_keyblock_weights;
+} KeyRelativeData;
+
+static void key_evaluate_relative_chunk_cb(void *__restrict userdata,
+                                           const int chunk,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KeyRelativeData *data = userdata;
+  const int start = chunk * KEY_RELATIVE_CHUNK_SIZE;
+  key_evaluate_relative(start,
+                        start + KEY_RELATIVE_CHUNK_SIZE,
+                        data->tot,
+                        data->out,
+                        data->key,
+                        data->actkb,
+                        data->per_keyblock_weights,
+                        KEY_MODE_DUMMY);
+}
+
+static void do_mesh_key_relative(
+    Key *key, KeyBlock *actkb, float **per_keyblock_weights, char *out, const int tot)
+{
+  const Mesh *me = (const Mesh *)key->from;
+  /* In edit-mode the data of the active key is fetched from the BMesh for every range,
+   * only split the work when the key data can be used directly. */
+  if (tot < KEY_RELATIVE_CHUNK_SIZE * 2 || (GS(me->id.name) == ID_ME && me->edit_mesh)) {
+    key_evaluate_relative(0, tot, tot, out, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+    return;
+  }
+
+  KeyRelativeData data = {
+      .tot = tot,
+      .out = out,
+      .key = key,
+      .actkb = actkb,
+      .per_keyblock_weights = per_keyblock_weights,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  const int chunks_len = (tot + KEY_RELATIVE_CHUNK_SIZE - 1) / KEY_RELATIVE_CHUNK_SIZE;
+  BLI_task_parallel_range(0, chunks_len, &data, key_evaluate_relative_chunk_cb, &settings);
+}
+
 static void do_mesh_key(Object *ob, Key *key, char *out, const int tot)
 {
   KeyBlock *k[4], *actkb = BKE_keyblock_from_object(ob);
@@ -1391,8 +1464,7 @@ static void do_mesh_key(Object *ob, Key *key, char *out, const int tot)
     WeightsArrayCache cache = {0, NULL};
     float **per_keyblock_weights;
     per_keyblock_weights = keyblock_get_per_block_weights(ob, key, &cache);
-    key_evaluate_relative(
-        0, tot, tot, (char *)out, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+    do_mesh_key_relative(key, actkb, per_keyblock_weights, out, tot);
     keyblock_free_per_block_weights(key, per_keyblock_weights, &cache);
   }
   else {
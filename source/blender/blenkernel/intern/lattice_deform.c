@@ -165,8 +165,8 @@ void BKE_lattice_deform_data_eval_co(LatticeDeformData *lattice_deform_data,
   const Lattice *lt = lattice_deform_data->lt;
   float u, v, w, tu[4], tv[4], tw[4];
   float vec[3];
-  int idx_w, idx_v, idx_u;
-  int ui, vi, wi, uu, vv, ww;
+  int idx_w[4], idx_v[4], idx_u[4];
+  int ui, vi, wi;
 
   /* vgroup influence */
   float co_prev[4] = {0}, weight_blend = 0.0f;
@@ -219,19 +219,32 @@ void BKE_lattice_deform_data_eval_co(LatticeDeformData *lattice_deform_data,
   const int w_stride = lt->pntsu * lt->pntsv;
   const int idx_w_max = (lt->pntsw - 1) * lt->pntsu * lt->pntsv;
   const int v_stride = lt->pntsu;
-  const int idx_v_max = (lt->pntsv - 1) * lt->pntsu;
-  const int idx_u_max = (lt->pntsu - 1);
-
-  for (ww = wi - 1; ww <= wi + 2; ww++) {
-    w = weight * tw[ww - wi + 1];
-    idx_w = CLAMPIS(ww * w_stride, 0, idx_w_max);
-    for (vv = vi - 1; vv <= vi + 2; vv++) {
-      v = w * tv[vv - vi + 1];
-      idx_v = CLAMPIS(vv * v_stride, 0, idx_v_max);
-      for (uu = ui - 1; uu <= ui + 2; uu++) {
-        u = v * tu[uu - ui + 1];
-        idx_u = CLAMPIS(uu, 0, idx_u_max);
-        const int idx = idx_w + idx_v + idx_u;
+
+  /* Offsets of the 4x4x4 neighborhood, clamped to the lattice bounds. */
+  for (int i = 0; i < 4; i++) {
+    idx_w[i] = CLAMPIS(wi + i - 1, 0, lt->pntsw - 1) * w_stride;
+    idx_v[i] = CLAMPIS(vi + i - 1, 0, lt->pntsv - 1) * v_stride;
+    idx_u[i] = CLAMPIS(ui + i - 1, 0, lt->pntsu - 1);
+  }
+
+  /* Skip points without influence, which is most of the neighborhood for lattices that are
+   * flat along an axis or use linear interpolation. */
+  for (int i_w = 0; i_w < 4; i_w++) {
+    w = weight * tw[i_w];
+    if (w == 0.0f) {
+      continue;
+    }
+    for (int i_v = 0; i_v < 4; i_v++) {
+      v = w * tv[i_v];
+      if (v == 0.0f) {
+        continue;
+      }
+      for (int i_u = 0; i_u < 4; i_u++) {
+        u = v * tu[i_u];
+        if (u == 0.0f) {
+          continue;
+        }
+        const int idx = idx_w[i_w] + idx_v[i_v] + idx_u[i_u];
 #ifdef __SSE2__
         {
           __m128 weight_vec = _mm_set1_ps(u);
@@ -272,6 +285,9 @@ void BKE_lattice_deform_data_destroy(LatticeDeformData *lattice_deform_data)
   if (lattice_deform_data->latticedata) {
     MEM_freeN(lattice_deform_data->latticedata);
   }
+  if (lattice_deform_data->lattice_weights) {
+    MEM_freeN(lattice_deform_data->lattice_weights);
+  }
 
   MEM_freeN(lattice_deform_data);
 }
@@ -78,6 +78,8 @@
 
 #include "atomic_ops.h"
 
+#include "lib_intern.h"
+
 //#define DEBUG_TIME
 
 #ifdef DEBUG_TIME
@@ -844,6 +846,7 @@ void BKE_libblock_management_main_remove(Main *bmain, void *idv)
 
   ListBase *lb = which_libbase(bmain, GS(id->name));
   BKE_main_lock(bmain);
+  lib_id_name_cache_remove(lb, id);
   BLI_remlink(lb, id);
   id->tag |= LIB_TAG_NO_MAIN;
   bmain->is_memfile_undo_written = false;
@@ -1403,6 +1406,93 @@ void id_sort_by_name(ListBase *lb, ID *id, ID *id_sorting_hint)
 #undef ID_SORT_STEP_SIZE
 }
 
+/* -------------------------------------------------------------------- */
+/** \name ID Name Cache
+ *
+ * Local IDs of a Main by name, so that #check_for_dupid does not have to go over the whole list
+ * of IDs. It is only valid while all IDs are named through #BKE_id_new_name_validate, hence it is
+ * only enabled around operations creating many IDs, see #BKE_main_id_name_cache_begin.
+ * \{ */
+
+static struct {
+  Main *bmain;
+  int users;
+  /* For each ID type index, the local IDs keyed by their name without the ID code. */
+  GHash *names[MAX_LIBARRAY];
+} id_name_cache = {NULL};
+
+static GHash *id_name_cache_get(ListBase *lb, const short id_type)
+{
+  if (id_name_cache.bmain == NULL || lb != which_libbase(id_name_cache.bmain, id_type)) {
+    return NULL;
+  }
+  return id_name_cache.names[BKE_idtype_idcode_to_index(id_type)];
+}
+
+static void id_name_cache_add(ListBase *lb, ID *id)
+{
+  GHash *names = id_name_cache_get(lb, GS(id->name));
+  if (names != NULL && !ID_IS_LINKED(id)) {
+    BLI_ghash_reinsert(names, id->name + 2, id, NULL, NULL);
+  }
+}
+
+/** Has to be called before \a id is removed from \a lb or renamed. */
+void lib_id_name_cache_remove(ListBase *lb, ID *id)
+{
+  GHash *names = id_name_cache_get(lb, GS(id->name));
+  if (names != NULL && BLI_ghash_lookup(names, id->name + 2) == id) {
+    BLI_ghash_remove(names, id->name + 2, NULL, NULL);
+  }
+}
+
+/**
+ * Make naming new IDs in \a bmain independent of the number of existing IDs, until
+ * #BKE_main_id_name_cache_end is called. Calls can be nested.
+ *
+ * \warning Local IDs must not be renamed other than through #BKE_id_new_name_validate meanwhile.
+ */
+void BKE_main_id_name_cache_begin(Main *bmain)
+{
+  if (id_name_cache.users++ != 0) {
+    BLI_assert(id_name_cache.bmain == bmain);
+    return;
+  }
+
+  ListBase *lbarray[MAX_LIBARRAY];
+  int a = set_listbasepointers(bmain, lbarray);
+  while (a--) {
+    GHash *names = BLI_ghash_str_new(__func__);
+    LISTBASE_FOREACH (ID *, id, lbarray[a]) {
+      if (!ID_IS_LINKED(id)) {
+        BLI_ghash_reinsert(names, id->name + 2, id, NULL, NULL);
+      }
+    }
+    id_name_cache.names[a] = names;
+  }
+  id_name_cache.bmain = bmain;
+}
+
+void BKE_main_id_name_cache_end(Main *bmain)
+{
+  BLI_assert(id_name_cache.users > 0 && id_name_cache.bmain == bmain);
+  UNUSED_VARS_NDEBUG(bmain);
+
+  if (--id_name_cache.users != 0) {
+    return;
+  }
+
+  for (int a = 0; a < MAX_LIBARRAY; a++) {
+    if (id_name_cache.names[a] != NULL) {
+      BLI_ghash_free(id_name_cache.names[a], NULL, NULL);
+      id_name_cache.names[a] = NULL;
+    }
+  }
+  id_name_cache.bmain = NULL;
+}
+
+/** \} */
+
 /* Note: this code assumes and ensures that the suffix number can never go beyond 1 billion. */
 #define MAX_NUMBER 1000000000
 /* We do not want to get "name.000", so minimal number is 1. */
@@ -1472,6 +1562,7 @@ static bool check_for_dupid(ListBase *lb, ID *id, char *name, ID **r_id_sorting_
   }
 
   const short id_type = (short)GS(id_test->name);
+  GHash *names = id_name_cache_get(lb, id_type);
 
   /* Static storage of previous handled ID/name info, used to perform a quicker test and optimize
    * creation of huge number of IDs using the same given base name. */
@@ -1511,19 +1602,29 @@ static bool check_for_dupid(ListBase *lb, ID *id, char *name, ID **r_id_sorting_
          * now we have to ensure that previous final name is indeed used in current ID list,
          * and that current one is not. */
         bool is_valid = false;
-        for (id_test = lb->first; id_test; id_test = id_test->next) {
-          if (id != id_test && !ID_IS_LINKED(id_test)) {
-            if (id_test->name[2] == final_name[0] && STREQ(final_name, id_test->name + 2)) {
-              /* We expect final_name to not be already used, so this is a failure. */
-              is_valid = false;
-              break;
-            }
-            /* Previous final name should only be found once in the list, so if it was found
-             * already, no need to do a string comparison again. */
-            if (!is_valid && id_test->name[2] == prev_final_name[0] &&
-                STREQ(prev_final_name, id_test->name + 2)) {
-              is_valid = true;
-              *r_id_sorting_hint = id_test;
+        if (names != NULL) {
+          ID *id_prev = BLI_ghash_lookup(names, prev_final_name);
+          ID *id_final = BLI_ghash_lookup(names, final_name);
+          if (id_prev != NULL && id_prev != id && ELEM(id_final, NULL, id)) {
+            is_valid = true;
+            *r_id_sorting_hint = id_prev;
+          }
+        }
+        else {
+          for (id_test = lb->first; id_test; id_test = id_test->next) {
+            if (id != id_test && !ID_IS_LINKED(id_test)) {
+              if (id_test->name[2] == final_name[0] && STREQ(final_name, id_test->name + 2)) {
+                /* We expect final_name to not be already used, so this is a failure. */
+                is_valid = false;
+                break;
+              }
+              /* Previous final name should only be found once in the list, so if it was found
+               * already, no need to do a string comparison again. */
+              if (!is_valid && id_test->name[2] == prev_final_name[0] &&
+                  STREQ(prev_final_name, id_test->name + 2)) {
+                is_valid = true;
+                *r_id_sorting_hint = id_test;
+              }
             }
           }
         }
@@ -1540,6 +1641,14 @@ static bool check_for_dupid(ListBase *lb, ID *id, char *name, ID **r_id_sorting_
     }
   }
 
+  if (names != NULL && ELEM(BLI_ghash_lookup(names, name), NULL, id)) {
+    /* The name is not used by another ID, same as the first iteration of the loop below. */
+    prev_id_type = ID_LINK_PLACEHOLDER;
+    prev_final_base_name[0] = '\0';
+    prev_number = MIN_NUMBER - 1;
+    return is_name_changed;
+  }
+
   /* To speed up finding smallest unused number within [0 .. MAX_NUMBERS_IN_USE - 1].
    * We do not bother beyond that point. */
   ID *ids_in_use[MAX_NUMBERS_IN_USE] = {NULL};
@@ -1689,7 +1798,9 @@ bool BKE_id_new_name_validate(ListBase *lb, ID *id, const char *tname)
 
   ID *id_sorting_hint = NULL;
   result = check_for_dupid(lb, id, name, &id_sorting_hint);
+  lib_id_name_cache_remove(lb, id);
   strcpy(id->name + 2, name);
+  id_name_cache_add(lb, id);
 
   /* This was in 2.43 and previous releases
    * however all data in blender should be sorted, not just duplicate names
@@ -1718,25 +1829,46 @@ void BKE_main_id_clear_newpoins(Main *bmain)
   FOREACH_MAIN_ID_END;
 }
 
+typedef struct IDRefcountRecomputeData {
+  /** Map from IDs of the Main database to their index in the arrays below. */
+  GHash *id_to_index;
+  /** Number of #IDWALK_CB_USER usages of each ID. */
+  int *users;
+  /** Whether each ID has some #IDWALK_CB_USER_ONE usage. */
+  char *users_one;
+  bool do_linked_only;
+} IDRefcountRecomputeData;
+
+/* Called from several threads at once, so only accumulates usages into the arrays of
+ * #IDRefcountRecomputeData, they are applied to the IDs afterwards. */
 static int id_refcount_recompute_callback(LibraryIDLinkCallbackData *cb_data)
 {
   ID **id_pointer = cb_data->id_pointer;
   const int cb_flag = cb_data->cb_flag;
-  const bool do_linked_only = (bool)POINTER_AS_INT(cb_data->user_data);
+  IDRefcountRecomputeData *data = cb_data->user_data;
 
   if (*id_pointer == NULL) {
     return IDWALK_RET_NOP;
   }
-  if (do_linked_only && !ID_IS_LINKED(*id_pointer)) {
+  if (data->do_linked_only && !ID_IS_LINKED(*id_pointer)) {
+    return IDWALK_RET_NOP;
+  }
+  if ((cb_flag & (IDWALK_CB_USER | IDWALK_CB_USER_ONE)) == 0) {
     return IDWALK_RET_NOP;
   }
 
+  void **index_p = BLI_ghash_lookup_p(data->id_to_index, *id_pointer);
+  if (index_p == NULL) {
+    /* Used ID is not in Main, its user count is not handled here. */
+    return IDWALK_RET_NOP;
+  }
+  const int index = POINTER_AS_INT(*index_p);
+
   if (cb_flag & IDWALK_CB_USER) {
-    /* Do not touch to direct/indirect linked status here... */
-    id_us_plus_no_lib(*id_pointer);
+    atomic_add_and_fetch_int32(&data->users[index], 1);
   }
   if (cb_flag & IDWALK_CB_USER_ONE) {
-    id_us_ensure_real(*id_pointer);
+    atomic_fetch_and_or_char(&data->users_one[index], 1);
   }
 
   return IDWALK_RET_NOP;
@@ -1745,8 +1877,27 @@ static int id_refcount_recompute_callback(LibraryIDLinkCallbackData *cb_data)
 void BKE_main_id_refcount_recompute(struct Main *bmain, const bool do_linked_only)
 {
   ID *id;
+  int ids_len = 0;
 
   FOREACH_MAIN_ID_BEGIN (bmain, id) {
+    ids_len++;
+  }
+  FOREACH_MAIN_ID_END;
+
+  ID **ids = MEM_malloc_arrayN((size_t)ids_len, sizeof(*ids), __func__);
+  IDRefcountRecomputeData data = {
+      .id_to_index = BLI_ghash_ptr_new_ex(__func__, (uint)ids_len),
+      .users = MEM_calloc_arrayN((size_t)ids_len, sizeof(*data.users), __func__),
+      .users_one = MEM_calloc_arrayN((size_t)ids_len, sizeof(*data.users_one), __func__),
+      .do_linked_only = do_linked_only,
+  };
+
+  int index = 0;
+  FOREACH_MAIN_ID_BEGIN (bmain, id) {
+    ids[index] = id;
+    BLI_ghash_insert(data.id_to_index, id, POINTER_FROM_INT(index));
+    index++;
+
     if (!ID_IS_LINKED(id) && do_linked_only) {
       continue;
     }
@@ -1760,14 +1911,32 @@ void BKE_main_id_refcount_recompute(struct Main *bmain, const bool do_linked_onl
   FOREACH_MAIN_ID_END;
 
   /* Go over whole Main database to re-generate proper usercounts... */
-  FOREACH_MAIN_ID_BEGIN (bmain, id) {
-    BKE_library_foreach_ID_link(bmain,
-                                id,
-                                id_refcount_recompute_callback,
-                                POINTER_FROM_INT((int)do_linked_only),
-                                IDWALK_READONLY | IDWALK_INCLUDE_UI);
+  BKE_library_foreach_ID_link_parallel(bmain,
+                                       ids,
+                                       ids_len,
+                                       id_refcount_recompute_callback,
+                                       &data,
+                                       IDWALK_READONLY | IDWALK_INCLUDE_UI);
+
+  /* Same result as calling #id_us_plus_no_lib and #id_us_ensure_real for each usage, in any
+   * order. */
+  for (index = 0; index < ids_len; index++) {
+    id = ids[index];
+    int users = data.users[index];
+    if (users != 0 && (id->tag & LIB_TAG_EXTRAUSER) && (id->tag & LIB_TAG_EXTRAUSER_SET)) {
+      id->tag &= ~LIB_TAG_EXTRAUSER_SET;
+      users--;
+    }
+    id->us += users;
+    if (data.users_one[index]) {
+      id_us_ensure_real(id);
+    }
   }
-  FOREACH_MAIN_ID_END;
+
+  BLI_ghash_free(data.id_to_index, NULL, NULL);
+  MEM_freeN(data.users);
+  MEM_freeN(data.users_one);
+  MEM_freeN(ids);
 }
 
 static void library_make_local_copying_check(ID *id,
@@ -1867,6 +2036,7 @@ void BKE_library_make_local(Main *bmain,
   TIMEIT_START(make_local);
 #endif
 
+  BKE_main_id_name_cache_begin(bmain);
   BKE_main_relations_create(bmain, 0);
 
 #ifdef DEBUG_TIME
@@ -2019,17 +2189,22 @@ void BKE_library_make_local(Main *bmain,
    * ID in a separated loop,
    * as lbarray ordering is not enough to ensure us we did catch all dependencies
    * (e.g. if making local a parent object before its child...). See T48907. */
-  /* TODO This is now the biggest step by far (in term of processing time).
-   * We may be able to gain here by using again main->relations mapping, but...
-   * this implies BKE_libblock_remap & co to be able to update main->relations on the fly.
-   * Have to think about it a bit more, and see whether new code is OK first, anyway. */
+  /* All IDs are remapped at once, going over Main a single time. */
+  GHash *copied_to_new_ids = BLI_ghash_ptr_new(__func__);
   for (LinkNode *it = copied_ids; it; it = it->next) {
     ID *id = it->link;
 
     BLI_assert(id->newid != NULL);
     BLI_assert(id->lib != NULL);
 
-    BKE_libblock_remap(bmain, id, id->newid, ID_REMAP_SKIP_INDIRECT_USAGE);
+    BLI_ghash_insert(copied_to_new_ids, id, id->newid);
+  }
+  BKE_libblock_remap_multiple(bmain, copied_to_new_ids, ID_REMAP_SKIP_INDIRECT_USAGE);
+  BLI_ghash_free(copied_to_new_ids, NULL, NULL);
+
+  for (LinkNode *it = copied_ids; it; it = it->next) {
+    ID *id = it->link;
+
     if (old_to_new_ids) {
       BLI_ghash_insert(old_to_new_ids, id, id->newid);
     }
@@ -2124,6 +2299,7 @@ void BKE_library_make_local(Main *bmain,
 
   BKE_main_id_clear_newpoins(bmain);
   BLI_memarena_free(linklist_mem);
+  BKE_main_id_name_cache_end(bmain);
 
 #ifdef DEBUG_TIME
   printf("Cleanup and finish: Done.\n");
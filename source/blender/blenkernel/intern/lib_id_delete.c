@@ -28,6 +28,7 @@
 
 #include "BLI_utildefines.h"
 
+#include "BLI_ghash.h"
 #include "BLI_listbase.h"
 
 #include "BKE_anim_data.h"
@@ -175,6 +176,7 @@ void BKE_id_free_ex(Main *bmain, void *idv, int flag, const bool use_flag_from_i
 
   if ((flag & LIB_ID_FREE_NO_MAIN) == 0) {
     ListBase *lb = which_libbase(bmain, type);
+    lib_id_name_cache_remove(lb, id);
     BLI_remlink(lb, id);
   }
 
@@ -274,6 +276,7 @@ static void id_delete(Main *bmain, const bool do_tagged_deletion)
           id_next = id->next;
           /* Note: in case we delete a library, we also delete all its datablocks! */
           if ((id->tag & tag) || (id->lib != NULL && (id->lib->id.tag & tag))) {
+            lib_id_name_cache_remove(lb, id);
             BLI_remlink(lb, id);
             BLI_addtail(&tagged_deleted_ids, id);
             /* Do not tag as no_main now, we want to unlink it first (lower-level ID management
@@ -288,15 +291,22 @@ static void id_delete(Main *bmain, const bool do_tagged_deletion)
         dummy_link.next = tagged_deleted_ids.first;
         last_remapped_id = (ID *)(&dummy_link);
       }
+      /* Will tag 'never NULL' users of those IDs too.
+       * Note that we cannot use BKE_libblock_unlink() here,
+       * since it would ignore indirect (and proxy!)
+       * links, this can lead to nasty crashing here in second, actual deleting loop.
+       * Also, this will also flag users of deleted data that cannot be unlinked
+       * (object using deleted obdata, etc.), so that they also get deleted.
+       * All IDs are remapped at once, going over Main a single time. */
+      GHash *old_to_new_ids = BLI_ghash_ptr_new(__func__);
+      for (id = last_remapped_id->next; id; id = id->next) {
+        BLI_ghash_insert(old_to_new_ids, id, NULL);
+      }
+      BKE_libblock_remap_multiple_locked(
+          bmain, old_to_new_ids, ID_REMAP_FLAG_NEVER_NULL_USAGE | ID_REMAP_FORCE_NEVER_NULL_USAGE);
+      BLI_ghash_free(old_to_new_ids, NULL, NULL);
+
       for (id = last_remapped_id->next; id; id = id->next) {
-        /* Will tag 'never NULL' users of this ID too.
-         * Note that we cannot use BKE_libblock_unlink() here,
-         * since it would ignore indirect (and proxy!)
-         * links, this can lead to nasty crashing here in second, actual deleting loop.
-         * Also, this will also flag users of deleted data that cannot be unlinked
-         * (object using deleted obdata, etc.), so that they also get deleted. */
-        BKE_libblock_remap_locked(
-            bmain, id, NULL, ID_REMAP_FLAG_NEVER_NULL_USAGE | ID_REMAP_FORCE_NEVER_NULL_USAGE);
         /* Since we removed ID from Main,
          * we also need to unlink its own other IDs usages ourself. */
         BKE_libblock_relink_ex(bmain, id, NULL, NULL, 0);
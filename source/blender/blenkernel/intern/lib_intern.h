@@ -26,3 +26,5 @@
 extern BKE_library_free_notifier_reference_cb free_notifier_reference_cb;
 
 extern BKE_library_remap_editor_id_reference_cb remap_editor_id_reference_cb;
+
+void lib_id_name_cache_remove(struct ListBase *lb, struct ID *id);
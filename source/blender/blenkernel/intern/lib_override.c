@@ -49,6 +49,7 @@
 #include "BKE_scene.h"
 
 #include "BLI_ghash.h"
+#include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_string.h"
 #include "BLI_task.h"
@@ -1423,35 +1424,32 @@ void BKE_lib_override_library_main_operations_create(Main *bmain, const bool for
     BKE_lib_override_library_main_tag(bmain, IDOVERRIDE_LIBRARY_TAG_UNUSED, true);
   }
 
-  /* Usual pose bones issue, need to be done outside of the threaded process or we may run into
-   * concurrency issues here.
-   * Note that calling #BKE_pose_ensure again in thread in
-   * #BKE_lib_override_library_operations_create is not a problem then. */
-  LISTBASE_FOREACH (Object *, ob, &bmain->objects) {
-    if (ob->type == OB_ARMATURE) {
-      BLI_assert(ob->data != NULL);
-      BKE_pose_ensure(bmain, ob, ob->data, true);
-    }
-  }
-
-  TaskPool *task_pool = BLI_task_pool_create(bmain, TASK_PRIORITY_HIGH);
+  /* Gather the overrides to diff first, on the main thread, so that nothing has to be done when
+   * no override was changed (the common case on undo push). */
+  LinkNode *todo_ids = NULL;
 
   FOREACH_MAIN_ID_BEGIN (bmain, id) {
     if (ID_IS_OVERRIDE_LIBRARY_REAL(id) &&
         (force_auto || (id->tag & LIB_TAG_OVERRIDE_LIBRARY_AUTOREFRESH))) {
-      /* Usual issue with pose, it's quiet rare but sometimes they may not be up to date when this
-       * function is called. */
-      if (GS(id->name) == ID_OB) {
-        Object *ob = (Object *)id;
-        if (ob->type == OB_ARMATURE) {
-          BLI_assert(ob->data != NULL);
-          BKE_pose_ensure(bmain, ob, ob->data, true);
-        }
-      }
       /* Only check overrides if we do have the real reference data available, and not some empty
        * 'placeholder' for missing data (broken links). */
       if ((id->override_library->reference->tag & LIB_TAG_MISSING) == 0) {
-        BLI_task_pool_push(task_pool, lib_override_library_operations_create_cb, id, false, NULL);
+        /* Usual pose bones issue, need to be done outside of the threaded process or we may run
+         * into concurrency issues here. Only the poses of the diffed objects and their references
+         * are accessed.
+         * Note that calling #BKE_pose_ensure again in thread in
+         * #BKE_lib_override_library_operations_create is not a problem then. */
+        if (GS(id->name) == ID_OB) {
+          Object *ob = (Object *)id;
+          Object *ob_reference = (Object *)id->override_library->reference;
+          if (ob->type == OB_ARMATURE) {
+            BLI_assert(ob->data != NULL);
+            BLI_assert(ob_reference->data != NULL);
+            BKE_pose_ensure(bmain, ob, ob->data, true);
+            BKE_pose_ensure(bmain, ob_reference, ob_reference->data, true);
+          }
+        }
+        BLI_linklist_prepend(&todo_ids, id);
       }
       else {
         BKE_lib_override_library_properties_tag(
@@ -1462,9 +1460,19 @@ void BKE_lib_override_library_main_operations_create(Main *bmain, const bool for
   }
   FOREACH_MAIN_ID_END;
 
-  BLI_task_pool_work_and_wait(task_pool);
+  if (todo_ids != NULL) {
+    TaskPool *task_pool = BLI_task_pool_create(bmain, TASK_PRIORITY_HIGH);
+
+    for (LinkNode *todo_id = todo_ids; todo_id != NULL; todo_id = todo_id->next) {
+      BLI_task_pool_push(
+          task_pool, lib_override_library_operations_create_cb, todo_id->link, false, NULL);
+    }
+
+    BLI_task_pool_work_and_wait(task_pool);
+    BLI_task_pool_free(task_pool);
 
-  BLI_task_pool_free(task_pool);
+    BLI_linklist_free(todo_ids, NULL);
+  }
 
   if (force_auto) {
     BKE_lib_override_library_main_unused_cleanup(bmain);
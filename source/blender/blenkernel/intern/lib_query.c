@@ -28,6 +28,7 @@
 #include "BLI_ghash.h"
 #include "BLI_linklist_stack.h"
 #include "BLI_listbase.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_anim_data.h"
@@ -292,6 +293,54 @@ void BKE_library_foreach_ID_link(
   library_foreach_ID_link(bmain, NULL, id, callback, user_data, flag, NULL);
 }
 
+typedef struct ForeachIDLinkParallelData {
+  Main *bmain;
+  ID **ids;
+  LibraryIDLinkCallback callback;
+  void *user_data;
+  int flag;
+} ForeachIDLinkParallelData;
+
+static void foreach_ID_link_parallel_cb(void *__restrict userdata,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ForeachIDLinkParallelData *data = userdata;
+  library_foreach_ID_link(
+      data->bmain, NULL, data->ids[i], data->callback, data->user_data, data->flag, NULL);
+}
+
+/**
+ * Same as #BKE_library_foreach_ID_link, but processes all given IDs in parallel.
+ *
+ * Only valid for read-only queries (\a flag must contain #IDWALK_READONLY, and cannot contain
+ * #IDWALK_RECURSE). The callback is called concurrently from several threads, so it must not
+ * modify any ID, and must only write shared data in a thread-safe way (e.g. using atomics).
+ */
+void BKE_library_foreach_ID_link_parallel(Main *bmain,
+                                          ID **ids,
+                                          const int ids_len,
+                                          LibraryIDLinkCallback callback,
+                                          void *user_data,
+                                          int flag)
+{
+  BLI_assert(flag & IDWALK_READONLY);
+  BLI_assert((flag & IDWALK_RECURSE) == 0);
+
+  ForeachIDLinkParallelData data = {
+      .bmain = bmain,
+      .ids = ids,
+      .callback = callback,
+      .user_data = user_data,
+      .flag = flag,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(0, ids_len, &data, foreach_ID_link_parallel_cb, &settings);
+}
+
 /**
  * re-usable function, use when replacing ID's
  */
@@ -595,6 +644,96 @@ void BKE_library_ID_test_usages(Main *bmain, void *idv, bool *is_used_local, boo
 }
 
 /* ***** IDs usages.checking/tagging. ***** */
+static void lib_query_unused_ids_tag_one(ID *id, const int tag, int *r_num_tagged)
+{
+  id->tag |= tag;
+  if (r_num_tagged != NULL) {
+    r_num_tagged[INDEX_ID_NULL]++;
+    r_num_tagged[BKE_idtype_idcode_to_index(GS(id->name))]++;
+  }
+}
+
+/**
+ * Tag all unused IDs (i.e. IDs without any user, not even a fake one) with \a tag, and clear it
+ * from all other IDs.
+ *
+ * \param do_tag_recursive: Also tag IDs which are only used by other unused IDs, i.e. which would
+ * become unused once those get deleted. All of them are found in a single pass over the Main
+ * relations, by propagating the 'unused' status from user to used IDs.
+ * \param r_num_tagged: If non-NULL, must be a zero-initialized array of #INDEX_ID_MAX items. The
+ * number of tagged IDs of each type is added to it, and their total to the #INDEX_ID_NULL item.
+ */
+void BKE_lib_query_unused_ids_tag(Main *bmain,
+                                  const int tag,
+                                  const bool do_tag_recursive,
+                                  int *r_num_tagged)
+{
+  ID *id;
+
+  FOREACH_MAIN_ID_BEGIN (bmain, id) {
+    id->tag &= ~tag;
+  }
+  FOREACH_MAIN_ID_END;
+
+  if (!do_tag_recursive) {
+    FOREACH_MAIN_ID_BEGIN (bmain, id) {
+      if (id->us == 0) {
+        lib_query_unused_ids_tag_one(id, tag, r_num_tagged);
+      }
+    }
+    FOREACH_MAIN_ID_END;
+    return;
+  }
+
+  BKE_main_relations_create(bmain, 0);
+
+  /* Users left to each used ID once all unused IDs processed so far have been removed. */
+  GHash *id_users_left = BLI_ghash_ptr_new(__func__);
+  BLI_LINKSTACK_DECLARE(ids_todo, ID *);
+  BLI_LINKSTACK_INIT(ids_todo);
+
+  FOREACH_MAIN_ID_BEGIN (bmain, id) {
+    if (id->us == 0) {
+      lib_query_unused_ids_tag_one(id, tag, r_num_tagged);
+      BLI_LINKSTACK_PUSH(ids_todo, id);
+    }
+  }
+  FOREACH_MAIN_ID_END;
+
+  while ((id = BLI_LINKSTACK_POP(ids_todo))) {
+    MainIDRelationsEntry *entry = BLI_ghash_lookup(bmain->relations->id_user_to_used, id);
+    for (; entry != NULL; entry = entry->next) {
+      ID *id_used = *entry->id_pointer;
+      if (id_used == NULL || (id_used->tag & tag)) {
+        continue;
+      }
+      if (entry->usage_flag & IDWALK_CB_EMBEDDED) {
+        /* Embedded IDs go away with their owner, so their usages do too. */
+        BLI_LINKSTACK_PUSH(ids_todo, id_used);
+        continue;
+      }
+      if ((entry->usage_flag & IDWALK_CB_USER) == 0 || (id_used->tag & LIB_TAG_NO_MAIN)) {
+        continue;
+      }
+
+      void **users_left_p;
+      if (!BLI_ghash_ensure_p(id_users_left, id_used, &users_left_p)) {
+        *users_left_p = POINTER_FROM_INT(id_used->us);
+      }
+      const int users_left = POINTER_AS_INT(*users_left_p) - 1;
+      *users_left_p = POINTER_FROM_INT(users_left);
+      if (users_left <= 0) {
+        lib_query_unused_ids_tag_one(id_used, tag, r_num_tagged);
+        BLI_LINKSTACK_PUSH(ids_todo, id_used);
+      }
+    }
+  }
+
+  BLI_LINKSTACK_FREE(ids_todo);
+  BLI_ghash_free(id_users_left, NULL, NULL);
+  BKE_main_relations_free(bmain);
+}
+
 static int foreach_libblock_used_linked_data_tag_clear_cb(LibraryIDLinkCallbackData *cb_data)
 {
   ID *self_id = cb_data->id_self;
@@ -22,6 +22,9 @@
 
 #include "CLG_log.h"
 
+#include "MEM_guardedalloc.h"
+
+#include "BLI_ghash.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_object_types.h"
@@ -345,6 +348,55 @@ static void libblock_remap_data_postprocess_nodetree_update(Main *bmain, ID *new
   ntreeUpdateAllUsers(bmain, new_id);
 }
 
+static void libblock_remap_data_init(IDRemap *r_id_remap_data,
+                                     Main *bmain,
+                                     ID *old_id,
+                                     ID *new_id,
+                                     const short remap_flags)
+{
+  r_id_remap_data->bmain = bmain;
+  r_id_remap_data->old_id = old_id;
+  r_id_remap_data->new_id = new_id;
+  r_id_remap_data->id_owner = NULL;
+  r_id_remap_data->flag = remap_flags;
+  r_id_remap_data->status = 0;
+  r_id_remap_data->skipped_direct = 0;
+  r_id_remap_data->skipped_indirect = 0;
+  r_id_remap_data->skipped_refcounted = 0;
+}
+
+/* Update the old and new IDs once all usages have been remapped. */
+static void libblock_remap_data_finalize(IDRemap *r_id_remap_data)
+{
+  ID *old_id = r_id_remap_data->old_id;
+  ID *new_id = r_id_remap_data->new_id;
+
+  /* XXX We may not want to always 'transfer' fake-user from old to new id...
+   *     Think for now it's desired behavior though,
+   *     we can always add an option (flag) to control this later if needed. */
+  if (old_id && (old_id->flag & LIB_FAKEUSER)) {
+    id_fake_user_clear(old_id);
+    id_fake_user_set(new_id);
+  }
+
+  id_us_clear_real(old_id);
+
+  if (new_id && (new_id->tag & LIB_TAG_INDIRECT) &&
+      (r_id_remap_data->status & ID_REMAP_IS_LINKED_DIRECT)) {
+    new_id->tag &= ~LIB_TAG_INDIRECT;
+    new_id->flag &= ~LIB_INDIRECT_WEAK_LINK;
+    new_id->tag |= LIB_TAG_EXTERN;
+  }
+
+#ifdef DEBUG_PRINT
+  printf("%s: %d occurrences skipped (%d direct and %d indirect ones)\n",
+         __func__,
+         r_id_remap_data->skipped_direct + r_id_remap_data->skipped_indirect,
+         r_id_remap_data->skipped_direct,
+         r_id_remap_data->skipped_indirect);
+#endif
+}
+
 /**
  * Execute the 'data' part of the remapping (that is, all ID pointers from other ID data-blocks).
  *
@@ -379,15 +431,7 @@ static void libblock_remap_data(
   if (r_id_remap_data == NULL) {
     r_id_remap_data = &id_remap_data;
   }
-  r_id_remap_data->bmain = bmain;
-  r_id_remap_data->old_id = old_id;
-  r_id_remap_data->new_id = new_id;
-  r_id_remap_data->id_owner = NULL;
-  r_id_remap_data->flag = remap_flags;
-  r_id_remap_data->status = 0;
-  r_id_remap_data->skipped_direct = 0;
-  r_id_remap_data->skipped_indirect = 0;
-  r_id_remap_data->skipped_refcounted = 0;
+  libblock_remap_data_init(r_id_remap_data, bmain, old_id, new_id, remap_flags);
 
   if (id) {
 #ifdef DEBUG_PRINT
@@ -421,49 +465,16 @@ static void libblock_remap_data(
     FOREACH_MAIN_ID_END;
   }
 
-  /* XXX We may not want to always 'transfer' fake-user from old to new id...
-   *     Think for now it's desired behavior though,
-   *     we can always add an option (flag) to control this later if needed. */
-  if (old_id && (old_id->flag & LIB_FAKEUSER)) {
-    id_fake_user_clear(old_id);
-    id_fake_user_set(new_id);
-  }
-
-  id_us_clear_real(old_id);
-
-  if (new_id && (new_id->tag & LIB_TAG_INDIRECT) &&
-      (r_id_remap_data->status & ID_REMAP_IS_LINKED_DIRECT)) {
-    new_id->tag &= ~LIB_TAG_INDIRECT;
-    new_id->flag &= ~LIB_INDIRECT_WEAK_LINK;
-    new_id->tag |= LIB_TAG_EXTERN;
-  }
-
-#ifdef DEBUG_PRINT
-  printf("%s: %d occurrences skipped (%d direct and %d indirect ones)\n",
-         __func__,
-         r_id_remap_data->skipped_direct + r_id_remap_data->skipped_indirect,
-         r_id_remap_data->skipped_direct,
-         r_id_remap_data->skipped_indirect);
-#endif
+  libblock_remap_data_finalize(r_id_remap_data);
 }
 
-/**
- * Replace all references in given Main to \a old_id by \a new_id
- * (if \a new_id is NULL, it unlinks \a old_id).
- */
-void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const short remap_flags)
+/* Non-data part of the remapping, once all usages of \a old_id have been handled. */
+static void libblock_remap_postprocess(Main *bmain, const IDRemap *id_remap_data)
 {
-  IDRemap id_remap_data;
-  ID *old_id = old_idv;
-  ID *new_id = new_idv;
+  ID *old_id = id_remap_data->old_id;
+  ID *new_id = id_remap_data->new_id;
   int skipped_direct, skipped_refcounted;
 
-  BLI_assert(old_id != NULL);
-  BLI_assert((new_id == NULL) || GS(old_id->name) == GS(new_id->name));
-  BLI_assert(old_id != new_id);
-
-  libblock_remap_data(bmain, NULL, old_id, new_id, remap_flags, &id_remap_data);
-
   if (free_notifier_reference_cb) {
     free_notifier_reference_cb(old_id);
   }
@@ -475,14 +486,14 @@ void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const
     remap_editor_id_reference_cb(old_id, new_id);
   }
 
-  skipped_direct = id_remap_data.skipped_direct;
-  skipped_refcounted = id_remap_data.skipped_refcounted;
+  skipped_direct = id_remap_data->skipped_direct;
+  skipped_refcounted = id_remap_data->skipped_refcounted;
 
   /* If old_id was used by some ugly 'user_one' stuff (like Image or Clip editors...), and user
    * count has actually been incremented for that, we have to decrease once more its user count...
    * unless we had to skip some 'user_one' cases. */
   if ((old_id->tag & LIB_TAG_EXTRAUSER_SET) &&
-      !(id_remap_data.status & ID_REMAP_IS_USER_ONE_SKIPPED)) {
+      !(id_remap_data->status & ID_REMAP_IS_USER_ONE_SKIPPED)) {
     id_us_clear_real(old_id);
   }
 
@@ -540,11 +551,135 @@ void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const
   BKE_main_unlock(bmain);
   libblock_remap_data_postprocess_nodetree_update(bmain, new_id);
   BKE_main_lock(bmain);
+}
+
+/**
+ * Replace all references in given Main to \a old_id by \a new_id
+ * (if \a new_id is NULL, it unlinks \a old_id).
+ */
+void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const short remap_flags)
+{
+  IDRemap id_remap_data;
+  ID *old_id = old_idv;
+  ID *new_id = new_idv;
+
+  BLI_assert(old_id != NULL);
+  BLI_assert((new_id == NULL) || GS(old_id->name) == GS(new_id->name));
+  BLI_assert(old_id != new_id);
+
+  libblock_remap_data(bmain, NULL, old_id, new_id, remap_flags, &id_remap_data);
+  libblock_remap_postprocess(bmain, &id_remap_data);
+
+  /* Full rebuild of DEG! */
+  DEG_relations_tag_update(bmain);
+}
+
+typedef struct IDRemapMultiple {
+  /* IDRemap data of each remapped ID, keyed by the old ID. */
+  GHash *id_remaps;
+} IDRemapMultiple;
+
+static int foreach_libblock_remap_multiple_callback(LibraryIDLinkCallbackData *cb_data)
+{
+  if ((cb_data->cb_flag & IDWALK_CB_EMBEDDED) || *cb_data->id_pointer == NULL) {
+    return IDWALK_RET_NOP;
+  }
+
+  IDRemapMultiple *id_remap_multiple = cb_data->user_data;
+  IDRemap *id_remap_data = BLI_ghash_lookup(id_remap_multiple->id_remaps, *cb_data->id_pointer);
+  if (id_remap_data == NULL) {
+    return IDWALK_RET_NOP;
+  }
+
+  /* Each owner ID is processed once, so this is the first usage of old_id met in it. */
+  if (id_remap_data->id_owner != cb_data->id_owner) {
+    id_remap_data->id_owner = cb_data->id_owner;
+    libblock_remap_data_preprocess(id_remap_data);
+  }
+
+  LibraryIDLinkCallbackData cb_data_remap = *cb_data;
+  cb_data_remap.user_data = id_remap_data;
+  return foreach_libblock_remap_callback(&cb_data_remap);
+}
+
+/**
+ * Same as calling #BKE_libblock_remap_locked for each pair of \a old_to_new_ids (new IDs may be
+ * NULL), but only going once over the whole Main database.
+ *
+ * \note Remapping is not chained, usages of an old ID are replaced by its new ID even if that new
+ * ID is also remapped.
+ */
+void BKE_libblock_remap_multiple_locked(Main *bmain, GHash *old_to_new_ids, const short remap_flags)
+{
+  const int remap_num = (int)BLI_ghash_len(old_to_new_ids);
+  if (remap_num == 0) {
+    return;
+  }
+
+  const int foreach_id_flags = (remap_flags & ID_REMAP_NO_INDIRECT_PROXY_DATA_USAGE) != 0 ?
+                                   IDWALK_NO_INDIRECT_PROXY_DATA_USAGE :
+                                   IDWALK_NOP;
+
+  IDRemap *id_remap_array = MEM_malloc_arrayN(
+      (size_t)remap_num, sizeof(*id_remap_array), __func__);
+  IDRemapMultiple id_remap_multiple = {
+      .id_remaps = BLI_ghash_ptr_new_ex(__func__, (uint)remap_num),
+  };
+  /* Types of the remapped IDs, to skip IDs that cannot use any of them. */
+  short id_types[MAX_LIBARRAY];
+  int id_types_num = 0;
+
+  int i = 0;
+  GHashIterator gh_iter;
+  GHASH_ITER (gh_iter, old_to_new_ids) {
+    ID *old_id = BLI_ghashIterator_getKey(&gh_iter);
+    ID *new_id = BLI_ghashIterator_getValue(&gh_iter);
+
+    BLI_assert(old_id != NULL);
+    BLI_assert((new_id == NULL) || GS(old_id->name) == GS(new_id->name));
+    BLI_assert(old_id != new_id);
+
+    IDRemap *id_remap_data = &id_remap_array[i++];
+    libblock_remap_data_init(id_remap_data, bmain, old_id, new_id, remap_flags);
+    BLI_ghash_insert(id_remap_multiple.id_remaps, old_id, id_remap_data);
+
+    int j;
+    for (j = 0; j < id_types_num && id_types[j] != GS(old_id->name); j++) {
+      /* Pass. */
+    }
+    if (j == id_types_num) {
+      id_types[id_types_num++] = GS(old_id->name);
+    }
+  }
+
+  ID *id_curr;
+  FOREACH_MAIN_ID_BEGIN (bmain, id_curr) {
+    for (int j = 0; j < id_types_num; j++) {
+      if (BKE_library_id_can_use_idtype(id_curr, id_types[j])) {
+        BKE_library_foreach_ID_link(NULL,
+                                    id_curr,
+                                    foreach_libblock_remap_multiple_callback,
+                                    &id_remap_multiple,
+                                    foreach_id_flags);
+        break;
+      }
+    }
+  }
+  FOREACH_MAIN_ID_END;
+
+  for (i = 0; i < remap_num; i++) {
+    libblock_remap_data_finalize(&id_remap_array[i]);
+    libblock_remap_postprocess(bmain, &id_remap_array[i]);
+  }
+
+  BLI_ghash_free(id_remap_multiple.id_remaps, NULL, NULL);
+  MEM_freeN(id_remap_array);
 
   /* Full rebuild of DEG! */
   DEG_relations_tag_update(bmain);
 }
 
+
 void BKE_libblock_remap(Main *bmain, void *old_idv, void *new_idv, const short remap_flags)
 {
   BKE_main_lock(bmain);
@@ -554,6 +689,15 @@ void BKE_libblock_remap(Main *bmain, void *old_idv, void *new_idv, const short r
   BKE_main_unlock(bmain);
 }
 
+void BKE_libblock_remap_multiple(Main *bmain, GHash *old_to_new_ids, const short remap_flags)
+{
+  BKE_main_lock(bmain);
+
+  BKE_libblock_remap_multiple_locked(bmain, old_to_new_ids, remap_flags);
+
+  BKE_main_unlock(bmain);
+}
+
 /**
  * Unlink given \a id from given \a bmain
  * (does not touch to indirect, i.e. library, usages of the ID).
@@ -252,13 +252,22 @@ void BKE_main_relations_create(Main *bmain, const short flag)
     BKE_main_relations_free(bmain);
   }
 
+  /* Reserve for all IDs up-front, growing the hashes while filling them is most of the cost
+   * otherwise. */
+  ListBase *lbarray[MAX_LIBARRAY];
+  uint id_num = 0;
+  for (int a = set_listbasepointers(bmain, lbarray); a--;) {
+    id_num += (uint)BLI_listbase_count(lbarray[a]);
+  }
+
   bmain->relations = MEM_mallocN(sizeof(*bmain->relations), __func__);
-  bmain->relations->id_used_to_user = BLI_ghash_new(
-      BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, __func__);
-  bmain->relations->id_user_to_used = BLI_ghash_new(
-      BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, __func__);
+  bmain->relations->id_used_to_user = BLI_ghash_new_ex(
+      BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, __func__, id_num);
+  bmain->relations->id_user_to_used = BLI_ghash_new_ex(
+      BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, __func__, id_num);
+  /* Most IDs use a few others, each usage taking two entries. */
   bmain->relations->entry_pool = BLI_mempool_create(
-      sizeof(MainIDRelationsEntry), 128, 128, BLI_MEMPOOL_NOP);
+      sizeof(MainIDRelationsEntry), MAX2(128, id_num * 4), 512, BLI_MEMPOOL_NOP);
 
   ID *id;
   FOREACH_MAIN_ID_BEGIN (bmain, id) {
@@ -820,12 +820,35 @@ typedef struct LoopSplitTaskDataCommon {
 /* See comment about edge_to_loops below. */
 #define IS_EDGE_SHARP(_e2l) (ELEM((_e2l)[1], INDEX_UNSET, INDEX_INVALID))
 
+static void mesh_edges_sharp_tag_prepare_cb(void *__restrict userdata,
+                                            const int mp_index,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LoopSplitTaskDataCommon *data = userdata;
+  const MPoly *mp = &data->mpolys[mp_index];
+  const MLoop *mloops = data->mloops;
+  const MVert *mverts = data->mverts;
+  float(*loopnors)[3] = data->loopnors;
+  int *loop_to_poly = data->loop_to_poly;
+
+  const int ml_last_index = (mp->loopstart + mp->totloop) - 1;
+  for (int ml_index = mp->loopstart; ml_index <= ml_last_index; ml_index++) {
+    loop_to_poly[ml_index] = mp_index;
+
+    /* Pre-populate all loop normals as if their verts were all-smooth,
+     * this way we don't have to compute those later!
+     */
+    if (loopnors) {
+      normal_short_to_float_v3(loopnors[ml_index], mverts[mloops[ml_index].v].no);
+    }
+  }
+}
+
 static void mesh_edges_sharp_tag(LoopSplitTaskDataCommon *data,
                                  const bool check_angle,
                                  const float split_angle,
                                  const bool do_sharp_edges_tag)
 {
-  const MVert *mverts = data->mverts;
   const MEdge *medges = data->medges;
   const MLoop *mloops = data->mloops;
 
@@ -834,7 +857,6 @@ static void mesh_edges_sharp_tag(LoopSplitTaskDataCommon *data,
   const int numEdges = data->numEdges;
   const int numPolys = data->numPolys;
 
-  float(*loopnors)[3] = data->loopnors; /* Note: loopnors may be NULL here. */
   const float(*polynors)[3] = data->polynors;
 
   int(*edge_to_loops)[2] = data->edge_to_loops;
@@ -847,6 +869,13 @@ static void mesh_edges_sharp_tag(LoopSplitTaskDataCommon *data,
 
   const float split_angle_cos = check_angle ? cosf(split_angle) : -1.0f;
 
+  /* The per-loop data does not depend on other polys, only the classification of edges below
+   * depends on the order in which polys are visited. Note: loopnors may be NULL here. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, numPolys, data, mesh_edges_sharp_tag_prepare_cb, &settings);
+
   for (mp = mpolys, mp_index = 0; mp_index < numPolys; mp++, mp_index++) {
     const MLoop *ml_curr;
     int *e2l;
@@ -858,15 +887,6 @@ static void mesh_edges_sharp_tag(LoopSplitTaskDataCommon *data,
     for (; ml_curr_index <= ml_last_index; ml_curr++, ml_curr_index++) {
       e2l = edge_to_loops[ml_curr->e];
 
-      loop_to_poly[ml_curr_index] = mp_index;
-
-      /* Pre-populate all loop normals as if their verts were all-smooth,
-       * this way we don't have to compute those later!
-       */
-      if (loopnors) {
-        normal_short_to_float_v3(loopnors[ml_curr_index], mverts[ml_curr->v].no);
-      }
-
       /* Check whether current edge might be smooth or sharp */
       if ((e2l[0] | e2l[1]) == 0) {
         /* 'Empty' edge until now, set e2l[0] (and e2l[1] to INDEX_UNSET to tag it as unset). */
@@ -3278,146 +3298,219 @@ int BKE_mesh_tessface_calc_ex(CustomData *fdata,
 #undef ML_TO_MF_QUAD
 }
 
+/** Compared against the number of loops, smaller meshes are not worth the threading overhead. */
+#define MESH_FACE_TESSELLATE_THREADED_LIMIT 4096
+
 /**
- * Calculate tessellation into #MLoopTri which exist only for this purpose.
+ * \param arena: Allocated lazily when n-gons are found, persists across calls
+ * so memory can be reused (by clearing it) for threads that handle many polygons.
  */
-void BKE_mesh_recalc_looptri(const MLoop *mloop,
-                             const MPoly *mpoly,
-                             const MVert *mvert,
-                             int totloop,
-                             int totpoly,
-                             MLoopTri *mlooptri)
+BLI_INLINE void mesh_calc_tessellation_for_face(const MLoop *mloop,
+                                                const MPoly *mpoly,
+                                                const MVert *mvert,
+                                                unsigned int poly_index,
+                                                MLoopTri *mlt,
+                                                MemArena **r_arena)
 {
-  /* use this to avoid locking pthread for _every_ polygon
-   * and calling the fill function */
-
-#define USE_TESSFACE_SPEEDUP
-
-  const MPoly *mp;
-  const MLoop *ml;
-  MLoopTri *mlt;
-  MemArena *arena = NULL;
-  int poly_index, mlooptri_index;
-  unsigned int j;
+  const unsigned int mp_loopstart = (unsigned int)mpoly[poly_index].loopstart;
+  const unsigned int mp_totloop = (unsigned int)mpoly[poly_index].totloop;
 
-  mlooptri_index = 0;
-  mp = mpoly;
-  for (poly_index = 0; poly_index < totpoly; poly_index++, mp++) {
-    const unsigned int mp_loopstart = (unsigned int)mp->loopstart;
-    const unsigned int mp_totloop = (unsigned int)mp->totloop;
-    unsigned int l1, l2, l3;
-    if (mp_totloop < 3) {
-      /* do nothing */
-    }
-
-#ifdef USE_TESSFACE_SPEEDUP
-
-#  define ML_TO_MLT(i1, i2, i3) \
-    { \
-      mlt = &mlooptri[mlooptri_index]; \
-      l1 = mp_loopstart + i1; \
-      l2 = mp_loopstart + i2; \
-      l3 = mp_loopstart + i3; \
-      ARRAY_SET_ITEMS(mlt->tri, l1, l2, l3); \
-      mlt->poly = (unsigned int)poly_index; \
-    } \
-    ((void)0)
+#define ML_TO_MLT(i1, i2, i3) \
+  { \
+    ARRAY_SET_ITEMS(mlt->tri, mp_loopstart + i1, mp_loopstart + i2, mp_loopstart + i3); \
+    mlt->poly = poly_index; \
+  } \
+  ((void)0)
 
-    else if (mp_totloop == 3) {
+  switch (mp_totloop) {
+    case 3: {
       ML_TO_MLT(0, 1, 2);
-      mlooptri_index++;
+      break;
     }
-    else if (mp_totloop == 4) {
+    case 4: {
       ML_TO_MLT(0, 1, 2);
-      MLoopTri *mlt_a = mlt;
-      mlooptri_index++;
+      MLoopTri *mlt_a = mlt++;
       ML_TO_MLT(0, 2, 3);
       MLoopTri *mlt_b = mlt;
-      mlooptri_index++;
 
       if (UNLIKELY(is_quad_flip_v3_first_third_fast(mvert[mloop[mlt_a->tri[0]].v].co,
                                                     mvert[mloop[mlt_a->tri[1]].v].co,
                                                     mvert[mloop[mlt_a->tri[2]].v].co,
                                                     mvert[mloop[mlt_b->tri[2]].v].co))) {
-        /* flip out of degenerate 0-2 state. */
+        /* Flip out of degenerate 0-2 state. */
         mlt_a->tri[2] = mlt_b->tri[2];
         mlt_b->tri[0] = mlt_a->tri[1];
       }
+      break;
     }
-#endif /* USE_TESSFACE_SPEEDUP */
-    else {
-      const float *co_curr, *co_prev;
+    default: {
+      const MLoop *ml;
+      float axis_mat[3][3];
 
-      float normal[3];
+      /* Calculate `axis_mat` to project verts to 2D. */
+      {
+        float normal[3];
+        const float *co_curr, *co_prev;
 
-      float axis_mat[3][3];
-      float(*projverts)[2];
-      unsigned int(*tris)[3];
+        zero_v3(normal);
+
+        /* Calc normal, flipped: to get a positive 2D cross product. */
+        ml = mloop + mp_loopstart;
+        co_prev = mvert[ml[mp_totloop - 1].v].co;
+        for (unsigned int j = 0; j < mp_totloop; j++, ml++) {
+          co_curr = mvert[ml->v].co;
+          add_newell_cross_v3_v3v3(normal, co_prev, co_curr);
+          co_prev = co_curr;
+        }
+        if (UNLIKELY(normalize_v3(normal) == 0.0f)) {
+          normal[2] = 1.0f;
+        }
+        axis_dominant_v3_to_m3_negate(axis_mat, normal);
+      }
 
       const unsigned int totfilltri = mp_totloop - 2;
 
-      if (UNLIKELY(arena == NULL)) {
-        arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
+      MemArena *pf_arena = *r_arena;
+      if (UNLIKELY(pf_arena == NULL)) {
+        pf_arena = *r_arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
       }
 
-      tris = BLI_memarena_alloc(arena, sizeof(*tris) * (size_t)totfilltri);
-      projverts = BLI_memarena_alloc(arena, sizeof(*projverts) * (size_t)mp_totloop);
+      unsigned int(*tris)[3] = BLI_memarena_alloc(pf_arena, sizeof(*tris) * (size_t)totfilltri);
+      float(*projverts)[2] = BLI_memarena_alloc(pf_arena,
+                                                sizeof(*projverts) * (size_t)mp_totloop);
 
-      zero_v3(normal);
-
-      /* calc normal, flipped: to get a positive 2d cross product */
       ml = mloop + mp_loopstart;
-      co_prev = mvert[ml[mp_totloop - 1].v].co;
-      for (j = 0; j < mp_totloop; j++, ml++) {
-        co_curr = mvert[ml->v].co;
-        add_newell_cross_v3_v3v3(normal, co_prev, co_curr);
-        co_prev = co_curr;
-      }
-      if (UNLIKELY(normalize_v3(normal) == 0.0f)) {
-        normal[2] = 1.0f;
+      for (unsigned int j = 0; j < mp_totloop; j++, ml++) {
+        mul_v2_m3v3(projverts[j], axis_mat, mvert[ml->v].co);
       }
 
-      /* project verts to 2d */
-      axis_dominant_v3_to_m3_negate(axis_mat, normal);
+      BLI_polyfill_calc_arena(projverts, mp_totloop, 1, tris, pf_arena);
 
-      ml = mloop + mp_loopstart;
-      for (j = 0; j < mp_totloop; j++, ml++) {
-        mul_v2_m3v3(projverts[j], axis_mat, mvert[ml->v].co);
+      /* Apply fill. */
+      for (unsigned int j = 0; j < totfilltri; j++, mlt++) {
+        const unsigned int *tri = tris[j];
+        ML_TO_MLT(tri[0], tri[1], tri[2]);
       }
 
-      BLI_polyfill_calc_arena(projverts, mp_totloop, 1, tris, arena);
+      BLI_memarena_clear(pf_arena);
 
-      /* apply fill */
-      for (j = 0; j < totfilltri; j++) {
-        unsigned int *tri = tris[j];
+      break;
+    }
+  }
+#undef ML_TO_MLT
+}
 
-        mlt = &mlooptri[mlooptri_index];
+static void mesh_recalc_looptri__single_threaded(const MLoop *mloop,
+                                                 const MPoly *mpoly,
+                                                 const MVert *mvert,
+                                                 int totloop,
+                                                 int totpoly,
+                                                 MLoopTri *mlooptri)
+{
+  MemArena *pf_arena = NULL;
+  const MPoly *mp = mpoly;
+  unsigned int tri_index = 0;
+  for (unsigned int poly_index = 0; poly_index < (unsigned int)totpoly; poly_index++, mp++) {
+    if (mp->totloop < 3) {
+      continue;
+    }
+    mesh_calc_tessellation_for_face(
+        mloop, mpoly, mvert, poly_index, &mlooptri[tri_index], &pf_arena);
+    tri_index += (unsigned int)(mp->totloop - 2);
+  }
 
-        /* set loop indices, transformed to vert indices later */
-        l1 = mp_loopstart + tri[0];
-        l2 = mp_loopstart + tri[1];
-        l3 = mp_loopstart + tri[2];
+  if (pf_arena) {
+    BLI_memarena_free(pf_arena);
+    pf_arena = NULL;
+  }
+  BLI_assert(tri_index == (unsigned int)poly_to_tri_count(totpoly, totloop));
+  UNUSED_VARS_NDEBUG(totloop);
+}
 
-        ARRAY_SET_ITEMS(mlt->tri, l1, l2, l3);
-        mlt->poly = (unsigned int)poly_index;
+struct TessellationUserData {
+  const MLoop *mloop;
+  const MPoly *mpoly;
+  const MVert *mvert;
 
-        mlooptri_index++;
-      }
+  /** Output array. */
+  MLoopTri *mlooptri;
+};
 
-      BLI_memarena_clear(arena);
-    }
+struct TessellationUserTLS {
+  MemArena *pf_arena;
+};
+
+static void mesh_calc_tessellation_for_face_fn(void *__restrict userdata,
+                                               const int index,
+                                               const TaskParallelTLS *__restrict tls)
+{
+  const struct TessellationUserData *data = userdata;
+  struct TessellationUserTLS *tls_data = tls->userdata_chunk;
+  if (data->mpoly[index].totloop < 3) {
+    return;
   }
+  /* Polygon loops are stored contiguously, so the triangle offset follows from the loop start. */
+  const int tri_index = poly_to_tri_count(index, data->mpoly[index].loopstart);
+  mesh_calc_tessellation_for_face(data->mloop,
+                                  data->mpoly,
+                                  data->mvert,
+                                  (unsigned int)index,
+                                  &data->mlooptri[tri_index],
+                                  &tls_data->pf_arena);
+}
 
-  if (arena) {
-    BLI_memarena_free(arena);
-    arena = NULL;
+static void mesh_calc_tessellation_for_face_free_fn(const void *__restrict UNUSED(userdata),
+                                                    void *__restrict tls_v)
+{
+  struct TessellationUserTLS *tls_data = tls_v;
+  if (tls_data->pf_arena) {
+    BLI_memarena_free(tls_data->pf_arena);
   }
+}
 
-  BLI_assert(mlooptri_index == poly_to_tri_count(totpoly, totloop));
-  UNUSED_VARS_NDEBUG(totloop);
+static void mesh_recalc_looptri__multi_threaded(const MLoop *mloop,
+                                                const MPoly *mpoly,
+                                                const MVert *mvert,
+                                                int UNUSED(totloop),
+                                                int totpoly,
+                                                MLoopTri *mlooptri)
+{
+  struct TessellationUserTLS tls_data_dummy = {NULL};
 
-#undef USE_TESSFACE_SPEEDUP
-#undef ML_TO_MLT
+  struct TessellationUserData data = {
+      .mloop = mloop,
+      .mpoly = mpoly,
+      .mvert = mvert,
+      .mlooptri = mlooptri,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+
+  settings.userdata_chunk = &tls_data_dummy;
+  settings.userdata_chunk_size = sizeof(tls_data_dummy);
+
+  settings.func_free = mesh_calc_tessellation_for_face_free_fn;
+
+  BLI_task_parallel_range(0, totpoly, &data, mesh_calc_tessellation_for_face_fn, &settings);
+}
+
+/**
+ * Calculate tessellation into #MLoopTri which exist only for this purpose.
+ */
+void BKE_mesh_recalc_looptri(const MLoop *mloop,
+                             const MPoly *mpoly,
+                             const MVert *mvert,
+                             int totloop,
+                             int totpoly,
+                             MLoopTri *mlooptri)
+{
+  if (totloop < MESH_FACE_TESSELLATE_THREADED_LIMIT) {
+    mesh_recalc_looptri__single_threaded(mloop, mpoly, mvert, totloop, totpoly, mlooptri);
+  }
+  else {
+    mesh_recalc_looptri__multi_threaded(mloop, mpoly, mvert, totloop, totpoly, mlooptri);
+  }
 }
 
 static void bm_corners_to_loops_ex(ID *id,
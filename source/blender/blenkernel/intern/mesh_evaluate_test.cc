@@ -0,0 +1,105 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 by Blender Foundation.
+ */
+#include "testing/testing.h"
+
+#include "BKE_idtype.h"
+#include "BKE_lib_id.h"
+#include "BKE_mesh.h"
+#include "BKE_mesh_runtime.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+
+#include "BLI_math_base.h"
+#include "BLI_rand.hh"
+
+namespace blender::bke::tests {
+
+/* Grid of `side * side` quads with random heights, without edges. */
+static Mesh *test_mesh_grid_create(RandomNumberGenerator *rng, int32_t num_items)
+{
+  const int side = max_ii((int)sqrtf((float)num_items), 1);
+  const int verts_side = side + 1;
+  const int totvert = verts_side * verts_side;
+  const int totpoly = side * side;
+
+  BKE_idtype_init();
+  Mesh *mesh = BKE_mesh_new_nomain(totvert, 0, 0, totpoly * 4, totpoly);
+
+  for (int y = 0; y < verts_side; y++) {
+    for (int x = 0; x < verts_side; x++) {
+      MVert *mv = &mesh->mvert[y * verts_side + x];
+      mv->co[0] = (float)x;
+      mv->co[1] = (float)y;
+      mv->co[2] = rng->get_float();
+    }
+  }
+
+  for (int y = 0; y < side; y++) {
+    for (int x = 0; x < side; x++) {
+      const int poly_index = y * side + x;
+      MPoly *mp = &mesh->mpoly[poly_index];
+      mp->loopstart = poly_index * 4;
+      mp->totloop = 4;
+
+      MLoop *ml = &mesh->mloop[mp->loopstart];
+      ml[0].v = y * verts_side + x;
+      ml[1].v = y * verts_side + x + 1;
+      ml[2].v = (y + 1) * verts_side + x + 1;
+      ml[3].v = (y + 1) * verts_side + x;
+    }
+  }
+
+  return mesh;
+}
+
+static void test_mesh_evaluate(Mesh *mesh)
+{
+  BKE_mesh_calc_edges(mesh, false, false);
+  EXPECT_GT(mesh->totedge, 0);
+
+  BKE_mesh_calc_normals(mesh);
+
+  BKE_mesh_runtime_looptri_recalc(mesh);
+  EXPECT_EQ(BKE_mesh_runtime_looptri_len(mesh), mesh->totpoly * 2);
+}
+
+static void test_mesh_evaluate_performance(int32_t num_items)
+{
+  RandomNumberGenerator rng;
+  Mesh *mesh = test_mesh_grid_create(&rng, num_items);
+  test_mesh_evaluate(mesh);
+  BKE_id_free(nullptr, mesh);
+}
+
+TEST(mesh_evaluate_performance, performance_grid_10000)
+{
+  test_mesh_evaluate_performance(10000);
+}
+TEST(mesh_evaluate_performance, performance_grid_100000)
+{
+  test_mesh_evaluate_performance(100000);
+}
+TEST(mesh_evaluate_performance, performance_grid_1000000)
+{
+  test_mesh_evaluate_performance(1000000);
+}
+
+}  // namespace blender::bke::tests
@@ -82,6 +82,39 @@ static bool mesh_remap_bvhtree_query_nearest(BVHTreeFromMesh *treedata,
   return false;
 }
 
+/**
+ * Find the nearest source element of all destination vertices at once,
+ * \a r_vcos_dst receives the vertex coordinates in tree space.
+ */
+static void mesh_remap_bvhtree_query_nearest_verts(BVHTreeFromMesh *treedata,
+                                                   const MVert *verts_dst,
+                                                   const int numverts_dst,
+                                                   const SpaceTransform *space_transform,
+                                                   const float max_dist_sq,
+                                                   float (*r_vcos_dst)[3],
+                                                   BVHTreeNearest *r_nearest)
+{
+  for (int i = 0; i < numverts_dst; i++) {
+    copy_v3_v3(r_vcos_dst[i], verts_dst[i].co);
+
+    /* Convert the vertex to tree coordinates, if needed. */
+    if (space_transform) {
+      BLI_space_transform_apply(space_transform, r_vcos_dst[i]);
+    }
+
+    r_nearest[i].index = -1;
+    r_nearest[i].dist_sq = max_dist_sq;
+  }
+
+  BLI_bvhtree_find_nearest_batch(treedata->tree,
+                                 (const float(*)[3])r_vcos_dst,
+                                 numverts_dst,
+                                 r_nearest,
+                                 treedata->nearest_callback,
+                                 treedata,
+                                 0);
+}
+
 static bool mesh_remap_bvhtree_query_raycast(BVHTreeFromMesh *treedata,
                                              BVHTreeRayHit *rayhit,
                                              const float co[3],
@@ -529,51 +562,52 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
     float tmp_co[3], tmp_no[3];
 
     if (mode == MREMAP_MODE_VERT_NEAREST) {
+      float(*vcos_dst)[3] = MEM_malloc_arrayN((size_t)numverts_dst, sizeof(*vcos_dst), __func__);
+      BVHTreeNearest *nearest_dst = MEM_malloc_arrayN(
+          (size_t)numverts_dst, sizeof(*nearest_dst), __func__);
+
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_VERTS, 2);
-      nearest.index = -1;
+      mesh_remap_bvhtree_query_nearest_verts(
+          &treedata, verts_dst, numverts_dst, space_transform, max_dist_sq, vcos_dst, nearest_dst);
 
       for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, verts_dst[i].co);
-
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
-
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &nearest.index, &full_weight);
+        if (nearest_dst[i].index != -1) {
+          hit_dist = sqrtf(nearest_dst[i].dist_sq);
+          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &nearest_dst[i].index, &full_weight);
         }
         else {
           /* No source for this dest vertex! */
           BKE_mesh_remap_item_define_invalid(r_map, i);
         }
       }
+
+      MEM_freeN(vcos_dst);
+      MEM_freeN(nearest_dst);
     }
     else if (ELEM(mode, MREMAP_MODE_VERT_EDGE_NEAREST, MREMAP_MODE_VERT_EDGEINTERP_NEAREST)) {
       MEdge *edges_src = me_src->medge;
       float(*vcos_src)[3] = BKE_mesh_vert_coords_alloc(me_src, NULL);
 
+      float(*vcos_dst)[3] = MEM_malloc_arrayN((size_t)numverts_dst, sizeof(*vcos_dst), __func__);
+      BVHTreeNearest *nearest_dst = MEM_malloc_arrayN(
+          (size_t)numverts_dst, sizeof(*nearest_dst), __func__);
+
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
-      nearest.index = -1;
+      mesh_remap_bvhtree_query_nearest_verts(
+          &treedata, verts_dst, numverts_dst, space_transform, max_dist_sq, vcos_dst, nearest_dst);
 
       for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, verts_dst[i].co);
-
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
+        const float *co_dst = vcos_dst[i];
 
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          MEdge *me = &edges_src[nearest.index];
+        if (nearest_dst[i].index != -1) {
+          hit_dist = sqrtf(nearest_dst[i].dist_sq);
+          MEdge *me = &edges_src[nearest_dst[i].index];
           const float *v1cos = vcos_src[me->v1];
           const float *v2cos = vcos_src[me->v2];
 
           if (mode == MREMAP_MODE_VERT_EDGE_NEAREST) {
-            const float dist_v1 = len_squared_v3v3(tmp_co, v1cos);
-            const float dist_v2 = len_squared_v3v3(tmp_co, v2cos);
+            const float dist_v1 = len_squared_v3v3(co_dst, v1cos);
+            const float dist_v2 = len_squared_v3v3(co_dst, v2cos);
             const int index = (int)((dist_v1 > dist_v2) ? me->v2 : me->v1);
             mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &index, &full_weight);
           }
@@ -585,7 +619,7 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
             indices[1] = (int)me->v2;
 
             /* Weight is inverse of point factor here... */
-            weights[0] = line_point_factor_v3(tmp_co, v2cos, v1cos);
+            weights[0] = line_point_factor_v3(co_dst, v2cos, v1cos);
             CLAMP(weights[0], 0.0f, 1.0f);
             weights[1] = 1.0f - weights[0];
 
@@ -599,6 +633,8 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
       }
 
       MEM_freeN(vcos_src);
+      MEM_freeN(vcos_dst);
+      MEM_freeN(nearest_dst);
     }
     else if (ELEM(mode,
                   MREMAP_MODE_VERT_POLY_NEAREST,
@@ -753,13 +789,10 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
     float tmp_co[3], tmp_no[3];
 
     if (mode == MREMAP_MODE_EDGE_VERT_NEAREST) {
-      const int num_verts_src = me_src->totvert;
-      const int num_edges_src = me_src->totedge;
       MEdge *edges_src = me_src->medge;
       float(*vcos_src)[3] = BKE_mesh_vert_coords_alloc(me_src, NULL);
 
-      MeshElemMap *vert_to_edge_src_map;
-      int *vert_to_edge_src_map_mem;
+      const MeshElemMap *vert_to_edge_src_map = BKE_mesh_runtime_vert_edge_map_ensure(me_src);
 
       struct {
         float hit_dist;
@@ -771,12 +804,6 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
         v_dst_to_src_map[i].hit_dist = -1.0f;
       }
 
-      BKE_mesh_vert_edge_map_create(&vert_to_edge_src_map,
-                                    &vert_to_edge_src_map_mem,
-                                    edges_src,
-                                    num_verts_src,
-                                    num_edges_src);
-
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_VERTS, 2);
       nearest.index = -1;
 
@@ -876,8 +903,6 @@ void BKE_mesh_remap_calc_edges_from_mesh(const int mode,
 
       MEM_freeN(vcos_src);
       MEM_freeN(v_dst_to_src_map);
-      MEM_freeN(vert_to_edge_src_map);
-      MEM_freeN(vert_to_edge_src_map_mem);
     }
     else if (mode == MREMAP_MODE_EDGE_NEAREST) {
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
@@ -1073,7 +1098,7 @@ static void mesh_island_to_astar_graph_edge_process(MeshIslandStore *islands,
                                                     MLoop *loops,
                                                     const int edge_idx,
                                                     BLI_bitmap *done_edges,
-                                                    MeshElemMap *edge_to_poly_map,
+                                                    const MeshElemMap *edge_to_poly_map,
                                                     const bool is_edge_innercut,
                                                     const int *poly_island_index_map,
                                                     float (*poly_centers)[3],
@@ -1127,7 +1152,7 @@ static void mesh_island_to_astar_graph_edge_process(MeshIslandStore *islands,
 static void mesh_island_to_astar_graph(MeshIslandStore *islands,
                                        const int island_index,
                                        MVert *verts,
-                                       MeshElemMap *edge_to_poly_map,
+                                       const MeshElemMap *edge_to_poly_map,
                                        const int numedges,
                                        MLoop *loops,
                                        MPoly *polys,
@@ -1317,12 +1342,9 @@ void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
 
     float(*poly_cents_src)[3] = NULL;
 
-    MeshElemMap *vert_to_loop_map_src = NULL;
-    int *vert_to_loop_map_src_buff = NULL;
-    MeshElemMap *vert_to_poly_map_src = NULL;
-    int *vert_to_poly_map_src_buff = NULL;
-    MeshElemMap *edge_to_poly_map_src = NULL;
-    int *edge_to_poly_map_src_buff = NULL;
+    const MeshElemMap *vert_to_loop_map_src = NULL;
+    const MeshElemMap *vert_to_poly_map_src = NULL;
+    const MeshElemMap *edge_to_poly_map_src = NULL;
     MeshElemMap *poly_to_looptri_map_src = NULL;
     int *poly_to_looptri_map_src_buff = NULL;
 
@@ -1431,33 +1453,14 @@ void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
     }
 
     if (use_from_vert) {
-      BKE_mesh_vert_loop_map_create(&vert_to_loop_map_src,
-                                    &vert_to_loop_map_src_buff,
-                                    polys_src,
-                                    loops_src,
-                                    num_verts_src,
-                                    num_polys_src,
-                                    num_loops_src);
+      vert_to_loop_map_src = BKE_mesh_runtime_vert_loop_map_ensure(me_src);
       if (mode & MREMAP_USE_POLY) {
-        BKE_mesh_vert_poly_map_create(&vert_to_poly_map_src,
-                                      &vert_to_poly_map_src_buff,
-                                      polys_src,
-                                      loops_src,
-                                      num_verts_src,
-                                      num_polys_src,
-                                      num_loops_src);
+        vert_to_poly_map_src = BKE_mesh_runtime_vert_poly_map_ensure(me_src);
       }
     }
 
     /* Needed for islands (or plain mesh) to AStar graph conversion. */
-    BKE_mesh_edge_poly_map_create(&edge_to_poly_map_src,
-                                  &edge_to_poly_map_src_buff,
-                                  edges_src,
-                                  num_edges_src,
-                                  polys_src,
-                                  num_polys_src,
-                                  loops_src,
-                                  num_loops_src);
+    edge_to_poly_map_src = BKE_mesh_runtime_edge_poly_map_ensure(me_src);
     if (use_from_vert) {
       loop_to_poly_map_src = MEM_mallocN(sizeof(*loop_to_poly_map_src) * (size_t)num_loops_src,
                                          __func__);
@@ -1650,7 +1653,7 @@ void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
         ml_dst = &loops_dst[mp_dst->loopstart];
         for (plidx_dst = 0; plidx_dst < mp_dst->totloop; plidx_dst++, ml_dst++) {
           if (use_from_vert) {
-            MeshElemMap *vert_to_refelem_map_src = NULL;
+            const MeshElemMap *vert_to_refelem_map_src = NULL;
 
             copy_v3_v3(tmp_co, verts_dst[ml_dst->v].co);
             nearest.index = -1;
@@ -2157,24 +2160,6 @@ void BKE_mesh_remap_calc_loops_from_mesh(const int mode,
     if (vcos_src) {
       MEM_freeN(vcos_src);
     }
-    if (vert_to_loop_map_src) {
-      MEM_freeN(vert_to_loop_map_src);
-    }
-    if (vert_to_loop_map_src_buff) {
-      MEM_freeN(vert_to_loop_map_src_buff);
-    }
-    if (vert_to_poly_map_src) {
-      MEM_freeN(vert_to_poly_map_src);
-    }
-    if (vert_to_poly_map_src_buff) {
-      MEM_freeN(vert_to_poly_map_src_buff);
-    }
-    if (edge_to_poly_map_src) {
-      MEM_freeN(edge_to_poly_map_src);
-    }
-    if (edge_to_poly_map_src_buff) {
-      MEM_freeN(edge_to_poly_map_src_buff);
-    }
     if (poly_to_looptri_map_src) {
       MEM_freeN(poly_to_looptri_map_src);
     }
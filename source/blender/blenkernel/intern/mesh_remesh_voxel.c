@@ -32,6 +32,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_mesh_types.h"
@@ -314,14 +315,58 @@ Mesh *BKE_mesh_remesh_voxel_to_mesh_nomain(Mesh *mesh,
   return new_mesh;
 }
 
-void BKE_mesh_remesh_reproject_paint_mask(Mesh *target, Mesh *source)
+typedef struct RemeshNearestVertsData {
+  const BVHTreeFromMesh *bvhtree;
+  const MVert *target_verts;
+  int *r_nearest;
+} RemeshNearestVertsData;
+
+static void remesh_find_nearest_verts_cb(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const RemeshNearestVertsData *data = userdata;
+  BVHTreeNearest nearest;
+  nearest.index = -1;
+  nearest.dist_sq = FLT_MAX;
+  BLI_bvhtree_find_nearest(data->bvhtree->tree,
+                           data->target_verts[i].co,
+                           &nearest,
+                           data->bvhtree->nearest_callback,
+                           (void *)data->bvhtree);
+  data->r_nearest[i] = nearest.index;
+}
+
+/**
+ * Find the closest source vertex for every target vertex, -1 when there is none.
+ * The result is shared by all layers that are reprojected, the queries run in parallel.
+ */
+static int *remesh_find_nearest_verts(Mesh *target, Mesh *source)
 {
   BVHTreeFromMesh bvhtree = {
       .nearest_callback = NULL,
   };
   BKE_bvhtree_from_mesh_get(&bvhtree, source, BVHTREE_FROM_VERTS, 2);
-  MVert *target_verts = CustomData_get_layer(&target->vdata, CD_MVERT);
 
+  int *nearest_verts = MEM_malloc_arrayN(target->totvert, sizeof(*nearest_verts), __func__);
+
+  RemeshNearestVertsData data = {
+      .bvhtree = &bvhtree,
+      .target_verts = CustomData_get_layer(&target->vdata, CD_MVERT),
+      .r_nearest = nearest_verts,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, target->totvert, &data, remesh_find_nearest_verts_cb, &settings);
+
+  free_bvhtree_from_mesh(&bvhtree);
+  return nearest_verts;
+}
+
+void BKE_mesh_remesh_reproject_paint_mask(Mesh *target, Mesh *source)
+{
   float *target_mask;
   if (CustomData_has_layer(&target->vdata, CD_PAINT_MASK)) {
     target_mask = CustomData_get_layer(&target->vdata, CD_PAINT_MASK);
@@ -340,18 +385,48 @@ void BKE_mesh_remesh_reproject_paint_mask(Mesh *target, Mesh *source)
         &source->vdata, CD_PAINT_MASK, CD_CALLOC, NULL, source->totvert);
   }
 
+  int *nearest_verts = remesh_find_nearest_verts(target, source);
   for (int i = 0; i < target->totvert; i++) {
-    float from_co[3];
-    BVHTreeNearest nearest;
-    nearest.index = -1;
-    nearest.dist_sq = FLT_MAX;
-    copy_v3_v3(from_co, target_verts[i].co);
-    BLI_bvhtree_find_nearest(bvhtree.tree, from_co, &nearest, bvhtree.nearest_callback, &bvhtree);
-    if (nearest.index != -1) {
-      target_mask[i] = source_mask[nearest.index];
+    if (nearest_verts[i] != -1) {
+      target_mask[i] = source_mask[nearest_verts[i]];
     }
   }
-  free_bvhtree_from_mesh(&bvhtree);
+  MEM_freeN(nearest_verts);
+}
+
+typedef struct RemeshFaceSetsData {
+  const BVHTreeFromMesh *bvhtree;
+  const MPoly *target_polys;
+  const MVert *target_verts;
+  const MLoop *target_loops;
+  const MLoopTri *looptri;
+  const int *source_face_sets;
+  int *target_face_sets;
+} RemeshFaceSetsData;
+
+static void remesh_reproject_face_sets_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const RemeshFaceSetsData *data = userdata;
+  float from_co[3];
+  BVHTreeNearest nearest;
+  nearest.index = -1;
+  nearest.dist_sq = FLT_MAX;
+  const MPoly *mpoly = &data->target_polys[i];
+  BKE_mesh_calc_poly_center(
+      mpoly, &data->target_loops[mpoly->loopstart], data->target_verts, from_co);
+  BLI_bvhtree_find_nearest(data->bvhtree->tree,
+                           from_co,
+                           &nearest,
+                           data->bvhtree->nearest_callback,
+                           (void *)data->bvhtree);
+  if (nearest.index != -1) {
+    data->target_face_sets[i] = data->source_face_sets[data->looptri[nearest.index].poly];
+  }
+  else {
+    data->target_face_sets[i] = 1;
+  }
 }
 
 void BKE_remesh_reproject_sculpt_face_sets(Mesh *target, Mesh *source)
@@ -385,32 +460,33 @@ void BKE_remesh_reproject_sculpt_face_sets(Mesh *target, Mesh *source)
   const MLoopTri *looptri = BKE_mesh_runtime_looptri_ensure(source);
   BKE_bvhtree_from_mesh_get(&bvhtree, source, BVHTREE_FROM_LOOPTRI, 2);
 
-  for (int i = 0; i < target->totpoly; i++) {
-    float from_co[3];
-    BVHTreeNearest nearest;
-    nearest.index = -1;
-    nearest.dist_sq = FLT_MAX;
-    const MPoly *mpoly = &target_polys[i];
-    BKE_mesh_calc_poly_center(mpoly, &target_loops[mpoly->loopstart], target_verts, from_co);
-    BLI_bvhtree_find_nearest(bvhtree.tree, from_co, &nearest, bvhtree.nearest_callback, &bvhtree);
-    if (nearest.index != -1) {
-      target_face_sets[i] = source_face_sets[looptri[nearest.index].poly];
-    }
-    else {
-      target_face_sets[i] = 1;
-    }
-  }
+  RemeshFaceSetsData data = {
+      .bvhtree = &bvhtree,
+      .target_polys = target_polys,
+      .target_verts = target_verts,
+      .target_loops = target_loops,
+      .looptri = looptri,
+      .source_face_sets = source_face_sets,
+      .target_face_sets = target_face_sets,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, target->totpoly, &data, remesh_reproject_face_sets_cb, &settings);
+
   free_bvhtree_from_mesh(&bvhtree);
 }
 
 void BKE_remesh_reproject_vertex_paint(Mesh *target, Mesh *source)
 {
-  BVHTreeFromMesh bvhtree = {
-      .nearest_callback = NULL,
-  };
-  BKE_bvhtree_from_mesh_get(&bvhtree, source, BVHTREE_FROM_VERTS, 2);
-
   int tot_color_layer = CustomData_number_of_layers(&source->vdata, CD_PROP_COLOR);
+  if (tot_color_layer == 0) {
+    return;
+  }
+
+  /* All layers use the same source vertices, only look them up once. */
+  int *nearest_verts = remesh_find_nearest_verts(target, source);
 
   for (int layer_n = 0; layer_n < tot_color_layer; layer_n++) {
     const char *layer_name = CustomData_get_layer_name(&source->vdata, CD_PROP_COLOR, layer_n);
@@ -418,20 +494,14 @@ void BKE_remesh_reproject_vertex_paint(Mesh *target, Mesh *source)
         &target->vdata, CD_PROP_COLOR, CD_CALLOC, NULL, target->totvert, layer_name);
 
     MPropCol *target_color = CustomData_get_layer_n(&target->vdata, CD_PROP_COLOR, layer_n);
-    MVert *target_verts = CustomData_get_layer(&target->vdata, CD_MVERT);
     MPropCol *source_color = CustomData_get_layer_n(&source->vdata, CD_PROP_COLOR, layer_n);
     for (int i = 0; i < target->totvert; i++) {
-      BVHTreeNearest nearest;
-      nearest.index = -1;
-      nearest.dist_sq = FLT_MAX;
-      BLI_bvhtree_find_nearest(
-          bvhtree.tree, target_verts[i].co, &nearest, bvhtree.nearest_callback, &bvhtree);
-      if (nearest.index != -1) {
-        copy_v4_v4(target_color[i].color, source_color[nearest.index].color);
+      if (nearest_verts[i] != -1) {
+        copy_v4_v4(target_color[i].color, source_color[nearest_verts[i]].color);
       }
     }
   }
-  free_bvhtree_from_mesh(&bvhtree);
+  MEM_freeN(nearest_verts);
 }
 
 struct Mesh *BKE_mesh_remesh_voxel_fix_poles(struct Mesh *mesh)
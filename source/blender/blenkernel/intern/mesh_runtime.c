@@ -35,6 +35,7 @@
 #include "BKE_bvhutils.h"
 #include "BKE_lib_id.h"
 #include "BKE_mesh.h"
+#include "BKE_mesh_mapping.h"
 #include "BKE_mesh_runtime.h"
 #include "BKE_shrinkwrap.h"
 #include "BKE_subdiv_ccg.h"
@@ -68,6 +69,7 @@ void BKE_mesh_runtime_reset_on_copy(Mesh *mesh, const int UNUSED(flag))
   memset(&runtime->looptris, 0, sizeof(runtime->looptris));
   runtime->bvh_cache = NULL;
   runtime->shrinkwrap_data = NULL;
+  runtime->topology_maps = NULL;
 
   mesh->runtime.eval_mutex = MEM_mallocN(sizeof(ThreadMutex), "mesh runtime eval_mutex");
   BLI_mutex_init(mesh->runtime.eval_mutex);
@@ -175,6 +177,40 @@ const MLoopTri *BKE_mesh_runtime_looptri_ensure(Mesh *mesh)
   return looptri;
 }
 
+/**
+ * Reuse the triangulation of \a mesh_src for \a mesh_dst, which shares its topology arrays and
+ * only has different vertex positions (the result of deform-only modifiers). The source keeps
+ * its triangulation across evaluations, so copying it is much cheaper than triangulating again.
+ *
+ * \note Concave quads and n-gons are triangulated based on vertex positions, with this they keep
+ * the triangulation of the undeformed mesh. This also avoids the split changing between frames.
+ */
+void BKE_mesh_runtime_looptri_copy_from_deform_source(Mesh *mesh_dst, Mesh *mesh_src)
+{
+  BLI_assert(mesh_dst->mpoly == mesh_src->mpoly && mesh_dst->mloop == mesh_src->mloop);
+  BLI_assert(mesh_dst->totpoly == mesh_src->totpoly && mesh_dst->totloop == mesh_src->totloop);
+
+  const MLoopTri *looptri_src = BKE_mesh_runtime_looptri_ensure(mesh_src);
+
+  ThreadMutex *mesh_eval_mutex = (ThreadMutex *)mesh_dst->runtime.eval_mutex;
+  BLI_mutex_lock(mesh_eval_mutex);
+
+  if (mesh_dst->runtime.looptris.array == NULL) {
+    mesh_ensure_looptri_data(mesh_dst);
+    if (mesh_dst->runtime.looptris.len != 0) {
+      memcpy(mesh_dst->runtime.looptris.array_wip,
+             looptri_src,
+             sizeof(*looptri_src) * (size_t)mesh_dst->runtime.looptris.len);
+    }
+    atomic_cas_ptr((void **)&mesh_dst->runtime.looptris.array,
+                   mesh_dst->runtime.looptris.array,
+                   mesh_dst->runtime.looptris.array_wip);
+    mesh_dst->runtime.looptris.array_wip = NULL;
+  }
+
+  BLI_mutex_unlock(mesh_eval_mutex);
+}
+
 /* This is a copy of DM_verttri_from_looptri(). */
 void BKE_mesh_runtime_verttri_from_looptri(MVertTri *r_verttri,
                                            const MLoop *mloop,
@@ -189,6 +225,166 @@ void BKE_mesh_runtime_verttri_from_looptri(MVertTri *r_verttri,
   }
 }
 
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Mesh Runtime Topology Maps
+ *
+ * Adjacency maps are expensive to build and many tools (data transfer, skin, paint...) need
+ * the same ones for the same mesh. They are built on demand and kept until the geometry is
+ * cleared. Since they only depend on topology, changing vertex positions keeps them valid.
+ * \{ */
+
+typedef enum eMeshTopologyMapType {
+  MESH_TOPOLOGY_MAP_VERT_POLY = 0,
+  MESH_TOPOLOGY_MAP_VERT_LOOP,
+  MESH_TOPOLOGY_MAP_VERT_EDGE,
+  MESH_TOPOLOGY_MAP_EDGE_POLY,
+} eMeshTopologyMapType;
+#define MESH_TOPOLOGY_MAP_TOT (MESH_TOPOLOGY_MAP_EDGE_POLY + 1)
+
+typedef struct MeshTopologyMaps {
+  /* Topology the maps were built from, used to detect changes that were not followed by
+   * #BKE_mesh_runtime_clear_geometry. */
+  const MEdge *medge;
+  const MPoly *mpoly;
+  const MLoop *mloop;
+  int totvert, totedge, totpoly, totloop;
+
+  struct {
+    MeshElemMap *map;
+    int *mem;
+  } maps[MESH_TOPOLOGY_MAP_TOT];
+} MeshTopologyMaps;
+
+static void mesh_runtime_topology_maps_free(Mesh *mesh)
+{
+  MeshTopologyMaps *topology_maps = mesh->runtime.topology_maps;
+  if (topology_maps == NULL) {
+    return;
+  }
+  for (int i = 0; i < MESH_TOPOLOGY_MAP_TOT; i++) {
+    MEM_SAFE_FREE(topology_maps->maps[i].map);
+    MEM_SAFE_FREE(topology_maps->maps[i].mem);
+  }
+  MEM_freeN(topology_maps);
+  mesh->runtime.topology_maps = NULL;
+}
+
+static bool mesh_runtime_topology_maps_match(const MeshTopologyMaps *topology_maps,
+                                             const Mesh *mesh)
+{
+  return topology_maps->medge == mesh->medge && topology_maps->mpoly == mesh->mpoly &&
+         topology_maps->mloop == mesh->mloop && topology_maps->totvert == mesh->totvert &&
+         topology_maps->totedge == mesh->totedge && topology_maps->totpoly == mesh->totpoly &&
+         topology_maps->totloop == mesh->totloop;
+}
+
+static const MeshElemMap *mesh_runtime_topology_map_ensure(Mesh *mesh,
+                                                           const eMeshTopologyMapType type)
+{
+  ThreadMutex *mesh_eval_mutex = (ThreadMutex *)mesh->runtime.eval_mutex;
+  BLI_mutex_lock(mesh_eval_mutex);
+
+  MeshTopologyMaps *topology_maps = mesh->runtime.topology_maps;
+  if (topology_maps != NULL && !mesh_runtime_topology_maps_match(topology_maps, mesh)) {
+    mesh_runtime_topology_maps_free(mesh);
+    topology_maps = NULL;
+  }
+  if (topology_maps == NULL) {
+    topology_maps = MEM_callocN(sizeof(*topology_maps), __func__);
+    topology_maps->medge = mesh->medge;
+    topology_maps->mpoly = mesh->mpoly;
+    topology_maps->mloop = mesh->mloop;
+    topology_maps->totvert = mesh->totvert;
+    topology_maps->totedge = mesh->totedge;
+    topology_maps->totpoly = mesh->totpoly;
+    topology_maps->totloop = mesh->totloop;
+    mesh->runtime.topology_maps = topology_maps;
+  }
+
+  MeshElemMap **r_map = &topology_maps->maps[type].map;
+  int **r_mem = &topology_maps->maps[type].mem;
+  if (*r_map == NULL) {
+    switch (type) {
+      case MESH_TOPOLOGY_MAP_VERT_POLY:
+        BKE_mesh_vert_poly_map_create(r_map,
+                                      r_mem,
+                                      mesh->mpoly,
+                                      mesh->mloop,
+                                      mesh->totvert,
+                                      mesh->totpoly,
+                                      mesh->totloop);
+        break;
+      case MESH_TOPOLOGY_MAP_VERT_LOOP:
+        BKE_mesh_vert_loop_map_create(r_map,
+                                      r_mem,
+                                      mesh->mpoly,
+                                      mesh->mloop,
+                                      mesh->totvert,
+                                      mesh->totpoly,
+                                      mesh->totloop);
+        break;
+      case MESH_TOPOLOGY_MAP_VERT_EDGE:
+        BKE_mesh_vert_edge_map_create(r_map, r_mem, mesh->medge, mesh->totvert, mesh->totedge);
+        break;
+      case MESH_TOPOLOGY_MAP_EDGE_POLY:
+        BKE_mesh_edge_poly_map_create(r_map,
+                                      r_mem,
+                                      mesh->medge,
+                                      mesh->totedge,
+                                      mesh->mpoly,
+                                      mesh->totpoly,
+                                      mesh->mloop,
+                                      mesh->totloop);
+        break;
+    }
+  }
+  const MeshElemMap *map = *r_map;
+
+  BLI_mutex_unlock(mesh_eval_mutex);
+
+  return map;
+}
+
+/**
+ * Vertex to face map owned by the mesh, it must not be freed by the caller.
+ */
+const MeshElemMap *BKE_mesh_runtime_vert_poly_map_ensure(Mesh *mesh)
+{
+  return mesh_runtime_topology_map_ensure(mesh, MESH_TOPOLOGY_MAP_VERT_POLY);
+}
+
+/**
+ * Vertex to loop map owned by the mesh, it must not be freed by the caller.
+ */
+const MeshElemMap *BKE_mesh_runtime_vert_loop_map_ensure(Mesh *mesh)
+{
+  return mesh_runtime_topology_map_ensure(mesh, MESH_TOPOLOGY_MAP_VERT_LOOP);
+}
+
+/**
+ * Vertex to edge map owned by the mesh, it must not be freed by the caller.
+ */
+const MeshElemMap *BKE_mesh_runtime_vert_edge_map_ensure(Mesh *mesh)
+{
+  return mesh_runtime_topology_map_ensure(mesh, MESH_TOPOLOGY_MAP_VERT_EDGE);
+}
+
+/**
+ * Edge to face map owned by the mesh, it must not be freed by the caller.
+ */
+const MeshElemMap *BKE_mesh_runtime_edge_poly_map_ensure(Mesh *mesh)
+{
+  return mesh_runtime_topology_map_ensure(mesh, MESH_TOPOLOGY_MAP_EDGE_POLY);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Mesh Runtime Edit Data & Geometry
+ * \{ */
+
 bool BKE_mesh_runtime_ensure_edit_data(struct Mesh *mesh)
 {
   if (mesh->runtime.edit_data != NULL) {
@@ -240,6 +436,7 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
     mesh->runtime.subdiv_ccg = NULL;
   }
   BKE_shrinkwrap_discard_boundary_data(mesh);
+  mesh_runtime_topology_maps_free(mesh);
 }
 
 /** \} */
@@ -45,6 +45,41 @@
 #include "atomic_ops.h"
 #include "mikktspace.h"
 
+/* -------------------------------------------------------------------- */
+/** \name Mikktspace Threading
+ * \{ */
+
+typedef struct MikkTSpaceTasks {
+  void (*task)(void *task_data, const int task_index);
+  void *task_data;
+} MikkTSpaceTasks;
+
+static void mikktspace_task_cb(void *__restrict userdata,
+                               const int task_index,
+                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const MikkTSpaceTasks *tasks = userdata;
+  tasks->task(tasks->task_data, task_index);
+}
+
+/* Lets Mikktspace evaluate its triangles and groups from multiple threads. */
+static void mikktspace_run_tasks(const SMikkTSpaceContext *UNUSED(pContext),
+                                 void (*task)(void *task_data, const int task_index),
+                                 void *task_data,
+                                 const int tasks_num)
+{
+  MikkTSpaceTasks tasks = {
+      .task = task,
+      .task_data = task_data,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0, tasks_num, &tasks, mikktspace_task_cb, &settings);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Mesh Tangent Calculations (Single Layer)
  * \{ */
@@ -165,6 +200,7 @@ void BKE_mesh_calc_loop_tangent_single_ex(const MVert *mverts,
   s_interface.m_getTexCoord = get_texture_coordinate;
   s_interface.m_getNormal = get_normal;
   s_interface.m_setTSpaceBasic = set_tspace;
+  s_interface.m_runTasks = mikktspace_run_tasks;
 
   /* 0 if failed */
   if (genTangSpaceDefault(&s_context) == false) {
@@ -468,6 +504,7 @@ static void DM_calc_loop_tangents_thread(TaskPool *__restrict UNUSED(pool), void
     sInterface.m_getTexCoord = dm_ts_GetTextureCoordinate;
     sInterface.m_getNormal = dm_ts_GetNormal;
     sInterface.m_setTSpaceBasic = dm_ts_SetTSpace;
+    sInterface.m_runTasks = mikktspace_run_tasks;
 
     /* 0 if failed */
     genTangSpaceDefault(&sContext);
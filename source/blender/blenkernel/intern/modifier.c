@@ -50,6 +50,7 @@
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
+#include "BLI_profile.h"
 #include "BLI_session_uuid.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.h"
@@ -1019,7 +1020,12 @@ struct Mesh *BKE_modifier_modify_mesh(ModifierData *md,
   if (mti->dependsOnNormals && mti->dependsOnNormals(md)) {
     modwrap_dependsOnNormals(me);
   }
-  return mti->modifyMesh(md, ctx, me);
+
+  ProfileZone profile_zone;
+  BLI_profile_zone_begin(&profile_zone, mti->name, md->name);
+  struct Mesh *result = mti->modifyMesh(md, ctx, me);
+  BLI_profile_zone_end(&profile_zone);
+  return result;
 }
 
 void BKE_modifier_deform_verts(ModifierData *md,
@@ -1034,7 +1040,11 @@ void BKE_modifier_deform_verts(ModifierData *md,
   if (me && mti->dependsOnNormals && mti->dependsOnNormals(md)) {
     modwrap_dependsOnNormals(me);
   }
+
+  ProfileZone profile_zone;
+  BLI_profile_zone_begin(&profile_zone, mti->name, md->name);
   mti->deformVerts(md, ctx, me, vertexCos, numVerts);
+  BLI_profile_zone_end(&profile_zone);
 }
 
 void BKE_modifier_deform_vertsEM(ModifierData *md,
@@ -1050,7 +1060,11 @@ void BKE_modifier_deform_vertsEM(ModifierData *md,
   if (me && mti->dependsOnNormals && mti->dependsOnNormals(md)) {
     BKE_mesh_calc_normals(me);
   }
+
+  ProfileZone profile_zone;
+  BLI_profile_zone_begin(&profile_zone, mti->name, md->name);
   mti->deformVertsEM(md, ctx, em, me, vertexCos, numVerts);
+  BLI_profile_zone_end(&profile_zone);
 }
 
 /* end modifier callback wrappers */
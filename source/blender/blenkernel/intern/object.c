@@ -333,6 +333,8 @@ static void object_free_data(ID *id)
     ob->runtime.curve_cache = NULL;
   }
 
+  BKE_modifier_stage_cache_free(ob);
+
   BKE_previewimg_free(&ob->preview);
 }
 
@@ -4876,6 +4878,7 @@ void BKE_object_runtime_reset_on_copy(Object *object, const int UNUSED(flag))
   runtime->mesh_deform_eval = NULL;
   runtime->curve_cache = NULL;
   runtime->object_as_temp_mesh = NULL;
+  runtime->modifier_stage_cache = NULL;
 }
 
 /**
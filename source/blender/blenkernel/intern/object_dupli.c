@@ -28,6 +28,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_listbase.h"
+#include "BLI_memarena.h"
 #include "BLI_string_utf8.h"
 
 #include "BLI_alloca.h"
@@ -68,6 +69,22 @@
 /** \name Internal Duplicate Context
  * \{ */
 
+/**
+ * Storage of the #ListBase returned by #object_duplilist.
+ *
+ * Instancers can generate millions of duplis, so they are allocated from an arena, and the hashes
+ * of the object names used for their random ID are cached, since most consecutive duplis
+ * instance the same object.
+ */
+typedef struct DupliList {
+  /** Must be first, it is what callers get and pass back to #free_object_duplilist. */
+  ListBase list;
+  MemArena *arena;
+
+  const Object *hash_ob, *hash_instancer;
+  uint hash_ob_name, hash_instancer_name;
+} DupliList;
+
 typedef struct DupliContext {
   Depsgraph *depsgraph;
   /** XXX child objects are selected from this group if set, could be nicer. */
@@ -86,7 +103,7 @@ typedef struct DupliContext {
   const struct DupliGenerator *gen;
 
   /** Result containers. */
-  ListBase *duplilist; /* Legacy doubly-linked list. */
+  DupliList *duplilist; /* Legacy doubly-linked list. */
 } DupliContext;
 
 typedef struct DupliGenerator {
@@ -159,13 +176,17 @@ static DupliObject *make_dupli(const DupliContext *ctx,
                                const float mat[4][4],
                                int index)
 {
+  DupliList *duplilist = ctx->duplilist;
   DupliObject *dob;
   int i;
 
   /* Add a #DupliObject instance to the result container. */
-  if (ctx->duplilist) {
-    dob = MEM_callocN(sizeof(DupliObject), "dupli object");
-    BLI_addtail(ctx->duplilist, dob);
+  if (duplilist) {
+    if (duplilist->arena == NULL) {
+      duplilist->arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
+    }
+    dob = BLI_memarena_calloc(duplilist->arena, sizeof(DupliObject));
+    BLI_addtail(&duplilist->list, dob);
   }
   else {
     return NULL;
@@ -197,7 +218,11 @@ static DupliObject *make_dupli(const DupliContext *ctx,
 
   /* Random number.
    * The logic here is designed to match Cycles. */
-  dob->random_id = BLI_hash_string(dob->ob->id.name + 2);
+  if (duplilist->hash_ob != ob) {
+    duplilist->hash_ob = ob;
+    duplilist->hash_ob_name = BLI_hash_string(ob->id.name + 2);
+  }
+  dob->random_id = duplilist->hash_ob_name;
 
   if (dob->persistent_id[0] != INT_MAX) {
     for (i = 0; i < MAX_DUPLI_RECUR; i++) {
@@ -209,7 +234,11 @@ static DupliObject *make_dupli(const DupliContext *ctx,
   }
 
   if (ctx->object != ob) {
-    dob->random_id ^= BLI_hash_int(BLI_hash_string(ctx->object->id.name + 2));
+    if (duplilist->hash_instancer != ctx->object) {
+      duplilist->hash_instancer = ctx->object;
+      duplilist->hash_instancer_name = BLI_hash_int(BLI_hash_string(ctx->object->id.name + 2));
+    }
+    dob->random_id ^= duplilist->hash_instancer_name;
   }
 
   return dob;
@@ -1520,7 +1549,7 @@ static const DupliGenerator *get_dupli_generator(const DupliContext *ctx)
  */
 ListBase *object_duplilist(Depsgraph *depsgraph, Scene *sce, Object *ob)
 {
-  ListBase *duplilist = MEM_callocN(sizeof(ListBase), "duplilist");
+  DupliList *duplilist = MEM_callocN(sizeof(DupliList), "duplilist");
   DupliContext ctx;
   init_context(&ctx, depsgraph, sce, ob, NULL);
   if (ctx.gen) {
@@ -1528,13 +1557,16 @@ ListBase *object_duplilist(Depsgraph *depsgraph, Scene *sce, Object *ob)
     ctx.gen->make_duplis(&ctx);
   }
 
-  return duplilist;
+  return &duplilist->list;
 }
 
 void free_object_duplilist(ListBase *lb)
 {
-  BLI_freelistN(lb);
-  MEM_freeN(lb);
+  DupliList *duplilist = (DupliList *)lb;
+  if (duplilist->arena != NULL) {
+    BLI_memarena_free(duplilist->arena);
+  }
+  MEM_freeN(duplilist);
 }
 
 /** \} */
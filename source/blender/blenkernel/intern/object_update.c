@@ -345,11 +345,30 @@ void BKE_object_eval_uber_transform(Depsgraph *depsgraph, Object *object)
   BKE_object_eval_proxy_copy(depsgraph, object);
 }
 
+/**
+ * Vertex coordinates of an edit-mesh changed without changes to its topology (transform),
+ * the evaluated meshes wrap the edit-mesh directly so their topology is unchanged too.
+ */
+static bool object_batch_cache_is_deform_only_update(const Mesh *me)
+{
+  const BMEditMesh *em = me->edit_mesh;
+  if (em == NULL || !em->is_deform_only_update) {
+    return false;
+  }
+  const Mesh *me_final = em->mesh_eval_final;
+  const Mesh *me_cage = em->mesh_eval_cage;
+  return (me_final != NULL && me_final->runtime.wrapper_type == ME_WRAPPER_TYPE_BMESH) &&
+         (me_cage == NULL || me_cage->runtime.wrapper_type == ME_WRAPPER_TYPE_BMESH);
+}
+
 void BKE_object_batch_cache_dirty_tag(Object *ob)
 {
   switch (ob->type) {
     case OB_MESH:
-      BKE_mesh_batch_cache_dirty_tag(ob->data, BKE_MESH_BATCH_DIRTY_ALL);
+      BKE_mesh_batch_cache_dirty_tag(ob->data,
+                                     object_batch_cache_is_deform_only_update(ob->data) ?
+                                         BKE_MESH_BATCH_DIRTY_DEFORM :
+                                         BKE_MESH_BATCH_DIRTY_ALL);
       break;
     case OB_LATTICE:
       BKE_lattice_batch_cache_dirty_tag(ob->data, BKE_LATTICE_BATCH_DIRTY_ALL);
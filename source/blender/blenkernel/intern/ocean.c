@@ -1372,19 +1372,104 @@ void BKE_ocean_simulate_cache(struct OceanCache *och, int frame)
   och->ibufs_norm[f] = IMB_loadiffname(string, 0, NULL);
 }
 
-void BKE_ocean_bake(struct Ocean *o,
-                    struct OceanCache *och,
-                    void (*update_cb)(void *, float progress, int *cancel),
-                    void *update_cb_data)
-{
+typedef struct OceanBakeData {
+  struct Ocean *o;
+  struct OceanCache *och;
+  float *prev_foam;
+  bool use_prev_foam;
+  ImBuf *ibuf_foam, *ibuf_disp, *ibuf_normal, *ibuf_spray, *ibuf_spray_inverse;
+} OceanBakeData;
+
+static void ocean_bake_row_cb(void *__restrict userdata,
+                              const int y,
+                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const OceanBakeData *data = userdata;
+  struct Ocean *o = data->o;
+  struct OceanCache *och = data->och;
+  float *prev_foam = data->prev_foam;
+  ImBuf *ibuf_foam = data->ibuf_foam;
+  ImBuf *ibuf_disp = data->ibuf_disp;
+  ImBuf *ibuf_normal = data->ibuf_normal;
+  ImBuf *ibuf_spray = data->ibuf_spray;
+  ImBuf *ibuf_spray_inverse = data->ibuf_spray_inverse;
+  const int res_x = och->resolution_x;
   /* note: some of these values remain uninitialized unless certain options
    * are enabled, take care that BKE_ocean_eval_ij() initializes a member
    * before use - campbell */
   OceanResult ocr;
 
+  for (int x = 0; x < res_x; x++) {
+    BKE_ocean_eval_ij(o, &ocr, x, y);
+
+    /* add to the image */
+    rgb_to_rgba_unit_alpha(&ibuf_disp->rect_float[4 * (res_x * y + x)], ocr.disp);
+
+    if (o->_do_jacobian) {
+      /* TODO, cleanup unused code - campbell */
+
+      float /*r, */ /* UNUSED */ pr = 0.0f, foam_result;
+      float neg_disp, neg_eplus;
+
+      ocr.foam = BKE_ocean_jminus_to_foam(ocr.Jminus, och->foam_coverage);
+
+      /* accumulate previous value for this cell */
+      if (data->use_prev_foam) {
+        pr = prev_foam[res_x * y + x];
+      }
+
+      /* r = BLI_rng_get_float(rng); */ /* UNUSED */ /* randomly reduce foam */
+
+      /* pr = pr * och->foam_fade; */ /* overall fade */
+
+      /* Remember ocean coord sys is Y up!
+       * break up the foam where height (Y) is low (wave valley),
+       * and X and Z displacement is greatest. */
+
+      neg_disp = ocr.disp[1] < 0.0f ? 1.0f + ocr.disp[1] : 1.0f;
+      neg_disp = neg_disp < 0.0f ? 0.0f : neg_disp;
+
+      /* foam, 'ocr.Eplus' only initialized with do_jacobian */
+      neg_eplus = ocr.Eplus[2] < 0.0f ? 1.0f + ocr.Eplus[2] : 1.0f;
+      neg_eplus = neg_eplus < 0.0f ? 0.0f : neg_eplus;
+
+      if (pr < 1.0f) {
+        pr *= pr;
+      }
+
+      pr *= och->foam_fade * (0.75f + neg_eplus * 0.25f);
+
+      /* A full clamping should not be needed! */
+      foam_result = min_ff(pr + ocr.foam, 1.0f);
+
+      prev_foam[res_x * y + x] = foam_result;
+
+      /*foam_result = min_ff(foam_result, 1.0f); */
+
+      value_to_rgba_unit_alpha(&ibuf_foam->rect_float[4 * (res_x * y + x)], foam_result);
+
+      /* spray map baking */
+      if (o->_do_spray) {
+        rgb_to_rgba_unit_alpha(&ibuf_spray->rect_float[4 * (res_x * y + x)], ocr.Eplus);
+        rgb_to_rgba_unit_alpha(&ibuf_spray_inverse->rect_float[4 * (res_x * y + x)],
+                               ocr.Eminus);
+      }
+    }
+
+    if (o->_do_normals) {
+      rgb_to_rgba_unit_alpha(&ibuf_normal->rect_float[4 * (res_x * y + x)], ocr.normal);
+    }
+  }
+}
+
+void BKE_ocean_bake(struct Ocean *o,
+                    struct OceanCache *och,
+                    void (*update_cb)(void *, float progress, int *cancel),
+                    void *update_cb_data)
+{
   ImageFormatData imf = {0};
 
-  int f, i = 0, x, y, cancel = 0;
+  int f, i = 0, cancel = 0;
   float progress;
 
   ImBuf *ibuf_foam, *ibuf_disp, *ibuf_normal, *ibuf_spray, *ibuf_spray_inverse;
@@ -1424,70 +1509,21 @@ void BKE_ocean_bake(struct Ocean *o,
     BKE_ocean_simulate(o, och->time[i], och->wave_scale, och->chop_amount);
 
     /* add new foam */
-    for (y = 0; y < res_y; y++) {
-      for (x = 0; x < res_x; x++) {
-
-        BKE_ocean_eval_ij(o, &ocr, x, y);
-
-        /* add to the image */
-        rgb_to_rgba_unit_alpha(&ibuf_disp->rect_float[4 * (res_x * y + x)], ocr.disp);
-
-        if (o->_do_jacobian) {
-          /* TODO, cleanup unused code - campbell */
-
-          float /*r, */ /* UNUSED */ pr = 0.0f, foam_result;
-          float neg_disp, neg_eplus;
-
-          ocr.foam = BKE_ocean_jminus_to_foam(ocr.Jminus, och->foam_coverage);
-
-          /* accumulate previous value for this cell */
-          if (i > 0) {
-            pr = prev_foam[res_x * y + x];
-          }
-
-          /* r = BLI_rng_get_float(rng); */ /* UNUSED */ /* randomly reduce foam */
-
-          /* pr = pr * och->foam_fade; */ /* overall fade */
-
-          /* Remember ocean coord sys is Y up!
-           * break up the foam where height (Y) is low (wave valley),
-           * and X and Z displacement is greatest. */
-
-          neg_disp = ocr.disp[1] < 0.0f ? 1.0f + ocr.disp[1] : 1.0f;
-          neg_disp = neg_disp < 0.0f ? 0.0f : neg_disp;
-
-          /* foam, 'ocr.Eplus' only initialized with do_jacobian */
-          neg_eplus = ocr.Eplus[2] < 0.0f ? 1.0f + ocr.Eplus[2] : 1.0f;
-          neg_eplus = neg_eplus < 0.0f ? 0.0f : neg_eplus;
-
-          if (pr < 1.0f) {
-            pr *= pr;
-          }
-
-          pr *= och->foam_fade * (0.75f + neg_eplus * 0.25f);
-
-          /* A full clamping should not be needed! */
-          foam_result = min_ff(pr + ocr.foam, 1.0f);
-
-          prev_foam[res_x * y + x] = foam_result;
-
-          /*foam_result = min_ff(foam_result, 1.0f); */
-
-          value_to_rgba_unit_alpha(&ibuf_foam->rect_float[4 * (res_x * y + x)], foam_result);
-
-          /* spray map baking */
-          if (o->_do_spray) {
-            rgb_to_rgba_unit_alpha(&ibuf_spray->rect_float[4 * (res_x * y + x)], ocr.Eplus);
-            rgb_to_rgba_unit_alpha(&ibuf_spray_inverse->rect_float[4 * (res_x * y + x)],
-                                   ocr.Eminus);
-          }
-        }
-
-        if (o->_do_normals) {
-          rgb_to_rgba_unit_alpha(&ibuf_normal->rect_float[4 * (res_x * y + x)], ocr.normal);
-        }
-      }
-    }
+    OceanBakeData data = {
+        .o = o,
+        .och = och,
+        .prev_foam = prev_foam,
+        .use_prev_foam = (i > 0),
+        .ibuf_foam = ibuf_foam,
+        .ibuf_disp = ibuf_disp,
+        .ibuf_normal = ibuf_normal,
+        .ibuf_spray = ibuf_spray,
+        .ibuf_spray_inverse = ibuf_spray_inverse,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (res_y > 16);
+    BLI_task_parallel_range(0, res_y, &data, ocean_bake_row_cb, &settings);
 
     /* write the images */
     cache_filename(string, och->bakepath, och->relbase, f, CACHE_TYPE_DISPLACE);
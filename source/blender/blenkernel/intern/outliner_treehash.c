@@ -73,9 +73,9 @@ static void tse_group_remove_element(TseGroup *tse_group, TreeStoreElem *elem)
   BLI_assert(tse_group->size >= 0);
   for (int i = 0; i < tse_group->size; i++) {
     if (tse_group->elems[i] == elem) {
-      memcpy(tse_group->elems[i],
-             tse_group->elems[i + 1],
-             (tse_group->size - (i + 1)) * sizeof(TreeStoreElem *));
+      memmove(&tse_group->elems[i],
+              &tse_group->elems[i + 1],
+              (tse_group->size - i) * sizeof(TreeStoreElem *));
       break;
     }
   }
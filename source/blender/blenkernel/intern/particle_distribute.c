@@ -876,6 +876,44 @@ static void distribute_invalid(ParticleSimulationData *sim, int from)
   }
 }
 
+typedef struct DistributeAreaData {
+  Mesh *mesh;
+  float (*orcodata)[3];
+  /* Texture space of the original mesh, used to transform the orcos to object space. */
+  float loc[3], size[3];
+  float *element_weight;
+} DistributeAreaData;
+
+static void distribute_element_area_cb(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DistributeAreaData *data = userdata;
+  const MFace *mf = &data->mesh->mface[i];
+  float co1[3], co2[3], co3[3], co4[3];
+
+  if (data->orcodata) {
+    madd_v3_v3v3v3(co1, data->loc, data->orcodata[mf->v1], data->size);
+    madd_v3_v3v3v3(co2, data->loc, data->orcodata[mf->v2], data->size);
+    madd_v3_v3v3v3(co3, data->loc, data->orcodata[mf->v3], data->size);
+    if (mf->v4) {
+      madd_v3_v3v3v3(co4, data->loc, data->orcodata[mf->v4], data->size);
+    }
+  }
+  else {
+    const MVert *mvert = data->mesh->mvert;
+    copy_v3_v3(co1, mvert[mf->v1].co);
+    copy_v3_v3(co2, mvert[mf->v2].co);
+    copy_v3_v3(co3, mvert[mf->v3].co);
+    if (mf->v4) {
+      copy_v3_v3(co4, mvert[mf->v4].co);
+    }
+  }
+
+  data->element_weight[i] = mf->v4 ? area_quad_v3(co1, co2, co3, co4) :
+                                     area_tri_v3(co1, co2, co3);
+}
+
 /* Creates a distribution of coordinates on a Mesh */
 static int psys_thread_context_init_distribute(ParticleThreadContext *ctx,
                                                ParticleSimulationData *sim,
@@ -1051,48 +1089,30 @@ static int psys_thread_context_init_distribute(ParticleThreadContext *ctx,
 
   /* Calculate weights from face areas */
   if ((part->flag & PART_EDISTR || children) && from != PART_FROM_VERT) {
-    MVert *v1, *v2, *v3, *v4;
-    float totarea = 0.0f, co1[3], co2[3], co3[3], co4[3];
-    float(*orcodata)[3];
+    float totarea = 0.0f;
+    DistributeAreaData area_data = {
+        .mesh = mesh,
+        .orcodata = CustomData_get_layer(&mesh->vdata, CD_ORCO),
+        .element_weight = element_weight,
+    };
+
+    if (area_data.orcodata) {
+      /* Transform orcos from normalized 0..1 to object space. */
+      Mesh *me = ob->data;
+      BKE_mesh_texspace_get(me->texcomesh ? me->texcomesh : me, area_data.loc, area_data.size);
+    }
 
-    orcodata = CustomData_get_layer(&mesh->vdata, CD_ORCO);
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1024;
+    BLI_task_parallel_range(0, totelem, &area_data, distribute_element_area_cb, &settings);
 
+    /* Accumulate in order, so the result doesn't depend on the threading. */
     for (i = 0; i < totelem; i++) {
-      MFace *mf = &mesh->mface[i];
-
-      if (orcodata) {
-        /* Transform orcos from normalized 0..1 to object space. */
-        copy_v3_v3(co1, orcodata[mf->v1]);
-        copy_v3_v3(co2, orcodata[mf->v2]);
-        copy_v3_v3(co3, orcodata[mf->v3]);
-        BKE_mesh_orco_verts_transform(ob->data, &co1, 1, 1);
-        BKE_mesh_orco_verts_transform(ob->data, &co2, 1, 1);
-        BKE_mesh_orco_verts_transform(ob->data, &co3, 1, 1);
-        if (mf->v4) {
-          copy_v3_v3(co4, orcodata[mf->v4]);
-          BKE_mesh_orco_verts_transform(ob->data, &co4, 1, 1);
-        }
-      }
-      else {
-        v1 = &mesh->mvert[mf->v1];
-        v2 = &mesh->mvert[mf->v2];
-        v3 = &mesh->mvert[mf->v3];
-        copy_v3_v3(co1, v1->co);
-        copy_v3_v3(co2, v2->co);
-        copy_v3_v3(co3, v3->co);
-        if (mf->v4) {
-          v4 = &mesh->mvert[mf->v4];
-          copy_v3_v3(co4, v4->co);
-        }
-      }
-
-      cur = mf->v4 ? area_quad_v3(co1, co2, co3, co4) : area_tri_v3(co1, co2, co3);
-
+      cur = element_weight[i];
       if (cur > maxweight) {
         maxweight = cur;
       }
-
-      element_weight[i] = cur;
       totarea += cur;
     }
 
@@ -1335,24 +1335,27 @@ static void psys_update_particle_bvhtree(ParticleSystem *psys, float cfra)
         totpart++;
       }
 
-      BLI_rw_mutex_lock(&psys_bvhtree_rwlock, THREAD_LOCK_WRITE);
-
-      BLI_bvhtree_free(psys->bvhtree);
-      psys->bvhtree = BLI_bvhtree_new(totpart, 0.0, 4, 6);
+      /* Build the new tree before locking,
+       * so other particle systems can keep querying the old one meanwhile. */
+      BVHTree *bvhtree = BLI_bvhtree_new(totpart, 0.0, 4, 6);
 
       LOOP_SHOWN_PARTICLES
       {
         if (pa->alive == PARS_ALIVE) {
           if (pa->state.time == cfra) {
-            BLI_bvhtree_insert(psys->bvhtree, p, pa->prev_state.co, 1);
+            BLI_bvhtree_insert(bvhtree, p, pa->prev_state.co, 1);
           }
           else {
-            BLI_bvhtree_insert(psys->bvhtree, p, pa->state.co, 1);
+            BLI_bvhtree_insert(bvhtree, p, pa->state.co, 1);
           }
         }
       }
-      BLI_bvhtree_balance(psys->bvhtree);
+      BLI_bvhtree_balance(bvhtree);
 
+      BLI_rw_mutex_lock(&psys_bvhtree_rwlock, THREAD_LOCK_WRITE);
+
+      BLI_bvhtree_free(psys->bvhtree);
+      psys->bvhtree = bvhtree;
       psys->bvhtree_frame = cfra;
 
       BLI_rw_mutex_unlock(&psys_bvhtree_rwlock);
@@ -1698,22 +1701,29 @@ static void sph_evaluate_func(BVHTree *tree,
 
   pfr->tot_neighbors = 0;
 
-  for (i = 0; i < 10 && psys[i]; i++) {
-    pfr->npsys = psys[i];
-    pfr->massfac = psys[i]->part->mass / pfr->mass;
-    pfr->use_size = psys[i]->part->flag & PART_SIZEMASS;
+  if (tree) {
+    if (psys[0]) {
+      pfr->npsys = psys[0];
+      pfr->massfac = psys[0]->part->mass / pfr->mass;
+      pfr->use_size = psys[0]->part->flag & PART_SIZEMASS;
 
-    if (tree) {
       BLI_bvhtree_range_query(tree, co, interaction_radius, callback, pfr);
-      break;
     }
+    return;
+  }
 
-    BLI_rw_mutex_lock(&psys_bvhtree_rwlock, THREAD_LOCK_READ);
+  /* Lock once for all particle systems, this is called for every particle. */
+  BLI_rw_mutex_lock(&psys_bvhtree_rwlock, THREAD_LOCK_READ);
 
-    BLI_bvhtree_range_query(psys[i]->bvhtree, co, interaction_radius, callback, pfr);
+  for (i = 0; i < 10 && psys[i]; i++) {
+    pfr->npsys = psys[i];
+    pfr->massfac = psys[i]->part->mass / pfr->mass;
+    pfr->use_size = psys[i]->part->flag & PART_SIZEMASS;
 
-    BLI_rw_mutex_unlock(&psys_bvhtree_rwlock);
+    BLI_bvhtree_range_query(psys[i]->bvhtree, co, interaction_radius, callback, pfr);
   }
+
+  BLI_rw_mutex_unlock(&psys_bvhtree_rwlock);
 }
 static void sph_density_accum_cb(void *userdata, int index, const float co[3], float squared_dist)
 {
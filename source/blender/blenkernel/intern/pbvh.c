@@ -250,56 +250,52 @@ void pbvh_grow_nodes(PBVH *pbvh, int totnode)
   pbvh->totnode = totnode;
 }
 
-/* Add a vertex to the map, with a positive value for unique vertices and
- * a negative value for additional vertices */
-static int map_insert_vert(
-    PBVH *pbvh, GHash *map, unsigned int *face_verts, unsigned int *uniq_verts, int vertex)
+static int pbvh_compare_ints(const void *a_v, const void *b_v)
 {
-  void *key, **value_p;
+  const int a = *(const int *)a_v;
+  const int b = *(const int *)b_v;
+  return (a > b) - (a < b);
+}
+
+/* Vertices claimed by the node are stored bit-inverted in its temporary vertex list. */
+BLI_INLINE int leaf_vert_decode(const int vert)
+{
+  return (vert < 0) ? ~vert : vert;
+}
 
-  key = POINTER_FROM_INT(vertex);
-  if (!BLI_ghash_ensure_p(map, key, &value_p)) {
-    int value_i;
-    if (BLI_BITMAP_TEST(pbvh->vert_bitmap, vertex) == 0) {
-      BLI_BITMAP_ENABLE(pbvh->vert_bitmap, vertex);
-      value_i = *uniq_verts;
-      (*uniq_verts)++;
+static int leaf_vert_find(const int *verts, const int verts_num, const int vert)
+{
+  int lo = 0, hi = verts_num - 1;
+  while (lo < hi) {
+    const int mid = (lo + hi) / 2;
+    if (leaf_vert_decode(verts[mid]) < vert) {
+      lo = mid + 1;
     }
     else {
-      value_i = ~(*face_verts);
-      (*face_verts)++;
+      hi = mid;
     }
-    *value_p = POINTER_FROM_INT(value_i);
-    return value_i;
   }
-
-  return POINTER_AS_INT(*value_p);
+  BLI_assert(leaf_vert_decode(verts[lo]) == vert);
+  return lo;
 }
 
-/* Find vertices used by the faces in this node and update the draw buffers */
-static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
+/* First pass of building a mesh leaf: gather the sorted list of distinct vertices used by the
+ * faces in this node, instead of a hash map, so leaves can be built in parallel. The list is
+ * stored in `vert_indices` until the vertices are claimed, see #build_mesh_leaf_claim_verts. */
+static void build_mesh_leaf_node_verts(PBVH *pbvh, PBVHNode *node)
 {
   bool has_visible = false;
-
-  node->uniq_verts = node->face_verts = 0;
   const int totface = node->totprim;
 
-  /* reserve size is rough guess */
-  GHash *map = BLI_ghash_int_new_ex("build_mesh_leaf_node gh", 2 * totface);
-
-  int(*face_vert_indices)[3] = MEM_mallocN(sizeof(int[3]) * totface, "bvh node face vert indices");
-
-  node->face_vert_indices = (const int(*)[3])face_vert_indices;
-
   if (pbvh->respect_hide == false) {
     has_visible = true;
   }
 
+  int *verts = MEM_mallocN(sizeof(int[3]) * totface, "bvh node vert indices");
   for (int i = 0; i < totface; i++) {
     const MLoopTri *lt = &pbvh->looptri[node->prim_indices[i]];
     for (int j = 0; j < 3; j++) {
-      face_vert_indices[i][j] = map_insert_vert(
-          pbvh, map, &node->face_verts, &node->uniq_verts, pbvh->mloop[lt->tri[j]].v);
+      verts[i * 3 + j] = pbvh->mloop[lt->tri[j]].v;
     }
 
     if (has_visible == false) {
@@ -309,38 +305,77 @@ static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
     }
   }
 
-  int *vert_indices = MEM_callocN(sizeof(int) * (node->uniq_verts + node->face_verts),
-                                  "bvh node vert indices");
-  node->vert_indices = vert_indices;
+  qsort(verts, (size_t)totface * 3, sizeof(int), pbvh_compare_ints);
+  int verts_num = 0;
+  for (int i = 0; i < totface * 3; i++) {
+    if (verts_num == 0 || verts[verts_num - 1] != verts[i]) {
+      verts[verts_num++] = verts[i];
+    }
+  }
 
-  /* Build the vertex list, unique verts first */
-  GHashIterator gh_iter;
-  GHASH_ITER (gh_iter, map) {
-    void *value = BLI_ghashIterator_getValue(&gh_iter);
-    int ndx = POINTER_AS_INT(value);
+  node->vert_indices = MEM_reallocN(verts, sizeof(int) * verts_num);
+  node->uniq_verts = verts_num;
+  node->face_verts = 0;
 
-    if (ndx < 0) {
-      ndx = -ndx + node->uniq_verts - 1;
-    }
+  BKE_pbvh_node_mark_rebuild_draw(node);
+
+  BKE_pbvh_node_fully_hidden_set(node, !has_visible);
+}
+
+/* Every vertex is unique to the first leaf using it, done in node order so the result doesn't
+ * depend on the threading. */
+static void build_mesh_leaf_claim_verts(PBVH *pbvh, PBVHNode *node)
+{
+  int *verts = (int *)node->vert_indices;
 
-    vert_indices[ndx] = POINTER_AS_INT(BLI_ghashIterator_getKey(&gh_iter));
+  for (int i = 0; i < node->uniq_verts; i++) {
+    if (BLI_BITMAP_TEST(pbvh->vert_bitmap, verts[i]) == 0) {
+      BLI_BITMAP_ENABLE(pbvh->vert_bitmap, verts[i]);
+      verts[i] = ~verts[i];
+    }
   }
+}
 
-  for (int i = 0; i < totface; i++) {
-    const int sides = 3;
+/* Final pass of building a mesh leaf: order the vertex list with the unique vertices first and
+ * create the per face vertex indices into it. */
+static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
+{
+  const int *verts = node->vert_indices;
+  const int verts_num = node->uniq_verts;
+  const int totface = node->totprim;
 
-    for (int j = 0; j < sides; j++) {
-      if (face_vert_indices[i][j] < 0) {
-        face_vert_indices[i][j] = -face_vert_indices[i][j] + node->uniq_verts - 1;
-      }
+  int uniq_verts = 0;
+  for (int i = 0; i < verts_num; i++) {
+    if (verts[i] < 0) {
+      uniq_verts++;
     }
   }
 
-  BKE_pbvh_node_mark_rebuild_draw(node);
+  int *vert_indices = MEM_mallocN(sizeof(int) * verts_num, "bvh node vert indices");
+  int *vert_remap = MEM_mallocN(sizeof(int) * verts_num, __func__);
+  int uniq_index = 0, face_index = uniq_verts;
+  for (int i = 0; i < verts_num; i++) {
+    const int dst = (verts[i] < 0) ? uniq_index++ : face_index++;
+    vert_indices[dst] = leaf_vert_decode(verts[i]);
+    vert_remap[i] = dst;
+  }
 
-  BKE_pbvh_node_fully_hidden_set(node, !has_visible);
+  int(*face_vert_indices)[3] = MEM_mallocN(sizeof(int[3]) * totface, "bvh node face vert indices");
+  for (int i = 0; i < totface; i++) {
+    const MLoopTri *lt = &pbvh->looptri[node->prim_indices[i]];
+    for (int j = 0; j < 3; j++) {
+      face_vert_indices[i][j] = vert_remap[leaf_vert_find(
+          verts, verts_num, pbvh->mloop[lt->tri[j]].v)];
+    }
+  }
 
-  BLI_ghash_free(map, NULL, NULL);
+  MEM_freeN((void *)verts);
+  MEM_freeN(vert_remap);
+
+  node->vert_indices = vert_indices;
+  node->face_vert_indices = (const int(*)[3])face_vert_indices;
+  node->uniq_verts = uniq_verts;
+  node->face_verts = verts_num - uniq_verts;
 }
 
 static void update_vb(PBVH *pbvh, PBVHNode *node, BBC *prim_bbc, int offset, int count)
@@ -423,12 +458,7 @@ static void build_leaf(PBVH *pbvh, int node_index, BBC *prim_bbc, int offset, in
   /* Still need vb for searches */
   update_vb(pbvh, &pbvh->nodes[node_index], prim_bbc, offset, count);
 
-  if (pbvh->looptri) {
-    build_mesh_leaf_node(pbvh, pbvh->nodes + node_index);
-  }
-  else {
-    build_grid_leaf_node(pbvh, pbvh->nodes + node_index);
-  }
+  /* The leaf data is filled in by #pbvh_build_leaves once the whole tree is known. */
 }
 
 /* Return zero if all primitives in the node can be drawn with the
@@ -531,6 +561,63 @@ static void build_sub(PBVH *pbvh, int node_index, BB *cb, BBC *prim_bbc, int off
             offset + count - end);
 }
 
+typedef struct PBVHBuildLeavesData {
+  PBVH *pbvh;
+  PBVHNode **leaves;
+} PBVHBuildLeavesData;
+
+static void pbvh_build_leaf_verts_task_cb(void *__restrict userdata,
+                                          const int n,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVHBuildLeavesData *data = userdata;
+
+  if (data->pbvh->looptri) {
+    build_mesh_leaf_node_verts(data->pbvh, data->leaves[n]);
+  }
+  else {
+    build_grid_leaf_node(data->pbvh, data->leaves[n]);
+  }
+}
+
+static void pbvh_build_leaf_task_cb(void *__restrict userdata,
+                                    const int n,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVHBuildLeavesData *data = userdata;
+  build_mesh_leaf_node(data->pbvh, data->leaves[n]);
+}
+
+/* Leaves are independent of each other, except for which one owns the vertices they share. */
+static void pbvh_build_leaves(PBVH *pbvh)
+{
+  PBVHNode **leaves = MEM_mallocN(sizeof(*leaves) * pbvh->totnode, __func__);
+  int totleaf = 0;
+  for (int i = 0; i < pbvh->totnode; i++) {
+    if (pbvh->nodes[i].flag & PBVH_Leaf) {
+      leaves[totleaf++] = &pbvh->nodes[i];
+    }
+  }
+
+  PBVHBuildLeavesData data = {
+      .pbvh = pbvh,
+      .leaves = leaves,
+  };
+
+  TaskParallelSettings settings;
+  BKE_pbvh_parallel_range_settings(&settings, true, totleaf);
+  BLI_task_parallel_range(0, totleaf, &data, pbvh_build_leaf_verts_task_cb, &settings);
+
+  if (pbvh->looptri) {
+    for (int i = 0; i < totleaf; i++) {
+      build_mesh_leaf_claim_verts(pbvh, leaves[i]);
+    }
+    BLI_task_parallel_range(0, totleaf, &data, pbvh_build_leaf_task_cb, &settings);
+  }
+
+  MEM_freeN(leaves);
+}
+
 static void pbvh_build(PBVH *pbvh, BB *cb, BBC *prim_bbc, int totprim)
 {
   if (totprim != pbvh->totprim) {
@@ -554,6 +641,75 @@ static void pbvh_build(PBVH *pbvh, BB *cb, BBC *prim_bbc, int totprim)
 
   pbvh->totnode = 1;
   build_sub(pbvh, 0, cb, prim_bbc, 0, totprim);
+  pbvh_build_leaves(pbvh);
+}
+
+typedef struct PBVHPrimBoundsData {
+  PBVH *pbvh;
+  BBC *prim_bbc;
+} PBVHPrimBoundsData;
+
+static void pbvh_mesh_prim_bounds_task_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict tls)
+{
+  PBVHPrimBoundsData *data = userdata;
+  PBVH *pbvh = data->pbvh;
+  const MLoopTri *lt = &pbvh->looptri[i];
+  const int sides = 3;
+  BBC *bbc = data->prim_bbc + i;
+
+  BB_reset((BB *)bbc);
+
+  for (int j = 0; j < sides; j++) {
+    BB_expand((BB *)bbc, pbvh->verts[pbvh->mloop[lt->tri[j]].v].co);
+  }
+
+  BBC_update_centroid(bbc);
+
+  BB_expand((BB *)tls->userdata_chunk, bbc->bcentroid);
+}
+
+static void pbvh_grids_prim_bounds_task_cb(void *__restrict userdata,
+                                           const int i,
+                                           const TaskParallelTLS *__restrict tls)
+{
+  PBVHPrimBoundsData *data = userdata;
+  const CCGKey *key = &data->pbvh->gridkey;
+  CCGElem *grid = data->pbvh->grids[i];
+  BBC *bbc = data->prim_bbc + i;
+
+  BB_reset((BB *)bbc);
+
+  for (int j = 0; j < key->grid_area; j++) {
+    BB_expand((BB *)bbc, CCG_elem_offset_co(key, grid, j));
+  }
+
+  BBC_update_centroid(bbc);
+
+  BB_expand((BB *)tls->userdata_chunk, bbc->bcentroid);
+}
+
+static void pbvh_prim_bounds_reduce(const void *__restrict UNUSED(userdata),
+                                    void *__restrict chunk_join,
+                                    void *__restrict chunk)
+{
+  BB_expand_with_bb((BB *)chunk_join, (BB *)chunk);
+}
+
+/* Compute the bounds of every primitive, and the bounds of their centroids in \a r_cb. */
+static void pbvh_calc_prim_bounds(PBVHPrimBoundsData *data,
+                                  const int totprim,
+                                  TaskParallelRangeFunc func,
+                                  BB *r_cb)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  settings.userdata_chunk = r_cb;
+  settings.userdata_chunk_size = sizeof(*r_cb);
+  settings.func_reduce = pbvh_prim_bounds_reduce;
+  BLI_task_parallel_range(0, totprim, data, func, &settings);
 }
 
 /**
@@ -598,21 +754,11 @@ void BKE_pbvh_build_mesh(PBVH *pbvh,
   /* For each face, store the AABB and the AABB centroid */
   prim_bbc = MEM_mallocN(sizeof(BBC) * looptri_num, "prim_bbc");
 
-  for (int i = 0; i < looptri_num; i++) {
-    const MLoopTri *lt = &looptri[i];
-    const int sides = 3;
-    BBC *bbc = prim_bbc + i;
-
-    BB_reset((BB *)bbc);
-
-    for (int j = 0; j < sides; j++) {
-      BB_expand((BB *)bbc, verts[pbvh->mloop[lt->tri[j]].v].co);
-    }
-
-    BBC_update_centroid(bbc);
-
-    BB_expand(&cb, bbc->bcentroid);
-  }
+  PBVHPrimBoundsData data = {
+      .pbvh = pbvh,
+      .prim_bbc = prim_bbc,
+  };
+  pbvh_calc_prim_bounds(&data, looptri_num, pbvh_mesh_prim_bounds_task_cb, &cb);
 
   if (looptri_num) {
     pbvh_build(pbvh, &cb, prim_bbc, looptri_num);
@@ -648,20 +794,11 @@ void BKE_pbvh_build_grids(PBVH *pbvh,
   /* For each grid, store the AABB and the AABB centroid */
   BBC *prim_bbc = MEM_mallocN(sizeof(BBC) * totgrid, "prim_bbc");
 
-  for (int i = 0; i < totgrid; i++) {
-    CCGElem *grid = grids[i];
-    BBC *bbc = prim_bbc + i;
-
-    BB_reset((BB *)bbc);
-
-    for (int j = 0; j < gridsize * gridsize; j++) {
-      BB_expand((BB *)bbc, CCG_elem_offset_co(key, grid, j));
-    }
-
-    BBC_update_centroid(bbc);
-
-    BB_expand(&cb, bbc->bcentroid);
-  }
+  PBVHPrimBoundsData data = {
+      .pbvh = pbvh,
+      .prim_bbc = prim_bbc,
+  };
+  pbvh_calc_prim_bounds(&data, totgrid, pbvh_grids_prim_bounds_task_cb, &cb);
 
   if (totgrid) {
     pbvh_build(pbvh, &cb, prim_bbc, totgrid);
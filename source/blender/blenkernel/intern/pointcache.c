@@ -44,6 +44,7 @@
 #include "DNA_simulation_types.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_compress.h"
 #include "BLI_endian_switch.h"
 #include "BLI_math.h"
 #include "BLI_string.h"
@@ -1550,6 +1551,9 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, unsigned char *result,
         r = LzmaUncompress(result, &leno, in, &leni, props, sizeOfIt);
       }
 #endif
+      if (compressed == PTCACHE_COMPRESS_ZLIB_PARALLEL) {
+        r = (BLI_decompress_mem(in, in_len, result, len) == len) ? 0 : 1;
+      }
       MEM_freeN(in);
     }
   }
@@ -1570,8 +1574,6 @@ static int ptcache_file_compressed_write(
   unsigned char *props = MEM_callocN(sizeof(char[16]), "tmp");
   size_t sizeOfIt = 5;
 
-  (void)mode; /* unused when building w/o compression */
-
 #ifdef WITH_LZO
   out_len = LZO_OUT_LEN(in_len);
   if (mode == 1) {
@@ -1611,6 +1613,18 @@ static int ptcache_file_compressed_write(
     }
   }
 #endif
+  if (mode == PTCACHE_COMPRESS_ZLIB_PARALLEL) {
+    /* Blocks are compressed in parallel, see #BLI_compress_blocks. */
+    void *compressed_buf = BLI_compress_mem(in, in_len, 1, &out_len);
+    if (compressed_buf == NULL || (out_len >= in_len)) {
+      compressed = 0;
+    }
+    else {
+      memcpy(out, compressed_buf, out_len);
+      compressed = PTCACHE_COMPRESS_ZLIB_PARALLEL;
+    }
+    MEM_SAFE_FREE(compressed_buf);
+  }
 
   ptcache_file_write(pf, &compressed, 1, sizeof(unsigned char));
   if (compressed) {
@@ -1640,32 +1654,6 @@ static int ptcache_file_write(PTCacheFile *pf, const void *f, unsigned int tot,
 {
   return (fwrite(f, size, tot, pf->fp) == tot);
 }
-static int ptcache_file_data_read(PTCacheFile *pf)
-{
-  int i;
-
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    if ((pf->data_types & (1 << i)) &&
-        !ptcache_file_read(pf, pf->cur[i], 1, ptcache_data_size[i])) {
-      return 0;
-    }
-  }
-
-  return 1;
-}
-static int ptcache_file_data_write(PTCacheFile *pf)
-{
-  int i;
-
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    if ((pf->data_types & (1 << i)) &&
-        !ptcache_file_write(pf, pf->cur[i], 1, ptcache_data_size[i])) {
-      return 0;
-    }
-  }
-
-  return 1;
-}
 static int ptcache_file_header_begin_read(PTCacheFile *pf)
 {
   unsigned int typeflag = 0;
@@ -1832,18 +1820,82 @@ static void ptcache_data_free(PTCacheMem *pm)
     }
   }
 }
-static void ptcache_data_copy(void *from[], void *to[])
+
+/* Size of the data of one point in an uncompressed file, the data types are interleaved. */
+static unsigned int ptcache_file_data_point_size(unsigned int data_types)
 {
-  int i;
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    /* note, durian file 03.4b_comp crashes if to[i] is not tested
-     * its NULL, not sure if this should be fixed elsewhere but for now its needed */
-    if (from[i] && to[i]) {
-      memcpy(to[i], from[i], ptcache_data_size[i]);
+  unsigned int size = 0;
+  for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+    if (data_types & (1 << i)) {
+      size += ptcache_data_size[i];
     }
   }
+  return size;
 }
+/**
+ * Read the interleaved data of all points with a single read instead of one per data type and
+ * point, and split it into the arrays of the memory cache.
+ */
+static int ptcache_file_data_read_all(PTCacheFile *pf, PTCacheMem *pm)
+{
+  const unsigned int point_size = ptcache_file_data_point_size(pm->data_types);
+  if (pm->totpoint == 0 || point_size == 0) {
+    return 1;
+  }
+
+  char *buf = MEM_mallocN((size_t)point_size * pm->totpoint, __func__);
+  if (!ptcache_file_read(pf, buf, pm->totpoint, point_size)) {
+    MEM_freeN(buf);
+    return 0;
+  }
+
+  unsigned int offset = 0;
+  for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+    if ((pm->data_types & (1 << i)) == 0) {
+      continue;
+    }
+    const int size = ptcache_data_size[i];
+    const char *src = buf + offset;
+    char *dst = pm->data[i];
+    for (unsigned int p = 0; p < pm->totpoint; p++, src += point_size, dst += size) {
+      memcpy(dst, src, size);
+    }
+    offset += size;
+  }
 
+  MEM_freeN(buf);
+  return 1;
+}
+/* Interleave the data of all points and write it with a single write. */
+static int ptcache_file_data_write_all(PTCacheFile *pf, PTCacheMem *pm)
+{
+  const unsigned int point_size = ptcache_file_data_point_size(pm->data_types);
+  if (pm->totpoint == 0 || point_size == 0) {
+    return 1;
+  }
+
+  char *buf = MEM_callocN((size_t)point_size * pm->totpoint, __func__);
+
+  unsigned int offset = 0;
+  for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+    if ((pm->data_types & (1 << i)) == 0) {
+      continue;
+    }
+    const int size = ptcache_data_size[i];
+    if (pm->data[i]) {
+      const char *src = pm->data[i];
+      char *dst = buf + offset;
+      for (unsigned int p = 0; p < pm->totpoint; p++, src += size, dst += point_size) {
+        memcpy(dst, src, size);
+      }
+    }
+    offset += size;
+  }
+
+  const int ok = ptcache_file_write(pf, buf, pm->totpoint, point_size);
+  MEM_freeN(buf);
+  return ok;
+}
 static void ptcache_extra_free(PTCacheMem *pm)
 {
   PTCacheExtra *extra = pm->extradata.first;
@@ -1973,19 +2025,8 @@ static PTCacheMem *ptcache_disk_frame_to_mem(PTCacheID *pid, int cfra)
         }
       }
     }
-    else {
-      void *cur[BPHYS_TOT_DATA];
-      BKE_ptcache_mem_pointers_init(pm, cur);
-      ptcache_file_pointers_init(pf);
-
-      for (i = 0; i < pm->totpoint; i++) {
-        if (!ptcache_file_data_read(pf)) {
-          error = 1;
-          break;
-        }
-        ptcache_data_copy(pf->cur, cur);
-        BKE_ptcache_mem_pointers_incr(cur);
-      }
+    else if (!ptcache_file_data_read_all(pf, pm)) {
+      error = 1;
     }
   }
 
@@ -2075,19 +2116,8 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
         }
       }
     }
-    else {
-      void *cur[BPHYS_TOT_DATA];
-      BKE_ptcache_mem_pointers_init(pm, cur);
-      ptcache_file_pointers_init(pf);
-
-      for (i = 0; i < pm->totpoint; i++) {
-        ptcache_data_copy(cur, pf->cur);
-        if (!ptcache_file_data_write(pf)) {
-          error = 1;
-          break;
-        }
-        BKE_ptcache_mem_pointers_incr(cur);
-      }
+    else if (!ptcache_file_data_write_all(pf, pm)) {
+      error = 1;
     }
   }
 
@@ -1825,22 +1825,25 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
       }
       else {
         /* perform simulation data updates as tagged */
+        /* Whether the collision shape was just created from the current mesh. */
+        bool shape_is_new = false;
         /* refresh object... */
         if (rebuild) {
           /* World has been rebuilt so rebuild object */
-          /* TODO(Sybren): rigidbody_validate_sim_object() can call rigidbody_validate_sim_shape(),
-           * but neither resets the RBO_FLAG_NEEDS_RESHAPE flag nor
-           * calls RB_body_set_collision_shape().
-           * This results in the collision shape being created twice, which is unnecessary. */
           rigidbody_validate_sim_object(rbw, ob, true);
+          shape_is_new = true;
         }
         else if (rbo->flag & RBO_FLAG_NEEDS_VALIDATE) {
+          shape_is_new = (rbo->shared->physics_shape == NULL);
           rigidbody_validate_sim_object(rbw, ob, false);
         }
         /* refresh shape... */
         if (rbo->flag & RBO_FLAG_NEEDS_RESHAPE) {
-          /* mesh/shape data changed, so force shape refresh */
-          rigidbody_validate_sim_shape(rbw, ob, true);
+          /* mesh/shape data changed, so force shape refresh,
+           * unless it was created above already (convex hulls and meshes are expensive). */
+          if (!shape_is_new) {
+            rigidbody_validate_sim_shape(rbw, ob, true);
+          }
           /* now tell RB sim about it */
           /* XXX: we assume that this can only get applied for active/passive shapes
            * that will be included as rigidbodies. */
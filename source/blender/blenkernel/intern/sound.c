@@ -996,15 +996,56 @@ int BKE_sound_scene_playing(Scene *scene)
   return -1;
 }
 
+static void sound_waveform_free(SoundWaveform *waveform)
+{
+  if (waveform->data) {
+    MEM_freeN(waveform->data);
+  }
+  for (int lod = 0; lod < SOUND_WAVE_LOD_LEN; lod++) {
+    if (waveform->lod_data[lod]) {
+      MEM_freeN(waveform->lod_data[lod]);
+    }
+  }
+  MEM_freeN(waveform);
+}
+
+/* Halve the resolution for every level, so drawing a zoomed out strip only has to look at a few
+ * samples per pixel instead of the whole sound. */
+static void sound_waveform_build_lod(SoundWaveform *waveform)
+{
+  const float *src = waveform->data;
+  int src_length = waveform->length;
+
+  for (int lod = 0; lod < SOUND_WAVE_LOD_LEN && src_length >= 4; lod++) {
+    const int length = (src_length + 1) / 2;
+    float *dst = MEM_mallocN(sizeof(float[3]) * length, "SoundWaveform.lod");
+
+    for (int i = 0; i < length; i++) {
+      const float *a = &src[i * 6];
+      if (i * 2 + 1 < src_length) {
+        const float *b = a + 3;
+        dst[i * 3] = min_ff(a[0], b[0]);
+        dst[i * 3 + 1] = max_ff(a[1], b[1]);
+        dst[i * 3 + 2] = sqrtf((a[2] * a[2] + b[2] * b[2]) * 0.5f);
+      }
+      else {
+        copy_v3_v3(&dst[i * 3], a);
+      }
+    }
+
+    waveform->lod_data[lod] = dst;
+    waveform->lod_length[lod] = length;
+    src = dst;
+    src_length = length;
+  }
+}
+
 void BKE_sound_free_waveform(bSound *sound)
 {
   if ((sound->tags & SOUND_TAGS_WAVEFORM_NO_RELOAD) == 0) {
     SoundWaveform *waveform = sound->waveform;
     if (waveform) {
-      if (waveform->data) {
-        MEM_freeN(waveform->data);
-      }
-      MEM_freeN(waveform);
+      sound_waveform_free(waveform);
     }
 
     sound->waveform = NULL;
@@ -1023,7 +1064,7 @@ void BKE_sound_read_waveform(Main *bmain, bSound *sound, short *stop)
   }
 
   AUD_SoundInfo info = AUD_getInfo(sound->playback_handle);
-  SoundWaveform *waveform = MEM_mallocN(sizeof(SoundWaveform), "SoundWaveform");
+  SoundWaveform *waveform = MEM_callocN(sizeof(SoundWaveform), "SoundWaveform");
 
   if (info.length > 0) {
     int length = info.length * SOUND_WAVE_SAMPLES_PER_SECOND;
@@ -1031,6 +1072,9 @@ void BKE_sound_read_waveform(Main *bmain, bSound *sound, short *stop)
     waveform->data = MEM_mallocN(sizeof(float[3]) * length, "SoundWaveform.samples");
     waveform->length = AUD_readSound(
         sound->playback_handle, waveform->data, length, SOUND_WAVE_SAMPLES_PER_SECOND, stop);
+    if (!*stop) {
+      sound_waveform_build_lod(waveform);
+    }
   }
   else {
     /* Create an empty waveform here if the sound couldn't be
@@ -1042,10 +1086,7 @@ void BKE_sound_read_waveform(Main *bmain, bSound *sound, short *stop)
   }
 
   if (*stop) {
-    if (waveform->data) {
-      MEM_freeN(waveform->data);
-    }
-    MEM_freeN(waveform);
+    sound_waveform_free(waveform);
     BLI_spin_lock(sound->spinlock);
     sound->tags &= ~SOUND_TAGS_WAVEFORM_LOADING;
     BLI_spin_unlock(sound->spinlock);
@@ -36,6 +36,7 @@
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.h"
+#include "BLI_threads.h"
 
 #include "DNA_listBase.h"
 
@@ -50,6 +51,8 @@
 
 /* Statics */
 static ListBase studiolights;
+static bool studiolights_initialized = false;
+static ThreadMutex studiolights_init_lock = BLI_MUTEX_INITIALIZER;
 static int last_studiolight_id = 0;
 #define STUDIOLIGHT_RADIANCE_CUBEMAP_SIZE 96
 #define STUDIOLIGHT_IRRADIANCE_EQUIRECT_HEIGHT 32
@@ -1406,7 +1409,7 @@ void BKE_studiolight_default(SolidLight lights[4], float light_ambient[4])
 }
 
 /* API */
-void BKE_studiolight_init(void)
+static void studiolight_init_list(void)
 {
   /* Add default studio light */
   StudioLight *sl = studiolight_create(
@@ -1447,16 +1450,39 @@ void BKE_studiolight_init(void)
   BKE_studiolight_default(sl->light, sl->light_ambient);
 }
 
+/* Scanning the data-files folders touches the file system, so it is done on first use.
+ * Background renders which don't use studio lights never pay for it. */
+static void studiolight_ensure_init(void)
+{
+  if (studiolights_initialized) {
+    return;
+  }
+  BLI_mutex_lock(&studiolights_init_lock);
+  if (!studiolights_initialized) {
+    studiolight_init_list();
+    studiolights_initialized = true;
+  }
+  BLI_mutex_unlock(&studiolights_init_lock);
+}
+
+void BKE_studiolight_init(void)
+{
+  studiolight_ensure_init();
+}
+
 void BKE_studiolight_free(void)
 {
   struct StudioLight *sl;
   while ((sl = BLI_pophead(&studiolights))) {
     studiolight_free(sl);
   }
+  studiolights_initialized = false;
 }
 
 struct StudioLight *BKE_studiolight_find_default(int flag)
 {
+  studiolight_ensure_init();
+
   const char *default_name = "";
 
   if (flag & STUDIOLIGHT_TYPE_WORLD) {
@@ -1482,6 +1508,8 @@ struct StudioLight *BKE_studiolight_find_default(int flag)
 
 struct StudioLight *BKE_studiolight_find(const char *name, int flag)
 {
+  studiolight_ensure_init();
+
   LISTBASE_FOREACH (StudioLight *, sl, &studiolights) {
     if (STREQLEN(sl->name, name, FILE_MAXFILE)) {
       if ((sl->flag & flag)) {
@@ -1498,6 +1526,8 @@ struct StudioLight *BKE_studiolight_find(const char *name, int flag)
 
 struct StudioLight *BKE_studiolight_findindex(int index, int flag)
 {
+  studiolight_ensure_init();
+
   LISTBASE_FOREACH (StudioLight *, sl, &studiolights) {
     if (sl->index == index) {
       return sl;
@@ -1509,6 +1539,8 @@ struct StudioLight *BKE_studiolight_findindex(int index, int flag)
 
 struct ListBase *BKE_studiolight_listbase(void)
 {
+  studiolight_ensure_init();
+
   return &studiolights;
 }
 
@@ -1585,6 +1617,8 @@ void BKE_studiolight_remove(StudioLight *sl)
 
 StudioLight *BKE_studiolight_load(const char *path, int type)
 {
+  studiolight_ensure_init();
+
   StudioLight *sl = studiolight_add_file(path, type | STUDIOLIGHT_USER_DEFINED);
   return sl;
 }
@@ -1593,6 +1627,8 @@ StudioLight *BKE_studiolight_create(const char *path,
                                     const SolidLight light[4],
                                     const float light_ambient[3])
 {
+  studiolight_ensure_init();
+
   StudioLight *sl = studiolight_create(STUDIOLIGHT_EXTERNAL_FILE | STUDIOLIGHT_USER_DEFINED |
                                        STUDIOLIGHT_TYPE_STUDIO |
                                        STUDIOLIGHT_SPECULAR_HIGHLIGHT_PASS);
@@ -80,21 +80,34 @@ static void set_coarse_positions(Subdiv *subdiv,
       BLI_BITMAP_ENABLE(vertex_used_map, loop->v);
     }
   }
-  for (int vertex_index = 0, manifold_vertex_index = 0; vertex_index < mesh->totvert;
-       vertex_index++) {
+  /* Pass runs of used vertices at once, which avoids going through the evaluator API for every
+   * single vertex. Usually all vertices are used, so this is a single call. */
+  int manifold_vertex_index = 0;
+  int vertex_index = 0;
+  while (vertex_index < mesh->totvert) {
     if (!BLI_BITMAP_TEST_BOOL(vertex_used_map, vertex_index)) {
+      vertex_index++;
       continue;
     }
-    const float *vertex_co;
+    const int run_start = vertex_index;
+    while (vertex_index < mesh->totvert && BLI_BITMAP_TEST_BOOL(vertex_used_map, vertex_index)) {
+      vertex_index++;
+    }
+    const int run_len = vertex_index - run_start;
     if (coarse_vertex_cos != NULL) {
-      vertex_co = coarse_vertex_cos[vertex_index];
+      subdiv->evaluator->setCoarsePositions(
+          subdiv->evaluator, coarse_vertex_cos[run_start], manifold_vertex_index, run_len);
     }
     else {
-      const MVert *vertex = &mvert[vertex_index];
-      vertex_co = vertex->co;
+      subdiv->evaluator->setCoarsePositionsFromBuffer(subdiv->evaluator,
+                                                      mvert,
+                                                      offsetof(MVert, co) +
+                                                          run_start * sizeof(MVert),
+                                                      sizeof(MVert),
+                                                      manifold_vertex_index,
+                                                      run_len);
     }
-    subdiv->evaluator->setCoarsePositions(subdiv->evaluator, vertex_co, manifold_vertex_index, 1);
-    manifold_vertex_index++;
+    manifold_vertex_index += run_len;
   }
   MEM_freeN(vertex_used_map);
 }
@@ -32,6 +32,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_math_color.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -747,6 +748,61 @@ void BKE_texture_get_value(const Scene *scene,
   BKE_texture_get_value_ex(scene, texture, tex_co, texres, NULL, use_color_management);
 }
 
+typedef struct TextureGetValuesData {
+  const Scene *scene;
+  Tex *texture;
+  const float (*tex_co)[3];
+  TexResult *texres;
+  struct ImagePool *pool;
+  bool use_color_management;
+} TextureGetValuesData;
+
+static void texture_get_values_task(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const TextureGetValuesData *data = userdata;
+  TexResult *texres = &data->texres[i];
+
+  texres->nor = NULL;
+  BKE_texture_get_value_ex(data->scene,
+                           data->texture,
+                           data->tex_co[i],
+                           texres,
+                           data->pool,
+                           data->use_color_management);
+}
+
+/**
+ * Evaluate the texture for an array of coordinates at once, from multiple threads.
+ * Images used by the texture are acquired once up-front, so sampling them doesn't
+ * take the global image lock for every coordinate.
+ */
+void BKE_texture_get_values(const Scene *scene,
+                            Tex *texture,
+                            const float (*tex_co)[3],
+                            const int tex_co_num,
+                            TexResult *r_texres,
+                            bool use_color_management)
+{
+  TextureGetValuesData data = {
+      .scene = scene,
+      .texture = texture,
+      .tex_co = tex_co,
+      .texres = r_texres,
+      .pool = BKE_image_pool_new(),
+      .use_color_management = use_color_management,
+  };
+  BKE_texture_fetch_images_for_pool(texture, data.pool);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (tex_co_num > 512);
+  BLI_task_parallel_range(0, tex_co_num, &data, texture_get_values_task, &settings);
+
+  BKE_image_pool_free(data.pool);
+}
+
 static void texture_nodes_fetch_images_for_pool(Tex *texture,
                                                 bNodeTree *ntree,
                                                 struct ImagePool *pool)
@@ -38,6 +38,9 @@
 #include "BKE_movieclip.h"
 #include "BKE_tracking.h"
 
+#include "IMB_imbuf.h"
+#include "IMB_imbuf_types.h"
+
 #include "libmv-capi.h"
 #include "tracking_private.h"
 
@@ -80,6 +83,10 @@ typedef struct AutoTrackContext {
   bool first_sync;
   SpinLock spin_lock;
 
+  /* Reads the frame needed by the next step into the movie clip cache while the tracks of the
+   * current step are being tracked, so frame decoding is not on the critical path. */
+  TaskPool *prefetch_pool;
+
   bool step_ok;
 } AutoTrackContext;
 
@@ -370,9 +377,26 @@ AutoTrackContext *BKE_autotrack_context_new(MovieClip *clip,
   fill_autotrack_tracks(frame_width, frame_height, tracksbase, backwards, context->autotrack);
   /* Create per-track tracking options. */
   create_per_track_tracking_options(clip, user, tracksbase, context);
+  if (sequence) {
+    context->prefetch_pool = BLI_task_pool_create_background(context, TASK_PRIORITY_HIGH);
+  }
   return context;
 }
 
+static void autotrack_context_prefetch_cb(TaskPool *__restrict pool, void *taskdata)
+{
+  AutoTrackContext *context = BLI_task_pool_user_data(pool);
+  BLI_spin_lock(&context->spin_lock);
+  MovieClipUser user = context->user;
+  BLI_spin_unlock(&context->spin_lock);
+  BKE_movieclip_user_set_frame(&user, POINTER_AS_INT(taskdata));
+  /* Only needs to end up in the clip cache, the image accessor gets it from there. */
+  ImBuf *ibuf = BKE_movieclip_get_ibuf(context->clips[0], &user);
+  if (ibuf != NULL) {
+    IMB_freeImBuf(ibuf);
+  }
+}
+
 static void autotrack_context_step_cb(void *__restrict userdata,
                                       const int track,
                                       const TaskParallelTLS *__restrict UNUSED(tls))
@@ -444,6 +468,17 @@ bool BKE_autotrack_context_step(AutoTrackContext *context)
   const int frame_delta = context->backwards ? -1 : 1;
   context->step_ok = false;
 
+  if (context->prefetch_pool != NULL) {
+    /* The frame tracked into by this step was read during the previous one, start reading the
+     * frame of the next step. */
+    BLI_task_pool_work_and_wait(context->prefetch_pool);
+    BLI_task_pool_push(context->prefetch_pool,
+                       autotrack_context_prefetch_cb,
+                       POINTER_FROM_INT(context->user.framenr + 2 * frame_delta),
+                       false,
+                       NULL);
+  }
+
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
   settings.use_threading = (context->num_tracks > 1);
@@ -539,6 +574,10 @@ void BKE_autotrack_context_finish(AutoTrackContext *context)
 
 void BKE_autotrack_context_free(AutoTrackContext *context)
 {
+  if (context->prefetch_pool != NULL) {
+    BLI_task_pool_work_and_wait(context->prefetch_pool);
+    BLI_task_pool_free(context->prefetch_pool);
+  }
   libmv_autoTrackDestroy(context->autotrack);
   tracking_image_accessor_destroy(context->image_accessor);
   MEM_freeN(context->options);
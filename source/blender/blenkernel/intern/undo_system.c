@@ -448,6 +448,33 @@ void BKE_undosys_stack_limit_steps_and_memory(UndoStack *ustack, int steps, size
   }
 }
 
+/**
+ * Spill old steps out of memory until the memory used by the undo stack fits \a memory_limit,
+ * for undo types supporting it. Called before #BKE_undosys_stack_limit_steps_and_memory
+ * so history is kept instead of being freed.
+ */
+void BKE_undosys_stack_spill_memory(UndoStack *ustack, size_t memory_limit)
+{
+  UNDO_NESTED_ASSERT(false);
+  if (memory_limit == 0) {
+    return;
+  }
+
+  size_t data_size_all = 0;
+  for (UndoStep *us = ustack->steps.last; us; us = us->prev) {
+    data_size_all += us->data_size;
+    if ((data_size_all > memory_limit) && (us != ustack->step_active) &&
+        (us->type->step_spill != NULL)) {
+      const size_t data_size = us->data_size;
+      if (us->type->step_spill(us)) {
+        CLOG_INFO(&LOG, 2, "spill '%s', size=%zu", us->name, data_size);
+        BLI_assert(us->data_size <= data_size);
+        data_size_all -= data_size - us->data_size;
+      }
+    }
+  }
+}
+
 /** \} */
 
 UndoStep *BKE_undosys_step_push_init_with_type(UndoStack *ustack,
@@ -18,6 +18,8 @@
  * \ingroup bke
  */
 
+#include <cmath>
+
 #include "MEM_guardedalloc.h"
 
 #include "BLI_array.hh"
@@ -103,19 +105,40 @@ static void create_texture_to_object_matrix(const openvdb::Mat4d &grid_transform
 
 #endif
 
+/**
+ * \param max_voxels: When the active voxels of the grid span more voxels than this, the grid is
+ * resampled at a lower resolution first, so large grids can still be displayed. Zero means there
+ * is no limit.
+ */
 bool BKE_volume_grid_dense_floats(const Volume *volume,
                                   VolumeGrid *volume_grid,
+                                  const int64_t max_voxels,
                                   DenseFloatVolumeGrid *r_dense_grid)
 {
 #ifdef WITH_OPENVDB
   const VolumeGridType grid_type = BKE_volume_grid_type(volume_grid);
   openvdb::GridBase::ConstPtr grid = BKE_volume_grid_openvdb_for_read(volume, volume_grid);
 
-  const openvdb::CoordBBox bbox = grid->evalActiveVoxelBoundingBox();
+  openvdb::CoordBBox bbox = grid->evalActiveVoxelBoundingBox();
   if (bbox.empty()) {
     return false;
   }
 
+  if (max_voxels > 0 && static_cast<int64_t>(bbox.volume()) > max_voxels) {
+    const float resolution_factor = static_cast<float>(
+        std::cbrt(static_cast<double>(max_voxels) / bbox.volume()));
+    openvdb::GridBase::ConstPtr resampled_grid = BKE_volume_grid_create_with_changed_resolution(
+        grid_type, *grid, resolution_factor);
+    if (!resampled_grid) {
+      return false;
+    }
+    grid = resampled_grid;
+    bbox = grid->evalActiveVoxelBoundingBox();
+    if (bbox.empty()) {
+      return false;
+    }
+  }
+
   const openvdb::Vec3i resolution = bbox.dim().asVec3i();
   const int64_t num_voxels = static_cast<int64_t>(resolution[0]) *
                              static_cast<int64_t>(resolution[1]) *
@@ -137,7 +160,7 @@ bool BKE_volume_grid_dense_floats(const Volume *volume,
   copy_v3_v3_int(r_dense_grid->resolution, resolution.asV());
   return true;
 #endif
-  UNUSED_VARS(volume, volume_grid, r_dense_grid);
+  UNUSED_VARS(volume, volume_grid, max_voxels, r_dense_grid);
   return false;
 }
 
@@ -0,0 +1,60 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ * \brief Compression of data split into independent blocks.
+ *
+ * Blocks are compressed in parallel, each of them into its own gzip member. A concatenation of
+ * the compressed blocks is a regular gzip stream, while every block can also be decompressed on
+ * its own, which gives random access to the data when offsets of the blocks are stored.
+ */
+
+#include "BLI_sys_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Size of uncompressed data of a block, large enough to not affect compression ratio much. */
+#define BLI_COMPRESS_BLOCK_SIZE (1 << 20)
+
+typedef struct CompressBlock {
+  /** Uncompressed data. */
+  const void *data;
+  size_t data_len;
+
+  /** Compressed data, allocated by #BLI_compress_blocks. NULL when compression failed. */
+  void *compressed;
+  size_t compressed_len;
+} CompressBlock;
+
+bool BLI_compress_blocks(CompressBlock *blocks, int blocks_num, int level);
+
+void *BLI_compress_mem(const void *data, size_t data_len, int level, size_t *r_compressed_len);
+size_t BLI_decompress_mem(const void *compressed,
+                          size_t compressed_len,
+                          void *r_data,
+                          size_t data_len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,94 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A container with a separate value for every thread that accesses it, the values can be
+ * iterated over (e.g. to combine or reset them) when no other thread uses the container.
+ */
+
+#ifdef WITH_TBB
+/* Quiet top level deprecation message, unrelated to API usage here. */
+#  define TBB_SUPPRESS_DEPRECATED_MESSAGES 1
+#  include <tbb/enumerable_thread_specific.h>
+#endif
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include "BLI_map.hh"
+#include "BLI_utility_mixins.hh"
+
+namespace blender::threading {
+
+#ifndef WITH_TBB
+namespace enumerable_thread_specific_utils {
+inline int thread_id()
+{
+  static std::atomic<int> next_id = 0;
+  static thread_local const int id = next_id++;
+  return id;
+}
+}  // namespace enumerable_thread_specific_utils
+#endif
+
+template<typename T> class EnumerableThreadSpecific : NonCopyable, NonMovable {
+#ifdef WITH_TBB
+  tbb::enumerable_thread_specific<T> values_;
+#else
+  std::mutex mutex_;
+  /* Values are stored in separate allocations so that references stay valid when the map grows. */
+  Map<int, std::unique_ptr<T>> values_;
+#endif
+
+ public:
+  /**
+   * Get the value of the calling thread, it is default constructed on first access.
+   */
+  T &local()
+  {
+#ifdef WITH_TBB
+    return values_.local();
+#else
+    const int thread_id = enumerable_thread_specific_utils::thread_id();
+    std::lock_guard lock{mutex_};
+    return *values_.lookup_or_add_cb(thread_id, []() { return std::make_unique<T>(); });
+#endif
+  }
+
+  /**
+   * Call \a function for the value of every thread which accessed the container.
+   * Must not be called while the container is used by other threads.
+   */
+  template<typename Function> void foreach_value(const Function &function)
+  {
+#ifdef WITH_TBB
+    for (T &value : values_) {
+      function(value);
+    }
+#else
+    for (std::unique_ptr<T> &value : values_.values()) {
+      function(*value);
+    }
+#endif
+  }
+};
+
+}  // namespace blender::threading
@@ -148,6 +148,13 @@ struct float2 {
     float mu;
   };
 
+  uint64_t hash() const
+  {
+    uint64_t x1 = *reinterpret_cast<const uint32_t *>(&x);
+    uint64_t x2 = *reinterpret_cast<const uint32_t *>(&y);
+    return (x1 * 812519) ^ (x2 * 707951);
+  }
+
   static isect_result isect_seg_seg(const float2 &v1,
                                     const float2 &v2,
                                     const float2 &v3,
@@ -141,7 +141,7 @@ BLI_INLINE void **BLI_ghashIterator_getValue_p(GHashIterator *ghi) ATTR_WARN_UNU
 BLI_INLINE bool BLI_ghashIterator_done(GHashIterator *ghi) ATTR_WARN_UNUSED_RESULT;
 
 struct _gh_Entry {
-  void *next, *key, *val;
+  void *key, *val;
 };
 BLI_INLINE void *BLI_ghashIterator_getKey(GHashIterator *ghi)
 {
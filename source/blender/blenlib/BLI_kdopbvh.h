@@ -193,6 +193,13 @@ int BLI_bvhtree_find_nearest(BVHTree *tree,
                              BVHTreeNearest *nearest,
                              BVHTree_NearestPointCallback callback,
                              void *userdata);
+void BLI_bvhtree_find_nearest_batch(BVHTree *tree,
+                                    const float (*co)[3],
+                                    const int co_len,
+                                    BVHTreeNearest *r_nearest,
+                                    BVHTree_NearestPointCallback callback,
+                                    void *userdata,
+                                    int flag);
 
 int BLI_bvhtree_find_nearest_first(BVHTree *tree,
                                    const float co[3],
@@ -34,11 +34,14 @@ template<typename Allocator = GuardedAllocator> class LinearAllocator : NonCopya
  private:
   Allocator allocator_;
   Vector<void *> owned_buffers_;
+  Vector<Span<char>> borrowed_buffers_;
   Vector<Span<char>> unused_borrowed_buffers_;
 
   uintptr_t current_begin_;
   uintptr_t current_end_;
   int64_t next_min_alloc_size_;
+  /** Size of the last (and largest) owned buffer. */
+  int64_t last_owned_buffer_size_ = 0;
 
 #ifdef DEBUG
   int64_t debug_allocated_amount_ = 0;
@@ -185,6 +188,7 @@ template<typename Allocator = GuardedAllocator> class LinearAllocator : NonCopya
    */
   void provide_buffer(void *buffer, uint size)
   {
+    borrowed_buffers_.append(Span<char>(static_cast<char *>(buffer), size));
     unused_borrowed_buffers_.append(Span<char>(static_cast<char *>(buffer), size));
   }
 
@@ -194,6 +198,36 @@ template<typename Allocator = GuardedAllocator> class LinearAllocator : NonCopya
     this->provide_buffer(aligned_buffer.ptr(), Size);
   }
 
+  /**
+   * Make all memory available for new allocations again. All buffers returned before become
+   * invalid, destructors of constructed values are not called.
+   *
+   * Only the largest owned buffer is kept, so that an allocator which is reset regularly (e.g. for
+   * scratch memory of an evaluation) quickly stops allocating memory.
+   */
+  void reset()
+  {
+    if (owned_buffers_.is_empty()) {
+      current_begin_ = 0;
+      current_end_ = 0;
+    }
+    else {
+      void *last_buffer = owned_buffers_.pop_last();
+      for (void *ptr : owned_buffers_) {
+        allocator_.deallocate(ptr);
+      }
+      owned_buffers_.clear();
+      owned_buffers_.append(last_buffer);
+      current_begin_ = (uintptr_t)last_buffer;
+      current_end_ = current_begin_ + last_owned_buffer_size_;
+    }
+    unused_borrowed_buffers_ = borrowed_buffers_;
+
+#ifdef DEBUG
+    debug_allocated_amount_ = 0;
+#endif
+  }
+
  private:
   void allocate_new_buffer(int64_t min_allocation_size)
   {
@@ -213,6 +247,7 @@ template<typename Allocator = GuardedAllocator> class LinearAllocator : NonCopya
 
     void *buffer = allocator_.allocate(size_in_bytes, 8, AT);
     owned_buffers_.append(buffer);
+    last_owned_buffer_size_ = size_in_bytes;
     current_begin_ = (uintptr_t)buffer;
     current_end_ = current_begin_ + size_in_bytes;
   }
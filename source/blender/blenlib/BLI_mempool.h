@@ -93,6 +93,23 @@ BLI_mempool_iter *BLI_mempool_iter_threadsafe_create(BLI_mempool *pool,
     ATTR_NONNULL();
 void BLI_mempool_iter_threadsafe_free(BLI_mempool_iter *iter_arr) ATTR_NONNULL();
 
+/** Thread local allocation. note: the contents of this struct are private. */
+typedef struct BLI_mempool_local {
+  BLI_mempool *pool;
+  /** Free elements owned by this thread. */
+  struct BLI_freenode *free;
+  /** Change in the number of used elements, applied to the pool by #BLI_mempool_local_finish. */
+  int totused_delta;
+} BLI_mempool_local;
+
+void BLI_mempool_local_init(BLI_mempool *pool, BLI_mempool_local *local) ATTR_NONNULL();
+void *BLI_mempool_local_alloc(BLI_mempool_local *local) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL(1);
+void *BLI_mempool_local_calloc(BLI_mempool_local *local) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL(1);
+void BLI_mempool_local_free(BLI_mempool_local *local, void *addr) ATTR_NONNULL(1, 2);
+void BLI_mempool_local_finish(BLI_mempool_local *local) ATTR_NONNULL();
+
 #ifdef __cplusplus
 }
 #endif
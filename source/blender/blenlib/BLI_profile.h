@@ -0,0 +1,60 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Timeline profiler shared by all sub-systems.
+ *
+ * Zones and counters are recorded into a ring buffer per thread (no locking when recording),
+ * and exported as a single Chrome trace (JSON), which can be opened in `chrome://tracing`,
+ * Perfetto or Tracy's importer. Recording is always compiled in, but a zone costs no more than
+ * checking a flag until profiling gets enabled (see #BLI_profile_enable and `--profile`).
+ *
+ * C++ code can use #blender::timeit::ScopedProfileZone from `BLI_timeit.hh`.
+ */
+
+#include "BLI_sys_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Only meant to be used through #BLI_profile_zone_begin & #BLI_profile_zone_end. */
+typedef struct ProfileZone {
+  const char *name;
+  const char *detail;
+  uint64_t start_ns;
+  int depth;
+  bool is_active;
+} ProfileZone;
+
+void BLI_profile_enable(bool enable);
+bool BLI_profile_is_enabled(void);
+void BLI_profile_output_set(const char *filepath);
+void BLI_profile_clear(void);
+bool BLI_profile_write_chrome_trace(const char *filepath);
+void BLI_profile_exit(void);
+
+void BLI_profile_zone_begin(ProfileZone *zone, const char *name, const char *detail);
+void BLI_profile_zone_end(ProfileZone *zone);
+void BLI_profile_counter(const char *name, int64_t value);
+
+#ifdef __cplusplus
+}
+#endif
@@ -41,10 +41,12 @@
 #  endif
 #endif
 
+#include <utility>
+
 #include "BLI_index_range.hh"
 #include "BLI_utildefines.h"
 
-namespace blender {
+namespace blender::threading {
 
 template<typename Range, typename Function>
 void parallel_for_each(Range &range, const Function &function)
@@ -75,4 +77,61 @@ void parallel_for(IndexRange range, int64_t grain_size, const Function &function
 #endif
 }
 
-}  // namespace blender
+/**
+ * Compute a value from sub-ranges of \a range in parallel, e.g. bounds or a sum.
+ *
+ * \param function: Called as `Value function(IndexRange range, const Value &value)`,
+ * accumulating the elements of the range into a copy of \a value.
+ * \param reduction: Called as `Value reduction(const Value &a, const Value &b)`,
+ * combining the results of two sub-ranges.
+ */
+template<typename Value, typename Function, typename Reduction>
+Value parallel_reduce(IndexRange range,
+                      int64_t grain_size,
+                      const Value &identity,
+                      const Function &function,
+                      const Reduction &reduction)
+{
+#ifdef WITH_TBB
+  return tbb::parallel_reduce(
+      tbb::blocked_range<int64_t>(range.first(), range.one_after_last(), grain_size),
+      identity,
+      [&](const tbb::blocked_range<int64_t> &subrange, const Value &ident) {
+        return function(IndexRange(subrange.begin(), subrange.size()), ident);
+      },
+      reduction);
+#else
+  UNUSED_VARS(grain_size, reduction);
+  return function(range, identity);
+#endif
+}
+
+/**
+ * Execute all of the provided functions, possibly in parallel.
+ */
+template<typename... Functions> void parallel_invoke(Functions &&... functions)
+{
+#ifdef WITH_TBB
+  tbb::parallel_invoke(std::forward<Functions>(functions)...);
+#else
+  (functions(), ...);
+#endif
+}
+
+/**
+ * Don't execute unrelated tasks while waiting for the tasks started by \a function.
+ *
+ * While waiting in a parallel loop, the thread can pick up other tasks, e.g. from the depsgraph
+ * evaluation the loop is nested in. Those may wait on a lock held by the current task and
+ * dead-lock, isolation prevents that.
+ */
+template<typename Function> void isolate_task(const Function &function)
+{
+#ifdef WITH_TBB
+  tbb::this_task_arena::isolate(function);
+#else
+  function();
+#endif
+}
+
+}  // namespace blender::threading
@@ -20,6 +20,7 @@
 #include <iostream>
 #include <string>
 
+#include "BLI_profile.h"
 #include "BLI_sys_types.h"
 
 namespace blender::timeit {
@@ -29,6 +30,7 @@ using TimePoint = Clock::time_point;
 using Nanoseconds = std::chrono::nanoseconds;
 
 void print_duration(Nanoseconds duration);
+void print_throughput(int64_t elements, Nanoseconds duration);
 
 class ScopedTimer {
  private:
@@ -52,6 +54,65 @@ class ScopedTimer {
   }
 };
 
+/**
+ * Like #ScopedTimer, but also prints how many elements have been processed per second.
+ */
+class ScopedThroughputTimer {
+ private:
+  std::string name_;
+  int64_t elements_;
+  TimePoint start_;
+
+ public:
+  ScopedThroughputTimer(std::string name, const int64_t elements)
+      : name_(std::move(name)), elements_(elements)
+  {
+    start_ = Clock::now();
+  }
+
+  ~ScopedThroughputTimer()
+  {
+    const TimePoint end = Clock::now();
+    const Nanoseconds duration = end - start_;
+
+    std::cout << "Timer '" << name_ << "' took ";
+    print_duration(duration);
+    std::cout << " (";
+    print_throughput(elements_, duration);
+    std::cout << ")\n";
+  }
+};
+
+/**
+ * Records a zone into the profiler timeline for the lifetime of the object (see `BLI_profile.h`).
+ * Unlike #ScopedTimer it's cheap enough to be left in code permanently,
+ * nothing is recorded unless profiling is enabled.
+ *
+ * \param name: Must be a static string.
+ * \param detail: Optional, copied when the zone ends.
+ */
+class ScopedProfileZone {
+ private:
+  ProfileZone zone_;
+
+ public:
+  ScopedProfileZone(const char *name, const char *detail = nullptr)
+  {
+    BLI_profile_zone_begin(&zone_, name, detail);
+  }
+
+  ~ScopedProfileZone()
+  {
+    BLI_profile_zone_end(&zone_);
+  }
+
+  ScopedProfileZone(const ScopedProfileZone &other) = delete;
+  ScopedProfileZone &operator=(const ScopedProfileZone &other) = delete;
+};
+
 }  // namespace blender::timeit
 
 #define SCOPED_TIMER(name) blender::timeit::ScopedTimer scoped_timer(name)
+#define SCOPED_THROUGHPUT_TIMER(name, elements) \
+  blender::timeit::ScopedThroughputTimer scoped_throughput_timer(name, elements)
+#define SCOPED_PROFILE_ZONE(name) blender::timeit::ScopedProfileZone scoped_profile_zone(name)
@@ -20,7 +20,7 @@
 /** \file
  * \ingroup bli
  *
- * A general (pointer -> pointer) chaining hash table
+ * A general (pointer -> pointer) open addressing hash table
  * for 'Abstract Data Types' (known as an ADT Hash Table).
  */
 
@@ -45,12 +45,11 @@
 /** \name Structs & Constants
  * \{ */
 
-#define GHASH_USE_MODULO_BUCKETS
-
 /**
  * Next prime after `2^n` (skipping 2 & 3).
  *
- * \note Also used by: `BLI_edgehash` & `BLI_smallhash`.
+ * \note Not used by GHash itself anymore (it uses power of two sizes),
+ * kept for: `BLI_edgehash` & `BLI_smallhash`.
  */
 extern const uint BLI_ghash_hash_sizes[]; /* Quiet warning, this is only used by smallhash.c */
 const uint BLI_ghash_hash_sizes[] = {
@@ -58,31 +57,30 @@ const uint BLI_ghash_hash_sizes[] = {
     2053,    4099,    8209,    16411,   32771,    65537,    131101,   262147,    524309,
     1048583, 2097169, 4194319, 8388617, 16777259, 33554467, 67108879, 134217757, 268435459,
 };
-#define hashsizes BLI_ghash_hash_sizes
+BLI_STATIC_ASSERT(ARRAY_SIZE(BLI_ghash_hash_sizes) == 27, "Invalid 'hashsizes' size");
 
-#ifdef GHASH_USE_MODULO_BUCKETS
-#  define GHASH_MAX_SIZE 27
-BLI_STATIC_ASSERT(ARRAY_SIZE(hashsizes) == GHASH_MAX_SIZE, "Invalid 'hashsizes' size");
-#else
-#  define GHASH_BUCKET_BIT_MIN 2
-#  define GHASH_BUCKET_BIT_MAX 28 /* About 268M of buckets... */
-#endif
+/**
+ * The table uses open addressing: buckets are a power of two sized array of (hash, entry) pairs,
+ * probed in the same order as `blender::PythonProbingStrategy`, the default strategy of
+ * `blender::Map` (see `BLI_probing_strategies.hh`).
+ *
+ * Entries themselves are still allocated from a mempool, so the key and value pointers
+ * returned by #BLI_ghash_lookup_p, #BLI_ghash_ensure_p & co. stay valid when the table grows.
+ */
+#define GHASH_BUCKET_BIT_MIN 3
+#define GHASH_BUCKET_BIT_MAX 28 /* About 268M of buckets... */
 
 /**
- * \note Max load #GHASH_LIMIT_GROW used to be 3. (pre 2.74).
- * Python uses 0.6666, tommyhashlib even goes down to 0.5.
- * Reducing our from 3 to 0.75 gives huge speedup
- * (about twice quicker pure GHash insertions/lookup,
- * about 25% - 30% quicker 'dynamic-topology' stroke drawing e.g.).
+ * \note Max load #GHASH_LIMIT_GROW used to be 3 (pre 2.74), then 0.75 for the chained table.
+ * Open addressing degrades quickly once more than half of the buckets are used,
+ * so the max load of `blender::Map` (0.5) is used, removed buckets count towards it.
  * Min load #GHASH_LIMIT_SHRINK is a quarter of max load, to avoid resizing to quickly.
  */
-#define GHASH_LIMIT_GROW(_nbkt) (((_nbkt)*3) / 4)
-#define GHASH_LIMIT_SHRINK(_nbkt) (((_nbkt)*3) / 16)
+#define GHASH_LIMIT_GROW(_nbkt) ((_nbkt) / 2)
+#define GHASH_LIMIT_SHRINK(_nbkt) ((_nbkt) / 8)
 
 /* WARNING! Keep in sync with ugly _gh_Entry in header!!! */
 typedef struct Entry {
-  struct Entry *next;
-
   void *key;
 } Entry;
 
@@ -96,21 +94,29 @@ typedef Entry GSetEntry;
 
 #define GHASH_ENTRY_SIZE(_is_gset) ((_is_gset) ? sizeof(GSetEntry) : sizeof(GHashEntry))
 
+typedef struct GHashBucket {
+  /** NULL when the bucket was never used, #GHASH_BUCKET_REMOVED once its entry got removed. */
+  Entry *e;
+  /** Full hash of the key, avoids calling the compare callback on mismatches and re-hashing. */
+  uint hash;
+} GHashBucket;
+
+#define GHASH_BUCKET_REMOVED ((Entry *)(uintptr_t)1)
+#define GHASH_BUCKET_IS_USED(_bucket) ((uintptr_t)(_bucket)->e > (uintptr_t)GHASH_BUCKET_REMOVED)
+
 struct GHash {
   GHashHashFP hashfp;
   GHashCmpFP cmpfp;
 
-  Entry **buckets;
+  GHashBucket *buckets;
   struct BLI_mempool *entrypool;
   uint nbuckets;
   uint limit_grow, limit_shrink;
-#ifdef GHASH_USE_MODULO_BUCKETS
-  uint cursize, size_min;
-#else
   uint bucket_mask, bucket_bit, bucket_bit_min;
-#endif
 
   uint nentries;
+  /** Number of #GHASH_BUCKET_REMOVED buckets, they make probing longer until the next resize. */
+  uint nremoved;
   uint flag;
 };
 
@@ -149,23 +155,15 @@ BLI_INLINE uint ghash_keyhash(GHash *gh, const void *key)
 }
 
 /**
- * Get the full hash for an entry.
- */
-BLI_INLINE uint ghash_entryhash(GHash *gh, const Entry *e)
-{
-  return gh->hashfp(e->key);
-}
-
-/**
- * Get the bucket-index for an already-computed full hash.
+ * Step to the next bucket of the probing sequence started with `*r_probe = *r_perturb = hash`.
+ *
+ * The perturbation quickly mixes the higher bits of the hash in,
+ * once it reaches zero the sequence visits every bucket.
  */
-BLI_INLINE uint ghash_bucket_index(GHash *gh, const uint hash)
+BLI_INLINE void ghash_probe_next(uint *r_probe, uint *r_perturb)
 {
-#ifdef GHASH_USE_MODULO_BUCKETS
-  return hash % gh->nbuckets;
-#else
-  return hash & gh->bucket_mask;
-#endif
+  *r_perturb >>= 5;
+  *r_probe = 5 * *r_probe + 1 + *r_perturb;
 }
 
 /**
@@ -176,16 +174,13 @@ BLI_INLINE uint ghash_find_next_bucket_index(GHash *gh, uint curr_bucket)
   if (curr_bucket >= gh->nbuckets) {
     curr_bucket = 0;
   }
-  if (gh->buckets[curr_bucket]) {
-    return curr_bucket;
-  }
   for (; curr_bucket < gh->nbuckets; curr_bucket++) {
-    if (gh->buckets[curr_bucket]) {
+    if (GHASH_BUCKET_IS_USED(&gh->buckets[curr_bucket])) {
       return curr_bucket;
     }
   }
   for (curr_bucket = 0; curr_bucket < gh->nbuckets; curr_bucket++) {
-    if (gh->buckets[curr_bucket]) {
+    if (GHASH_BUCKET_IS_USED(&gh->buckets[curr_bucket])) {
       return curr_bucket;
     }
   }
@@ -193,70 +188,43 @@ BLI_INLINE uint ghash_find_next_bucket_index(GHash *gh, uint curr_bucket)
   return 0;
 }
 
+/**
+ * Find the first unused (never used or removed) bucket along the probing sequence of \a hash.
+ */
+BLI_INLINE GHashBucket *ghash_find_free_bucket(GHash *gh, const uint hash)
+{
+  for (uint probe = hash, perturb = hash;; ghash_probe_next(&probe, &perturb)) {
+    GHashBucket *bucket = &gh->buckets[probe & gh->bucket_mask];
+    if (!GHASH_BUCKET_IS_USED(bucket)) {
+      return bucket;
+    }
+  }
+}
+
 /**
  * Expand buckets to the next size up or down.
  */
 static void ghash_buckets_resize(GHash *gh, const uint nbuckets)
 {
-  Entry **buckets_old = gh->buckets;
-  Entry **buckets_new;
+  GHashBucket *buckets_old = gh->buckets;
   const uint nbuckets_old = gh->nbuckets;
-  uint i;
 
-  BLI_assert((gh->nbuckets != nbuckets) || !gh->buckets);
+  BLI_assert((gh->nbuckets != nbuckets) || !gh->buckets || gh->nremoved);
   //  printf("%s: %d -> %d\n", __func__, nbuckets_old, nbuckets);
 
   gh->nbuckets = nbuckets;
-#ifdef GHASH_USE_MODULO_BUCKETS
-#else
   gh->bucket_mask = nbuckets - 1;
-#endif
+  gh->nremoved = 0;
 
-  buckets_new = (Entry **)MEM_callocN(sizeof(*gh->buckets) * gh->nbuckets, __func__);
+  gh->buckets = (GHashBucket *)MEM_callocN(sizeof(*gh->buckets) * gh->nbuckets, __func__);
 
   if (buckets_old) {
-    if (nbuckets > nbuckets_old) {
-      for (i = 0; i < nbuckets_old; i++) {
-        for (Entry *e = buckets_old[i], *e_next; e; e = e_next) {
-          const uint hash = ghash_entryhash(gh, e);
-          const uint bucket_index = ghash_bucket_index(gh, hash);
-          e_next = e->next;
-          e->next = buckets_new[bucket_index];
-          buckets_new[bucket_index] = e;
-        }
-      }
-    }
-    else {
-      for (i = 0; i < nbuckets_old; i++) {
-#ifdef GHASH_USE_MODULO_BUCKETS
-        for (Entry *e = buckets_old[i], *e_next; e; e = e_next) {
-          const uint hash = ghash_entryhash(gh, e);
-          const uint bucket_index = ghash_bucket_index(gh, hash);
-          e_next = e->next;
-          e->next = buckets_new[bucket_index];
-          buckets_new[bucket_index] = e;
-        }
-#else
-        /* No need to recompute hashes in this case, since our mask is just smaller,
-         * all items in old bucket 'i' will go in same new bucket (i & new_mask)! */
-        const uint bucket_index = ghash_bucket_index(gh, i);
-        BLI_assert(!buckets_old[i] ||
-                   (bucket_index == ghash_bucket_index(gh, ghash_entryhash(gh, buckets_old[i]))));
-        Entry *e;
-        for (e = buckets_old[i]; e && e->next; e = e->next) {
-          /* pass */
-        }
-        if (e) {
-          e->next = buckets_new[bucket_index];
-          buckets_new[bucket_index] = buckets_old[i];
-        }
-#endif
+    /* Hashes are stored, no need to call the hash callback again. */
+    for (uint i = 0; i < nbuckets_old; i++) {
+      if (GHASH_BUCKET_IS_USED(&buckets_old[i])) {
+        *ghash_find_free_bucket(gh, buckets_old[i].hash) = buckets_old[i];
       }
     }
-  }
-
-  gh->buckets = buckets_new;
-  if (buckets_old) {
     MEM_freeN(buckets_old);
   }
 }
@@ -269,34 +237,31 @@ static void ghash_buckets_expand(GHash *gh, const uint nentries, const bool user
 {
   uint new_nbuckets;
 
-  if (LIKELY(gh->buckets && (nentries < gh->limit_grow))) {
+  if (LIKELY(gh->buckets && (nentries + gh->nremoved < gh->limit_grow))) {
     return;
   }
 
   new_nbuckets = gh->nbuckets;
 
-#ifdef GHASH_USE_MODULO_BUCKETS
-  while ((nentries > gh->limit_grow) && (gh->cursize < GHASH_MAX_SIZE - 1)) {
-    new_nbuckets = hashsizes[++gh->cursize];
-    gh->limit_grow = GHASH_LIMIT_GROW(new_nbuckets);
-  }
-#else
   while ((nentries > gh->limit_grow) && (gh->bucket_bit < GHASH_BUCKET_BIT_MAX)) {
     new_nbuckets = 1u << ++gh->bucket_bit;
     gh->limit_grow = GHASH_LIMIT_GROW(new_nbuckets);
   }
-#endif
 
   if (user_defined) {
-#ifdef GHASH_USE_MODULO_BUCKETS
-    gh->size_min = gh->cursize;
-#else
     gh->bucket_bit_min = gh->bucket_bit;
-#endif
   }
 
   if ((new_nbuckets == gh->nbuckets) && gh->buckets) {
-    return;
+    if (nentries + gh->nremoved <= gh->limit_grow) {
+      return;
+    }
+    /* Removed buckets are too many, rebuild the table to get rid of them.
+     * Grow at the same time when it's still more than half full,
+     * so cycles of removal and insertion don't rebuild it over and over. */
+    if ((nentries > gh->limit_grow / 2) && (gh->bucket_bit < GHASH_BUCKET_BIT_MAX)) {
+      new_nbuckets = 1u << ++gh->bucket_bit;
+    }
   }
 
   gh->limit_grow = GHASH_LIMIT_GROW(new_nbuckets);
@@ -321,24 +286,13 @@ static void ghash_buckets_contract(GHash *gh,
 
   new_nbuckets = gh->nbuckets;
 
-#ifdef GHASH_USE_MODULO_BUCKETS
-  while ((nentries < gh->limit_shrink) && (gh->cursize > gh->size_min)) {
-    new_nbuckets = hashsizes[--gh->cursize];
-    gh->limit_shrink = GHASH_LIMIT_SHRINK(new_nbuckets);
-  }
-#else
   while ((nentries < gh->limit_shrink) && (gh->bucket_bit > gh->bucket_bit_min)) {
     new_nbuckets = 1u << --gh->bucket_bit;
     gh->limit_shrink = GHASH_LIMIT_SHRINK(new_nbuckets);
   }
-#endif
 
   if (user_defined) {
-#ifdef GHASH_USE_MODULO_BUCKETS
-    gh->size_min = gh->cursize;
-#else
     gh->bucket_bit_min = gh->bucket_bit;
-#endif
   }
 
   if ((new_nbuckets == gh->nbuckets) && gh->buckets) {
@@ -357,66 +311,74 @@ BLI_INLINE void ghash_buckets_reset(GHash *gh, const uint nentries)
 {
   MEM_SAFE_FREE(gh->buckets);
 
-#ifdef GHASH_USE_MODULO_BUCKETS
-  gh->cursize = 0;
-  gh->size_min = 0;
-  gh->nbuckets = hashsizes[gh->cursize];
-#else
   gh->bucket_bit = GHASH_BUCKET_BIT_MIN;
   gh->bucket_bit_min = GHASH_BUCKET_BIT_MIN;
   gh->nbuckets = 1u << gh->bucket_bit;
   gh->bucket_mask = gh->nbuckets - 1;
-#endif
 
   gh->limit_grow = GHASH_LIMIT_GROW(gh->nbuckets);
   gh->limit_shrink = GHASH_LIMIT_SHRINK(gh->nbuckets);
 
   gh->nentries = 0;
+  gh->nremoved = 0;
 
   ghash_buckets_expand(gh, nentries, (nentries != 0));
 }
 
 /**
- * Internal lookup function.
- * Takes hash and bucket_index arguments to avoid calling #ghash_keyhash and #ghash_bucket_index
- * multiple times.
+ * Internal lookup function, returns the bucket holding \a key or NULL.
+ * Takes the hash argument to avoid calling #ghash_keyhash multiple times.
  */
-BLI_INLINE Entry *ghash_lookup_entry_ex(GHash *gh, const void *key, const uint bucket_index)
+BLI_INLINE GHashBucket *ghash_lookup_bucket_ex(GHash *gh, const void *key, const uint hash)
 {
-  Entry *e;
-  /* If we do not store GHash, not worth computing it for each entry here!
-   * Typically, comparison function will be quicker, and since it's needed in the end anyway... */
-  for (e = gh->buckets[bucket_index]; e; e = e->next) {
-    if (UNLIKELY(gh->cmpfp(key, e->key) == false)) {
-      return e;
+  for (uint probe = hash, perturb = hash;; ghash_probe_next(&probe, &perturb)) {
+    GHashBucket *bucket = &gh->buckets[probe & gh->bucket_mask];
+    if (bucket->e == NULL) {
+      return NULL;
+    }
+    if ((bucket->hash == hash) && (bucket->e != GHASH_BUCKET_REMOVED) &&
+        UNLIKELY(gh->cmpfp(key, bucket->e->key) == false)) {
+      return bucket;
     }
   }
-
-  return NULL;
 }
 
 /**
- * Internal lookup function, returns previous entry of target one too.
- * Takes bucket_index argument to avoid calling #ghash_keyhash and #ghash_bucket_index
- * multiple times.
- * Useful when modifying buckets somehow (like removing an entry...).
- */
-BLI_INLINE Entry *ghash_lookup_entry_prev_ex(GHash *gh,
-                                             const void *key,
-                                             Entry **r_e_prev,
-                                             const uint bucket_index)
-{
-  /* If we do not store GHash, not worth computing it for each entry here!
-   * Typically, comparison function will be quicker, and since it's needed in the end anyway... */
-  for (Entry *e_prev = NULL, *e = gh->buckets[bucket_index]; e; e_prev = e, e = e->next) {
-    if (UNLIKELY(gh->cmpfp(key, e->key) == false)) {
-      *r_e_prev = e_prev;
-      return e;
+ * Internal lookup function for insertion, returns the bucket holding \a key when found,
+ * otherwise the bucket a new entry for \a key should be stored in
+ * (the first removed bucket of the probing sequence, if any).
+ */
+BLI_INLINE GHashBucket *ghash_lookup_bucket_for_insert_ex(GHash *gh,
+                                                          const void *key,
+                                                          const uint hash,
+                                                          bool *r_found)
+{
+  GHashBucket *bucket_free = NULL;
+  for (uint probe = hash, perturb = hash;; ghash_probe_next(&probe, &perturb)) {
+    GHashBucket *bucket = &gh->buckets[probe & gh->bucket_mask];
+    if (bucket->e == NULL) {
+      *r_found = false;
+      return bucket_free ? bucket_free : bucket;
+    }
+    if (bucket->e == GHASH_BUCKET_REMOVED) {
+      if (bucket_free == NULL) {
+        bucket_free = bucket;
+      }
+    }
+    else if ((bucket->hash == hash) && UNLIKELY(gh->cmpfp(key, bucket->e->key) == false)) {
+      *r_found = true;
+      return bucket;
     }
   }
+}
 
-  *r_e_prev = NULL;
-  return NULL;
+/**
+ * Internal lookup function. Takes the hash argument to avoid calling #ghash_keyhash multiple times.
+ */
+BLI_INLINE Entry *ghash_lookup_entry_ex(GHash *gh, const void *key, const uint hash)
+{
+  GHashBucket *bucket = ghash_lookup_bucket_ex(gh, key, hash);
+  return bucket ? bucket->e : NULL;
 }
 
 /**
@@ -425,8 +387,7 @@ BLI_INLINE Entry *ghash_lookup_entry_prev_ex(GHash *gh,
 BLI_INLINE Entry *ghash_lookup_entry(GHash *gh, const void *key)
 {
   const uint hash = ghash_keyhash(gh, key);
-  const uint bucket_index = ghash_bucket_index(gh, hash);
-  return ghash_lookup_entry_ex(gh, key, bucket_index);
+  return ghash_lookup_entry_ex(gh, key, hash);
 }
 
 static GHash *ghash_new(GHashHashFP hashfp,
@@ -451,65 +412,57 @@ static GHash *ghash_new(GHashHashFP hashfp,
 }
 
 /**
- * Internal insert function.
- * Takes hash and bucket_index arguments to avoid calling #ghash_keyhash and #ghash_bucket_index
- * multiple times.
+ * Store \a e in the given unused \a bucket (which must be part of the probing sequence of
+ * \a hash), then grow the buckets if needed.
  */
-BLI_INLINE void ghash_insert_ex(GHash *gh, void *key, void *val, const uint bucket_index)
+BLI_INLINE void ghash_insert_bucket(GHash *gh, GHashBucket *bucket, Entry *e, const uint hash)
 {
-  GHashEntry *e = BLI_mempool_alloc(gh->entrypool);
-
-  BLI_assert((gh->flag & GHASH_FLAG_ALLOW_DUPES) || (BLI_ghash_haskey(gh, key) == 0));
-  BLI_assert(!(gh->flag & GHASH_FLAG_IS_GSET));
+  BLI_assert(!GHASH_BUCKET_IS_USED(bucket));
 
-  e->e.next = gh->buckets[bucket_index];
-  e->e.key = key;
-  e->val = val;
-  gh->buckets[bucket_index] = (Entry *)e;
+  if (bucket->e == GHASH_BUCKET_REMOVED) {
+    gh->nremoved--;
+  }
+  bucket->e = e;
+  bucket->hash = hash;
 
   ghash_buckets_expand(gh, ++gh->nentries, false);
 }
 
 /**
- * Insert function that takes a pre-allocated entry.
+ * Internal insert function.
+ * Takes the hash argument to avoid calling #ghash_keyhash multiple times.
  */
-BLI_INLINE void ghash_insert_ex_keyonly_entry(GHash *gh,
-                                              void *key,
-                                              const uint bucket_index,
-                                              Entry *e)
+BLI_INLINE void ghash_insert_ex(GHash *gh, void *key, void *val, const uint hash)
 {
-  BLI_assert((gh->flag & GHASH_FLAG_ALLOW_DUPES) || (BLI_ghash_haskey(gh, key) == 0));
+  GHashEntry *e = BLI_mempool_alloc(gh->entrypool);
 
-  e->next = gh->buckets[bucket_index];
-  e->key = key;
-  gh->buckets[bucket_index] = e;
+  BLI_assert((gh->flag & GHASH_FLAG_ALLOW_DUPES) || (BLI_ghash_haskey(gh, key) == 0));
+  BLI_assert(!(gh->flag & GHASH_FLAG_IS_GSET));
 
-  ghash_buckets_expand(gh, ++gh->nentries, false);
+  e->e.key = key;
+  e->val = val;
+  ghash_insert_bucket(gh, ghash_find_free_bucket(gh, hash), (Entry *)e, hash);
 }
 
 /**
  * Insert function that doesn't set the value (use for GSet)
  */
-BLI_INLINE void ghash_insert_ex_keyonly(GHash *gh, void *key, const uint bucket_index)
+BLI_INLINE void ghash_insert_ex_keyonly(GHash *gh, void *key, const uint hash)
 {
   Entry *e = BLI_mempool_alloc(gh->entrypool);
 
   BLI_assert((gh->flag & GHASH_FLAG_ALLOW_DUPES) || (BLI_ghash_haskey(gh, key) == 0));
   BLI_assert((gh->flag & GHASH_FLAG_IS_GSET) != 0);
 
-  e->next = gh->buckets[bucket_index];
   e->key = key;
-  gh->buckets[bucket_index] = e;
-
-  ghash_buckets_expand(gh, ++gh->nentries, false);
+  ghash_insert_bucket(gh, ghash_find_free_bucket(gh, hash), e, hash);
 }
 
 BLI_INLINE void ghash_insert(GHash *gh, void *key, void *val)
 {
   const uint hash = ghash_keyhash(gh, key);
-  const uint bucket_index = ghash_bucket_index(gh, hash);
 
-  ghash_insert_ex(gh, key, val, bucket_index);
+  ghash_insert_ex(gh, key, val, hash);
 }
 
 BLI_INLINE bool ghash_insert_safe(GHash *gh,
@@ -520,12 +473,13 @@ BLI_INLINE bool ghash_insert_safe(GHash *gh,
                                   GHashValFreeFP valfreefp)
 {
   const uint hash = ghash_keyhash(gh, key);
-  const uint bucket_index = ghash_bucket_index(gh, hash);
-  GHashEntry *e = (GHashEntry *)ghash_lookup_entry_ex(gh, key, bucket_index);
+  bool found;
+  GHashBucket *bucket = ghash_lookup_bucket_for_insert_ex(gh, key, hash, &found);
 
   BLI_assert(!(gh->flag & GHASH_FLAG_IS_GSET));
 
-  if (e) {
+  if (found) {
+    GHashEntry *e = (GHashEntry *)bucket->e;
     if (override) {
       if (keyfreefp) {
         keyfreefp(e->e.key);
@@ -538,7 +492,11 @@ BLI_INLINE bool ghash_insert_safe(GHash *gh,
     }
     return false;
   }
-  ghash_insert_ex(gh, key, val, bucket_index);
+
+  GHashEntry *e = BLI_mempool_alloc(gh->entrypool);
+  e->e.key = key;
+  e->val = val;
+  ghash_insert_bucket(gh, bucket, (Entry *)e, hash);
   return true;
 }
 
@@ -548,24 +506,61 @@ BLI_INLINE bool ghash_insert_safe_keyonly(GHash *gh,
                                           GHashKeyFreeFP keyfreefp)
 {
   const uint hash = ghash_keyhash(gh, key);
-  const uint bucket_index = ghash_bucket_index(gh, hash);
-  Entry *e = ghash_lookup_entry_ex(gh, key, bucket_index);
+  bool found;
+  GHashBucket *bucket = ghash_lookup_bucket_for_insert_ex(gh, key, hash, &found);
 
   BLI_assert((gh->flag & GHASH_FLAG_IS_GSET) != 0);
 
-  if (e) {
+  if (found) {
     if (override) {
       if (keyfreefp) {
-        keyfreefp(e->key);
+        keyfreefp(bucket->e->key);
       }
-      e->key = key;
+      bucket->e->key = key;
     }
     return false;
   }
-  ghash_insert_ex_keyonly(gh, key, bucket_index);
+
+  Entry *e = BLI_mempool_alloc(gh->entrypool);
+  e->key = key;
+  ghash_insert_bucket(gh, bucket, e, hash);
   return true;
 }
 
+/**
+ * Lookup \a key, adding a new (uninitialized) entry for it when it's not found.
+ *
+ * \return the entry, \a r_haskey is set when it already existed.
+ */
+BLI_INLINE Entry *ghash_ensure_entry(GHash *gh, const void *key, bool *r_haskey)
+{
+  const uint hash = ghash_keyhash(gh, key);
+  GHashBucket *bucket = ghash_lookup_bucket_for_insert_ex(gh, key, hash, r_haskey);
+
+  if (*r_haskey) {
+    return bucket->e;
+  }
+
+  Entry *e = BLI_mempool_alloc(gh->entrypool);
+  e->key = (void *)key;
+  ghash_insert_bucket(gh, bucket, e, hash);
+  return e;
+}
+
+/**
+ * Mark the used \a bucket as removed. Its entry is left to the caller.
+ */
+BLI_INLINE void ghash_remove_bucket(GHash *gh, GHashBucket *bucket)
+{
+  BLI_assert(GHASH_BUCKET_IS_USED(bucket));
+
+  /* Other entries may have been probed past this bucket, it can't simply be cleared. */
+  bucket->e = GHASH_BUCKET_REMOVED;
+  gh->nremoved++;
+
+  ghash_buckets_contract(gh, --gh->nentries, false, false);
+}
+
 /**
  * Remove the entry and return it, caller must free from gh->entrypool.
  */
@@ -573,14 +568,14 @@ static Entry *ghash_remove_ex(GHash *gh,
                               const void *key,
                               GHashKeyFreeFP keyfreefp,
                               GHashValFreeFP valfreefp,
-                              const uint bucket_index)
+                              const uint hash)
 {
-  Entry *e_prev;
-  Entry *e = ghash_lookup_entry_prev_ex(gh, key, &e_prev, bucket_index);
+  GHashBucket *bucket = ghash_lookup_bucket_ex(gh, key, hash);
 
   BLI_assert(!valfreefp || !(gh->flag & GHASH_FLAG_IS_GSET));
 
-  if (e) {
+  if (bucket) {
+    Entry *e = bucket->e;
     if (keyfreefp) {
       keyfreefp(e->key);
     }
@@ -588,17 +583,11 @@ static Entry *ghash_remove_ex(GHash *gh,
       valfreefp(((GHashEntry *)e)->val);
     }
 
-    if (e_prev) {
-      e_prev->next = e->next;
-    }
-    else {
-      gh->buckets[bucket_index] = e->next;
-    }
-
-    ghash_buckets_contract(gh, --gh->nentries, false, false);
+    ghash_remove_bucket(gh, bucket);
+    return e;
   }
 
-  return e;
+  return NULL;
 }
 
 /**
@@ -616,10 +605,10 @@ static Entry *ghash_pop(GHash *gh, GHashIterState *state)
    * in case we are popping from a large ghash with few items in it... */
   curr_bucket = ghash_find_next_bucket_index(gh, curr_bucket);
 
-  Entry *e = gh->buckets[curr_bucket];
-  BLI_assert(e);
+  Entry *e = gh->buckets[curr_bucket].e;
+  BLI_assert(GHASH_BUCKET_IS_USED(&gh->buckets[curr_bucket]));
 
-  ghash_remove_ex(gh, e->key, NULL, NULL, curr_bucket);
+  ghash_remove_bucket(gh, &gh->buckets[curr_bucket]);
 
   state->curr_bucket = curr_bucket;
   return e;
@@ -636,9 +625,8 @@ static void ghash_free_cb(GHash *gh, GHashKeyFreeFP keyfreefp, GHashValFreeFP va
   BLI_assert(!valfreefp || !(gh->flag & GHASH_FLAG_IS_GSET));
 
   for (i = 0; i < gh->nbuckets; i++) {
-    Entry *e;
-
-    for (e = gh->buckets[i]; e; e = e->next) {
+    if (GHASH_BUCKET_IS_USED(&gh->buckets[i])) {
+      Entry *e = gh->buckets[i].e;
       if (keyfreefp) {
         keyfreefp(e->key);
       }
@@ -667,20 +655,16 @@ static GHash *ghash_copy(GHash *gh, GHashKeyCopyFP keycopyfp, GHashValCopyFP val
   BLI_assert(gh_new->nbuckets == gh->nbuckets);
 
   for (i = 0; i < gh->nbuckets; i++) {
-    Entry *e;
-
-    for (e = gh->buckets[i]; e; e = e->next) {
+    const GHashBucket *bucket = &gh->buckets[i];
+    if (GHASH_BUCKET_IS_USED(bucket)) {
       Entry *e_new = BLI_mempool_alloc(gh_new->entrypool);
-      ghash_entry_copy(gh_new, e_new, gh, e, keycopyfp, valcopyfp);
+      ghash_entry_copy(gh_new, e_new, gh, bucket->e, keycopyfp, valcopyfp);
 
-      /* Warning!
-       * This means entries in buckets in new copy will be in reversed order!
-       * This shall not be an issue though, since order should never be assumed in ghash. */
-
-      /* Note: We can use 'i' here, since we are sure that
-       * 'gh' and 'gh_new' have the same number of buckets! */
-      e_new->next = gh_new->buckets[i];
-      gh_new->buckets[i] = e_new;
+      /* Note: buckets can't be copied as-is, removed buckets of \a gh are not copied,
+       * which may break the probing sequence of following entries. Hashes are known though. */
+      GHashBucket *bucket_new = ghash_find_free_bucket(gh_new, bucket->hash);
+      bucket_new->e = e_new;
+      bucket_new->hash = bucket->hash;
     }
   }
   gh_new->nentries = gh->nentries;
@@ -781,8 +765,7 @@ bool BLI_ghash_reinsert(
 void *BLI_ghash_replace_key(GHash *gh, void *key)
 {
   const uint hash = ghash_keyhash(gh, key);
-  const uint bucket_index = ghash_bucket_index(gh, hash);
-  GHashEntry *e = (GHashEntry *)ghash_lookup_entry_ex(gh, key, bucket_index);
+  GHashEntry *e = (GHashEntry *)ghash_lookup_entry_ex(gh, key, hash);
   if (e != NULL) {
     void *key_prev = e->e.key;
     e->e.key = key;
@@ -850,15 +833,10 @@ void **BLI_ghash_lookup_p(GHash *gh, const void *key)
  */
 bool BLI_ghash_ensure_p(GHash *gh, void *key, void ***r_val)
 {
-  const uint hash = ghash_keyhash(gh, key);
-  const uint bucket_index = ghash_bucket_index(gh, hash);
-  GHashEntry *e = (GHashEntry *)ghash_lookup_entry_ex(gh, key, bucket_index);
-  const bool haskey = (e != NULL);
+  bool haskey;
+  GHashEntry *e = (GHashEntry *)ghash_ensure_entry(gh, key, &haskey);
 
-  if (!haskey) {
-    e = BLI_mempool_alloc(gh->entrypool);
-    ghash_insert_ex_keyonly_entry(gh, key, bucket_index, (Entry *)e);
-  }
+  BLI_assert(!(gh->flag & GHASH_FLAG_IS_GSET));
 
   *r_val = &e->val;
   return haskey;
@@ -872,15 +850,12 @@ bool BLI_ghash_ensure_p(GHash *gh, void *key, void ***r_val)
  */
 bool BLI_ghash_ensure_p_ex(GHash *gh, const void *key, void ***r_key, void ***r_val)
 {
-  const uint hash = ghash_keyhash(gh, key);
-  const uint bucket_index = ghash_bucket_index(gh, hash);
-  GHashEntry *e = (GHashEntry *)ghash_lookup_entry_ex(gh, key, bucket_index);
-  const bool haskey = (e != NULL);
+  bool haskey;
+  GHashEntry *e = (GHashEntry *)ghash_ensure_entry(gh, key, &haskey);
+
+  BLI_assert(!(gh->flag & GHASH_FLAG_IS_GSET));
 
   if (!haskey) {
-    /* Pass 'key' in case we resize. */
-    e = BLI_mempool_alloc(gh->entrypool);
-    ghash_insert_ex_keyonly_entry(gh, (void *)key, bucket_index, (Entry *)e);
     e->e.key = NULL; /* caller must re-assign */
   }
 
@@ -903,8 +878,7 @@ bool BLI_ghash_remove(GHash *gh,
                       GHashValFreeFP valfreefp)
 {
   const uint hash = ghash_keyhash(gh, key);
-  const uint bucket_index = ghash_bucket_index(gh, hash);
-  Entry *e = ghash_remove_ex(gh, key, keyfreefp, valfreefp, bucket_index);
+  Entry *e = ghash_remove_ex(gh, key, keyfreefp, valfreefp, hash);
   if (e) {
     BLI_mempool_free(gh->entrypool, e);
     return true;
@@ -924,8 +898,7 @@ bool BLI_ghash_remove(GHash *gh,
 void *BLI_ghash_popkey(GHash *gh, const void *key, GHashKeyFreeFP keyfreefp)
 {
   const uint hash = ghash_keyhash(gh, key);
-  const uint bucket_index = ghash_bucket_index(gh, hash);
-  GHashEntry *e = (GHashEntry *)ghash_remove_ex(gh, key, keyfreefp, NULL, bucket_index);
+  GHashEntry *e = (GHashEntry *)ghash_remove_ex(gh, key, keyfreefp, NULL, hash);
   BLI_assert(!(gh->flag & GHASH_FLAG_IS_GSET));
   if (e) {
     void *val = e->val;
@@ -1054,6 +1027,21 @@ GHashIterator *BLI_ghashIterator_new(GHash *gh)
   return ghi;
 }
 
+/**
+ * Advance \a ghi to the next used bucket, or to the end.
+ */
+BLI_INLINE void ghash_iterator_next(GHashIterator *ghi)
+{
+  GHash *gh = ghi->gh;
+  ghi->curEntry = NULL;
+  while (++ghi->curBucket < gh->nbuckets) {
+    if (GHASH_BUCKET_IS_USED(&gh->buckets[ghi->curBucket])) {
+      ghi->curEntry = gh->buckets[ghi->curBucket].e;
+      break;
+    }
+  }
+}
+
 /**
  * Init an already allocated GHashIterator. The hash table must not
  * be mutated while the iterator is in use, and the iterator will
@@ -1068,13 +1056,7 @@ void BLI_ghashIterator_init(GHashIterator *ghi, GHash *gh)
   ghi->curEntry = NULL;
   ghi->curBucket = UINT_MAX; /* wraps to zero */
   if (gh->nentries) {
-    do {
-      ghi->curBucket++;
-      if (UNLIKELY(ghi->curBucket == ghi->gh->nbuckets)) {
-        break;
-      }
-      ghi->curEntry = ghi->gh->buckets[ghi->curBucket];
-    } while (!ghi->curEntry);
+    ghash_iterator_next(ghi);
   }
 }
 
@@ -1086,14 +1068,7 @@ void BLI_ghashIterator_init(GHashIterator *ghi, GHash *gh)
 void BLI_ghashIterator_step(GHashIterator *ghi)
 {
   if (ghi->curEntry) {
-    ghi->curEntry = ghi->curEntry->next;
-    while (!ghi->curEntry) {
-      ghi->curBucket++;
-      if (ghi->curBucket == ghi->gh->nbuckets) {
-        break;
-      }
-      ghi->curEntry = ghi->gh->buckets[ghi->curBucket];
-    }
+    ghash_iterator_next(ghi);
   }
 }
 
@@ -1147,8 +1122,7 @@ uint BLI_gset_len(GSet *gs)
 void BLI_gset_insert(GSet *gs, void *key)
 {
   const uint hash = ghash_keyhash((GHash *)gs, key);
-  const uint bucket_index = ghash_bucket_index((GHash *)gs, hash);
-  ghash_insert_ex_keyonly((GHash *)gs, key, bucket_index);
+  ghash_insert_ex_keyonly((GHash *)gs, key, hash);
 }
 
 /**
@@ -1170,15 +1144,10 @@ bool BLI_gset_add(GSet *gs, void *key)
  */
 bool BLI_gset_ensure_p_ex(GSet *gs, const void *key, void ***r_key)
 {
-  const uint hash = ghash_keyhash((GHash *)gs, key);
-  const uint bucket_index = ghash_bucket_index((GHash *)gs, hash);
-  GSetEntry *e = (GSetEntry *)ghash_lookup_entry_ex((GHash *)gs, key, bucket_index);
-  const bool haskey = (e != NULL);
+  bool haskey;
+  GSetEntry *e = (GSetEntry *)ghash_ensure_entry((GHash *)gs, key, &haskey);
 
   if (!haskey) {
-    /* Pass 'key' in case we resize */
-    e = BLI_mempool_alloc(((GHash *)gs)->entrypool);
-    ghash_insert_ex_keyonly_entry((GHash *)gs, (void *)key, bucket_index, (Entry *)e);
     e->key = NULL; /* caller must re-assign */
   }
 
@@ -1290,8 +1259,7 @@ void *BLI_gset_lookup(GSet *gs, const void *key)
 void *BLI_gset_pop_key(GSet *gs, const void *key)
 {
   const uint hash = ghash_keyhash((GHash *)gs, key);
-  const uint bucket_index = ghash_bucket_index((GHash *)gs, hash);
-  Entry *e = ghash_remove_ex((GHash *)gs, key, NULL, NULL, bucket_index);
+  Entry *e = ghash_remove_ex((GHash *)gs, key, NULL, NULL, hash);
   if (e) {
     void *key_ret = e->key;
     BLI_mempool_free(((GHash *)gs)->entrypool, e);
@@ -1306,8 +1274,6 @@ void *BLI_gset_pop_key(GSet *gs, const void *key)
 /** \name Debugging & Introspection
  * \{ */
 
-#include "BLI_math.h"
-
 /**
  * \return number of buckets in the GHash.
  */
@@ -1321,9 +1287,26 @@ int BLI_gset_buckets_len(GSet *gs)
 }
 
 /**
- * Measure how well the hash function performs (1.0 is approx as good as random distribution),
- * and return a few other stats like load,
- * variance of the distribution of the entries in the buckets, etc.
+ * Number of buckets probed to find the entry stored in \a bucket.
+ */
+static uint ghash_bucket_probe_len(GHash *gh, const GHashBucket *bucket)
+{
+  uint len = 1;
+  for (uint probe = bucket->hash, perturb = bucket->hash;
+       &gh->buckets[probe & gh->bucket_mask] != bucket;
+       ghash_probe_next(&probe, &perturb)) {
+    len++;
+  }
+  return len;
+}
+
+/**
+ * Measure how well the hash function performs (1.0 is the best possible value, every entry is
+ * found in the first probed bucket), and return a few other stats like load,
+ * variance of the probing lengths of the entries, etc.
+ *
+ * Since buckets hold a single entry, "overloaded" ones are entries not stored in their first
+ * probed bucket, and the biggest bucket is the longest probing sequence.
  *
  * Smaller is better!
  */
@@ -1335,6 +1318,9 @@ double BLI_ghash_calc_quality_ex(GHash *gh,
                                  int *r_biggest_bucket)
 {
   double mean;
+  uint64_t sum = 0;
+  uint64_t sum_overloaded = 0;
+  uint biggest = 0;
   uint i;
 
   if (gh->nentries == 0) {
@@ -1357,62 +1343,46 @@ double BLI_ghash_calc_quality_ex(GHash *gh,
     return 0.0;
   }
 
-  mean = (double)gh->nentries / (double)gh->nbuckets;
+  for (i = 0; i < gh->nbuckets; i++) {
+    if (GHASH_BUCKET_IS_USED(&gh->buckets[i])) {
+      const uint len = ghash_bucket_probe_len(gh, &gh->buckets[i]);
+      sum += len;
+      if (len > 1) {
+        sum_overloaded++;
+      }
+      biggest = MAX2(biggest, len);
+    }
+  }
+  mean = (double)sum / (double)gh->nentries;
+
   if (r_load) {
-    *r_load = mean;
+    *r_load = (double)gh->nentries / (double)gh->nbuckets;
+  }
+  if (r_prop_empty_buckets) {
+    *r_prop_empty_buckets = (double)(gh->nbuckets - gh->nentries) / (double)gh->nbuckets;
+  }
+  if (r_prop_overloaded_buckets) {
+    *r_prop_overloaded_buckets = (double)sum_overloaded / (double)gh->nentries;
   }
   if (r_biggest_bucket) {
-    *r_biggest_bucket = 0;
+    *r_biggest_bucket = (int)biggest;
   }
 
   if (r_variance) {
-    /* We already know our mean (i.e. load factor), easy to compute variance.
+    /* We already know our mean, easy to compute variance.
      * See https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Two-pass_algorithm
      */
-    double sum = 0.0;
+    double sum_sq = 0.0;
     for (i = 0; i < gh->nbuckets; i++) {
-      int count = 0;
-      Entry *e;
-      for (e = gh->buckets[i]; e; e = e->next) {
-        count++;
+      if (GHASH_BUCKET_IS_USED(&gh->buckets[i])) {
+        const double len = (double)ghash_bucket_probe_len(gh, &gh->buckets[i]);
+        sum_sq += (len - mean) * (len - mean);
       }
-      sum += ((double)count - mean) * ((double)count - mean);
     }
-    *r_variance = sum / (double)(gh->nbuckets - 1);
+    *r_variance = (gh->nentries > 1) ? sum_sq / (double)(gh->nentries - 1) : 0.0;
   }
 
-  {
-    uint64_t sum = 0;
-    uint64_t overloaded_buckets_threshold = (uint64_t)max_ii(GHASH_LIMIT_GROW(1), 1);
-    uint64_t sum_overloaded = 0;
-    uint64_t sum_empty = 0;
-
-    for (i = 0; i < gh->nbuckets; i++) {
-      uint64_t count = 0;
-      Entry *e;
-      for (e = gh->buckets[i]; e; e = e->next) {
-        count++;
-      }
-      if (r_biggest_bucket) {
-        *r_biggest_bucket = max_ii(*r_biggest_bucket, (int)count);
-      }
-      if (r_prop_overloaded_buckets && (count > overloaded_buckets_threshold)) {
-        sum_overloaded++;
-      }
-      if (r_prop_empty_buckets && !count) {
-        sum_empty++;
-      }
-      sum += count * (count + 1);
-    }
-    if (r_prop_overloaded_buckets) {
-      *r_prop_overloaded_buckets = (double)sum_overloaded / (double)gh->nbuckets;
-    }
-    if (r_prop_empty_buckets) {
-      *r_prop_empty_buckets = (double)sum_empty / (double)gh->nbuckets;
-    }
-    return ((double)sum * (double)gh->nbuckets /
-            ((double)gh->nentries * (gh->nentries + 2 * gh->nbuckets - 1)));
-  }
+  return mean;
 }
 double BLI_gset_calc_quality_ex(GSet *gs,
                                 double *r_load,
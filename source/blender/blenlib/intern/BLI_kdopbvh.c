@@ -50,6 +50,7 @@
 
 #include "BLI_strict_flags.h"
 
+
 /* used for iterative_raycast */
 // #define USE_SKIP_LINKS
 
@@ -61,6 +62,12 @@
 
 #define MAX_TREETYPE 32
 
+#ifdef __SSE2__
+#  include <emmintrin.h>
+/* Children are tested four at a time, writing results for all four. */
+BLI_STATIC_ASSERT(MAX_TREETYPE % 4 == 0, "MAX_TREETYPE must be a multiple of 4")
+#endif
+
 /* Setting zero so we can catch bugs in BLI_task/KDOPBVH.
  * TODO(sergey): Deduplicate the limits with PBVH from BKE.
  */
@@ -414,6 +421,71 @@ static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int e
   }
 }
 
+typedef struct BVHRefitData {
+  const BVHTree *tree;
+} BVHRefitData;
+
+typedef struct BVHRefitChunk {
+  float bv[26];
+} BVHRefitChunk;
+
+static void bv_join(const BVHTree *tree, float *__restrict bv, const float *__restrict bv_other)
+{
+  for (axis_t axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
+    if (bv_other[(2 * axis_iter)] < bv[(2 * axis_iter)]) {
+      bv[(2 * axis_iter)] = bv_other[(2 * axis_iter)];
+    }
+    if (bv_other[(2 * axis_iter) + 1] > bv[(2 * axis_iter) + 1]) {
+      bv[(2 * axis_iter) + 1] = bv_other[(2 * axis_iter) + 1];
+    }
+  }
+}
+
+static void refit_kdop_hull_task_cb(void *__restrict userdata,
+                                    const int j,
+                                    const TaskParallelTLS *__restrict tls)
+{
+  const BVHRefitData *data = userdata;
+  BVHRefitChunk *chunk = tls->userdata_chunk;
+  bv_join(data->tree, chunk->bv, data->tree->nodes[j]->bv);
+}
+
+static void refit_kdop_hull_reduce(const void *__restrict userdata,
+                                   void *__restrict chunk_join,
+                                   void *__restrict chunk)
+{
+  const BVHRefitData *data = userdata;
+  bv_join(data->tree, ((BVHRefitChunk *)chunk_join)->bv, ((BVHRefitChunk *)chunk)->bv);
+}
+
+/**
+ * A version of #refit_kdop_hull which joins the leafs from multiple threads,
+ * used for the branches close to the root which contain most of the leafs.
+ */
+static void refit_kdop_hull_parallel(const BVHTree *tree, BVHNode *node, int start, int end)
+{
+  if (end - start <= KDOPBVH_THREAD_LEAF_THRESHOLD) {
+    refit_kdop_hull(tree, node, start, end);
+    return;
+  }
+
+  node_minmax_init(tree, node);
+
+  BVHRefitData data = {.tree = tree};
+  BVHRefitChunk chunk;
+  memcpy(chunk.bv, node->bv, sizeof(float) * (size_t)tree->axis);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.userdata_chunk = &chunk;
+  settings.userdata_chunk_size = sizeof(chunk);
+  settings.func_reduce = refit_kdop_hull_reduce;
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(start, end, &data, refit_kdop_hull_task_cb, &settings);
+
+  memcpy(node->bv, chunk.bv, sizeof(float) * (size_t)tree->axis);
+}
+
 /**
  * only supports x,y,z axis in the moment
  * but we should use a plain and simple function here for speed sake */
@@ -720,7 +792,7 @@ static void non_recursive_bvh_div_nodes_task_cb(void *__restrict userdata,
 
   /* This calculates the bounding box of this branch
    * and chooses the largest axis as the axis to divide leafs */
-  refit_kdop_hull(data->tree, parent, parent_leafs_begin, parent_leafs_end);
+  refit_kdop_hull_parallel(data->tree, parent, parent_leafs_begin, parent_leafs_end);
   split_axis = get_largest_axis(parent->bv);
 
   /* Save split axis (this can be used on ray-tracing to speedup the query time) */
@@ -1041,17 +1113,45 @@ bool BLI_bvhtree_update_node(
 /**
  * Call #BLI_bvhtree_update_node() first for every node/point/triangle.
  */
+static void bvhtree_update_tree_task_cb(void *__restrict userdata,
+                                        const int j,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BVHTree *tree = userdata;
+  node_join(tree, tree->nodes[tree->totleaf + j]);
+}
+
 void BLI_bvhtree_update_tree(BVHTree *tree)
 {
   /* Update bottom=>top
    * TRICKY: the way we build the tree all the children have an index greater than the parent
-   * This allows us todo a bottom up update by starting on the bigger numbered branch. */
+   * This allows us todo a bottom up update by starting on the bigger numbered branch.
+   *
+   * Branches are stored level by level (see #non_recursive_bvh_div_nodes), so all branches of a
+   * level only depend on the levels below and can be joined in parallel. */
+  const int tree_type = tree->tree_type;
+  const int tree_offset = 2 - tree_type;
+  const int num_branches = tree->totbranch;
 
-  BVHNode **root = tree->nodes + tree->totleaf;
-  BVHNode **index = tree->nodes + tree->totleaf + tree->totbranch - 1;
+  /* Index of the first branch of every level (1 based, as used when building). */
+  int level_starts[64];
+  int levels_num = 0;
+  for (int i = 1; i <= num_branches; i = i * tree_type + tree_offset) {
+    BLI_assert(levels_num < (int)ARRAY_SIZE(level_starts));
+    level_starts[levels_num++] = i;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (tree->totleaf > KDOPBVH_THREAD_LEAF_THRESHOLD);
+  settings.min_iter_per_thread = 256;
 
-  for (; index >= root; index--) {
-    node_join(tree, *index);
+  int level_end = num_branches + 1;
+  for (int level = levels_num - 1; level >= 0; level--) {
+    const int level_start = level_starts[level];
+    BLI_task_parallel_range(
+        level_start - 1, level_end - 1, tree, bvhtree_update_tree_task_cb, &settings);
+    level_end = level_start;
   }
 }
 /**
@@ -1489,6 +1589,46 @@ static float calc_nearest_point_squared(const float proj[3], BVHNode *node, floa
   return len_squared_v3v3(proj, nearest);
 }
 
+/**
+ * Squared distances to the bounding volumes of all children of \a node,
+ * computed four at a time when possible.
+ */
+static void calc_nearest_point_squared_children(const float proj[3],
+                                                const BVHNode *node,
+                                                float r_dists_sq[MAX_TREETYPE])
+{
+  int i = 0;
+#ifdef __SSE2__
+  const __m128 proj_x = _mm_set1_ps(proj[0]);
+  const __m128 proj_y = _mm_set1_ps(proj[1]);
+  const __m128 proj_z = _mm_set1_ps(proj[2]);
+
+  for (; i < node->totnode; i += 4) {
+    const float *bv[4];
+    for (int j = 0; j < 4; j++) {
+      bv[j] = node->children[min_ii(i + j, node->totnode - 1)]->bv;
+    }
+#  define BV_GATHER(k) _mm_setr_ps(bv[0][k], bv[1][k], bv[2][k], bv[3][k])
+    /* Same clamping as #calc_nearest_point_squared. */
+    const __m128 dx = _mm_sub_ps(proj_x,
+                                 _mm_min_ps(_mm_max_ps(proj_x, BV_GATHER(0)), BV_GATHER(1)));
+    const __m128 dy = _mm_sub_ps(proj_y,
+                                 _mm_min_ps(_mm_max_ps(proj_y, BV_GATHER(2)), BV_GATHER(3)));
+    const __m128 dz = _mm_sub_ps(proj_z,
+                                 _mm_min_ps(_mm_max_ps(proj_z, BV_GATHER(4)), BV_GATHER(5)));
+#  undef BV_GATHER
+    _mm_storeu_ps(&r_dists_sq[i],
+                  _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+                             _mm_mul_ps(dz, dz)));
+  }
+#else
+  float nearest[3];
+  for (; i < node->totnode; i++) {
+    r_dists_sq[i] = calc_nearest_point_squared(proj, node->children[i], nearest);
+  }
+#endif
+}
+
 /* Depth first search method */
 static void dfs_find_nearest_dfs(BVHNearestData *data, BVHNode *node)
 {
@@ -1504,13 +1644,14 @@ static void dfs_find_nearest_dfs(BVHNearestData *data, BVHNode *node)
   else {
     /* Better heuristic to pick the closest node to dive on */
     int i;
-    float nearest[3];
+    float dists_sq[MAX_TREETYPE];
+
+    calc_nearest_point_squared_children(data->proj, node, dists_sq);
 
     if (data->proj[node->main_axis] <= node->children[0]->bv[node->main_axis * 2 + 1]) {
 
       for (i = 0; i != node->totnode; i++) {
-        if (calc_nearest_point_squared(data->proj, node->children[i], nearest) >=
-            data->nearest.dist_sq) {
+        if (dists_sq[i] >= data->nearest.dist_sq) {
           continue;
         }
         dfs_find_nearest_dfs(data, node->children[i]);
@@ -1518,8 +1659,7 @@ static void dfs_find_nearest_dfs(BVHNearestData *data, BVHNode *node)
     }
     else {
       for (i = node->totnode - 1; i >= 0; i--) {
-        if (calc_nearest_point_squared(data->proj, node->children[i], nearest) >=
-            data->nearest.dist_sq) {
+        if (dists_sq[i] >= data->nearest.dist_sq) {
           continue;
         }
         dfs_find_nearest_dfs(data, node->children[i]);
@@ -1551,13 +1691,13 @@ static void heap_find_nearest_inner(BVHNearestData *data, HeapSimple *heap, BVHN
     }
   }
   else {
-    float nearest[3];
+    float dists_sq[MAX_TREETYPE];
 
-    for (int i = 0; i != node->totnode; i++) {
-      float dist_sq = calc_nearest_point_squared(data->proj, node->children[i], nearest);
+    calc_nearest_point_squared_children(data->proj, node, dists_sq);
 
-      if (dist_sq < data->nearest.dist_sq) {
-        BLI_heapsimple_insert(heap, dist_sq, node->children[i]);
+    for (int i = 0; i != node->totnode; i++) {
+      if (dists_sq[i] < data->nearest.dist_sq) {
+        BLI_heapsimple_insert(heap, dists_sq[i], node->children[i]);
       }
     }
   }
@@ -1641,6 +1781,145 @@ int BLI_bvhtree_find_nearest(BVHTree *tree,
   return BLI_bvhtree_find_nearest_ex(tree, co, nearest, callback, userdata, 0);
 }
 
+/** Number of consecutive (spatially sorted) queries handled by one task. */
+#define BVH_NEAREST_BATCH_CHUNK_SIZE 256
+
+typedef struct BVHNearestBatchItem {
+  uint code;
+  int index;
+} BVHNearestBatchItem;
+
+typedef struct BVHNearestBatchData {
+  BVHTree *tree;
+  const float (*co)[3];
+  BVHTreeNearest *nearest;
+  const BVHNearestBatchItem *items;
+  int items_len;
+  BVHTree_NearestPointCallback callback;
+  void *userdata;
+  int flag;
+} BVHNearestBatchData;
+
+/** Spread the lower 10 bits of \a v so there are two zero bits between each of them. */
+static uint bvhtree_morton_expand_bits(uint v)
+{
+  v = (v * 0x00010001u) & 0xFF0000FFu;
+  v = (v * 0x00000101u) & 0x0F00F00Fu;
+  v = (v * 0x00000011u) & 0xC30C30C3u;
+  v = (v * 0x00000005u) & 0x49249249u;
+  return v;
+}
+
+static int bvhtree_nearest_batch_item_cmp(const void *a_v, const void *b_v)
+{
+  const BVHNearestBatchItem *a = a_v;
+  const BVHNearestBatchItem *b = b_v;
+  if (a->code != b->code) {
+    return (a->code < b->code) ? -1 : 1;
+  }
+  return (a->index < b->index) ? -1 : (a->index > b->index);
+}
+
+static void bvhtree_find_nearest_batch_cb(void *__restrict userdata,
+                                          const int chunk,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHNearestBatchData *data = userdata;
+  const int start = chunk * BVH_NEAREST_BATCH_CHUNK_SIZE;
+  const int end = min_ii(start + BVH_NEAREST_BATCH_CHUNK_SIZE, data->items_len);
+  const BVHTreeNearest *prev = NULL;
+
+  for (int i = start; i < end; i++) {
+    const int index = data->items[i].index;
+    const float *co = data->co[index];
+    BVHTreeNearest *nearest = &data->nearest[index];
+
+    /* The element found for the previous (close by) query bounds the distance of this one,
+     * which prunes most of the tree before the search even starts. */
+    if (prev && prev->index != -1) {
+      const float dist_sq = len_squared_v3v3(co, prev->co);
+      if (dist_sq < nearest->dist_sq) {
+        *nearest = *prev;
+        nearest->dist_sq = dist_sq;
+      }
+    }
+
+    BLI_bvhtree_find_nearest_ex(
+        data->tree, co, nearest, data->callback, data->userdata, data->flag);
+    prev = nearest;
+  }
+}
+
+/**
+ * Find the nearest element for each of the \a co_len coordinates, giving the same result as
+ * calling #BLI_bvhtree_find_nearest_ex for each one of them.
+ *
+ * The queries are sorted along a Z-order curve and handled in parallel chunks, every query is
+ * seeded with the result of the previous one, so only a small part of the tree is searched.
+ *
+ * \param r_nearest: Array of \a co_len items, initialized by the caller as for a single query
+ * (typically `index = -1` and `dist_sq` set to the maximum distance).
+ * \param callback: Called from multiple threads. Since results are reused between queries,
+ * it must not accept or reject elements depending on the query.
+ */
+void BLI_bvhtree_find_nearest_batch(BVHTree *tree,
+                                    const float (*co)[3],
+                                    const int co_len,
+                                    BVHTreeNearest *r_nearest,
+                                    BVHTree_NearestPointCallback callback,
+                                    void *userdata,
+                                    int flag)
+{
+  if (co_len == 0) {
+    return;
+  }
+
+  float min[3], max[3];
+  INIT_MINMAX(min, max);
+  for (int i = 0; i < co_len; i++) {
+    minmax_v3v3_v3(min, max, co[i]);
+  }
+
+  float scale[3];
+  for (int axis = 0; axis < 3; axis++) {
+    const float size = max[axis] - min[axis];
+    scale[axis] = (size > FLT_EPSILON) ? 1023.0f / size : 0.0f;
+  }
+
+  BVHNearestBatchItem *items = MEM_malloc_arrayN((size_t)co_len, sizeof(*items), __func__);
+  for (int i = 0; i < co_len; i++) {
+    uint code = 0;
+    for (int axis = 0; axis < 3; axis++) {
+      const int cell = min_ii((int)((co[i][axis] - min[axis]) * scale[axis]), 1023);
+      code |= bvhtree_morton_expand_bits((uint)cell) << axis;
+    }
+    items[i].code = code;
+    items[i].index = i;
+  }
+  qsort(items, (size_t)co_len, sizeof(*items), bvhtree_nearest_batch_item_cmp);
+
+  BVHNearestBatchData data = {
+      .tree = tree,
+      .co = co,
+      .nearest = r_nearest,
+      .items = items,
+      .items_len = co_len,
+      .callback = callback,
+      .userdata = userdata,
+      .flag = flag,
+  };
+
+  const int chunks_len = (co_len + BVH_NEAREST_BATCH_CHUNK_SIZE - 1) /
+                         BVH_NEAREST_BATCH_CHUNK_SIZE;
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (chunks_len > 1);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, chunks_len, &data, bvhtree_find_nearest_batch_cb, &settings);
+
+  MEM_freeN(items);
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -1806,18 +2085,73 @@ static float fast_ray_nearest_hit(const BVHRayCastData *data, const BVHNode *nod
   return max_fff(t1x, t1y, t1z);
 }
 
-static void dfs_raycast(BVHRayCastData *data, BVHNode *node)
+BLI_INLINE float ray_nearest_hit_node(const BVHRayCastData *data, const BVHNode *node)
 {
-  int i;
-
-  /* ray-bv is really fast.. and simple tests revealed its worth to test it
-   * before calling the ray-primitive functions */
   /* XXX: temporary solution for particles until fast_ray_nearest_hit supports ray.radius */
-  float dist = (data->ray.radius == 0.0f) ? fast_ray_nearest_hit(data, node) :
-                                            ray_nearest_hit(data, node->bv);
-  if (dist >= data->hit.dist) {
+  return (data->ray.radius == 0.0f) ? fast_ray_nearest_hit(data, node) :
+                                      ray_nearest_hit(data, node->bv);
+}
+
+/**
+ * Compute the distances to all children of \a node at once, testing four at a time when possible.
+ * Children which are missed get #FLT_MAX, other distances aren't clamped to `data->hit.dist`.
+ */
+static void ray_nearest_hit_children(const BVHRayCastData *data,
+                                     const BVHNode *node,
+                                     float r_dists[MAX_TREETYPE])
+{
+  int i = 0;
+
+#ifdef __SSE2__
+  if (data->ray.radius == 0.0f) {
+    const int *index = data->index;
+    const __m128 origin_x = _mm_set1_ps(data->ray.origin[0]);
+    const __m128 origin_y = _mm_set1_ps(data->ray.origin[1]);
+    const __m128 origin_z = _mm_set1_ps(data->ray.origin[2]);
+    const __m128 idot_x = _mm_set1_ps(data->idot_axis[0]);
+    const __m128 idot_y = _mm_set1_ps(data->idot_axis[1]);
+    const __m128 idot_z = _mm_set1_ps(data->idot_axis[2]);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 miss = _mm_set1_ps(FLT_MAX);
+
+    for (; i < node->totnode; i += 4) {
+      /* Gather the slabs of (up to) four children, repeating the last one as padding. */
+      const float *bv[4];
+      for (int j = 0; j < 4; j++) {
+        bv[j] = node->children[min_ii(i + j, node->totnode - 1)]->bv;
+      }
+#  define BV_GATHER(k) \
+    _mm_setr_ps(bv[0][index[k]], bv[1][index[k]], bv[2][index[k]], bv[3][index[k]])
+      const __m128 t1x = _mm_mul_ps(_mm_sub_ps(BV_GATHER(0), origin_x), idot_x);
+      const __m128 t2x = _mm_mul_ps(_mm_sub_ps(BV_GATHER(1), origin_x), idot_x);
+      const __m128 t1y = _mm_mul_ps(_mm_sub_ps(BV_GATHER(2), origin_y), idot_y);
+      const __m128 t2y = _mm_mul_ps(_mm_sub_ps(BV_GATHER(3), origin_y), idot_y);
+      const __m128 t1z = _mm_mul_ps(_mm_sub_ps(BV_GATHER(4), origin_z), idot_z);
+      const __m128 t2z = _mm_mul_ps(_mm_sub_ps(BV_GATHER(5), origin_z), idot_z);
+#  undef BV_GATHER
+
+      /* Same as the checks in #fast_ray_nearest_hit, since `t1 <= t2` on every axis. */
+      const __m128 tmin = _mm_max_ps(_mm_max_ps(t1x, t1y), t1z);
+      const __m128 tmax = _mm_min_ps(_mm_min_ps(t2x, t2y), t2z);
+      const __m128 is_miss = _mm_or_ps(_mm_cmpgt_ps(tmin, tmax), _mm_cmplt_ps(tmax, zero));
+
+      /* #MAX_TREETYPE is a multiple of four, so this never writes past the end. */
+      _mm_storeu_ps(&r_dists[i],
+                    _mm_or_ps(_mm_and_ps(is_miss, miss), _mm_andnot_ps(is_miss, tmin)));
+    }
     return;
   }
+#endif
+
+  for (; i < node->totnode; i++) {
+    r_dists[i] = ray_nearest_hit_node(data, node->children[i]);
+  }
+}
+
+/* Visit a node which is known to be hit at `dist`, closer than the current hit. */
+static void dfs_raycast_node(BVHRayCastData *data, BVHNode *node, const float dist)
+{
+  int i;
 
   if (node->totnode == 0) {
     if (data->callback) {
@@ -1830,58 +2164,84 @@ static void dfs_raycast(BVHRayCastData *data, BVHNode *node)
     }
   }
   else {
+    /* Testing all children before descending is cheaper than testing them one by one,
+     * the distances stay valid since they don't depend on the current hit. */
+    float dists[MAX_TREETYPE];
+    ray_nearest_hit_children(data, node, dists);
+
     /* pick loop direction to dive into the tree (based on ray direction and split axis) */
     if (data->ray_dot_axis[node->main_axis] > 0.0f) {
       for (i = 0; i != node->totnode; i++) {
-        dfs_raycast(data, node->children[i]);
+        if (dists[i] < data->hit.dist) {
+          dfs_raycast_node(data, node->children[i], dists[i]);
+        }
       }
     }
     else {
       for (i = node->totnode - 1; i >= 0; i--) {
-        dfs_raycast(data, node->children[i]);
+        if (dists[i] < data->hit.dist) {
+          dfs_raycast_node(data, node->children[i], dists[i]);
+        }
       }
     }
   }
 }
 
-/**
- * A version of #dfs_raycast with minor changes to reset the index & dist each ray cast.
- */
-static void dfs_raycast_all(BVHRayCastData *data, BVHNode *node)
+static void dfs_raycast(BVHRayCastData *data, BVHNode *node)
 {
-  int i;
-
   /* ray-bv is really fast.. and simple tests revealed its worth to test it
    * before calling the ray-primitive functions */
-  /* XXX: temporary solution for particles until fast_ray_nearest_hit supports ray.radius */
-  float dist = (data->ray.radius == 0.0f) ? fast_ray_nearest_hit(data, node) :
-                                            ray_nearest_hit(data, node->bv);
+  const float dist = ray_nearest_hit_node(data, node);
   if (dist >= data->hit.dist) {
     return;
   }
+  dfs_raycast_node(data, node, dist);
+}
+
+/**
+ * A version of #dfs_raycast_node with minor changes to reset the index & dist each ray cast.
+ */
+static void dfs_raycast_all_node(BVHRayCastData *data, BVHNode *node)
+{
+  int i;
 
   if (node->totnode == 0) {
     /* no need to check for 'data->callback' (using 'all' only makes sense with a callback). */
-    dist = data->hit.dist;
+    const float dist = data->hit.dist;
     data->callback(data->userdata, node->index, &data->ray, &data->hit);
     data->hit.index = -1;
     data->hit.dist = dist;
   }
   else {
+    float dists[MAX_TREETYPE];
+    ray_nearest_hit_children(data, node, dists);
+
     /* pick loop direction to dive into the tree (based on ray direction and split axis) */
     if (data->ray_dot_axis[node->main_axis] > 0.0f) {
       for (i = 0; i != node->totnode; i++) {
-        dfs_raycast_all(data, node->children[i]);
+        if (dists[i] < data->hit.dist) {
+          dfs_raycast_all_node(data, node->children[i]);
+        }
       }
     }
     else {
       for (i = node->totnode - 1; i >= 0; i--) {
-        dfs_raycast_all(data, node->children[i]);
+        if (dists[i] < data->hit.dist) {
+          dfs_raycast_all_node(data, node->children[i]);
+        }
       }
     }
   }
 }
 
+static void dfs_raycast_all(BVHRayCastData *data, BVHNode *node)
+{
+  if (ray_nearest_hit_node(data, node) >= data->hit.dist) {
+    return;
+  }
+  dfs_raycast_all_node(data, node);
+}
+
 static void bvhtree_ray_cast_data_precalc(BVHRayCastData *data, int flag)
 {
   int i;
@@ -27,6 +27,7 @@
  * - Freeing chunks.
  * - Iterating over allocated chunks
  *   (optionally when using the #BLI_MEMPOOL_ALLOW_ITER flag).
+ * - Allocating and freeing from multiple threads using #BLI_mempool_local.
  */
 
 #include <stdlib.h>
@@ -184,6 +185,40 @@ static BLI_mempool_chunk *mempool_chunk_alloc(BLI_mempool *pool)
   return MEM_mallocN(sizeof(BLI_mempool_chunk) + (size_t)pool->csize, "BLI_Mempool Chunk");
 }
 
+/**
+ * Link all elements of \a mpchunk into a free list starting at the chunk data.
+ *
+ * \return The last element of the list.
+ */
+static BLI_freenode *mempool_chunk_init_nodes(BLI_mempool *pool, BLI_mempool_chunk *mpchunk)
+{
+  const uint esize = pool->esize;
+  BLI_freenode *curnode = CHUNK_DATA(mpchunk);
+  uint j;
+
+  /* loop through the allocated data, building the pointer structures */
+  j = pool->pchunk;
+  if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+    while (j--) {
+      curnode->next = NODE_STEP_NEXT(curnode);
+      curnode->freeword = FREEWORD;
+      curnode = curnode->next;
+    }
+  }
+  else {
+    while (j--) {
+      curnode->next = NODE_STEP_NEXT(curnode);
+      curnode = curnode->next;
+    }
+  }
+
+  /* terminate the list (rewind one) */
+  curnode = NODE_STEP_PREV(curnode);
+  curnode->next = NULL;
+
+  return curnode;
+}
+
 /**
  * Initialize a chunk and add into \a pool->chunks
  *
@@ -197,9 +232,7 @@ static BLI_freenode *mempool_chunk_add(BLI_mempool *pool,
                                        BLI_mempool_chunk *mpchunk,
                                        BLI_freenode *last_tail)
 {
-  const uint esize = pool->esize;
   BLI_freenode *curnode = CHUNK_DATA(mpchunk);
-  uint j;
 
   /* append */
   if (pool->chunk_tail) {
@@ -217,26 +250,8 @@ static BLI_freenode *mempool_chunk_add(BLI_mempool *pool,
     pool->free = curnode;
   }
 
-  /* loop through the allocated data, building the pointer structures */
-  j = pool->pchunk;
-  if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
-    while (j--) {
-      curnode->next = NODE_STEP_NEXT(curnode);
-      curnode->freeword = FREEWORD;
-      curnode = curnode->next;
-    }
-  }
-  else {
-    while (j--) {
-      curnode->next = NODE_STEP_NEXT(curnode);
-      curnode = curnode->next;
-    }
-  }
-
-  /* terminate the list (rewind one)
-   * will be overwritten if 'curnode' gets passed in again as 'last_tail' */
-  curnode = NODE_STEP_PREV(curnode);
-  curnode->next = NULL;
+  /* Will be overwritten if 'curnode' gets passed in again as 'last_tail'. */
+  curnode = mempool_chunk_init_nodes(pool, mpchunk);
 
 #ifdef USE_TOTALLOC
   pool->totalloc += pool->pchunk;
@@ -451,6 +466,164 @@ void BLI_mempool_free(BLI_mempool *pool, void *addr)
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Thread Local Allocation
+ *
+ * Multiple threads can allocate and free elements of the same pool at once, each using its own
+ * #BLI_mempool_local. Every thread keeps a private free list, which is refilled by taking over
+ * the whole shared free list of the pool, or by reserving a new chunk when that is empty.
+ * Elements freed on a thread are kept by that thread until #BLI_mempool_local_finish returns them
+ * to the pool.
+ *
+ * Regular pool functions (including iteration) must not be used while any thread is using its
+ * #BLI_mempool_local. Chunks reserved this way are added at the start of the chunk list, so
+ * iteration doesn't follow the order of allocation.
+ * \{ */
+
+void BLI_mempool_local_init(BLI_mempool *pool, BLI_mempool_local *local)
+{
+  local->pool = pool;
+  local->free = NULL;
+  local->totused_delta = 0;
+}
+
+static BLI_freenode *mempool_local_refill(BLI_mempool_local *local)
+{
+  BLI_mempool *pool = local->pool;
+
+  /* Take over the entire shared free list. Replacing it with NULL (instead of popping a single
+   * element) can't suffer from the ABA problem, since it doesn't depend on the `next` pointer. */
+  BLI_freenode *free_list = pool->free;
+  while (free_list != NULL) {
+    BLI_freenode *free_list_prev = atomic_cas_ptr((void **)&pool->free, free_list, NULL);
+    if (free_list_prev == free_list) {
+      return free_list;
+    }
+    free_list = free_list_prev;
+  }
+
+  /* Reserve a new chunk for this thread. */
+  BLI_mempool_chunk *mpchunk = mempool_chunk_alloc(pool);
+  mempool_chunk_init_nodes(pool, mpchunk);
+
+  BLI_mempool_chunk *chunks = pool->chunks;
+  while (true) {
+    mpchunk->next = chunks;
+    BLI_mempool_chunk *chunks_prev = atomic_cas_ptr((void **)&pool->chunks, chunks, mpchunk);
+    if (chunks_prev == chunks) {
+      break;
+    }
+    chunks = chunks_prev;
+  }
+  if (chunks == NULL) {
+    /* Only the first chunk added to an empty pool becomes the tail. */
+    pool->chunk_tail = mpchunk;
+  }
+
+#ifdef USE_TOTALLOC
+  atomic_add_and_fetch_u(&pool->totalloc, pool->pchunk);
+#endif
+
+  return CHUNK_DATA(mpchunk);
+}
+
+void *BLI_mempool_local_alloc(BLI_mempool_local *local)
+{
+  BLI_mempool *pool = local->pool;
+
+  if (UNLIKELY(local->free == NULL)) {
+    local->free = mempool_local_refill(local);
+  }
+
+  BLI_freenode *free_pop = local->free;
+
+  if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+    free_pop->freeword = USEDWORD;
+  }
+
+  local->free = free_pop->next;
+  local->totused_delta++;
+
+#ifdef WITH_MEM_VALGRIND
+  VALGRIND_MEMPOOL_ALLOC(pool, free_pop, pool->esize);
+#endif
+
+  return (void *)free_pop;
+}
+
+void *BLI_mempool_local_calloc(BLI_mempool_local *local)
+{
+  void *retval = BLI_mempool_local_alloc(local);
+  memset(retval, 0, (size_t)local->pool->esize);
+  return retval;
+}
+
+/**
+ * Free an element, which may have been allocated by any thread.
+ *
+ * \note Unlike #BLI_mempool_free, unused chunks are never freed.
+ */
+void BLI_mempool_local_free(BLI_mempool_local *local, void *addr)
+{
+  BLI_mempool *pool = local->pool;
+  BLI_freenode *newhead = addr;
+
+#ifndef NDEBUG
+  if (UNLIKELY(mempool_debug_memset)) {
+    memset(addr, 255, pool->esize);
+  }
+#endif
+
+  if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+#ifndef NDEBUG
+    BLI_assert(newhead->freeword != FREEWORD);
+#endif
+    newhead->freeword = FREEWORD;
+  }
+
+  newhead->next = local->free;
+  local->free = newhead;
+  local->totused_delta--;
+
+#ifdef WITH_MEM_VALGRIND
+  VALGRIND_MEMPOOL_FREE(pool, addr);
+#endif
+}
+
+/**
+ * Return the remaining free elements of \a local to the pool and update its element count.
+ * \a local can be used again afterwards.
+ */
+void BLI_mempool_local_finish(BLI_mempool_local *local)
+{
+  BLI_mempool *pool = local->pool;
+
+  if (local->free) {
+    BLI_freenode *tail = local->free;
+    while (tail->next) {
+      tail = tail->next;
+    }
+
+    /* Pushing is safe without a lock, see #mempool_local_refill. */
+    BLI_freenode *free_list = pool->free;
+    while (true) {
+      tail->next = free_list;
+      BLI_freenode *free_list_prev = atomic_cas_ptr((void **)&pool->free, free_list, local->free);
+      if (free_list_prev == free_list) {
+        break;
+      }
+      free_list = free_list_prev;
+    }
+    local->free = NULL;
+  }
+
+  /* Wrapping arithmetic takes care of negative changes. */
+  atomic_add_and_fetch_u(&pool->totused, (uint)local->totused_delta);
+  local->totused_delta = 0;
+}
+
+/** \} */
+
 int BLI_mempool_len(BLI_mempool *pool)
 {
   return (int)pool->totused;
@@ -104,6 +104,7 @@
 
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
 
 #include "BLI_strict_flags.h"
 
@@ -155,6 +156,12 @@
  * so 4 -> 7, 5 -> 10, 6 -> 15... etc.
  */
 #  define BCHUNK_HASH_TABLE_ACCUMULATE_STEPS 4
+
+/* Hash arrays of at least this many elements using threads,
+ * in blocks of #BCHUNK_HASH_THREAD_BLOCK elements (large meshes undo pushes for e.g.).
+ */
+#  define BCHUNK_HASH_THREAD_MIN 65536
+#  define BCHUNK_HASH_THREAD_BLOCK 16384
 #else
 /* How many items to hash (multiplied by stride)
  */
@@ -769,24 +776,76 @@ static uint hash_data(const uchar *key, size_t n)
 #undef HASH_INIT
 
 #ifdef USE_HASH_TABLE_ACCUMULATE
-static void hash_array_from_data(const BArrayInfo *info,
-                                 const uchar *data_slice,
-                                 const size_t data_slice_len,
-                                 hash_key *hash_array)
+static void hash_array_from_data_range(const BArrayInfo *info,
+                                       const uchar *data_slice,
+                                       const size_t i_start,
+                                       const size_t i_end,
+                                       hash_key *hash_array)
 {
   if (info->chunk_stride != 1) {
-    for (size_t i = 0, i_step = 0; i_step < data_slice_len; i++, i_step += info->chunk_stride) {
+    for (size_t i = i_start, i_step = i_start * info->chunk_stride; i < i_end;
+         i++, i_step += info->chunk_stride) {
       hash_array[i] = hash_data(&data_slice[i_step], info->chunk_stride);
     }
   }
   else {
     /* fast-path for bytes */
-    for (size_t i = 0; i < data_slice_len; i++) {
+    for (size_t i = i_start; i < i_end; i++) {
       hash_array[i] = hash_data_single(data_slice[i]);
     }
   }
 }
 
+typedef struct HashArrayTaskData {
+  const BArrayInfo *info;
+  const uchar *data_slice;
+  /** Source & destination arrays for #hash_accum_step_task. */
+  const hash_key *hash_array_src;
+  hash_key *hash_array;
+  size_t hash_array_len;
+  size_t hash_offset;
+} HashArrayTaskData;
+
+static void hash_array_from_data_task(void *__restrict userdata,
+                                      const int block,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const HashArrayTaskData *data = userdata;
+  const size_t i_start = (size_t)block * BCHUNK_HASH_THREAD_BLOCK;
+  const size_t i_end = MIN2(i_start + BCHUNK_HASH_THREAD_BLOCK, data->hash_array_len);
+  hash_array_from_data_range(data->info, data->data_slice, i_start, i_end, data->hash_array);
+}
+
+static void hash_array_parallel_range(HashArrayTaskData *data, TaskParallelRangeFunc func)
+{
+  const int blocks_len = (int)((data->hash_array_len + BCHUNK_HASH_THREAD_BLOCK - 1) /
+                               BCHUNK_HASH_THREAD_BLOCK);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, blocks_len, data, func, &settings);
+}
+
+static void hash_array_from_data(const BArrayInfo *info,
+                                 const uchar *data_slice,
+                                 const size_t data_slice_len,
+                                 hash_key *hash_array)
+{
+  const size_t hash_array_len = data_slice_len / info->chunk_stride;
+  if (hash_array_len < BCHUNK_HASH_THREAD_MIN) {
+    hash_array_from_data_range(info, data_slice, 0, hash_array_len, hash_array);
+    return;
+  }
+
+  HashArrayTaskData data = {
+      .info = info,
+      .data_slice = data_slice,
+      .hash_array = hash_array,
+      .hash_array_len = hash_array_len,
+  };
+  hash_array_parallel_range(&data, hash_array_from_data_task);
+}
+
 /*
  * Similar to hash_array_from_data,
  * but able to step into the next chunk if we run-out of data.
@@ -816,6 +875,33 @@ static void hash_array_from_cref(const BArrayInfo *info,
   BLI_assert(i == hash_array_len);
 }
 
+/**
+ * Unlike the in-place loop of #hash_accum, source & destination don't alias,
+ * so the compiler can vectorize this.
+ */
+static void hash_accum_step_range(const hash_key *__restrict hash_array_src,
+                                  hash_key *__restrict hash_array_dst,
+                                  const size_t hash_offset,
+                                  const size_t i_start,
+                                  const size_t i_end)
+{
+  for (size_t i = i_start; i < i_end; i++) {
+    hash_array_dst[i] = hash_array_src[i] +
+                        (hash_array_src[i + hash_offset]) * ((hash_array_src[i] & 0xff) + 1);
+  }
+}
+
+static void hash_accum_step_task(void *__restrict userdata,
+                                 const int block,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const HashArrayTaskData *data = userdata;
+  const size_t i_start = (size_t)block * BCHUNK_HASH_THREAD_BLOCK;
+  const size_t i_end = MIN2(i_start + BCHUNK_HASH_THREAD_BLOCK, data->hash_array_len);
+  hash_accum_step_range(
+      data->hash_array_src, data->hash_array, data->hash_offset, i_start, i_end);
+}
+
 static void hash_accum(hash_key *hash_array, const size_t hash_array_len, size_t iter_steps)
 {
   /* _very_ unlikely, can happen if you select a chunk-size of 1 for example. */
@@ -824,6 +910,36 @@ static void hash_accum(hash_key *hash_array, const size_t hash_array_len, size_t
   }
 
   const size_t hash_array_search_len = hash_array_len - iter_steps;
+
+  if (hash_array_search_len >= BCHUNK_HASH_THREAD_MIN) {
+    /* Each step only reads values of the previous one, alternate between two arrays
+     * so blocks can be accumulated in parallel, giving the same result as the in-place loop.
+     * Values past the search length are never written to, both arrays share them. */
+    hash_key *hash_array_tmp = MEM_mallocN(sizeof(*hash_array_tmp) * hash_array_len, __func__);
+    memcpy(&hash_array_tmp[hash_array_search_len],
+           &hash_array[hash_array_search_len],
+           sizeof(*hash_array) * iter_steps);
+
+    hash_key *hash_arrays[2] = {hash_array, hash_array_tmp};
+    int src = 0;
+    HashArrayTaskData data = {
+        .hash_array_len = hash_array_search_len,
+    };
+    while (iter_steps != 0) {
+      data.hash_array_src = hash_arrays[src];
+      data.hash_array = hash_arrays[!src];
+      data.hash_offset = iter_steps;
+      hash_array_parallel_range(&data, hash_accum_step_task);
+      src = !src;
+      iter_steps -= 1;
+    }
+    if (src != 0) {
+      memcpy(hash_array, hash_array_tmp, sizeof(*hash_array) * hash_array_search_len);
+    }
+    MEM_freeN(hash_array_tmp);
+    return;
+  }
+
   while (iter_steps != 0) {
     const size_t hash_offset = iter_steps;
     for (uint i = 0; i < hash_array_search_len; i++) {
@@ -0,0 +1,175 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <string.h>
+
+#include "zlib.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_compress.h"
+#include "BLI_task.h"
+#include "BLI_utildefines.h"
+
+#include "BLI_strict_flags.h"
+
+static void compress_block(CompressBlock *block, const int level)
+{
+  block->compressed = NULL;
+  block->compressed_len = 0;
+
+  z_stream stream = {NULL};
+  /* Window bits with 16 added writes gzip header and trailer. */
+  if (deflateInit2(&stream, level, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    return;
+  }
+  const size_t compressed_max_len = deflateBound(&stream, (uLong)block->data_len);
+  block->compressed = MEM_mallocN(compressed_max_len, __func__);
+
+  stream.next_in = (Bytef *)block->data;
+  stream.avail_in = (uInt)block->data_len;
+  stream.next_out = block->compressed;
+  stream.avail_out = (uInt)compressed_max_len;
+  if (deflate(&stream, Z_FINISH) == Z_STREAM_END) {
+    block->compressed_len = compressed_max_len - stream.avail_out;
+  }
+  else {
+    MEM_SAFE_FREE(block->compressed);
+  }
+  deflateEnd(&stream);
+}
+
+static void compress_block_task(TaskPool *__restrict pool, void *taskdata)
+{
+  const int *level = BLI_task_pool_user_data(pool);
+  compress_block(taskdata, *level);
+}
+
+/**
+ * Compress every block into a gzip member, using all threads.
+ *
+ * \param level: zlib compression level, from 0 (no compression) to 9 (best compression).
+ * \return false when any of the blocks failed to compress.
+ */
+bool BLI_compress_blocks(CompressBlock *blocks, int blocks_num, int level)
+{
+  if (blocks_num == 1) {
+    compress_block(&blocks[0], level);
+  }
+  else if (blocks_num > 1) {
+    TaskPool *task_pool = BLI_task_pool_create(&level, TASK_PRIORITY_HIGH);
+    for (int i = 0; i < blocks_num; i++) {
+      BLI_task_pool_push(task_pool, compress_block_task, &blocks[i], false, NULL);
+    }
+    BLI_task_pool_work_and_wait(task_pool);
+    BLI_task_pool_free(task_pool);
+  }
+
+  bool ok = true;
+  for (int i = 0; i < blocks_num; i++) {
+    if (blocks[i].compressed == NULL) {
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+/**
+ * Compress the data into a gzip stream which consists of blocks of #BLI_COMPRESS_BLOCK_SIZE,
+ * compressed in parallel.
+ *
+ * \return Compressed data allocated with MEM_mallocN, NULL on failure.
+ */
+void *BLI_compress_mem(const void *data, size_t data_len, int level, size_t *r_compressed_len)
+{
+  *r_compressed_len = 0;
+
+  const int blocks_num = (int)MAX2((data_len + BLI_COMPRESS_BLOCK_SIZE - 1) / BLI_COMPRESS_BLOCK_SIZE, (size_t)1);
+  CompressBlock *blocks = MEM_calloc_arrayN((size_t)blocks_num, sizeof(*blocks), __func__);
+  for (int i = 0; i < blocks_num; i++) {
+    const size_t offset = (size_t)i * BLI_COMPRESS_BLOCK_SIZE;
+    blocks[i].data = (const char *)data + offset;
+    blocks[i].data_len = MIN2(data_len - offset, (size_t)BLI_COMPRESS_BLOCK_SIZE);
+  }
+
+  char *compressed = NULL;
+  if (BLI_compress_blocks(blocks, blocks_num, level)) {
+    size_t compressed_len = 0;
+    for (int i = 0; i < blocks_num; i++) {
+      compressed_len += blocks[i].compressed_len;
+    }
+    compressed = MEM_mallocN(compressed_len, __func__);
+    char *compressed_iter = compressed;
+    for (int i = 0; i < blocks_num; i++) {
+      memcpy(compressed_iter, blocks[i].compressed, blocks[i].compressed_len);
+      compressed_iter += blocks[i].compressed_len;
+    }
+    *r_compressed_len = compressed_len;
+  }
+
+  for (int i = 0; i < blocks_num; i++) {
+    MEM_SAFE_FREE(blocks[i].compressed);
+  }
+  MEM_freeN(blocks);
+
+  return compressed;
+}
+
+/**
+ * Decompress a gzip stream, which can consist of multiple members, into a buffer of known size.
+ *
+ * \return Number of decompressed bytes, 0 on failure.
+ */
+size_t BLI_decompress_mem(const void *compressed,
+                          size_t compressed_len,
+                          void *r_data,
+                          size_t data_len)
+{
+  z_stream stream = {NULL};
+  if (inflateInit2(&stream, MAX_WBITS + 16) != Z_OK) {
+    return 0;
+  }
+  stream.next_in = (Bytef *)compressed;
+  stream.avail_in = (uInt)compressed_len;
+  stream.next_out = r_data;
+  stream.avail_out = (uInt)data_len;
+
+  bool ok = true;
+  while (stream.avail_out != 0) {
+    const int ret = inflate(&stream, Z_NO_FLUSH);
+    if (ret == Z_STREAM_END) {
+      /* Continue with the next member. */
+      if (stream.avail_in == 0 || inflateReset(&stream) != Z_OK) {
+        break;
+      }
+    }
+    else if (ret != Z_OK) {
+      ok = false;
+      break;
+    }
+  }
+  const size_t decompressed_len = data_len - stream.avail_out;
+  inflateEnd(&stream);
+
+  return ok ? decompressed_len : 0;
+}
@@ -22,6 +22,7 @@
 
 #include "BLI_kdtree_impl.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_strict_flags.h"
 #include "BLI_utildefines.h"
 
@@ -45,6 +46,8 @@ typedef struct KDTreeNode {
 struct KDTree {
   KDTreeNode *nodes;
   uint nodes_len;
+  /** Nodes after this were inserted after balancing, they are searched linearly. */
+  uint nodes_len_balanced;
   uint root;
 #ifdef DEBUG
   bool is_balanced;        /* ensure we call balance first */
@@ -56,6 +59,18 @@ struct KDTree {
 #define KD_NEAR_ALLOC_INC 100 /* alloc increment for collecting nearest */
 #define KD_FOUND_ALLOC_INC 50 /* alloc increment for collecting nearest */
 
+/* Sub-trees with more nodes are balanced in parallel. */
+#define KD_BALANCE_THREAD_MIN 8192
+/* Number of query points to search in parallel. */
+#define KD_BATCH_THREAD_MIN 1024
+/* Trees with more nodes find the neighbors of all nodes in parallel when de-duplicating. */
+#define KD_DEDUPLICATE_THREAD_MIN 10000
+/* Maximum average number of neighbors per node to store, otherwise search serially. */
+#define KD_DEDUPLICATE_NEIGHBORS_MAX 32
+/* Nodes inserted after balancing which are searched linearly before balancing again,
+ * or a fraction of the balanced nodes when that is larger. */
+#define KD_OVERFLOW_LEN_MIN 64
+
 #define KD_NODE_UNSET ((uint)-1)
 
 /**
@@ -103,6 +118,7 @@ KDTree *BLI_kdtree_nd_(new)(uint nodes_len_capacity)
   tree = MEM_mallocN(sizeof(KDTree), "KDTree");
   tree->nodes = MEM_mallocN(sizeof(KDTreeNode) * nodes_len_capacity, "KDTreeNode");
   tree->nodes_len = 0;
+  tree->nodes_len_balanced = 0;
   tree->root = KD_NODE_ROOT_IS_INIT;
 
 #ifdef DEBUG
@@ -123,6 +139,9 @@ void BLI_kdtree_nd_(free)(KDTree *tree)
 
 /**
  * Construction: first insert points, then call balance. Normal is optional.
+ *
+ * Points inserted after balancing can be found right away, they are kept in a small overflow
+ * list which is searched linearly, the tree is balanced again once that becomes too large.
  */
 void BLI_kdtree_nd_(insert)(KDTree *tree, int index, const float co[KD_DIMS])
 {
@@ -140,24 +159,30 @@ void BLI_kdtree_nd_(insert)(KDTree *tree, int index, const float co[KD_DIMS])
   node->index = index;
   node->d = 0;
 
+  if (tree->root == KD_NODE_ROOT_IS_INIT) {
 #ifdef DEBUG
-  tree->is_balanced = false;
+    tree->is_balanced = false;
 #endif
+    return;
+  }
+
+  /* Inserting into a balanced tree. */
+  const uint overflow_len = tree->nodes_len - tree->nodes_len_balanced;
+  if ((tree->root == KD_NODE_UNSET) ||
+      (overflow_len > KD_OVERFLOW_LEN_MIN && overflow_len > tree->nodes_len_balanced / 8)) {
+    BLI_kdtree_nd_(balance)(tree);
+  }
 }
 
-static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+/**
+ * Partition \a nodes around the median along \a axis.
+ * \return the index of the median.
+ */
+static uint kdtree_balance_median(KDTreeNode *nodes, uint nodes_len, uint axis)
 {
-  KDTreeNode *node;
   float co;
   uint left, right, median, i, j;
 
-  if (nodes_len <= 0) {
-    return KD_NODE_UNSET;
-  }
-  else if (nodes_len == 1) {
-    return 0 + ofs;
-  }
-
   /* quicksort style sorting around median */
   left = 0;
   right = nodes_len - 1;
@@ -190,6 +215,23 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
     }
   }
 
+  return median;
+}
+
+static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+{
+  KDTreeNode *node;
+  uint median;
+
+  if (nodes_len <= 0) {
+    return KD_NODE_UNSET;
+  }
+  else if (nodes_len == 1) {
+    return 0 + ofs;
+  }
+
+  median = kdtree_balance_median(nodes, nodes_len, axis);
+
   /* set node and sort subnodes */
   node = &nodes[median];
   node->d = axis;
@@ -201,6 +243,54 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
   return median + ofs;
 }
 
+typedef struct KDTreeBalanceTask {
+  KDTreeNode *nodes;
+  uint nodes_len;
+  uint axis;
+  uint ofs;
+  uint *r_root;
+} KDTreeBalanceTask;
+
+static void kdtree_balance_parallel(
+    TaskPool *pool, KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs, uint *r_root);
+
+static void kdtree_balance_task_run(TaskPool *__restrict pool, void *taskdata)
+{
+  const KDTreeBalanceTask *task = taskdata;
+  kdtree_balance_parallel(pool, task->nodes, task->nodes_len, task->axis, task->ofs, task->r_root);
+}
+
+/**
+ * A version of #kdtree_balance which balances the left side of large sub-trees in a task.
+ * Each side only touches its own range of nodes, so the result is the same.
+ */
+static void kdtree_balance_parallel(
+    TaskPool *pool, KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs, uint *r_root)
+{
+  if (nodes_len < KD_BALANCE_THREAD_MIN) {
+    *r_root = kdtree_balance(nodes, nodes_len, axis, ofs);
+    return;
+  }
+
+  const uint median = kdtree_balance_median(nodes, nodes_len, axis);
+  KDTreeNode *node = &nodes[median];
+  node->d = axis;
+  axis = (axis + 1) % KD_DIMS;
+
+  KDTreeBalanceTask *task = MEM_mallocN(sizeof(*task), __func__);
+  task->nodes = nodes;
+  task->nodes_len = median;
+  task->axis = axis;
+  task->ofs = ofs;
+  task->r_root = &node->left;
+  BLI_task_pool_push(pool, kdtree_balance_task_run, task, true, NULL);
+
+  kdtree_balance_parallel(
+      pool, nodes + median + 1, (nodes_len - (median + 1)), axis, (median + 1) + ofs, &node->right);
+
+  *r_root = median + ofs;
+}
+
 void BLI_kdtree_nd_(balance)(KDTree *tree)
 {
   if (tree->root != KD_NODE_ROOT_IS_INIT) {
@@ -210,7 +300,16 @@ void BLI_kdtree_nd_(balance)(KDTree *tree)
     }
   }
 
-  tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  if (tree->nodes_len >= KD_BALANCE_THREAD_MIN) {
+    TaskPool *pool = BLI_task_pool_create(NULL, TASK_PRIORITY_HIGH);
+    kdtree_balance_parallel(pool, tree->nodes, tree->nodes_len, 0, 0, &tree->root);
+    BLI_task_pool_work_and_wait(pool);
+    BLI_task_pool_free(pool);
+  }
+  else {
+    tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  }
+  tree->nodes_len_balanced = tree->nodes_len;
 
 #ifdef DEBUG
   tree->is_balanced = true;
@@ -319,6 +418,15 @@ int BLI_kdtree_nd_(find_nearest)(const KDTree *tree,
     }
   }
 
+  for (uint i = tree->nodes_len_balanced; i < tree->nodes_len; i++) {
+    const KDTreeNode *node = &nodes[i];
+    cur_dist = len_squared_vnvn(node->co, co);
+    if (cur_dist < min_dist) {
+      min_dist = cur_dist;
+      min_node = node;
+    }
+  }
+
   if (r_nearest) {
     r_nearest->index = min_node->index;
     r_nearest->dist = sqrtf(min_dist);
@@ -424,6 +532,10 @@ int BLI_kdtree_nd_(find_nearest_cb)(
     }
   }
 
+  for (uint i = tree->nodes_len_balanced; i < tree->nodes_len; i++) {
+    NODE_TEST_NEAREST(&nodes[i]);
+  }
+
 #undef NODE_TEST_NEAREST
 
 finally:
@@ -580,6 +692,15 @@ int BLI_kdtree_nd_(find_nearest_n_with_len_squared_cb)(
     }
   }
 
+  for (i = tree->nodes_len_balanced; i < tree->nodes_len; i++) {
+    const KDTreeNode *node = &nodes[i];
+    cur_dist = len_sq_fn(co, node->co, user_data);
+    if (nearest_len < nearest_len_capacity || cur_dist < r_nearest[nearest_len - 1].dist) {
+      nearest_ordered_insert(
+          r_nearest, &nearest_len, nearest_len_capacity, node->index, cur_dist, node->co);
+    }
+  }
+
   for (i = 0; i < nearest_len; i++) {
     r_nearest[i].dist = sqrtf(r_nearest[i].dist);
   }
@@ -710,6 +831,15 @@ int BLI_kdtree_nd_(range_search_with_len_squared_cb)(
     }
   }
 
+  for (uint i = tree->nodes_len_balanced; i < tree->nodes_len; i++) {
+    const KDTreeNode *node = &nodes[i];
+    dist_sq = len_sq_fn(co, node->co, user_data);
+    if (dist_sq <= range_sq) {
+      nearest_add_in_range(
+          &nearest, nearest_len++, &nearest_len_capacity, node->index, dist_sq, node->co);
+    }
+  }
+
   if (stack != stack_default) {
     MEM_freeN(stack);
   }
@@ -800,12 +930,129 @@ void BLI_kdtree_nd_(range_search_cb)(
     }
   }
 
+  for (uint i = tree->nodes_len_balanced; i < tree->nodes_len; i++) {
+    const KDTreeNode *node = &nodes[i];
+    dist_sq = len_squared_vnvn(node->co, co);
+    if (dist_sq <= range_sq) {
+      if (search_cb(user_data, node->index, node->co, dist_sq) == false) {
+        goto finally;
+      }
+    }
+  }
+
 finally:
   if (stack != stack_default) {
     MEM_freeN(stack);
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Batch Queries
+ *
+ * Search for many points at once, spreading the queries over multiple threads.
+ * \{ */
+
+typedef struct KDTreeBatchData {
+  const KDTree *tree;
+  const float (*co)[KD_DIMS];
+  KDTreeNearest *r_nearest;
+  float range;
+  bool (*search_cb)(
+      void *user_data, uint co_index, int index, const float co[KD_DIMS], float dist_sq);
+  void *user_data;
+} KDTreeBatchData;
+
+static void kdtree_find_nearest_batch_cb(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDTreeBatchData *data = userdata;
+  KDTreeNearest *nearest = &data->r_nearest[i];
+  if (BLI_kdtree_nd_(find_nearest)(data->tree, data->co[i], nearest) == -1) {
+    nearest->index = -1;
+    nearest->dist = FLT_MAX;
+  }
+}
+
+/**
+ * Find the nearest point for each of \a co, the same as calling
+ * #BLI_kdtree_3d_find_nearest for every coordinate.
+ *
+ * \param r_nearest: Array of \a co_len results, the index is -1 when nothing was found.
+ */
+void BLI_kdtree_nd_(find_nearest_batch)(const KDTree *tree,
+                                        const float (*co)[KD_DIMS],
+                                        const uint co_len,
+                                        KDTreeNearest *r_nearest)
+{
+  KDTreeBatchData data = {
+      .tree = tree,
+      .co = co,
+      .r_nearest = r_nearest,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (co_len > KD_BATCH_THREAD_MIN);
+  BLI_task_parallel_range(0, (int)co_len, &data, kdtree_find_nearest_batch_cb, &settings);
+}
+
+typedef struct KDTreeBatchSearch {
+  const KDTreeBatchData *data;
+  uint co_index;
+} KDTreeBatchSearch;
+
+static bool kdtree_range_search_batch_search_cb(void *user_data,
+                                                int index,
+                                                const float co[KD_DIMS],
+                                                float dist_sq)
+{
+  const KDTreeBatchSearch *search = user_data;
+  return search->data->search_cb(search->data->user_data, search->co_index, index, co, dist_sq);
+}
+
+static void kdtree_range_search_batch_cb(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDTreeBatchData *data = userdata;
+  KDTreeBatchSearch search = {data, (uint)i};
+  BLI_kdtree_nd_(range_search_cb)(
+      data->tree, data->co[i], data->range, kdtree_range_search_batch_search_cb, &search);
+}
+
+/**
+ * A version of #BLI_kdtree_3d_range_search_cb which searches around each of \a co.
+ *
+ * \param search_cb: Called with the index of the query coordinate \a co_index,
+ * false return value stops searching for that coordinate.
+ * Calls for different coordinates may run at the same time (from different threads).
+ */
+void BLI_kdtree_nd_(range_search_batch_cb)(
+    const KDTree *tree,
+    const float (*co)[KD_DIMS],
+    const uint co_len,
+    float range,
+    bool (*search_cb)(
+        void *user_data, uint co_index, int index, const float co[KD_DIMS], float dist_sq),
+    void *user_data)
+{
+  KDTreeBatchData data = {
+      .tree = tree,
+      .co = co,
+      .range = range,
+      .search_cb = search_cb,
+      .user_data = user_data,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (co_len > KD_BATCH_THREAD_MIN);
+  BLI_task_parallel_range(0, (int)co_len, &data, kdtree_range_search_batch_cb, &settings);
+}
+
+/** \} */
+
 /**
  * Use when we want to loop over nodes ordered by index.
  * Requires indices to be aligned with nodes.
@@ -866,6 +1113,157 @@ static void deduplicate_recursive(const struct DeDuplicateParams *p, uint i)
   }
 }
 
+/**
+ * Collect the nodes within range of \a search_co, other than \a search itself.
+ * Only counts them when \a r_neighbors is NULL.
+ */
+static uint deduplicate_neighbors_recursive(const KDTreeNode *nodes,
+                                            const uint i,
+                                            const float search_co[KD_DIMS],
+                                            const int search,
+                                            const float range,
+                                            const float range_sq,
+                                            int *r_neighbors)
+{
+  const KDTreeNode *node = &nodes[i];
+  uint found = 0;
+  if (search_co[node->d] + range <= node->co[node->d]) {
+    if (node->left != KD_NODE_UNSET) {
+      found += deduplicate_neighbors_recursive(
+          nodes, node->left, search_co, search, range, range_sq, r_neighbors);
+    }
+  }
+  else if (search_co[node->d] - range >= node->co[node->d]) {
+    if (node->right != KD_NODE_UNSET) {
+      found += deduplicate_neighbors_recursive(
+          nodes, node->right, search_co, search, range, range_sq, r_neighbors);
+    }
+  }
+  else {
+    if ((search != node->index) && (len_squared_vnvn(node->co, search_co) <= range_sq)) {
+      if (r_neighbors) {
+        r_neighbors[found] = node->index;
+      }
+      found++;
+    }
+    if (node->left != KD_NODE_UNSET) {
+      found += deduplicate_neighbors_recursive(nodes,
+                                               node->left,
+                                               search_co,
+                                               search,
+                                               range,
+                                               range_sq,
+                                               r_neighbors ? r_neighbors + found : NULL);
+    }
+    if (node->right != KD_NODE_UNSET) {
+      found += deduplicate_neighbors_recursive(nodes,
+                                               node->right,
+                                               search_co,
+                                               search,
+                                               range,
+                                               range_sq,
+                                               r_neighbors ? r_neighbors + found : NULL);
+    }
+  }
+  return found;
+}
+
+typedef struct DeDuplicateNeighborsData {
+  const KDTree *tree;
+  float range;
+  float range_sq;
+  /** Start of the neighbors of every node, followed by the total number of neighbors. */
+  uint *offsets;
+  /** Neighbors of all nodes, NULL while counting. */
+  int *neighbors;
+} DeDuplicateNeighborsData;
+
+static void deduplicate_neighbors_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const DeDuplicateNeighborsData *data = userdata;
+  const KDTreeNode *nodes = data->tree->nodes;
+  const uint found = deduplicate_neighbors_recursive(
+      nodes,
+      data->tree->root,
+      nodes[i].co,
+      nodes[i].index,
+      data->range,
+      data->range_sq,
+      data->neighbors ? data->neighbors + data->offsets[i] : NULL);
+  if (data->neighbors == NULL) {
+    data->offsets[i] = found;
+  }
+}
+
+/**
+ * Find the neighbors of all nodes in parallel, so that the order dependent merging
+ * only has to loop over them. Returns false when there are too many neighbors to store.
+ */
+static bool deduplicate_neighbors_calc(const KDTree *tree,
+                                       const float range,
+                                       uint **r_offsets,
+                                       int **r_neighbors)
+{
+  DeDuplicateNeighborsData data = {
+      .tree = tree,
+      .range = range,
+      .range_sq = square_f(range),
+      .offsets = MEM_mallocN(sizeof(uint) * (tree->nodes_len + 1), __func__),
+      .neighbors = NULL,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = KD_BATCH_THREAD_MIN;
+  BLI_task_parallel_range(0, (int)tree->nodes_len, &data, deduplicate_neighbors_cb, &settings);
+
+  /* Turn the counts into offsets. */
+  const size_t neighbors_max = (size_t)tree->nodes_len * KD_DEDUPLICATE_NEIGHBORS_MAX;
+  size_t neighbors_len = 0;
+  for (uint i = 0; i < tree->nodes_len; i++) {
+    const uint count = data.offsets[i];
+    data.offsets[i] = (uint)neighbors_len;
+    neighbors_len += count;
+    if (neighbors_len > neighbors_max) {
+      MEM_freeN(data.offsets);
+      return false;
+    }
+  }
+  data.offsets[tree->nodes_len] = (uint)neighbors_len;
+
+  data.neighbors = MEM_mallocN(sizeof(int) * MAX2(neighbors_len, (size_t)1), __func__);
+  BLI_task_parallel_range(0, (int)tree->nodes_len, &data, deduplicate_neighbors_cb, &settings);
+
+  *r_offsets = data.offsets;
+  *r_neighbors = data.neighbors;
+  return true;
+}
+
+/**
+ * Merge the candidates around #DeDuplicateParams.search_co,
+ * using the neighbors of \a node_index when they have been calculated up-front.
+ */
+static void deduplicate_search(const struct DeDuplicateParams *p,
+                               const uint root,
+                               const uint node_index,
+                               const uint *neighbor_offsets,
+                               const int *neighbors)
+{
+  if (neighbors == NULL) {
+    deduplicate_recursive(p, root);
+    return;
+  }
+  for (uint j = neighbor_offsets[node_index]; j < neighbor_offsets[node_index + 1]; j++) {
+    const int index = neighbors[j];
+    if (p->duplicates[index] == -1) {
+      p->duplicates[index] = p->search;
+      *p->duplicates_found += 1;
+    }
+  }
+}
+
 /**
  * Find duplicate points in \a range.
  * Favors speed over quality since it doesn't find the best target vertex for merging.
@@ -890,6 +1288,10 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
                                          int *duplicates)
 {
   int found = 0;
+
+  /* Points inserted after balancing aren't supported. */
+  BLI_assert(tree->nodes_len_balanced == tree->nodes_len);
+
   struct DeDuplicateParams p = {
       .nodes = tree->nodes,
       .range = range,
@@ -898,6 +1300,12 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
       .duplicates_found = &found,
   };
 
+  uint *neighbor_offsets = NULL;
+  int *neighbors = NULL;
+  if (tree->nodes_len > KD_DEDUPLICATE_THREAD_MIN) {
+    deduplicate_neighbors_calc(tree, range, &neighbor_offsets, &neighbors);
+  }
+
   if (use_index_order) {
     uint *order = kdtree_order(tree);
     for (uint i = 0; i < tree->nodes_len; i++) {
@@ -907,7 +1315,7 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
         p.search = index;
         copy_vn_vn(p.search_co, tree->nodes[node_index].co);
         int found_prev = found;
-        deduplicate_recursive(&p, tree->root);
+        deduplicate_search(&p, tree->root, node_index, neighbor_offsets, neighbors);
         if (found != found_prev) {
           /* Prevent chains of doubles. */
           duplicates[index] = index;
@@ -924,7 +1332,7 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
         p.search = index;
         copy_vn_vn(p.search_co, tree->nodes[node_index].co);
         int found_prev = found;
-        deduplicate_recursive(&p, tree->root);
+        deduplicate_search(&p, tree->root, node_index, neighbor_offsets, neighbors);
         if (found != found_prev) {
           /* Prevent chains of doubles. */
           duplicates[index] = index;
@@ -932,6 +1340,11 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
       }
     }
   }
+
+  if (neighbors) {
+    MEM_freeN(neighbor_offsets);
+    MEM_freeN(neighbors);
+  }
   return found;
 }
 
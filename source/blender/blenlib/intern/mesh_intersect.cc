@@ -2384,6 +2384,150 @@ static CDT_data calc_cluster_subdivided(const CoplanarClusterInfo &clinfo,
   return cd_data;
 }
 
+struct PopulatePlaneData {
+  const IMesh &tm;
+  const TriOverlaps &tri_ov;
+
+  PopulatePlaneData(const IMesh &tm, const TriOverlaps &tri_ov) : tm(tm), tri_ov(tri_ov)
+  {
+  }
+};
+
+static void populate_plane_range_func(void *__restrict userdata,
+                                      const int iter,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const PopulatePlaneData *data = static_cast<const PopulatePlaneData *>(userdata);
+  if (data->tri_ov.first_overlap_index(iter) != -1) {
+    data->tm.face(iter)->populate_plane(true);
+  }
+}
+
+/**
+ * Calculate the exact planes of the triangles that overlap with some other triangle.
+ * The planes are needed by the intersection tests, and need arbitrary precision arithmetic,
+ * so this is done in parallel.
+ */
+static void populate_overlapping_planes(const IMesh &tm, const TriOverlaps &tri_ov)
+{
+  PopulatePlaneData data(tm, tri_ov);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1000;
+  settings.use_threading = intersect_use_threading;
+  BLI_task_parallel_range(0, tm.face_size(), &data, populate_plane_range_func, &settings);
+}
+
+struct ClusterSubdivideData {
+  Array<CDT_data> &r_cluster_subdivided;
+  const CoplanarClusterInfo &clinfo;
+  const IMesh &tm;
+  const TriOverlaps &ov;
+  const Map<std::pair<int, int>, ITT_value> &itt_map;
+  IMeshArena *arena;
+
+  ClusterSubdivideData(Array<CDT_data> &r_cluster_subdivided,
+                       const CoplanarClusterInfo &clinfo,
+                       const IMesh &tm,
+                       const TriOverlaps &ov,
+                       const Map<std::pair<int, int>, ITT_value> &itt_map,
+                       IMeshArena *arena)
+      : r_cluster_subdivided(r_cluster_subdivided),
+        clinfo(clinfo),
+        tm(tm),
+        ov(ov),
+        itt_map(itt_map),
+        arena(arena)
+  {
+  }
+};
+
+static void calc_cluster_subdivided_range_func(void *__restrict userdata,
+                                               const int iter,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ClusterSubdivideData *data = static_cast<ClusterSubdivideData *>(userdata);
+  data->r_cluster_subdivided[iter] = calc_cluster_subdivided(
+      data->clinfo, iter, data->tm, data->ov, data->itt_map, data->arena);
+}
+
+/**
+ * Fill in \a r_cluster_subdivided with the subdivision of every cluster.
+ * The clusters are independent, so they are subdivided in parallel.
+ */
+static void calc_clusters_subdivided(Array<CDT_data> &r_cluster_subdivided,
+                                     const CoplanarClusterInfo &clinfo,
+                                     const IMesh &tm,
+                                     const TriOverlaps &ov,
+                                     const Map<std::pair<int, int>, ITT_value> &itt_map,
+                                     IMeshArena *arena)
+{
+  ClusterSubdivideData data(r_cluster_subdivided, clinfo, tm, ov, itt_map, arena);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  settings.use_threading = intersect_use_threading;
+  BLI_task_parallel_range(
+      0, clinfo.tot_cluster(), &data, calc_cluster_subdivided_range_func, &settings);
+}
+
+struct ExtractTrisData {
+  Array<IMesh> &r_tri_subdivided;
+  const Array<CDT_data> &cluster_subdivided;
+  const CoplanarClusterInfo &clinfo;
+  const IMesh &tm;
+  IMeshArena *arena;
+
+  ExtractTrisData(Array<IMesh> &r_tri_subdivided,
+                  const Array<CDT_data> &cluster_subdivided,
+                  const CoplanarClusterInfo &clinfo,
+                  const IMesh &tm,
+                  IMeshArena *arena)
+      : r_tri_subdivided(r_tri_subdivided),
+        cluster_subdivided(cluster_subdivided),
+        clinfo(clinfo),
+        tm(tm),
+        arena(arena)
+  {
+  }
+};
+
+static void extract_tri_range_func(void *__restrict userdata,
+                                   const int iter,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ExtractTrisData *data = static_cast<ExtractTrisData *>(userdata);
+  const int t = iter;
+  const int c = data->clinfo.tri_cluster(t);
+  if (c != NO_INDEX) {
+    BLI_assert(data->r_tri_subdivided[t].face_size() == 0);
+    data->r_tri_subdivided[t] = extract_subdivided_tri(
+        data->cluster_subdivided[c], data->tm, t, data->arena);
+  }
+  else if (data->r_tri_subdivided[t].face_size() == 0) {
+    data->r_tri_subdivided[t] = extract_single_tri(data->tm, t);
+  }
+}
+
+/**
+ * Fill in the slots of \a r_tri_subdivided that #calc_subdivided_tris did not handle:
+ * triangles in clusters get their part of the cluster subdivision,
+ * the remaining ones are just copied.
+ */
+static void extract_remaining_tris(Array<IMesh> &r_tri_subdivided,
+                                   const Array<CDT_data> &cluster_subdivided,
+                                   const CoplanarClusterInfo &clinfo,
+                                   const IMesh &tm,
+                                   IMeshArena *arena)
+{
+  ExtractTrisData data(r_tri_subdivided, cluster_subdivided, clinfo, tm, arena);
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1000;
+  settings.use_threading = intersect_use_threading;
+  BLI_task_parallel_range(0, tm.face_size(), &data, extract_tri_range_func, &settings);
+}
+
 static IMesh union_tri_subdivides(const blender::Array<IMesh> &tri_subdivided)
 {
   int tot_tri = 0;
@@ -2672,11 +2816,7 @@ IMesh trimesh_nary_intersect(const IMesh &tm_in,
   double overlap_time = PIL_check_seconds_timer();
   std::cout << "intersect overlaps calculated, time = " << overlap_time - bb_calc_time << "\n";
 #  endif
-  for (int t : tm_clean->face_index_range()) {
-    if (tri_ov.first_overlap_index(t) != -1) {
-      tm_clean->face(t)->populate_plane(true);
-    }
-  }
+  populate_overlapping_planes(*tm_clean, tri_ov);
 #  ifdef PERFDEBUG
   double plane_populate = PIL_check_seconds_timer();
   std::cout << "planes populated, time = " << plane_populate - overlap_time << "\n";
@@ -2708,24 +2848,13 @@ IMesh trimesh_nary_intersect(const IMesh &tm_in,
   std::cout << "subdivided tris found, time = " << subdivided_tris_time - itt_time << "\n";
 #  endif
   Array<CDT_data> cluster_subdivided(clinfo.tot_cluster());
-  for (int c : clinfo.index_range()) {
-    cluster_subdivided[c] = calc_cluster_subdivided(clinfo, c, *tm_clean, tri_ov, itt_map, arena);
-  }
+  calc_clusters_subdivided(cluster_subdivided, clinfo, *tm_clean, tri_ov, itt_map, arena);
 #  ifdef PERFDEBUG
   double cluster_subdivide_time = PIL_check_seconds_timer();
   std::cout << "subdivided clusters found, time = "
             << cluster_subdivide_time - subdivided_tris_time << "\n";
 #  endif
-  for (int t : tm_clean->face_index_range()) {
-    int c = clinfo.tri_cluster(t);
-    if (c != NO_INDEX) {
-      BLI_assert(tri_subdivided[t].face_size() == 0);
-      tri_subdivided[t] = extract_subdivided_tri(cluster_subdivided[c], *tm_clean, t, arena);
-    }
-    else if (tri_subdivided[t].face_size() == 0) {
-      tri_subdivided[t] = extract_single_tri(*tm_clean, t);
-    }
-  }
+  extract_remaining_tris(tri_subdivided, cluster_subdivided, clinfo, *tm_clean, arena);
 #  ifdef PERFDEBUG
   double extract_time = PIL_check_seconds_timer();
   std::cout << "triangles extracted, time = " << extract_time - cluster_subdivide_time << "\n";
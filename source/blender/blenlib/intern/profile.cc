@@ -0,0 +1,344 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "BLI_fileops.h"
+#include "BLI_profile.h"
+#include "BLI_string.h"
+#include "BLI_threads.h"
+#include "BLI_utildefines.h"
+
+namespace blender::profile {
+
+using Clock = std::chrono::steady_clock;
+
+enum class EventType : uint8_t {
+  Zone,
+  Counter,
+};
+
+struct Event {
+  const char *name;
+  uint64_t start_ns;
+  /** End time for zones, value for counters. */
+  int64_t end_ns_or_value;
+  int depth;
+  EventType type;
+  /** Copied, the detail string of a zone typically belongs to data which may be freed. */
+  char detail[35];
+};
+
+/** Oldest events get overwritten once a thread recorded that many. */
+static constexpr uint64_t THREAD_EVENTS_MAX = 1 << 14;
+/** Threads starting to record after that many did are ignored, to bound memory usage. */
+static constexpr size_t THREADS_MAX = 256;
+
+/** Events of a single thread, only ever written to by that thread. */
+struct ThreadBuffer {
+  int thread_id;
+  bool is_main_thread;
+  int depth = 0;
+  std::unique_ptr<Event[]> events;
+  /** Total number of recorded events, the ring buffer index is this modulo the capacity. */
+  std::atomic<uint64_t> events_num = 0;
+};
+
+static struct {
+  std::atomic<bool> is_enabled = false;
+  /** Incremented when buffers get freed, so threads don't keep using them. */
+  std::atomic<int> generation = 0;
+  Clock::time_point start_time = Clock::now();
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  std::string output_filepath;
+} g_profile;
+
+static thread_local ThreadBuffer *thread_buffer = nullptr;
+static thread_local int thread_buffer_generation = -1;
+
+static uint64_t time_ns()
+{
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                                        g_profile.start_time)
+      .count();
+}
+
+static ThreadBuffer *thread_buffer_ensure()
+{
+  const int generation = g_profile.generation.load(std::memory_order_relaxed);
+  if (LIKELY(thread_buffer_generation == generation)) {
+    return thread_buffer;
+  }
+
+  std::lock_guard lock(g_profile.mutex);
+  thread_buffer_generation = generation;
+  thread_buffer = nullptr;
+  if (g_profile.buffers.size() < THREADS_MAX) {
+    std::unique_ptr<ThreadBuffer> buffer = std::make_unique<ThreadBuffer>();
+    buffer->thread_id = (int)g_profile.buffers.size();
+    buffer->is_main_thread = BLI_thread_is_main();
+    buffer->events = std::make_unique<Event[]>(THREAD_EVENTS_MAX);
+    thread_buffer = buffer.get();
+    g_profile.buffers.push_back(std::move(buffer));
+  }
+  return thread_buffer;
+}
+
+/** The event is only visible to the exporter once #event_commit is called. */
+static Event &event_next(ThreadBuffer &buffer)
+{
+  const uint64_t index = buffer.events_num.load(std::memory_order_relaxed);
+  return buffer.events[index % THREAD_EVENTS_MAX];
+}
+
+static void event_commit(ThreadBuffer &buffer)
+{
+  buffer.events_num.fetch_add(1, std::memory_order_release);
+}
+
+static void json_write_string(FILE *fp, const char *str)
+{
+  fputc('"', fp);
+  for (const char *c = str; *c; c++) {
+    if (ELEM(*c, '"', '\\')) {
+      fputc('\\', fp);
+      fputc(*c, fp);
+    }
+    else if ((uchar)*c < 0x20) {
+      fprintf(fp, "\\u%04x", (uint)(uchar)*c);
+    }
+    else {
+      fputc(*c, fp);
+    }
+  }
+  fputc('"', fp);
+}
+
+static void write_chrome_trace(FILE *fp)
+{
+  std::lock_guard lock(g_profile.mutex);
+
+  const char *sep = "\n";
+  fprintf(fp, "{\"traceEvents\":[");
+  for (const std::unique_ptr<ThreadBuffer> &buffer : g_profile.buffers) {
+    fprintf(fp,
+            "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+            "\"args\":{\"name\":",
+            sep,
+            buffer->thread_id);
+    if (buffer->is_main_thread) {
+      fprintf(fp, "\"Main\"}}");
+    }
+    else {
+      fprintf(fp, "\"Thread %d\"}}", buffer->thread_id);
+    }
+    sep = ",\n";
+
+    const uint64_t events_num = buffer->events_num.load(std::memory_order_acquire);
+    const uint64_t first = (events_num > THREAD_EVENTS_MAX) ? events_num - THREAD_EVENTS_MAX : 0;
+    for (uint64_t i = first; i < events_num; i++) {
+      const Event &event = buffer->events[i % THREAD_EVENTS_MAX];
+      fprintf(fp, "%s{\"name\":", sep);
+      json_write_string(fp, event.name);
+      if (event.type == EventType::Zone) {
+        fprintf(fp,
+                ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d,\"args\":{\"depth\":%d",
+                (double)event.start_ns / 1e3,
+                (double)(event.end_ns_or_value - (int64_t)event.start_ns) / 1e3,
+                buffer->thread_id,
+                event.depth);
+        if (event.detail[0]) {
+          fprintf(fp, ",\"detail\":");
+          json_write_string(fp, event.detail);
+        }
+        fprintf(fp, "}}");
+      }
+      else {
+        fprintf(fp,
+                ",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":%d,\"args\":{\"value\":%lld}}",
+                (double)event.start_ns / 1e3,
+                buffer->thread_id,
+                (long long)event.end_ns_or_value);
+      }
+    }
+  }
+  fprintf(fp, "\n]}\n");
+}
+
+}  // namespace blender::profile
+
+using namespace blender::profile;
+
+/**
+ * Start or stop recording zones and counters, recorded events are kept when stopping.
+ */
+void BLI_profile_enable(bool enable)
+{
+  g_profile.is_enabled.store(enable, std::memory_order_relaxed);
+}
+
+bool BLI_profile_is_enabled(void)
+{
+  return g_profile.is_enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Enable profiling and write the trace to \a filepath on #BLI_profile_exit.
+ */
+void BLI_profile_output_set(const char *filepath)
+{
+  {
+    std::lock_guard lock(g_profile.mutex);
+    g_profile.output_filepath = filepath;
+  }
+  BLI_profile_enable(true);
+}
+
+/**
+ * Drop all recorded events. Zones which are in progress must not be ended on other threads
+ * at the same time.
+ */
+void BLI_profile_clear(void)
+{
+  std::lock_guard lock(g_profile.mutex);
+  for (std::unique_ptr<ThreadBuffer> &buffer : g_profile.buffers) {
+    buffer->events_num.store(0, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * Export all recorded events of all threads. Events recorded while exporting may be missing, or
+ * partially overwritten when a ring buffer wraps around, so export after disabling profiling.
+ */
+bool BLI_profile_write_chrome_trace(const char *filepath)
+{
+  FILE *fp = BLI_fopen(filepath, "w");
+  if (fp == nullptr) {
+    return false;
+  }
+  write_chrome_trace(fp);
+  return (fclose(fp) == 0);
+}
+
+/**
+ * Write the trace set by #BLI_profile_output_set (if any), and free all buffers.
+ */
+void BLI_profile_exit(void)
+{
+  BLI_profile_enable(false);
+
+  std::string filepath;
+  {
+    std::lock_guard lock(g_profile.mutex);
+    filepath = std::move(g_profile.output_filepath);
+    g_profile.output_filepath.clear();
+  }
+  if (!filepath.empty()) {
+    if (BLI_profile_write_chrome_trace(filepath.c_str())) {
+      printf("Profile written to '%s'\n", filepath.c_str());
+    }
+    else {
+      printf("Error: could not write profile to '%s'\n", filepath.c_str());
+    }
+  }
+
+  std::lock_guard lock(g_profile.mutex);
+  g_profile.generation.fetch_add(1, std::memory_order_relaxed);
+  g_profile.buffers.clear();
+}
+
+/**
+ * Start a zone, \a name must be a static string. \a detail (may be NULL) must remain valid until
+ * #BLI_profile_zone_end, which must be called on the same thread.
+ */
+void BLI_profile_zone_begin(ProfileZone *zone, const char *name, const char *detail)
+{
+  zone->is_active = false;
+  if (LIKELY(!g_profile.is_enabled.load(std::memory_order_relaxed))) {
+    return;
+  }
+  ThreadBuffer *buffer = thread_buffer_ensure();
+  if (buffer == nullptr) {
+    return;
+  }
+  zone->is_active = true;
+  zone->name = name;
+  zone->detail = detail;
+  zone->depth = buffer->depth++;
+  zone->start_ns = time_ns();
+}
+
+void BLI_profile_zone_end(ProfileZone *zone)
+{
+  if (LIKELY(!zone->is_active)) {
+    return;
+  }
+  const uint64_t end_ns = time_ns();
+  /* Buffers may have been freed by #BLI_profile_exit in the meantime. */
+  if (thread_buffer_generation != g_profile.generation.load(std::memory_order_relaxed)) {
+    return;
+  }
+  ThreadBuffer &buffer = *thread_buffer;
+  buffer.depth--;
+  BLI_assert(buffer.depth == zone->depth);
+
+  Event &event = event_next(buffer);
+  event.type = EventType::Zone;
+  event.name = zone->name;
+  event.start_ns = zone->start_ns;
+  event.end_ns_or_value = (int64_t)end_ns;
+  event.depth = zone->depth;
+  if (zone->detail) {
+    BLI_strncpy(event.detail, zone->detail, sizeof(event.detail));
+  }
+  else {
+    event.detail[0] = '\0';
+  }
+  event_commit(buffer);
+}
+
+/**
+ * Record the value of a counter, \a name must be a static string.
+ */
+void BLI_profile_counter(const char *name, int64_t value)
+{
+  if (LIKELY(!g_profile.is_enabled.load(std::memory_order_relaxed))) {
+    return;
+  }
+  ThreadBuffer *buffer = thread_buffer_ensure();
+  if (buffer == nullptr) {
+    return;
+  }
+  Event &event = event_next(*buffer);
+  event.type = EventType::Counter;
+  event.name = name;
+  event.start_ns = time_ns();
+  event.end_ns_or_value = value;
+  event.depth = buffer->depth;
+  event.detail[0] = '\0';
+  event_commit(*buffer);
+}
@@ -16,6 +16,8 @@
 
 #include "BLI_timeit.hh"
 
+#include <algorithm>
+
 namespace blender::timeit {
 
 void print_duration(Nanoseconds duration)
@@ -31,4 +33,16 @@ void print_duration(Nanoseconds duration)
   }
 }
 
+void print_throughput(const int64_t elements, Nanoseconds duration)
+{
+  const double seconds = std::max<double>(duration.count(), 1) / 1.0e9;
+  const double elements_per_second = elements / seconds;
+  if (elements_per_second < 1.0e6) {
+    std::cout << elements_per_second << " elements/s";
+  }
+  else {
+    std::cout << elements_per_second / 1.0e6 << " M elements/s";
+  }
+}
+
 }  // namespace blender::timeit
@@ -800,6 +800,11 @@ TEST(array_store, TestChunk_Rand31_Stride11_Chunk21)
 {
   random_chunk_mutate_helper(31, 100, 11, 21, 7117);
 }
+/* Large enough to hash & accumulate using threads. */
+TEST(array_store, TestChunk_Rand2048_Stride4_Chunk64)
+{
+  random_chunk_mutate_helper(2048, 4, 4, 64, 4441);
+}
 
 #if 0
 /* -------------------------------------------------------------------- */
@@ -0,0 +1,75 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_compress.h"
+#include "BLI_threads.h"
+#include "BLI_utildefines.h"
+
+#include <string.h>
+
+static void compress_roundtrip(const size_t data_len)
+{
+  char *data = (char *)MEM_mallocN(MAX2(data_len, 1), __func__);
+  for (size_t i = 0; i < data_len; i++) {
+    data[i] = (char)((i * 7) % 251);
+  }
+
+  size_t compressed_len;
+  void *compressed = BLI_compress_mem(data, data_len, 1, &compressed_len);
+  ASSERT_NE(compressed, nullptr);
+  EXPECT_GT(compressed_len, 0);
+
+  char *result = (char *)MEM_mallocN(MAX2(data_len, 1), __func__);
+  EXPECT_EQ(BLI_decompress_mem(compressed, compressed_len, result, data_len), data_len);
+  EXPECT_EQ(memcmp(data, result, data_len), 0);
+
+  MEM_freeN(result);
+  MEM_freeN(compressed);
+  MEM_freeN(data);
+}
+
+TEST(compress, RoundtripSmall)
+{
+  compress_roundtrip(1000);
+}
+
+TEST(compress, RoundtripMultipleBlocks)
+{
+  BLI_threadapi_init();
+  compress_roundtrip(BLI_COMPRESS_BLOCK_SIZE * 3 + 123);
+  BLI_threadapi_exit();
+}
+
+TEST(compress, DecompressSingleBlock)
+{
+  BLI_threadapi_init();
+
+  const size_t data_len = BLI_COMPRESS_BLOCK_SIZE * 2;
+  char *data = (char *)MEM_mallocN(data_len, __func__);
+  memset(data, 'a', BLI_COMPRESS_BLOCK_SIZE);
+  memset(data + BLI_COMPRESS_BLOCK_SIZE, 'b', BLI_COMPRESS_BLOCK_SIZE);
+
+  CompressBlock blocks[2];
+  blocks[0].data = data;
+  blocks[0].data_len = BLI_COMPRESS_BLOCK_SIZE;
+  blocks[1].data = data + BLI_COMPRESS_BLOCK_SIZE;
+  blocks[1].data_len = BLI_COMPRESS_BLOCK_SIZE;
+  EXPECT_TRUE(BLI_compress_blocks(blocks, 2, 1));
+
+  /* The second block is decompressed without the first one. */
+  char *result = (char *)MEM_mallocN(BLI_COMPRESS_BLOCK_SIZE, __func__);
+  EXPECT_EQ(BLI_decompress_mem(
+                blocks[1].compressed, blocks[1].compressed_len, result, BLI_COMPRESS_BLOCK_SIZE),
+            BLI_COMPRESS_BLOCK_SIZE);
+  EXPECT_EQ(memcmp(data + BLI_COMPRESS_BLOCK_SIZE, result, BLI_COMPRESS_BLOCK_SIZE), 0);
+
+  MEM_freeN(result);
+  MEM_freeN(blocks[0].compressed);
+  MEM_freeN(blocks[1].compressed);
+  MEM_freeN(data);
+
+  BLI_threadapi_exit();
+}
@@ -0,0 +1,41 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <atomic>
+
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_task.hh"
+#include "BLI_threads.h"
+
+namespace blender::threading::tests {
+
+TEST(enumerable_thread_specific, LocalIsStable)
+{
+  EnumerableThreadSpecific<int> values;
+  int &value = values.local();
+  value = 5;
+  EXPECT_EQ(&values.local(), &value);
+  EXPECT_EQ(values.local(), 5);
+}
+
+TEST(enumerable_thread_specific, SumOverThreads)
+{
+  BLI_threadapi_init();
+
+  EnumerableThreadSpecific<int64_t> sums;
+  parallel_for(IndexRange(1000), 10, [&](IndexRange range) {
+    int64_t &sum = sums.local();
+    for (const int64_t i : range) {
+      sum += i;
+    }
+  });
+
+  int64_t sum = 0;
+  sums.foreach_value([&](int64_t value) { sum += value; });
+  EXPECT_EQ(sum, 999 * 1000 / 2);
+
+  BLI_threadapi_exit();
+}
+
+}  // namespace blender::threading::tests
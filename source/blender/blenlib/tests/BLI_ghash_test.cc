@@ -207,3 +207,51 @@ TEST(ghash, Pop)
 
   BLI_ghash_free(ghash, nullptr, nullptr);
 }
+
+/* Check removed buckets are reused or cleaned up, keeping lookups and pointers valid. */
+TEST(ghash, RemoveReinsert)
+{
+  GHash *ghash = BLI_ghash_new(BLI_ghashutil_inthash_p, BLI_ghashutil_intcmp, __func__);
+  unsigned int keys[TESTCASE_SIZE];
+  void **vals_p[TESTCASE_SIZE];
+  int i, pass;
+
+  init_keys(keys, 40);
+
+  for (i = 0; i < TESTCASE_SIZE; i++) {
+    EXPECT_FALSE(BLI_ghash_ensure_p(ghash, POINTER_FROM_UINT(keys[i]), &vals_p[i]));
+    *vals_p[i] = POINTER_FROM_UINT(keys[i]);
+  }
+
+  /* Keep removing and adding back half of the keys, the other half must remain untouched. */
+  for (pass = 0; pass < 8; pass++) {
+    for (i = 0; i < TESTCASE_SIZE; i += 2) {
+      EXPECT_TRUE(BLI_ghash_remove(ghash, POINTER_FROM_UINT(keys[i]), nullptr, nullptr));
+    }
+    EXPECT_EQ(BLI_ghash_len(ghash), TESTCASE_SIZE / 2);
+    for (i = 0; i < TESTCASE_SIZE; i += 2) {
+      EXPECT_TRUE(BLI_ghash_reinsert(
+          ghash, POINTER_FROM_UINT(keys[i]), POINTER_FROM_UINT(keys[i]), nullptr, nullptr));
+    }
+    EXPECT_EQ(BLI_ghash_len(ghash), TESTCASE_SIZE);
+  }
+
+  for (i = 0; i < TESTCASE_SIZE; i++) {
+    EXPECT_EQ(POINTER_AS_UINT(BLI_ghash_lookup(ghash, POINTER_FROM_UINT(keys[i]))), keys[i]);
+  }
+  for (i = 1; i < TESTCASE_SIZE; i += 2) {
+    EXPECT_EQ(BLI_ghash_lookup_p(ghash, POINTER_FROM_UINT(keys[i])), vals_p[i]);
+  }
+
+  {
+    GHashIterator gh_iter;
+    int count = 0;
+    GHASH_ITER (gh_iter, ghash) {
+      EXPECT_EQ(BLI_ghashIterator_getKey(&gh_iter), BLI_ghashIterator_getValue(&gh_iter));
+      count++;
+    }
+    EXPECT_EQ(count, TESTCASE_SIZE);
+  }
+
+  BLI_ghash_free(ghash, nullptr, nullptr);
+}
@@ -132,3 +132,225 @@ TEST(kdopbvh, OptimalFindNearest_500)
 {
   find_nearest_points_test(500, 1.0, 1000, 12, true);
 }
+
+static void nearest_point_callback(void *userdata,
+                                   int index,
+                                   const float co[3],
+                                   BVHTreeNearest *nearest)
+{
+  const float(*points)[3] = (const float(*)[3])userdata;
+  const float dist_sq = len_squared_v3v3(co, points[index]);
+  if (dist_sq < nearest->dist_sq) {
+    nearest->index = index;
+    nearest->dist_sq = dist_sq;
+    copy_v3_v3(nearest->co, points[index]);
+  }
+}
+
+/**
+ * Check the batched search finds the same distances as searching every coordinate on its own.
+ */
+static void find_nearest_batch_test(int points_len, int co_len, float max_dist, int random_seed)
+{
+  struct RNG *rng = BLI_rng_new(random_seed);
+  BVHTree *tree = BLI_bvhtree_new(points_len, 0.0, 8, 8);
+
+  float(*points)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * points_len, __func__);
+  float(*co)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * co_len, __func__);
+  BVHTreeNearest *nearest = (BVHTreeNearest *)MEM_mallocN(sizeof(*nearest) * co_len, __func__);
+
+  for (int i = 0; i < points_len; i++) {
+    rng_v3_round(points[i], 3, rng, 1000, 1.0f);
+    BLI_bvhtree_insert(tree, i, points[i], 1);
+  }
+  BLI_bvhtree_balance(tree);
+
+  for (int i = 0; i < co_len; i++) {
+    rng_v3_round(co[i], 3, rng, 100000, 1.2f);
+    nearest[i].index = -1;
+    nearest[i].dist_sq = max_dist * max_dist;
+  }
+
+  BLI_bvhtree_find_nearest_batch(tree, co, co_len, nearest, nearest_point_callback, points, 0);
+
+  for (int i = 0; i < co_len; i++) {
+    BVHTreeNearest single;
+    single.index = -1;
+    single.dist_sq = max_dist * max_dist;
+    BLI_bvhtree_find_nearest(tree, co[i], &single, nearest_point_callback, points);
+
+    EXPECT_EQ(nearest[i].index == -1, single.index == -1);
+    if (single.index != -1) {
+      EXPECT_EQ(nearest[i].dist_sq, single.dist_sq);
+      EXPECT_EQ_ARRAY(points[nearest[i].index], nearest[i].co, 3);
+    }
+  }
+
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(points);
+  MEM_freeN(co);
+  MEM_freeN(nearest);
+}
+
+TEST(kdopbvh, FindNearestBatch_1)
+{
+  find_nearest_batch_test(1, 10, FLT_MAX, 1234);
+}
+TEST(kdopbvh, FindNearestBatch_500)
+{
+  find_nearest_batch_test(500, 10000, FLT_MAX, 12);
+}
+TEST(kdopbvh, FindNearestBatch_MaxDist)
+{
+  find_nearest_batch_test(500, 10000, 0.05f, 123);
+}
+
+/* -------------------------------------------------------------------- */
+/* Ray Cast */
+
+struct RayCastSpheres {
+  const float (*centers)[3];
+  float radius;
+};
+
+static float ray_sphere_dist(const float center[3],
+                             const float radius,
+                             const float origin[3],
+                             const float dir[3])
+{
+  float oc[3];
+  sub_v3_v3v3(oc, center, origin);
+  const float t = dot_v3v3(oc, dir);
+  const float d_sq = len_squared_v3(oc) - t * t;
+  const float r_sq = radius * radius;
+  if (d_sq > r_sq) {
+    return FLT_MAX;
+  }
+  const float dist = t - sqrtf(r_sq - d_sq);
+  return (dist >= 0.0f) ? dist : FLT_MAX;
+}
+
+static void ray_cast_spheres_callback(void *userdata,
+                                      int index,
+                                      const BVHTreeRay *ray,
+                                      BVHTreeRayHit *hit)
+{
+  const RayCastSpheres *data = (const RayCastSpheres *)userdata;
+  const float dist = ray_sphere_dist(
+      data->centers[index], data->radius, ray->origin, ray->direction);
+  if (dist < hit->dist) {
+    hit->index = index;
+    hit->dist = dist;
+  }
+}
+
+static void ray_cast_test(int points_len, char tree_type, int random_seed)
+{
+  struct RNG *rng = BLI_rng_new(random_seed);
+  BVHTree *tree = BLI_bvhtree_new(points_len, 0.0, tree_type, 6);
+  const float radius = 0.05f;
+
+  float(*centers)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * points_len, __func__);
+  for (int i = 0; i < points_len; i++) {
+    rng_v3_round(centers[i], 3, rng, 1000, 1.0f);
+    float bounds[2][3];
+    copy_v3_v3(bounds[0], centers[i]);
+    copy_v3_v3(bounds[1], centers[i]);
+    add_v3_fl(bounds[0], -radius);
+    add_v3_fl(bounds[1], radius);
+    BLI_bvhtree_insert(tree, i, bounds[0], 2);
+  }
+  BLI_bvhtree_balance(tree);
+
+  RayCastSpheres data = {centers, radius};
+  for (int i = 0; i < 200; i++) {
+    float origin[3], dir[3];
+    rng_v3_round(origin, 3, rng, 1000, 2.0f);
+    BLI_rng_get_float_unit_v3(rng, dir);
+    /* Also cover rays parallel to an axis. */
+    if (i % 10 == 0) {
+      zero_v3(dir);
+      dir[i % 3] = (i % 20 == 0) ? 1.0f : -1.0f;
+    }
+
+    int index_expect = -1;
+    float dist_expect = BVH_RAYCAST_DIST_MAX;
+    for (int j = 0; j < points_len; j++) {
+      const float dist = ray_sphere_dist(centers[j], radius, origin, dir);
+      if (dist < dist_expect) {
+        index_expect = j;
+        dist_expect = dist;
+      }
+    }
+
+    BVHTreeRayHit hit;
+    hit.index = -1;
+    hit.dist = BVH_RAYCAST_DIST_MAX;
+    BLI_bvhtree_ray_cast(tree, origin, dir, 0.0f, &hit, ray_cast_spheres_callback, &data);
+    EXPECT_EQ(hit.index, index_expect);
+    if (index_expect != -1) {
+      EXPECT_FLOAT_EQ(hit.dist, dist_expect);
+    }
+  }
+
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(centers);
+}
+
+TEST(kdopbvh, RayCast_Binary)
+{
+  ray_cast_test(500, 2, 12);
+}
+TEST(kdopbvh, RayCast_Quad)
+{
+  ray_cast_test(500, 4, 123);
+}
+TEST(kdopbvh, RayCast_Oct)
+{
+  ray_cast_test(500, 8, 1234);
+}
+
+/* -------------------------------------------------------------------- */
+/* Update */
+
+static void update_tree_test(int points_len, int random_seed)
+{
+  struct RNG *rng = BLI_rng_new(random_seed);
+  BVHTree *tree = BLI_bvhtree_new(points_len, 0.0, 4, 6);
+
+  float(*points)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * points_len, __func__);
+  for (int i = 0; i < points_len; i++) {
+    rng_v3_round(points[i], 3, rng, 1000, 1.0f);
+    BLI_bvhtree_insert(tree, i, points[i], 1);
+  }
+  BLI_bvhtree_balance(tree);
+
+  /* Move all points, the refit tree must still find every point. */
+  for (int i = 0; i < points_len; i++) {
+    rng_v3_round(points[i], 3, rng, 1000, 1.0f);
+    BLI_bvhtree_update_node(tree, i, points[i], nullptr, 1);
+  }
+  BLI_bvhtree_update_tree(tree);
+
+  for (int i = 0; i < points_len; i++) {
+    const int j = BLI_bvhtree_find_nearest(tree, points[i], nullptr, nullptr, nullptr);
+    EXPECT_GE(j, 0);
+    EXPECT_LT(j, points_len);
+    EXPECT_EQ_ARRAY(points[i], points[j], 3);
+  }
+
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(points);
+}
+
+TEST(kdopbvh, UpdateTree_500)
+{
+  update_tree_test(500, 12);
+}
+TEST(kdopbvh, UpdateTree_10000)
+{
+  update_tree_test(10000, 123);
+}
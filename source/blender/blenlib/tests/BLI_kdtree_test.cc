@@ -0,0 +1,194 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <array>
+#include <vector>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_kdtree.h"
+#include "BLI_math_vector.h"
+#include "BLI_rand.h"
+
+static std::vector<std::array<float, 3>> random_points(const int points_len, const int seed)
+{
+  RNG *rng = BLI_rng_new(seed);
+  std::vector<std::array<float, 3>> points(points_len);
+  for (std::array<float, 3> &co : points) {
+    for (float &value : co) {
+      value = BLI_rng_get_float(rng) * 2.0f - 1.0f;
+    }
+  }
+  BLI_rng_free(rng);
+  return points;
+}
+
+static float nearest_dist_brute_force(const std::vector<std::array<float, 3>> &points,
+                                      const int points_len,
+                                      const float co[3])
+{
+  float dist_min = FLT_MAX;
+  for (int i = 0; i < points_len; i++) {
+    dist_min = min_ff(dist_min, len_v3v3(points[i].data(), co));
+  }
+  return dist_min;
+}
+
+static int range_count_brute_force(const std::vector<std::array<float, 3>> &points,
+                                   const int points_len,
+                                   const float co[3],
+                                   const float range)
+{
+  int count = 0;
+  for (int i = 0; i < points_len; i++) {
+    if (len_squared_v3v3(points[i].data(), co) <= range * range) {
+      count++;
+    }
+  }
+  return count;
+}
+
+TEST(kdtree, BalanceLarge)
+{
+  /* Large enough to be balanced in parallel. */
+  const int points_len = 50000;
+  std::vector<std::array<float, 3>> points = random_points(points_len, 12);
+  std::vector<std::array<float, 3>> queries = random_points(100, 123);
+
+  KDTree_3d *tree = BLI_kdtree_3d_new(points_len);
+  for (int i = 0; i < points_len; i++) {
+    BLI_kdtree_3d_insert(tree, i, points[i].data());
+  }
+  BLI_kdtree_3d_balance(tree);
+
+  for (const std::array<float, 3> &co : queries) {
+    KDTreeNearest_3d nearest;
+    EXPECT_NE(BLI_kdtree_3d_find_nearest(tree, co.data(), &nearest), -1);
+    EXPECT_FLOAT_EQ(nearest.dist, nearest_dist_brute_force(points, points_len, co.data()));
+  }
+  BLI_kdtree_3d_free(tree);
+}
+
+TEST(kdtree, InsertAfterBalance)
+{
+  const int points_len = 2000;
+  const int points_balanced_len = 500;
+  std::vector<std::array<float, 3>> points = random_points(points_len, 1234);
+  std::vector<std::array<float, 3>> queries = random_points(20, 12345);
+
+  KDTree_3d *tree = BLI_kdtree_3d_new(points_len);
+  for (int i = 0; i < points_balanced_len; i++) {
+    BLI_kdtree_3d_insert(tree, i, points[i].data());
+  }
+  BLI_kdtree_3d_balance(tree);
+
+  /* Points are found right after inserting, whether they are balanced or not. */
+  for (int i = points_balanced_len; i < points_len; i++) {
+    BLI_kdtree_3d_insert(tree, i, points[i].data());
+
+    KDTreeNearest_3d nearest;
+    EXPECT_NE(BLI_kdtree_3d_find_nearest(tree, points[i].data(), &nearest), -1);
+    EXPECT_EQ(nearest.dist, 0.0f);
+
+    if (i % 100 == 0) {
+      for (const std::array<float, 3> &co : queries) {
+        KDTreeNearest_3d *nearest_range = nullptr;
+        const int found = BLI_kdtree_3d_range_search(tree, co.data(), &nearest_range, 0.2f);
+        EXPECT_EQ(found, range_count_brute_force(points, i + 1, co.data(), 0.2f));
+        MEM_SAFE_FREE(nearest_range);
+
+        KDTreeNearest_3d nearest_n[4];
+        EXPECT_EQ(BLI_kdtree_3d_find_nearest_n(tree, co.data(), nearest_n, 4), 4);
+        EXPECT_FLOAT_EQ(nearest_n[0].dist, nearest_dist_brute_force(points, i + 1, co.data()));
+      }
+    }
+  }
+  BLI_kdtree_3d_free(tree);
+}
+
+static bool range_count_cb(void *user_data,
+                           uint co_index,
+                           int UNUSED(index),
+                           const float UNUSED(co[3]),
+                           float UNUSED(dist_sq))
+{
+  int *counts = (int *)user_data;
+  counts[co_index]++;
+  return true;
+}
+
+TEST(kdtree, Batch)
+{
+  const int points_len = 5000;
+  const int queries_len = 2000;
+  std::vector<std::array<float, 3>> points = random_points(points_len, 1);
+  std::vector<std::array<float, 3>> queries = random_points(queries_len, 2);
+
+  KDTree_3d *tree = BLI_kdtree_3d_new(points_len);
+  for (int i = 0; i < points_len; i++) {
+    BLI_kdtree_3d_insert(tree, i, points[i].data());
+  }
+  BLI_kdtree_3d_balance(tree);
+
+  const float(*queries_co)[3] = (const float(*)[3])queries.data();
+
+  std::vector<KDTreeNearest_3d> nearest(queries_len);
+  BLI_kdtree_3d_find_nearest_batch(tree, queries_co, queries_len, nearest.data());
+
+  std::vector<int> counts(queries_len, 0);
+  BLI_kdtree_3d_range_search_batch_cb(
+      tree, queries_co, queries_len, 0.1f, range_count_cb, counts.data());
+
+  for (int i = 0; i < queries_len; i++) {
+    KDTreeNearest_3d nearest_single;
+    EXPECT_EQ(BLI_kdtree_3d_find_nearest(tree, queries_co[i], &nearest_single),
+              nearest[i].index);
+    EXPECT_EQ(nearest_single.dist, nearest[i].dist);
+    EXPECT_EQ(counts[i], range_count_brute_force(points, points_len, queries_co[i], 0.1f));
+  }
+  BLI_kdtree_3d_free(tree);
+}
+
+TEST(kdtree, DuplicatesFastLarge)
+{
+  /* Large enough to find the neighbors in parallel. */
+  const int points_len = 12000;
+  const float range = 0.06f;
+  std::vector<std::array<float, 3>> points = random_points(points_len, 3);
+
+  KDTree_3d *tree = BLI_kdtree_3d_new(points_len);
+  for (int i = 0; i < points_len; i++) {
+    BLI_kdtree_3d_insert(tree, i, points[i].data());
+  }
+  BLI_kdtree_3d_balance(tree);
+
+  std::vector<int> duplicates(points_len, -1);
+  const int found = BLI_kdtree_3d_calc_duplicates_fast(tree, range, true, duplicates.data());
+  BLI_kdtree_3d_free(tree);
+
+  /* Points are visited in index order, so the result can be reproduced with a brute force
+   * search. */
+  std::vector<int> duplicates_expected(points_len, -1);
+  int found_expected = 0;
+  for (int i = 0; i < points_len; i++) {
+    if (!ELEM(duplicates_expected[i], -1, i)) {
+      continue;
+    }
+    const int found_prev = found_expected;
+    for (int j = 0; j < points_len; j++) {
+      if (j != i && duplicates_expected[j] == -1 &&
+          len_squared_v3v3(points[i].data(), points[j].data()) <= range * range) {
+        duplicates_expected[j] = i;
+        found_expected++;
+      }
+    }
+    if (found_expected != found_prev) {
+      duplicates_expected[i] = i;
+    }
+  }
+
+  EXPECT_GT(found, 0);
+  EXPECT_EQ(found, found_expected);
+  EXPECT_EQ(duplicates, duplicates_expected);
+}
@@ -115,4 +115,21 @@ TEST(linear_allocator, ConstructArrayCopy)
   EXPECT_EQ(span2[2], 3);
 }
 
+TEST(linear_allocator, Reset)
+{
+  LinearAllocator<> allocator;
+
+  for (int i = 0; i < 100; i++) {
+    allocator.allocate(1000, 8);
+  }
+  allocator.reset();
+
+  /* The largest buffer is reused after resetting. */
+  void *ptr1 = allocator.allocate(1000, 8);
+  allocator.reset();
+  void *ptr2 = allocator.allocate(1000, 8);
+  EXPECT_EQ(ptr1, ptr2);
+  EXPECT_TRUE(is_aligned(ptr2, 8));
+}
+
 }  // namespace blender::tests
@@ -0,0 +1,61 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <thread>
+#include <vector>
+
+#include "BLI_mempool.h"
+
+TEST(mempool, LocalAllocFree)
+{
+  BLI_mempool *pool = BLI_mempool_create(sizeof(int), 0, 64, BLI_MEMPOOL_ALLOW_ITER);
+
+  const int threads_num = 4;
+  const int elems_num = 10000;
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < threads_num; i++) {
+    threads.emplace_back([pool, i]() {
+      BLI_mempool_local local;
+      BLI_mempool_local_init(pool, &local);
+      std::vector<int *> elems;
+      for (int j = 0; j < elems_num; j++) {
+        int *elem = (int *)BLI_mempool_local_alloc(&local);
+        *elem = i;
+        elems.push_back(elem);
+      }
+      /* Free every other element, so some chunks are shared between threads afterwards. */
+      for (int j = 0; j < elems_num; j += 2) {
+        BLI_mempool_local_free(&local, elems[j]);
+      }
+      BLI_mempool_local_finish(&local);
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(BLI_mempool_len(pool), threads_num * elems_num / 2);
+
+  int counts[threads_num] = {0};
+  BLI_mempool_iter iter;
+  BLI_mempool_iternew(pool, &iter);
+  int *elem;
+  while ((elem = (int *)BLI_mempool_iterstep(&iter))) {
+    ASSERT_TRUE(*elem >= 0 && *elem < threads_num);
+    counts[*elem]++;
+  }
+  for (int i = 0; i < threads_num; i++) {
+    EXPECT_EQ(counts[i], elems_num / 2);
+  }
+
+  /* The returned elements are reused by regular allocation. */
+  for (int j = 0; j < threads_num * elems_num / 2; j++) {
+    int *elem_new = (int *)BLI_mempool_alloc(pool);
+    *elem_new = -1;
+  }
+  EXPECT_EQ(BLI_mempool_len(pool), threads_num * elems_num);
+
+  BLI_mempool_destroy(pool);
+}
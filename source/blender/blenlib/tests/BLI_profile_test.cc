@@ -0,0 +1,101 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "BLI_profile.h"
+#include "BLI_timeit.hh"
+
+namespace blender::timeit::tests {
+
+static std::string write_trace()
+{
+  const std::string filepath = ::testing::TempDir() + "BLI_profile_test.json";
+  EXPECT_TRUE(BLI_profile_write_chrome_trace(filepath.c_str()));
+  std::ifstream file(filepath);
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  file.close();
+  std::remove(filepath.c_str());
+  return buffer.str();
+}
+
+static int count_occurrences(const std::string &str, const std::string &sub)
+{
+  int count = 0;
+  for (size_t pos = str.find(sub); pos != std::string::npos; pos = str.find(sub, pos + 1)) {
+    count++;
+  }
+  return count;
+}
+
+TEST(profile, DisabledRecordsNothing)
+{
+  BLI_profile_exit();
+  {
+    ScopedProfileZone zone("ignored_zone");
+  }
+  BLI_profile_counter("ignored_counter", 1);
+  const std::string trace = write_trace();
+  EXPECT_EQ(trace.find("ignored_"), std::string::npos);
+  BLI_profile_exit();
+}
+
+TEST(profile, NestedZonesAndCounters)
+{
+  BLI_profile_exit();
+  BLI_profile_enable(true);
+  {
+    ScopedProfileZone outer("outer_zone", "detail \"quoted\"");
+    for (int i = 0; i < 3; i++) {
+      SCOPED_PROFILE_ZONE("inner_zone");
+    }
+    BLI_profile_counter("test_counter", 42);
+  }
+  BLI_profile_enable(false);
+
+  const std::string trace = write_trace();
+  EXPECT_EQ(count_occurrences(trace, "\"name\":\"inner_zone\",\"ph\":\"X\""), 3);
+  EXPECT_EQ(count_occurrences(trace, "\"depth\":1"), 3);
+  EXPECT_EQ(count_occurrences(trace, "\"name\":\"outer_zone\",\"ph\":\"X\""), 1);
+  EXPECT_NE(trace.find("\"detail\":\"detail \\\"quoted\\\"\""), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"test_counter\",\"ph\":\"C\""), std::string::npos);
+  EXPECT_NE(trace.find("\"value\":42"), std::string::npos);
+
+  BLI_profile_clear();
+  EXPECT_EQ(write_trace().find("inner_zone"), std::string::npos);
+  BLI_profile_exit();
+}
+
+TEST(profile, Threads)
+{
+  BLI_profile_exit();
+  BLI_profile_enable(true);
+  {
+    SCOPED_PROFILE_ZONE("main_zone");
+  }
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([]() {
+      for (int j = 0; j < 100; j++) {
+        SCOPED_PROFILE_ZONE("thread_zone");
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  BLI_profile_enable(false);
+
+  const std::string trace = write_trace();
+  EXPECT_EQ(count_occurrences(trace, "\"name\":\"thread_name\""), 5);
+  EXPECT_EQ(count_occurrences(trace, "\"name\":\"thread_zone\""), 400);
+  EXPECT_EQ(count_occurrences(trace, "\"name\":\"main_zone\""), 1);
+  BLI_profile_exit();
+}
+
+}  // namespace blender::timeit::tests
@@ -1,6 +1,8 @@
 /* Apache License, Version 2.0 */
 
 #include "testing/testing.h"
+#include <algorithm>
+#include <atomic>
 #include <string.h>
 
 #include "atomic_ops.h"
@@ -12,6 +14,7 @@
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 
 #define NUM_ITEMS 10000
 
@@ -181,3 +184,45 @@ TEST(task, ListBaseIter)
   MEM_freeN(items_buffer);
   BLI_threadapi_exit();
 }
+
+/* *** C++ API. *** */
+
+TEST(task, ParallelReduce)
+{
+  BLI_threadapi_init();
+
+  int data[NUM_ITEMS];
+  for (int i = 0; i < NUM_ITEMS; i++) {
+    data[i] = (i * 7919) % NUM_ITEMS;
+  }
+
+  const int max = blender::threading::parallel_reduce(
+      blender::IndexRange(NUM_ITEMS),
+      100,
+      -1,
+      [&](blender::IndexRange range, const int &value) {
+        int result = value;
+        for (const int i : range) {
+          result = std::max(result, data[i]);
+        }
+        return result;
+      },
+      [](const int &a, const int &b) { return std::max(a, b); });
+  EXPECT_EQ(max, NUM_ITEMS - 1);
+
+  BLI_threadapi_exit();
+}
+
+TEST(task, ParallelInvoke)
+{
+  BLI_threadapi_init();
+
+  std::atomic<int> counter = 0;
+  blender::threading::parallel_invoke(
+      [&]() { counter++; },
+      [&]() { counter++; },
+      [&]() { blender::threading::isolate_task([&]() { counter++; }); });
+  EXPECT_EQ(counter, 3);
+
+  BLI_threadapi_exit();
+}
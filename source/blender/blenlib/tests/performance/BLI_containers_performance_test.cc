@@ -0,0 +1,147 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_index_mask.hh"
+#include "BLI_map.hh"
+#include "BLI_rand.hh"
+#include "BLI_set.hh"
+#include "BLI_timeit.hh"
+#include "BLI_vector.hh"
+#include "BLI_vector_set.hh"
+
+/* Number of times every benchmark is repeated, so that timings can be compared between runs. */
+#define NUM_RUNS 3
+
+namespace blender::tests {
+
+/* All benchmarks use the same fixed seed, so that every run processes the same data. */
+static Vector<int> get_random_ints(const int amount, const int factor)
+{
+  RandomNumberGenerator rng{0};
+  Vector<int> values;
+  values.reserve(amount);
+  for (int i = 0; i < amount; i++) {
+    values.append(rng.get_int32() * factor);
+  }
+  return values;
+}
+
+template<typename MapT> static void benchmark_map(const std::string &name, Span<int> values)
+{
+  MapT map;
+  {
+    SCOPED_THROUGHPUT_TIMER(name + " Add", values.size());
+    for (const int value : values) {
+      map.add(value, value);
+    }
+  }
+  int count = 0;
+  {
+    SCOPED_THROUGHPUT_TIMER(name + " Lookup", values.size());
+    for (const int value : values) {
+      count += map.lookup(value) == value;
+    }
+  }
+  {
+    SCOPED_THROUGHPUT_TIMER(name + " Remove", values.size());
+    for (const int value : values) {
+      count += map.remove(value);
+    }
+  }
+  /* Print the value to avoid the compiler optimizing the lookups away. */
+  std::cout << "Count: " << count << "\n";
+}
+
+template<typename SetT> static void benchmark_set(const std::string &name, Span<int> values)
+{
+  SetT set;
+  {
+    SCOPED_THROUGHPUT_TIMER(name + " Add", values.size());
+    for (const int value : values) {
+      set.add(value);
+    }
+  }
+  int count = 0;
+  {
+    SCOPED_THROUGHPUT_TIMER(name + " Contains", values.size());
+    for (const int value : values) {
+      count += set.contains(value);
+    }
+  }
+  std::cout << "Count: " << count << "\n";
+}
+
+TEST(containers_performance, Map)
+{
+  const Vector<int> values = get_random_ints(1000000, 1);
+  for (int i = 0; i < NUM_RUNS; i++) {
+    benchmark_map<Map<int, int>>("Map<int, int>", values);
+  }
+}
+
+TEST(containers_performance, Set)
+{
+  const Vector<int> values = get_random_ints(1000000, 1);
+  for (int i = 0; i < NUM_RUNS; i++) {
+    benchmark_set<Set<int>>("Set<int>", values);
+  }
+}
+
+TEST(containers_performance, VectorSet)
+{
+  const Vector<int> values = get_random_ints(1000000, 1);
+  for (int i = 0; i < NUM_RUNS; i++) {
+    benchmark_set<VectorSet<int>>("VectorSet<int>", values);
+  }
+}
+
+/* Values with many identical low bits, which is a bad case for hash tables with a simple hash. */
+TEST(containers_performance, MapClustered)
+{
+  const Vector<int> values = get_random_ints(1000000, 1 << 10);
+  for (int i = 0; i < NUM_RUNS; i++) {
+    benchmark_map<Map<int, int>>("Map<int, int> clustered", values);
+  }
+}
+
+static void benchmark_index_mask(const std::string &name, IndexMask mask)
+{
+  Array<float> data(mask.min_array_size(), 1.0f);
+  float sum = 0.0f;
+  {
+    SCOPED_THROUGHPUT_TIMER(name + " foreach_index", mask.size());
+    mask.foreach_index([&](const int64_t i) { sum += data[i]; });
+  }
+  {
+    SCOPED_THROUGHPUT_TIMER(name + " Iterate", mask.size());
+    for (const int64_t i : mask) {
+      data[i] *= 2.0f;
+    }
+  }
+  std::cout << "Sum: " << sum << "\n";
+}
+
+TEST(containers_performance, IndexMask)
+{
+  const int64_t size = 10000000;
+
+  /* Every other element, so that the mask is not a range. */
+  Vector<int64_t> sparse_indices;
+  {
+    SCOPED_THROUGHPUT_TIMER("IndexMask build sparse", size);
+    for (const int64_t i : IndexRange(size)) {
+      if (i % 2 == 0) {
+        sparse_indices.append(i);
+      }
+    }
+  }
+
+  for (int i = 0; i < NUM_RUNS; i++) {
+    benchmark_index_mask("IndexMask range", IndexRange(size));
+    benchmark_index_mask("IndexMask sparse", sparse_indices.as_span());
+  }
+}
+
+}  // namespace blender::tests
@@ -36,6 +36,7 @@ struct LinkNode;
 struct ListBase;
 struct Main;
 struct MemFile;
+struct PreviewImage;
 struct ReportList;
 struct Scene;
 struct UserDef;
@@ -88,13 +89,19 @@ struct BlendFileReadParams {
   int undo_direction : 2;
 };
 
-/* skip reading some data-block types (may want to skip screen data too). */
+/* skip reading some data-block types. */
 typedef enum eBLOReadSkip {
   BLO_READ_SKIP_NONE = 0,
   BLO_READ_SKIP_USERDEF = (1 << 0),
   BLO_READ_SKIP_DATA = (1 << 1),
   /** Do not attempt to re-use IDs from old bmain for unchanged ones in case of undo. */
   BLO_READ_SKIP_UNDO_OLD_MAIN = (1 << 2),
+  /**
+   * Do not read window-managers, work-spaces and screens, for loading without UI
+   * (#G_FILE_NO_UI) where they are replaced by the ones of the current session anyway.
+   * Only used for files which don't need them for versioning.
+   */
+  BLO_READ_SKIP_UI = (1 << 3),
 } eBLOReadSkip;
 #define BLO_READ_SKIP_ALL (BLO_READ_SKIP_USERDEF | BLO_READ_SKIP_DATA)
 
@@ -126,6 +133,9 @@ struct LinkNode *BLO_blendhandle_get_datablock_names(BlendHandle *bh,
                                                      int ofblocktype,
                                                      int *tot_names);
 struct LinkNode *BLO_blendhandle_get_previews(BlendHandle *bh, int ofblocktype, int *tot_prev);
+struct PreviewImage *BLO_blendhandle_get_preview_for_id(BlendHandle *bh,
+                                                        int ofblocktype,
+                                                        const char *name);
 struct LinkNode *BLO_blendhandle_get_linkable_groups(BlendHandle *bh);
 
 void BLO_blendhandle_close(BlendHandle *bh);
@@ -32,7 +32,9 @@ typedef struct {
   const char *buf;
   /** Size in bytes. */
   size_t size;
-  /** When true, this chunk doesn't own the memory, it's shared with a previous #MemFileChunk */
+  /** When true, this chunk is identical to the matching #MemFileChunk of the previous step.
+   * Buffers are reference counted and may also be shared with any other chunk of the same
+   * content, regardless of this flag. */
   bool is_identical;
   /** When true, this chunk is also identical to the one in the next step (used by undo code to
    * detect unchanged IDs).
@@ -46,6 +48,8 @@ typedef struct {
 typedef struct MemFile {
   ListBase chunks;
   size_t size;
+  /** Set while the chunk buffers are stored in a temporary file, see #BLO_memfile_spill. */
+  struct MemFileSpill *spill;
 } MemFile;
 
 typedef struct MemFileWriteData {
@@ -78,6 +82,8 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
 extern void BLO_memfile_free(MemFile *memfile);
 extern void BLO_memfile_merge(MemFile *first, MemFile *second);
 extern void BLO_memfile_clear_future(MemFile *memfile);
+extern bool BLO_memfile_spill(MemFile *memfile, const char *filepath);
+extern bool BLO_memfile_unspill(MemFile *memfile);
 
 /* utilities */
 extern struct Main *BLO_memfile_main_get(struct MemFile *memfile,
@@ -42,6 +42,7 @@
 
 #include "BKE_idtype.h"
 #include "BKE_main.h"
+#include "BKE_report.h"
 
 #include "BLO_blend_defs.h"
 #include "BLO_readfile.h"
@@ -159,6 +160,46 @@ LinkNode *BLO_blendhandle_get_datablock_names(BlendHandle *bh, int ofblocktype,
   return names;
 }
 
+/**
+ * Read the icon and image rects that follow the #PreviewImage data block \a bhead.
+ *
+ * \param prv_dst: The preview to store the rects in, a copy of \a prv_src.
+ * \return The last block that was read.
+ */
+static BHead *blo_blendhandle_read_preview_rects(FileData *fd,
+                                                 BHead *bhead,
+                                                 PreviewImage *prv_dst,
+                                                 const PreviewImage *prv_src)
+{
+  if (prv_src->rect[0] && prv_src->w[0] && prv_src->h[0]) {
+    bhead = blo_bhead_next(fd, bhead);
+    BLI_assert((prv_dst->w[0] * prv_dst->h[0] * sizeof(uint)) == bhead->len);
+    prv_dst->rect[0] = BLO_library_read_struct(fd, bhead, "PreviewImage Icon Rect");
+  }
+  else {
+    /* This should not be needed, but can happen in 'broken' .blend files,
+     * better handle this gracefully than crashing. */
+    BLI_assert(prv_src->rect[0] == NULL && prv_src->w[0] == 0 && prv_src->h[0] == 0);
+    prv_dst->rect[0] = NULL;
+    prv_dst->w[0] = prv_dst->h[0] = 0;
+  }
+
+  if (prv_src->rect[1] && prv_src->w[1] && prv_src->h[1]) {
+    bhead = blo_bhead_next(fd, bhead);
+    BLI_assert((prv_dst->w[1] * prv_dst->h[1] * sizeof(uint)) == bhead->len);
+    prv_dst->rect[1] = BLO_library_read_struct(fd, bhead, "PreviewImage Image Rect");
+  }
+  else {
+    /* This should not be needed, but can happen in 'broken' .blend files,
+     * better handle this gracefully than crashing. */
+    BLI_assert(prv_src->rect[1] == NULL && prv_src->w[1] == 0 && prv_src->h[1] == 0);
+    prv_dst->rect[1] = NULL;
+    prv_dst->w[1] = prv_dst->h[1] = 0;
+  }
+
+  return bhead;
+}
+
 /**
  * Gets the previews of all the data-blocks in a file of a certain type
  * (e.g. all the scene previews in a file).
@@ -205,31 +246,7 @@ LinkNode *BLO_blendhandle_get_previews(BlendHandle *bh, int ofblocktype, int *to
           prv = BLO_library_read_struct(fd, bhead, "PreviewImage");
           if (prv) {
             memcpy(new_prv, prv, sizeof(PreviewImage));
-            if (prv->rect[0] && prv->w[0] && prv->h[0]) {
-              bhead = blo_bhead_next(fd, bhead);
-              BLI_assert((new_prv->w[0] * new_prv->h[0] * sizeof(uint)) == bhead->len);
-              new_prv->rect[0] = BLO_library_read_struct(fd, bhead, "PreviewImage Icon Rect");
-            }
-            else {
-              /* This should not be needed, but can happen in 'broken' .blend files,
-               * better handle this gracefully than crashing. */
-              BLI_assert(prv->rect[0] == NULL && prv->w[0] == 0 && prv->h[0] == 0);
-              new_prv->rect[0] = NULL;
-              new_prv->w[0] = new_prv->h[0] = 0;
-            }
-
-            if (prv->rect[1] && prv->w[1] && prv->h[1]) {
-              bhead = blo_bhead_next(fd, bhead);
-              BLI_assert((new_prv->w[1] * new_prv->h[1] * sizeof(uint)) == bhead->len);
-              new_prv->rect[1] = BLO_library_read_struct(fd, bhead, "PreviewImage Image Rect");
-            }
-            else {
-              /* This should not be needed, but can happen in 'broken' .blend files,
-               * better handle this gracefully than crashing. */
-              BLI_assert(prv->rect[1] == NULL && prv->w[1] == 0 && prv->h[1] == 0);
-              new_prv->rect[1] = NULL;
-              new_prv->w[1] = new_prv->h[1] = 0;
-            }
+            bhead = blo_blendhandle_read_preview_rects(fd, bhead, new_prv, prv);
             MEM_freeN(prv);
           }
         }
@@ -249,6 +266,51 @@ LinkNode *BLO_blendhandle_get_previews(BlendHandle *bh, int ofblocktype, int *to
   return previews;
 }
 
+/**
+ * Gets the preview of a single data-block, without reading the previews of the other data-blocks
+ * of that type.
+ *
+ * \param bh: The blendhandle to access.
+ * \param ofblocktype: The type of the data-block.
+ * \param name: The name of the data-block, without its ID code prefix.
+ * \return The PreviewImage or NULL when the data-block has none,
+ * free with #BKE_previewimg_freefunc().
+ */
+PreviewImage *BLO_blendhandle_get_preview_for_id(BlendHandle *bh,
+                                                 int ofblocktype,
+                                                 const char *name)
+{
+  FileData *fd = (FileData *)bh;
+  const int sdna_preview_image = DNA_struct_find_nr(fd->filesdna, "PreviewImage");
+  bool looking = false;
+
+  for (BHead *bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
+    if (bhead->code == DATA) {
+      if (looking && bhead->SDNAnr == sdna_preview_image) {
+        PreviewImage *prv = BLO_library_read_struct(fd, bhead, "PreviewImage");
+        if (prv == NULL) {
+          return NULL;
+        }
+
+        PreviewImage *new_prv = MEM_dupallocN(prv);
+        blo_blendhandle_read_preview_rects(fd, bhead, new_prv, prv);
+        MEM_freeN(prv);
+        return new_prv;
+      }
+    }
+    else if (looking || bhead->code == ENDB) {
+      /* The data-block was found, but it has no preview. */
+      break;
+    }
+    else if (bhead->code == ofblocktype) {
+      const char *idname = blo_bhead_id_name(fd, bhead);
+      looking = STREQ(idname + 2, name);
+    }
+  }
+
+  return NULL;
+}
+
 /**
  * Gets the names of all the linkable data-block types available in a file.
  * (e.g. "Scene", "Mesh", "Light", etc.).
@@ -369,6 +431,12 @@ BlendFileData *BLO_read_from_memfile(Main *oldmain,
   FileData *fd;
   ListBase old_mainlist;
 
+  /* Old undo steps may have been moved out of memory. */
+  if (!BLO_memfile_unspill(memfile)) {
+    BKE_report(reports, RPT_ERROR, "Unable to read spilled undo step from disk");
+    return NULL;
+  }
+
   fd = blo_filedata_from_memfile(memfile, params, reports);
   if (fd) {
     fd->reports = reports;
@@ -33,7 +33,8 @@
 
 #include "BLI_utildefines.h"
 #ifndef WIN32
-#  include <unistd.h> /* for read close */
+#  include <sys/mman.h> /* for mmap munmap */
+#  include <unistd.h>   /* for read close */
 #else
 #  include "BLI_winstuff.h"
 #  include "winsock2.h"
@@ -58,6 +59,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "CLG_log.h"
+
 #include "BLI_blenlib.h"
 #include "BLI_endian_switch.h"
 #include "BLI_ghash.h"
@@ -65,6 +68,7 @@
 #include "BLI_math.h"
 #include "BLI_memarena.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BLT_translation.h"
@@ -103,6 +107,8 @@
 
 #include "SEQ_sequencer.h"
 
+#include "PIL_time.h"
+
 #include "readfile.h"
 
 #include <errno.h>
@@ -169,6 +175,18 @@
  */
 #define USE_BHEAD_READ_ON_DEMAND
 
+/**
+ * Memory map uncompressed files instead of reading them, so that scanning block headers does not
+ * need a system call per block and only the pages of blocks which are actually read are loaded.
+ * Combined with #USE_BHEAD_READ_ON_DEMAND this avoids reading the data of blocks which are not
+ * used at all, e.g. when linking few data-blocks from a large library.
+ *
+ * \note Not used on MS-Windows, where memory mapping can not be used from multiple threads.
+ */
+#if !defined(WIN32) && defined(__LP64__)
+#  define USE_BHEAD_MMAP
+#endif
+
 /* use GHash for BHead name-based lookups (speeds up linking) */
 #define USE_GHASH_BHEAD
 
@@ -184,6 +202,8 @@
 #  define DEBUG_PRINTF(...)
 #endif
 
+static CLG_LogRef LOG = {"blo.readfile"};
+
 /* local prototypes */
 static void read_libraries(FileData *basefd, ListBase *mainlist);
 static void *read_struct(FileData *fd, BHead *bh, const char *blockname);
@@ -1161,6 +1181,29 @@ static ssize_t fd_read_from_memory(FileData *filedata,
   return readsize;
 }
 
+static off64_t fd_seek_from_memory(FileData *filedata, off64_t offset, int whence)
+{
+  off64_t new_offset;
+  switch (whence) {
+    case SEEK_SET:
+      new_offset = offset;
+      break;
+    case SEEK_CUR:
+      new_offset = filedata->file_offset + offset;
+      break;
+    case SEEK_END:
+      new_offset = (off64_t)filedata->buffersize + offset;
+      break;
+    default:
+      return -1;
+  }
+  if (new_offset < 0 || new_offset > (off64_t)filedata->buffersize) {
+    return -1;
+  }
+  filedata->file_offset = new_offset;
+  return new_offset;
+}
+
 /* MemFile reading. */
 
 static ssize_t fd_read_from_memfile(FileData *filedata,
@@ -1306,10 +1349,25 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
 
   BLI_lseek(file, 0, SEEK_SET);
 
+  const char *mmap_buffer = NULL;
+  size_t mmap_size = 0;
+
   /* Regular file. */
   if (memcmp(header, "BLENDER", sizeof(header)) == 0) {
     read_fn = fd_read_data_from_file;
     seek_fn = fd_seek_data_from_file;
+
+#ifdef USE_BHEAD_MMAP
+    mmap_size = BLI_file_descriptor_size(file);
+    if (mmap_size != (size_t)-1 && mmap_size > 0) {
+      void *mem = mmap(NULL, mmap_size, PROT_READ, MAP_PRIVATE, file, 0);
+      if (mem != MAP_FAILED) {
+        mmap_buffer = mem;
+        read_fn = fd_read_from_memory;
+        seek_fn = fd_seek_from_memory;
+      }
+    }
+#endif
   }
 
   /* Gzip file. */
@@ -1343,6 +1401,12 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
   fd->filedes = file;
   fd->gzfiledes = gzfile;
 
+  if (mmap_buffer != NULL) {
+    fd->buffer = mmap_buffer;
+    fd->buffersize = mmap_size;
+    fd->flags |= FD_FLAGS_IS_MMAP;
+  }
+
   fd->read = read_fn;
   fd->seek = seek_fn;
 
@@ -1409,20 +1473,27 @@ static ssize_t fd_read_gzip_from_memory(FileData *filedata,
   filedata->strm.next_out = (Bytef *)buffer;
   filedata->strm.avail_out = (uint)size;
 
-  /* Inflate another chunk. */
-  err = inflate(&filedata->strm, Z_SYNC_FLUSH);
+  while (filedata->strm.avail_out != 0) {
+    /* Inflate another chunk. */
+    err = inflate(&filedata->strm, Z_SYNC_FLUSH);
 
-  if (err == Z_STREAM_END) {
-    return 0;
-  }
-  if (err != Z_OK) {
-    printf("fd_read_gzip_from_memory: zlib error\n");
-    return 0;
+    if (err == Z_STREAM_END) {
+      /* Compressed files can consist of multiple gzip members, continue with the next one. */
+      if (filedata->strm.avail_in == 0 || inflateReset(&filedata->strm) != Z_OK) {
+        break;
+      }
+      continue;
+    }
+    if (err != Z_OK) {
+      printf("fd_read_gzip_from_memory: zlib error\n");
+      return 0;
+    }
   }
 
-  filedata->file_offset += size;
+  const size_t readsize = size - filedata->strm.avail_out;
+  filedata->file_offset += readsize;
 
-  return (ssize_t)size;
+  return (ssize_t)readsize;
 }
 
 static int fd_read_gzip_from_memory_init(FileData *fd)
@@ -1508,6 +1579,12 @@ void blo_filedata_free(FileData *fd)
       }
     }
 
+#ifdef USE_BHEAD_MMAP
+    if (fd->flags & FD_FLAGS_IS_MMAP) {
+      munmap((void *)fd->buffer, fd->buffersize);
+      fd->buffer = NULL;
+    }
+#endif
     if (fd->buffer && !(fd->flags & FD_FLAGS_NOT_MY_BUFFER)) {
       MEM_freeN((void *)fd->buffer);
       fd->buffer = NULL;
@@ -2068,6 +2145,70 @@ static void switch_endian_structs(const struct SDNA *filesdna, BHead *bhead)
   }
 }
 
+/* Number of structs converted by a single task when reconstructing big arrays. */
+#define READ_STRUCT_RECONSTRUCT_CHUNK_SIZE 4096
+
+typedef struct ReadStructReconstructData {
+  const struct DNA_ReconstructInfo *reconstruct_info;
+  int old_struct_nr, new_struct_nr;
+  int old_block_size, new_block_size;
+  int blocks;
+  const char *old_blocks;
+  char *new_blocks;
+} ReadStructReconstructData;
+
+static void read_struct_reconstruct_cb(void *__restrict userdata,
+                                       const int chunk,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ReadStructReconstructData *data = userdata;
+  const int block_start = chunk * READ_STRUCT_RECONSTRUCT_CHUNK_SIZE;
+  const int blocks = min_ii(READ_STRUCT_RECONSTRUCT_CHUNK_SIZE, data->blocks - block_start);
+
+  DNA_struct_reconstruct_blocks(data->reconstruct_info,
+                                data->old_struct_nr,
+                                data->new_struct_nr,
+                                blocks,
+                                data->old_blocks + (size_t)block_start * data->old_block_size,
+                                data->new_blocks + (size_t)block_start * data->new_block_size);
+}
+
+/* Convert the data of \a bh to the current SDNA, big arrays (vertices, loops, key-frames...) are
+ * converted in parallel. */
+static void *read_struct_reconstruct(FileData *fd, BHead *bh)
+{
+  if (bh->nr < 2 * READ_STRUCT_RECONSTRUCT_CHUNK_SIZE) {
+    return DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1));
+  }
+
+  const SDNA_Struct *old_struct = fd->filesdna->structs[bh->SDNAnr];
+  const int new_struct_nr = DNA_struct_find_nr(fd->memsdna, fd->filesdna->types[old_struct->type]);
+  if (new_struct_nr == -1) {
+    return NULL;
+  }
+  const SDNA_Struct *new_struct = fd->memsdna->structs[new_struct_nr];
+
+  ReadStructReconstructData data = {
+      .reconstruct_info = fd->reconstruct_info,
+      .old_struct_nr = bh->SDNAnr,
+      .new_struct_nr = new_struct_nr,
+      .old_block_size = fd->filesdna->types_size[old_struct->type],
+      .new_block_size = fd->memsdna->types_size[new_struct->type],
+      .blocks = bh->nr,
+      .old_blocks = (const char *)(bh + 1),
+  };
+  data.new_blocks = MEM_callocN((size_t)data.blocks * (size_t)data.new_block_size, "reconstruct");
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  const int chunks = (data.blocks + READ_STRUCT_RECONSTRUCT_CHUNK_SIZE - 1) /
+                     READ_STRUCT_RECONSTRUCT_CHUNK_SIZE;
+  BLI_task_parallel_range(0, chunks, &data, read_struct_reconstruct_cb, &settings);
+
+  return data.new_blocks;
+}
+
 static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
 {
   void *temp = NULL;
@@ -2102,7 +2243,7 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
           }
         }
 #endif
-        temp = DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1));
+        temp = read_struct_reconstruct(fd, bh);
       }
       else {
         /* SDNA_CMP_EQUAL */
@@ -3936,6 +4077,25 @@ static BHead *read_userdef(BlendFileData *bfd, FileData *fd, BHead *bhead)
 /** \name Read File (Internal)
  * \{ */
 
+/* Log the time spent in a step of #blo_read_file_internal,
+ * returns the start time of the next step. */
+static double read_file_step_time_log(const char *step_name, const double time_start)
+{
+  const double time_end = PIL_check_seconds_timer();
+  CLOG_INFO(&LOG, 1, "%s: %.2f ms", step_name, (time_end - time_start) * 1000.0);
+  return time_end;
+}
+
+/* Versioning of 2.80 and older files uses their screens (e.g. to create work-spaces and pick
+ * the active view layer), so these are always read. */
+static bool read_file_skip_ui_block(const FileData *fd, const BHead *bhead)
+{
+  if ((fd->skip_flags & BLO_READ_SKIP_UI) == 0 || fd->memfile != NULL || fd->fileversion <= 280) {
+    return false;
+  }
+  return ELEM(bhead->code, ID_WM, ID_WS, ID_SCR);
+}
+
 BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
 {
   BHead *bhead = blo_bhead_first(fd);
@@ -3946,6 +4106,9 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     DEBUG_PRINTF("\nUNDO: read step\n");
   }
 
+  const double time_read_start = PIL_check_seconds_timer();
+  double time_step = time_read_start;
+
   bfd = MEM_callocN(sizeof(BlendFileData), "blendfiledata");
 
   bfd->main = BKE_main_new();
@@ -4023,7 +4186,7 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
         /* pass on to default */
         ATTR_FALLTHROUGH;
       default:
-        if (fd->skip_flags & BLO_READ_SKIP_DATA) {
+        if ((fd->skip_flags & BLO_READ_SKIP_DATA) || read_file_skip_ui_block(fd, bhead)) {
           bhead = blo_bhead_next(fd, bhead);
         }
         else {
@@ -4032,6 +4195,8 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     }
   }
 
+  time_step = read_file_step_time_log("read data-blocks", time_step);
+
   /* do before read_libraries, but skip undo case */
   if (fd->memfile == NULL) {
     if ((fd->skip_flags & BLO_READ_SKIP_DATA) == 0) {
@@ -4041,6 +4206,8 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     if ((fd->skip_flags & BLO_READ_SKIP_USERDEF) == 0) {
       do_versions_userdef(fd, bfd);
     }
+
+    time_step = read_file_step_time_log("versioning", time_step);
   }
 
   if ((fd->skip_flags & BLO_READ_SKIP_DATA) == 0) {
@@ -4048,8 +4215,12 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
 
     blo_join_main(&mainlist);
 
+    time_step = read_file_step_time_log("read libraries", time_step);
+
     lib_link_all(fd, bfd->main);
 
+    time_step = read_file_step_time_log("link data-blocks", time_step);
+
     /* Skip in undo case. */
     if (fd->memfile == NULL) {
       /* Note that we can't recompute user-counts at this point in undo case, we play too much with
@@ -4076,6 +4247,8 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
 
       /* After all data has been read and versioned, uses LIB_TAG_NEW. */
       ntreeUpdateAllNew(bfd->main);
+
+      time_step = read_file_step_time_log("versioning after linking", time_step);
     }
 
     placeholders_ensure_valid(bfd->main);
@@ -4095,8 +4268,16 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     fix_relpaths_library(fd->relabase, bfd->main);
 
     link_global(fd, bfd); /* as last */
+
+    read_file_step_time_log("overrides and finalize", time_step);
   }
 
+  CLOG_INFO(&LOG,
+            1,
+            "read '%s' in %.2f ms",
+            filepath,
+            (PIL_check_seconds_timer() - time_read_start) * 1000.0);
+
   fd->mainlist = NULL; /* Safety, this is local variable, shall not be used afterward. */
 
   return bfd;
@@ -55,6 +55,8 @@ enum eFileDataFlag {
   FD_FLAGS_NOT_MY_BUFFER = 1 << 4,
   /* XXX Unused in practice (checked once but never set). */
   FD_FLAGS_NOT_MY_LIBMAP = 1 << 5,
+  /** #FileData.buffer is a memory mapping of the file, to be unmapped on free. */
+  FD_FLAGS_IS_MMAP = 1 << 6,
 };
 
 /* Disallow since it's 32bit on ms-windows. */
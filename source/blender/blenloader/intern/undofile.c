@@ -41,7 +41,9 @@
 #include "DNA_listBase.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_compress.h"
 #include "BLI_ghash.h"
+#include "BLI_hash_mm2a.h"
 
 #include "BLO_readfile.h"
 #include "BLO_undofile.h"
@@ -54,17 +56,278 @@
 
 /* **************** support for memory-write, for undo buffers *************** */
 
+/* -------------------------------------------------------------------- */
+/** \name Chunk Buffers
+ *
+ * Buffers of chunks are shared by all memfiles and identified by their content, so data which is
+ * identical to any existing chunk of the whole undo stack (not only the matching chunk of the
+ * previous step) is stored only once. Buffers are reference counted by the chunks using them.
+ *
+ * \note Only used from the main thread, like the undo system itself.
+ * \{ */
+
+typedef struct MemFileChunkBuffer {
+  /** Data of the buffer, allocated right after this struct. */
+  const char *data;
+  size_t size;
+  uint hash;
+  /** Number of chunks using the buffer, in all memfiles. */
+  uint users;
+} MemFileChunkBuffer;
+
+/** Set of all #MemFileChunkBuffer, freed when the last one is released. */
+static GSet *memfile_chunk_buffers = NULL;
+
+static uint memfile_chunk_buffer_hash(const void *key)
+{
+  const MemFileChunkBuffer *buffer = key;
+  return buffer->hash;
+}
+
+static bool memfile_chunk_buffer_cmp(const void *a, const void *b)
+{
+  const MemFileChunkBuffer *buffer_a = a;
+  const MemFileChunkBuffer *buffer_b = b;
+  return !((buffer_a->hash == buffer_b->hash) && (buffer_a->size == buffer_b->size) &&
+           (memcmp(buffer_a->data, buffer_b->data, buffer_a->size) == 0));
+}
+
+static MemFileChunkBuffer *memfile_chunk_buffer_from_data(const char *buf)
+{
+  return ((MemFileChunkBuffer *)buf) - 1;
+}
+
+/**
+ * Return a buffer with a copy of given data, re-using an existing one with the same content.
+ *
+ * \param r_is_new: Set to true when a new buffer was allocated.
+ */
+static const char *memfile_chunk_buffer_ensure(const char *buf, size_t size, bool *r_is_new)
+{
+  if (memfile_chunk_buffers == NULL) {
+    memfile_chunk_buffers = BLI_gset_new(
+        memfile_chunk_buffer_hash, memfile_chunk_buffer_cmp, __func__);
+  }
+
+  MemFileChunkBuffer key = {
+      .data = buf,
+      .size = size,
+      .hash = BLI_hash_mm2((const unsigned char *)buf, size, 0),
+  };
+  MemFileChunkBuffer *buffer = BLI_gset_lookup(memfile_chunk_buffers, &key);
+  if (buffer != NULL) {
+    buffer->users++;
+    *r_is_new = false;
+    return buffer->data;
+  }
+
+  buffer = MEM_mallocN(sizeof(*buffer) + size, "Chunk buffer");
+  char *data = (char *)(buffer + 1);
+  memcpy(data, buf, size);
+  buffer->data = data;
+  buffer->size = size;
+  buffer->hash = key.hash;
+  buffer->users = 1;
+  BLI_gset_insert(memfile_chunk_buffers, buffer);
+  *r_is_new = true;
+  return data;
+}
+
+static void memfile_chunk_buffer_add_user(const char *buf)
+{
+  memfile_chunk_buffer_from_data(buf)->users++;
+}
+
+static void memfile_chunk_buffer_release(const char *buf)
+{
+  MemFileChunkBuffer *buffer = memfile_chunk_buffer_from_data(buf);
+  BLI_assert(buffer->users > 0);
+  if (--buffer->users != 0) {
+    return;
+  }
+
+  BLI_gset_remove(memfile_chunk_buffers, buffer, NULL);
+  MEM_freeN(buffer);
+
+  if (BLI_gset_len(memfile_chunk_buffers) == 0) {
+    BLI_gset_free(memfile_chunk_buffers, NULL);
+    memfile_chunk_buffers = NULL;
+  }
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Spilling to Disk
+ *
+ * Chunks of old undo steps can be compressed into a temporary file and their buffers released,
+ * only the list of chunks (with their sizes and flags) is kept in memory. The buffers are loaded
+ * back before the memfile is read.
+ * \{ */
+
+typedef struct MemFileSpill {
+  char filepath[1024]; /* FILE_MAX */
+  /** Compressed size of every chunk, in the order of #MemFile.chunks. */
+  size_t *compressed_sizes;
+} MemFileSpill;
+
+/** Number of chunks compressed in parallel. */
+#define MEMFILE_SPILL_BATCH_SIZE 64
+
+static void memfile_spill_free(MemFile *memfile)
+{
+  MemFileSpill *spill = memfile->spill;
+  BLI_delete(spill->filepath, false, false);
+  MEM_freeN(spill->compressed_sizes);
+  MEM_freeN(spill);
+  memfile->spill = NULL;
+}
+
+/**
+ * Compress all chunks of the memfile into a file and release their buffers.
+ *
+ * \return false when writing failed, the memfile is then left untouched.
+ */
+bool BLO_memfile_spill(MemFile *memfile, const char *filepath)
+{
+  if (memfile->spill != NULL) {
+    return true;
+  }
+
+  FILE *file = BLI_fopen(filepath, "wb");
+  if (file == NULL) {
+    return false;
+  }
+
+  const int chunks_num = BLI_listbase_count(&memfile->chunks);
+  size_t *compressed_sizes = MEM_malloc_arrayN(
+      (size_t)MAX2(chunks_num, 1), sizeof(*compressed_sizes), __func__);
+  CompressBlock blocks[MEMFILE_SPILL_BATCH_SIZE];
+  int chunk_index = 0;
+  bool ok = true;
+
+  MemFileChunk *chunk = memfile->chunks.first;
+  while (ok && chunk != NULL) {
+    int blocks_num = 0;
+    for (; chunk != NULL && blocks_num < MEMFILE_SPILL_BATCH_SIZE; chunk = chunk->next) {
+      blocks[blocks_num].data = chunk->buf;
+      blocks[blocks_num].data_len = chunk->size;
+      blocks_num++;
+    }
+
+    ok = BLI_compress_blocks(blocks, blocks_num, 1);
+    for (int i = 0; i < blocks_num; i++) {
+      if (ok && fwrite(blocks[i].compressed, 1, blocks[i].compressed_len, file) !=
+                    blocks[i].compressed_len) {
+        ok = false;
+      }
+      compressed_sizes[chunk_index++] = blocks[i].compressed_len;
+      MEM_SAFE_FREE(blocks[i].compressed);
+    }
+  }
+
+  if (fclose(file) != 0) {
+    ok = false;
+  }
+
+  if (!ok) {
+    BLI_delete(filepath, false, false);
+    MEM_freeN(compressed_sizes);
+    return false;
+  }
+
+  LISTBASE_FOREACH (MemFileChunk *, chunk_iter, &memfile->chunks) {
+    memfile_chunk_buffer_release(chunk_iter->buf);
+    chunk_iter->buf = NULL;
+  }
+
+  MemFileSpill *spill = MEM_callocN(sizeof(*spill), __func__);
+  BLI_strncpy(spill->filepath, filepath, sizeof(spill->filepath));
+  spill->compressed_sizes = compressed_sizes;
+  memfile->spill = spill;
+  return true;
+}
+
+/**
+ * Load back the chunk buffers of a memfile spilled with #BLO_memfile_spill.
+ *
+ * \return false when reading failed, the memfile then stays spilled.
+ */
+bool BLO_memfile_unspill(MemFile *memfile)
+{
+  MemFileSpill *spill = memfile->spill;
+  if (spill == NULL) {
+    return true;
+  }
+
+  FILE *file = BLI_fopen(spill->filepath, "rb");
+  if (file == NULL) {
+    return false;
+  }
+
+  char *compressed = NULL, *data = NULL;
+  size_t compressed_alloc_len = 0, data_alloc_len = 0;
+  int chunk_index = 0;
+  bool ok = true;
+
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    const size_t compressed_len = spill->compressed_sizes[chunk_index++];
+    if (compressed_len > compressed_alloc_len) {
+      MEM_SAFE_FREE(compressed);
+      compressed = MEM_mallocN(compressed_len, __func__);
+      compressed_alloc_len = compressed_len;
+    }
+    if (chunk->size > data_alloc_len) {
+      MEM_SAFE_FREE(data);
+      data = MEM_mallocN(chunk->size, __func__);
+      data_alloc_len = chunk->size;
+    }
+
+    if (fread(compressed, 1, compressed_len, file) != compressed_len ||
+        BLI_decompress_mem(compressed, compressed_len, data, chunk->size) != chunk->size) {
+      ok = false;
+      break;
+    }
+
+    bool is_new;
+    chunk->buf = memfile_chunk_buffer_ensure(data, chunk->size, &is_new);
+  }
+
+  fclose(file);
+  MEM_SAFE_FREE(compressed);
+  MEM_SAFE_FREE(data);
+
+  if (!ok) {
+    LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+      if (chunk->buf != NULL) {
+        memfile_chunk_buffer_release(chunk->buf);
+        chunk->buf = NULL;
+      }
+    }
+    return false;
+  }
+
+  memfile_spill_free(memfile);
+  return true;
+}
+
+/** \} */
+
 /* not memfile itself */
 void BLO_memfile_free(MemFile *memfile)
 {
   MemFileChunk *chunk;
 
   while ((chunk = BLI_pophead(&memfile->chunks))) {
-    if (chunk->is_identical == false) {
-      MEM_freeN((void *)chunk->buf);
+    /* Buffers of spilled memfiles are already released. */
+    if (chunk->buf != NULL) {
+      memfile_chunk_buffer_release(chunk->buf);
     }
     MEM_freeN(chunk);
   }
+  if (memfile->spill != NULL) {
+    memfile_spill_free(memfile);
+  }
   memfile->size = 0;
 }
 
@@ -72,35 +335,33 @@ void BLO_memfile_free(MemFile *memfile)
 /* result is that 'first' is being freed */
 void BLO_memfile_merge(MemFile *first, MemFile *second)
 {
-  /* We use this mapping to store the memory buffers from second memfile chunks which are not owned
-   * by it (i.e. shared with some previous memory steps). */
-  GHash *buffer_to_second_memchunk = BLI_ghash_new(
-      BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, __func__);
-
-  /* First, detect all memchunks in second memfile that are not owned by it. */
-  for (MemFileChunk *sc = second->chunks.first; sc != NULL; sc = sc->next) {
-    if (sc->is_identical) {
-      BLI_ghash_insert(buffer_to_second_memchunk, (void *)sc->buf, sc);
+  /* Buffers are reference counted, so no ownership needs to be transferred. However chunks of the
+   * second memfile which were identical to changed chunks of the first one are not identical to
+   * the step preceding the first memfile. */
+  if (first->spill != NULL || second->spill != NULL) {
+    /* Buffers are not available to match chunks, consider everything changed. */
+    LISTBASE_FOREACH (MemFileChunk *, sc, &second->chunks) {
+      sc->is_identical = false;
     }
+    BLO_memfile_free(first);
+    return;
   }
 
-  /* Now, check all chunks from first memfile (the one we are removing), and if a memchunk owned by
-   * it is also used by the second memfile, transfer the ownership. */
+  GSet *first_changed_buffers = BLI_gset_ptr_new(__func__);
+
   for (MemFileChunk *fc = first->chunks.first; fc != NULL; fc = fc->next) {
     if (!fc->is_identical) {
-      MemFileChunk *sc = BLI_ghash_lookup(buffer_to_second_memchunk, fc->buf);
-      if (sc != NULL) {
-        BLI_assert(sc->is_identical);
-        sc->is_identical = false;
-        fc->is_identical = true;
-      }
-      /* Note that if the second memfile does not use that chunk, we assume that the first one
-       * fully owns it without sharing it with any other memfile, and hence it should be freed with
-       * it. */
+      BLI_gset_add(first_changed_buffers, (void *)fc->buf);
+    }
+  }
+
+  for (MemFileChunk *sc = second->chunks.first; sc != NULL; sc = sc->next) {
+    if (sc->is_identical && BLI_gset_haskey(first_changed_buffers, sc->buf)) {
+      sc->is_identical = false;
     }
   }
 
-  BLI_ghash_free(buffer_to_second_memchunk, NULL, NULL);
+  BLI_gset_free(first_changed_buffers, NULL);
 
   BLO_memfile_free(first);
 }
@@ -117,6 +378,11 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
                             MemFile *written_memfile,
                             MemFile *reference_memfile)
 {
+  /* A spilled memfile has no buffers to compare against. */
+  if (reference_memfile != NULL && reference_memfile->spill != NULL) {
+    reference_memfile = NULL;
+  }
+
   mem_data->written_memfile = written_memfile;
   mem_data->reference_memfile = reference_memfile;
   mem_data->reference_current_chunk = reference_memfile ? reference_memfile->chunks.first : NULL;
@@ -178,17 +444,19 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
         curchunk->buf = compchunk->buf;
         curchunk->is_identical = true;
         compchunk->is_identical_future = true;
+        memfile_chunk_buffer_add_user(curchunk->buf);
       }
     }
     *compchunk_step = compchunk->next;
   }
 
-  /* not equal... */
+  /* not equal to the previous step, but the same data may still be stored by another chunk... */
   if (curchunk->buf == NULL) {
-    char *buf_new = MEM_mallocN(size, "Chunk buffer");
-    memcpy(buf_new, buf, size);
-    curchunk->buf = buf_new;
-    memfile->size += size;
+    bool is_new;
+    curchunk->buf = memfile_chunk_buffer_ensure(buf, size, &is_new);
+    if (is_new) {
+      memfile->size += size;
+    }
   }
 }
 
@@ -225,6 +493,10 @@ bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
   MemFileChunk *chunk;
   int file, oflags;
 
+  if (!BLO_memfile_unspill(memfile)) {
+    return false;
+  }
+
   /* note: This is currently used for autosave and 'quit.blend',
    * where _not_ following symlinks is OK,
    * however if this is ever executed explicitly by the user,
@@ -99,7 +99,9 @@
 
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
+#include "BLI_compress.h"
 #include "BLI_mempool.h"
+#include "BLI_threads.h"
 #include "MEM_guardedalloc.h" /* MEM_freeN */
 
 #include "BKE_blender_version.h"
@@ -146,6 +148,7 @@
 typedef enum {
   WW_WRAP_NONE = 1,
   WW_WRAP_ZLIB,
+  WW_WRAP_ZLIB_PARALLEL,
 } eWriteWrapType;
 
 typedef struct WriteWrap WriteWrap;
@@ -162,6 +165,7 @@ struct WriteWrap {
   union {
     int file_handle;
     gzFile gz_handle;
+    struct WriteWrapZlibParallel *zlib_parallel;
   } _user_data;
 };
 
@@ -217,6 +221,115 @@ static size_t ww_write_zlib(WriteWrap *ww, const char *buf, size_t buf_len)
 }
 #undef FILE_HANDLE
 
+/* zlib, compressing blocks of the file in parallel.
+ *
+ * Each block is compressed into its own gzip member, the file is a concatenation of them which
+ * is still a valid gzip stream for readers. Blocks are collected into batches which are
+ * compressed by all threads and then written to the file in order. */
+
+typedef struct WriteWrapZlibParallel {
+  int file_handle;
+
+  CompressBlock *blocks;
+  /** Uncompressed data of the blocks, owned by the write wrap. */
+  uchar **blocks_data;
+  /** Number of blocks in the current batch, the last one is being filled. */
+  int blocks_num;
+  /** Number of blocks compressed in parallel. */
+  int blocks_max;
+
+  bool error;
+} WriteWrapZlibParallel;
+
+#define ZLIB_PARALLEL(ww) (ww)->_user_data.zlib_parallel
+
+static void ww_zlib_parallel_flush(WriteWrapZlibParallel *zp)
+{
+  if (zp->blocks_num == 0) {
+    return;
+  }
+
+  /* Same compression level as #ww_open_zlib. */
+  if (!BLI_compress_blocks(zp->blocks, zp->blocks_num, 1)) {
+    zp->error = true;
+  }
+
+  for (int i = 0; i < zp->blocks_num; i++) {
+    CompressBlock *block = &zp->blocks[i];
+    if (!zp->error) {
+      if (write(zp->file_handle, block->compressed, block->compressed_len) !=
+          block->compressed_len) {
+        zp->error = true;
+      }
+    }
+    MEM_SAFE_FREE(block->compressed);
+    block->data_len = 0;
+  }
+  zp->blocks_num = 0;
+}
+
+static bool ww_open_zlib_parallel(WriteWrap *ww, const char *filepath)
+{
+  int file = BLI_open(filepath, O_BINARY + O_WRONLY + O_CREAT + O_TRUNC, 0666);
+  if (file == -1) {
+    return false;
+  }
+
+  WriteWrapZlibParallel *zp = MEM_callocN(sizeof(*zp), __func__);
+  zp->file_handle = file;
+  zp->blocks_max = 2 * BLI_system_thread_count();
+  zp->blocks = MEM_calloc_arrayN(zp->blocks_max, sizeof(*zp->blocks), __func__);
+  zp->blocks_data = MEM_malloc_arrayN(zp->blocks_max, sizeof(*zp->blocks_data), __func__);
+  for (int i = 0; i < zp->blocks_max; i++) {
+    zp->blocks_data[i] = MEM_mallocN(BLI_COMPRESS_BLOCK_SIZE, __func__);
+    zp->blocks[i].data = zp->blocks_data[i];
+  }
+  ZLIB_PARALLEL(ww) = zp;
+  return true;
+}
+static bool ww_close_zlib_parallel(WriteWrap *ww)
+{
+  WriteWrapZlibParallel *zp = ZLIB_PARALLEL(ww);
+  if (zp->blocks_num != 0 && zp->blocks[zp->blocks_num - 1].data_len == 0) {
+    /* Last block did not receive any data. */
+    zp->blocks_num--;
+  }
+  ww_zlib_parallel_flush(zp);
+
+  const bool ok = !zp->error && (close(zp->file_handle) != -1);
+
+  for (int i = 0; i < zp->blocks_max; i++) {
+    MEM_freeN(zp->blocks_data[i]);
+  }
+  MEM_freeN(zp->blocks_data);
+  MEM_freeN(zp->blocks);
+  MEM_freeN(zp);
+  ZLIB_PARALLEL(ww) = NULL;
+  return ok;
+}
+static size_t ww_write_zlib_parallel(WriteWrap *ww, const char *buf, size_t buf_len)
+{
+  WriteWrapZlibParallel *zp = ZLIB_PARALLEL(ww);
+  const size_t len = buf_len;
+  while (buf_len > 0) {
+    if (zp->blocks_num == 0 ||
+        zp->blocks[zp->blocks_num - 1].data_len == BLI_COMPRESS_BLOCK_SIZE) {
+      if (zp->blocks_num == zp->blocks_max) {
+        ww_zlib_parallel_flush(zp);
+      }
+      zp->blocks_num++;
+    }
+    CompressBlock *block = &zp->blocks[zp->blocks_num - 1];
+    const size_t copy_len = MIN2(buf_len, BLI_COMPRESS_BLOCK_SIZE - block->data_len);
+    memcpy(zp->blocks_data[zp->blocks_num - 1] + block->data_len, buf, copy_len);
+    block->data_len += copy_len;
+    buf += copy_len;
+    buf_len -= copy_len;
+  }
+  return zp->error ? 0 : len;
+}
+#undef ZLIB_PARALLEL
+
 /* --- end compression types --- */
 
 static void ww_handle_init(eWriteWrapType ww_type, WriteWrap *r_ww)
@@ -231,6 +344,13 @@ static void ww_handle_init(eWriteWrapType ww_type, WriteWrap *r_ww)
       r_ww->use_buf = false;
       break;
     }
+    case WW_WRAP_ZLIB_PARALLEL: {
+      r_ww->open = ww_open_zlib_parallel;
+      r_ww->close = ww_close_zlib_parallel;
+      r_ww->write = ww_write_zlib_parallel;
+      r_ww->use_buf = false;
+      break;
+    }
     default: {
       r_ww->open = ww_open_none;
       r_ww->close = ww_close_none;
@@ -451,6 +571,9 @@ static bool mywrite_end(WriteData *wd)
 static void mywrite_id_begin(WriteData *wd, ID *id)
 {
   if (wd->use_memfile) {
+    /* Start the ID data in its own chunk, so chunks stay aligned to ID boundaries and can be
+     * de-duplicated by their content. */
+    mywrite_flush(wd);
     wd->mem.current_id_session_uuid = id->session_uuid;
 
     /* If current next memchunk does not match the ID we are about to write, try to find the
@@ -1144,7 +1267,7 @@ bool BLO_write_file(Main *mainvar,
   BLI_snprintf(tempname, sizeof(tempname), "%s@", filepath);
 
   if (write_flags & G_FILE_COMPRESS) {
-    ww_type = WW_WRAP_ZLIB;
+    ww_type = (BLI_system_thread_count() > 1) ? WW_WRAP_ZLIB_PARALLEL : WW_WRAP_ZLIB;
   }
   else {
     ww_type = WW_WRAP_NONE;
@@ -34,6 +34,10 @@
 #include "bmesh.h"
 #include "intern/bmesh_operators_private.h"
 
+#define ELE_DEL 1
+#define EDGE_COL 2
+#define VERT_IN_FACE 4
+
 static void remdoubles_splitface(BMFace *f, BMesh *bm, BMOperator *op, BMOpSlot *slot_targetmap)
 {
   BMIter liter;
@@ -41,6 +45,10 @@ static void remdoubles_splitface(BMFace *f, BMesh *bm, BMOperator *op, BMOpSlot
   bool split = false;
 
   BM_ITER_ELEM (l, &liter, f, BM_LOOPS_OF_FACE) {
+    /* Only doubles are tagged for deletion, avoid looking up every other vertex in the map. */
+    if (!BMO_vert_flag_test(bm, l->v, ELE_DEL)) {
+      continue;
+    }
     BMVert *v_tar = BMO_slot_map_elem_get(slot_targetmap, l->v);
     /* ok: if v_tar is NULL (e.g. not in the map) then it's
      *     a target vert, otherwise it's a double */
@@ -66,10 +74,6 @@ static void remdoubles_splitface(BMFace *f, BMesh *bm, BMOperator *op, BMOpSlot
   }
 }
 
-#define ELE_DEL 1
-#define EDGE_COL 2
-#define VERT_IN_FACE 4
-
 /**
  * helper function for bmo_weld_verts_exec so we can use stack memory
  */
@@ -191,6 +195,7 @@ finally : {
 void bmo_weld_verts_exec(BMesh *bm, BMOperator *op)
 {
   BMIter iter, liter;
+  BMOIter siter;
   BMVert *v;
   BMEdge *e;
   BMLoop *l;
@@ -206,9 +211,10 @@ void bmo_weld_verts_exec(BMesh *bm, BMOperator *op)
     targetmap_all = BLI_ghash_ptr_new(__func__);
   }
 
-  /* mark merge verts for deletion */
-  BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
-    BMVert *v_dst = BMO_slot_map_elem_get(slot_targetmap, v);
+  /* Mark merge verts for deletion, iterating over the map instead of all verts,
+   * the merged flags of the targets don't depend on the order. */
+  BMO_ITER (v, &siter, op->slots_in, "targetmap", 0) {
+    BMVert *v_dst = BMO_iter_map_value_ptr(&siter);
     if (v_dst != NULL) {
       BMO_vert_flag_enable(bm, v, ELE_DEL);
 
@@ -32,6 +32,7 @@
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
 #include "BLI_quadric.h"
+#include "BLI_task.h"
 #include "BLI_utildefines_stack.h"
 
 #include "BKE_customdata.h"
@@ -236,18 +237,21 @@ static float bm_decim_build_edge_cost_single__topology(BMEdge *e)
 
 #endif /* USE_TOPOLOGY_FALLBACK */
 
-static void bm_decim_build_edge_cost_single(BMEdge *e,
-                                            const Quadric *vquadrics,
-                                            const float *vweights,
-                                            const float vweight_factor,
-                                            Heap *eheap,
-                                            HeapNode **eheap_table)
+/**
+ * \return false when the edge can't be collapsed and must not be in the heap.
+ * Only reads the mesh, so it's safe to call from multiple threads.
+ */
+static bool bm_decim_calc_edge_cost(BMEdge *e,
+                                    const Quadric *vquadrics,
+                                    const float *vweights,
+                                    const float vweight_factor,
+                                    float *r_cost)
 {
   float cost;
 
   if (UNLIKELY(vweights && ((vweights[BM_elem_index_get(e->v1)] == 0.0f) ||
                             (vweights[BM_elem_index_get(e->v2)] == 0.0f)))) {
-    goto clear;
+    return false;
   }
 
   /* check we can collapse, some edges we better not touch */
@@ -257,7 +261,7 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
     else {
       /* only collapse tri's */
-      goto clear;
+      return false;
     }
   }
   else if (BM_edge_is_manifold(e)) {
@@ -266,11 +270,11 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
     else {
       /* only collapse tri's */
-      goto clear;
+      return false;
     }
   }
   else {
-    goto clear;
+    return false;
   }
   /* end sanity check */
 
@@ -323,10 +327,24 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
   }
 
-  BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
-  return;
+  *r_cost = cost;
+  return true;
+}
+
+static void bm_decim_build_edge_cost_single(BMEdge *e,
+                                            const Quadric *vquadrics,
+                                            const float *vweights,
+                                            const float vweight_factor,
+                                            Heap *eheap,
+                                            HeapNode **eheap_table)
+{
+  float cost;
+
+  if (bm_decim_calc_edge_cost(e, vquadrics, vweights, vweight_factor, &cost)) {
+    BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
+    return;
+  }
 
-clear:
   if (eheap_table[BM_elem_index_get(e)]) {
     BLI_heap_remove(eheap, eheap_table[BM_elem_index_get(e)]);
   }
@@ -341,6 +359,25 @@ static void bm_decim_invalid_edge_cost_single(BMEdge *e, Heap *eheap, HeapNode *
   eheap_table[BM_elem_index_get(e)] = BLI_heap_insert(eheap, COST_INVALID, e);
 }
 
+typedef struct BMDecimEdgeCostData {
+  const Quadric *vquadrics;
+  const float *vweights;
+  float vweight_factor;
+  /** Edge index aligned, #COST_INVALID for edges that can't be collapsed. */
+  float *ecosts;
+} BMDecimEdgeCostData;
+
+static void bm_decim_calc_edge_cost_cb(void *userdata, MempoolIterData *mp_e)
+{
+  BMDecimEdgeCostData *data = userdata;
+  BMEdge *e = (BMEdge *)mp_e;
+  float *cost = &data->ecosts[BM_elem_index_get(e)];
+
+  if (!bm_decim_calc_edge_cost(e, data->vquadrics, data->vweights, data->vweight_factor, cost)) {
+    *cost = COST_INVALID;
+  }
+}
+
 static void bm_decim_build_edge_cost(BMesh *bm,
                                      const Quadric *vquadrics,
                                      const float *vweights,
@@ -352,11 +389,25 @@ static void bm_decim_build_edge_cost(BMesh *bm,
   BMEdge *e;
   uint i;
 
+  /* Solving the quadrics is the expensive part, do it for all edges in parallel,
+   * then fill the heap in edge order so the result doesn't depend on threading. */
+  BM_mesh_elem_index_ensure(bm, BM_EDGE);
+
+  BMDecimEdgeCostData data = {
+      .vquadrics = vquadrics,
+      .vweights = vweights,
+      .vweight_factor = vweight_factor,
+      .ecosts = MEM_malloc_arrayN((size_t)bm->totedge, sizeof(float), __func__),
+  };
+  BM_iter_parallel(
+      bm, BM_EDGES_OF_MESH, bm_decim_calc_edge_cost_cb, &data, bm->totedge >= BM_OMP_LIMIT);
+
   BM_ITER_MESH_INDEX (e, &iter, bm, BM_EDGES_OF_MESH, i) {
-    /* keep sanity check happy */
-    eheap_table[i] = NULL;
-    bm_decim_build_edge_cost_single(e, vquadrics, vweights, vweight_factor, eheap, eheap_table);
+    const float cost = data.ecosts[i];
+    eheap_table[i] = (cost != COST_INVALID) ? BLI_heap_insert(eheap, cost, e) : NULL;
   }
+
+  MEM_freeN(data.ecosts);
 }
 
 #ifdef USE_SYMMETRY
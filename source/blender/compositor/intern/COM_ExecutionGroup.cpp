@@ -429,11 +429,14 @@ void ExecutionGroup::finalizeChunkExecution(int chunkNumber, MemoryBuffer **memo
     this->m_bTree->progress(this->m_bTree->prh, progress);
 
     char buf[128];
+    char memory_str[15];
+    BLI_str_format_byte_unit(memory_str, MemoryBuffer::get_used_memory(), false);
     BLI_snprintf(buf,
                  sizeof(buf),
-                 TIP_("Compositing | Tile %u-%u"),
+                 TIP_("Compositing | Tile %u-%u | Buffers %s"),
                  this->m_chunksFinished,
-                 this->m_numberOfChunks);
+                 this->m_numberOfChunks,
+                 memory_str);
     this->m_bTree->stats_draw(this->m_bTree->sdh, buf);
   }
 }
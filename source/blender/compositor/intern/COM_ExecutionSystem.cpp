@@ -197,6 +197,8 @@ void ExecutionSystem::execute()
     ExecutionGroup *executionGroup = this->m_groups[index];
     executionGroup->deinitExecution();
   }
+
+  MemoryBuffer::free_pool();
 }
 
 void ExecutionSystem::executeGroups(CompositorPriority priority)
@@ -16,13 +16,103 @@
  * Copyright 2011, Blender Foundation.
  */
 
+#include <map>
+#include <vector>
+
 #include "COM_MemoryBuffer.h"
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_threads.h"
+
 using std::max;
 using std::min;
 
+/* Freed buffers are kept in a pool grouped by power of two size classes, chunks of an execution
+ * group mostly have the same size so their buffers can be recycled instead of going through the
+ * allocator and faulting in new pages for every chunk. Full frame buffers are not pooled. */
+#define COM_BUFFER_POOL_MAX_BUFFER_SIZE (16 * 1024 * 1024)
+/* Maximum amount of memory kept in unused pooled buffers. */
+#define COM_BUFFER_POOL_SIZE (256 * 1024 * 1024)
+
+static ThreadMutex g_buffer_pool_lock = BLI_MUTEX_INITIALIZER;
+static std::map<size_t, std::vector<float *>> g_buffer_pool;
+static size_t g_buffer_pool_size = 0;
+static size_t g_buffer_used_size = 0;
+
+static size_t buffer_pool_size_class(size_t size)
+{
+  if (size > COM_BUFFER_POOL_MAX_BUFFER_SIZE) {
+    return size;
+  }
+  size_t size_class = 4096;
+  while (size_class < size) {
+    size_class <<= 1;
+  }
+  return size_class;
+}
+
+static float *buffer_pool_alloc(size_t size)
+{
+  const size_t size_class = buffer_pool_size_class(size);
+  float *buffer = nullptr;
+
+  BLI_mutex_lock(&g_buffer_pool_lock);
+  g_buffer_used_size += size_class;
+  std::vector<float *> &buffers = g_buffer_pool[size_class];
+  if (!buffers.empty()) {
+    buffer = buffers.back();
+    buffers.pop_back();
+    g_buffer_pool_size -= size_class;
+  }
+  BLI_mutex_unlock(&g_buffer_pool_lock);
+
+  if (buffer == nullptr) {
+    buffer = (float *)MEM_mallocN_aligned(size_class, 16, "COM_MemoryBuffer");
+  }
+  return buffer;
+}
+
+static void buffer_pool_free(float *buffer, size_t size)
+{
+  const size_t size_class = buffer_pool_size_class(size);
+
+  BLI_mutex_lock(&g_buffer_pool_lock);
+  g_buffer_used_size -= size_class;
+  if (size_class <= COM_BUFFER_POOL_MAX_BUFFER_SIZE &&
+      g_buffer_pool_size + size_class <= COM_BUFFER_POOL_SIZE) {
+    g_buffer_pool[size_class].push_back(buffer);
+    g_buffer_pool_size += size_class;
+    buffer = nullptr;
+  }
+  BLI_mutex_unlock(&g_buffer_pool_lock);
+
+  if (buffer) {
+    MEM_freeN(buffer);
+  }
+}
+
+void MemoryBuffer::free_pool()
+{
+  BLI_mutex_lock(&g_buffer_pool_lock);
+  for (std::pair<const size_t, std::vector<float *>> &item : g_buffer_pool) {
+    for (float *buffer : item.second) {
+      MEM_freeN(buffer);
+    }
+  }
+  g_buffer_pool.clear();
+  g_buffer_pool_size = 0;
+  BLI_mutex_unlock(&g_buffer_pool_lock);
+}
+
+size_t MemoryBuffer::get_used_memory()
+{
+  BLI_mutex_lock(&g_buffer_pool_lock);
+  const size_t used_size = g_buffer_used_size + g_buffer_pool_size;
+  BLI_mutex_unlock(&g_buffer_pool_lock);
+  return used_size;
+}
+
 static unsigned int determine_num_channels(DataType datatype)
 {
   switch (datatype) {
@@ -58,8 +148,8 @@ MemoryBuffer::MemoryBuffer(MemoryProxy *memoryProxy, unsigned int chunkNumber, r
   this->m_memoryProxy = memoryProxy;
   this->m_chunkNumber = chunkNumber;
   this->m_num_channels = determine_num_channels(memoryProxy->getDataType());
-  this->m_buffer = (float *)MEM_mallocN_aligned(
-      sizeof(float) * determineBufferSize() * this->m_num_channels, 16, "COM_MemoryBuffer");
+  this->m_buffer = buffer_pool_alloc(sizeof(float) * determineBufferSize() *
+                                     this->m_num_channels);
   this->m_state = COM_MB_ALLOCATED;
   this->m_datatype = memoryProxy->getDataType();
 }
@@ -72,8 +162,8 @@ MemoryBuffer::MemoryBuffer(MemoryProxy *memoryProxy, rcti *rect)
   this->m_memoryProxy = memoryProxy;
   this->m_chunkNumber = -1;
   this->m_num_channels = determine_num_channels(memoryProxy->getDataType());
-  this->m_buffer = (float *)MEM_mallocN_aligned(
-      sizeof(float) * determineBufferSize() * this->m_num_channels, 16, "COM_MemoryBuffer");
+  this->m_buffer = buffer_pool_alloc(sizeof(float) * determineBufferSize() *
+                                     this->m_num_channels);
   this->m_state = COM_MB_TEMPORARILY;
   this->m_datatype = memoryProxy->getDataType();
 }
@@ -86,8 +176,8 @@ MemoryBuffer::MemoryBuffer(DataType dataType, rcti *rect)
   this->m_memoryProxy = nullptr;
   this->m_chunkNumber = -1;
   this->m_num_channels = determine_num_channels(dataType);
-  this->m_buffer = (float *)MEM_mallocN_aligned(
-      sizeof(float) * determineBufferSize() * this->m_num_channels, 16, "COM_MemoryBuffer");
+  this->m_buffer = buffer_pool_alloc(sizeof(float) * determineBufferSize() *
+                                     this->m_num_channels);
   this->m_state = COM_MB_TEMPORARILY;
   this->m_datatype = dataType;
 }
@@ -144,7 +234,7 @@ float MemoryBuffer::getMaximumValue(rcti *rect)
 MemoryBuffer::~MemoryBuffer()
 {
   if (this->m_buffer) {
-    MEM_freeN(this->m_buffer);
+    buffer_pool_free(this->m_buffer, sizeof(float) * determineBufferSize() * this->m_num_channels);
     this->m_buffer = nullptr;
   }
 }
@@ -115,6 +115,16 @@ class MemoryBuffer {
    */
   ~MemoryBuffer();
 
+  /**
+   * \brief free the unused buffers kept for recycling, called at the end of an execution
+   */
+  static void free_pool();
+
+  /**
+   * \brief memory used by buffers for chunks, including the unused ones kept for recycling
+   */
+  static size_t get_used_memory();
+
   /**
    * \brief read the ChunkNumber of this MemoryBuffer
    */
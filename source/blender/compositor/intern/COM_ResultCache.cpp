@@ -0,0 +1,146 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#include <list>
+#include <string.h>
+
+#include "COM_ResultCache.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_hash_mm2a.h"
+#include "BLI_threads.h"
+
+/* Memory budget of the cache, a 4K color buffer takes about 130 MB. */
+#define COM_RESULT_CACHE_SIZE (1024 * 1024 * 1024)
+
+struct ResultCacheEntry {
+  uint64_t key;
+  DataType datatype;
+  rcti rect;
+  float *buffer;
+  size_t size;
+};
+
+/* Most recently used entries are at the front. */
+static std::list<ResultCacheEntry> g_entries;
+static size_t g_size = 0;
+static ThreadMutex g_cache_lock = BLI_MUTEX_INITIALIZER;
+
+static void result_cache_entry_free(ResultCacheEntry &entry)
+{
+  MEM_freeN(entry.buffer);
+  g_size -= entry.size;
+}
+
+uint64_t ResultCache::hash_data(const void *data, size_t size, uint64_t hash)
+{
+  if (data == nullptr) {
+    size = 0;
+  }
+
+  /* Two 32 bit hashes with different seeds, collisions would silently show a wrong result. */
+  const uint32_t low = BLI_hash_mm2((const unsigned char *)data, size, (uint32_t)hash);
+  const uint32_t high = BLI_hash_mm2((const unsigned char *)data, size, (uint32_t)(hash >> 32) + 1);
+  return ((uint64_t)high << 32) | low;
+}
+
+uint64_t ResultCache::hash_buffer(MemoryBuffer *buffer, uint64_t hash)
+{
+  if (buffer == nullptr || buffer->getBuffer() == nullptr) {
+    const int unconnected = -1;
+    return hash_data(&unconnected, sizeof(unconnected), hash);
+  }
+
+  const int header[3] = {
+      buffer->getWidth(), buffer->getHeight(), (int)buffer->get_num_channels()};
+  hash = hash_data(header, sizeof(header), hash);
+
+  const size_t size = sizeof(float) * buffer->getWidth() * buffer->getHeight() *
+                      buffer->get_num_channels();
+  return hash_data(buffer->getBuffer(), size, hash);
+}
+
+MemoryBuffer *ResultCache::lookup(uint64_t key, DataType datatype, rcti *rect)
+{
+  BLI_mutex_lock(&g_cache_lock);
+
+  for (std::list<ResultCacheEntry>::iterator it = g_entries.begin(); it != g_entries.end(); ++it) {
+    if (it->key == key && it->datatype == datatype && BLI_rcti_compare(&it->rect, rect)) {
+      MemoryBuffer *result = new MemoryBuffer(datatype, rect);
+      memcpy(result->getBuffer(), it->buffer, it->size);
+
+      g_entries.splice(g_entries.begin(), g_entries, it);
+      BLI_mutex_unlock(&g_cache_lock);
+      return result;
+    }
+  }
+
+  BLI_mutex_unlock(&g_cache_lock);
+  return nullptr;
+}
+
+void ResultCache::insert(uint64_t key, DataType datatype, MemoryBuffer *buffer)
+{
+  const size_t size = sizeof(float) * buffer->getWidth() * buffer->getHeight() *
+                      buffer->get_num_channels();
+  if (size > COM_RESULT_CACHE_SIZE) {
+    return;
+  }
+
+  BLI_mutex_lock(&g_cache_lock);
+
+  /* Another operation with the same settings and inputs may have stored its result already. */
+  for (ResultCacheEntry &entry : g_entries) {
+    if (entry.key == key && entry.datatype == datatype &&
+        BLI_rcti_compare(&entry.rect, buffer->getRect())) {
+      BLI_mutex_unlock(&g_cache_lock);
+      return;
+    }
+  }
+
+  ResultCacheEntry entry;
+  entry.key = key;
+  entry.datatype = datatype;
+  entry.rect = *buffer->getRect();
+  entry.buffer = (float *)MEM_mallocN(size, "ResultCacheEntry");
+  entry.size = size;
+  memcpy(entry.buffer, buffer->getBuffer(), size);
+
+  while (!g_entries.empty() && g_size + size > COM_RESULT_CACHE_SIZE) {
+    result_cache_entry_free(g_entries.back());
+    g_entries.pop_back();
+  }
+
+  g_entries.push_front(entry);
+  g_size += size;
+
+  BLI_mutex_unlock(&g_cache_lock);
+}
+
+void ResultCache::deinitialize()
+{
+  BLI_mutex_lock(&g_cache_lock);
+
+  for (ResultCacheEntry &entry : g_entries) {
+    result_cache_entry_free(entry);
+  }
+  g_entries.clear();
+
+  BLI_mutex_unlock(&g_cache_lock);
+}
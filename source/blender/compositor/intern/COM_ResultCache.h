@@ -0,0 +1,62 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "COM_MemoryBuffer.h"
+
+/**
+ * \brief Results of expensive operations that are kept between executions of the compositor.
+ *
+ * Entries are keyed by a hash of the operation settings and the contents of its input buffers,
+ * so editing nodes further down the tree reuses the result instead of recomputing it. The least
+ * recently used entries are freed when the cache grows over its memory budget.
+ * \ingroup execution
+ */
+class ResultCache {
+ public:
+  /**
+   * \brief Hash the contents of a buffer, including its size and number of channels.
+   * \param buffer: the buffer to hash, can be nullptr for unconnected inputs
+   * \param hash: hash to combine with
+   */
+  static uint64_t hash_buffer(MemoryBuffer *buffer, uint64_t hash);
+
+  /**
+   * \brief Hash plain data such as operation settings.
+   */
+  static uint64_t hash_data(const void *data, size_t size, uint64_t hash);
+
+  /**
+   * \brief Create a buffer with the cached result for the given key.
+   * \return nullptr when there is no result with the same key, data type and area.
+   */
+  static MemoryBuffer *lookup(uint64_t key, DataType datatype, rcti *rect);
+
+  /**
+   * \brief Store a copy of the result of an operation.
+   */
+  static void insert(uint64_t key, DataType datatype, MemoryBuffer *buffer);
+
+  /**
+   * \brief Free all cached results.
+   */
+  static void deinitialize();
+};
@@ -94,6 +94,25 @@ class SocketReader {
   {
   }
 
+  /**
+   * \brief calculate a rectangle of pixels at once
+   * \note this method is called for non-complex, the default implementation calls
+   * executePixelSampled for every pixel. Operations that override it process whole rows in a
+   * tight loop instead of going through a virtual call per pixel.
+   * \param output: is a buffer of num_channels floats for every pixel of the rectangle, row by row
+   * \param rect: the area to calculate in image space
+   * \param num_channels: the number of channels of the output socket
+   */
+  virtual void executeRect(float *output, const rcti &rect, int num_channels)
+  {
+    for (int y = rect.ymin; y < rect.ymax; y++) {
+      for (int x = rect.xmin; x < rect.xmax; x++) {
+        executePixelSampled(output, x, y, COM_PS_NEAREST);
+        output += num_channels;
+      }
+    }
+  }
+
  public:
   inline void readSampled(float result[4], float x, float y, PixelSampler sampler)
   {
@@ -107,6 +126,10 @@ class SocketReader {
   {
     executePixelFiltered(result, x, y, dx, dy);
   }
+  inline void readRect(float *result, const rcti &rect, int num_channels)
+  {
+    executeRect(result, rect, num_channels);
+  }
 
   virtual void *initializeTileData(rcti * /*rect*/)
   {
@@ -16,6 +16,8 @@
  * Copyright 2011, Blender Foundation.
  */
 
+#include <vector>
+
 #include "COM_ConvertOperation.h"
 
 #include "IMB_colormanagement.h"
@@ -54,6 +56,23 @@ void ConvertValueToColorOperation::executePixelSampled(float output[4],
   output[3] = 1.0f;
 }
 
+void ConvertValueToColorOperation::executeRect(float *output, const rcti &rect, int num_channels)
+{
+  BLI_assert(num_channels == COM_NUM_CHANNELS_COLOR);
+  UNUSED_VARS_NDEBUG(num_channels);
+
+  /* Read the values into the last quarter of the output and expand them in place. */
+  const int size = BLI_rcti_size_x(&rect) * BLI_rcti_size_y(&rect);
+  float *values = &output[size * 3];
+  this->m_inputOperation->readRect(values, rect, COM_NUM_CHANNELS_VALUE);
+  for (int i = 0; i < size; i++) {
+    const float value = values[i];
+    float *out = &output[i * COM_NUM_CHANNELS_COLOR];
+    out[0] = out[1] = out[2] = value;
+    out[3] = 1.0f;
+  }
+}
+
 /* ******** Color to Value ******** */
 
 ConvertColorToValueOperation::ConvertColorToValueOperation() : ConvertBaseOperation()
@@ -72,6 +91,20 @@ void ConvertColorToValueOperation::executePixelSampled(float output[4],
   output[0] = (inputColor[0] + inputColor[1] + inputColor[2]) / 3.0f;
 }
 
+void ConvertColorToValueOperation::executeRect(float *output, const rcti &rect, int num_channels)
+{
+  BLI_assert(num_channels == COM_NUM_CHANNELS_VALUE);
+  UNUSED_VARS_NDEBUG(num_channels);
+
+  const int size = BLI_rcti_size_x(&rect) * BLI_rcti_size_y(&rect);
+  std::vector<float> color(size * COM_NUM_CHANNELS_COLOR);
+  this->m_inputOperation->readRect(color.data(), rect, COM_NUM_CHANNELS_COLOR);
+  for (int i = 0; i < size; i++) {
+    const float *inputColor = &color[i * COM_NUM_CHANNELS_COLOR];
+    output[i] = (inputColor[0] + inputColor[1] + inputColor[2]) / 3.0f;
+  }
+}
+
 /* ******** Color to BW ******** */
 
 ConvertColorToBWOperation::ConvertColorToBWOperation() : ConvertBaseOperation()
@@ -90,6 +123,19 @@ void ConvertColorToBWOperation::executePixelSampled(float output[4],
   output[0] = IMB_colormanagement_get_luminance(inputColor);
 }
 
+void ConvertColorToBWOperation::executeRect(float *output, const rcti &rect, int num_channels)
+{
+  BLI_assert(num_channels == COM_NUM_CHANNELS_VALUE);
+  UNUSED_VARS_NDEBUG(num_channels);
+
+  const int size = BLI_rcti_size_x(&rect) * BLI_rcti_size_y(&rect);
+  std::vector<float> color(size * COM_NUM_CHANNELS_COLOR);
+  this->m_inputOperation->readRect(color.data(), rect, COM_NUM_CHANNELS_COLOR);
+  for (int i = 0; i < size; i++) {
+    output[i] = IMB_colormanagement_get_luminance(&color[i * COM_NUM_CHANNELS_COLOR]);
+  }
+}
+
 /* ******** Color to Vector ******** */
 
 ConvertColorToVectorOperation::ConvertColorToVectorOperation() : ConvertBaseOperation()
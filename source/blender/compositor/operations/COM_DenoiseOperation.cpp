@@ -17,6 +17,7 @@
  */
 
 #include "COM_DenoiseOperation.h"
+#include "COM_ResultCache.h"
 #include "BLI_math.h"
 #include "BLI_system.h"
 #ifdef WITH_OPENIMAGEDENOISE
@@ -60,9 +61,21 @@ MemoryBuffer *DenoiseOperation::createMemoryBuffer(rcti *rect2)
   rect.ymin = 0;
   rect.xmax = getWidth();
   rect.ymax = getHeight();
-  MemoryBuffer *result = new MemoryBuffer(COM_DT_COLOR, &rect);
+
+  /* Denoising is expensive, reuse the result of a previous execution with the same inputs. */
+  uint64_t key = ResultCache::hash_data(this->m_settings, sizeof(NodeDenoise), 0);
+  key = ResultCache::hash_buffer(tileColor, key);
+  key = ResultCache::hash_buffer(tileNormal, key);
+  key = ResultCache::hash_buffer(tileAlbedo, key);
+  MemoryBuffer *result = ResultCache::lookup(key, COM_DT_COLOR, &rect);
+  if (result) {
+    return result;
+  }
+
+  result = new MemoryBuffer(COM_DT_COLOR, &rect);
   float *data = result->getBuffer();
   this->generateDenoise(data, tileColor, tileNormal, tileAlbedo, this->m_settings);
+  ResultCache::insert(key, COM_DT_COLOR, result);
   return result;
 }
 
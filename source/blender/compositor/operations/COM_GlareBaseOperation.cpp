@@ -17,6 +17,7 @@
  */
 
 #include "COM_GlareBaseOperation.h"
+#include "COM_ResultCache.h"
 #include "BLI_math.h"
 
 GlareBaseOperation::GlareBaseOperation()
@@ -45,9 +46,19 @@ MemoryBuffer *GlareBaseOperation::createMemoryBuffer(rcti *rect2)
   rect.ymin = 0;
   rect.xmax = getWidth();
   rect.ymax = getHeight();
-  MemoryBuffer *result = new MemoryBuffer(COM_DT_COLOR, &rect);
+
+  /* Glare is expensive, reuse the result of a previous execution with the same input. */
+  uint64_t key = ResultCache::hash_data(this->m_settings, sizeof(NodeGlare), 0);
+  key = ResultCache::hash_buffer(tile, key);
+  MemoryBuffer *result = ResultCache::lookup(key, COM_DT_COLOR, &rect);
+  if (result) {
+    return result;
+  }
+
+  result = new MemoryBuffer(COM_DT_COLOR, &rect);
   float *data = result->getBuffer();
   this->generateGlare(data, tile, this->m_settings);
+  ResultCache::insert(key, COM_DT_COLOR, result);
   return result;
 }
 
@@ -71,6 +71,28 @@ void MathBaseOperation::clampIfNeeded(float *color)
   }
 }
 
+int MathBaseOperation::readInputRects(const rcti &rect,
+                                      std::vector<float> &value1,
+                                      std::vector<float> &value2)
+{
+  const int size = BLI_rcti_size_x(&rect) * BLI_rcti_size_y(&rect);
+  /* Leave room for operations that write a full float[4] for the last pixel. */
+  value1.resize(size + 3);
+  value2.resize(size + 3);
+  this->m_inputValue1Operation->readRect(value1.data(), rect, COM_NUM_CHANNELS_VALUE);
+  this->m_inputValue2Operation->readRect(value2.data(), rect, COM_NUM_CHANNELS_VALUE);
+  return size;
+}
+
+void MathBaseOperation::clampRectIfNeeded(float *output, int size)
+{
+  if (this->m_useClamp) {
+    for (int i = 0; i < size; i++) {
+      CLAMP(output[i], 0.0f, 1.0f);
+    }
+  }
+}
+
 void MathAddOperation::executePixelSampled(float output[4], float x, float y, PixelSampler sampler)
 {
   float inputValue1[4];
@@ -84,6 +106,20 @@ void MathAddOperation::executePixelSampled(float output[4], float x, float y, Pi
   clampIfNeeded(output);
 }
 
+void MathAddOperation::executeRect(float *output, const rcti &rect, int num_channels)
+{
+  BLI_assert(num_channels == COM_NUM_CHANNELS_VALUE);
+  UNUSED_VARS_NDEBUG(num_channels);
+
+  std::vector<float> value1, value2;
+  const int size = readInputRects(rect, value1, value2);
+  for (int i = 0; i < size; i++) {
+    output[i] = value1[i] + value2[i];
+  }
+
+  clampRectIfNeeded(output, size);
+}
+
 void MathSubtractOperation::executePixelSampled(float output[4],
                                                 float x,
                                                 float y,
@@ -100,6 +136,20 @@ void MathSubtractOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MathSubtractOperation::executeRect(float *output, const rcti &rect, int num_channels)
+{
+  BLI_assert(num_channels == COM_NUM_CHANNELS_VALUE);
+  UNUSED_VARS_NDEBUG(num_channels);
+
+  std::vector<float> value1, value2;
+  const int size = readInputRects(rect, value1, value2);
+  for (int i = 0; i < size; i++) {
+    output[i] = value1[i] - value2[i];
+  }
+
+  clampRectIfNeeded(output, size);
+}
+
 void MathMultiplyOperation::executePixelSampled(float output[4],
                                                 float x,
                                                 float y,
@@ -116,6 +166,20 @@ void MathMultiplyOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MathMultiplyOperation::executeRect(float *output, const rcti &rect, int num_channels)
+{
+  BLI_assert(num_channels == COM_NUM_CHANNELS_VALUE);
+  UNUSED_VARS_NDEBUG(num_channels);
+
+  std::vector<float> value1, value2;
+  const int size = readInputRects(rect, value1, value2);
+  for (int i = 0; i < size; i++) {
+    output[i] = value1[i] * value2[i];
+  }
+
+  clampRectIfNeeded(output, size);
+}
+
 void MathDivideOperation::executePixelSampled(float output[4],
                                               float x,
                                               float y,
@@ -137,6 +201,21 @@ void MathDivideOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MathDivideOperation::executeRect(float *output, const rcti &rect, int num_channels)
+{
+  BLI_assert(num_channels == COM_NUM_CHANNELS_VALUE);
+  UNUSED_VARS_NDEBUG(num_channels);
+
+  std::vector<float> value1, value2;
+  const int size = readInputRects(rect, value1, value2);
+  for (int i = 0; i < size; i++) {
+    /* We don't want to divide by zero. */
+    output[i] = (value2[i] == 0) ? 0.0f : value1[i] / value2[i];
+  }
+
+  clampRectIfNeeded(output, size);
+}
+
 void MathSineOperation::executePixelSampled(float output[4],
                                             float x,
                                             float y,
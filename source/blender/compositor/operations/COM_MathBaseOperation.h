@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "COM_NodeOperation.h"
 
 /**
@@ -43,6 +45,13 @@ class MathBaseOperation : public NodeOperation {
 
   void clampIfNeeded(float color[4]);
 
+  /**
+   * Read the first two inputs for a whole rectangle, one value per pixel. Returns the number of
+   * pixels, used by the operations that implement #executeRect.
+   */
+  int readInputRects(const rcti &rect, std::vector<float> &value1, std::vector<float> &value2);
+  void clampRectIfNeeded(float *output, int size);
+
  public:
   /**
    * the inner loop of this program
@@ -76,6 +85,7 @@ class MathAddOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRect(float *output, const rcti &rect, int num_channels);
 };
 class MathSubtractOperation : public MathBaseOperation {
  public:
@@ -83,6 +93,7 @@ class MathSubtractOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRect(float *output, const rcti &rect, int num_channels);
 };
 class MathMultiplyOperation : public MathBaseOperation {
  public:
@@ -90,6 +101,7 @@ class MathMultiplyOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRect(float *output, const rcti &rect, int num_channels);
 };
 class MathDivideOperation : public MathBaseOperation {
  public:
@@ -97,6 +109,7 @@ class MathDivideOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRect(float *output, const rcti &rect, int num_channels);
 };
 class MathSineOperation : public MathBaseOperation {
  public:
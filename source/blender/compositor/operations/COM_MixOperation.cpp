@@ -20,6 +20,10 @@
 
 #include "BLI_math.h"
 
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
 /* ******** Mix Base Operation ******** */
 
 MixBaseOperation::MixBaseOperation()
@@ -63,6 +67,65 @@ void MixBaseOperation::executePixelSampled(float output[4], float x, float y, Pi
   output[3] = inputColor1[3];
 }
 
+int MixBaseOperation::readInputRects(const rcti &rect,
+                                     std::vector<float> &value,
+                                     std::vector<float> &color1,
+                                     std::vector<float> &color2)
+{
+  const int size = BLI_rcti_size_x(&rect) * BLI_rcti_size_y(&rect);
+  /* Leave room for operations that write a full float[4] for the last value. */
+  value.resize(size + 3);
+  color1.resize(size * COM_NUM_CHANNELS_COLOR);
+  color2.resize(size * COM_NUM_CHANNELS_COLOR);
+  this->m_inputValueOperation->readRect(value.data(), rect, COM_NUM_CHANNELS_VALUE);
+  this->m_inputColor1Operation->readRect(color1.data(), rect, COM_NUM_CHANNELS_COLOR);
+  this->m_inputColor2Operation->readRect(color2.data(), rect, COM_NUM_CHANNELS_COLOR);
+
+  if (this->useValueAlphaMultiply()) {
+    for (int i = 0; i < size; i++) {
+      value[i] *= color2[i * COM_NUM_CHANNELS_COLOR + 3];
+    }
+  }
+  return size;
+}
+
+void MixBaseOperation::clampRectIfNeeded(float *output, int size)
+{
+  if (m_useClamp) {
+    for (int i = 0; i < size; i++) {
+      clamp_v4(&output[i * COM_NUM_CHANNELS_COLOR], 0.0f, 1.0f);
+    }
+  }
+}
+
+void MixBaseOperation::executeRect(float *output, const rcti &rect, int num_channels)
+{
+  BLI_assert(num_channels == COM_NUM_CHANNELS_COLOR);
+  UNUSED_VARS_NDEBUG(num_channels);
+
+  std::vector<float> value, color1, color2;
+  const int size = readInputRects(rect, value, color1, color2);
+
+  for (int i = 0; i < size; i++) {
+    const float *inputColor1 = &color1[i * COM_NUM_CHANNELS_COLOR];
+    const float *inputColor2 = &color2[i * COM_NUM_CHANNELS_COLOR];
+    float *out = &output[i * COM_NUM_CHANNELS_COLOR];
+#ifdef __SSE2__
+    const __m128 v = _mm_set1_ps(value[i]);
+    const __m128 vm = _mm_set1_ps(1.0f - value[i]);
+    _mm_storeu_ps(out,
+                  _mm_add_ps(_mm_mul_ps(vm, _mm_loadu_ps(inputColor1)),
+                             _mm_mul_ps(v, _mm_loadu_ps(inputColor2))));
+#else
+    const float valuem = 1.0f - value[i];
+    out[0] = valuem * inputColor1[0] + value[i] * inputColor2[0];
+    out[1] = valuem * inputColor1[1] + value[i] * inputColor2[1];
+    out[2] = valuem * inputColor1[2] + value[i] * inputColor2[2];
+#endif
+    out[3] = inputColor1[3];
+  }
+}
+
 void MixBaseOperation::determineResolution(unsigned int resolution[2],
                                            unsigned int preferredResolution[2])
 {
@@ -124,6 +187,33 @@ void MixAddOperation::executePixelSampled(float output[4], float x, float y, Pix
   clampIfNeeded(output);
 }
 
+void MixAddOperation::executeRect(float *output, const rcti &rect, int num_channels)
+{
+  BLI_assert(num_channels == COM_NUM_CHANNELS_COLOR);
+  UNUSED_VARS_NDEBUG(num_channels);
+
+  std::vector<float> value, color1, color2;
+  const int size = readInputRects(rect, value, color1, color2);
+
+  for (int i = 0; i < size; i++) {
+    const float *inputColor1 = &color1[i * COM_NUM_CHANNELS_COLOR];
+    const float *inputColor2 = &color2[i * COM_NUM_CHANNELS_COLOR];
+    float *out = &output[i * COM_NUM_CHANNELS_COLOR];
+#ifdef __SSE2__
+    const __m128 v = _mm_set1_ps(value[i]);
+    _mm_storeu_ps(out,
+                  _mm_add_ps(_mm_loadu_ps(inputColor1), _mm_mul_ps(v, _mm_loadu_ps(inputColor2))));
+#else
+    out[0] = inputColor1[0] + value[i] * inputColor2[0];
+    out[1] = inputColor1[1] + value[i] * inputColor2[1];
+    out[2] = inputColor1[2] + value[i] * inputColor2[2];
+#endif
+    out[3] = inputColor1[3];
+  }
+
+  clampRectIfNeeded(output, size);
+}
+
 /* ******** Mix Blend Operation ******** */
 
 MixBlendOperation::MixBlendOperation()
@@ -158,6 +248,12 @@ void MixBlendOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MixBlendOperation::executeRect(float *output, const rcti &rect, int num_channels)
+{
+  MixBaseOperation::executeRect(output, rect, num_channels);
+  clampRectIfNeeded(output, BLI_rcti_size_x(&rect) * BLI_rcti_size_y(&rect));
+}
+
 /* ******** Mix Burn Operation ******** */
 
 MixColorBurnOperation::MixColorBurnOperation()
@@ -705,6 +801,36 @@ void MixMultiplyOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MixMultiplyOperation::executeRect(float *output, const rcti &rect, int num_channels)
+{
+  BLI_assert(num_channels == COM_NUM_CHANNELS_COLOR);
+  UNUSED_VARS_NDEBUG(num_channels);
+
+  std::vector<float> value, color1, color2;
+  const int size = readInputRects(rect, value, color1, color2);
+
+  for (int i = 0; i < size; i++) {
+    const float *inputColor1 = &color1[i * COM_NUM_CHANNELS_COLOR];
+    const float *inputColor2 = &color2[i * COM_NUM_CHANNELS_COLOR];
+    float *out = &output[i * COM_NUM_CHANNELS_COLOR];
+#ifdef __SSE2__
+    const __m128 v = _mm_set1_ps(value[i]);
+    const __m128 vm = _mm_set1_ps(1.0f - value[i]);
+    _mm_storeu_ps(out,
+                  _mm_mul_ps(_mm_loadu_ps(inputColor1),
+                             _mm_add_ps(vm, _mm_mul_ps(v, _mm_loadu_ps(inputColor2)))));
+#else
+    const float valuem = 1.0f - value[i];
+    out[0] = inputColor1[0] * (valuem + value[i] * inputColor2[0]);
+    out[1] = inputColor1[1] * (valuem + value[i] * inputColor2[1]);
+    out[2] = inputColor1[2] * (valuem + value[i] * inputColor2[2]);
+#endif
+    out[3] = inputColor1[3];
+  }
+
+  clampRectIfNeeded(output, size);
+}
+
 /* ******** Mix Ovelray Operation ******** */
 
 MixOverlayOperation::MixOverlayOperation()
@@ -831,6 +957,37 @@ void MixScreenOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MixScreenOperation::executeRect(float *output, const rcti &rect, int num_channels)
+{
+  BLI_assert(num_channels == COM_NUM_CHANNELS_COLOR);
+  UNUSED_VARS_NDEBUG(num_channels);
+
+  std::vector<float> value, color1, color2;
+  const int size = readInputRects(rect, value, color1, color2);
+
+  for (int i = 0; i < size; i++) {
+    const float *inputColor1 = &color1[i * COM_NUM_CHANNELS_COLOR];
+    const float *inputColor2 = &color2[i * COM_NUM_CHANNELS_COLOR];
+    float *out = &output[i * COM_NUM_CHANNELS_COLOR];
+#ifdef __SSE2__
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 v = _mm_set1_ps(value[i]);
+    const __m128 vm = _mm_set1_ps(1.0f - value[i]);
+    const __m128 inv1 = _mm_sub_ps(one, _mm_loadu_ps(inputColor1));
+    const __m128 inv2 = _mm_sub_ps(one, _mm_loadu_ps(inputColor2));
+    _mm_storeu_ps(out, _mm_sub_ps(one, _mm_mul_ps(_mm_add_ps(vm, _mm_mul_ps(v, inv2)), inv1)));
+#else
+    const float valuem = 1.0f - value[i];
+    out[0] = 1.0f - (valuem + value[i] * (1.0f - inputColor2[0])) * (1.0f - inputColor1[0]);
+    out[1] = 1.0f - (valuem + value[i] * (1.0f - inputColor2[1])) * (1.0f - inputColor1[1]);
+    out[2] = 1.0f - (valuem + value[i] * (1.0f - inputColor2[2])) * (1.0f - inputColor1[2]);
+#endif
+    out[3] = inputColor1[3];
+  }
+
+  clampRectIfNeeded(output, size);
+}
+
 /* ******** Mix Soft Light Operation ******** */
 
 MixSoftLightOperation::MixSoftLightOperation()
@@ -909,6 +1066,33 @@ void MixSubtractOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MixSubtractOperation::executeRect(float *output, const rcti &rect, int num_channels)
+{
+  BLI_assert(num_channels == COM_NUM_CHANNELS_COLOR);
+  UNUSED_VARS_NDEBUG(num_channels);
+
+  std::vector<float> value, color1, color2;
+  const int size = readInputRects(rect, value, color1, color2);
+
+  for (int i = 0; i < size; i++) {
+    const float *inputColor1 = &color1[i * COM_NUM_CHANNELS_COLOR];
+    const float *inputColor2 = &color2[i * COM_NUM_CHANNELS_COLOR];
+    float *out = &output[i * COM_NUM_CHANNELS_COLOR];
+#ifdef __SSE2__
+    const __m128 v = _mm_set1_ps(value[i]);
+    _mm_storeu_ps(out,
+                  _mm_sub_ps(_mm_loadu_ps(inputColor1), _mm_mul_ps(v, _mm_loadu_ps(inputColor2))));
+#else
+    out[0] = inputColor1[0] - value[i] * inputColor2[0];
+    out[1] = inputColor1[1] - value[i] * inputColor2[1];
+    out[2] = inputColor1[2] - value[i] * inputColor2[2];
+#endif
+    out[3] = inputColor1[3];
+  }
+
+  clampRectIfNeeded(output, size);
+}
+
 /* ******** Mix Value Operation ******** */
 
 MixValueOperation::MixValueOperation()
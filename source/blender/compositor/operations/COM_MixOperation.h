@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "COM_NodeOperation.h"
 
 /**
@@ -43,6 +45,17 @@ class MixBaseOperation : public NodeOperation {
     }
   }
 
+  /**
+   * Read the inputs for a whole rectangle, the value is already multiplied by the alpha of the
+   * second color when needed. Returns the number of pixels, used by the operations that implement
+   * #executeRect.
+   */
+  int readInputRects(const rcti &rect,
+                     std::vector<float> &value,
+                     std::vector<float> &color1,
+                     std::vector<float> &color2);
+  void clampRectIfNeeded(float *output, int size);
+
  public:
   /**
    * Default constructor
@@ -53,6 +66,7 @@ class MixBaseOperation : public NodeOperation {
    * the inner loop of this program
    */
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRect(float *output, const rcti &rect, int num_channels);
 
   /**
    * Initialize the execution
@@ -84,12 +98,14 @@ class MixAddOperation : public MixBaseOperation {
  public:
   MixAddOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRect(float *output, const rcti &rect, int num_channels);
 };
 
 class MixBlendOperation : public MixBaseOperation {
  public:
   MixBlendOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRect(float *output, const rcti &rect, int num_channels);
 };
 
 class MixColorBurnOperation : public MixBaseOperation {
@@ -156,6 +172,7 @@ class MixMultiplyOperation : public MixBaseOperation {
  public:
   MixMultiplyOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRect(float *output, const rcti &rect, int num_channels);
 };
 
 class MixOverlayOperation : public MixBaseOperation {
@@ -174,6 +191,7 @@ class MixScreenOperation : public MixBaseOperation {
  public:
   MixScreenOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRect(float *output, const rcti &rect, int num_channels);
 };
 
 class MixSoftLightOperation : public MixBaseOperation {
@@ -186,6 +204,7 @@ class MixSubtractOperation : public MixBaseOperation {
  public:
   MixSubtractOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRect(float *output, const rcti &rect, int num_channels);
 };
 
 class MixValueOperation : public MixBaseOperation {
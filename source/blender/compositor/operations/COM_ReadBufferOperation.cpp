@@ -107,6 +107,35 @@ void ReadBufferOperation::executePixelFiltered(
   }
 }
 
+void ReadBufferOperation::executeRect(float *output, const rcti &rect, int num_channels)
+{
+  const rcti *buffer_rect = m_buffer->getRect();
+  const int width = BLI_rcti_size_x(&rect);
+
+  if (m_single_value) {
+    /* write buffer has a single value stored at (0,0) */
+    const float *value = m_buffer->getBuffer();
+    const int size = width * BLI_rcti_size_y(&rect);
+    for (int i = 0; i < size; i++) {
+      memcpy(&output[i * num_channels], value, sizeof(float) * num_channels);
+    }
+  }
+  else if (num_channels == (int)m_buffer->get_num_channels() &&
+           BLI_rcti_inside_rcti(buffer_rect, &rect)) {
+    /* Copy whole rows, no clipping is needed inside the buffer. */
+    const float *buffer = m_buffer->getBuffer();
+    const int buffer_width = m_buffer->getWidth();
+    for (int y = rect.ymin; y < rect.ymax; y++) {
+      const int offset = (y - buffer_rect->ymin) * buffer_width + (rect.xmin - buffer_rect->xmin);
+      memcpy(output, &buffer[offset * num_channels], sizeof(float) * width * num_channels);
+      output += width * num_channels;
+    }
+  }
+  else {
+    NodeOperation::executeRect(output, rect, num_channels);
+  }
+}
+
 bool ReadBufferOperation::determineDependingAreaOfInterest(rcti *input,
                                                            ReadBufferOperation *readOperation,
                                                            rcti *output)
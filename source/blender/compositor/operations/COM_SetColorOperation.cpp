@@ -31,6 +31,16 @@ void SetColorOperation::executePixelSampled(float output[4],
   copy_v4_v4(output, this->m_color);
 }
 
+void SetColorOperation::executeRect(float *output, const rcti &rect, int num_channels)
+{
+  BLI_assert(num_channels == COM_NUM_CHANNELS_COLOR);
+  UNUSED_VARS_NDEBUG(num_channels);
+  const int size = BLI_rcti_size_x(&rect) * BLI_rcti_size_y(&rect);
+  for (int i = 0; i < size; i++) {
+    copy_v4_v4(&output[i * COM_NUM_CHANNELS_COLOR], this->m_color);
+  }
+}
+
 void SetColorOperation::determineResolution(unsigned int resolution[2],
                                             unsigned int preferredResolution[2])
 {
@@ -31,6 +31,16 @@ void SetValueOperation::executePixelSampled(float output[4],
   output[0] = this->m_value;
 }
 
+void SetValueOperation::executeRect(float *output, const rcti &rect, int num_channels)
+{
+  BLI_assert(num_channels == COM_NUM_CHANNELS_VALUE);
+  UNUSED_VARS_NDEBUG(num_channels);
+  const int size = BLI_rcti_size_x(&rect) * BLI_rcti_size_y(&rect);
+  for (int i = 0; i < size; i++) {
+    output[i] = this->m_value;
+  }
+}
+
 void SetValueOperation::determineResolution(unsigned int resolution[2],
                                             unsigned int preferredResolution[2])
 {
@@ -78,6 +78,13 @@ void DEG_graph_relations_update(struct Depsgraph *graph);
 /* Tag all relations in the database for update.*/
 void DEG_relations_tag_update(struct Main *bmain);
 
+/* Tag relations of the given ID for update in all dependency graphs.
+ *
+ * Is to be used when the set of IDs and their operations stays the same and only the way the ID
+ * depends on others changes (for example, modifier's target object is changed). Graphs which
+ * can not update relations of the ID alone are tagged for full relations update. */
+void DEG_id_tag_relations_update(struct Main *bmain, struct ID *id);
+
 /* Add Dependencies  ----------------------------- */
 
 /* Handle for components to define their dependencies from callbacks.
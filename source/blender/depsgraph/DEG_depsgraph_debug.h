@@ -62,6 +62,15 @@ void DEG_debug_stats_gnuplot(const struct Depsgraph *graph,
                              const char *label,
                              const char *output_filename);
 
+/* Write average evaluation time of all operations, the most expensive ones first. */
+void DEG_debug_stats_json(const struct Depsgraph *graph, FILE *fp);
+
+/* Fill in human readable report of the given number of the most expensive operations. */
+void DEG_debug_stats_hottest_operations(const struct Depsgraph *graph,
+                                        const int num_operations,
+                                        char *r_result,
+                                        const size_t result_maxncpy);
+
 /* ************************************************ */
 
 /* Compare two dependency graphs. */
@@ -135,6 +135,10 @@ enum {
   DEG_ITER_OBJECT_FLAG_LINKED_VIA_SET = (1 << 2),
   DEG_ITER_OBJECT_FLAG_VISIBLE = (1 << 3),
   DEG_ITER_OBJECT_FLAG_DUPLI = (1 << 4),
+  /* Iterate over the instances of a dupli-list grouped by the object and data they instance,
+   * so that all instances of the same geometry are visited one after another. The order within
+   * a group is kept. */
+  DEG_ITER_OBJECT_FLAG_DUPLI_GROUPED = (1 << 5),
 };
 
 typedef struct DEGObjectIterData {
@@ -201,7 +205,7 @@ void DEG_iterator_objects_end(struct BLI_Iterator *iter);
                          instance_, \
                          DEG_ITER_OBJECT_FLAG_LINKED_DIRECTLY | \
                              DEG_ITER_OBJECT_FLAG_LINKED_VIA_SET | DEG_ITER_OBJECT_FLAG_VISIBLE | \
-                             DEG_ITER_OBJECT_FLAG_DUPLI)
+                             DEG_ITER_OBJECT_FLAG_DUPLI | DEG_ITER_OBJECT_FLAG_DUPLI_GROUPED)
 
 #define DEG_OBJECT_ITER_FOR_RENDER_ENGINE_END DEG_OBJECT_ITER_END
 
@@ -260,6 +264,24 @@ void DEG_foreach_dependent_ID_component(const Depsgraph *depsgraph,
 
 void DEG_foreach_ID(const Depsgraph *depsgraph, DEGForeachIDCallback callback, void *user_data);
 
+/* *********************** DEG scratch memory ****************** */
+
+/* Allocate temporary memory for evaluation, without having to free it. The memory stays valid
+ * until the next evaluation of the depsgraph starts, so it must not be used for evaluated data.
+ * Thread safe. */
+void *DEG_scratch_alloc(const Depsgraph *depsgraph, size_t size);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
+
+#ifdef __cplusplus
+namespace blender {
+class GuardedAllocator;
+template<typename Allocator> class LinearAllocator;
+}  // namespace blender
+
+/* Allocator of the calling thread used by #DEG_scratch_alloc. */
+blender::LinearAllocator<blender::GuardedAllocator> &DEG_get_scratch_allocator(
+    const Depsgraph *depsgraph);
+#endif
@@ -0,0 +1,104 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/builder/deg_builder_critical_path.h"
+
+#include <algorithm>
+
+#include "BLI_stack.h"
+#include "BLI_utildefines.h"
+
+#include "intern/depsgraph.h"
+#include "intern/depsgraph_relation.h"
+#include "intern/node/deg_node.h"
+#include "intern/node/deg_node_operation.h"
+
+namespace blender::deg {
+
+namespace {
+
+/* Relations which are ignored by the evaluation engine when scheduling operations are also
+ * ignored when calculating critical paths. */
+bool is_relation_considered(const Relation *rel)
+{
+  return (rel->to->type == NodeType::OPERATION) && (rel->flag & RELATION_FLAG_CYCLIC) == 0;
+}
+
+/* Cost in seconds which is used for operations which were never evaluated yet. */
+const float DEFAULT_OPERATION_COST = 1e-5f;
+
+/* Estimated cost of evaluating the operation itself, without any of its dependents. */
+float operation_self_cost(const OperationNode *op_node)
+{
+  if (op_node->is_noop()) {
+    return 0.0f;
+  }
+  if (op_node->stats.num_evaluations == 0) {
+    return DEFAULT_OPERATION_COST;
+  }
+  return (float)op_node->stats.average_time;
+}
+
+}  // namespace
+
+/* The graph with cyclic relations ignored is acyclic, so the critical path is calculated by
+ * walking it in the reverse topological order: starting from operations which have no
+ * dependents, and only visiting an operation once all of its dependents are handled. */
+void deg_graph_calculate_critical_paths(Depsgraph *graph)
+{
+  BLI_Stack *stack = BLI_stack_new(sizeof(OperationNode *), "DEG critical path stack");
+  for (OperationNode *op_node : graph->operations) {
+    op_node->critical_path_cost = 0.0f;
+    op_node->num_links_pending = 0;
+    for (Relation *rel : op_node->outlinks) {
+      if (is_relation_considered(rel)) {
+        ++op_node->num_links_pending;
+      }
+    }
+    if (op_node->num_links_pending == 0) {
+      BLI_stack_push(stack, &op_node);
+    }
+  }
+  while (!BLI_stack_is_empty(stack)) {
+    OperationNode *op_node;
+    BLI_stack_pop(stack, &op_node);
+    /* All dependents are handled at this point, so the cost of the longest of their chains is
+     * known. */
+    op_node->critical_path_cost += operation_self_cost(op_node);
+    for (Relation *rel : op_node->inlinks) {
+      if (rel->from->type != NodeType::OPERATION || !is_relation_considered(rel)) {
+        continue;
+      }
+      OperationNode *op_from = (OperationNode *)rel->from;
+      op_from->critical_path_cost = std::max(op_from->critical_path_cost,
+                                             op_node->critical_path_cost);
+      BLI_assert(op_from->num_links_pending > 0);
+      if (--op_from->num_links_pending == 0) {
+        BLI_stack_push(stack, &op_from);
+      }
+    }
+  }
+  BLI_stack_free(stack);
+}
+
+}  // namespace blender::deg
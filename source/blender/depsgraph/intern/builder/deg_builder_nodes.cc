@@ -351,6 +351,25 @@ void DepsgraphNodeBuilder::begin_build()
     saved_entry_tags_.append(entry_tag);
   }
 
+  for (OperationNode *op_node : graph_->operations) {
+    if (op_node->stats.num_evaluations == 0) {
+      continue;
+    }
+    ComponentNode *comp_node = op_node->owner;
+    IDNode *id_node = comp_node->owner;
+
+    SavedOperationStats operation_stats;
+    operation_stats.id_orig = id_node->id_orig;
+    operation_stats.component_type = comp_node->type;
+    operation_stats.component_name = comp_node->name;
+    operation_stats.opcode = op_node->opcode;
+    operation_stats.name = op_node->name;
+    operation_stats.name_tag = op_node->name_tag;
+    operation_stats.average_time = op_node->stats.average_time;
+    operation_stats.num_evaluations = op_node->stats.num_evaluations;
+    saved_operation_stats_.append(operation_stats);
+  }
+
   /* Make sure graph has no nodes left from previous state. */
   graph_->clear_all_nodes();
   graph_->operations.clear();
@@ -377,6 +396,25 @@ void DepsgraphNodeBuilder::end_build()
      * that originally node was explicitly tagged for user update. */
     op_node->tag_update(graph_, DEG_UPDATE_SOURCE_USER_EDIT);
   }
+
+  for (const SavedOperationStats &operation_stats : saved_operation_stats_) {
+    IDNode *id_node = find_id_node(operation_stats.id_orig);
+    if (id_node == nullptr) {
+      continue;
+    }
+    ComponentNode *comp_node = id_node->find_component(operation_stats.component_type,
+                                                       operation_stats.component_name.c_str());
+    if (comp_node == nullptr) {
+      continue;
+    }
+    OperationNode *op_node = comp_node->find_operation(
+        operation_stats.opcode, operation_stats.name.c_str(), operation_stats.name_tag);
+    if (op_node == nullptr) {
+      continue;
+    }
+    op_node->stats.average_time = operation_stats.average_time;
+    op_node->stats.num_evaluations = operation_stats.num_evaluations;
+  }
 }
 
 void DepsgraphNodeBuilder::build_id(ID *id)
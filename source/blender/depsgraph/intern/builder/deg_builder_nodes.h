@@ -259,6 +259,20 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   };
   Vector<SavedEntryTag> saved_entry_tags_;
 
+  /* Evaluation timing of an operation from the previous state of the dependency graph, so that
+   * the cost model used for scheduling survives relations update. */
+  struct SavedOperationStats {
+    ID *id_orig;
+    NodeType component_type;
+    string component_name;
+    OperationCode opcode;
+    string name;
+    int name_tag;
+    double average_time;
+    int num_evaluations;
+  };
+  Vector<SavedOperationStats> saved_operation_stats_;
+
   struct BuilderWalkUserData {
     DepsgraphNodeBuilder *builder;
     /* Denotes whether object the walk is invoked from is visible. */
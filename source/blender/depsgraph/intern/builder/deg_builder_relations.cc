@@ -244,7 +244,11 @@ bool object_have_geometry_component(const Object *object)
 DepsgraphRelationBuilder::DepsgraphRelationBuilder(Main *bmain,
                                                    Depsgraph *graph,
                                                    DepsgraphBuilderCache *cache)
-    : DepsgraphBuilder(bmain, graph, cache), scene_(nullptr), rna_node_query_(graph, this)
+    : DepsgraphBuilder(bmain, graph, cache),
+      scene_(nullptr),
+      owner_id_(nullptr),
+      has_missing_nodes_(false),
+      rna_node_query_(graph, this)
 {
 }
 
@@ -350,7 +354,7 @@ Relation *DepsgraphRelationBuilder::add_time_relation(TimeSourceNode *timesrc,
                                                       int flags)
 {
   if (timesrc && node_to) {
-    return graph_->add_new_relation(timesrc, node_to, description, flags);
+    return add_owned_relation(timesrc, node_to, description, flags);
   }
 
   DEG_DEBUG_PRINTF((::Depsgraph *)graph_,
@@ -371,7 +375,7 @@ Relation *DepsgraphRelationBuilder::add_operation_relation(OperationNode *node_f
                                                            int flags)
 {
   if (node_from && node_to) {
-    return graph_->add_new_relation(node_from, node_to, description, flags);
+    return add_owned_relation(node_from, node_to, description, flags);
   }
 
   DEG_DEBUG_PRINTF((::Depsgraph *)graph_,
@@ -386,6 +390,24 @@ Relation *DepsgraphRelationBuilder::add_operation_relation(OperationNode *node_f
   return nullptr;
 }
 
+Relation *DepsgraphRelationBuilder::add_owned_relation(Node *node_from,
+                                                       Node *node_to,
+                                                       const char *description,
+                                                       int flags)
+{
+  const int64_t num_outlinks = node_from->outlinks.size();
+  Relation *rel = graph_->add_new_relation(node_from, node_to, description, flags);
+  if (node_from->outlinks.size() != num_outlinks) {
+    rel->owner_id = owner_id_;
+  }
+  else if (rel->owner_id != owner_id_) {
+    /* Existing relation is requested by another builder, it can not be removed when only one of
+     * them is re-built. */
+    rel->owner_id = nullptr;
+  }
+  return rel;
+}
+
 void DepsgraphRelationBuilder::add_particle_collision_relations(const OperationKey &key,
                                                                 Object *object,
                                                                 Collection *collection,
@@ -478,6 +500,27 @@ void DepsgraphRelationBuilder::begin_build()
 {
 }
 
+bool DepsgraphRelationBuilder::build_id_relations_incremental(Span<ID *> ids)
+{
+  scene_ = graph_->scene;
+  /* Relations of all other IDs are up to date, so consider them built. This also ensures that
+   * the builder does not recurse into dependencies of the given IDs. */
+  for (IDNode *id_node : graph_->id_nodes) {
+    if (!ids.contains(id_node->id_orig)) {
+      built_map_.tagBuild(id_node->id_orig);
+    }
+  }
+  for (ID *id : ids) {
+    build_id(id);
+  }
+  for (ID *id : ids) {
+    IDNode *id_node = graph_->find_id_node(id);
+    build_copy_on_write_relations(id_node);
+    build_driver_relations(id_node);
+  }
+  return !has_missing_nodes_;
+}
+
 void DepsgraphRelationBuilder::build_id(ID *id)
 {
   if (id == nullptr) {
@@ -597,6 +640,7 @@ void DepsgraphRelationBuilder::build_collection(LayerCollection *from_layer_coll
                                           OperationCode::TRANSFORM_FINAL);
   ComponentKey duplicator_key(object != nullptr ? &object->id : nullptr, NodeType::DUPLI);
   if (!group_done) {
+    OwnerIDScope owner_scope(this, &collection->id);
     build_idproperties(collection->id.properties);
     LISTBASE_FOREACH (CollectionObject *, cob, &collection->gobject) {
       build_object(cob->ob);
@@ -627,6 +671,7 @@ void DepsgraphRelationBuilder::build_object(Object *object)
   if (built_map_.checkIsBuiltAndTag(object)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &object->id);
   /* Object Transforms */
   OperationCode base_op = (object->parent) ? OperationCode::TRANSFORM_PARENT :
                                              OperationCode::TRANSFORM_LOCAL;
@@ -1326,7 +1371,7 @@ void DepsgraphRelationBuilder::build_animdata_curves_targets(ID *id,
       add_relation(adt_key, pose_init_key, "Animation -> Prop", RELATION_CHECK_BEFORE_ADD);
       continue;
     }
-    graph_->add_new_relation(
+    add_owned_relation(
         operation_from, operation_to, "Animation -> Prop", RELATION_CHECK_BEFORE_ADD);
     /* It is possible that animation is writing to a nested ID data-block,
      * need to make sure animation is evaluated after target ID is copied. */
@@ -1420,6 +1465,7 @@ void DepsgraphRelationBuilder::build_action(bAction *action)
   if (built_map_.checkIsBuiltAndTag(action)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &action->id);
   build_idproperties(action->id.properties);
   if (!BLI_listbase_is_empty(&action->curves)) {
     TimeSourceKey time_src_key;
@@ -1678,6 +1724,7 @@ void DepsgraphRelationBuilder::build_world(World *world)
   if (built_map_.checkIsBuiltAndTag(world)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &world->id);
   build_idproperties(world->id.properties);
   /* animation */
   build_animdata(&world->id);
@@ -1894,6 +1941,7 @@ void DepsgraphRelationBuilder::build_particle_settings(ParticleSettings *part)
   if (built_map_.checkIsBuiltAndTag(part)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &part->id);
   /* Animation data relations. */
   build_animdata(&part->id);
   build_parameters(&part->id);
@@ -1953,6 +2001,7 @@ void DepsgraphRelationBuilder::build_shapekeys(Key *key)
   if (built_map_.checkIsBuiltAndTag(key)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &key->id);
   build_idproperties(key->id.properties);
   /* Attach animdata to geometry. */
   build_animdata(&key->id);
@@ -2133,6 +2182,7 @@ void DepsgraphRelationBuilder::build_object_data_geometry_datablock(ID *obdata)
   if (built_map_.checkIsBuiltAndTag(obdata)) {
     return;
   }
+  OwnerIDScope owner_scope(this, obdata);
   build_idproperties(obdata->properties);
   /* Animation. */
   build_animdata(obdata);
@@ -2246,6 +2296,7 @@ void DepsgraphRelationBuilder::build_armature(bArmature *armature)
   if (built_map_.checkIsBuiltAndTag(armature)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &armature->id);
   build_idproperties(armature->id.properties);
   build_animdata(&armature->id);
   build_parameters(&armature->id);
@@ -2265,6 +2316,7 @@ void DepsgraphRelationBuilder::build_camera(Camera *camera)
   if (built_map_.checkIsBuiltAndTag(camera)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &camera->id);
   build_idproperties(camera->id.properties);
   build_animdata(&camera->id);
   build_parameters(&camera->id);
@@ -2282,6 +2334,7 @@ void DepsgraphRelationBuilder::build_light(Light *lamp)
   if (built_map_.checkIsBuiltAndTag(lamp)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &lamp->id);
   build_idproperties(lamp->id.properties);
   build_animdata(&lamp->id);
   build_parameters(&lamp->id);
@@ -2327,6 +2380,7 @@ void DepsgraphRelationBuilder::build_nodetree(bNodeTree *ntree)
   if (built_map_.checkIsBuiltAndTag(ntree)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &ntree->id);
   build_idproperties(ntree->id.properties);
   build_animdata(&ntree->id);
   build_parameters(&ntree->id);
@@ -2431,6 +2485,7 @@ void DepsgraphRelationBuilder::build_material(Material *material)
   if (built_map_.checkIsBuiltAndTag(material)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &material->id);
   build_idproperties(material->id.properties);
   /* animation */
   build_animdata(&material->id);
@@ -2462,6 +2517,7 @@ void DepsgraphRelationBuilder::build_texture(Tex *texture)
   if (built_map_.checkIsBuiltAndTag(texture)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &texture->id);
   /* texture itself */
   ComponentKey texture_key(&texture->id, NodeType::GENERIC_DATABLOCK);
   build_idproperties(texture->id.properties);
@@ -2498,6 +2554,7 @@ void DepsgraphRelationBuilder::build_image(Image *image)
   if (built_map_.checkIsBuiltAndTag(image)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &image->id);
   build_idproperties(image->id.properties);
   build_parameters(&image->id);
 }
@@ -2507,6 +2564,7 @@ void DepsgraphRelationBuilder::build_gpencil(bGPdata *gpd)
   if (built_map_.checkIsBuiltAndTag(gpd)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &gpd->id);
   /* animation */
   build_animdata(&gpd->id);
   build_parameters(&gpd->id);
@@ -2519,6 +2577,7 @@ void DepsgraphRelationBuilder::build_cachefile(CacheFile *cache_file)
   if (built_map_.checkIsBuiltAndTag(cache_file)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &cache_file->id);
   build_idproperties(cache_file->id.properties);
   /* Animation. */
   build_animdata(&cache_file->id);
@@ -2548,6 +2607,7 @@ void DepsgraphRelationBuilder::build_mask(Mask *mask)
   if (built_map_.checkIsBuiltAndTag(mask)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &mask->id);
   ID *mask_id = &mask->id;
   build_idproperties(mask_id->properties);
   /* F-Curve animation. */
@@ -2585,6 +2645,7 @@ void DepsgraphRelationBuilder::build_freestyle_linestyle(FreestyleLineStyle *lin
   if (built_map_.checkIsBuiltAndTag(linestyle)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &linestyle->id);
 
   ID *linestyle_id = &linestyle->id;
   build_parameters(linestyle_id);
@@ -2598,6 +2659,7 @@ void DepsgraphRelationBuilder::build_movieclip(MovieClip *clip)
   if (built_map_.checkIsBuiltAndTag(clip)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &clip->id);
   /* Animation. */
   build_idproperties(clip->id.properties);
   build_animdata(&clip->id);
@@ -2609,6 +2671,7 @@ void DepsgraphRelationBuilder::build_lightprobe(LightProbe *probe)
   if (built_map_.checkIsBuiltAndTag(probe)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &probe->id);
   build_idproperties(probe->id.properties);
   build_animdata(&probe->id);
   build_parameters(&probe->id);
@@ -2619,6 +2682,7 @@ void DepsgraphRelationBuilder::build_speaker(Speaker *speaker)
   if (built_map_.checkIsBuiltAndTag(speaker)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &speaker->id);
   build_idproperties(speaker->id.properties);
   build_animdata(&speaker->id);
   build_parameters(&speaker->id);
@@ -2635,6 +2699,7 @@ void DepsgraphRelationBuilder::build_sound(bSound *sound)
   if (built_map_.checkIsBuiltAndTag(sound)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &sound->id);
   build_idproperties(sound->id.properties);
   build_animdata(&sound->id);
   build_parameters(&sound->id);
@@ -2645,6 +2710,7 @@ void DepsgraphRelationBuilder::build_simulation(Simulation *simulation)
   if (built_map_.checkIsBuiltAndTag(simulation)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &simulation->id);
   build_idproperties(simulation->id.properties);
   build_animdata(&simulation->id);
   build_parameters(&simulation->id);
@@ -2670,6 +2736,7 @@ void DepsgraphRelationBuilder::build_scene_sequencer(Scene *scene)
   if (built_map_.checkIsBuiltAndTag(scene, BuilderMap::TAG_SCENE_SEQUENCER)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &scene->id);
   build_scene_audio(scene);
   ComponentKey scene_audio_key(&scene->id, NodeType::AUDIO);
   /* Make sure dependencies from sequences data goes to the sequencer evaluation. */
@@ -2772,6 +2839,7 @@ void DepsgraphRelationBuilder::build_nested_shapekey(ID *owner, Key *key)
 void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
 {
   ID *id_orig = id_node->id_orig;
+  OwnerIDScope owner_scope(this, id_orig);
   const ID_Type id_type = GS(id_orig->name);
   TimeSourceKey time_source_key;
   OperationKey copy_on_write_key(id_orig, NodeType::COPY_ON_WRITE, OperationCode::COPY_ON_WRITE);
@@ -2820,16 +2888,27 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
      * copy of ID. */
     OperationNode *op_entry = comp_node->get_entry_operation();
     if (op_entry != nullptr) {
-      Relation *rel = graph_->add_new_relation(op_cow, op_entry, "CoW Dependency");
+      Relation *rel = add_owned_relation(op_cow, op_entry, "CoW Dependency");
       rel->flag |= rel_flag;
     }
-    /* All dangling operations should also be executed after copy-on-write. */
-    for (OperationNode *op_node : comp_node->operations_map->values()) {
+    /* All dangling operations should also be executed after copy-on-write.
+     * NOTE: Operations are only moved from the map to the vector when build is finalized, which
+     * did already happen when relations are updated incrementally. */
+    Vector<OperationNode *> operations;
+    if (comp_node->operations_map != nullptr) {
+      for (OperationNode *op_node : comp_node->operations_map->values()) {
+        operations.append(op_node);
+      }
+    }
+    else {
+      operations.extend(comp_node->operations);
+    }
+    for (OperationNode *op_node : operations) {
       if (op_node == op_entry) {
         continue;
       }
       if (op_node->inlinks.is_empty()) {
-        Relation *rel = graph_->add_new_relation(op_cow, op_node, "CoW Dependency");
+        Relation *rel = add_owned_relation(op_cow, op_node, "CoW Dependency");
         rel->flag |= rel_flag;
       }
       else {
@@ -2845,7 +2924,7 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
           }
         }
         if (!has_same_comp_dependency) {
-          Relation *rel = graph_->add_new_relation(op_cow, op_node, "CoW Dependency");
+          Relation *rel = add_owned_relation(op_cow, op_node, "CoW Dependency");
           rel->flag |= rel_flag;
         }
       }
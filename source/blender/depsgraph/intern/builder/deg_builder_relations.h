@@ -165,6 +165,15 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
 
   void begin_build();
 
+  /* Re-derive relations of the given IDs only, assuming all other relations of the graph are up to
+   * date. Relations which were previously created by builders of those IDs are to be removed
+   * from the graph prior to this call.
+   *
+   * Returns false if relations could not be built because some of the nodes were not found in
+   * the graph. This happens when nodes of the graph are to be re-built as well, and in this case
+   * the graph is to be fully re-built. */
+  bool build_id_relations_incremental(Span<ID *> ids);
+
   template<typename KeyFrom, typename KeyTo>
   Relation *add_relation(const KeyFrom &key_from,
                          const KeyTo &key_to,
@@ -337,6 +346,11 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
                                    OperationNode *node_to,
                                    const char *description,
                                    int flags = 0);
+  /* Add relation to the graph, assigning ID which is currently being built as its owner. */
+  Relation *add_owned_relation(Node *node_from,
+                               Node *node_to,
+                               const char *description,
+                               int flags = 0);
 
   template<typename KeyType>
   DepsNodeHandle create_node_handle(const KeyType &key, const char *default_name = "");
@@ -368,8 +382,30 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
 
   static void constraint_walk(bConstraint *con, ID **idpoin, bool is_reference, void *user_data);
 
+  /* Makes the given ID the owner of all relations created during the lifetime of the scope. */
+  class OwnerIDScope {
+   public:
+    OwnerIDScope(DepsgraphRelationBuilder *builder, ID *id)
+        : builder_(builder), previous_owner_id_(builder->owner_id_)
+    {
+      builder_->owner_id_ = id;
+    }
+    ~OwnerIDScope()
+    {
+      builder_->owner_id_ = previous_owner_id_;
+    }
+
+   private:
+    DepsgraphRelationBuilder *builder_;
+    ID *previous_owner_id_;
+  };
+
   /* State which demotes currently built entities. */
   Scene *scene_;
+  /* ID which relations are currently being built. */
+  ID *owner_id_;
+  /* Some of the relations could not be added because their nodes do not exist. */
+  bool has_missing_nodes_;
 
   BuilderMap built_map_;
   RNANodeQuery rna_node_query_;
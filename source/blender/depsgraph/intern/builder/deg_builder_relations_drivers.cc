@@ -176,6 +176,7 @@ void DepsgraphRelationBuilder::build_driver_relations(IDNode *id_node)
   if (adt == nullptr) {
     return;
   }
+  OwnerIDScope owner_scope(this, id_orig);
 
   // Mapping from RNA prefix -> set of driver descriptors:
   Map<string, Vector<DriverDescriptor>> driver_groups;
@@ -53,6 +53,7 @@ Relation *DepsgraphRelationBuilder::add_relation(const KeyFrom &key_from,
     return add_operation_relation(op_from, op_to, description, flags);
   }
   else {
+    has_missing_nodes_ = true;
     if (!op_from) {
       /* XXX TODO handle as error or report if needed */
       fprintf(stderr,
@@ -95,6 +96,7 @@ Relation *DepsgraphRelationBuilder::add_relation(const TimeSourceKey &key_from,
   if (time_from != nullptr && op_to != nullptr) {
     return add_time_relation(time_from, op_to, description, flags);
   }
+  has_missing_nodes_ = true;
   return nullptr;
 }
 
@@ -111,6 +113,7 @@ Relation *DepsgraphRelationBuilder::add_node_handle_relation(const KeyType &key_
     return add_operation_relation(op_from, op_to, description, flags);
   }
   else {
+    has_missing_nodes_ = true;
     if (!op_from) {
       fprintf(stderr,
               "add_node_handle_relation(%s) - Could not find op_from (%s)\n",
@@ -52,6 +52,7 @@ void DepsgraphRelationBuilder::build_scene_parameters(Scene *scene)
   if (built_map_.checkIsBuiltAndTag(scene, BuilderMap::TAG_PARAMETERS)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &scene->id);
   build_idproperties(scene->id.properties);
   build_parameters(&scene->id);
   OperationKey parameters_eval_key(
@@ -69,6 +70,7 @@ void DepsgraphRelationBuilder::build_scene_compositor(Scene *scene)
   if (built_map_.checkIsBuiltAndTag(scene, BuilderMap::TAG_SCENE_COMPOSITOR)) {
     return;
   }
+  OwnerIDScope owner_scope(this, &scene->id);
   if (scene->nodetree == nullptr) {
     return;
   }
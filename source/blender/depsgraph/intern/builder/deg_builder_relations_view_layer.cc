@@ -90,6 +90,7 @@ void DepsgraphRelationBuilder::build_view_layer(Scene *scene,
 {
   /* Setup currently building context. */
   scene_ = scene;
+  OwnerIDScope owner_scope(this, &scene->id);
   /* Scene objects. */
   /* NOTE: Nodes builder requires us to pass CoW base because it's being
    * passed to the evaluation functions. During relations builder we only
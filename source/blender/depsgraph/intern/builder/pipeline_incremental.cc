@@ -0,0 +1,156 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "pipeline_incremental.h"
+
+#include "PIL_time.h"
+
+#include "BLI_utildefines.h"
+
+#include "BKE_global.h"
+
+#include "DNA_ID.h"
+
+#include "DEG_depsgraph.h"
+
+#include "intern/builder/deg_builder.h"
+#include "intern/builder/deg_builder_cache.h"
+#include "intern/builder/deg_builder_cycle.h"
+#include "intern/builder/deg_builder_relations.h"
+#include "intern/debug/deg_debug.h"
+#include "intern/depsgraph.h"
+#include "intern/depsgraph_relation.h"
+#include "intern/node/deg_node.h"
+#include "intern/node/deg_node_id.h"
+#include "intern/node/deg_node_operation.h"
+#include "intern/node/deg_node_time.h"
+
+namespace blender::deg {
+
+namespace {
+
+bool can_update_relations_incrementally(const Depsgraph *graph, Span<ID *> ids)
+{
+  if (graph->is_render_pipeline_depsgraph) {
+    return false;
+  }
+  for (ID *id : ids) {
+    /* Relations owned by objects are all created by the object builder, which is not the case
+     * for other ID types (for example, scene relations are created by multiple builders). */
+    if (GS(id->name) != ID_OB) {
+      return false;
+    }
+    /* Nodes are to be built for the new IDs. */
+    if (graph->find_id_node(id) == nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void remove_relations_owned_by(Node *node, Span<ID *> ids)
+{
+  Vector<Relation *> relations_to_remove;
+  for (Relation *rel : node->inlinks) {
+    if (rel->owner_id != nullptr && ids.contains(rel->owner_id)) {
+      relations_to_remove.append(rel);
+    }
+  }
+  for (Relation *rel : relations_to_remove) {
+    rel->unlink();
+    delete rel;
+  }
+}
+
+void remove_relations_owned_by(Depsgraph *graph, Span<ID *> ids)
+{
+  for (OperationNode *op_node : graph->operations) {
+    remove_relations_owned_by(op_node, ids);
+  }
+  remove_relations_owned_by(graph->time_source, ids);
+}
+
+/* Cycles are detected again for the whole graph, which needs the previous cyclic state of
+ * relations to be forgotten. */
+void clear_cyclic_relation_flags(Depsgraph *graph)
+{
+  for (OperationNode *op_node : graph->operations) {
+    for (Relation *rel : op_node->inlinks) {
+      rel->flag &= ~RELATION_FLAG_CYCLIC;
+    }
+  }
+}
+
+/* Remember current state of the ID nodes, so that finalization can tag IDs for which relations
+ * update changed the way they are to be evaluated. */
+void store_id_nodes_state(Depsgraph *graph)
+{
+  for (IDNode *id_node : graph->id_nodes) {
+    id_node->previously_visible_components_mask = id_node->visible_components_mask;
+    id_node->previous_eval_flags = id_node->eval_flags;
+    id_node->previous_customdata_masks = id_node->customdata_masks;
+  }
+}
+
+}  // namespace
+
+bool deg_graph_relations_update_incremental(Depsgraph *graph)
+{
+  double start_time = 0.0;
+  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+    start_time = PIL_check_seconds_timer();
+  }
+
+  Vector<ID *> ids;
+  for (ID *id : graph->relations_update_ids) {
+    ids.append(id);
+  }
+  graph->relations_update_ids.clear();
+  if (!can_update_relations_incrementally(graph, ids)) {
+    return false;
+  }
+
+  store_id_nodes_state(graph);
+  remove_relations_owned_by(graph, ids);
+  clear_cyclic_relation_flags(graph);
+
+  DepsgraphBuilderCache builder_cache;
+  DepsgraphRelationBuilder relation_builder(graph->bmain, graph, &builder_cache);
+  relation_builder.begin_build();
+  if (!relation_builder.build_id_relations_incremental(ids)) {
+    return false;
+  }
+
+  deg_graph_detect_cycles(graph);
+  deg_graph_build_finalize(graph->bmain, graph);
+  DEG_graph_on_visible_update(graph->bmain, reinterpret_cast<::Depsgraph *>(graph), false);
+
+  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+    printf("Depsgraph relations of %d IDs updated in %f seconds.\n",
+           (int)ids.size(),
+           PIL_check_seconds_timer() - start_time);
+  }
+  return true;
+}
+
+}  // namespace blender::deg
@@ -0,0 +1,144 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Reports of the per-operation evaluation cost model.
+ */
+
+#include "DEG_depsgraph_debug.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "BLI_string.h"
+#include "BLI_utildefines.h"
+
+#include "intern/depsgraph.h"
+#include "intern/node/deg_node_component.h"
+#include "intern/node/deg_node_id.h"
+#include "intern/node/deg_node_operation.h"
+
+#include "DNA_ID.h"
+
+namespace deg = blender::deg;
+
+namespace blender::deg {
+namespace {
+
+/* Get all operations which were evaluated at least once, the most expensive ones first. */
+Vector<const OperationNode *> get_operations_by_average_time(const Depsgraph *graph)
+{
+  Vector<const OperationNode *> operations;
+  for (const OperationNode *op_node : graph->operations) {
+    if (op_node->stats.num_evaluations != 0) {
+      operations.append(op_node);
+    }
+  }
+  std::sort(operations.begin(),
+            operations.end(),
+            [](const OperationNode *a, const OperationNode *b) {
+              return a->stats.average_time > b->stats.average_time;
+            });
+  return operations;
+}
+
+string json_escape(const string &str)
+{
+  string result;
+  for (const char ch : str) {
+    switch (ch) {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      default:
+        if ((unsigned char)ch < 0x20) {
+          /* Control characters are not expected in names, skip them. */
+          break;
+        }
+        result += ch;
+        break;
+    }
+  }
+  return result;
+}
+
+}  // namespace
+}  // namespace blender::deg
+
+void DEG_debug_stats_json(const Depsgraph *depsgraph, FILE *fp)
+{
+  if (depsgraph == nullptr) {
+    return;
+  }
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(depsgraph);
+  fprintf(fp, "{\n  \"operations\": [");
+  bool is_first = true;
+  for (const deg::OperationNode *op_node : deg::get_operations_by_average_time(deg_graph)) {
+    const deg::ComponentNode *comp_node = op_node->owner;
+    const deg::IDNode *id_node = comp_node->owner;
+    fprintf(fp,
+            "%s\n    {\"id\": \"%s\", \"component\": \"%s\", \"component_name\": \"%s\", "
+            "\"operation\": \"%s\", \"name\": \"%s\", \"name_tag\": %d, "
+            "\"average_time\": %.9f, \"last_time\": %.9f, \"num_evaluations\": %d, "
+            "\"critical_path_cost\": %.9f}",
+            is_first ? "" : ",",
+            deg::json_escape(id_node->id_orig->name).c_str(),
+            deg::nodeTypeAsString(comp_node->type),
+            deg::json_escape(comp_node->name).c_str(),
+            deg::operationCodeAsString(op_node->opcode),
+            deg::json_escape(op_node->name).c_str(),
+            op_node->name_tag,
+            op_node->stats.average_time,
+            op_node->stats.current_time,
+            op_node->stats.num_evaluations,
+            op_node->critical_path_cost);
+    is_first = false;
+  }
+  fprintf(fp, "\n  ]\n}\n");
+}
+
+void DEG_debug_stats_hottest_operations(const Depsgraph *depsgraph,
+                                        const int num_operations,
+                                        char *r_result,
+                                        const size_t result_maxncpy)
+{
+  r_result[0] = '\0';
+  if (depsgraph == nullptr) {
+    return;
+  }
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(depsgraph);
+  blender::Vector<const deg::OperationNode *> operations = deg::get_operations_by_average_time(
+      deg_graph);
+  std::stringstream stream;
+  const int num_reported = std::min<int>(num_operations, operations.size());
+  for (int i = 0; i < num_reported; i++) {
+    const deg::OperationNode *op_node = operations[i];
+    stream << op_node->stats.average_time * 1000.0 << " ms\t" << op_node->full_identifier()
+           << "\n";
+  }
+  BLI_strncpy(r_result, stream.str().c_str(), result_maxncpy);
+}
@@ -37,6 +37,8 @@
 
 #include "BKE_main.h" /* for MAX_LIBARRAY */
 
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_linear_allocator.hh"
 #include "BLI_threads.h" /* for SpinLock */
 
 #include "DEG_depsgraph.h"
@@ -110,6 +112,10 @@ struct Depsgraph {
   /* Indicates whether relations needs to be updated. */
   bool need_update;
 
+  /* IDs for which only relations are to be updated, without rebuilding the whole graph.
+   * Ignored when need_update is set. */
+  Set<ID *> relations_update_ids;
+
   /* Indicates which ID types were updated. */
   char id_type_updated[MAX_LIBARRAY];
 
@@ -167,6 +173,10 @@ struct Depsgraph {
    * created along with relations, for fast lookup during evaluation. */
   Map<const ID *, ListBase *> *physics_relations[DEG_PHYSICS_RELATIONS_NUM];
 
+  /* Per-thread memory for temporary data of evaluation functions, which is reset at the beginning
+   * of every evaluation instead of being freed. */
+  threading::EnumerableThreadSpecific<LinearAllocator<>> scratch_allocators;
+
   MEM_CXX_CLASS_ALLOC_FUNCS("Depsgraph");
 };
 
@@ -47,6 +47,7 @@
 #include "builder/pipeline_all_objects.h"
 #include "builder/pipeline_compositor.h"
 #include "builder/pipeline_from_ids.h"
+#include "builder/pipeline_incremental.h"
 #include "builder/pipeline_render.h"
 #include "builder/pipeline_view_layer.h"
 
@@ -263,8 +264,15 @@ void DEG_graph_relations_update(Depsgraph *graph)
 {
   deg::Depsgraph *deg_graph = (deg::Depsgraph *)graph;
   if (!deg_graph->need_update) {
-    /* Graph is up to date, nothing to do. */
-    return;
+    if (deg_graph->relations_update_ids.is_empty()) {
+      /* Graph is up to date, nothing to do. */
+      return;
+    }
+    if (deg::deg_graph_relations_update_incremental(deg_graph)) {
+      return;
+    }
+    /* Graph is possibly left in a partially updated state, build it from scratch. */
+    deg_graph->need_update = true;
   }
   DEG_graph_build_from_view_layer(graph);
 }
@@ -277,3 +285,19 @@ void DEG_relations_tag_update(Main *bmain)
     DEG_graph_tag_relations_update(reinterpret_cast<Depsgraph *>(depsgraph));
   }
 }
+
+/* Tag relations of the given ID for update. */
+void DEG_id_tag_relations_update(Main *bmain, ID *id)
+{
+  DEG_GLOBAL_DEBUG_PRINTF(TAG, "%s: Tagging relations of %s for update.\n", __func__, id->name);
+  for (deg::Depsgraph *depsgraph : deg::get_all_registered_graphs(bmain)) {
+    if (depsgraph->need_update) {
+      continue;
+    }
+    if (GS(id->name) != ID_OB || depsgraph->find_id_node(id) == nullptr) {
+      DEG_graph_tag_relations_update(reinterpret_cast<Depsgraph *>(depsgraph));
+      continue;
+    }
+    depsgraph->relations_update_ids.add(id);
+  }
+}
@@ -315,11 +315,24 @@ bool DEG_is_evaluated_object(const Object *object)
   return !DEG_is_original_object(object);
 }
 
+void *DEG_scratch_alloc(const Depsgraph *depsgraph, size_t size)
+{
+  /* Same alignment as guarded allocations. */
+  return DEG_get_scratch_allocator(depsgraph).allocate((int64_t)size, 16);
+}
+
+blender::LinearAllocator<> &DEG_get_scratch_allocator(const Depsgraph *depsgraph)
+{
+  deg::Depsgraph *deg_graph = const_cast<deg::Depsgraph *>(
+      reinterpret_cast<const deg::Depsgraph *>(depsgraph));
+  return deg_graph->scratch_allocators.local();
+}
+
 bool DEG_is_fully_evaluated(const struct Depsgraph *depsgraph)
 {
   const deg::Depsgraph *deg_graph = (const deg::Depsgraph *)depsgraph;
   /* Check whether relations are up to date. */
-  if (deg_graph->need_update) {
+  if (deg_graph->need_update || !deg_graph->relations_update_ids.is_empty()) {
     return false;
   }
   /* Check whether IDs are up to date. */
@@ -34,6 +34,7 @@
 #include "BKE_node.h"
 #include "BKE_object.h"
 
+#include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_utildefines.h"
 
@@ -178,6 +179,24 @@ bool deg_objects_dupli_iterator_next(BLI_Iterator *iter)
   return false;
 }
 
+/* Order instances by the geometry they instance. Resources of the draw manager are allocated in
+ * iteration order, keeping instances of the same geometry next to each other allows them to be
+ * merged into a single instanced draw call. */
+int deg_dupli_object_source_cmp(const void *a, const void *b)
+{
+  const DupliObject *dob_a = (const DupliObject *)a;
+  const DupliObject *dob_b = (const DupliObject *)b;
+  const uintptr_t data_a = (uintptr_t)dob_a->ob->data, data_b = (uintptr_t)dob_b->ob->data;
+  if (data_a != data_b) {
+    return (data_a < data_b) ? -1 : 1;
+  }
+  const uintptr_t ob_a = (uintptr_t)dob_a->ob, ob_b = (uintptr_t)dob_b->ob;
+  if (ob_a != ob_b) {
+    return (ob_a < ob_b) ? -1 : 1;
+  }
+  return 0;
+}
+
 void deg_iterator_objects_step(BLI_Iterator *iter, deg::IDNode *id_node)
 {
   /* Set it early in case we need to exit and we are running from within a loop. */
@@ -228,6 +247,9 @@ void deg_iterator_objects_step(BLI_Iterator *iter, deg::IDNode *id_node)
     if ((data->flag & DEG_ITER_OBJECT_FLAG_DUPLI) && (object->transflag & OB_DUPLI)) {
       data->dupli_parent = object;
       data->dupli_list = object_duplilist(data->graph, data->scene, object);
+      if (data->flag & DEG_ITER_OBJECT_FLAG_DUPLI_GROUPED) {
+        BLI_listbase_sort(data->dupli_list, deg_dupli_object_source_cmp);
+      }
       data->dupli_object_next = (DupliObject *)data->dupli_list->first;
     }
   }
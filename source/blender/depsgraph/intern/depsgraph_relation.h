@@ -25,6 +25,8 @@
 
 #include "MEM_guardedalloc.h"
 
+struct ID;
+
 namespace blender {
 namespace deg {
 
@@ -62,6 +64,11 @@ struct Relation {
   const char *name; /* label for debugging */
   int flag;         /* Bitmask of RelationFlag) */
 
+  /* Original ID which relations builder created this relation. Is nullptr when the relation is
+   * not created from within a specific ID builder, or when builders of multiple IDs requested the
+   * same relation. Allows to only re-derive relations of a specific ID. */
+  ID *owner_id;
+
   MEM_CXX_CLASS_ALLOC_FUNCS("Relation");
 };
 
@@ -25,12 +25,16 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include <algorithm>
+
 #include "PIL_time.h"
 
 #include "BLI_compiler_attrs.h"
 #include "BLI_gsqueue.h"
 #include "BLI_task.h"
+#include "BLI_timeit.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_global.h"
 
@@ -43,6 +47,7 @@
 
 #include "atomic_ops.h"
 
+#include "intern/builder/deg_builder_critical_path.h"
 #include "intern/depsgraph.h"
 #include "intern/depsgraph_relation.h"
 #include "intern/eval/deg_eval_copy_on_write.h"
@@ -68,9 +73,31 @@ void schedule_children(DepsgraphEvalState *state,
                        ScheduleFunction *schedule_function,
                        ScheduleFunctionArgs... schedule_function_args);
 
-void schedule_node_to_pool(OperationNode *node, const int UNUSED(thread_id), TaskPool *pool)
+/* Operations which became ready for evaluation, but are not pushed to the task pool yet. */
+using ReadyOperations = Vector<OperationNode *, 16>;
+
+void schedule_node_to_ready_list(OperationNode *node,
+                                 const int /*thread_id*/,
+                                 ReadyOperations *ready_operations)
+{
+  ready_operations->append(node);
+}
+
+/* Order operations so that the ones starting the most expensive chains come first. */
+void sort_by_critical_path(ReadyOperations &ready_operations)
 {
-  BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
+  std::sort(ready_operations.begin(),
+            ready_operations.end(),
+            [](const OperationNode *a, const OperationNode *b) {
+              return a->critical_path_cost > b->critical_path_cost;
+            });
+}
+
+void push_ready_operations_to_pool(TaskPool *pool, Span<OperationNode *> ready_operations)
+{
+  for (OperationNode *node : ready_operations) {
+    BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
+  }
 }
 
 /* Denotes which part of dependency graph is being evaluated. */
@@ -103,15 +130,15 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
 
   /* Sanity checks. */
   BLI_assert(!operation_node->is_noop() && "NOOP nodes should not actually be scheduled");
-  /* Perform operation. */
-  if (state->do_stats) {
-    const double start_time = PIL_check_seconds_timer();
-    operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += PIL_check_seconds_timer() - start_time;
-  }
-  else {
+  /* Perform operation. The timing is always measured, since it feeds the cost model which is
+   * used for scheduling. */
+  const double start_time = PIL_check_seconds_timer();
+  {
+    timeit::ScopedProfileZone profile_zone(operationCodeAsString(operation_node->opcode),
+                                           operation_node->owner->owner->name.c_str());
     operation_node->evaluate(depsgraph);
   }
+  operation_node->stats.current_time += PIL_check_seconds_timer() - start_time;
 }
 
 void deg_task_run_func(TaskPool *pool, void *taskdata)
@@ -119,12 +146,22 @@ void deg_task_run_func(TaskPool *pool, void *taskdata)
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
+  ReadyOperations ready_operations;
   OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
-  evaluate_node(state, operation_node);
+  while (operation_node != nullptr) {
+    evaluate_node(state, operation_node);
 
-  /* Schedule children. */
-  schedule_children(state, operation_node, schedule_node_to_pool, pool);
+    /* Schedule children. The one which starts the most expensive chain is evaluated right away by
+     * this thread, others are pushed to the pool where idle threads can steal them. */
+    schedule_children(state, operation_node, schedule_node_to_ready_list, &ready_operations);
+    if (ready_operations.is_empty()) {
+      break;
+    }
+    sort_by_critical_path(ready_operations);
+    operation_node = ready_operations[0];
+    push_ready_operations_to_pool(pool, ready_operations.as_span().drop_front(1));
+    ready_operations.clear();
+  }
 }
 
 bool check_operation_node_visible(OperationNode *op_node)
@@ -177,15 +214,12 @@ void calculate_pending_parents(Depsgraph *graph)
   }
 }
 
-void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
+void initialize_execution(DepsgraphEvalState * /*state*/, Depsgraph *graph)
 {
-  const bool do_stats = state->do_stats;
   calculate_pending_parents(graph);
   /* Clear tags and other things which needs to be clear. */
   for (OperationNode *node : graph->operations) {
-    if (do_stats) {
-      node->stats.reset_current();
-    }
+    node->stats.reset_current();
   }
 }
 
@@ -313,6 +347,15 @@ void schedule_node_to_queue(OperationNode *node,
   BLI_gsqueue_push(evaluation_queue, &node);
 }
 
+void evaluate_graph_threaded(DepsgraphEvalState *state, TaskPool *task_pool)
+{
+  ReadyOperations ready_operations;
+  schedule_graph(state, schedule_node_to_ready_list, &ready_operations);
+  sort_by_critical_path(ready_operations);
+  push_ready_operations_to_pool(task_pool, ready_operations);
+  BLI_task_pool_work_and_wait(task_pool);
+}
+
 void evaluate_graph_single_threaded(DepsgraphEvalState *state)
 {
   GSQueue *evaluation_queue = BLI_gsqueue_new(sizeof(OperationNode *));
@@ -371,6 +414,10 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   }
 
   graph->debug.begin_graph_evaluation();
+  SCOPED_PROFILE_ZONE("Depsgraph Evaluation");
+
+  /* Scratch memory of the previous evaluation is not used anymore. */
+  graph->scratch_allocators.foreach_value([](LinearAllocator<> &allocator) { allocator.reset(); });
 
   graph->is_evaluating = true;
   depsgraph_ensure_view_layer(graph);
@@ -386,15 +433,13 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   /* First, process all Copy-On-Write nodes. */
   state.stage = EvaluationStage::COPY_ON_WRITE;
   TaskPool *task_pool = deg_evaluate_task_pool_create(&state);
-  schedule_graph(&state, schedule_node_to_pool, task_pool);
-  BLI_task_pool_work_and_wait(task_pool);
+  evaluate_graph_threaded(&state, task_pool);
   BLI_task_pool_free(task_pool);
 
   /* After that, process all other nodes. */
   state.stage = EvaluationStage::THREADED_EVALUATION;
   task_pool = deg_evaluate_task_pool_create(&state);
-  schedule_graph(&state, schedule_node_to_pool, task_pool);
-  BLI_task_pool_work_and_wait(task_pool);
+  evaluate_graph_threaded(&state, task_pool);
   BLI_task_pool_free(task_pool);
 
   if (state.need_single_thread_pass) {
@@ -408,6 +453,10 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
   }
+  /* Update the cost model with the new timing, so the next evaluation is scheduled according to
+   * the most recent knowledge about expensive operations. */
+  deg_eval_stats_accumulate(graph);
+  deg_graph_calculate_critical_paths(graph);
   /* Clear any uncleared tags - just in case. */
   deg_graph_clear_tags(graph);
   graph->is_evaluating = false;
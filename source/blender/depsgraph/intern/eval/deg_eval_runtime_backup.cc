@@ -34,6 +34,7 @@ namespace blender::deg {
 RuntimeBackup::RuntimeBackup(const Depsgraph *depsgraph)
     : have_backup(false),
       animation_backup(depsgraph),
+      mesh_backup(depsgraph),
       scene_backup(depsgraph),
       sound_backup(depsgraph),
       object_backup(depsgraph),
@@ -58,6 +59,9 @@ void RuntimeBackup::init_from_id(ID *id)
     case ID_OB:
       object_backup.init_from_object(reinterpret_cast<Object *>(id));
       break;
+    case ID_ME:
+      mesh_backup.init_from_mesh(reinterpret_cast<Mesh *>(id));
+      break;
     case ID_SCE:
       scene_backup.init_from_scene(reinterpret_cast<Scene *>(id));
       break;
@@ -96,6 +100,9 @@ void RuntimeBackup::restore_to_id(ID *id)
     case ID_OB:
       object_backup.restore_to_object(reinterpret_cast<Object *>(id));
       break;
+    case ID_ME:
+      mesh_backup.restore_to_mesh(reinterpret_cast<Mesh *>(id));
+      break;
     case ID_SCE:
       scene_backup.restore_to_scene(reinterpret_cast<Scene *>(id));
       break;
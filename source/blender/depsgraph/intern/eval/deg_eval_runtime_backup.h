@@ -26,6 +26,7 @@
 #include "DNA_ID.h"
 
 #include "intern/eval/deg_eval_runtime_backup_animation.h"
+#include "intern/eval/deg_eval_runtime_backup_mesh.h"
 #include "intern/eval/deg_eval_runtime_backup_movieclip.h"
 #include "intern/eval/deg_eval_runtime_backup_object.h"
 #include "intern/eval/deg_eval_runtime_backup_scene.h"
@@ -59,6 +60,7 @@ class RuntimeBackup {
   bool have_backup;
 
   AnimationBackup animation_backup;
+  MeshBackup mesh_backup;
   SceneBackup scene_backup;
   SoundBackup sound_backup;
   ObjectRuntimeBackup object_backup;
@@ -0,0 +1,59 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/eval/deg_eval_runtime_backup_mesh.h"
+
+#include "BLI_utildefines.h"
+
+#include "DNA_mesh_types.h"
+
+namespace blender::deg {
+
+MeshBackup::MeshBackup(const Depsgraph * /*depsgraph*/) : batch_cache(nullptr)
+{
+}
+
+void MeshBackup::init_from_mesh(Mesh *mesh)
+{
+  /* Outside of edit mode the evaluated mesh owns the batch cache which is used for drawing. */
+  if (mesh->edit_mesh == nullptr) {
+    return;
+  }
+  batch_cache = mesh->runtime.batch_cache;
+  mesh->runtime.batch_cache = nullptr;
+}
+
+void MeshBackup::restore_to_mesh(Mesh *mesh)
+{
+  if (batch_cache == nullptr) {
+    return;
+  }
+  /* The cache is validated by the draw manager: it is tagged dirty by the geometry evaluation
+   * and discarded when the mesh left edit mode. */
+  BLI_assert(mesh->runtime.batch_cache == nullptr);
+  mesh->runtime.batch_cache = batch_cache;
+  batch_cache = nullptr;
+}
+
+}  // namespace blender::deg
@@ -0,0 +1,48 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#pragma once
+
+struct Mesh;
+
+namespace blender {
+namespace deg {
+
+struct Depsgraph;
+
+/* Backup of mesh datablocks runtime data. */
+class MeshBackup {
+ public:
+  MeshBackup(const Depsgraph *depsgraph);
+
+  void init_from_mesh(Mesh *mesh);
+  void restore_to_mesh(Mesh *mesh);
+
+  /* GPU batch cache of a mesh in edit mode. Kept so that coordinate-only updates (transform)
+   * can re-use the buffers which only depend on the topology. */
+  void *batch_cache;
+};
+
+}  // namespace deg
+}  // namespace blender
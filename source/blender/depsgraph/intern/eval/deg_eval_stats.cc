@@ -54,4 +54,14 @@ void deg_eval_stats_aggregate(Depsgraph *graph)
   }
 }
 
+void deg_eval_stats_accumulate(Depsgraph *graph)
+{
+  for (OperationNode *op_node : graph->operations) {
+    if (!op_node->scheduled || op_node->is_noop()) {
+      continue;
+    }
+    op_node->stats.accumulate_current();
+  }
+}
+
 }  // namespace blender::deg
@@ -31,5 +31,9 @@ struct Depsgraph;
 /* Aggregate operation timings to overall component and ID nodes timing. */
 void deg_eval_stats_aggregate(Depsgraph *graph);
 
+/* Accumulate timing of operations evaluated by the current graph evaluation into their running
+ * averages, which are kept for the whole lifetime of the graph. */
+void deg_eval_stats_accumulate(Depsgraph *graph);
+
 }  // namespace deg
 }  // namespace blender
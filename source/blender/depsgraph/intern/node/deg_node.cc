@@ -278,6 +278,8 @@ Node::Stats::Stats()
 void Node::Stats::reset()
 {
   current_time = 0.0;
+  average_time = 0.0;
+  num_evaluations = 0;
 }
 
 void Node::Stats::reset_current()
@@ -285,6 +287,20 @@ void Node::Stats::reset_current()
   current_time = 0.0;
 }
 
+void Node::Stats::accumulate_current()
+{
+  /* Weight of the most recent evaluation. Is high enough to react to changes in the scene within
+   * a couple of frames, and low enough to smooth out noise caused by threading. */
+  const double factor = 0.2;
+  if (num_evaluations == 0) {
+    average_time = current_time;
+  }
+  else {
+    average_time += (current_time - average_time) * factor;
+  }
+  ++num_evaluations;
+}
+
 /*******************************************************************************
  * Node itself.
  */
@@ -161,8 +161,16 @@ struct Node {
     /* Reset counters needed for the current graph evaluation, does not
      * touch averaging accumulators. */
     void reset_current();
+    /* Accumulate time of the current graph evaluation into the running average. Is to be called
+     * only for nodes which were actually evaluated. */
+    void accumulate_current();
     /* Time spend on this node during current graph evaluation. */
     double current_time;
+    /* Exponential moving average of the time spent on this node, over all evaluations of the
+     * node during the current session. */
+    double average_time;
+    /* Number of evaluations which contributed to the average time. */
+    int num_evaluations;
   };
   /* Relationships between nodes
    * The reason why all depsgraph nodes are descended from this type (apart
@@ -289,6 +289,11 @@ OperationNode *ComponentNode::get_exit_operation()
 
 void ComponentNode::finalize_build(Depsgraph * /*graph*/)
 {
+  /* Operations were already collected by a previous build, which happens when only relations of
+   * the graph are updated. */
+  if (operations_map == nullptr) {
+    return;
+  }
   operations.reserve(operations_map->size());
   for (OperationNode *op_node : operations_map->values()) {
     operations.append(op_node);
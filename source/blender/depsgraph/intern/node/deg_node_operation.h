@@ -266,6 +266,11 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Estimated cost of the most expensive chain of operations which starts at this operation,
+   * including the operation itself. Operations with higher cost are evaluated first, so that
+   * long dependency chains do not leave other threads idle at the end of evaluation. */
+  float critical_path_cost;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
@@ -291,6 +291,8 @@ static void eevee_object_data_init(DrawData *dd)
   eevee_data->shadow_caster_id = -1;
   eevee_data->need_update = false;
   eevee_data->geom_update = false;
+  eevee_data->lightcache_update = false;
+  eevee_data->lightcache_bounds_valid = false;
 }
 
 EEVEE_ObjectEngineData *EEVEE_object_data_get(Object *ob)
@@ -123,9 +123,11 @@ void EEVEE_cache_populate(void *vedata, Object *ob)
   if (DRW_object_is_renderable(ob) && (ob_visibility & OB_VISIBLE_SELF)) {
     if (ELEM(ob->type, OB_MESH, OB_CURVE, OB_SURF, OB_FONT, OB_MBALL)) {
       EEVEE_materials_cache_populate(vedata, sldata, ob, &cast_shadow);
+      EEVEE_lightprobes_object_update(sldata, ob);
     }
     else if (ob->type == OB_HAIR) {
       EEVEE_object_hair_cache_populate(vedata, sldata, ob, &cast_shadow);
+      EEVEE_lightprobes_object_update(sldata, ob);
     }
     else if (ob->type == OB_VOLUME) {
       EEVEE_volumes_cache_object_add(sldata, vedata, draw_ctx->scene, ob);
@@ -392,6 +394,9 @@ static void eevee_id_object_update(void *UNUSED(vedata), Object *object)
   if (oedata != NULL && oedata->dd.recalc != 0) {
     oedata->need_update = true;
     oedata->geom_update = (oedata->dd.recalc & (ID_RECALC_GEOMETRY)) != 0;
+    if (oedata->dd.recalc & (ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY)) {
+      oedata->lightcache_update = true;
+    }
     oedata->dd.recalc = 0;
   }
 }
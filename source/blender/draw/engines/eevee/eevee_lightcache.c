@@ -26,6 +26,7 @@
 
 #include "BKE_global.h"
 
+#include "BLI_bitmap.h"
 #include "BLI_endian_switch.h"
 #include "BLI_threads.h"
 
@@ -152,6 +153,19 @@ typedef struct EEVEE_LightBake {
   /** Pointer to the owner_id of the probe object. */
   LightProbe **cube_prb;
 
+  /* Partial update */
+  /** Only render the probes that changed or that influence the dirty bounds. */
+  bool do_partial;
+  /** World space bounds of the changes since the last bake. */
+  float dirty_min[3], dirty_max[3];
+  /** Probes data of the last bake, to find the probes that changed. */
+  EEVEE_LightGrid *grid_data_old;
+  EEVEE_LightProbe *cube_data_old;
+  /** Probes to render, the others keep the result of the last bake. */
+  BLI_bitmap *grid_dirty, *cube_dirty;
+  /** Last grid and cube to render. */
+  int grid_last, cube_last;
+
   /* Dummy Textures */
   struct GPUTexture *dummy_color, *dummy_depth;
   struct GPUTexture *dummy_layer_color;
@@ -290,6 +304,22 @@ void EEVEE_lightcache_info_update(SceneEEVEE *eevee)
   }
 }
 
+/* Tag the part of the scene that changed since the last bake. Only the probes influencing it are
+ * re-baked, unless a full update is already pending. */
+void EEVEE_lightcache_tag_region(LightCache *lcache, const float min[3], const float max[3])
+{
+  if ((lcache->flag & LIGHTCACHE_UPDATE_REGION) == 0) {
+    if (lcache->flag &
+        (LIGHTCACHE_UPDATE_WORLD | LIGHTCACHE_UPDATE_GRID | LIGHTCACHE_UPDATE_CUBE)) {
+      return;
+    }
+    lcache->flag |= LIGHTCACHE_UPDATE_REGION;
+    INIT_MINMAX(lcache->dirty_min, lcache->dirty_max);
+  }
+  minmax_v3v3_v3(lcache->dirty_min, lcache->dirty_max, min);
+  minmax_v3v3_v3(lcache->dirty_min, lcache->dirty_max, max);
+}
+
 static void irradiance_pool_size_get(int visibility_size, int total_samples, int r_size[3])
 {
   /* Compute how many irradiance samples we can store per visibility sample. */
@@ -725,8 +755,26 @@ static void eevee_lightbake_create_resources(EEVEE_LightBake *lbake)
 
   EEVEE_lightcache_load(eevee->light_cache_data);
 
-  lbake->lcache->flag |= LIGHTCACHE_BAKING;
-  lbake->lcache->cube_len = 1;
+  LightCache *lcache = lbake->lcache;
+  /* A new cache or a world update needs every probe to be rendered. Otherwise keep the data
+   * of the last bake to only render the probes affected by the changes. */
+  lbake->do_partial = !lbake->own_light_cache && (lcache->flag & LIGHTCACHE_UPDATE_REGION) &&
+                      (lcache->flag & LIGHTCACHE_UPDATE_WORLD) == 0;
+  if (lbake->do_partial) {
+    lbake->grid_data_old = MEM_dupallocN(lcache->grid_data);
+    lbake->cube_data_old = MEM_dupallocN(lcache->cube_data);
+    copy_v3_v3(lbake->dirty_min, lcache->dirty_min);
+    copy_v3_v3(lbake->dirty_max, lcache->dirty_max);
+    /* Start gathering the changes for the next update. */
+    INIT_MINMAX(lcache->dirty_min, lcache->dirty_max);
+  }
+  else {
+    lcache->flag &= ~LIGHTCACHE_UPDATE_REGION;
+  }
+
+  lcache->flag |= LIGHTCACHE_BAKING;
+  /* The cube-maps of the last bake remain valid for a partial update. */
+  lcache->cube_len = lbake->do_partial ? lbake->cube_len : 1;
 }
 
 wmJob *EEVEE_lightbake_job_create(struct wmWindowManager *wm,
@@ -838,6 +886,10 @@ void EEVEE_lightbake_job_data_free(void *custom_data)
 
   MEM_SAFE_FREE(lbake->cube_prb);
   MEM_SAFE_FREE(lbake->grid_prb);
+  MEM_SAFE_FREE(lbake->grid_data_old);
+  MEM_SAFE_FREE(lbake->cube_data_old);
+  MEM_SAFE_FREE(lbake->grid_dirty);
+  MEM_SAFE_FREE(lbake->cube_dirty);
 
   BLI_mutex_free(lbake->mutex);
 
@@ -1116,8 +1168,8 @@ static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
   LightCache *lcache = scene_eval->eevee.light_cache_data;
   int grid_loc[3], sample_id, sample_offset, stride;
   float pos[3];
-  const bool is_last_bounce_sample = ((egrid->offset + lbake->grid_sample) ==
-                                      (lbake->total_irr_samples - 1));
+  const bool is_last_bounce_sample = ((lbake->grid_curr == lbake->grid_last) &&
+                                      (lbake->grid_sample == lbake->grid_sample_len - 1));
 
   /* No bias for rendering the probe. */
   egrid->level_bias = 1.0f;
@@ -1183,8 +1235,7 @@ static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
   }
 
   /* If it is the last sample grid sample (and last bounce). */
-  if ((lbake->bounce_curr == lbake->bounce_len - 1) && (lbake->grid_curr == lbake->grid_len - 1) &&
-      (lbake->grid_sample == lbake->grid_sample_len - 1)) {
+  if ((lbake->bounce_curr == lbake->bounce_len - 1) && is_last_bounce_sample) {
     lcache->flag &= ~LIGHTCACHE_UPDATE_GRID;
   }
 }
@@ -1226,10 +1277,10 @@ static void eevee_lightbake_render_probe_sample(void *ved, void *user_data)
                                 filter_quality,
                                 clamp);
 
-  lcache->cube_len += 1;
+  lcache->cube_len = max_ii(lcache->cube_len, lbake->cube_offset + 1);
 
   /* If it's the last probe. */
-  if (lbake->cube_offset == lbake->cube_len - 1) {
+  if (lbake->cube_offset == lbake->cube_last) {
     lcache->flag &= ~LIGHTCACHE_UPDATE_CUBE;
   }
 }
@@ -1321,10 +1372,147 @@ static void eevee_lightbake_gather_probes(EEVEE_LightBake *lbake)
              lbake->cube_len - 1,
              eevee_lightbake_cube_comp);
 
-  lbake->total = lbake->total_irr_samples * lbake->bounce_len + lbake->cube_len;
   lbake->done = 0;
 }
 
+/* World space bounds of a box of half size `extent` in the space of `world_to_local`. */
+static void eevee_lightbake_influence_bounds(const float world_to_local[4][4],
+                                             const float extent,
+                                             float r_min[3],
+                                             float r_max[3])
+{
+  float local_to_world[4][4];
+  if (!invert_m4_m4(local_to_world, world_to_local)) {
+    /* Degenerate probe, assume it is influenced by anything. */
+    copy_v3_fl(r_min, -FLT_MAX);
+    copy_v3_fl(r_max, FLT_MAX);
+    return;
+  }
+
+  INIT_MINMAX(r_min, r_max);
+  for (int i = 0; i < 8; i++) {
+    float co[3] = {
+        (i & 1) ? extent : -extent,
+        (i & 2) ? extent : -extent,
+        (i & 4) ? extent : -extent,
+    };
+    mul_m4_v3(local_to_world, co);
+    minmax_v3v3_v3(r_min, r_max, co);
+  }
+}
+
+static void eevee_lightbake_grid_influence_bounds(const EEVEE_LightGrid *egrid,
+                                                  float r_min[3],
+                                                  float r_max[3])
+{
+  /* The attenuation reaches zero at the influence distance outside of the grid. */
+  const float distinf = egrid->attenuation_bias / max_ff(1e-8f, egrid->attenuation_scale);
+  eevee_lightbake_influence_bounds(egrid->mat, 1.0f + distinf, r_min, r_max);
+}
+
+static void eevee_lightbake_cube_influence_bounds(const EEVEE_LightProbe *eprobe,
+                                                  float r_min[3],
+                                                  float r_max[3])
+{
+  eevee_lightbake_influence_bounds(eprobe->attenuationmat, 1.0f, r_min, r_max);
+}
+
+static bool eevee_lightbake_grid_data_equals(const EEVEE_LightGrid *grid_a,
+                                             const EEVEE_LightGrid *grid_b)
+{
+  /* The level bias is only used for the progressive display while baking. */
+  EEVEE_LightGrid grid_tmp = *grid_b;
+  grid_tmp.level_bias = grid_a->level_bias;
+  return memcmp(grid_a, &grid_tmp, sizeof(grid_tmp)) == 0;
+}
+
+/* Find the probes to render. For a partial update these are the probes that changed and the
+ * ones whose influence intersects the dirty bounds. Cube-maps also see the irradiance grids, so
+ * they are re-rendered if they intersect a grid that is. */
+static void eevee_lightbake_tag_dirty_probes(EEVEE_LightBake *lbake)
+{
+  LightCache *lcache = lbake->lcache;
+  float min[3], max[3];
+
+  lbake->grid_dirty = BLI_BITMAP_NEW(lbake->grid_len, "EEVEE Grid dirty");
+  lbake->cube_dirty = BLI_BITMAP_NEW(lbake->cube_len, "EEVEE Cube dirty");
+  lbake->grid_last = lbake->cube_last = 0;
+  lbake->total = 0;
+
+  /* Bypass world, start at 1. */
+  for (int i = 1; i < lbake->grid_len; i++) {
+    const EEVEE_LightGrid *egrid = &lcache->grid_data[i];
+    eevee_lightbake_grid_influence_bounds(egrid, min, max);
+    if (!lbake->do_partial || !eevee_lightbake_grid_data_equals(egrid, &lbake->grid_data_old[i]) ||
+        isect_aabb_aabb_v3(min, max, lbake->dirty_min, lbake->dirty_max)) {
+      BLI_BITMAP_ENABLE(lbake->grid_dirty, i);
+      lbake->grid_last = i;
+      lbake->total += egrid->resolution[0] * egrid->resolution[1] * egrid->resolution[2] *
+                      lbake->bounce_len;
+    }
+  }
+
+  for (int i = 1; i < lbake->cube_len; i++) {
+    const EEVEE_LightProbe *eprobe = &lcache->cube_data[i];
+    eevee_lightbake_cube_influence_bounds(eprobe, min, max);
+    bool is_dirty = !lbake->do_partial ||
+                    memcmp(eprobe, &lbake->cube_data_old[i], sizeof(*eprobe)) != 0 ||
+                    isect_aabb_aabb_v3(min, max, lbake->dirty_min, lbake->dirty_max);
+    for (int j = 1; j < lbake->grid_len && !is_dirty; j++) {
+      if (BLI_BITMAP_TEST(lbake->grid_dirty, j)) {
+        float grid_min[3], grid_max[3];
+        eevee_lightbake_grid_influence_bounds(&lcache->grid_data[j], grid_min, grid_max);
+        is_dirty = isect_aabb_aabb_v3(min, max, grid_min, grid_max);
+      }
+    }
+    if (is_dirty) {
+      BLI_BITMAP_ENABLE(lbake->cube_dirty, i);
+      lbake->cube_last = i;
+      lbake->total += 1;
+    }
+  }
+
+  if (!lbake->do_partial) {
+    /* World probe. */
+    lbake->total += 1;
+  }
+  lbake->total = max_ii(lbake->total, 1);
+}
+
+/* The job was stopped before the end of a partial update: make sure the next update renders
+ * the probes that were not done yet. */
+static void eevee_lightbake_partial_update_cancel(EEVEE_LightBake *lbake)
+{
+  LightCache *lcache = lbake->lcache;
+  float min[3], max[3];
+
+  if ((lcache->flag & LIGHTCACHE_UPDATE_REGION) == 0) {
+    /* A full update was requested in the meantime. */
+    return;
+  }
+
+  minmax_v3v3_v3(lcache->dirty_min, lcache->dirty_max, lbake->dirty_min);
+  minmax_v3v3_v3(lcache->dirty_min, lcache->dirty_max, lbake->dirty_max);
+
+  /* The probes data is already updated in the cache, so add their influence to the region. */
+  for (int i = 1; i < lbake->grid_len; i++) {
+    if (BLI_BITMAP_TEST(lbake->grid_dirty, i)) {
+      eevee_lightbake_grid_influence_bounds(&lcache->grid_data[i], min, max);
+      minmax_v3v3_v3(lcache->dirty_min, lcache->dirty_max, min);
+      minmax_v3v3_v3(lcache->dirty_min, lcache->dirty_max, max);
+    }
+  }
+  for (int i = 1; i < lbake->cube_len; i++) {
+    if (BLI_BITMAP_TEST(lbake->cube_dirty, i)) {
+      eevee_lightbake_cube_influence_bounds(&lcache->cube_data[i], min, max);
+      minmax_v3v3_v3(lcache->dirty_min, lcache->dirty_max, min);
+      minmax_v3v3_v3(lcache->dirty_min, lcache->dirty_max, max);
+    }
+  }
+
+  lcache->flag |= LIGHTCACHE_UPDATE_GRID | LIGHTCACHE_UPDATE_CUBE;
+}
+
 void EEVEE_lightbake_update(void *custom_data)
 {
   EEVEE_LightBake *lbake = (EEVEE_LightBake *)custom_data;
@@ -1406,6 +1594,7 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
 
   /* Gather all probes data */
   eevee_lightbake_gather_probes(lbake);
+  eevee_lightbake_tag_dirty_probes(lbake);
 
   LightCache *lcache = lbake->lcache;
 
@@ -1431,6 +1620,9 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
       lbake->grid = lcache->grid_data + 1;
       for (lbake->grid_curr = 1; lbake->grid_curr < lbake->grid_len;
            lbake->grid_curr++, lbake->probe++, lbake->grid++) {
+        if (!BLI_BITMAP_TEST(lbake->grid_dirty, lbake->grid_curr)) {
+          continue;
+        }
         LightProbe *prb = *lbake->probe;
         lbake->grid_sample_len = prb->grid_resolution_x * prb->grid_resolution_y *
                                  prb->grid_resolution_z;
@@ -1449,10 +1641,22 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
     lbake->cube = lcache->cube_data + 1;
     for (lbake->cube_offset = 1; lbake->cube_offset < lbake->cube_len;
          lbake->cube_offset++, lbake->probe++, lbake->cube++) {
-      lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample);
+      if (BLI_BITMAP_TEST(lbake->cube_dirty, lbake->cube_offset)) {
+        lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample);
+      }
     }
   }
 
+  if (G.is_break == true || *lbake->stop) {
+    if (lbake->do_partial) {
+      eevee_lightbake_partial_update_cancel(lbake);
+    }
+  }
+  else {
+    /* Also clear the tags when there was nothing to render. */
+    lcache->flag &= ~(LIGHTCACHE_UPDATE_GRID | LIGHTCACHE_UPDATE_CUBE);
+  }
+
   /* Read the resulting lighting data to save it to file/disk. */
   eevee_lightbake_context_enable(lbake);
   eevee_lightbake_readback_irradiance(lcache);
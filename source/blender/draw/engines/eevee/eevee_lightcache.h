@@ -63,6 +63,9 @@ struct LightCache *EEVEE_lightcache_create(const int grid_len,
 void EEVEE_lightcache_free(struct LightCache *lcache);
 bool EEVEE_lightcache_load(struct LightCache *lcache);
 void EEVEE_lightcache_info_update(struct SceneEEVEE *eevee);
+void EEVEE_lightcache_tag_region(struct LightCache *lcache,
+                                 const float min[3],
+                                 const float max[3]);
 
 void EEVEE_lightcache_blend_write(struct BlendWriter *writer, struct LightCache *cache);
 void EEVEE_lightcache_blend_read_data(struct BlendDataReader *reader, struct LightCache *cache);
@@ -331,6 +331,8 @@ void EEVEE_lightprobes_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedat
   pinfo->vis_data.collection = NULL;
   pinfo->do_grid_update = false;
   pinfo->do_cube_update = false;
+  pinfo->do_region_update = false;
+  INIT_MINMAX(pinfo->region_min, pinfo->region_max);
 
   {
     DRW_PASS_CREATE(psl->probe_background, DRW_STATE_WRITE_COLOR | DRW_STATE_DEPTH_EQUAL);
@@ -511,6 +513,48 @@ void EEVEE_lightprobes_cache_add(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata
   }
 }
 
+/* Grow the region to re-bake with the previous and current bounds of an object that moved or
+ * changed shape. Only the probes influencing this region are updated by the auto-bake. */
+void EEVEE_lightprobes_object_update(EEVEE_ViewLayerData *sldata, Object *ob)
+{
+  if (ob->base_flag & BASE_FROM_DUPLI) {
+    /* TODO: Special case for dupli objects because we cannot save the object pointer. */
+    return;
+  }
+
+  EEVEE_ObjectEngineData *oedata = EEVEE_object_data_ensure(ob);
+  if (oedata->lightcache_bounds_valid && !oedata->lightcache_update) {
+    return;
+  }
+
+  BoundBox *bb = BKE_object_boundbox_get(ob);
+  if (bb == NULL) {
+    return;
+  }
+
+  float min[3], max[3];
+  INIT_MINMAX(min, max);
+  for (int i = 0; i < 8; i++) {
+    float vec[3];
+    mul_v3_m4v3(vec, ob->obmat, bb->vec[i]);
+    minmax_v3v3_v3(min, max, vec);
+  }
+
+  if (oedata->lightcache_bounds_valid) {
+    EEVEE_LightProbesInfo *pinfo = sldata->probes;
+    minmax_v3v3_v3(pinfo->region_min, pinfo->region_max, oedata->lightcache_bounds[0]);
+    minmax_v3v3_v3(pinfo->region_min, pinfo->region_max, oedata->lightcache_bounds[1]);
+    minmax_v3v3_v3(pinfo->region_min, pinfo->region_max, min);
+    minmax_v3v3_v3(pinfo->region_min, pinfo->region_max, max);
+    pinfo->do_region_update = true;
+  }
+
+  copy_v3_v3(oedata->lightcache_bounds[0], min);
+  copy_v3_v3(oedata->lightcache_bounds[1], max);
+  oedata->lightcache_bounds_valid = true;
+  oedata->lightcache_update = false;
+}
+
 void EEVEE_lightprobes_grid_data_from_object(Object *ob, EEVEE_LightGrid *egrid, int *offset)
 {
   LightProbe *probe = (LightProbe *)ob->data;
@@ -746,13 +790,17 @@ void EEVEE_lightprobes_cache_finish(EEVEE_ViewLayerData *sldata, EEVEE_Data *ved
   /* If light-cache auto-update is enable we tag the relevant part
    * of the cache to update and fire up a baking job. */
   if (!DRW_state_is_image_render() && !DRW_state_is_opengl_render() &&
-      (pinfo->do_grid_update || pinfo->do_cube_update)) {
+      (pinfo->do_grid_update || pinfo->do_cube_update || pinfo->do_region_update)) {
     BLI_assert(draw_ctx->evil_C);
 
     if (draw_ctx->scene->eevee.flag & SCE_EEVEE_GI_AUTOBAKE) {
       Scene *scene_orig = DEG_get_input_scene(draw_ctx->depsgraph);
       if (scene_orig->eevee.light_cache_data != NULL) {
-        if (pinfo->do_grid_update) {
+        /* Only re-bake the probes influenced by the changed objects. The baking job also
+         * detects the probes that were moved or edited themselves. */
+        EEVEE_lightcache_tag_region(
+            scene_orig->eevee.light_cache_data, pinfo->region_min, pinfo->region_max);
+        if (pinfo->do_grid_update || pinfo->do_region_update) {
           scene_orig->eevee.light_cache_data->flag |= LIGHTCACHE_UPDATE_GRID;
         }
         /* If we update grid we need to update the cube-maps too.
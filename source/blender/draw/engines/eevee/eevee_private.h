@@ -474,6 +474,8 @@ typedef struct EEVEE_ShadowCascadeRender {
   float cascade_exponent;
   float cascade_fade;
   int cascade_count;
+  /* World->Light->NDC of the last render, to skip it if nothing changed. */
+  float rendered_persmat[MAX_CASCADE_NUM][4][4];
 } EEVEE_ShadowCascadeRender;
 
 BLI_STATIC_ASSERT_ALIGN(EEVEE_Light, 16)
@@ -502,6 +504,9 @@ typedef struct EEVEE_LightsInfo {
   int num_cascade_layer, cache_num_cascade_layer;
   int cube_len, cascade_len, shadow_len;
   int shadow_cube_size, shadow_cascade_size;
+  /* Resolution of the cube-maps in the pool, can be lower than the scene setting to fit the
+   * memory budget. */
+  int shadow_cube_pool_size;
   bool shadow_high_bitdepth, soft_shadows;
   /* UBO Storage : data used by UBO */
   struct EEVEE_Light light_data[MAX_LIGHT];
@@ -515,6 +520,10 @@ typedef struct EEVEE_LightsInfo {
   uchar shadow_cascade_light_indices[MAX_SHADOW_CASCADE];
   /* Update bitmap. */
   BLI_bitmap sh_cube_update[BLI_BITMAP_SIZE(MAX_SHADOW_CUBE)];
+  /* Faces to update if the whole cube-map does not need to. */
+  BLI_bitmap sh_cube_face_update[BLI_BITMAP_SIZE(MAX_SHADOW_CUBE * 6)];
+  /* The cascade pool was re-allocated and all cascades need to be rendered. */
+  bool sh_cascade_update;
   /* Lights tracking */
   struct BoundSphere shadow_bounds[MAX_LIGHT]; /* Tightly packed light bounds  */
   /* List of bbox and update bitmap. Double buffered. */
@@ -545,6 +554,9 @@ typedef struct EEVEE_LightProbesInfo {
   /* Update */
   bool do_cube_update;
   bool do_grid_update;
+  /** Bounds of the objects that moved or changed shape, see #EEVEE_lightprobes_object_update. */
+  bool do_region_update;
+  float region_min[3], region_max[3];
   /* For rendering probes */
   float probemat[6][4][4];
   int layer;
@@ -898,6 +910,10 @@ typedef struct EEVEE_ObjectEngineData {
   bool need_update;
   bool geom_update;
   uint shadow_caster_id;
+  /* Light cache auto-update: world space bounds the last time the probes were tagged. */
+  bool lightcache_update;
+  bool lightcache_bounds_valid;
+  float lightcache_bounds[2][3];
 } EEVEE_ObjectEngineData;
 
 typedef struct EEVEE_WorldEngineData {
@@ -1049,6 +1065,8 @@ void eevee_contact_shadow_setup(const Light *la, EEVEE_Shadow *evsh);
 void EEVEE_shadows_init(EEVEE_ViewLayerData *sldata);
 void EEVEE_shadows_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
 void EEVEE_shadows_caster_register(EEVEE_ViewLayerData *sldata, struct Object *ob);
+bool EEVEE_shadows_caster_updated_in_volume(const EEVEE_LightsInfo *linfo,
+                                            const float persmat[4][4]);
 void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
 void EEVEE_shadows_cube_add(EEVEE_LightsInfo *linfo, EEVEE_Light *evli, struct Object *ob);
 bool EEVEE_shadows_cube_setup(EEVEE_LightsInfo *linfo, const EEVEE_Light *evli, int sample_ofs);
@@ -1153,6 +1171,7 @@ bool EEVEE_lightprobes_obj_visibility_cb(bool vis_in, void *user_data);
 void EEVEE_lightprobes_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
 void EEVEE_lightprobes_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
 void EEVEE_lightprobes_cache_add(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata, Object *ob);
+void EEVEE_lightprobes_object_update(EEVEE_ViewLayerData *sldata, Object *ob);
 void EEVEE_lightprobes_cache_finish(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
 void EEVEE_lightprobes_refresh(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
 void EEVEE_lightprobes_refresh_planar(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
@@ -30,6 +30,9 @@
 #include "eevee_private.h"
 
 #define SH_CASTER_ALLOC_CHUNK 32
+/* Memory budget of the cube-map pool, the resolution is lowered to fit. */
+#define SHADOW_CUBE_POOL_MAX_BYTES ((int64_t)1 << 30)
+#define SHADOW_CUBE_MIN_SIZE 64
 
 void eevee_contact_shadow_setup(const Light *la, EEVEE_Shadow *evsh)
 {
@@ -199,6 +202,81 @@ static bool sphere_bbox_intersect(const BoundSphere *bs, const EEVEE_BoundBox *b
   return x && y && z;
 }
 
+static void bbox_transform_minmax(const EEVEE_BoundBox *bb,
+                                  const float mat[4][4],
+                                  float r_min[3],
+                                  float r_max[3])
+{
+  INIT_MINMAX(r_min, r_max);
+  for (int i = 0; i < 8; i++) {
+    float co[3];
+    for (int axis = 0; axis < 3; axis++) {
+      co[axis] = bb->center[axis] + ((i & (1 << axis)) ? bb->halfdim[axis] : -bb->halfdim[axis]);
+    }
+    mul_m4_v3(mat, co);
+    minmax_v3v3_v3(r_min, r_max, co);
+  }
+}
+
+/* Tag the faces of a shadow cube-map that can see the shadow caster. */
+static void shadow_cube_faces_tag(EEVEE_LightsInfo *linfo, int cube, const EEVEE_BoundBox *bb)
+{
+  const EEVEE_ShadowCube *cube_data = linfo->shadow_cube_data + cube;
+  float min[3], max[3];
+  bbox_transform_minmax(bb, cube_data->shadowmat, min, max);
+
+  /* Closest distance to the light position along each axis of light space. */
+  float dist[3];
+  for (int axis = 0; axis < 3; axis++) {
+    dist[axis] = (min[axis] > 0.0f) ? min[axis] : ((max[axis] < 0.0f) ? -max[axis] : 0.0f);
+  }
+
+  for (int face = 0; face < 6; face++) {
+    /* Faces are ordered +X, -X, +Y, -Y, +Z, -Z. A face sees the points whose coordinate along
+     * its axis is larger than the other two. Add some margin for the texel border and the
+     * anti-aliasing rotation. */
+    const int axis = face / 2;
+    const float extent = ((face & 1) ? -min[axis] : max[axis]) * 1.1f;
+    if (extent >= dist[(axis + 1) % 3] && extent >= dist[(axis + 2) % 3]) {
+      BLI_BITMAP_ENABLE(linfo->sh_cube_face_update, cube * 6 + face);
+    }
+  }
+}
+
+static void shadow_cube_caster_update(EEVEE_LightsInfo *linfo,
+                                      int cube,
+                                      const EEVEE_BoundBox *bb)
+{
+  /* Skip if the whole cube-map is already updated. */
+  if (!BLI_BITMAP_TEST(linfo->sh_cube_update, cube) &&
+      sphere_bbox_intersect(&linfo->shadow_bounds[cube], bb)) {
+    shadow_cube_faces_tag(linfo, cube, bb);
+  }
+}
+
+/* Return true if a shadow caster that changed since the last redraw is inside the volume of an
+ * orthographic projection. */
+bool EEVEE_shadows_caster_updated_in_volume(const EEVEE_LightsInfo *linfo,
+                                            const float persmat[4][4])
+{
+  const EEVEE_ShadowCasterBuffer *buffers[2] = {linfo->shcaster_backbuffer,
+                                                linfo->shcaster_frontbuffer};
+  for (int b = 0; b < 2; b++) {
+    const EEVEE_ShadowCasterBuffer *buffer = buffers[b];
+    for (int i = 0; i < buffer->count; i++) {
+      if (BLI_BITMAP_TEST(buffer->update, i)) {
+        float min[3], max[3];
+        bbox_transform_minmax(&buffer->bbox[i], persmat, min, max);
+        if (min[0] <= 1.0f && max[0] >= -1.0f && min[1] <= 1.0f && max[1] >= -1.0f &&
+            min[2] <= 1.0f && max[2] >= -1.0f) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
 void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
 {
   EEVEE_StorageList *stl = vedata->stl;
@@ -209,13 +287,22 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
 
   eGPUTextureFormat shadow_pool_format = (linfo->shadow_high_bitdepth) ? GPU_DEPTH_COMPONENT24 :
                                                                          GPU_DEPTH_COMPONENT16;
+  /* Lower the cube-maps resolution if they do not fit the memory budget. */
+  int cube_pool_size = linfo->shadow_cube_size;
+  const int64_t texel_bytes = (linfo->shadow_high_bitdepth) ? 4 : 2;
+  while (cube_pool_size > SHADOW_CUBE_MIN_SIZE &&
+         (int64_t)cube_pool_size * cube_pool_size * 6 * linfo->num_cube_layer * texel_bytes >
+             SHADOW_CUBE_POOL_MAX_BYTES) {
+    cube_pool_size /= 2;
+  }
+
   /* Setup enough layers. */
   /* Free textures if number mismatch. */
-  if (linfo->num_cube_layer != linfo->cache_num_cube_layer) {
+  if ((linfo->num_cube_layer != linfo->cache_num_cube_layer) ||
+      (linfo->shadow_cube_pool_size != cube_pool_size)) {
     DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_pool);
     linfo->cache_num_cube_layer = linfo->num_cube_layer;
-    /* Update all lights. */
-    BLI_bitmap_set_all(&linfo->sh_cube_update[0], true, MAX_LIGHT);
+    linfo->shadow_cube_pool_size = cube_pool_size;
   }
 
   if (linfo->num_cascade_layer != linfo->cache_num_cascade_layer) {
@@ -224,15 +311,18 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   }
 
   if (!sldata->shadow_cube_pool) {
-    sldata->shadow_cube_pool = DRW_texture_create_2d_array(linfo->shadow_cube_size,
-                                                           linfo->shadow_cube_size,
+    sldata->shadow_cube_pool = DRW_texture_create_2d_array(linfo->shadow_cube_pool_size,
+                                                           linfo->shadow_cube_pool_size,
                                                            max_ii(1, linfo->num_cube_layer * 6),
                                                            shadow_pool_format,
                                                            DRW_TEX_FILTER | DRW_TEX_COMPARE,
                                                            NULL);
+    /* Update all lights. */
+    BLI_bitmap_set_all(&linfo->sh_cube_update[0], true, MAX_LIGHT);
   }
 
   if (!sldata->shadow_cascade_pool) {
+    linfo->sh_cascade_update = true;
     sldata->shadow_cascade_pool = DRW_texture_create_2d_array(linfo->shadow_cascade_size,
                                                               linfo->shadow_cascade_size,
                                                               max_ii(1, linfo->num_cascade_layer),
@@ -256,17 +346,12 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
 
   /* TODO(fclem): This part can be slow, optimize it. */
   EEVEE_BoundBox *bbox = backbuffer->bbox;
-  BoundSphere *bsphere = linfo->shadow_bounds;
   /* Search for deleted shadow casters or if shcaster WAS in shadow radius. */
   for (int i = 0; i < backbuffer->count; i++) {
     /* If the shadowcaster has been deleted or updated. */
     if (BLI_BITMAP_TEST(backbuffer->update, i)) {
       for (int j = 0; j < linfo->cube_len; j++) {
-        if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
-          if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
-            BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
-          }
-        }
+        shadow_cube_caster_update(linfo, j, &bbox[i]);
       }
     }
   }
@@ -276,11 +361,7 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     /* If the shadowcaster has been updated. */
     if (BLI_BITMAP_TEST(frontbuffer->update, i)) {
       for (int j = 0; j < linfo->cube_len; j++) {
-        if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
-          if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
-            BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
-          }
-        }
+        shadow_cube_caster_update(linfo, j, &bbox[i]);
       }
     }
   }
@@ -298,6 +379,16 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   }
 }
 
+static bool shadow_cube_faces_need_update(const EEVEE_LightsInfo *linfo, int cube)
+{
+  for (int face = 0; face < 6; face++) {
+    if (BLI_BITMAP_TEST(linfo->sh_cube_face_update, cube * 6 + face)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 /* this refresh lights shadow buffers */
 void EEVEE_shadows_draw(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata, DRWView *view)
 {
@@ -323,7 +414,8 @@ void EEVEE_shadows_draw(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata, DRWView
   DRW_stats_group_start("Cube Shadow Maps");
   {
     for (int cube = 0; cube < linfo->cube_len; cube++) {
-      if (BLI_BITMAP_TEST(cube_visible, cube) && BLI_BITMAP_TEST(linfo->sh_cube_update, cube)) {
+      if (BLI_BITMAP_TEST(cube_visible, cube) && (BLI_BITMAP_TEST(linfo->sh_cube_update, cube) ||
+                                                  shadow_cube_faces_need_update(linfo, cube))) {
         EEVEE_shadows_draw_cubemap(sldata, vedata, cube);
       }
     }
@@ -335,6 +427,7 @@ void EEVEE_shadows_draw(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata, DRWView
     for (int cascade = 0; cascade < linfo->cascade_len; cascade++) {
       EEVEE_shadows_draw_cascades(sldata, vedata, view, cascade);
     }
+    linfo->sh_cascade_update = false;
   }
   DRW_stats_group_end();
 
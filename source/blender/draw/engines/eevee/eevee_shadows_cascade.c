@@ -426,6 +426,16 @@ void EEVEE_shadows_draw_cascades(EEVEE_ViewLayerData *sldata,
    * The only time it's more beneficial is when the CPU culling overhead
    * outweigh the instancing overhead. which is rarely the case. */
   for (int j = 0; j < csm_render->cascade_count; j++) {
+    /* Skip the cascades that are rendered with the same matrices and where no shadow caster
+     * changed. They are stable as long as the view and the light do not move. */
+    float persmat[4][4];
+    mul_m4_m4m4(persmat, csm_render->projmat[j], csm_render->viewmat);
+    if (!linfo->sh_cascade_update && equals_m4m4(persmat, csm_render->rendered_persmat[j]) &&
+        !EEVEE_shadows_caster_updated_in_volume(linfo, persmat)) {
+      continue;
+    }
+    copy_m4_m4(csm_render->rendered_persmat[j], persmat);
+
     DRW_view_set_active(g_data->cube_views[j]);
     int layer = csm_data->tex_id + j;
     GPU_framebuffer_texture_layer_attach(
@@ -126,7 +126,7 @@ bool EEVEE_shadows_cube_setup(EEVEE_LightsInfo *linfo, const EEVEE_Light *evli,
      **/
     /* NOTE: this has implication for spotlight rendering optimization
      * (see EEVEE_shadows_draw_cubemap). */
-    float angular_texel_size = 2.0f * DEG2RADF(90) / (float)linfo->shadow_cube_size;
+    float angular_texel_size = 2.0f * DEG2RADF(90) / (float)linfo->shadow_cube_pool_size;
     EEVEE_random_rotation_m4(sample_ofs, angular_texel_size, cube_data->shadowmat);
   }
 
@@ -191,10 +191,12 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
 
   eevee_ensure_cube_views(shdw_data->near,
                           shdw_data->far,
-                          linfo->shadow_cube_size,
+                          linfo->shadow_cube_pool_size,
                           cube_data->shadowmat,
                           g_data->cube_views);
 
+  const bool update_all_faces = BLI_BITMAP_TEST(linfo->sh_cube_update, cube_index);
+
   /* Render shadow cube */
   /* Render 6 faces separately: seems to be faster for the general case.
    * The only time it's more beneficial is when the CPU culling overhead
@@ -209,6 +211,10 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
     if (evli->light_type != LA_LOCAL && j == 4) {
       continue;
     }
+    /* Skip faces that no updated shadow caster can be seen from. */
+    if (!update_all_faces && !BLI_BITMAP_TEST(linfo->sh_cube_face_update, cube_index * 6 + j)) {
+      continue;
+    }
     /* TODO(fclem): some cube sides can be invisible in the main views. Cull them. */
     // if (frustum_intersect(g_data->cube_views[j], main_view))
     //   continue;
@@ -222,4 +228,7 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
   }
 
   BLI_BITMAP_SET(&linfo->sh_cube_update[0], cube_index, false);
+  for (int j = 0; j < 6; j++) {
+    BLI_BITMAP_DISABLE(linfo->sh_cube_face_update, cube_index * 6 + j);
+  }
 }
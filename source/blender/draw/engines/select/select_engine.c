@@ -24,6 +24,8 @@
 
 #include "DNA_screen_types.h"
 
+#include "DEG_depsgraph_query.h"
+
 #include "UI_resources.h"
 
 #include "DRW_engine.h"
@@ -202,14 +204,35 @@ static void select_cache_init(void *vedata)
   e_data.context.is_dirty = !compare_m4m4(e_data.context.persmat, persmat, FLT_EPSILON);
 
   if (!e_data.context.is_dirty) {
-    /* Check if any of the drawn objects have been transformed. */
-    Object **ob = &e_data.context.objects_drawn[0];
-    for (uint i = e_data.context.objects_drawn_len; i--; ob++) {
-      DrawData *data = DRW_drawdata_get(&(*ob)->id, &draw_engine_select_type);
-      if (data && (data->recalc & ID_RECALC_TRANSFORM) != 0) {
-        data->recalc &= ~ID_RECALC_TRANSFORM;
+    /* The size of the region may change without affecting the matrices. */
+    e_data.context.is_dirty = (e_data.texture_u32 == NULL) ||
+                              (GPU_texture_width(e_data.texture_u32) != draw_ctx->region->winx) ||
+                              (GPU_texture_height(e_data.texture_u32) != draw_ctx->region->winy);
+  }
+
+  if (!e_data.context.is_dirty) {
+    /* Check if any of the drawn objects have been updated. The buffer is kept between selection
+     * operators, so the evaluated objects are looked up again instead of trusting
+     * `objects_drawn`, which can point to freed copies after the depsgraph has been rebuilt. */
+    uint drawn_len = 0;
+    Object **ob = &e_data.context.objects[0];
+    for (uint i = e_data.context.objects_len; i--; ob++) {
+      Object *ob_eval = DEG_get_evaluated_object(draw_ctx->depsgraph, *ob);
+      SELECTID_ObjectData *sel_data = (SELECTID_ObjectData *)DRW_drawdata_get(
+          &ob_eval->id, &draw_engine_select_type);
+      if (sel_data == NULL || !sel_data->is_drawn) {
+        continue;
+      }
+      if ((sel_data->drawn_index >= e_data.context.objects_drawn_len) ||
+          (e_data.context.objects_drawn[sel_data->drawn_index] != ob_eval) ||
+          (sel_data->dd.recalc != 0)) {
         e_data.context.is_dirty = true;
       }
+      sel_data->dd.recalc = 0;
+      drawn_len++;
+    }
+    if (drawn_len != e_data.context.objects_drawn_len) {
+      e_data.context.is_dirty = true;
     }
   }
 
@@ -346,6 +369,8 @@ static void select_engine_free(void)
   MEM_SAFE_FREE(e_data.context.objects);
   MEM_SAFE_FREE(e_data.context.index_offsets);
   MEM_SAFE_FREE(e_data.context.objects_drawn);
+  e_data.context.objects_len = 0;
+  e_data.context.objects_drawn_len = 0;
 }
 
 /** \} */
@@ -3590,7 +3590,7 @@ void drw_batch_cache_generate_requested(Object *ob)
         DRW_mesh_batch_cache_create_requested(
             DST.task_graph, ob, mesh_eval, scene, is_paint_mode, use_hide);
       }
-      DRW_curve_batch_cache_create_requested(ob);
+      DRW_curve_batch_cache_create_requested(DST.task_graph, ob);
       break;
     /* TODO all cases */
     default:
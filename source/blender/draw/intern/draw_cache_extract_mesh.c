@@ -32,6 +32,7 @@
 #include "BLI_jitter_2d.h"
 #include "BLI_math_bits.h"
 #include "BLI_math_vector.h"
+#include "BLI_profile.h"
 #include "BLI_string.h"
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
@@ -5387,9 +5388,16 @@ static void extract_init(ExtractTaskData *data)
   }
 }
 
+static const char *mesh_render_data_profile_name(const MeshRenderData *mr)
+{
+  return mr->me ? mr->me->id.name + 2 : NULL;
+}
+
 static void extract_run(void *__restrict taskdata)
 {
   ExtractTaskData *data = (ExtractTaskData *)taskdata;
+  ProfileZone profile_zone;
+  BLI_profile_zone_begin(&profile_zone, "Mesh Extract", mesh_render_data_profile_name(data->mr));
   if (data->tasktype == EXTRACT_MESH_EXTRACT) {
     mesh_extract_iter(data->mr,
                       data->iter_type,
@@ -5407,6 +5415,7 @@ static void extract_run(void *__restrict taskdata)
   else if (data->tasktype == EXTRACT_LINES_LOOSE) {
     extract_lines_loose_subbuffer(data->mr, data->cache);
   }
+  BLI_profile_zone_end(&profile_zone);
 }
 
 static void extract_init_and_run(void *__restrict taskdata)
@@ -5441,8 +5450,11 @@ static void mesh_extract_render_data_node_exec(void *__restrict task_data)
   const eMRIterType iter_type = update_task_data->iter_type;
   const eMRDataType data_flag = update_task_data->data_flag;
 
+  ProfileZone profile_zone;
+  BLI_profile_zone_begin(&profile_zone, "Mesh Render Data", mesh_render_data_profile_name(mr));
   mesh_render_data_update_normals(mr, iter_type, data_flag);
   mesh_render_data_update_looptris(mr, iter_type, data_flag);
+  BLI_profile_zone_end(&profile_zone);
 }
 
 static struct TaskNode *mesh_extract_render_data_node_create(struct TaskGraph *task_graph,
@@ -5527,9 +5539,12 @@ static void user_data_init_task_data_free(UserDataInitTaskData *taskdata)
 static void user_data_init_task_data_exec(void *__restrict task_data)
 {
   UserDataInitTaskData *extract_task_data = task_data;
+  ProfileZone profile_zone;
+  BLI_profile_zone_begin(&profile_zone, "Mesh Extract Init", NULL);
   LISTBASE_FOREACH (ExtractTaskData *, td, &extract_task_data->task_datas) {
     extract_init(td);
   }
+  BLI_profile_zone_end(&profile_zone);
 }
 
 static struct TaskNode *user_data_init_task_node_create(struct TaskGraph *task_graph,
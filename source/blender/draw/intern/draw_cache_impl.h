@@ -87,7 +87,7 @@ void DRW_mesh_batch_cache_free_old(struct Mesh *me, int ctime);
 void DRW_vertbuf_create_wiredata(struct GPUVertBuf *vbo, const int vert_len);
 
 /* Curve */
-void DRW_curve_batch_cache_create_requested(struct Object *ob);
+void DRW_curve_batch_cache_create_requested(struct TaskGraph *task_graph, struct Object *ob);
 
 int DRW_curve_material_count_get(struct Curve *cu);
 
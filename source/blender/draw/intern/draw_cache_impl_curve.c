@@ -27,6 +27,7 @@
 
 #include "BLI_listbase.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_curve_types.h"
@@ -941,7 +942,167 @@ int DRW_curve_material_count_get(Curve *cu)
 /** \name Grouped batch generation
  * \{ */
 
-void DRW_curve_batch_cache_create_requested(Object *ob)
+/* -------------------------------------------------------------------- */
+/** \name Buffer Extraction
+ *
+ * Every task fills a set of buffers that no other task writes to.
+ * \{ */
+
+typedef struct CurveExtractTaskData {
+  CurveBatchCache *cache;
+  CurveRenderData *rdata;
+  ListBase *lb;
+} CurveExtractTaskData;
+
+static bool curve_extract_pos_nor_requested(CurveBatchCache *cache)
+{
+  return DRW_vbo_requested(cache->ordered.pos_nor);
+}
+
+static void curve_extract_pos_nor_run(void *__restrict task_data)
+{
+  CurveExtractTaskData *data = task_data;
+  DRW_displist_vertbuf_create_pos_and_nor(data->lb, data->cache->ordered.pos_nor);
+}
+
+static bool curve_extract_edge_fac_requested(CurveBatchCache *cache)
+{
+  return DRW_vbo_requested(cache->ordered.edge_fac);
+}
+
+static void curve_extract_edge_fac_run(void *__restrict task_data)
+{
+  CurveExtractTaskData *data = task_data;
+  DRW_displist_vertbuf_create_wiredata(data->lb, data->cache->ordered.edge_fac);
+}
+
+static bool curve_extract_curves_pos_requested(CurveBatchCache *cache)
+{
+  return DRW_vbo_requested(cache->ordered.curves_pos);
+}
+
+static void curve_extract_curves_pos_run(void *__restrict task_data)
+{
+  CurveExtractTaskData *data = task_data;
+  curve_create_curves_pos(data->rdata, data->cache->ordered.curves_pos);
+}
+
+static bool curve_extract_loop_requested(CurveBatchCache *cache)
+{
+  return DRW_vbo_requested(cache->ordered.loop_pos_nor) ||
+         DRW_vbo_requested(cache->ordered.loop_uv) || DRW_vbo_requested(cache->ordered.loop_tan);
+}
+
+static void curve_extract_loop_run(void *__restrict task_data)
+{
+  CurveExtractTaskData *data = task_data;
+  CurveBatchCache *cache = data->cache;
+  DRW_displist_vertbuf_create_loop_pos_and_nor_and_uv_and_tan(
+      data->lb, cache->ordered.loop_pos_nor, cache->ordered.loop_uv, cache->ordered.loop_tan);
+}
+
+static bool curve_extract_tris_per_mat_requested(CurveBatchCache *cache)
+{
+  return DRW_ibo_requested(cache->surf_per_mat_tris[0]);
+}
+
+static void curve_extract_tris_per_mat_run(void *__restrict task_data)
+{
+  CurveExtractTaskData *data = task_data;
+  DRW_displist_indexbuf_create_triangles_loop_split_by_material(
+      data->lb, data->cache->surf_per_mat_tris, data->cache->mat_len);
+}
+
+static bool curve_extract_curves_lines_requested(CurveBatchCache *cache)
+{
+  return DRW_ibo_requested(cache->ibo.curves_lines);
+}
+
+static void curve_extract_curves_lines_run(void *__restrict task_data)
+{
+  CurveExtractTaskData *data = task_data;
+  curve_create_curves_lines(data->rdata, data->cache->ibo.curves_lines);
+}
+
+static bool curve_extract_surfaces_tris_requested(CurveBatchCache *cache)
+{
+  return DRW_ibo_requested(cache->ibo.surfaces_tris);
+}
+
+static void curve_extract_surfaces_tris_run(void *__restrict task_data)
+{
+  CurveExtractTaskData *data = task_data;
+  DRW_displist_indexbuf_create_triangles_in_order(data->lb, data->cache->ibo.surfaces_tris);
+}
+
+static bool curve_extract_surfaces_lines_requested(CurveBatchCache *cache)
+{
+  return DRW_ibo_requested(cache->ibo.surfaces_lines);
+}
+
+static void curve_extract_surfaces_lines_run(void *__restrict task_data)
+{
+  CurveExtractTaskData *data = task_data;
+  DRW_displist_indexbuf_create_lines_in_order(data->lb, data->cache->ibo.surfaces_lines);
+}
+
+static bool curve_extract_edges_adj_requested(CurveBatchCache *cache)
+{
+  return DRW_ibo_requested(cache->ibo.edges_adj_lines);
+}
+
+static void curve_extract_edges_adj_run(void *__restrict task_data)
+{
+  CurveExtractTaskData *data = task_data;
+  DRW_displist_indexbuf_create_edges_adjacency_lines(
+      data->lb, data->cache->ibo.edges_adj_lines, &data->cache->is_manifold);
+}
+
+static bool curve_extract_edit_data_requested(CurveBatchCache *cache)
+{
+  return DRW_vbo_requested(cache->edit.pos) || DRW_vbo_requested(cache->edit.data) ||
+         DRW_ibo_requested(cache->ibo.edit_verts) || DRW_ibo_requested(cache->ibo.edit_lines);
+}
+
+static void curve_extract_edit_data_run(void *__restrict task_data)
+{
+  CurveExtractTaskData *data = task_data;
+  CurveBatchCache *cache = data->cache;
+  curve_create_edit_data_and_handles(
+      data->rdata, cache->edit.pos, cache->edit.data, cache->ibo.edit_verts, cache->ibo.edit_lines);
+}
+
+static bool curve_extract_edit_curves_nor_requested(CurveBatchCache *cache)
+{
+  return DRW_vbo_requested(cache->edit.curves_nor);
+}
+
+static void curve_extract_edit_curves_nor_run(void *__restrict task_data)
+{
+  CurveExtractTaskData *data = task_data;
+  curve_create_edit_curves_nor(data->rdata, data->cache->edit.curves_nor);
+}
+
+static const struct {
+  bool (*is_requested)(CurveBatchCache *cache);
+  TaskGraphNodeRunFunction run;
+} curve_extract_tasks[] = {
+    {curve_extract_pos_nor_requested, curve_extract_pos_nor_run},
+    {curve_extract_edge_fac_requested, curve_extract_edge_fac_run},
+    {curve_extract_curves_pos_requested, curve_extract_curves_pos_run},
+    {curve_extract_loop_requested, curve_extract_loop_run},
+    {curve_extract_tris_per_mat_requested, curve_extract_tris_per_mat_run},
+    {curve_extract_curves_lines_requested, curve_extract_curves_lines_run},
+    {curve_extract_surfaces_tris_requested, curve_extract_surfaces_tris_run},
+    {curve_extract_surfaces_lines_requested, curve_extract_surfaces_lines_run},
+    {curve_extract_edges_adj_requested, curve_extract_edges_adj_run},
+    {curve_extract_edit_data_requested, curve_extract_edit_data_run},
+    {curve_extract_edit_curves_nor_requested, curve_extract_edit_curves_nor_run},
+};
+
+/** \} */
+
+void DRW_curve_batch_cache_create_requested(struct TaskGraph *task_graph, Object *ob)
 {
   BLI_assert(ELEM(ob->type, OB_CURVE, OB_SURF, OB_FONT));
 
@@ -1044,51 +1205,28 @@ void DRW_curve_batch_cache_create_requested(Object *ob)
 
   /* DispLists */
   ListBase *lb = &rdata->ob_curve_cache->disp;
-
-  /* Generate VBOs */
-  if (DRW_vbo_requested(cache->ordered.pos_nor)) {
-    DRW_displist_vertbuf_create_pos_and_nor(lb, cache->ordered.pos_nor);
-  }
-  if (DRW_vbo_requested(cache->ordered.edge_fac)) {
-    DRW_displist_vertbuf_create_wiredata(lb, cache->ordered.edge_fac);
-  }
-  if (DRW_vbo_requested(cache->ordered.curves_pos)) {
-    curve_create_curves_pos(rdata, cache->ordered.curves_pos);
-  }
-
-  if (DRW_vbo_requested(cache->ordered.loop_pos_nor) ||
+  /* Normals are lazily added to the DispLists, make sure this is done before the buffers that
+   * need them are filled in parallel. */
+  if (DRW_vbo_requested(cache->ordered.pos_nor) || DRW_vbo_requested(cache->ordered.loop_pos_nor) ||
       DRW_vbo_requested(cache->ordered.loop_uv) || DRW_vbo_requested(cache->ordered.loop_tan)) {
-    DRW_displist_vertbuf_create_loop_pos_and_nor_and_uv_and_tan(
-        lb, cache->ordered.loop_pos_nor, cache->ordered.loop_uv, cache->ordered.loop_tan);
-  }
-
-  if (DRW_ibo_requested(cache->surf_per_mat_tris[0])) {
-    DRW_displist_indexbuf_create_triangles_loop_split_by_material(
-        lb, cache->surf_per_mat_tris, cache->mat_len);
-  }
-
-  if (DRW_ibo_requested(cache->ibo.curves_lines)) {
-    curve_create_curves_lines(rdata, cache->ibo.curves_lines);
-  }
-  if (DRW_ibo_requested(cache->ibo.surfaces_tris)) {
-    DRW_displist_indexbuf_create_triangles_in_order(lb, cache->ibo.surfaces_tris);
-  }
-  if (DRW_ibo_requested(cache->ibo.surfaces_lines)) {
-    DRW_displist_indexbuf_create_lines_in_order(lb, cache->ibo.surfaces_lines);
-  }
-  if (DRW_ibo_requested(cache->ibo.edges_adj_lines)) {
-    DRW_displist_indexbuf_create_edges_adjacency_lines(
-        lb, cache->ibo.edges_adj_lines, &cache->is_manifold);
-  }
-
-  if (DRW_vbo_requested(cache->edit.pos) || DRW_vbo_requested(cache->edit.data) ||
-      DRW_ibo_requested(cache->ibo.edit_verts) || DRW_ibo_requested(cache->ibo.edit_lines)) {
-    curve_create_edit_data_and_handles(
-        rdata, cache->edit.pos, cache->edit.data, cache->ibo.edit_verts, cache->ibo.edit_lines);
-  }
-  if (DRW_vbo_requested(cache->edit.curves_nor)) {
-    curve_create_edit_curves_nor(rdata, cache->edit.curves_nor);
+    BKE_displist_normals_add(lb);
+  }
+
+  /* Generate VBOs & IBOs. The buffers don't depend on each other, fill them in parallel. */
+  CurveExtractTaskData task_data = {
+      .cache = cache,
+      .rdata = rdata,
+      .lb = lb,
+  };
+  for (int i = 0; i < ARRAY_SIZE(curve_extract_tasks); i++) {
+    if (curve_extract_tasks[i].is_requested(cache)) {
+      struct TaskNode *task_node = BLI_task_graph_node_create(
+          task_graph, curve_extract_tasks[i].run, &task_data, NULL);
+      BLI_task_graph_node_push_work(task_node);
+    }
   }
+  /* Task data lives on the stack, wait for the buffers to be filled. */
+  BLI_task_graph_work_and_wait(task_graph);
 
   curve_render_data_free(rdata);
 
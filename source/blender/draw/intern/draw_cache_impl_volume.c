@@ -258,6 +258,10 @@ GPUBatch *DRW_volume_batch_cache_get_selection_surface(Volume *volume)
   return cache->selection_surface;
 }
 
+/* Grids with more voxels than this are displayed at a lower resolution, converting them to a dense
+ * texture at full resolution would take too much memory. */
+#define VOLUME_DISPLAY_MAX_VOXELS (512 * 512 * 512)
+
 static DRWVolumeGrid *volume_grid_cache_get(Volume *volume,
                                             VolumeGrid *grid,
                                             VolumeBatchCache *cache)
@@ -292,7 +296,7 @@ static DRWVolumeGrid *volume_grid_cache_get(Volume *volume,
   const bool was_loaded = BKE_volume_grid_is_loaded(grid);
 
   DenseFloatVolumeGrid dense_grid;
-  if (BKE_volume_grid_dense_floats(volume, grid, &dense_grid)) {
+  if (BKE_volume_grid_dense_floats(volume, grid, VOLUME_DISPLAY_MAX_VOXELS, &dense_grid)) {
     copy_m4_m4(cache_grid->texture_to_object, dense_grid.texture_to_object);
     invert_m4_m4(cache_grid->object_to_texture, dense_grid.texture_to_object);
 
@@ -2102,7 +2102,9 @@ void DRW_pass_sort_shgroup_z(DRWPass *pass)
 
   /* Find the new last */
   DRWShadingGroup *last = pass->shgroups.first;
-  while ((last = last->next)) {
+  last->pass_handle = pass->handle;
+  while (last->next) {
+    last = last->next;
     /* Reset the pass id for debugging. */
     last->pass_handle = pass->handle;
   }
@@ -26,6 +26,7 @@
 #include "BLI_math.h"
 #include "BLI_math_bits.h"
 #include "BLI_memblock.h"
+#include "BLI_task.h"
 
 #include "BKE_global.h"
 
@@ -485,47 +486,83 @@ void DRW_culling_frustum_planes_get(const DRWView *view, float planes[6][4])
   memcpy(planes, view->frustum_planes, sizeof(float[6][4]));
 }
 
+typedef struct DRWCullingTaskData {
+  DRWView *view;
+  /* Number of culling states in the last chunk. */
+  int last_chunk_len;
+  int last_chunk;
+} DRWCullingTaskData;
+
+static void draw_compute_culling_state(DRWView *view, DRWCullingState *cull)
+{
+  if (cull->bsphere.radius < 0.0) {
+    cull->mask = 0;
+  }
+  else {
+    bool culled = !draw_culling_sphere_test(
+        &view->frustum_bsphere, view->frustum_planes, &cull->bsphere);
+
+#ifdef DRW_DEBUG_CULLING
+    if (G.debug_value != 0) {
+      if (culled) {
+        DRW_debug_sphere(cull->bsphere.center, cull->bsphere.radius, (const float[4]){1, 0, 0, 1});
+      }
+      else {
+        DRW_debug_sphere(cull->bsphere.center, cull->bsphere.radius, (const float[4]){0, 1, 0, 1});
+      }
+    }
+#endif
+
+    if (view->visibility_fn) {
+      culled = !view->visibility_fn(!culled, cull->user_data);
+    }
+
+    SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
+  }
+}
+
+static void draw_compute_culling_chunk_cb(void *__restrict userdata,
+                                          const int chunk,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const DRWCullingTaskData *data = userdata;
+  const int elem_len = (chunk == data->last_chunk) ? data->last_chunk_len :
+                                                     DRW_RESOURCE_CHUNK_LEN;
+  /* Culling states of a chunk are contiguous in memory. */
+  DRWCullingState *cull = BLI_memblock_elem_get(DST.vmempool->cullstates, chunk, 0);
+  for (int i = 0; i < elem_len; i++, cull++) {
+    draw_compute_culling_state(data->view, cull);
+  }
+}
+
 static void draw_compute_culling(DRWView *view)
 {
   view = view->parent ? view->parent : view;
 
-  /* TODO(fclem): multi-thread this. */
   /* TODO(fclem): compute all dirty views at once. */
   if (!view->is_dirty) {
     return;
   }
 
-  BLI_memblock_iter iter;
-  BLI_memblock_iternew(DST.vmempool->cullstates, &iter);
-  DRWCullingState *cull;
-  while ((cull = BLI_memblock_iterstep(&iter))) {
-    if (cull->bsphere.radius < 0.0) {
-      cull->mask = 0;
-    }
-    else {
-      bool culled = !draw_culling_sphere_test(
-          &view->frustum_bsphere, view->frustum_planes, &cull->bsphere);
+  /* One culling state is allocated for every resource handle (including the unit state).
+   * They are culled one resource chunk per task. */
+  DRWCullingTaskData data = {
+      .view = view,
+      .last_chunk = DRW_handle_chunk_get(&DST.resource_handle),
+      .last_chunk_len = DRW_handle_id_get(&DST.resource_handle),
+  };
 
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 4;
+  /* Visibility callbacks are allowed to modify their user data (see EEVEE planar probes). */
+  settings.use_threading = (view->visibility_fn == NULL);
 #ifdef DRW_DEBUG_CULLING
-      if (G.debug_value != 0) {
-        if (culled) {
-          DRW_debug_sphere(
-              cull->bsphere.center, cull->bsphere.radius, (const float[4]){1, 0, 0, 1});
-        }
-        else {
-          DRW_debug_sphere(
-              cull->bsphere.center, cull->bsphere.radius, (const float[4]){0, 1, 0, 1});
-        }
-      }
+  /* Debug drawing is not thread safe. */
+  settings.use_threading = false;
 #endif
-
-      if (view->visibility_fn) {
-        culled = !view->visibility_fn(!culled, cull->user_data);
-      }
-
-      SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
-    }
-  }
+  const int chunk_len = data.last_chunk + ((data.last_chunk_len > 0) ? 1 : 0);
+  BLI_task_parallel_range(0, chunk_len, &data, draw_compute_culling_chunk_cb, &settings);
 
   view->is_dirty = false;
 }
@@ -131,8 +131,6 @@ void UI_view2d_totRect_set_resize(struct View2D *v2d, int width, int height, boo
 
 void UI_view2d_mask_from_win(const struct View2D *v2d, struct rcti *r_mask);
 
-void UI_view2d_zoom_cache_reset(void);
-
 /* view matrix operations */
 void UI_view2d_view_ortho(const struct View2D *v2d);
 void UI_view2d_view_orthoSpecial(struct ARegion *region, struct View2D *v2d, const bool xaxis);
@@ -1046,22 +1046,6 @@ void UI_view2d_totRect_set(View2D *v2d, int width, int height)
   UI_view2d_totRect_set_resize(v2d, width, height, false);
 }
 
-void UI_view2d_zoom_cache_reset(void)
-{
-  /* TODO(sergey): This way we avoid threading conflict with sequencer rendering
-   * text strip. But ideally we want to make glyph cache to be fully safe
-   * for threading.
-   */
-  if (G.is_rendering) {
-    return;
-  }
-  /* While scaling we can accumulate fonts at many sizes (~20 or so).
-   * Not an issue with embedded font, but can use over 500Mb with i18n ones! See T38244. */
-
-  /* note: only some views draw text, we could check for this case to avoid clearning cache */
-  BLF_cache_clear();
-}
-
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -953,8 +953,6 @@ static void view_zoomstep_apply(bContext *C, wmOperator *op)
 /* cleanup temp customdata  */
 static void view_zoomstep_exit(wmOperator *op)
 {
-  UI_view2d_zoom_cache_reset();
-
   if (op->customdata) {
     MEM_freeN(op->customdata);
     op->customdata = NULL;
@@ -1191,8 +1189,6 @@ static void view_zoomdrag_apply(bContext *C, wmOperator *op)
 /* cleanup temp customdata  */
 static void view_zoomdrag_exit(bContext *C, wmOperator *op)
 {
-  UI_view2d_zoom_cache_reset();
-
   if (op->customdata) {
     v2dViewZoomData *vzd = op->customdata;
 
@@ -1804,10 +1800,6 @@ static int view2d_smoothview_invoke(bContext *C, wmOperator *UNUSED(op), const w
   UI_view2d_sync(CTX_wm_screen(C), CTX_wm_area(C), v2d, V2D_LOCK_COPY);
   ED_region_tag_redraw_no_rebuild(region);
 
-  if (v2d->sms == NULL) {
-    UI_view2d_zoom_cache_reset();
-  }
-
   return OPERATOR_FINISHED;
 }
 
@@ -2370,8 +2362,6 @@ static int reset_exec(bContext *C, wmOperator *UNUSED(op))
   ED_region_tag_redraw(region);
   UI_view2d_sync(CTX_wm_screen(C), CTX_wm_area(C), v2d, V2D_LOCK_COPY);
 
-  UI_view2d_zoom_cache_reset();
-
   return OPERATOR_FINISHED;
 }
 
@@ -743,11 +743,38 @@ static bool mesh_undosys_step_encode(struct bContext *C, struct Main *bmain, Und
   return true;
 }
 
+/**
+ * Each step stores the entire mesh, so when stepping over multiple undo steps at once,
+ * loading a step is redundant if the next step to load restores the same objects.
+ */
+static bool mesh_undosys_step_decode_is_redundant(const MeshUndoStep *us, const int dir)
+{
+  const UndoStep *us_other_p = (dir == -1) ? us->step.prev : us->step.next;
+  if ((us_other_p == NULL) || (us_other_p->type != us->step.type)) {
+    return false;
+  }
+
+  const MeshUndoStep *us_other = (const MeshUndoStep *)us_other_p;
+  if (us_other->elems_len != us->elems_len) {
+    return false;
+  }
+  for (uint i = 0; i < us->elems_len; i++) {
+    if (!STREQ(us->elems[i].obedit_ref.name, us_other->elems[i].obedit_ref.name)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 static void mesh_undosys_step_decode(
-    struct bContext *C, struct Main *bmain, UndoStep *us_p, int UNUSED(dir), bool UNUSED(is_final))
+    struct bContext *C, struct Main *bmain, UndoStep *us_p, int dir, bool is_final)
 {
   MeshUndoStep *us = (MeshUndoStep *)us_p;
 
+  if (!is_final && mesh_undosys_step_decode_is_redundant(us, dir)) {
+    return;
+  }
+
   /* Load all our objects  into edit-mode, clear everything else. */
   ED_undo_object_editmode_restore_helper(
       C, &us->elems[0].obedit_ref.ptr, us->elems_len, sizeof(*us->elems));
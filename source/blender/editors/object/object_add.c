@@ -3146,6 +3146,7 @@ static int duplicate_exec(bContext *C, wmOperator *op)
    * we also want to remap pointers between those... */
   BKE_main_id_tag_all(bmain, LIB_TAG_NEW, false);
   BKE_main_id_clear_newpoins(bmain);
+  BKE_main_id_name_cache_begin(bmain);
 
   CTX_DATA_BEGIN (C, Base *, base, selected_bases) {
     Base *basen = object_add_duplicate_internal(
@@ -3171,6 +3172,8 @@ static int duplicate_exec(bContext *C, wmOperator *op)
   }
   CTX_DATA_END;
 
+  BKE_main_id_name_cache_end(bmain);
+
   /* Note that this will also clear newid pointers and tags. */
   copy_object_set_idnew(C);
 
@@ -1030,9 +1030,11 @@ static void light_cache_bake_tag_cache(Scene *scene, wmOperator *op)
     switch (subset) {
       case LIGHTCACHE_SUBSET_ALL:
         scene->eevee.light_cache_data->flag |= LIGHTCACHE_UPDATE_GRID | LIGHTCACHE_UPDATE_CUBE;
+        scene->eevee.light_cache_data->flag &= ~LIGHTCACHE_UPDATE_REGION;
         break;
       case LIGHTCACHE_SUBSET_CUBE:
         scene->eevee.light_cache_data->flag |= LIGHTCACHE_UPDATE_CUBE;
+        scene->eevee.light_cache_data->flag &= ~LIGHTCACHE_UPDATE_REGION;
         break;
       case LIGHTCACHE_SUBSET_DIRTY:
         /* Leave tag untouched. */
@@ -1145,7 +1147,7 @@ void SCENE_OT_light_cache_bake(wmOperatorType *ot)
        "DIRTY",
        0,
        "Dirty Only",
-       "Only bake lightprobes that are marked as dirty"},
+       "Only bake lightprobes that are marked as dirty or influenced by the changed objects"},
       {LIGHTCACHE_SUBSET_CUBE,
        "CUBEMAPS",
        0,
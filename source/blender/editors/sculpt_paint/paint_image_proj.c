@@ -4691,10 +4691,33 @@ static bool project_image_refresh_tagged(ProjPaintState *ps)
 
   for (a = 0, projIma = ps->projImages; a < ps->image_tot; a++, projIma++) {
     if (projIma->touch) {
+      /* Every update has a fixed cost (acquiring the image buffer, color space conversion of the
+       * region, a texture upload), so update the touched cells at once when their bounds don't
+       * cover many more pixels than the cells themselves. */
+      ImagePaintPartialRedraw pr_union;
+      partial_redraw_single_init(&pr_union);
+      uint64_t cells_area = 0;
+      for (i = 0; i < PROJ_BOUNDBOX_SQUARED; i++) {
+        pr = &(projIma->partRedrawRect[i]);
+        if (pr->x2 != -1) {
+          partial_redraw_array_merge(&pr_union, pr, 1);
+          cells_area += (uint64_t)(pr->x2 - pr->x1) * (uint64_t)(pr->y2 - pr->y1);
+        }
+      }
+      const uint64_t union_area = (uint64_t)(pr_union.x2 - pr_union.x1) *
+                                  (uint64_t)(pr_union.y2 - pr_union.y1);
+      const bool use_union = (pr_union.x2 != -1) && (union_area <= cells_area * 2);
+
+      if (use_union) {
+        set_imapaintpartial(&pr_union);
+        imapaint_image_update(NULL, projIma->ima, projIma->ibuf, &projIma->iuser, true);
+        redraw = 1;
+      }
+
       /* look over each bound cell */
       for (i = 0; i < PROJ_BOUNDBOX_SQUARED; i++) {
         pr = &(projIma->partRedrawRect[i]);
-        if (pr->x2 != -1) { /* TODO - use 'enabled' ? */
+        if (pr->x2 != -1 && !use_union) { /* TODO - use 'enabled' ? */
           set_imapaintpartial(pr);
           imapaint_image_update(NULL, projIma->ima, projIma->ibuf, &projIma->iuser, true);
           redraw = 1;
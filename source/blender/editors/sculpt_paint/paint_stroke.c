@@ -67,6 +67,10 @@
 #  include "PIL_time_utildefines.h"
 #endif
 
+/* Time in seconds for processing a run of queued in between mouse moves, after which the rest of
+ * the run is skipped so the stroke catches up with the cursor. */
+#define PAINT_STROKE_INBETWEEN_TIME_BUDGET (1.0 / 60.0)
+
 typedef struct PaintSample {
   float mouse[2];
   float pressure;
@@ -120,6 +124,10 @@ typedef struct PaintStroke {
 
   float last_tablet_event_pressure;
 
+  /* Time at which processing the current run of in between mouse moves started, zero when the
+   * last event was not an in between mouse move. */
+  double inbetween_start_time;
+
   float zoom_2d;
   int pen_flip;
 
@@ -1375,6 +1383,23 @@ int paint_stroke_modal(bContext *C, wmOperator *op, const wmEvent *event)
     return OPERATOR_RUNNING_MODAL;
   }
 
+  /* With high polling rates events can be queued faster than dabs are applied. In between mouse
+   * moves only add accuracy, so once they took longer than the budget the rest of them is skipped,
+   * and the next mouse move continues the stroke from the last processed position up to the
+   * cursor instead of replaying every queued position while lagging behind. */
+  if (event->type == INBETWEEN_MOUSEMOVE) {
+    const double time = PIL_check_seconds_timer();
+    if (stroke->inbetween_start_time == 0.0) {
+      stroke->inbetween_start_time = time;
+    }
+    else if (time - stroke->inbetween_start_time > PAINT_STROKE_INBETWEEN_TIME_BUDGET) {
+      return OPERATOR_RUNNING_MODAL;
+    }
+  }
+  else {
+    stroke->inbetween_start_time = 0.0;
+  }
+
   /* see if tablet affects event. Line, anchored and drag dot strokes do not support pressure */
   pressure = ((br->flag & (BRUSH_LINE | BRUSH_ANCHORED | BRUSH_DRAG_DOT)) ?
                   1.0f :
@@ -191,6 +191,41 @@ static bool vertex_paint_use_fast_update_check(Object *ob)
   return false;
 }
 
+/* Same as #vertex_paint_use_fast_update_check for weights, the evaluated mesh must reference
+ * the original deform-vertex layer and no modifier may read it (e.g. armature deform),
+ * since those need to be re-evaluated to show the new weights. */
+static bool weight_paint_use_fast_update_check(const Scene *scene, Object *ob)
+{
+  Mesh *me_eval = BKE_object_get_evaluated_mesh(ob);
+
+  if (me_eval != NULL) {
+    Mesh *me = BKE_mesh_from_object(ob);
+    if (me && me->dvert) {
+      if (me->dvert != CustomData_get_layer(&me_eval->vdata, CD_MDEFORMVERT)) {
+        return false;
+      }
+
+      LISTBASE_FOREACH (ModifierData *, md, &ob->modifiers) {
+        if (!BKE_modifier_is_enabled(scene, md, eModifierMode_Realtime)) {
+          continue;
+        }
+        const ModifierTypeInfo *mti = BKE_modifier_get_info(md->type);
+        if (mti->requiredDataMask == NULL) {
+          continue;
+        }
+        CustomData_MeshMasks cddata_masks = {0};
+        mti->requiredDataMask(ob, md, &cddata_masks);
+        if (cddata_masks.vmask & CD_MASK_MDEFORMVERT) {
+          return false;
+        }
+      }
+      return true;
+    }
+  }
+
+  return false;
+}
+
 static void paint_last_stroke_update(Scene *scene, const float location[3])
 {
   UnifiedPaintSettings *ups = &scene->toolsettings->unified_paint_settings;
@@ -1452,6 +1487,12 @@ struct WPaintData {
   /* original weight values for use in blur/smear */
   float *precomputed_weight;
   bool precomputed_weight_ready;
+
+  /**
+   * Modify #Mesh.dvert directly, the evaluated mesh draws from this array
+   * and no modifier depends on the weights, otherwise we need to refresh the modifier stack.
+   */
+  bool use_fast_update;
 };
 
 /* Initialize the stroke cache invariants from operator properties */
@@ -1700,6 +1741,8 @@ static bool wpaint_stroke_test_start(bContext *C, wmOperator *op, const float mo
     wpd->precomputed_weight = MEM_mallocN(sizeof(float) * me->totvert, __func__);
   }
 
+  wpd->use_fast_update = weight_paint_use_fast_update_check(scene, ob);
+
   /* If not previously created, create vertex/weight paint mode session data */
   vertex_paint_init_stroke(depsgraph, ob);
   vwpaint_update_cache_invariants(C, vp, ss, op, mouse);
@@ -2405,7 +2448,14 @@ static void wpaint_stroke_update_step(bContext *C, struct PaintStroke *stroke, P
 
   BKE_mesh_batch_cache_dirty_tag(ob->data, BKE_MESH_BATCH_DIRTY_ALL);
 
-  DEG_id_tag_update(ob->data, 0);
+  if (wpd->use_fast_update == false) {
+    /* Recalculate modifier stack to get new weights, slow, avoid this if we can! */
+    DEG_id_tag_update(ob->data, 0);
+  }
+  else {
+    /* Flush changes through DEG. */
+    DEG_id_tag_update(ob->data, ID_RECALC_COPY_ON_WRITE);
+  }
   WM_event_add_notifier(C, NC_OBJECT | ND_DRAW, ob);
   swap_m4m4(wpd->vc.rv3d->persmat, mat);
 
@@ -2448,15 +2448,11 @@ static float brush_strength(const Sculpt *sd,
 }
 
 /* Return a multiplier for brush strength on a particular vertex. */
-float SCULPT_brush_strength_factor(SculptSession *ss,
-                                   const Brush *br,
-                                   const float brush_point[3],
-                                   const float len,
-                                   const short vno[3],
-                                   const float fno[3],
-                                   const float mask,
-                                   const int vertex_index,
-                                   const int thread_id)
+/* Strength of the brush texture at the given point, 1.0 without a texture. */
+static float sculpt_brush_texture_strength(SculptSession *ss,
+                                           const Brush *br,
+                                           const float brush_point[3],
+                                           const int thread_id)
 {
   StrokeCache *cache = ss->cache;
   const Scene *scene = cache->vc->scene;
@@ -2519,6 +2515,22 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
     }
   }
 
+  return avg;
+}
+
+float SCULPT_brush_strength_factor(SculptSession *ss,
+                                   const Brush *br,
+                                   const float brush_point[3],
+                                   const float len,
+                                   const short vno[3],
+                                   const float fno[3],
+                                   const float mask,
+                                   const int vertex_index,
+                                   const int thread_id)
+{
+  StrokeCache *cache = ss->cache;
+  float avg = sculpt_brush_texture_strength(ss, br, brush_point, thread_id);
+
   /* Hardness. */
   float final_len = len;
   const float hardness = cache->paint_brush.hardness;
@@ -2547,6 +2559,106 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
   return avg;
 }
 
+void SCULPT_brush_batch_add(SculptBrushBatch *batch,
+                            const PBVHVertexIter *vd,
+                            const float co[3],
+                            const short vno[3],
+                            const float fno[3],
+                            const float len,
+                            const float mask)
+{
+  BLI_assert(batch->count < SCULPT_BRUSH_BATCH_SIZE);
+  const int i = batch->count++;
+
+  copy_v3_v3(batch->co[i], co);
+  float no[3];
+  if (vno) {
+    normal_short_to_float_v3(no, vno);
+  }
+  else if (fno) {
+    copy_v3_v3(no, fno);
+  }
+  else {
+    zero_v3(no);
+  }
+  batch->no[0][i] = no[0];
+  batch->no[1][i] = no[1];
+  batch->no[2][i] = no[2];
+  batch->len[i] = len;
+  batch->mask[i] = mask;
+  batch->vertex_index[i] = vd->index;
+
+  batch->proxy_index[i] = vd->i;
+  batch->vert_co[i] = vd->co;
+  batch->vert_mask[i] = vd->mask;
+  batch->mvert[i] = vd->mvert;
+}
+
+void SCULPT_brush_strength_factor_batch(SculptSession *ss,
+                                        const Brush *br,
+                                        SculptBrushBatch *batch,
+                                        const int thread_id)
+{
+  StrokeCache *cache = ss->cache;
+  const int count = batch->count;
+  float *fade = batch->fade;
+
+  if (br->mtex.tex) {
+    for (int i = 0; i < count; i++) {
+      fade[i] = sculpt_brush_texture_strength(ss, br, batch->co[i], thread_id);
+    }
+  }
+  else {
+    copy_vn_fl(fade, count, 1.0f);
+  }
+
+  /* Hardness. */
+  const float radius = cache->radius;
+  const float hardness = cache->paint_brush.hardness;
+  float final_len[SCULPT_BRUSH_BATCH_SIZE];
+  for (int i = 0; i < count; i++) {
+    float p = batch->len[i] / radius;
+    if (p < hardness) {
+      final_len[i] = 0.0f;
+    }
+    else if (hardness == 1.0f) {
+      final_len[i] = radius;
+    }
+    else {
+      p = (p - hardness) / (1.0f - hardness);
+      final_len[i] = p * radius;
+    }
+  }
+
+  /* Falloff curve. */
+  float curve[SCULPT_BRUSH_BATCH_SIZE];
+  BKE_brush_curve_strength_array(br, final_len, curve, count, radius);
+  for (int i = 0; i < count; i++) {
+    fade[i] *= curve[i];
+  }
+
+  if (br->flag & BRUSH_FRONTFACE) {
+    const float *view_normal = cache->view_normal;
+    for (int i = 0; i < count; i++) {
+      const float dot = batch->no[0][i] * view_normal[0] + batch->no[1][i] * view_normal[1] +
+                        batch->no[2][i] * view_normal[2];
+      fade[i] *= dot > 0.0f ? dot : 0.0f;
+    }
+  }
+
+  /* Paint mask. */
+  for (int i = 0; i < count; i++) {
+    fade[i] *= 1.0f - batch->mask[i];
+  }
+
+  /* Auto-masking. */
+  if (cache->automasking) {
+    for (int i = 0; i < count; i++) {
+      fade[i] *= SCULPT_automasking_factor_get(cache->automasking, ss, batch->vertex_index[i]);
+    }
+  }
+}
+
 /* Test AABB against sphere. */
 bool SCULPT_search_sphere_cb(PBVHNode *node, void *data_v)
 {
@@ -3102,6 +3214,27 @@ static void do_displacement_eraser_brush(Sculpt *sd, Object *ob, PBVHNode **node
 
 /** \} */
 
+static void do_draw_brush_batch_apply(SculptSession *ss,
+                                      const Brush *brush,
+                                      SculptBrushBatch *batch,
+                                      float (*proxy)[3],
+                                      const float offset[3],
+                                      const int thread_id)
+{
+  SCULPT_brush_strength_factor_batch(ss, brush, batch, thread_id);
+
+  for (int i = 0; i < batch->count; i++) {
+    /* Offset vertex. */
+    mul_v3_v3fl(proxy[batch->proxy_index[i]], offset, batch->fade[i]);
+
+    if (batch->mvert[i]) {
+      batch->mvert[i]->flag |= ME_VERT_PBVH_UPDATE;
+    }
+  }
+
+  batch->count = 0;
+}
+
 static void do_draw_brush_task_cb_ex(void *__restrict userdata,
                                      const int n,
                                      const TaskParallelTLS *__restrict tls)
@@ -3121,28 +3254,22 @@ static void do_draw_brush_task_cb_ex(void *__restrict userdata,
       ss, &test, data->brush->falloff_shape);
   const int thread_id = BLI_task_parallel_thread_id(tls);
 
+  SculptBrushBatch batch;
+  batch.count = 0;
+
   BKE_pbvh_vertex_iter_begin(ss->pbvh, data->nodes[n], vd, PBVH_ITER_UNIQUE)
   {
     if (sculpt_brush_test_sq_fn(&test, vd.co)) {
-      /* Offset vertex. */
-      const float fade = SCULPT_brush_strength_factor(ss,
-                                                      brush,
-                                                      vd.co,
-                                                      sqrtf(test.dist),
-                                                      vd.no,
-                                                      vd.fno,
-                                                      vd.mask ? *vd.mask : 0.0f,
-                                                      vd.index,
-                                                      thread_id);
-
-      mul_v3_v3fl(proxy[vd.i], offset, fade);
-
-      if (vd.mvert) {
-        vd.mvert->flag |= ME_VERT_PBVH_UPDATE;
+      SCULPT_brush_batch_add(
+          &batch, &vd, vd.co, vd.no, vd.fno, sqrtf(test.dist), vd.mask ? *vd.mask : 0.0f);
+      if (batch.count == SCULPT_BRUSH_BATCH_SIZE) {
+        do_draw_brush_batch_apply(ss, brush, &batch, proxy, offset, thread_id);
       }
     }
   }
   BKE_pbvh_vertex_iter_end;
+
+  do_draw_brush_batch_apply(ss, brush, &batch, proxy, offset, thread_id);
 }
 
 static void do_draw_brush(Sculpt *sd, Object *ob, PBVHNode **nodes, int totnode)
@@ -3809,6 +3936,46 @@ static void do_pinch_brush(Sculpt *sd, Object *ob, PBVHNode **nodes, int totnode
   BLI_task_parallel_range(0, totnode, &data, do_pinch_brush_task_cb_ex, &settings);
 }
 
+static void do_grab_brush_batch_apply(SculptSession *ss,
+                                      const Brush *brush,
+                                      SculptBrushBatch *batch,
+                                      float (*proxy)[3],
+                                      const float grab_delta[3],
+                                      const int thread_id)
+{
+  const float bstrength = ss->cache->bstrength;
+
+  SCULPT_brush_strength_factor_batch(ss, brush, batch, thread_id);
+
+  if (brush->flag2 & BRUSH_GRAB_SILHOUETTE) {
+    float silhouette_test_dir[3];
+    normalize_v3_v3(silhouette_test_dir, grab_delta);
+    if (dot_v3v3(ss->cache->initial_normal, ss->cache->grab_delta_symmetry) < 0.0f) {
+      mul_v3_fl(silhouette_test_dir, -1.0f);
+    }
+    for (int i = 0; i < batch->count; i++) {
+      const float vno[3] = {batch->no[0][i], batch->no[1][i], batch->no[2][i]};
+      batch->fade[i] = bstrength * batch->fade[i] *
+                       max_ff(dot_v3v3(vno, silhouette_test_dir), 0.0f);
+    }
+  }
+  else {
+    for (int i = 0; i < batch->count; i++) {
+      batch->fade[i] *= bstrength;
+    }
+  }
+
+  for (int i = 0; i < batch->count; i++) {
+    mul_v3_v3fl(proxy[batch->proxy_index[i]], grab_delta, batch->fade[i]);
+
+    if (batch->mvert[i]) {
+      batch->mvert[i]->flag |= ME_VERT_PBVH_UPDATE;
+    }
+  }
+
+  batch->count = 0;
+}
+
 static void do_grab_brush_task_cb_ex(void *__restrict userdata,
                                      const int n,
                                      const TaskParallelTLS *__restrict tls)
@@ -3821,7 +3988,6 @@ static void do_grab_brush_task_cb_ex(void *__restrict userdata,
   PBVHVertexIter vd;
   SculptOrigVertData orig_data;
   float(*proxy)[3];
-  const float bstrength = ss->cache->bstrength;
 
   SCULPT_orig_vert_data_init(&orig_data, data->ob, data->nodes[n]);
 
@@ -3832,42 +3998,29 @@ static void do_grab_brush_task_cb_ex(void *__restrict userdata,
       ss, &test, data->brush->falloff_shape);
   const int thread_id = BLI_task_parallel_thread_id(tls);
 
-  const bool grab_silhouette = brush->flag2 & BRUSH_GRAB_SILHOUETTE;
+  SculptBrushBatch batch;
+  batch.count = 0;
 
   BKE_pbvh_vertex_iter_begin(ss->pbvh, data->nodes[n], vd, PBVH_ITER_UNIQUE)
   {
     SCULPT_orig_vert_data_update(&orig_data, &vd);
 
     if (sculpt_brush_test_sq_fn(&test, orig_data.co)) {
-      float fade = bstrength * SCULPT_brush_strength_factor(ss,
-                                                            brush,
-                                                            orig_data.co,
-                                                            sqrtf(test.dist),
-                                                            orig_data.no,
-                                                            NULL,
-                                                            vd.mask ? *vd.mask : 0.0f,
-                                                            vd.index,
-                                                            thread_id);
-
-      if (grab_silhouette) {
-        float silhouette_test_dir[3];
-        normalize_v3_v3(silhouette_test_dir, grab_delta);
-        if (dot_v3v3(ss->cache->initial_normal, ss->cache->grab_delta_symmetry) < 0.0f) {
-          mul_v3_fl(silhouette_test_dir, -1.0f);
-        }
-        float vno[3];
-        normal_short_to_float_v3(vno, orig_data.no);
-        fade *= max_ff(dot_v3v3(vno, silhouette_test_dir), 0.0f);
-      }
-
-      mul_v3_v3fl(proxy[vd.i], grab_delta, fade);
-
-      if (vd.mvert) {
-        vd.mvert->flag |= ME_VERT_PBVH_UPDATE;
+      SCULPT_brush_batch_add(&batch,
+                             &vd,
+                             orig_data.co,
+                             orig_data.no,
+                             NULL,
+                             sqrtf(test.dist),
+                             vd.mask ? *vd.mask : 0.0f);
+      if (batch.count == SCULPT_BRUSH_BATCH_SIZE) {
+        do_grab_brush_batch_apply(ss, brush, &batch, proxy, grab_delta, thread_id);
       }
     }
   }
   BKE_pbvh_vertex_iter_end;
+
+  do_grab_brush_batch_apply(ss, brush, &batch, proxy, grab_delta, thread_id);
 }
 
 static void do_grab_brush(Sculpt *sd, Object *ob, PBVHNode **nodes, int totnode)
@@ -813,6 +813,45 @@ float SCULPT_brush_strength_factor(struct SculptSession *ss,
                                    const int vertex_index,
                                    const int thread_id);
 
+/* Vertices passing the brush test are gathered in blocks, so the strength factors of a block can
+ * be computed in tight loops with the per-stroke state checked once. */
+#define SCULPT_BRUSH_BATCH_SIZE 64
+
+typedef struct SculptBrushBatch {
+  int count;
+
+  /* Inputs of the strength factor, normals are stored per component. */
+  float co[SCULPT_BRUSH_BATCH_SIZE][3];
+  float no[3][SCULPT_BRUSH_BATCH_SIZE];
+  float len[SCULPT_BRUSH_BATCH_SIZE];
+  float mask[SCULPT_BRUSH_BATCH_SIZE];
+  int vertex_index[SCULPT_BRUSH_BATCH_SIZE];
+
+  /* Iterator state to write the results back. */
+  int proxy_index[SCULPT_BRUSH_BATCH_SIZE];
+  float *vert_co[SCULPT_BRUSH_BATCH_SIZE];
+  float *vert_mask[SCULPT_BRUSH_BATCH_SIZE];
+  struct MVert *mvert[SCULPT_BRUSH_BATCH_SIZE];
+
+  /* Output of #SCULPT_brush_strength_factor_batch. */
+  float fade[SCULPT_BRUSH_BATCH_SIZE];
+} SculptBrushBatch;
+
+/* Add a vertex to the batch, the caller is responsible for flushing it once full. */
+void SCULPT_brush_batch_add(SculptBrushBatch *batch,
+                            const PBVHVertexIter *vd,
+                            const float co[3],
+                            const short vno[3],
+                            const float fno[3],
+                            const float len,
+                            const float mask);
+/* Same as #SCULPT_brush_strength_factor for all vertices in the batch, stored in `batch->fade`.
+ */
+void SCULPT_brush_strength_factor_batch(struct SculptSession *ss,
+                                        const struct Brush *br,
+                                        SculptBrushBatch *batch,
+                                        const int thread_id);
+
 /* Tilts a normal by the x and y tilt values using the view axis. */
 void SCULPT_tilt_apply_to_normal(float r_normal[3],
                                  struct StrokeCache *cache,
@@ -289,6 +289,43 @@ static void SCULPT_enhance_details_brush(Sculpt *sd,
   BLI_task_parallel_range(0, totnode, &data, do_enhance_details_brush_task_cb_ex, &settings);
 }
 
+/* Vertices are smoothed in place in iteration order, neighbors might already be smoothed. */
+static void do_smooth_brush_batch_apply(Sculpt *sd,
+                                        SculptSession *ss,
+                                        const Brush *brush,
+                                        SculptBrushBatch *batch,
+                                        const float bstrength,
+                                        const bool smooth_mask,
+                                        const int thread_id)
+{
+  SCULPT_brush_strength_factor_batch(ss, brush, batch, thread_id);
+
+  for (int i = 0; i < batch->count; i++) {
+    const float fade = bstrength * batch->fade[i];
+    const int vertex_index = batch->vertex_index[i];
+    if (smooth_mask) {
+      float *mask = batch->vert_mask[i];
+      float val = SCULPT_neighbor_mask_average(ss, vertex_index) - *mask;
+      val *= fade * bstrength;
+      *mask += val;
+      CLAMP(*mask, 0.0f, 1.0f);
+    }
+    else {
+      float *co = batch->vert_co[i];
+      float avg[3], val[3];
+      SCULPT_neighbor_coords_average_interior(ss, avg, vertex_index);
+      sub_v3_v3v3(val, avg, co);
+      madd_v3_v3v3fl(val, co, val, fade);
+      SCULPT_clip(sd, ss, co, val);
+    }
+    if (batch->mvert[i]) {
+      batch->mvert[i]->flag |= ME_VERT_PBVH_UPDATE;
+    }
+  }
+
+  batch->count = 0;
+}
+
 static void do_smooth_brush_task_cb_ex(void *__restrict userdata,
                                        const int n,
                                        const TaskParallelTLS *__restrict tls)
@@ -310,38 +347,27 @@ static void do_smooth_brush_task_cb_ex(void *__restrict userdata,
 
   const int thread_id = BLI_task_parallel_thread_id(tls);
 
+  SculptBrushBatch batch;
+  batch.count = 0;
+
   BKE_pbvh_vertex_iter_begin(ss->pbvh, data->nodes[n], vd, PBVH_ITER_UNIQUE)
   {
     if (sculpt_brush_test_sq_fn(&test, vd.co)) {
-      const float fade = bstrength * SCULPT_brush_strength_factor(
-                                         ss,
-                                         brush,
-                                         vd.co,
-                                         sqrtf(test.dist),
-                                         vd.no,
-                                         vd.fno,
-                                         smooth_mask ? 0.0f : (vd.mask ? *vd.mask : 0.0f),
-                                         vd.index,
-                                         thread_id);
-      if (smooth_mask) {
-        float val = SCULPT_neighbor_mask_average(ss, vd.index) - *vd.mask;
-        val *= fade * bstrength;
-        *vd.mask += val;
-        CLAMP(*vd.mask, 0.0f, 1.0f);
-      }
-      else {
-        float avg[3], val[3];
-        SCULPT_neighbor_coords_average_interior(ss, avg, vd.index);
-        sub_v3_v3v3(val, avg, vd.co);
-        madd_v3_v3v3fl(val, vd.co, val, fade);
-        SCULPT_clip(sd, ss, vd.co, val);
-      }
-      if (vd.mvert) {
-        vd.mvert->flag |= ME_VERT_PBVH_UPDATE;
+      SCULPT_brush_batch_add(&batch,
+                             &vd,
+                             vd.co,
+                             vd.no,
+                             vd.fno,
+                             sqrtf(test.dist),
+                             smooth_mask ? 0.0f : (vd.mask ? *vd.mask : 0.0f));
+      if (batch.count == SCULPT_BRUSH_BATCH_SIZE) {
+        do_smooth_brush_batch_apply(sd, ss, brush, &batch, bstrength, smooth_mask, thread_id);
       }
     }
   }
   BKE_pbvh_vertex_iter_end;
+
+  do_smooth_brush_batch_apply(sd, ss, brush, &batch, bstrength, smooth_mask, thread_id);
 }
 
 void SCULPT_smooth(Sculpt *sd,
@@ -45,6 +45,7 @@
 #include "BKE_customdata.h"
 #include "BKE_global.h"
 #include "BKE_key.h"
+#include "BKE_lib_id.h"
 #include "BKE_main.h"
 #include "BKE_mesh.h"
 #include "BKE_multires.h"
@@ -1334,6 +1335,250 @@ SculptUndoNode *SCULPT_undo_push_node(Object *ob, PBVHNode *node, SculptUndoType
   return unode;
 }
 
+/* Keep only the vertices of a regular mesh node kept[i] is true for, returns the number of bytes
+ * freed. */
+static size_t sculpt_undo_compact_verts(SculptUndoNode *unode, const bool *kept)
+{
+  int totkept = 0;
+  for (int i = 0; i < unode->totvert; i++) {
+    if (!kept[i]) {
+      continue;
+    }
+    unode->index[totkept] = unode->index[i];
+    if (unode->co) {
+      copy_v3_v3(unode->co[totkept], unode->co[i]);
+    }
+    if (unode->orig_co) {
+      copy_v3_v3(unode->orig_co[totkept], unode->orig_co[i]);
+    }
+    if (unode->mask) {
+      unode->mask[totkept] = unode->mask[i];
+    }
+    if (unode->col) {
+      copy_v4_v4(unode->col[totkept], unode->col[i]);
+    }
+    totkept++;
+  }
+
+  if (totkept == unode->totvert) {
+    return 0;
+  }
+
+  size_t elem_size = 0;
+  void **arrays[] = {(void **)&unode->index,
+                     (void **)&unode->co,
+                     (void **)&unode->orig_co,
+                     (void **)&unode->mask,
+                     (void **)&unode->col};
+  const size_t sizes[] = {
+      sizeof(int), sizeof(float[3]), sizeof(float[3]), sizeof(float), sizeof(float[4])};
+  for (int i = 0; i < ARRAY_SIZE(arrays); i++) {
+    if (*arrays[i] == NULL) {
+      continue;
+    }
+    elem_size += sizes[i];
+    if (totkept) {
+      *arrays[i] = MEM_reallocN(*arrays[i], sizes[i] * totkept);
+    }
+    else {
+      MEM_freeN(*arrays[i]);
+      *arrays[i] = NULL;
+    }
+  }
+
+  const size_t freed = elem_size * (size_t)(unode->totvert - totkept);
+  unode->totvert = totkept;
+  return freed;
+}
+
+/* Keep only the grids of a multires node kept[i] is true for, returns the number of bytes
+ * freed. */
+static size_t sculpt_undo_compact_grids(SculptUndoNode *unode, const bool *kept)
+{
+  const int grid_area = unode->gridsize * unode->gridsize;
+  int totkept = 0;
+  for (int i = 0; i < unode->totgrid; i++) {
+    if (!kept[i]) {
+      continue;
+    }
+    unode->grids[totkept] = unode->grids[i];
+    if (unode->co) {
+      memmove(unode->co[totkept * grid_area],
+              unode->co[i * grid_area],
+              sizeof(float[3]) * grid_area);
+    }
+    if (unode->mask) {
+      memmove(&unode->mask[totkept * grid_area],
+              &unode->mask[i * grid_area],
+              sizeof(float) * grid_area);
+    }
+    totkept++;
+  }
+
+  if (totkept == unode->totgrid) {
+    return 0;
+  }
+
+  size_t elem_size = 0;
+  if (unode->co) {
+    elem_size += sizeof(float[3]) * grid_area;
+    unode->co = totkept ? MEM_reallocN(unode->co, sizeof(float[3]) * grid_area * totkept) : NULL;
+  }
+  if (unode->mask) {
+    elem_size += sizeof(float) * grid_area;
+    unode->mask = totkept ? MEM_reallocN(unode->mask, sizeof(float) * grid_area * totkept) : NULL;
+  }
+  if (totkept == 0) {
+    MEM_freeN(unode->grids);
+    unode->grids = NULL;
+  }
+  else {
+    unode->grids = MEM_reallocN(unode->grids, sizeof(int) * totkept);
+  }
+
+  const size_t freed = (elem_size + sizeof(int)) * (size_t)(unode->totgrid - totkept);
+  unode->totgrid = totkept;
+  return freed;
+}
+
+typedef struct SculptUndoCompactData {
+  SculptSession *ss;
+  SculptUndoNode **unodes;
+  size_t *freed;
+} SculptUndoCompactData;
+
+static void sculpt_undo_compact_task_cb(void *__restrict userdata,
+                                        const int n,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SculptUndoCompactData *data = userdata;
+  SculptSession *ss = data->ss;
+  SculptUndoNode *unode = data->unodes[n];
+
+  if (unode->maxvert) {
+    const MVert *mvert = BKE_pbvh_get_verts(ss->pbvh);
+    bool *kept = MEM_mallocN(sizeof(bool) * unode->totvert, __func__);
+
+    for (int i = 0; i < unode->totvert; i++) {
+      const int vert = unode->index[i];
+      /* No need for float comparison here (memory is exactly equal or not). */
+      switch (unode->type) {
+        case SCULPT_UNDO_COORDS:
+          kept[i] = memcmp(unode->co[i], mvert[vert].co, sizeof(float[3])) != 0 ||
+                    (unode->orig_co &&
+                     memcmp(unode->orig_co[i], ss->orig_cos[vert], sizeof(float[3])) != 0);
+          break;
+        case SCULPT_UNDO_MASK:
+          kept[i] = unode->mask[i] != ss->vmask[vert];
+          break;
+        case SCULPT_UNDO_COLOR:
+          kept[i] = memcmp(unode->col[i], ss->vcol[vert].color, sizeof(float[4])) != 0;
+          break;
+        default:
+          kept[i] = true;
+          break;
+      }
+    }
+
+    data->freed[n] = sculpt_undo_compact_verts(unode, kept);
+    MEM_freeN(kept);
+  }
+  else {
+    SubdivCCG *subdiv_ccg = ss->subdiv_ccg;
+    const int grid_area = unode->gridsize * unode->gridsize;
+    CCGKey key;
+    BKE_subdiv_ccg_key_top_level(&key, subdiv_ccg);
+    bool *kept = MEM_mallocN(sizeof(bool) * unode->totgrid, __func__);
+
+    for (int j = 0; j < unode->totgrid; j++) {
+      CCGElem *grid = subdiv_ccg->grids[unode->grids[j]];
+      kept[j] = false;
+      for (int i = 0; i < grid_area && !kept[j]; i++) {
+        if (unode->type == SCULPT_UNDO_COORDS) {
+          kept[j] = memcmp(unode->co[j * grid_area + i],
+                           CCG_elem_offset_co(&key, grid, i),
+                           sizeof(float[3])) != 0;
+        }
+        else {
+          kept[j] = unode->mask[j * grid_area + i] != *CCG_elem_offset_mask(&key, grid, i);
+        }
+      }
+    }
+
+    data->freed[n] = sculpt_undo_compact_grids(unode, kept);
+    MEM_freeN(kept);
+  }
+}
+
+/* Only store the vertices and grids a finished stroke has actually changed: brushes push whole
+ * PBVH nodes, even when they only touch a few of their vertices. Restoring swaps values, so
+ * unchanged elements are not needed for redo either. */
+static void sculpt_undo_compact_nodes(UndoSculpt *usculpt)
+{
+  SculptUndoNode *unode_first = usculpt->nodes.first;
+  if (unode_first == NULL) {
+    return;
+  }
+
+  Object *ob = (Object *)BKE_libblock_find_name(G_MAIN, ID_OB, unode_first->idname + 2);
+  SculptSession *ss = ob ? ob->sculpt : NULL;
+  if (ss == NULL || ss->pbvh == NULL || ss->bm) {
+    return;
+  }
+
+  const int totnode = BLI_listbase_count(&usculpt->nodes);
+  SculptUndoNode **unodes = MEM_mallocN(sizeof(*unodes) * totnode, __func__);
+  int totcompact = 0;
+
+  LISTBASE_FOREACH (SculptUndoNode *, unode, &usculpt->nodes) {
+    if (!STREQ(unode->idname, unode_first->idname)) {
+      continue;
+    }
+    if (unode->maxvert) {
+      if (!ELEM(unode->type, SCULPT_UNDO_COORDS, SCULPT_UNDO_MASK, SCULPT_UNDO_COLOR) ||
+          BKE_pbvh_type(ss->pbvh) != PBVH_FACES || ss->totvert != unode->maxvert) {
+        continue;
+      }
+      if ((unode->type == SCULPT_UNDO_COORDS && unode->orig_co && ss->orig_cos == NULL) ||
+          (unode->type == SCULPT_UNDO_MASK && ss->vmask == NULL) ||
+          (unode->type == SCULPT_UNDO_COLOR && ss->vcol == NULL)) {
+        continue;
+      }
+    }
+    else if (unode->maxgrid) {
+      if (!ELEM(unode->type, SCULPT_UNDO_COORDS, SCULPT_UNDO_MASK) || ss->subdiv_ccg == NULL ||
+          ss->subdiv_ccg->num_grids != unode->maxgrid ||
+          ss->subdiv_ccg->grid_size != unode->gridsize) {
+        continue;
+      }
+      if (unode->type == SCULPT_UNDO_MASK && !ss->subdiv_ccg->has_mask) {
+        continue;
+      }
+    }
+    else {
+      continue;
+    }
+    unodes[totcompact++] = unode;
+  }
+
+  SculptUndoCompactData data = {
+      .ss = ss,
+      .unodes = unodes,
+      .freed = MEM_callocN(sizeof(size_t) * totcompact, __func__),
+  };
+
+  TaskParallelSettings settings;
+  BKE_pbvh_parallel_range_settings(&settings, true, totcompact);
+  BLI_task_parallel_range(0, totcompact, &data, sculpt_undo_compact_task_cb, &settings);
+
+  for (int i = 0; i < totcompact; i++) {
+    usculpt->undo_size -= min_zz(data.freed[i], usculpt->undo_size);
+  }
+
+  MEM_freeN(data.freed);
+  MEM_freeN(unodes);
+}
+
 void SCULPT_undo_push_begin(Object *ob, const char *name)
 {
   UndoStack *ustack = ED_undo_stack_get();
@@ -1372,6 +1617,9 @@ void SCULPT_undo_push_end_ex(const bool use_nested_undo)
   /* We could remove this and enforce all callers run in an operator using 'OPTYPE_UNDO'. */
   wmWindowManager *wm = G_MAIN->wm.first;
   if (wm->op_undo_depth == 0 || use_nested_undo) {
+    /* Only once the step is finished, nested pushes still use the full nodes. */
+    sculpt_undo_compact_nodes(usculpt);
+
     UndoStack *ustack = ED_undo_stack_get();
     BKE_undosys_step_push(ustack, NULL, NULL);
     if (wm->op_undo_depth == 0) {
@@ -2560,7 +2560,28 @@ static int filelist_readjob_list_dir(const char *root,
   return nbr_entries;
 }
 
-static int filelist_readjob_list_lib(const char *root, ListBase *entries, const bool skip_currpar)
+/**
+ * The last library opened by a read job. With recursion, the groups of a .blend file are listed
+ * right after the file itself, keeping it open avoids reading the file again for each group.
+ */
+typedef struct FileListReadLib {
+  char filepath[FILE_MAX_LIBEXTRA];
+  struct BlendHandle *libfiledata;
+} FileListReadLib;
+
+static void filelist_readjob_lib_close(FileListReadLib *read_lib)
+{
+  if (read_lib->libfiledata != NULL) {
+    BLO_blendhandle_close(read_lib->libfiledata);
+    read_lib->libfiledata = NULL;
+  }
+  read_lib->filepath[0] = '\0';
+}
+
+static int filelist_readjob_list_lib(const char *root,
+                                     ListBase *entries,
+                                     const bool skip_currpar,
+                                     FileListReadLib *read_lib)
 {
   FileListInternEntry *entry;
   LinkNode *ln, *names;
@@ -2577,7 +2598,12 @@ static int filelist_readjob_list_lib(const char *root, ListBase *entries, const
   }
 
   /* there we go */
-  libfiledata = BLO_blendhandle_from_file(dir, NULL);
+  if (!STREQ(read_lib->filepath, dir)) {
+    filelist_readjob_lib_close(read_lib);
+    read_lib->libfiledata = BLO_blendhandle_from_file(dir, NULL);
+    BLI_strncpy(read_lib->filepath, dir, sizeof(read_lib->filepath));
+  }
+  libfiledata = read_lib->libfiledata;
   if (libfiledata == NULL) {
     return nbr_entries;
   }
@@ -2593,8 +2619,6 @@ static int filelist_readjob_list_lib(const char *root, ListBase *entries, const
     nnames = BLI_linklist_count(names);
   }
 
-  BLO_blendhandle_close(libfiledata);
-
   if (!skip_currpar) {
     entry = MEM_callocN(sizeof(*entry), __func__);
     entry->relpath = BLI_strdup(FILENAME_PARENT);
@@ -2816,6 +2840,7 @@ static void filelist_readjob_do(const bool do_lib,
   const char *root = filelist->filelist.root;
   const int max_recursion = filelist->max_recursion;
   int nbr_done_dirs = 0, nbr_todo_dirs = 1;
+  FileListReadLib read_lib = {{0}};
 
   //  BLI_assert(filelist->filtered == NULL);
   BLI_assert(BLI_listbase_is_empty(&filelist->filelist.entries) &&
@@ -2858,7 +2883,7 @@ static void filelist_readjob_do(const bool do_lib,
     BLI_path_rel(rel_subdir, root);
 
     if (do_lib) {
-      nbr_entries = filelist_readjob_list_lib(subdir, &entries, skip_currpar);
+      nbr_entries = filelist_readjob_list_lib(subdir, &entries, skip_currpar, &read_lib);
     }
     if (!nbr_entries) {
       is_lib = false;
@@ -2929,6 +2954,8 @@ static void filelist_readjob_do(const bool do_lib,
     BLI_stack_discard(todo_dirs);
   }
   BLI_stack_free(todo_dirs);
+
+  filelist_readjob_lib_close(&read_lib);
 }
 
 static void filelist_readjob_dir(FileList *filelist,
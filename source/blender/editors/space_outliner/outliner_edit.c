@@ -2259,29 +2259,15 @@ static bool ed_operator_outliner_id_orphans_active(bContext *C)
 
 /** \} */
 
-static void outliner_orphans_purge_tag(ID *id, int *num_tagged)
-{
-  if (id->us == 0) {
-    id->tag |= LIB_TAG_DOIT;
-    num_tagged[INDEX_ID_NULL]++;
-    num_tagged[BKE_idtype_idcode_to_index(GS(id->name))]++;
-  }
-  else {
-    id->tag &= ~LIB_TAG_DOIT;
-  }
-}
-
 static int outliner_orphans_purge_invoke(bContext *C, wmOperator *op, const wmEvent *UNUSED(evt))
 {
   Main *bmain = CTX_data_main(C);
   int num_tagged[INDEX_ID_MAX] = {0};
 
+  const bool do_recursive_cleanup = RNA_boolean_get(op->ptr, "do_recursive");
+
   /* Tag all IDs having zero users. */
-  ID *id;
-  FOREACH_MAIN_ID_BEGIN (bmain, id) {
-    outliner_orphans_purge_tag(id, num_tagged);
-  }
-  FOREACH_MAIN_ID_END;
+  BKE_lib_query_unused_ids_tag(bmain, LIB_TAG_DOIT, do_recursive_cleanup, num_tagged);
   RNA_int_set(op->ptr, "num_deleted", num_tagged[INDEX_ID_NULL]);
 
   if (num_tagged[INDEX_ID_NULL] == 0) {
@@ -2323,13 +2309,11 @@ static int outliner_orphans_purge_exec(bContext *C, wmOperator *op)
   SpaceOutliner *space_outliner = CTX_wm_space_outliner(C);
   int num_tagged[INDEX_ID_MAX] = {0};
 
+  const bool do_recursive_cleanup = RNA_boolean_get(op->ptr, "do_recursive");
+
   if ((num_tagged[INDEX_ID_NULL] = RNA_int_get(op->ptr, "num_deleted")) == 0) {
     /* Tag all IDs having zero users. */
-    ID *id;
-    FOREACH_MAIN_ID_BEGIN (bmain, id) {
-      outliner_orphans_purge_tag(id, num_tagged);
-    }
-    FOREACH_MAIN_ID_END;
+    BKE_lib_query_unused_ids_tag(bmain, LIB_TAG_DOIT, do_recursive_cleanup, num_tagged);
 
     if (num_tagged[INDEX_ID_NULL] == 0) {
       BKE_report(op->reports, RPT_INFO, "No orphaned data-blocks to purge");
@@ -2374,6 +2358,13 @@ void OUTLINER_OT_orphans_purge(wmOperatorType *ot)
   /* properties */
   PropertyRNA *prop = RNA_def_int(ot->srna, "num_deleted", 0, 0, INT_MAX, "", "", 0, INT_MAX);
   RNA_def_property_flag(prop, PROP_SKIP_SAVE | PROP_HIDDEN);
+
+  RNA_def_boolean(ot->srna,
+                  "do_recursive",
+                  false,
+                  "Recursive Delete",
+                  "Recursively check for indirectly unused data-blocks, ensuring that no orphaned "
+                  "data-blocks remain after execution");
 }
 
 /** \} */
@@ -247,6 +247,15 @@ bool outliner_requires_rebuild_on_select_or_active_change(const SpaceOutliner *s
   return exclude_flags & (SO_FILTER_OB_STATE_SELECTED | SO_FILTER_OB_STATE_ACTIVE);
 }
 
+bool outliner_requires_rebuild_on_visibility_change(const SpaceOutliner *space_outliner)
+{
+  int exclude_flags = outliner_exclude_filter_get(space_outliner);
+  /* Hiding objects also changes their selected and selectable state, so any filter based on the
+   * object state has to be re-applied. Otherwise the visibility is only drawn, not stored in the
+   * tree. */
+  return exclude_flags & SO_FILTER_OB_STATE;
+}
+
 /**
  * Check if a display mode needs a full rebuild if the open/collapsed state changes.
  * Element types in these modes don't actually add children if collapsed, so the rebuild is needed.
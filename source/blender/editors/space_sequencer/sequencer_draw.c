@@ -293,6 +293,21 @@ static void draw_seq_waveform(View2D *v2d,
       return;
     }
 
+    /* Use the coarsest level that still has a sample per step, so zoomed out strips don't have
+     * to look at every sample of the sound. */
+    const float *data = waveform->data;
+    int data_length = waveform->length;
+    int lod_factor = 1;
+    for (int lod = 0; lod < SOUND_WAVE_LOD_LEN && waveform->lod_data[lod]; lod++) {
+      if (lod_factor * 2 > samplestep) {
+        break;
+      }
+      lod_factor *= 2;
+      data = waveform->lod_data[lod];
+      data_length = waveform->lod_length[lod];
+    }
+    const float lod_samplestep = samplestep / lod_factor;
+
     /* F-curve lookup is quite expensive, so do this after precondition. */
     FCurve *fcu = id_data_find_fcurve(&scene->id, seq, &RNA_Sequence, "volume", 0, NULL);
 
@@ -304,28 +319,29 @@ static void draw_seq_waveform(View2D *v2d,
     immBegin(GPU_PRIM_TRI_STRIP, length * 2);
 
     for (int i = 0; i < length; i++) {
-      float sampleoffset = startsample + ((x1_offset - x1) / stepsize + i) * samplestep;
-      int p = sampleoffset;
+      float sampleoffset = (startsample + ((x1_offset - x1) / stepsize + i) * samplestep) /
+                           lod_factor;
+      int p = min_ii(sampleoffset, data_length - 1);
 
-      value1 = waveform->data[p * 3];
-      value2 = waveform->data[p * 3 + 1];
+      value1 = data[p * 3];
+      value2 = data[p * 3 + 1];
 
-      if (samplestep > 1.0f) {
-        for (int j = p + 1; (j < waveform->length) && (j < p + samplestep); j++) {
-          if (value1 > waveform->data[j * 3]) {
-            value1 = waveform->data[j * 3];
+      if (lod_samplestep > 1.0f) {
+        for (int j = p + 1; (j < data_length) && (j < p + lod_samplestep); j++) {
+          if (value1 > data[j * 3]) {
+            value1 = data[j * 3];
           }
 
-          if (value2 < waveform->data[j * 3 + 1]) {
-            value2 = waveform->data[j * 3 + 1];
+          if (value2 < data[j * 3 + 1]) {
+            value2 = data[j * 3 + 1];
           }
         }
       }
-      else if (p + 1 < waveform->length) {
+      else if (p + 1 < data_length) {
         /* Use simple linear interpolation. */
         float f = sampleoffset - p;
-        value1 = (1.0f - f) * value1 + f * waveform->data[p * 3 + 3];
-        value2 = (1.0f - f) * value2 + f * waveform->data[p * 3 + 4];
+        value1 = (1.0f - f) * value1 + f * data[p * 3 + 3];
+        value2 = (1.0f - f) * value2 + f * data[p * 3 + 4];
       }
 
       if (fcu && !BKE_fcurve_is_empty(fcu)) {
@@ -32,6 +32,7 @@
 #include "BLI_linklist_stack.h"
 #include "BLI_math.h"
 #include "BLI_memarena.h"
+#include "BLI_task.h"
 
 #include "BKE_context.h"
 #include "BKE_crazyspace.h"
@@ -662,6 +663,140 @@ static void VertsToTransData(TransInfo *t,
   }
 }
 
+/* Entries of the vertex index map for vertices without #TransData, which are either skipped or
+ * get a #TransDataMirror. */
+#define TRANS_VERT_INDEX_SKIP -1
+#define TRANS_VERT_INDEX_MIRROR(index) (-2 - (index))
+
+struct TransEditVertsData {
+  TransInfo *t;
+  TransDataContainer *tc;
+  BMEditMesh *em;
+  TransDataExtension *tx;
+  /* Index into #TransDataContainer.data for every vertex, see #TRANS_VERT_INDEX_MIRROR. */
+  const int *vert_td_index;
+  int prop_mode;
+  const struct TransIslandData *island_data;
+  struct TransMirrorData *mirror_data;
+  const float *dists;
+  const int *dists_index;
+  float (*quats)[4];
+  float (*defmats)[3][3];
+  int cd_vert_bweight_offset;
+  float mtx[3][3], smtx[3][3];
+};
+
+static void trans_edit_verts_create_cb(void *__restrict userdata,
+                                       const int a,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  struct TransEditVertsData *data = userdata;
+  const int td_index = data->vert_td_index[a];
+  if (td_index == TRANS_VERT_INDEX_SKIP) {
+    return;
+  }
+
+  TransInfo *t = data->t;
+  TransDataContainer *tc = data->tc;
+  BMesh *bm = data->em->bm;
+  const struct TransIslandData *island_data = data->island_data;
+  struct TransMirrorData *mirror_data = data->mirror_data;
+  BMVert *eve = BM_vert_at_index(bm, a);
+
+  int island_index = -1;
+  if (island_data->island_vert_map) {
+    const int connected_index = (data->dists_index && data->dists_index[a] != -1) ?
+                                    data->dists_index[a] :
+                                    a;
+    island_index = island_data->island_vert_map[connected_index];
+  }
+
+  if (td_index < TRANS_VERT_INDEX_SKIP) {
+    TransDataMirror *td_mirror = &tc->data_mirror[TRANS_VERT_INDEX_MIRROR(td_index)];
+    int elem_index = mirror_data->vert_map[a].index;
+    BMVert *v_src = BM_vert_at_index(bm, elem_index);
+
+    if (BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
+      mirror_data->vert_map[a].flag |= TD_SELECTED;
+    }
+
+    td_mirror->extra = eve;
+    td_mirror->loc = eve->co;
+    copy_v3_v3(td_mirror->iloc, eve->co);
+    td_mirror->flag = mirror_data->vert_map[a].flag;
+    td_mirror->loc_src = v_src->co;
+    transdata_center_get(island_data, island_index, td_mirror->iloc, td_mirror->center);
+    return;
+  }
+
+  TransData *tob = &tc->data[td_index];
+  TransDataExtension *tx = data->tx ? &data->tx[td_index] : NULL;
+  float *bweight = (data->cd_vert_bweight_offset != -1) ?
+                       BM_ELEM_CD_GET_VOID_P(eve, data->cd_vert_bweight_offset) :
+                       NULL;
+
+  /* Do not use the island center in case we are using islands
+   * only to get axis for snap/rotate to normal... */
+  VertsToTransData(t, tob, tx, data->em, eve, bweight, island_data, island_index);
+
+  /* selected */
+  if (BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
+    tob->flag |= TD_SELECTED;
+  }
+
+  if (data->prop_mode) {
+    if (data->prop_mode & T_PROP_CONNECTED) {
+      tob->dist = data->dists[a];
+    }
+    else {
+      tob->flag |= TD_NOTCONNECTED;
+      tob->dist = FLT_MAX;
+    }
+  }
+
+  /* CrazySpace */
+  const bool use_quats = data->quats && BM_elem_flag_test(eve, BM_ELEM_TAG);
+  if (use_quats || data->defmats) {
+    float mat[3][3], qmat[3][3], imat[3][3];
+
+    /* Use both or either quat and defmat correction. */
+    if (use_quats) {
+      quat_to_mat3(qmat, data->quats[BM_elem_index_get(eve)]);
+
+      if (data->defmats) {
+        mul_m3_series(mat, data->defmats[a], qmat, data->mtx);
+      }
+      else {
+        mul_m3_m3m3(mat, data->mtx, qmat);
+      }
+    }
+    else {
+      mul_m3_m3m3(mat, data->mtx, data->defmats[a]);
+    }
+
+    invert_m3_m3(imat, mat);
+
+    copy_m3_m3(tob->smtx, imat);
+    copy_m3_m3(tob->mtx, mat);
+  }
+  else {
+    copy_m3_m3(tob->smtx, data->smtx);
+    copy_m3_m3(tob->mtx, data->mtx);
+  }
+
+  if (tc->use_mirror_axis_any) {
+    if (tc->use_mirror_axis_x && fabsf(tob->loc[0]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_X;
+    }
+    if (tc->use_mirror_axis_y && fabsf(tob->loc[1]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_Y;
+    }
+    if (tc->use_mirror_axis_z && fabsf(tob->loc[2]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_Z;
+    }
+  }
+}
+
 void createTransEditVerts(TransInfo *t)
 {
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
@@ -836,108 +971,52 @@ void createTransEditVerts(TransInfo *t)
       cd_vert_bweight_offset = CustomData_get_offset(&bm->vdata, CD_BWEIGHT);
     }
 
-    TransData *tob = tc->data;
-    TransDataMirror *td_mirror = tc->data_mirror;
+    /* Assign the transform data of every vertex up front, so they can be filled in parallel. */
+    int *vert_td_index = MEM_mallocN(bm->totvert * sizeof(*vert_td_index), __func__);
+    int td_len = 0, td_mirror_len = 0;
     BM_ITER_MESH_INDEX (eve, &iter, bm, BM_VERTS_OF_MESH, a) {
       if (BM_elem_flag_test(eve, BM_ELEM_HIDDEN)) {
-        continue;
-      }
-
-      int island_index = -1;
-      if (island_data.island_vert_map) {
-        const int connected_index = (dists_index && dists_index[a] != -1) ? dists_index[a] : a;
-        island_index = island_data.island_vert_map[connected_index];
+        vert_td_index[a] = TRANS_VERT_INDEX_SKIP;
       }
-
-      if (mirror_data.vert_map && mirror_data.vert_map[a].index != -1) {
-        int elem_index = mirror_data.vert_map[a].index;
-        BMVert *v_src = BM_vert_at_index(bm, elem_index);
-
-        if (BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
-          mirror_data.vert_map[a].flag |= TD_SELECTED;
-        }
-
-        td_mirror->extra = eve;
-        td_mirror->loc = eve->co;
-        copy_v3_v3(td_mirror->iloc, eve->co);
-        td_mirror->flag = mirror_data.vert_map[a].flag;
-        td_mirror->loc_src = v_src->co;
-        transdata_center_get(&island_data, island_index, td_mirror->iloc, td_mirror->center);
-
-        td_mirror++;
+      else if (mirror_data.vert_map && mirror_data.vert_map[a].index != -1) {
+        vert_td_index[a] = TRANS_VERT_INDEX_MIRROR(td_mirror_len++);
       }
       else if (prop_mode || BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
-        float *bweight = (cd_vert_bweight_offset != -1) ?
-                             BM_ELEM_CD_GET_VOID_P(eve, cd_vert_bweight_offset) :
-                             NULL;
-
-        /* Do not use the island center in case we are using islands
-         * only to get axis for snap/rotate to normal... */
-        VertsToTransData(t, tob, tx, em, eve, bweight, &island_data, island_index);
-        if (tx) {
-          tx++;
-        }
-
-        /* selected */
-        if (BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
-          tob->flag |= TD_SELECTED;
-        }
-
-        if (prop_mode) {
-          if (prop_mode & T_PROP_CONNECTED) {
-            tob->dist = dists[a];
-          }
-          else {
-            tob->flag |= TD_NOTCONNECTED;
-            tob->dist = FLT_MAX;
-          }
-        }
-
-        /* CrazySpace */
-        const bool use_quats = quats && BM_elem_flag_test(eve, BM_ELEM_TAG);
-        if (use_quats || defmats) {
-          float mat[3][3], qmat[3][3], imat[3][3];
-
-          /* Use both or either quat and defmat correction. */
-          if (use_quats) {
-            quat_to_mat3(qmat, quats[BM_elem_index_get(eve)]);
-
-            if (defmats) {
-              mul_m3_series(mat, defmats[a], qmat, mtx);
-            }
-            else {
-              mul_m3_m3m3(mat, mtx, qmat);
-            }
-          }
-          else {
-            mul_m3_m3m3(mat, mtx, defmats[a]);
-          }
-
-          invert_m3_m3(imat, mat);
-
-          copy_m3_m3(tob->smtx, imat);
-          copy_m3_m3(tob->mtx, mat);
-        }
-        else {
-          copy_m3_m3(tob->smtx, smtx);
-          copy_m3_m3(tob->mtx, mtx);
-        }
-
-        if (tc->use_mirror_axis_any) {
-          if (tc->use_mirror_axis_x && fabsf(tob->loc[0]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_X;
-          }
-          if (tc->use_mirror_axis_y && fabsf(tob->loc[1]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_Y;
-          }
-          if (tc->use_mirror_axis_z && fabsf(tob->loc[2]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_Z;
-          }
-        }
-
-        tob++;
+        vert_td_index[a] = td_len++;
+      }
+      else {
+        vert_td_index[a] = TRANS_VERT_INDEX_SKIP;
       }
     }
+    BLI_assert(td_len == tc->data_len);
+    BLI_assert(td_mirror_len == tc->data_mirror_len);
+
+    BM_mesh_elem_table_ensure(bm, BM_VERT);
+
+    struct TransEditVertsData data = {
+        .t = t,
+        .tc = tc,
+        .em = em,
+        .tx = tx,
+        .vert_td_index = vert_td_index,
+        .prop_mode = prop_mode,
+        .island_data = &island_data,
+        .mirror_data = &mirror_data,
+        .dists = dists,
+        .dists_index = dists_index,
+        .quats = quats,
+        .defmats = defmats,
+        .cd_vert_bweight_offset = cd_vert_bweight_offset,
+    };
+    copy_m3_m3(data.mtx, mtx);
+    copy_m3_m3(data.smtx, smtx);
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (bm->totvert > 1024);
+    BLI_task_parallel_range(0, bm->totvert, &data, trans_edit_verts_create_cb, &settings);
+
+    MEM_freeN(vert_td_index);
 
     if (island_data.center) {
       MEM_freeN(island_data.center);
@@ -1584,6 +1663,9 @@ void recalcData_mesh(TransInfo *t)
     BMEditMesh *em = BKE_editmesh_from_object(tc->obedit);
     EDBM_mesh_normals_update(em);
     BKE_editmesh_looptri_calc(em);
+    /* Only coordinates changed, unless face attributes are being corrected too.
+     * Cleared again when the transform finishes, see #special_aftertrans_update__mesh. */
+    em->is_deform_only_update = !is_canceling && (tc->custom.type.data == NULL);
   }
 }
 /** \} */
@@ -1597,6 +1679,12 @@ void special_aftertrans_update__mesh(bContext *UNUSED(C), TransInfo *t)
   const bool is_canceling = (t->state == TRANS_CANCEL);
   const bool use_automerge = !is_canceling && (t->flag & (T_AUTOMERGE | T_AUTOSPLIT)) != 0;
 
+  FOREACH_TRANS_DATA_CONTAINER (t, tc) {
+    /* The final update may change more than coordinates (auto-merge, face attributes). */
+    BMEditMesh *em = BKE_editmesh_from_object(tc->obedit);
+    em->is_deform_only_update = false;
+  }
+
   if (!is_canceling && ELEM(t->mode, TFM_EDGE_SLIDE, TFM_VERT_SLIDE)) {
     /* NOTE(joeedh): Handle multi-res re-projection,
      * done on transform completion since it's really slow. */
@@ -192,6 +192,8 @@ static void memfile_undosys_step_decode(struct bContext *C,
 
   MemFileUndoStep *us = (MemFileUndoStep *)us_p;
   BKE_memfile_undo_decode(us->data, undo_direction, use_old_bmain_data, C);
+  /* Spilled data has been loaded back. */
+  us_p->data_size = us->data->undo_size;
 
   for (UndoStep *us_iter = us_p->next; us_iter; us_iter = us_iter->next) {
     if (BKE_UNDOSYS_TYPE_IS_MEMFILE_SKIP(us_iter->type)) {
@@ -272,6 +274,23 @@ static void memfile_undosys_step_free(UndoStep *us_p)
   BKE_memfile_undo_free(us->data);
 }
 
+static bool memfile_undosys_step_spill(UndoStep *us_p)
+{
+  MemFileUndoStep *us = (MemFileUndoStep *)us_p;
+
+  /* The active memfile step is the reference when writing the next one, keep it in memory. */
+  UndoStack *ustack = ED_undo_stack_get();
+  if (us_p == BKE_undosys_step_find_by_type(ustack, BKE_UNDOSYS_TYPE_MEMFILE)) {
+    return false;
+  }
+
+  if (!BKE_memfile_undo_spill(us->data)) {
+    return false;
+  }
+  us_p->data_size = 0;
+  return true;
+}
+
 /* Export for ED_undo_sys. */
 void ED_memfile_undosys_type(UndoType *ut)
 {
@@ -280,6 +299,7 @@ void ED_memfile_undosys_type(UndoType *ut)
   ut->step_encode = memfile_undosys_step_encode;
   ut->step_decode = memfile_undosys_step_decode;
   ut->step_free = memfile_undosys_step_free;
+  ut->step_spill = memfile_undosys_step_spill;
 
   ut->use_context = true;
 
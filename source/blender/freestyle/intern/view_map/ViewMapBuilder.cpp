@@ -40,6 +40,8 @@
 
 #include "BKE_global.h"
 
+#include "BLI_task.h"
+
 namespace Freestyle {
 
 // XXX Grmll... G is used as template's typename parameter :/
@@ -433,211 +435,250 @@ static int computeVisibility(ViewMap *viewMap,
 // QI <= 22.
 
 template<typename G, typename I>
-static void computeCumulativeVisibility(ViewMap *ioViewMap,
-                                        G &grid,
-                                        real epsilon,
-                                        RenderMonitor *iRenderMonitor)
+static void computeCumulativeVisibilityEdge(ViewMap *ioViewMap,
+                                            ViewEdge *ve,
+                                            G &grid,
+                                            real epsilon)
 {
-  vector<ViewEdge *> &vedges = ioViewMap->ViewEdges();
-
   FEdge *fe, *festart;
   int nSamples = 0;
   vector<WFace *> wFaces;
   WFace *wFace = nullptr;
-  unsigned cnt = 0;
-  unsigned cntStep = (unsigned)ceil(0.01f * vedges.size());
   unsigned tmpQI = 0;
   unsigned qiClasses[256];
   unsigned maxIndex, maxCard;
   unsigned qiMajority;
-  for (vector<ViewEdge *>::iterator ve = vedges.begin(), veend = vedges.end(); ve != veend; ve++) {
-    if (iRenderMonitor) {
-      if (iRenderMonitor->testBreak()) {
-        break;
-      }
-      if (cnt % cntStep == 0) {
-        stringstream ss;
-        ss << "Freestyle: Visibility computations " << (100 * cnt / vedges.size()) << "%";
-        iRenderMonitor->setInfo(ss.str());
-        iRenderMonitor->progress((float)cnt / vedges.size());
-      }
-      cnt++;
-    }
+
 #if LOGGING
-    if (_global.debug & G_DEBUG_FREESTYLE) {
-      cout << "Processing ViewEdge " << (*ve)->getId() << endl;
-    }
+  if (_global.debug & G_DEBUG_FREESTYLE) {
+    cout << "Processing ViewEdge " << ve->getId() << endl;
+  }
 #endif
-    // Find an edge to test
-    if (!(*ve)->isInImage()) {
-      // This view edge has been proscenium culled
-      (*ve)->setQI(255);
-      (*ve)->setaShape(nullptr);
+  // Find an edge to test
+  if (!ve->isInImage()) {
+    // This view edge has been proscenium culled
+    ve->setQI(255);
+    ve->setaShape(nullptr);
 #if LOGGING
-      if (_global.debug & G_DEBUG_FREESTYLE) {
-        cout << "\tCulled." << endl;
-      }
-#endif
-      continue;
+    if (_global.debug & G_DEBUG_FREESTYLE) {
+      cout << "\tCulled." << endl;
     }
+#endif
+    return;
+  }
 
-    // Test edge
-    festart = (*ve)->fedgeA();
-    fe = (*ve)->fedgeA();
-    qiMajority = 0;
-    do {
-      if (fe != nullptr && fe->isInImage()) {
-        qiMajority++;
-      }
-      fe = fe->nextEdge();
-    } while (fe && fe != festart);
-
-    if (qiMajority == 0) {
-      // There are no occludable FEdges on this ViewEdge
-      // This should be impossible.
-      if (_global.debug & G_DEBUG_FREESTYLE) {
-        cout << "View Edge in viewport without occludable FEdges: " << (*ve)->getId() << endl;
-      }
-      // We can recover from this error:
-      // Treat this edge as fully visible with no occludee
-      (*ve)->setQI(0);
-      (*ve)->setaShape(nullptr);
-      continue;
+  // Test edge
+  festart = ve->fedgeA();
+  fe = ve->fedgeA();
+  qiMajority = 0;
+  do {
+    if (fe != nullptr && fe->isInImage()) {
+      qiMajority++;
     }
+    fe = fe->nextEdge();
+  } while (fe && fe != festart);
 
-    ++qiMajority;
-    qiMajority >>= 1;
-
-#if LOGGING
+  if (qiMajority == 0) {
+    // There are no occludable FEdges on this ViewEdge
+    // This should be impossible.
     if (_global.debug & G_DEBUG_FREESTYLE) {
-      cout << "\tqiMajority: " << qiMajority << endl;
+      cout << "View Edge in viewport without occludable FEdges: " << ve->getId() << endl;
     }
-#endif
+    // We can recover from this error:
+    // Treat this edge as fully visible with no occludee
+    ve->setQI(0);
+    ve->setaShape(nullptr);
+    return;
+  }
 
-    tmpQI = 0;
-    maxIndex = 0;
-    maxCard = 0;
-    nSamples = 0;
-    memset(qiClasses, 0, 256 * sizeof(*qiClasses));
-    set<ViewShape *> foundOccluders;
+  ++qiMajority;
+  qiMajority >>= 1;
 
-    fe = (*ve)->fedgeA();
-    do {
-      if (!fe || !fe->isInImage()) {
-        fe = fe->nextEdge();
-        continue;
-      }
-      if ((maxCard < qiMajority)) {
-        // ARB: change &wFace to wFace and use reference in called function
-        tmpQI = computeVisibility<G, I>(
-            ioViewMap, fe, grid, epsilon, *ve, &wFace, &foundOccluders);
 #if LOGGING
-        if (_global.debug & G_DEBUG_FREESTYLE) {
-          cout << "\tFEdge: visibility " << tmpQI << endl;
-        }
+  if (_global.debug & G_DEBUG_FREESTYLE) {
+    cout << "\tqiMajority: " << qiMajority << endl;
+  }
 #endif
 
-        // ARB: This is an error condition, not an alert condition.
-        // Some sort of recovery or abort is necessary.
-        if (tmpQI >= 256) {
-          cerr << "Warning: too many occluding levels" << endl;
-          // ARB: Wild guess: instead of aborting or corrupting memory, treat as tmpQI == 255
-          tmpQI = 255;
-        }
+  tmpQI = 0;
+  maxIndex = 0;
+  maxCard = 0;
+  nSamples = 0;
+  memset(qiClasses, 0, 256 * sizeof(*qiClasses));
+  set<ViewShape *> foundOccluders;
 
-        if (++qiClasses[tmpQI] > maxCard) {
-          maxCard = qiClasses[tmpQI];
-          maxIndex = tmpQI;
-        }
-      }
-      else {
-        // ARB: FindOccludee is redundant if ComputeRayCastingVisibility has been called
-        // ARB: change &wFace to wFace and use reference in called function
-        findOccludee<G, I>(fe, grid, epsilon, *ve, &wFace);
+  fe = ve->fedgeA();
+  do {
+    if (!fe || !fe->isInImage()) {
+      fe = fe->nextEdge();
+      continue;
+    }
+    if ((maxCard < qiMajority)) {
+      // ARB: change &wFace to wFace and use reference in called function
+      tmpQI = computeVisibility<G, I>(ioViewMap, fe, grid, epsilon, ve, &wFace, &foundOccluders);
 #if LOGGING
-        if (_global.debug & G_DEBUG_FREESTYLE) {
-          cout << "\tFEdge: occludee only (" << (wFace != NULL ? "found" : "not found") << ")"
-               << endl;
-        }
+      if (_global.debug & G_DEBUG_FREESTYLE) {
+        cout << "\tFEdge: visibility " << tmpQI << endl;
+      }
 #endif
+
+      // ARB: This is an error condition, not an alert condition.
+      // Some sort of recovery or abort is necessary.
+      if (tmpQI >= 256) {
+        cerr << "Warning: too many occluding levels" << endl;
+        // ARB: Wild guess: instead of aborting or corrupting memory, treat as tmpQI == 255
+        tmpQI = 255;
       }
 
-      // Store test results
-      if (wFace) {
-        vector<Vec3r> vertices;
-        for (int i = 0, numEdges = wFace->numberOfEdges(); i < numEdges; ++i) {
-          vertices.emplace_back(wFace->GetVertex(i)->GetVertex());
-        }
-        Polygon3r poly(vertices, wFace->GetNormal());
-        poly.userdata = (void *)wFace;
-        fe->setaFace(poly);
-        wFaces.push_back(wFace);
-        fe->setOccludeeEmpty(false);
+      if (++qiClasses[tmpQI] > maxCard) {
+        maxCard = qiClasses[tmpQI];
+        maxIndex = tmpQI;
+      }
+    }
+    else {
+      // ARB: FindOccludee is redundant if ComputeRayCastingVisibility has been called
+      // ARB: change &wFace to wFace and use reference in called function
+      findOccludee<G, I>(fe, grid, epsilon, ve, &wFace);
 #if LOGGING
-        if (_global.debug & G_DEBUG_FREESTYLE) {
-          cout << "\tFound occludee" << endl;
-        }
+      if (_global.debug & G_DEBUG_FREESTYLE) {
+        cout << "\tFEdge: occludee only (" << (wFace != NULL ? "found" : "not found") << ")"
+             << endl;
+      }
 #endif
+    }
+
+    // Store test results
+    if (wFace) {
+      vector<Vec3r> vertices;
+      for (int i = 0, numEdges = wFace->numberOfEdges(); i < numEdges; ++i) {
+        vertices.emplace_back(wFace->GetVertex(i)->GetVertex());
       }
-      else {
-        fe->setOccludeeEmpty(true);
+      Polygon3r poly(vertices, wFace->GetNormal());
+      poly.userdata = (void *)wFace;
+      fe->setaFace(poly);
+      wFaces.push_back(wFace);
+      fe->setOccludeeEmpty(false);
+#if LOGGING
+      if (_global.debug & G_DEBUG_FREESTYLE) {
+        cout << "\tFound occludee" << endl;
       }
+#endif
+    }
+    else {
+      fe->setOccludeeEmpty(true);
+    }
 
-      ++nSamples;
-      fe = fe->nextEdge();
-    } while ((maxCard < qiMajority) && (fe) && (fe != festart));
+    ++nSamples;
+    fe = fe->nextEdge();
+  } while ((maxCard < qiMajority) && (fe) && (fe != festart));
 
 #if LOGGING
-    if (_global.debug & G_DEBUG_FREESTYLE) {
-      cout << "\tFinished with " << nSamples << " samples, maxCard = " << maxCard << endl;
-    }
+  if (_global.debug & G_DEBUG_FREESTYLE) {
+    cout << "\tFinished with " << nSamples << " samples, maxCard = " << maxCard << endl;
+  }
 #endif
 
-    // ViewEdge
-    // qi --
-    // Find the minimum value that is >= the majority of the QI
-    for (unsigned count = 0, i = 0; i < 256; ++i) {
-      count += qiClasses[i];
-      if (count >= qiMajority) {
-        (*ve)->setQI(i);
-        break;
-      }
-    }
-    // occluders --
-    // I would rather not have to go through the effort of creating this set and then copying out
-    // its contents. Is there a reason why ViewEdge::_Occluders cannot be converted to a set<>?
-    for (set<ViewShape *>::iterator o = foundOccluders.begin(), oend = foundOccluders.end();
-         o != oend;
-         ++o) {
-      (*ve)->AddOccluder((*o));
+  // ViewEdge
+  // qi --
+  // Find the minimum value that is >= the majority of the QI
+  for (unsigned count = 0, i = 0; i < 256; ++i) {
+    count += qiClasses[i];
+    if (count >= qiMajority) {
+      ve->setQI(i);
+      break;
     }
+  }
+  // occluders --
+  // I would rather not have to go through the effort of creating this set and then copying out
+  // its contents. Is there a reason why ViewEdge::_Occluders cannot be converted to a set<>?
+  for (set<ViewShape *>::iterator o = foundOccluders.begin(), oend = foundOccluders.end();
+       o != oend;
+       ++o) {
+    ve->AddOccluder((*o));
+  }
 #if LOGGING
-    if (_global.debug & G_DEBUG_FREESTYLE) {
-      cout << "\tConclusion: QI = " << maxIndex << ", " << (*ve)->occluders_size() << " occluders."
-           << endl;
-    }
+  if (_global.debug & G_DEBUG_FREESTYLE) {
+    cout << "\tConclusion: QI = " << maxIndex << ", " << ve->occluders_size() << " occluders."
+         << endl;
+  }
 #else
-    (void)maxIndex;
+  (void)maxIndex;
 #endif
-    // occludee --
-    if (!wFaces.empty()) {
-      if (wFaces.size() <= (float)nSamples / 2.0f) {
-        (*ve)->setaShape(nullptr);
-      }
-      else {
-        ViewShape *vshape = ioViewMap->viewShape(
-            (*wFaces.begin())->GetVertex(0)->shape()->GetId());
-        (*ve)->setaShape(vshape);
+  // occludee --
+  if (!wFaces.empty()) {
+    if (wFaces.size() <= (float)nSamples / 2.0f) {
+      ve->setaShape(nullptr);
+    }
+    else {
+      ViewShape *vshape = ioViewMap->viewShape((*wFaces.begin())->GetVertex(0)->shape()->GetId());
+      ve->setaShape(vshape);
+    }
+  }
+}
+
+// View edges only read the grid and write to their own FEdges, so their visibility is computed in
+// parallel. Progress and cancellation are handled on the calling thread between batches.
+template<typename G, typename I> struct CumulativeVisibilityData {
+  ViewMap *viewMap;
+  ViewEdge **vedges;
+  G *grid;
+  real epsilon;
+};
+
+template<typename G, typename I>
+static void computeCumulativeVisibilityTask(void *__restrict userdata,
+                                            const int i,
+                                            const TaskParallelTLS *__restrict /*tls*/)
+{
+  CumulativeVisibilityData<G, I> *data = (CumulativeVisibilityData<G, I> *)userdata;
+  computeCumulativeVisibilityEdge<G, I>(data->viewMap, data->vedges[i], *data->grid, data->epsilon);
+}
+
+template<typename G, typename I>
+static void computeCumulativeVisibility(ViewMap *ioViewMap,
+                                        G &grid,
+                                        real epsilon,
+                                        RenderMonitor *iRenderMonitor)
+{
+  vector<ViewEdge *> &vedges = ioViewMap->ViewEdges();
+  const unsigned vedges_num = vedges.size();
+  if (vedges_num == 0) {
+    return;
+  }
+
+  CumulativeVisibilityData<G, I> data;
+  data.viewMap = ioViewMap;
+  data.vedges = &vedges[0];
+  data.grid = &grid;
+  data.epsilon = epsilon;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 16;
+
+  unsigned cnt = 0;
+  const unsigned cntStep = iRenderMonitor ? (unsigned)ceil(0.01f * vedges_num) : vedges_num;
+  while (cnt < vedges_num) {
+    if (iRenderMonitor) {
+      if (iRenderMonitor->testBreak()) {
+        break;
       }
+      stringstream ss;
+      ss << "Freestyle: Visibility computations " << (100 * cnt / vedges_num) << "%";
+      iRenderMonitor->setInfo(ss.str());
+      iRenderMonitor->progress((float)cnt / vedges_num);
     }
 
-    wFaces.clear();
+    const unsigned cntEnd = min(cnt + cntStep, vedges_num);
+    BLI_task_parallel_range(cnt, cntEnd, &data, computeCumulativeVisibilityTask<G, I>, &settings);
+    cnt = cntEnd;
   }
-  if (iRenderMonitor && !vedges.empty()) {
+
+  if (iRenderMonitor) {
     stringstream ss;
-    ss << "Freestyle: Visibility computations " << (100 * cnt / vedges.size()) << "%";
+    ss << "Freestyle: Visibility computations " << (100 * cnt / vedges_num) << "%";
     iRenderMonitor->setInfo(ss.str());
-    iRenderMonitor->progress((float)cnt / vedges.size());
+    iRenderMonitor->progress((float)cnt / vedges_num);
   }
 }
 
@@ -0,0 +1,158 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup fn
+ *
+ * An AttributesBlockContainer stores elements (e.g. particles) in fixed-size blocks. Every block
+ * has one array per attribute. Adding or removing elements never reallocates existing arrays, so
+ * that emission, removal and evaluation can work on many blocks in parallel.
+ *
+ * Blocks that are not used anymore are kept in a pool and are reused by the next call to
+ * #new_block.
+ */
+
+#include <mutex>
+
+#include "FN_attributes_ref.hh"
+
+#include "BLI_array.hh"
+#include "BLI_task.hh"
+
+namespace blender::fn {
+
+class AttributesBlockContainer;
+
+class AttributesBlock : NonCopyable, NonMovable {
+ private:
+  AttributesBlockContainer &owner_;
+  Array<void *> buffers_;
+  int64_t used_size_ = 0;
+
+  friend AttributesBlockContainer;
+
+ public:
+  AttributesBlock(AttributesBlockContainer &owner);
+  ~AttributesBlock();
+
+  AttributesBlockContainer &owner()
+  {
+    return owner_;
+  }
+
+  int64_t used_size() const
+  {
+    return used_size_;
+  }
+
+  int64_t capacity() const;
+
+  int64_t unused_capacity() const
+  {
+    return this->capacity() - used_size_;
+  }
+
+  bool is_full() const
+  {
+    return used_size_ == this->capacity();
+  }
+
+  IndexRange used_range() const
+  {
+    return IndexRange(used_size_);
+  }
+
+  /**
+   * References the elements that are in use.
+   */
+  MutableAttributesRef attributes()
+  {
+    return MutableAttributesRef(this->info(), buffers_, used_size_);
+  }
+
+  const AttributesInfo &info() const;
+
+  MutableAttributesRef add_default(int64_t amount);
+  void remove(IndexMask indices_to_remove);
+  void clear();
+};
+
+class AttributesBlockContainer : NonCopyable, NonMovable {
+ private:
+  const AttributesInfo &info_;
+  int64_t block_size_;
+  Vector<AttributesBlock *> active_blocks_;
+  Vector<AttributesBlock *> free_blocks_;
+  std::mutex mutex_;
+
+ public:
+  AttributesBlockContainer(const AttributesInfo &info, int64_t block_size);
+  ~AttributesBlockContainer();
+
+  const AttributesInfo &info() const
+  {
+    return info_;
+  }
+
+  int64_t block_size() const
+  {
+    return block_size_;
+  }
+
+  /**
+   * The returned span is invalidated by #new_block, #release_block and #compact.
+   */
+  Span<AttributesBlock *> active_blocks() const
+  {
+    return active_blocks_;
+  }
+
+  int64_t size() const;
+
+  /* These are thread-safe. */
+  AttributesBlock &new_block();
+  void release_block(AttributesBlock &block);
+
+  MutableAttributesRef add_default(int64_t amount);
+  void compact();
+
+  /**
+   * Calls the function for every active block. Blocks are processed in parallel, so the function
+   * must not access other blocks or change the set of active blocks.
+   */
+  template<typename Func> void foreach_block(const Func &func)
+  {
+    threading::parallel_for(active_blocks_.index_range(), 1, [&](IndexRange range) {
+      for (const int64_t i : range) {
+        func(*active_blocks_[i]);
+      }
+    });
+  }
+};
+
+inline int64_t AttributesBlock::capacity() const
+{
+  return owner_.block_size();
+}
+
+inline const AttributesInfo &AttributesBlock::info() const
+{
+  return owner_.info();
+}
+
+}  // namespace blender::fn
@@ -150,6 +150,38 @@ class AttributesInfo : NonCopyable, NonMovable {
   }
 };
 
+/**
+ * Stores the index of an attribute with a specific type. Looking the index up by name once and
+ * using it for all subsequent accesses avoids hash table lookups in inner loops. The index is
+ * only valid for #AttributesRef instances that use the same #AttributesInfo.
+ */
+template<typename T> class AttributeIndex {
+ private:
+  int index_ = -1;
+
+ public:
+  AttributeIndex() = default;
+
+  AttributeIndex(const AttributesInfo &info, StringRef name)
+      : index_(info.try_index_of(name, CPPType::get<T>()))
+  {
+  }
+
+  /**
+   * False when the attribute does not exist or has a different type.
+   */
+  operator bool() const
+  {
+    return index_ >= 0;
+  }
+
+  int index() const
+  {
+    BLI_assert(index_ >= 0);
+    return index_;
+  }
+};
+
 /**
  * References multiple arrays that match the description of an AttributesInfo instance. This class
  * is supposed to be relatively cheap to copy. It does not own any of the arrays itself.
@@ -211,6 +243,11 @@ class MutableAttributesRef {
     return this->get<T>(info_->index_of(name));
   }
 
+  template<typename T> MutableSpan<T> get(AttributeIndex<T> index) const
+  {
+    return this->get<T>(index.index());
+  }
+
   std::optional<GMutableSpan> try_get(StringRef name, const CPPType &type) const
   {
     int index = info_->try_index_of(name, type);
@@ -294,7 +331,7 @@ class AttributesRef {
   template<typename T> Span<T> get(int index) const
   {
     BLI_assert(info_->type_of(index).is<T>());
-    return Span<T>(static_cast<T *>(buffers_[index]) + range_.start(), range_.size());
+    return Span<T>(static_cast<const T *>(buffers_[index]) + range_.start(), range_.size());
   }
 
   template<typename T> Span<T> get(StringRef name) const
@@ -302,6 +339,11 @@ class AttributesRef {
     return this->get<T>(info_->index_of(name));
   }
 
+  template<typename T> Span<T> get(AttributeIndex<T> index) const
+  {
+    return this->get<T>(index.index());
+  }
+
   std::optional<GSpan> try_get(StringRef name, const CPPType &type) const
   {
     int64_t index = info_->try_index_of(name, type);
@@ -114,6 +114,7 @@ class CPPType : NonCopyable, NonMovable {
   int64_t alignment_;
   uintptr_t alignment_mask_;
   bool is_trivially_destructible_;
+  bool is_trivially_copyable_;
 
   ConstructDefaultF construct_default_;
   ConstructDefaultNF construct_default_n_;
@@ -157,6 +158,7 @@ class CPPType : NonCopyable, NonMovable {
           int64_t size,
           int64_t alignment,
           bool is_trivially_destructible,
+          bool is_trivially_copyable,
           ConstructDefaultF construct_default,
           ConstructDefaultNF construct_default_n,
           ConstructDefaultIndicesF construct_default_indices,
@@ -186,6 +188,7 @@ class CPPType : NonCopyable, NonMovable {
       : size_(size),
         alignment_(alignment),
         is_trivially_destructible_(is_trivially_destructible),
+        is_trivially_copyable_(is_trivially_copyable),
         construct_default_(construct_default),
         construct_default_n_(construct_default_n),
         construct_default_indices_(construct_default_indices),
@@ -277,6 +280,19 @@ class CPPType : NonCopyable, NonMovable {
     return is_trivially_destructible_;
   }
 
+  /**
+   * When true, instances can be copied and relocated with `memcpy`. Bulk operations use this to
+   * bypass the type specific callbacks and to turn masked operations on a range into a single
+   * contiguous copy.
+   *
+   * C++ equivalent:
+   *   std::is_trivially_copyable_v<T>;
+   */
+  bool is_trivially_copyable() const
+  {
+    return is_trivially_copyable_;
+  }
+
   /**
    * Returns true, when the given pointer fulfills the alignment requirement of this type.
    */
@@ -338,6 +354,9 @@ class CPPType : NonCopyable, NonMovable {
   {
     BLI_assert(n == 0 || this->pointer_can_point_to_instance(ptr));
 
+    if (is_trivially_destructible_) {
+      return;
+    }
     destruct_n_(ptr, n);
   }
 
@@ -345,6 +364,9 @@ class CPPType : NonCopyable, NonMovable {
   {
     BLI_assert(mask.size() == 0 || this->pointer_can_point_to_instance(ptr));
 
+    if (is_trivially_destructible_) {
+      return;
+    }
     destruct_indices_(ptr, mask);
   }
 
@@ -374,6 +396,10 @@ class CPPType : NonCopyable, NonMovable {
     BLI_assert(n == 0 || this->pointer_can_point_to_instance(src));
     BLI_assert(n == 0 || this->pointer_can_point_to_instance(dst));
 
+    if (is_trivially_copyable_) {
+      this->copy_trivial_n(src, dst, n);
+      return;
+    }
     copy_to_initialized_n_(src, dst, n);
   }
 
@@ -383,6 +409,10 @@ class CPPType : NonCopyable, NonMovable {
     BLI_assert(mask.size() == 0 || this->pointer_can_point_to_instance(src));
     BLI_assert(mask.size() == 0 || this->pointer_can_point_to_instance(dst));
 
+    if (is_trivially_copyable_ && mask.is_range()) {
+      this->copy_trivial_range(src, dst, mask.as_range());
+      return;
+    }
     copy_to_initialized_indices_(src, dst, mask);
   }
 
@@ -409,6 +439,10 @@ class CPPType : NonCopyable, NonMovable {
     BLI_assert(n == 0 || this->pointer_can_point_to_instance(src));
     BLI_assert(n == 0 || this->pointer_can_point_to_instance(dst));
 
+    if (is_trivially_copyable_) {
+      this->copy_trivial_n(src, dst, n);
+      return;
+    }
     copy_to_uninitialized_n_(src, dst, n);
   }
 
@@ -418,6 +452,10 @@ class CPPType : NonCopyable, NonMovable {
     BLI_assert(mask.size() == 0 || this->pointer_can_point_to_instance(src));
     BLI_assert(mask.size() == 0 || this->pointer_can_point_to_instance(dst));
 
+    if (is_trivially_copyable_ && mask.is_range()) {
+      this->copy_trivial_range(src, dst, mask.as_range());
+      return;
+    }
     copy_to_uninitialized_indices_(src, dst, mask);
   }
 
@@ -444,6 +482,10 @@ class CPPType : NonCopyable, NonMovable {
     BLI_assert(n == 0 || this->pointer_can_point_to_instance(src));
     BLI_assert(n == 0 || this->pointer_can_point_to_instance(dst));
 
+    if (is_trivially_copyable_) {
+      this->copy_trivial_n(src, dst, n);
+      return;
+    }
     relocate_to_initialized_n_(src, dst, n);
   }
 
@@ -453,6 +495,10 @@ class CPPType : NonCopyable, NonMovable {
     BLI_assert(mask.size() == 0 || this->pointer_can_point_to_instance(src));
     BLI_assert(mask.size() == 0 || this->pointer_can_point_to_instance(dst));
 
+    if (is_trivially_copyable_ && mask.is_range()) {
+      this->copy_trivial_range(src, dst, mask.as_range());
+      return;
+    }
     relocate_to_initialized_indices_(src, dst, mask);
   }
 
@@ -479,6 +525,10 @@ class CPPType : NonCopyable, NonMovable {
     BLI_assert(n == 0 || this->pointer_can_point_to_instance(src));
     BLI_assert(n == 0 || this->pointer_can_point_to_instance(dst));
 
+    if (is_trivially_copyable_) {
+      this->copy_trivial_n(src, dst, n);
+      return;
+    }
     relocate_to_uninitialized_n_(src, dst, n);
   }
 
@@ -488,6 +538,10 @@ class CPPType : NonCopyable, NonMovable {
     BLI_assert(mask.size() == 0 || this->pointer_can_point_to_instance(src));
     BLI_assert(mask.size() == 0 || this->pointer_can_point_to_instance(dst));
 
+    if (is_trivially_copyable_ && mask.is_range()) {
+      this->copy_trivial_range(src, dst, mask.as_range());
+      return;
+    }
     relocate_to_uninitialized_indices_(src, dst, mask);
   }
 
@@ -509,6 +563,10 @@ class CPPType : NonCopyable, NonMovable {
     BLI_assert(mask.size() == 0 || this->pointer_can_point_to_instance(value));
     BLI_assert(mask.size() == 0 || this->pointer_can_point_to_instance(dst));
 
+    if (is_trivially_copyable_ && mask.is_range()) {
+      fill_initialized_(value, POINTER_OFFSET(dst, size_ * mask[0]), mask.size());
+      return;
+    }
     fill_initialized_indices_(value, dst, mask);
   }
 
@@ -530,6 +588,10 @@ class CPPType : NonCopyable, NonMovable {
     BLI_assert(mask.size() == 0 || this->pointer_can_point_to_instance(value));
     BLI_assert(mask.size() == 0 || this->pointer_can_point_to_instance(dst));
 
+    if (is_trivially_copyable_ && mask.is_range()) {
+      fill_uninitialized_(value, POINTER_OFFSET(dst, size_ * mask[0]), mask.size());
+      return;
+    }
     fill_uninitialized_indices_(value, dst, mask);
   }
 
@@ -570,6 +632,19 @@ class CPPType : NonCopyable, NonMovable {
   {
     return this == &CPPType::get<T>();
   }
+
+ private:
+  void copy_trivial_n(const void *src, void *dst, int64_t n) const
+  {
+    BLI_assert(is_trivially_copyable_);
+    memcpy(dst, src, static_cast<size_t>(size_ * n));
+  }
+
+  void copy_trivial_range(const void *src, void *dst, IndexRange range) const
+  {
+    const int64_t offset = size_ * range.start();
+    this->copy_trivial_n(POINTER_OFFSET(src, offset), POINTER_OFFSET(dst, offset), range.size());
+  }
 };
 
 /* --------------------------------------------------------------------
@@ -755,6 +830,7 @@ inline std::unique_ptr<const CPPType> create_cpp_type(StringRef name, const T &d
                                     sizeof(T),
                                     alignof(T),
                                     std::is_trivially_destructible_v<T>,
+                                    std::is_trivially_copyable_v<T>,
                                     construct_default_cb<T>,
                                     construct_default_n_cb<T>,
                                     construct_default_indices_cb<T>,
@@ -120,9 +120,25 @@ class GVectorArray : NonCopyable, NonMovable {
   void extend(int64_t index, GVSpan span)
   {
     BLI_assert(type_ == span.type());
-    for (int64_t i = 0; i < span.size(); i++) {
-      this->append(index, span[i]);
+    if (span.is_empty()) {
+      return;
+    }
+    const int64_t old_length = lengths_[index];
+    const int64_t new_length = old_length + span.size();
+    if (new_length > capacities_[index]) {
+      this->grow_to_at_least(index, new_length);
+    }
+
+    void *dst = POINTER_OFFSET(starts_[index], element_size_ * old_length);
+    if (span.is_full_array()) {
+      type_.copy_to_uninitialized_n(span.as_full_array().data(), dst, span.size());
     }
+    else {
+      for (int64_t i = 0; i < span.size(); i++) {
+        type_.copy_to_uninitialized(span[i], POINTER_OFFSET(dst, element_size_ * i));
+      }
+    }
+    lengths_[index] = new_length;
   }
 
   void extend(IndexMask mask, GVArraySpan array_span)
@@ -148,7 +164,13 @@ class GVectorArray : NonCopyable, NonMovable {
   void grow_at_least_one(int64_t index)
   {
     BLI_assert(lengths_[index] == capacities_[index]);
-    int64_t new_capacity = lengths_[index] * 2 + 1;
+    this->grow_to_at_least(index, lengths_[index] + 1);
+  }
+
+  void grow_to_at_least(int64_t index, int64_t min_capacity)
+  {
+    BLI_assert(min_capacity > capacities_[index]);
+    int64_t new_capacity = std::max(min_capacity, lengths_[index] * 2 + 1);
 
     void *new_buffer = allocator_.allocate(element_size_ * new_capacity, type_.alignment());
     type_.relocate_to_uninitialized_n(starts_[index], new_buffer, lengths_[index]);
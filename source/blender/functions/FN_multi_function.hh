@@ -102,6 +102,11 @@ class MultiFunction {
     return signature_.depends_on_context;
   }
 
+  bool is_element_wise() const
+  {
+    return signature_.is_element_wise;
+  }
+
   const MFSignature &signature() const
   {
     return signature_;
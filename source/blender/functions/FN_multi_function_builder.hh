@@ -47,6 +47,7 @@ template<typename In1, typename Out1> class CustomMF_SI_SO : public MultiFunctio
     MFSignatureBuilder signature = this->get_builder(name);
     signature.single_input<In1>("In1");
     signature.single_output<Out1>("Out1");
+    signature.element_wise();
   }
 
   template<typename ElementFuncT>
@@ -58,6 +59,12 @@ template<typename In1, typename Out1> class CustomMF_SI_SO : public MultiFunctio
   template<typename ElementFuncT> static FunctionT create_function(ElementFuncT element_fn)
   {
     return [=](IndexMask mask, VSpan<In1> in1, MutableSpan<Out1> out1) {
+      if (in1.is_single_element()) {
+        /* The output is the same for every index, so compute it only once. */
+        const Out1 value = element_fn(in1.as_single_element());
+        mask.foreach_index([&](int i) { new (static_cast<void *>(&out1[i])) Out1(value); });
+        return;
+      }
       mask.foreach_index(
           [&](int i) { new (static_cast<void *>(&out1[i])) Out1(element_fn(in1[i])); });
     };
@@ -90,6 +97,7 @@ class CustomMF_SI_SI_SO : public MultiFunction {
     signature.single_input<In1>("In1");
     signature.single_input<In2>("In2");
     signature.single_output<Out1>("Out1");
+    signature.element_wise();
   }
 
   template<typename ElementFuncT>
@@ -101,6 +109,11 @@ class CustomMF_SI_SI_SO : public MultiFunction {
   template<typename ElementFuncT> static FunctionT create_function(ElementFuncT element_fn)
   {
     return [=](IndexMask mask, VSpan<In1> in1, VSpan<In2> in2, MutableSpan<Out1> out1) {
+      if (in1.is_single_element() && in2.is_single_element()) {
+        const Out1 value = element_fn(in1.as_single_element(), in2.as_single_element());
+        mask.foreach_index([&](int i) { new (static_cast<void *>(&out1[i])) Out1(value); });
+        return;
+      }
       mask.foreach_index(
           [&](int i) { new (static_cast<void *>(&out1[i])) Out1(element_fn(in1[i], in2[i])); });
     };
@@ -137,6 +150,7 @@ class CustomMF_SI_SI_SI_SO : public MultiFunction {
     signature.single_input<In2>("In2");
     signature.single_input<In3>("In3");
     signature.single_output<Out1>("Out1");
+    signature.element_wise();
   }
 
   template<typename ElementFuncT>
@@ -152,6 +166,12 @@ class CustomMF_SI_SI_SI_SO : public MultiFunction {
                VSpan<In2> in2,
                VSpan<In3> in3,
                MutableSpan<Out1> out1) {
+      if (in1.is_single_element() && in2.is_single_element() && in3.is_single_element()) {
+        const Out1 value = element_fn(
+            in1.as_single_element(), in2.as_single_element(), in3.as_single_element());
+        mask.foreach_index([&](int i) { new (static_cast<void *>(&out1[i])) Out1(value); });
+        return;
+      }
       mask.foreach_index([&](int i) {
         new (static_cast<void *>(&out1[i])) Out1(element_fn(in1[i], in2[i], in3[i]));
       });
@@ -215,6 +235,7 @@ template<typename From, typename To> class CustomMF_Convert : public MultiFuncti
     MFSignatureBuilder signature = this->get_builder(std::move(name));
     signature.single_input<From>("Input");
     signature.single_output<To>("Output");
+    signature.element_wise();
   }
 
   void call(IndexMask mask, MFParams params, MFContext UNUSED(context)) const override
@@ -315,4 +336,15 @@ class CustomMF_DefaultOutput : public MultiFunction {
   void call(IndexMask mask, MFParams params, MFContext context) const override;
 };
 
+/**
+ * A multi-function that outputs either the "If True" or the "If False" input for every index,
+ * depending on the condition. When evaluated in a #MFNetworkEvaluator, the inputs are computed
+ * lazily: each branch is only evaluated for the indices that select it.
+ */
+class CustomMF_GenericSwitch : public MultiFunction {
+ public:
+  CustomMF_GenericSwitch(const CPPType &type);
+  void call(IndexMask mask, MFParams params, MFContext context) const override;
+};
+
 }  // namespace blender::fn
@@ -25,6 +25,7 @@
 namespace blender::fn {
 
 class MFNetworkEvaluationStorage;
+class MFNetworkEvaluationBufferCache;
 
 class MFNetworkEvaluator : public MultiFunction {
  private:
@@ -39,13 +40,22 @@ class MFNetworkEvaluator : public MultiFunction {
  private:
   using Storage = MFNetworkEvaluationStorage;
 
+  bool can_evaluate_in_chunks(IndexMask mask) const;
+  void evaluate_in_chunks(IndexRange range, MFParams params, MFContext context) const;
+  void evaluate_mask(IndexMask mask,
+                     MFParams params,
+                     MFContext context,
+                     MFNetworkEvaluationBufferCache *buffer_cache = nullptr) const;
+
   void copy_inputs_to_storage(MFParams params, Storage &storage) const;
   void copy_outputs_to_storage(
       MFParams params,
       Storage &storage,
       Vector<const MFInputSocket *> &outputs_to_initialize_in_the_end) const;
 
-  void evaluate_network_to_compute_outputs(MFContext &global_context, Storage &storage) const;
+  void evaluate_network_to_compute_sockets(MFContext &global_context,
+                                           Storage &storage,
+                                           Span<const MFOutputSocket *> sockets) const;
 
   void evaluate_function(MFContext &global_context,
                          const MFFunctionNode &function_node,
@@ -53,6 +63,17 @@ class MFNetworkEvaluator : public MultiFunction {
 
   bool can_do_single_value_evaluation(const MFFunctionNode &function_node, Storage &storage) const;
 
+  bool can_evaluate_switch_input_lazily(const MFInputSocket &socket) const;
+  void evaluate_switch(MFContext &global_context,
+                       const MFFunctionNode &function_node,
+                       Storage &storage) const;
+  void evaluate_switch_branch(MFContext &global_context,
+                              const MFInputSocket &socket,
+                              IndexMask mask,
+                              GMutableSpan r_results,
+                              Storage &storage) const;
+  void share_computed_values(const MFOutputSocket &socket, Storage &from, Storage &to) const;
+
   void initialize_remaining_outputs(MFParams params,
                                     Storage &storage,
                                     Span<const MFInputSocket *> remaining_outputs) const;
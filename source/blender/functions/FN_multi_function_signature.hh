@@ -35,6 +35,7 @@ struct MFSignature {
   Vector<MFParamType> param_types;
   Vector<int> param_data_indices;
   bool depends_on_context = false;
+  bool is_element_wise = false;
 
   int data_index(int param_index) const
   {
@@ -165,6 +166,14 @@ class MFSignatureBuilder {
   {
     data_.depends_on_context = true;
   }
+
+  /** This indicates that the function only has single inputs and outputs and that the output at
+   * an index only depends on the inputs at the same index. Such functions can be evaluated on
+   * any sub-range of the indices, which allows them to be fused with other functions. */
+  void element_wise()
+  {
+    data_.is_element_wise = true;
+  }
 };
 
 }  // namespace blender::fn
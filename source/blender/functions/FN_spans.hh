@@ -98,6 +98,14 @@ class GSpan {
     return POINTER_OFFSET(data_, type_->size() * index);
   }
 
+  GSpan slice(const int64_t start, const int64_t size) const
+  {
+    BLI_assert(start >= 0);
+    BLI_assert(size >= 0);
+    BLI_assert(start + size <= size_ || size == 0);
+    return GSpan(*type_, POINTER_OFFSET(data_, type_->size() * start), size);
+  }
+
   template<typename T> Span<T> typed() const
   {
     BLI_assert(type_->is<T>());
@@ -165,6 +173,14 @@ class GMutableSpan {
     return POINTER_OFFSET(data_, type_->size() * index);
   }
 
+  GMutableSpan slice(const int64_t start, const int64_t size) const
+  {
+    BLI_assert(start >= 0);
+    BLI_assert(size >= 0);
+    BLI_assert(start + size <= size_ || size == 0);
+    return GMutableSpan(*type_, POINTER_OFFSET(data_, type_->size() * start), size);
+  }
+
   template<typename T> MutableSpan<T> typed()
   {
     BLI_assert(type_->is<T>());
@@ -435,6 +451,30 @@ class GVSpan : public VSpanBase<void> {
     return GSpan(*this->type_, data, this->virtual_size_);
   }
 
+  /**
+   * Returns a virtual span that references `size` elements starting at `start`. Single values
+   * remain single values.
+   */
+  GVSpan slice(const int64_t start, const int64_t size) const
+  {
+    BLI_assert(start >= 0);
+    BLI_assert(size >= 0);
+    BLI_assert(start + size <= this->virtual_size_);
+    switch (this->category_) {
+      case VSpanCategory::Single:
+        return GVSpan::FromSingle(*this->type_, this->data_.single.data, size);
+      case VSpanCategory::FullArray:
+        return GSpan(*this->type_,
+                     POINTER_OFFSET(this->data_.full_array.data, this->type_->size() * start),
+                     size);
+      case VSpanCategory::FullPointerArray:
+        return GVSpan::FromFullPointerArray(
+            *this->type_, this->data_.full_pointer_array.data + start, size);
+    }
+    BLI_assert(false);
+    return GVSpan(*this->type_);
+  }
+
   void materialize_to_uninitialized(void *dst) const
   {
     this->materialize_to_uninitialized(IndexRange(virtual_size_), dst);
@@ -0,0 +1,234 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <algorithm>
+
+#include "FN_attributes_block_container.hh"
+
+#include "MEM_guardedalloc.h"
+
+namespace blender::fn {
+
+AttributesBlock::AttributesBlock(AttributesBlockContainer &owner)
+    : owner_(owner), buffers_(owner.info().size())
+{
+  const AttributesInfo &info = owner.info();
+  for (const int i : info.index_range()) {
+    const CPPType &type = info.type_of(i);
+    buffers_[i] = MEM_mallocN_aligned(owner.block_size() * type.size(), type.alignment(), AT);
+  }
+}
+
+AttributesBlock::~AttributesBlock()
+{
+  this->clear();
+  for (void *buffer : buffers_) {
+    MEM_freeN(buffer);
+  }
+}
+
+/**
+ * Appends new elements that are initialized with the default value of every attribute. Returns
+ * a reference to the new elements, so that the caller can overwrite the values.
+ */
+MutableAttributesRef AttributesBlock::add_default(const int64_t amount)
+{
+  BLI_assert(amount <= this->unused_capacity());
+  const AttributesInfo &info = this->info();
+  for (const int i : info.index_range()) {
+    const CPPType &type = info.type_of(i);
+    void *dst = POINTER_OFFSET(buffers_[i], type.size() * used_size_);
+    type.fill_uninitialized(info.default_of(i), dst, amount);
+  }
+  const int64_t old_size = used_size_;
+  used_size_ += amount;
+  return this->attributes().slice(old_size, amount);
+}
+
+/**
+ * Destructs the given elements and fills the gaps with elements from the end of the block. The
+ * order of the remaining elements is not preserved.
+ */
+void AttributesBlock::remove(IndexMask indices_to_remove)
+{
+  if (indices_to_remove.size() == 0) {
+    return;
+  }
+  BLI_assert(indices_to_remove.last() < used_size_);
+
+  const AttributesInfo &info = this->info();
+  for (const int attribute_index : info.index_range()) {
+    const CPPType &type = info.type_of(attribute_index);
+    void *buffer = buffers_[attribute_index];
+    int64_t last = used_size_ - 1;
+    /* Going backwards, the last element is never one that still has to be removed. */
+    for (int64_t i = indices_to_remove.size() - 1; i >= 0; i--) {
+      const int64_t index = indices_to_remove[i];
+      void *dst = POINTER_OFFSET(buffer, type.size() * index);
+      type.destruct(dst);
+      if (index != last) {
+        type.relocate_to_uninitialized(POINTER_OFFSET(buffer, type.size() * last), dst);
+      }
+      last--;
+    }
+  }
+  used_size_ -= indices_to_remove.size();
+}
+
+void AttributesBlock::clear()
+{
+  const AttributesInfo &info = this->info();
+  for (const int i : info.index_range()) {
+    info.type_of(i).destruct_n(buffers_[i], used_size_);
+  }
+  used_size_ = 0;
+}
+
+AttributesBlockContainer::AttributesBlockContainer(const AttributesInfo &info,
+                                                   const int64_t block_size)
+    : info_(info), block_size_(block_size)
+{
+  BLI_assert(block_size > 0);
+}
+
+AttributesBlockContainer::~AttributesBlockContainer()
+{
+  for (AttributesBlock *block : active_blocks_) {
+    delete block;
+  }
+  for (AttributesBlock *block : free_blocks_) {
+    delete block;
+  }
+}
+
+int64_t AttributesBlockContainer::size() const
+{
+  int64_t size = 0;
+  for (const AttributesBlock *block : active_blocks_) {
+    size += block->used_size();
+  }
+  return size;
+}
+
+/**
+ * Returns an empty block that is added to the active blocks. Released blocks are reused before
+ * allocating new ones.
+ */
+AttributesBlock &AttributesBlockContainer::new_block()
+{
+  std::lock_guard<std::mutex> lock{mutex_};
+  AttributesBlock *block = free_blocks_.is_empty() ? new AttributesBlock(*this) :
+                                                     free_blocks_.pop_last();
+  active_blocks_.append(block);
+  return *block;
+}
+
+/**
+ * Destructs all elements in the block and moves it into the pool of unused blocks.
+ */
+void AttributesBlockContainer::release_block(AttributesBlock &block)
+{
+  BLI_assert(&block.owner() == this);
+  block.clear();
+  std::lock_guard<std::mutex> lock{mutex_};
+  active_blocks_.remove_first_occurrence_and_reorder(&block);
+  free_blocks_.append(&block);
+}
+
+/**
+ * Adds elements with default values. The elements are all added to a single new block, so that
+ * they can be referenced by one #MutableAttributesRef.
+ */
+MutableAttributesRef AttributesBlockContainer::add_default(const int64_t amount)
+{
+  BLI_assert(amount <= block_size_);
+  AttributesBlock &block = this->new_block();
+  return block.add_default(amount);
+}
+
+namespace {
+struct ElementsMove {
+  AttributesBlock *src_block;
+  AttributesBlock *dst_block;
+  int64_t src_start;
+  int64_t dst_start;
+  int64_t amount;
+};
+}  // namespace
+
+/**
+ * Moves elements from the emptiest blocks into the fullest blocks that still have capacity, and
+ * releases the blocks that became empty. The moves are planned upfront so that they can all be
+ * done in parallel: no block is a source and a target at the same time and the moved ranges
+ * never overlap.
+ */
+void AttributesBlockContainer::compact()
+{
+  Vector<AttributesBlock *> blocks = active_blocks_;
+  std::sort(blocks.begin(), blocks.end(), [](AttributesBlock *a, AttributesBlock *b) {
+    return a->used_size() > b->used_size();
+  });
+
+  Array<int64_t> planned_sizes(blocks.size());
+  for (const int64_t i : blocks.index_range()) {
+    planned_sizes[i] = blocks[i]->used_size();
+  }
+
+  Vector<ElementsMove> moves;
+  int64_t dst_index = 0;
+  int64_t src_index = blocks.size() - 1;
+  while (dst_index < src_index) {
+    if (planned_sizes[dst_index] == block_size_) {
+      dst_index++;
+      continue;
+    }
+    if (planned_sizes[src_index] == 0) {
+      src_index--;
+      continue;
+    }
+    const int64_t amount = std::min(block_size_ - planned_sizes[dst_index],
+                                    planned_sizes[src_index]);
+    planned_sizes[src_index] -= amount;
+    moves.append({blocks[src_index],
+                  blocks[dst_index],
+                  planned_sizes[src_index],
+                  planned_sizes[dst_index],
+                  amount});
+    planned_sizes[dst_index] += amount;
+  }
+
+  threading::parallel_for(moves.index_range(), 1, [&](IndexRange range) {
+    for (const ElementsMove &move : moves.as_span().slice(range)) {
+      for (const int i : info_.index_range()) {
+        const CPPType &type = info_.type_of(i);
+        void *src = POINTER_OFFSET(move.src_block->buffers_[i], type.size() * move.src_start);
+        void *dst = POINTER_OFFSET(move.dst_block->buffers_[i], type.size() * move.dst_start);
+        type.relocate_to_uninitialized_n(src, dst, move.amount);
+      }
+    }
+  });
+
+  for (const int64_t i : blocks.index_range()) {
+    blocks[i]->used_size_ = planned_sizes[i];
+  }
+  for (AttributesBlock *block : blocks) {
+    if (block->used_size() == 0) {
+      this->release_block(*block);
+    }
+  }
+}
+
+}  // namespace blender::fn
@@ -116,4 +116,27 @@ void CustomMF_DefaultOutput::call(IndexMask mask, MFParams params, MFContext UNU
   }
 }
 
+CustomMF_GenericSwitch::CustomMF_GenericSwitch(const CPPType &type)
+{
+  MFSignatureBuilder signature = this->get_builder("Switch");
+  signature.single_input<bool>("Switch");
+  signature.single_input("If False", type);
+  signature.single_input("If True", type);
+  signature.single_output("Result", type);
+}
+
+void CustomMF_GenericSwitch::call(IndexMask mask, MFParams params, MFContext UNUSED(context)) const
+{
+  VSpan<bool> conditions = params.readonly_single_input<bool>(0, "Switch");
+  GVSpan false_values = params.readonly_single_input(1, "If False");
+  GVSpan true_values = params.readonly_single_input(2, "If True");
+  GMutableSpan results = params.uninitialized_single_output(3, "Result");
+  const CPPType &type = results.type();
+
+  for (const int64_t i : mask) {
+    const void *value = conditions[i] ? true_values[i] : false_values[i];
+    type.copy_to_uninitialized(value, results[i]);
+  }
+}
+
 }  // namespace blender::fn
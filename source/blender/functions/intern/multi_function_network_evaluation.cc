@@ -26,22 +26,81 @@
  * - It does not use recursion. Those could become problematic with long node chains.
  * - It can handle all existing parameter types (including mutable parameters).
  * - Avoids data copies in many cases.
- * - Every node is executed at most once.
+ * - Every node is executed at most once, except for nodes that are only used by a branch of a
+ *   switch. Those are evaluated lazily on the indices that select the branch. Nodes that are used
+ *   by the branch and also somewhere else may be executed again for these indices.
  * - Can compute sub-functions on a single element, when the result is the same for all elements.
+ *   This also applies to outputs provided by the caller, the single value is broadcast into the
+ *   caller's buffer once the socket is computed.
+ * - Large contiguous masks are split into chunks that are evaluated on separate threads. Every
+ *   chunk flows through the entire network, so that intermediate buffers stay small enough to
+ *   remain in cache. Freed buffers are reused by the next chunk on the same thread.
  *
  * Possible improvements:
- * - Cache and reuse buffers.
  * - Use "deepest depth first" heuristic to decide which order the inputs of a node should be
  *   computed. This reduces the number of required temporary buffers when they are reused.
  */
 
+#include "FN_multi_function_builder.hh"
 #include "FN_multi_function_network_evaluation.hh"
 
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_set.hh"
 #include "BLI_stack.hh"
+#include "BLI_task.hh"
 
 namespace blender::fn {
 
 struct Value;
+struct OutputSingleValue;
+struct OutputVectorValue;
+
+/**
+ * Number of elements that are evaluated at once when the mask is split into chunks. This is small
+ * enough for the intermediate buffers of typical networks to stay in the L2 cache.
+ */
+static constexpr int64_t chunk_size = 4096;
+
+/**
+ * Keeps the buffers that have been freed by a #MFNetworkEvaluationStorage, so that they can be
+ * reused by the storage of the next chunk that is evaluated on the same thread.
+ */
+class MFNetworkEvaluationBufferCache : NonCopyable, NonMovable {
+ private:
+  struct Buffer {
+    void *data;
+    int64_t size;
+    int64_t alignment;
+  };
+
+  Vector<Buffer> free_buffers_;
+
+ public:
+  ~MFNetworkEvaluationBufferCache()
+  {
+    for (const Buffer &buffer : free_buffers_) {
+      MEM_freeN(buffer.data);
+    }
+  }
+
+  void *allocate(const int64_t size, const int64_t alignment)
+  {
+    for (const int64_t i : free_buffers_.index_range()) {
+      const Buffer &buffer = free_buffers_[i];
+      if (buffer.size == size && buffer.alignment == alignment) {
+        void *data = buffer.data;
+        free_buffers_.remove_and_reorder(i);
+        return data;
+      }
+    }
+    return MEM_mallocN_aligned(size, alignment, AT);
+  }
+
+  void free(void *data, const int64_t size, const int64_t alignment)
+  {
+    free_buffers_.append({data, size, alignment});
+  }
+};
 
 /**
  * This keeps track of all the values that flow through the multi-function network. Therefore it
@@ -56,9 +115,12 @@ class MFNetworkEvaluationStorage {
   IndexMask mask_;
   Array<Value *> value_per_output_id_;
   int64_t min_array_size_;
+  MFNetworkEvaluationBufferCache *buffer_cache_;
 
  public:
-  MFNetworkEvaluationStorage(IndexMask mask, int socket_id_amount);
+  MFNetworkEvaluationStorage(IndexMask mask,
+                             int socket_id_amount,
+                             MFNetworkEvaluationBufferCache *buffer_cache = nullptr);
   ~MFNetworkEvaluationStorage();
 
   /* Add the values that have been provided by the caller of the multi-function network. */
@@ -93,10 +155,21 @@ class MFNetworkEvaluationStorage {
   void finish_output_socket(const MFOutputSocket &socket);
   void finish_input_socket(const MFInputSocket &socket);
 
+  /* Get the computed value of a socket without using it up. */
+  GVSpan get_single_value__full(const MFOutputSocket &socket);
+  GVArraySpan get_vector_value__full(const MFOutputSocket &socket);
+
   IndexMask mask() const;
+  MFNetworkEvaluationBufferCache *buffer_cache() const;
   bool socket_is_computed(const MFOutputSocket &socket);
   bool is_same_value_for_every_index(const MFOutputSocket &socket);
   bool socket_has_buffer_for_output(const MFOutputSocket &socket);
+
+ private:
+  GMutableSpan allocate_full_buffer(const CPPType &type);
+  void free_full_buffer(GMutableSpan span);
+  GMutableSpan get_single_value_for_output(OutputSingleValue &value);
+  GVectorArray &get_single_vector_array_for_output(OutputVectorValue &value);
 };
 
 MFNetworkEvaluator::MFNetworkEvaluator(Vector<const MFOutputSocket *> inputs,
@@ -141,14 +214,87 @@ void MFNetworkEvaluator::call(IndexMask mask, MFParams params, MFContext context
     return;
   }
 
+  if (this->can_evaluate_in_chunks(mask)) {
+    this->evaluate_in_chunks(mask.as_range(), params, context);
+    return;
+  }
+
+  this->evaluate_mask(mask, params, context);
+}
+
+/**
+ * Chunked evaluation only works when the indices can be remapped by offsetting the caller
+ * buffers. Vector parameters are excluded, because #GVectorArray cannot be sliced and is not
+ * safe to extend from multiple threads.
+ */
+bool MFNetworkEvaluator::can_evaluate_in_chunks(IndexMask mask) const
+{
+  if (mask.size() < 2 * chunk_size || !mask.is_range()) {
+    return false;
+  }
+  for (const MFOutputSocket *socket : inputs_) {
+    if (socket->data_type().is_vector()) {
+      return false;
+    }
+  }
+  for (const MFInputSocket *socket : outputs_) {
+    if (socket->data_type().is_vector()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+BLI_NOINLINE void MFNetworkEvaluator::evaluate_in_chunks(IndexRange range,
+                                                         MFParams params,
+                                                         MFContext context) const
+{
+  const int64_t chunk_amount = (range.size() + chunk_size - 1) / chunk_size;
+  threading::EnumerableThreadSpecific<MFNetworkEvaluationBufferCache> buffer_caches;
+
+  threading::parallel_for(IndexRange(chunk_amount), 1, [&](IndexRange chunk_indices) {
+    MFNetworkEvaluationBufferCache &buffer_cache = buffer_caches.local();
+    for (const int64_t chunk_index : chunk_indices) {
+      const int64_t start = range.start() + chunk_index * chunk_size;
+      const int64_t size = std::min(chunk_size, range.one_after_last() - start);
+
+      /* Every chunk is evaluated on indices starting at zero, with the caller buffers offset. */
+      MFParamsBuilder chunk_params{*this, size};
+      for (const int input_index : inputs_.index_range()) {
+        const int param_index = input_index;
+        chunk_params.add_readonly_single_input(
+            params.readonly_single_input(param_index).slice(start, size));
+      }
+      for (const int output_index : outputs_.index_range()) {
+        const int param_index = output_index + inputs_.size();
+        chunk_params.add_uninitialized_single_output(
+            params.uninitialized_single_output(param_index).slice(start, size));
+      }
+
+      this->evaluate_mask(IndexRange(size), chunk_params, context, &buffer_cache);
+    }
+  });
+}
+
+BLI_NOINLINE void MFNetworkEvaluator::evaluate_mask(
+    IndexMask mask,
+    MFParams params,
+    MFContext context,
+    MFNetworkEvaluationBufferCache *buffer_cache) const
+{
   const MFNetwork &network = outputs_[0]->node().network();
-  Storage storage(mask, network.socket_id_amount());
+  Storage storage(mask, network.socket_id_amount(), buffer_cache);
 
   Vector<const MFInputSocket *> outputs_to_initialize_in_the_end;
 
   this->copy_inputs_to_storage(params, storage);
   this->copy_outputs_to_storage(params, storage, outputs_to_initialize_in_the_end);
-  this->evaluate_network_to_compute_outputs(context, storage);
+
+  Vector<const MFOutputSocket *, 32> sockets_to_compute;
+  for (const MFInputSocket *socket : outputs_) {
+    sockets_to_compute.append(socket->origin());
+  }
+  this->evaluate_network_to_compute_sockets(context, storage, sockets_to_compute);
   this->initialize_remaining_outputs(params, storage, outputs_to_initialize_in_the_end);
 }
 
@@ -211,13 +357,16 @@ BLI_NOINLINE void MFNetworkEvaluator::copy_outputs_to_storage(
   }
 }
 
-BLI_NOINLINE void MFNetworkEvaluator::evaluate_network_to_compute_outputs(
-    MFContext &global_context, Storage &storage) const
+static bool is_switch_node(const MFFunctionNode &node)
+{
+  return dynamic_cast<const CustomMF_GenericSwitch *>(&node.function()) != nullptr;
+}
+
+BLI_NOINLINE void MFNetworkEvaluator::evaluate_network_to_compute_sockets(
+    MFContext &global_context, Storage &storage, Span<const MFOutputSocket *> sockets) const
 {
   Stack<const MFOutputSocket *, 32> sockets_to_compute;
-  for (const MFInputSocket *socket : outputs_) {
-    sockets_to_compute.push(socket->origin());
-  }
+  sockets_to_compute.push_multiple(sockets);
 
   /* This is the main loop that traverses the MFNetwork. */
   while (!sockets_to_compute.is_empty()) {
@@ -232,22 +381,36 @@ BLI_NOINLINE void MFNetworkEvaluator::evaluate_network_to_compute_outputs(
     BLI_assert(node.is_function());
     BLI_assert(!node.has_unlinked_inputs());
     const MFFunctionNode &function_node = node.as_function();
+    const bool is_switch = is_switch_node(function_node);
 
     bool all_origins_are_computed = true;
+    bool all_required_origins_are_computed = true;
     for (const MFInputSocket *input_socket : function_node.inputs()) {
       const MFOutputSocket *origin = input_socket->origin();
       if (origin != nullptr) {
         if (!storage.socket_is_computed(*origin)) {
-          sockets_to_compute.push(origin);
           all_origins_are_computed = false;
+          if (is_switch && input_socket->index() > 0 &&
+              this->can_evaluate_switch_input_lazily(*input_socket)) {
+            continue;
+          }
+          sockets_to_compute.push(origin);
+          all_required_origins_are_computed = false;
         }
       }
     }
 
-    if (all_origins_are_computed) {
+    if (!all_required_origins_are_computed) {
+      continue;
+    }
+    if (is_switch && !(all_origins_are_computed &&
+                       this->can_do_single_value_evaluation(function_node, storage))) {
+      this->evaluate_switch(global_context, function_node, storage);
+    }
+    else {
       this->evaluate_function(global_context, function_node, storage);
-      sockets_to_compute.pop();
     }
+    sockets_to_compute.pop();
   }
 }
 
@@ -370,9 +533,23 @@ bool MFNetworkEvaluator::can_do_single_value_evaluation(const MFFunctionNode &fu
       return false;
     }
   }
-  if (storage.mask().min_array_size() >= 1) {
-    for (const MFOutputSocket *socket : function_node.outputs()) {
-      if (storage.socket_has_buffer_for_output(*socket)) {
+  /* Outputs provided by the caller get the single value broadcast when the node is finished. */
+  return true;
+}
+
+/**
+ * A branch of a switch is evaluated lazily when nothing else depends on the node it comes from.
+ */
+bool MFNetworkEvaluator::can_evaluate_switch_input_lazily(const MFInputSocket &socket) const
+{
+  const MFOutputSocket &origin = *socket.origin();
+  const MFNode &node = origin.node();
+  if (node.is_dummy() || !origin.data_type().is_single()) {
+    return false;
+  }
+  for (const MFOutputSocket *output : node.outputs()) {
+    for (const MFInputSocket *target : output->targets()) {
+      if (target != &socket) {
         return false;
       }
     }
@@ -380,6 +557,103 @@ bool MFNetworkEvaluator::can_do_single_value_evaluation(const MFFunctionNode &fu
   return true;
 }
 
+/**
+ * Splits the mask based on the condition and computes the result for each part from the
+ * corresponding branch. Branches that have not been computed yet are only evaluated on their
+ * part of the mask.
+ */
+BLI_NOINLINE void MFNetworkEvaluator::evaluate_switch(MFContext &global_context,
+                                                      const MFFunctionNode &function_node,
+                                                      Storage &storage) const
+{
+  VSpan<bool> conditions = storage.get_single_input__full(function_node.input(0)).typed<bool>();
+
+  Vector<int64_t> false_indices;
+  Vector<int64_t> true_indices;
+  for (const int64_t i : storage.mask()) {
+    if (conditions[i]) {
+      true_indices.append(i);
+    }
+    else {
+      false_indices.append(i);
+    }
+  }
+
+  GMutableSpan results = storage.get_single_output__full(function_node.output(0));
+  this->evaluate_switch_branch(
+      global_context, function_node.input(1), false_indices.as_span(), results, storage);
+  this->evaluate_switch_branch(
+      global_context, function_node.input(2), true_indices.as_span(), results, storage);
+
+  storage.finish_node(function_node);
+}
+
+BLI_NOINLINE void MFNetworkEvaluator::evaluate_switch_branch(MFContext &global_context,
+                                                             const MFInputSocket &socket,
+                                                             IndexMask mask,
+                                                             GMutableSpan r_results,
+                                                             Storage &storage) const
+{
+  if (mask.size() == 0) {
+    return;
+  }
+
+  const MFOutputSocket &origin = *socket.origin();
+  if (storage.socket_is_computed(origin)) {
+    GVSpan values = storage.get_single_input__full(socket);
+    values.materialize_to_uninitialized(mask, r_results.data());
+    return;
+  }
+
+  /* The branch is evaluated in a separate storage that only knows about the indices that select
+   * it. Values that have been computed already are shared with it. */
+  const MFNetwork &network = origin.node().network();
+  Storage branch_storage(mask, network.socket_id_amount(), storage.buffer_cache());
+  this->share_computed_values(origin, storage, branch_storage);
+  branch_storage.add_single_output_from_caller(origin, r_results);
+  this->evaluate_network_to_compute_sockets(global_context, branch_storage, {&origin});
+}
+
+/**
+ * Makes all values computed in #from, that are required to compute the given socket, available
+ * in #to.
+ */
+void MFNetworkEvaluator::share_computed_values(const MFOutputSocket &socket,
+                                               Storage &from,
+                                               Storage &to) const
+{
+  Stack<const MFOutputSocket *> sockets_to_check;
+  Set<const MFNode *> checked_nodes;
+  sockets_to_check.push(&socket);
+
+  while (!sockets_to_check.is_empty()) {
+    const MFOutputSocket &socket_to_check = *sockets_to_check.pop();
+    if (to.socket_is_computed(socket_to_check)) {
+      continue;
+    }
+    if (from.socket_is_computed(socket_to_check)) {
+      switch (socket_to_check.data_type().category()) {
+        case MFDataType::Single:
+          to.add_single_input_from_caller(socket_to_check,
+                                          from.get_single_value__full(socket_to_check));
+          break;
+        case MFDataType::Vector:
+          to.add_vector_input_from_caller(socket_to_check,
+                                          from.get_vector_value__full(socket_to_check));
+          break;
+      }
+      continue;
+    }
+    const MFNode &node = socket_to_check.node();
+    if (!checked_nodes.add(&node)) {
+      continue;
+    }
+    for (const MFInputSocket *input : node.inputs()) {
+      sockets_to_check.push(input->origin());
+    }
+  }
+}
+
 BLI_NOINLINE void MFNetworkEvaluator::initialize_remaining_outputs(
     MFParams params, Storage &storage, Span<const MFInputSocket *> remaining_outputs) const
 {
@@ -454,6 +728,9 @@ struct OutputValue : public Value {
 struct OutputSingleValue : public OutputValue {
   /** This span has been provided by the code that called the multi-function network. */
   GMutableSpan span;
+  /** When the value is the same for every index, it is computed only once into this buffer and
+   * broadcast to #span when the socket is finished. */
+  void *single_value = nullptr;
 
   OutputSingleValue(GMutableSpan span) : OutputValue(ValueType::OutputSingle), span(span)
   {
@@ -463,6 +740,8 @@ struct OutputSingleValue : public OutputValue {
 struct OutputVectorValue : public OutputValue {
   /** This vector array has been provided by the code that called the multi-function network. */
   GVectorArray *vector_array;
+  /** Same as #OutputSingleValue.single_value. */
+  GVectorArray *single_vector_array = nullptr;
 
   OutputVectorValue(GVectorArray &vector_array)
       : OutputValue(ValueType::OutputVector), vector_array(&vector_array)
@@ -506,10 +785,12 @@ struct OwnVectorValue : public Value {
 /** \name Storage methods
  * \{ */
 
-MFNetworkEvaluationStorage::MFNetworkEvaluationStorage(IndexMask mask, int socket_id_amount)
+MFNetworkEvaluationStorage::MFNetworkEvaluationStorage(
+    IndexMask mask, int socket_id_amount, MFNetworkEvaluationBufferCache *buffer_cache)
     : mask_(mask),
       value_per_output_id_(socket_id_amount, nullptr),
-      min_array_size_(mask.min_array_size())
+      min_array_size_(mask.min_array_size()),
+      buffer_cache_(buffer_cache)
 {
 }
 
@@ -528,13 +809,43 @@ MFNetworkEvaluationStorage::~MFNetworkEvaluationStorage()
       }
       else {
         type.destruct_indices(span.data(), mask_);
-        MEM_freeN(span.data());
+        this->free_full_buffer(span);
       }
     }
     else if (any_value->type == ValueType::OwnVector) {
       OwnVectorValue *value = static_cast<OwnVectorValue *>(any_value);
       delete value->vector_array;
     }
+    else if (any_value->type == ValueType::OutputSingle) {
+      OutputSingleValue *value = static_cast<OutputSingleValue *>(any_value);
+      if (value->single_value != nullptr) {
+        value->span.type().destruct(value->single_value);
+      }
+    }
+    else if (any_value->type == ValueType::OutputVector) {
+      OutputVectorValue *value = static_cast<OutputVectorValue *>(any_value);
+      delete value->single_vector_array;
+    }
+  }
+}
+
+GMutableSpan MFNetworkEvaluationStorage::allocate_full_buffer(const CPPType &type)
+{
+  const int64_t size = min_array_size_ * type.size();
+  void *buffer = (buffer_cache_ == nullptr) ?
+                     MEM_mallocN_aligned(size, type.alignment(), AT) :
+                     buffer_cache_->allocate(size, type.alignment());
+  return GMutableSpan(type, buffer, min_array_size_);
+}
+
+void MFNetworkEvaluationStorage::free_full_buffer(GMutableSpan span)
+{
+  const CPPType &type = span.type();
+  if (buffer_cache_ == nullptr) {
+    MEM_freeN(span.data());
+  }
+  else {
+    buffer_cache_->free(span.data(), span.size() * type.size(), type.alignment());
   }
 }
 
@@ -543,6 +854,11 @@ IndexMask MFNetworkEvaluationStorage::mask() const
   return mask_;
 }
 
+MFNetworkEvaluationBufferCache *MFNetworkEvaluationStorage::buffer_cache() const
+{
+  return buffer_cache_;
+}
+
 bool MFNetworkEvaluationStorage::socket_is_computed(const MFOutputSocket &socket)
 {
   Value *any_value = value_per_output_id_[socket.id()];
@@ -567,10 +883,14 @@ bool MFNetworkEvaluationStorage::is_same_value_for_every_index(const MFOutputSoc
       return static_cast<InputSingleValue *>(any_value)->virtual_span.is_single_element();
     case ValueType::InputVector:
       return static_cast<InputVectorValue *>(any_value)->virtual_array_span.is_single_array();
-    case ValueType::OutputSingle:
-      return static_cast<OutputSingleValue *>(any_value)->span.size() == 1;
-    case ValueType::OutputVector:
-      return static_cast<OutputVectorValue *>(any_value)->vector_array->size() == 1;
+    case ValueType::OutputSingle: {
+      OutputSingleValue *value = static_cast<OutputSingleValue *>(any_value);
+      return value->single_value != nullptr || value->span.size() == 1;
+    }
+    case ValueType::OutputVector: {
+      OutputVectorValue *value = static_cast<OutputVectorValue *>(any_value);
+      return value->single_vector_array != nullptr || value->vector_array->size() == 1;
+    }
   }
   BLI_assert(false);
   return false;
@@ -604,8 +924,21 @@ void MFNetworkEvaluationStorage::finish_output_socket(const MFOutputSocket &sock
     return;
   }
 
-  if (ELEM(any_value->type, ValueType::OutputSingle, ValueType::OutputVector)) {
-    static_cast<OutputValue *>(any_value)->is_computed = true;
+  if (any_value->type == ValueType::OutputSingle) {
+    OutputSingleValue *value = static_cast<OutputSingleValue *>(any_value);
+    if (value->single_value != nullptr && !value->is_computed) {
+      value->span.type().fill_uninitialized_indices(
+          value->single_value, value->span.data(), mask_);
+    }
+    value->is_computed = true;
+  }
+  else if (any_value->type == ValueType::OutputVector) {
+    OutputVectorValue *value = static_cast<OutputVectorValue *>(any_value);
+    if (value->single_vector_array != nullptr && !value->is_computed) {
+      GSpan single_array = (*value->single_vector_array)[0];
+      value->vector_array->extend(mask_, GVArraySpan(single_array, min_array_size_));
+    }
+    value->is_computed = true;
   }
 }
 
@@ -638,7 +971,7 @@ void MFNetworkEvaluationStorage::finish_input_socket(const MFInputSocket &socket
         }
         else {
           type.destruct_indices(span.data(), mask_);
-          MEM_freeN(span.data());
+          this->free_full_buffer(span);
         }
         value_per_output_id_[origin.id()] = nullptr;
       }
@@ -702,8 +1035,7 @@ GMutableSpan MFNetworkEvaluationStorage::get_single_output__full(const MFOutputS
   Value *any_value = value_per_output_id_[socket.id()];
   if (any_value == nullptr) {
     const CPPType &type = socket.data_type().single_type();
-    void *buffer = MEM_mallocN_aligned(min_array_size_ * type.size(), type.alignment(), AT);
-    GMutableSpan span(type, buffer, min_array_size_);
+    GMutableSpan span = this->allocate_full_buffer(type);
 
     auto *value = allocator_.construct<OwnSingleValue>(span, socket.targets().size(), false);
     value_per_output_id_[socket.id()] = value;
@@ -730,9 +1062,19 @@ GMutableSpan MFNetworkEvaluationStorage::get_single_output__single(const MFOutpu
   }
 
   BLI_assert(any_value->type == ValueType::OutputSingle);
-  GMutableSpan span = static_cast<OutputSingleValue *>(any_value)->span;
-  BLI_assert(span.size() == 1);
-  return span;
+  return this->get_single_value_for_output(*static_cast<OutputSingleValue *>(any_value));
+}
+
+GMutableSpan MFNetworkEvaluationStorage::get_single_value_for_output(OutputSingleValue &value)
+{
+  GMutableSpan span = value.span;
+  if (span.size() == 1) {
+    return span;
+  }
+  const CPPType &type = span.type();
+  BLI_assert(value.single_value == nullptr);
+  value.single_value = allocator_.allocate(type.size(), type.alignment());
+  return GMutableSpan(type, value.single_value, 1);
 }
 
 GVectorArray &MFNetworkEvaluationStorage::get_vector_output__full(const MFOutputSocket &socket)
@@ -766,9 +1108,18 @@ GVectorArray &MFNetworkEvaluationStorage::get_vector_output__single(const MFOutp
   }
 
   BLI_assert(any_value->type == ValueType::OutputVector);
-  GVectorArray &vector_array = *static_cast<OutputVectorValue *>(any_value)->vector_array;
-  BLI_assert(vector_array.size() == 1);
-  return vector_array;
+  return this->get_single_vector_array_for_output(*static_cast<OutputVectorValue *>(any_value));
+}
+
+GVectorArray &MFNetworkEvaluationStorage::get_single_vector_array_for_output(
+    OutputVectorValue &value)
+{
+  if (value.vector_array->size() == 1) {
+    return *value.vector_array;
+  }
+  BLI_assert(value.single_vector_array == nullptr);
+  value.single_vector_array = new GVectorArray(value.vector_array->type(), 1);
+  return *value.single_vector_array;
 }
 
 GMutableSpan MFNetworkEvaluationStorage::get_mutable_single__full(const MFInputSocket &input,
@@ -802,8 +1153,7 @@ GMutableSpan MFNetworkEvaluationStorage::get_mutable_single__full(const MFInputS
   }
 
   GVSpan virtual_span = this->get_single_input__full(input);
-  void *new_buffer = MEM_mallocN_aligned(min_array_size_ * type.size(), type.alignment(), AT);
-  GMutableSpan new_array_ref(type, new_buffer, min_array_size_);
+  GMutableSpan new_array_ref = this->allocate_full_buffer(type);
   virtual_span.materialize_to_uninitialized(mask_, new_array_ref.data());
 
   OwnSingleValue *new_value = allocator_.construct<OwnSingleValue>(
@@ -826,8 +1176,8 @@ GMutableSpan MFNetworkEvaluationStorage::get_mutable_single__single(const MFInpu
 
   if (to_any_value != nullptr) {
     BLI_assert(to_any_value->type == ValueType::OutputSingle);
-    GMutableSpan span = static_cast<OutputSingleValue *>(to_any_value)->span;
-    BLI_assert(span.size() == 1);
+    GMutableSpan span = this->get_single_value_for_output(
+        *static_cast<OutputSingleValue *>(to_any_value));
     GVSpan virtual_span = this->get_single_input__single(input);
     type.copy_to_uninitialized(virtual_span.as_single_element(), span[0]);
     return span;
@@ -912,8 +1262,8 @@ GVectorArray &MFNetworkEvaluationStorage::get_mutable_vector__single(const MFInp
 
   if (to_any_value != nullptr) {
     BLI_assert(to_any_value->type == ValueType::OutputVector);
-    GVectorArray &vector_array = *static_cast<OutputVectorValue *>(to_any_value)->vector_array;
-    BLI_assert(vector_array.size() == 1);
+    GVectorArray &vector_array = this->get_single_vector_array_for_output(
+        *static_cast<OutputVectorValue *>(to_any_value));
     GVArraySpan virtual_array_span = this->get_vector_input__single(input);
     vector_array.extend(0, virtual_array_span[0]);
     return vector_array;
@@ -942,8 +1292,12 @@ GVectorArray &MFNetworkEvaluationStorage::get_mutable_vector__single(const MFInp
 
 GVSpan MFNetworkEvaluationStorage::get_single_input__full(const MFInputSocket &socket)
 {
-  const MFOutputSocket &origin = *socket.origin();
-  Value *any_value = value_per_output_id_[origin.id()];
+  return this->get_single_value__full(*socket.origin());
+}
+
+GVSpan MFNetworkEvaluationStorage::get_single_value__full(const MFOutputSocket &socket)
+{
+  Value *any_value = value_per_output_id_[socket.id()];
   BLI_assert(any_value != nullptr);
 
   if (any_value->type == ValueType::OwnSingle) {
@@ -961,6 +1315,9 @@ GVSpan MFNetworkEvaluationStorage::get_single_input__full(const MFInputSocket &s
   if (any_value->type == ValueType::OutputSingle) {
     OutputSingleValue *value = static_cast<OutputSingleValue *>(any_value);
     BLI_assert(value->is_computed);
+    if (value->single_value != nullptr) {
+      return GVSpan::FromSingle(value->span.type(), value->single_value, min_array_size_);
+    }
     return value->span;
   }
 
@@ -987,6 +1344,9 @@ GVSpan MFNetworkEvaluationStorage::get_single_input__single(const MFInputSocket
   if (any_value->type == ValueType::OutputSingle) {
     OutputSingleValue *value = static_cast<OutputSingleValue *>(any_value);
     BLI_assert(value->is_computed);
+    if (value->single_value != nullptr) {
+      return GSpan(value->span.type(), value->single_value, 1);
+    }
     BLI_assert(value->span.size() == 1);
     return value->span;
   }
@@ -997,8 +1357,12 @@ GVSpan MFNetworkEvaluationStorage::get_single_input__single(const MFInputSocket
 
 GVArraySpan MFNetworkEvaluationStorage::get_vector_input__full(const MFInputSocket &socket)
 {
-  const MFOutputSocket &origin = *socket.origin();
-  Value *any_value = value_per_output_id_[origin.id()];
+  return this->get_vector_value__full(*socket.origin());
+}
+
+GVArraySpan MFNetworkEvaluationStorage::get_vector_value__full(const MFOutputSocket &socket)
+{
+  Value *any_value = value_per_output_id_[socket.id()];
   BLI_assert(any_value != nullptr);
 
   if (any_value->type == ValueType::OwnVector) {
@@ -1041,6 +1405,9 @@ GVArraySpan MFNetworkEvaluationStorage::get_vector_input__single(const MFInputSo
   }
   if (any_value->type == ValueType::OutputVector) {
     OutputVectorValue *value = static_cast<OutputVectorValue *>(any_value);
+    if (value->single_vector_array != nullptr) {
+      return *value->single_vector_array;
+    }
     BLI_assert(value->vector_array->size() == 1);
     return *value->vector_array;
   }
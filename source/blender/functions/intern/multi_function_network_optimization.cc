@@ -505,4 +505,362 @@ void common_subnetwork_elimination(MFNetwork &network)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Element-wise Function Fusion
+ *
+ * \{ */
+
+/**
+ * Evaluates a tree of element-wise functions in small blocks. The intermediate values of a block
+ * stay in cache, so that the caller arrays are only traversed once and no full-size temporary
+ * arrays are allocated.
+ */
+class MFFusedElementWiseFunction : public MultiFunction {
+ public:
+  struct Step {
+    const MultiFunction *function;
+    /* The slot that is used by every parameter of the function. */
+    Vector<int> param_slots;
+  };
+
+ private:
+  /* Number of elements that flow through all steps at once. */
+  static constexpr int64_t block_size = 256;
+
+  /* The first slots are the inputs of the fused function, all others are computed by a step. */
+  Vector<const CPPType *> slot_types_;
+  int input_amount_;
+  Vector<int> output_slots_;
+  Vector<Step> steps_;
+
+ public:
+  MFFusedElementWiseFunction(StringRef name,
+                             Vector<const CPPType *> slot_types,
+                             int input_amount,
+                             Vector<int> output_slots,
+                             Vector<Step> steps)
+      : slot_types_(std::move(slot_types)),
+        input_amount_(input_amount),
+        output_slots_(std::move(output_slots)),
+        steps_(std::move(steps))
+  {
+    MFSignatureBuilder signature = this->get_builder(name);
+    for (const int slot : IndexRange(input_amount_)) {
+      signature.single_input("In" + std::to_string(slot), *slot_types_[slot]);
+    }
+    for (const int i : output_slots_.index_range()) {
+      signature.single_output("Out" + std::to_string(i), *slot_types_[output_slots_[i]]);
+    }
+    signature.element_wise();
+  }
+
+  void call(IndexMask mask, MFParams params, MFContext context) const override
+  {
+    const int64_t buffer_size = std::min(block_size, mask.size());
+    LinearAllocator<> allocator;
+
+    /* Every slot gets a block-sized buffer. Input buffers are only used when the values have to
+     * be gathered from a non-contiguous mask. */
+    Array<void *> slot_buffers(slot_types_.size());
+    for (const int slot : slot_types_.index_range()) {
+      const CPPType &type = *slot_types_[slot];
+      slot_buffers[slot] = allocator.allocate(buffer_size * type.size(), type.alignment());
+    }
+
+    Vector<GVSpan> caller_inputs;
+    for (const int slot : IndexRange(input_amount_)) {
+      caller_inputs.append(params.readonly_single_input(slot));
+    }
+    Vector<GMutableSpan> caller_outputs;
+    for (const int i : output_slots_.index_range()) {
+      caller_outputs.append(params.uninitialized_single_output(input_amount_ + i));
+    }
+
+    const bool is_range = mask.is_range();
+    Vector<GVSpan> block_inputs;
+    Array<void *> slot_data(slot_types_.size());
+
+    for (int64_t block_start = 0; block_start < mask.size(); block_start += block_size) {
+      const int64_t size = std::min(block_size, mask.size() - block_start);
+      const int64_t first_index = mask[block_start];
+      Span<int64_t> indices = mask.indices().slice(block_start, size);
+
+      block_inputs.clear();
+      for (const int slot : IndexRange(input_amount_)) {
+        const GVSpan &input = caller_inputs[slot];
+        const CPPType &type = input.type();
+        if (is_range) {
+          block_inputs.append(input.slice(first_index, size));
+        }
+        else if (input.is_single_element()) {
+          block_inputs.append(GVSpan::FromSingle(type, input.as_single_element(), size));
+        }
+        else {
+          void *buffer = slot_buffers[slot];
+          for (const int64_t i : IndexRange(size)) {
+            type.copy_to_uninitialized(input[indices[i]], POINTER_OFFSET(buffer, type.size() * i));
+          }
+          block_inputs.append(GSpan(type, buffer, size));
+        }
+      }
+
+      slot_data.as_mutable_span().copy_from(slot_buffers);
+      if (is_range) {
+        /* Write the outputs directly into the caller arrays. */
+        for (const int i : output_slots_.index_range()) {
+          slot_data[output_slots_[i]] = caller_outputs[i].slice(first_index, size).data();
+        }
+      }
+
+      for (const Step &step : steps_) {
+        this->call_step(step, size, block_inputs, slot_data, context);
+      }
+
+      for (const int slot : IndexRange(input_amount_, slot_types_.size() - input_amount_)) {
+        if (is_range && output_slots_.contains(slot)) {
+          continue;
+        }
+        slot_types_[slot]->destruct_n(slot_data[slot], size);
+      }
+      if (is_range) {
+        continue;
+      }
+      for (const int slot : IndexRange(input_amount_)) {
+        if (!caller_inputs[slot].is_single_element()) {
+          slot_types_[slot]->destruct_n(slot_buffers[slot], size);
+        }
+      }
+      for (const int i : output_slots_.index_range()) {
+        GMutableSpan output = caller_outputs[i];
+        const CPPType &type = output.type();
+        void *buffer = slot_data[output_slots_[i]];
+        for (const int64_t j : IndexRange(size)) {
+          type.relocate_to_uninitialized(POINTER_OFFSET(buffer, type.size() * j),
+                                         output[indices[j]]);
+        }
+      }
+    }
+  }
+
+ private:
+  void call_step(const Step &step,
+                 const int64_t size,
+                 Span<GVSpan> block_inputs,
+                 Span<void *> slot_data,
+                 MFContext context) const
+  {
+    const MultiFunction &function = *step.function;
+    MFParamsBuilder params{function, size};
+    for (const int param_index : function.param_indices()) {
+      const int slot = step.param_slots[param_index];
+      const CPPType &type = *slot_types_[slot];
+      switch (function.param_type(param_index).category()) {
+        case MFParamType::SingleInput: {
+          if (slot < input_amount_) {
+            params.add_readonly_single_input(block_inputs[slot]);
+          }
+          else {
+            params.add_readonly_single_input(GSpan(type, slot_data[slot], size));
+          }
+          break;
+        }
+        case MFParamType::SingleOutput: {
+          params.add_uninitialized_single_output(GMutableSpan(type, slot_data[slot], size));
+          break;
+        }
+        default: {
+          BLI_assert(false);
+          break;
+        }
+      }
+    }
+    function.call(IndexRange(size), params, context);
+  }
+};
+
+static bool function_node_can_be_fused(MFFunctionNode &node)
+{
+  if (node.has_unlinked_inputs()) {
+    return false;
+  }
+  if (node.function().depends_on_context()) {
+    return false;
+  }
+  return node.function().is_element_wise();
+}
+
+static Vector<MFNode *> sort_nodes_topologically(MFNetwork &network)
+{
+  Array<int> remaining_inputs(network.node_id_amount(), 0);
+  Stack<MFNode *> nodes_to_check;
+  Vector<MFNode *> sorted_nodes;
+
+  for (int id : IndexRange(network.node_id_amount())) {
+    MFNode *node = network.node_or_null_by_id(id);
+    if (node == nullptr) {
+      continue;
+    }
+    for (MFInputSocket *input_socket : node->inputs()) {
+      if (input_socket->origin() != nullptr) {
+        remaining_inputs[id]++;
+      }
+    }
+    if (remaining_inputs[id] == 0) {
+      nodes_to_check.push(node);
+    }
+  }
+
+  while (!nodes_to_check.is_empty()) {
+    MFNode &node = *nodes_to_check.pop();
+    sorted_nodes.append(&node);
+
+    for (MFOutputSocket *output_socket : node.outputs()) {
+      for (MFInputSocket *target_socket : output_socket->targets()) {
+        MFNode &target_node = target_socket->node();
+        if (--remaining_inputs[target_node.id()] == 0) {
+          nodes_to_check.push(&target_node);
+        }
+      }
+    }
+  }
+
+  return sorted_nodes;
+}
+
+/**
+ * A node joins the group of its targets, when all of them are in the same group. Therefore, only
+ * the first node of a group (its root) can have targets outside of the group, which guarantees
+ * that fusing the group does not introduce cycles.
+ */
+static int find_group_of_all_targets(MFFunctionNode &node, Span<int> group_by_node)
+{
+  int group = -1;
+  for (MFOutputSocket *output_socket : node.outputs()) {
+    for (MFInputSocket *target_socket : output_socket->targets()) {
+      const int target_group = group_by_node[target_socket->node().id()];
+      if (target_group == -1 || (group != -1 && group != target_group)) {
+        return -1;
+      }
+      group = target_group;
+    }
+  }
+  return group;
+}
+
+/**
+ * The nodes of the group are in reverse topological order, the first node is the root.
+ */
+static void fuse_group(MFNetwork &network,
+                       ResourceCollector &resources,
+                       Span<MFFunctionNode *> group_nodes,
+                       Span<int> group_by_node)
+{
+  const int group = group_by_node[group_nodes[0]->id()];
+  Vector<MFFunctionNode *> sorted_nodes;
+  for (int i = group_nodes.size() - 1; i >= 0; i--) {
+    sorted_nodes.append(group_nodes[i]);
+  }
+
+  Map<const MFOutputSocket *, int> slot_by_socket;
+  Vector<const CPPType *> slot_types;
+  Vector<MFOutputSocket *> external_origins;
+
+  for (MFFunctionNode *node : sorted_nodes) {
+    for (MFInputSocket *input_socket : node->inputs()) {
+      MFOutputSocket *origin = input_socket->origin();
+      if (group_by_node[origin->node().id()] == group) {
+        continue;
+      }
+      if (slot_by_socket.add(origin, slot_types.size())) {
+        slot_types.append(&origin->data_type().single_type());
+        external_origins.append(origin);
+      }
+    }
+  }
+  const int input_amount = slot_types.size();
+
+  for (MFFunctionNode *node : sorted_nodes) {
+    for (MFOutputSocket *output_socket : node->outputs()) {
+      slot_by_socket.add_new(output_socket, slot_types.size());
+      slot_types.append(&output_socket->data_type().single_type());
+    }
+  }
+
+  Vector<MFFusedElementWiseFunction::Step> steps;
+  std::string name = "Fused";
+  for (MFFunctionNode *node : sorted_nodes) {
+    const MultiFunction &function = node->function();
+    MFFusedElementWiseFunction::Step step;
+    step.function = &function;
+    for (const int param_index : function.param_indices()) {
+      const MFParamType param_type = function.param_type(param_index);
+      if (param_type.is_input_or_mutable()) {
+        const MFInputSocket &socket = node->input_for_param(param_index);
+        step.param_slots.append(slot_by_socket.lookup(socket.origin()));
+      }
+      else {
+        const MFOutputSocket &socket = node->output_for_param(param_index);
+        step.param_slots.append(slot_by_socket.lookup(&socket));
+      }
+    }
+    steps.append(std::move(step));
+    name += " " + function.name();
+  }
+
+  MFFunctionNode &root_node = *group_nodes[0];
+  Vector<int> output_slots;
+  for (MFOutputSocket *output_socket : root_node.outputs()) {
+    output_slots.append(slot_by_socket.lookup(output_socket));
+  }
+
+  const MultiFunction &fused_fn = resources.construct<MFFusedElementWiseFunction>(
+      AT, name, std::move(slot_types), input_amount, std::move(output_slots), std::move(steps));
+  MFFunctionNode &fused_node = network.add_function(fused_fn);
+  for (const int i : external_origins.index_range()) {
+    network.add_link(*external_origins[i], fused_node.input(i));
+  }
+  for (const int i : root_node.outputs().index_range()) {
+    network.relink(root_node.output(i), fused_node.output(i));
+  }
+  network.remove(group_nodes.cast<MFNode *>());
+}
+
+/**
+ * Replace trees of connected element-wise functions with a single function that evaluates them
+ * in blocks. This avoids a pass over memory and a temporary array for every intermediate value.
+ */
+void element_wise_fusion(MFNetwork &network, ResourceCollector &resources)
+{
+  const Vector<MFNode *> sorted_nodes = sort_nodes_topologically(network);
+
+  /* The fusion group of every node, or -1 when the node is not fused. */
+  Array<int> group_by_node(network.node_id_amount(), -1);
+  Vector<Vector<MFFunctionNode *>> groups;
+
+  for (int i = sorted_nodes.size() - 1; i >= 0; i--) {
+    MFNode *node = sorted_nodes[i];
+    if (!node->is_function()) {
+      continue;
+    }
+    MFFunctionNode &function_node = node->as_function();
+    if (!function_node_can_be_fused(function_node)) {
+      continue;
+    }
+    int group = find_group_of_all_targets(function_node, group_by_node);
+    if (group == -1) {
+      group = groups.append_and_get_index({});
+    }
+    groups[group].append(&function_node);
+    group_by_node[function_node.id()] = group;
+  }
+
+  for (Span<MFFunctionNode *> group_nodes : groups) {
+    if (group_nodes.size() >= 2) {
+      fuse_group(network, resources, group_nodes, group_by_node);
+    }
+  }
+}
+
+/** \} */
+
 }  // namespace blender::fn::mf_network_optimization
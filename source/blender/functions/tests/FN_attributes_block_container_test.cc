@@ -0,0 +1,142 @@
+/* Apache License, Version 2.0 */
+
+#include "FN_attributes_block_container.hh"
+
+#include "testing/testing.h"
+
+namespace blender::fn::tests {
+
+TEST(attributes_block_container, AddDefault)
+{
+  AttributesInfoBuilder info_builder;
+  info_builder.add<int>("A", 4);
+  info_builder.add<std::string>("B", "hello");
+  AttributesInfo info{info_builder};
+
+  AttributesBlockContainer container{info, 10};
+  EXPECT_EQ(container.size(), 0);
+
+  MutableAttributesRef attributes = container.add_default(3);
+  EXPECT_EQ(attributes.size(), 3);
+  EXPECT_EQ(attributes.get<int>("A")[2], 4);
+  EXPECT_EQ(attributes.get<std::string>("B")[1], "hello");
+  attributes.get<int>("A")[1] = 7;
+
+  EXPECT_EQ(container.size(), 3);
+  EXPECT_EQ(container.active_blocks().size(), 1);
+  AttributesBlock &block = *container.active_blocks()[0];
+  EXPECT_EQ(block.unused_capacity(), 7);
+  EXPECT_EQ(block.attributes().get<int>("A")[1], 7);
+}
+
+TEST(attributes_block_container, Remove)
+{
+  AttributesInfoBuilder info_builder;
+  info_builder.add<int>("A", 0);
+  info_builder.add<std::string>("B", "");
+  AttributesInfo info{info_builder};
+
+  AttributesBlockContainer container{info, 10};
+  AttributesBlock &block = container.new_block();
+  MutableAttributesRef attributes = block.add_default(6);
+  for (const int i : IndexRange(6)) {
+    attributes.get<int>("A")[i] = i;
+    attributes.get<std::string>("B")[i] = std::to_string(i);
+  }
+
+  block.remove({0, 3, 5});
+  EXPECT_EQ(block.used_size(), 3);
+  MutableSpan<int> a = block.attributes().get<int>("A");
+  MutableSpan<std::string> b = block.attributes().get<std::string>("B");
+  EXPECT_EQ(a[0], 4);
+  EXPECT_EQ(a[1], 1);
+  EXPECT_EQ(a[2], 2);
+  EXPECT_EQ(b[0], "4");
+  EXPECT_EQ(b[1], "1");
+  EXPECT_EQ(b[2], "2");
+}
+
+TEST(attributes_block_container, ReuseReleasedBlock)
+{
+  AttributesInfoBuilder info_builder;
+  info_builder.add<float>("A", 0.0f);
+  AttributesInfo info{info_builder};
+
+  AttributesBlockContainer container{info, 10};
+  AttributesBlock &block1 = container.new_block();
+  block1.add_default(5);
+  container.release_block(block1);
+  EXPECT_EQ(container.active_blocks().size(), 0);
+
+  AttributesBlock &block2 = container.new_block();
+  EXPECT_EQ(&block1, &block2);
+  EXPECT_EQ(block2.used_size(), 0);
+}
+
+TEST(attributes_block_container, Compact)
+{
+  AttributesInfoBuilder info_builder;
+  info_builder.add<int>("A", 0);
+  AttributesInfo info{info_builder};
+
+  AttributesBlockContainer container{info, 10};
+  for (const int size : {2, 9, 10, 5, 1, 0}) {
+    MutableSpan<int> values = container.new_block().add_default(size).get<int>("A");
+    for (const int i : values.index_range()) {
+      values[i] = size * 100 + i;
+    }
+  }
+  EXPECT_EQ(container.active_blocks().size(), 6);
+
+  container.compact();
+  EXPECT_EQ(container.size(), 27);
+  EXPECT_EQ(container.active_blocks().size(), 3);
+
+  Vector<int> values;
+  for (AttributesBlock *block : container.active_blocks()) {
+    values.extend(block->attributes().get<int>("A"));
+  }
+  std::sort(values.begin(), values.end());
+  Vector<int> expected_values;
+  for (const int size : {2, 9, 10, 5, 1}) {
+    for (const int i : IndexRange(size)) {
+      expected_values.append(size * 100 + i);
+    }
+  }
+  std::sort(expected_values.begin(), expected_values.end());
+  EXPECT_EQ(values.size(), expected_values.size());
+  for (const int i : values.index_range()) {
+    EXPECT_EQ(values[i], expected_values[i]);
+  }
+}
+
+TEST(attributes_block_container, ForeachBlock)
+{
+  AttributesInfoBuilder info_builder;
+  info_builder.add<int>("A", 1);
+  AttributesInfo info{info_builder};
+
+  AttributesBlockContainer container{info, 100};
+  for (int i = 0; i < 20; i++) {
+    container.add_default(50 + i);
+  }
+
+  /* Remove the odd elements in every block in parallel. */
+  container.foreach_block([](AttributesBlock &block) {
+    Vector<int64_t> indices;
+    for (const int64_t i : block.used_range()) {
+      if (i % 2 == 1) {
+        indices.append(i);
+      }
+    }
+    block.remove(indices.as_span());
+  });
+
+  int64_t expected_size = 0;
+  for (int i = 0; i < 20; i++) {
+    expected_size += (50 + i + 1) / 2;
+  }
+  EXPECT_EQ(container.size(), expected_size);
+}
+
+}  // namespace blender::fn::tests
@@ -94,4 +94,28 @@ TEST(mutable_attributes_ref, ComplexTest)
   EXPECT_EQ(ids[2], 100);
 }
 
+TEST(mutable_attributes_ref, AttributeIndex)
+{
+  AttributesInfoBuilder info_builder;
+  info_builder.add<float>("Size", 0.5f);
+  info_builder.add<int>("ID", 0);
+  AttributesInfo info{info_builder};
+
+  const AttributeIndex<int> id_index{info, "ID"};
+  const AttributeIndex<float> wrong_type_index{info, "ID"};
+  const AttributeIndex<int> missing_index{info, "Missing"};
+  EXPECT_TRUE(id_index);
+  EXPECT_FALSE(wrong_type_index);
+  EXPECT_FALSE(missing_index);
+  EXPECT_EQ(id_index.index(), 1);
+
+  Array<float> sizes(4, 0.0f);
+  Array<int> ids(4, 0);
+  Array<void *> buffers = {sizes.data(), ids.data()};
+  MutableAttributesRef attributes{info, buffers, IndexRange(1, 3)};
+  attributes.get(id_index)[0] = 5;
+  EXPECT_EQ(ids[1], 5);
+  EXPECT_EQ(AttributesRef(attributes).get(id_index)[0], 5);
+}
+
 }  // namespace blender::fn::tests
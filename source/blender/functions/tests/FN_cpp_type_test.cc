@@ -313,6 +313,36 @@ TEST(cpp_type, FillUninitialized)
   EXPECT_EQ(buffer2[9], 0);
 }
 
+TEST(cpp_type, TrivialType)
+{
+  const CPPType &type = CPPType::get<int32_t>();
+  EXPECT_TRUE(type.is_trivially_copyable());
+  EXPECT_FALSE(CPPType_TestType.is_trivially_copyable());
+
+  int src[6] = {1, 2, 3, 4, 5, 6};
+  int dst[6] = {0};
+  type.copy_to_uninitialized_n(src, dst, 2);
+  EXPECT_EQ(dst[0], 1);
+  EXPECT_EQ(dst[1], 2);
+  EXPECT_EQ(dst[2], 0);
+
+  /* Masks that are ranges are copied contiguously, all others per index. */
+  type.copy_to_initialized_indices(src, dst, IndexRange(3, 2));
+  type.relocate_to_uninitialized_indices(src, dst, {0, 2});
+  EXPECT_EQ(dst[0], 1);
+  EXPECT_EQ(dst[1], 2);
+  EXPECT_EQ(dst[2], 3);
+  EXPECT_EQ(dst[3], 4);
+  EXPECT_EQ(dst[4], 5);
+  EXPECT_EQ(dst[5], 0);
+
+  const int value = 9;
+  type.fill_initialized_indices(&value, dst, IndexRange(4, 2));
+  EXPECT_EQ(dst[3], 4);
+  EXPECT_EQ(dst[4], 9);
+  EXPECT_EQ(dst[5], 9);
+}
+
 TEST(cpp_type, DebugPrint)
 {
   int value = 42;
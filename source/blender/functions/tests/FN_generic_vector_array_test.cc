@@ -98,4 +98,24 @@ TEST(generic_vector_array, Extend)
   EXPECT_EQ(ref[0][0], 3);
 }
 
+TEST(generic_vector_array, ExtendGeneric)
+{
+  GVectorArray vectors{CPPType::get<int32_t>(), 2};
+  std::array<int, 3> values = {2, 4, 6};
+  vectors.append(0, &values[0]);
+  vectors.extend(0, GVSpan(Span<int>(values)));
+  int value = 8;
+  vectors.extend(1, GVSpan::FromSingle(CPPType::get<int32_t>(), &value, 2));
+  vectors.extend(1, GVSpan(CPPType::get<int32_t>()));
+
+  GVectorArrayRef<int> ref = vectors;
+  EXPECT_EQ(vectors[0].size(), 4);
+  EXPECT_EQ(ref[0][0], 2);
+  EXPECT_EQ(ref[0][1], 2);
+  EXPECT_EQ(ref[0][3], 6);
+  EXPECT_EQ(vectors[1].size(), 2);
+  EXPECT_EQ(ref[1][0], 8);
+  EXPECT_EQ(ref[1][1], 8);
+}
+
 }  // namespace blender::fn::tests
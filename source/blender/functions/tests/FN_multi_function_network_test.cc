@@ -5,6 +5,7 @@
 #include "FN_multi_function_builder.hh"
 #include "FN_multi_function_network.hh"
 #include "FN_multi_function_network_evaluation.hh"
+#include "FN_multi_function_network_optimization.hh"
 
 namespace blender::fn::tests {
 namespace {
@@ -65,6 +66,289 @@ TEST(multi_function_network, Test1)
   }
 }
 
+TEST(multi_function_network, LargeRange)
+{
+  CustomMF_SI_SI_SO<int, int, int> add_fn("add", [](int a, int b) { return a + b; });
+  CustomMF_SI_SO<int, int> square_fn("square", [](int value) { return value * value; });
+
+  MFNetwork network;
+
+  MFNode &node1 = network.add_function(add_fn);
+  MFNode &node2 = network.add_function(square_fn);
+  MFOutputSocket &input1 = network.add_input("Input 1", MFDataType::ForSingle<int>());
+  MFOutputSocket &input2 = network.add_input("Input 2", MFDataType::ForSingle<int>());
+  MFInputSocket &output1 = network.add_output("Output 1", MFDataType::ForSingle<int>());
+  MFInputSocket &output2 = network.add_output("Output 2", MFDataType::ForSingle<int>());
+  network.add_link(input1, node1.input(0));
+  network.add_link(input2, node1.input(1));
+  network.add_link(node1.output(0), node2.input(0));
+  network.add_link(node1.output(0), output1);
+  network.add_link(node2.output(0), output2);
+
+  MFNetworkEvaluator network_fn{{&input1, &input2}, {&output1, &output2}};
+
+  /* Large enough to be split into multiple chunks, including a partial one at the end. */
+  const int size = 30011;
+  const IndexRange range(7, size - 10);
+  Array<int> values(size);
+  for (const int i : values.index_range()) {
+    values[i] = i % 1000;
+  }
+  const int offset = 3;
+  Array<int> results1(size, -1);
+  Array<int> results2(size, -1);
+
+  MFParamsBuilder params(network_fn, size);
+  params.add_readonly_single_input(values.as_span());
+  params.add_readonly_single_input(&offset);
+  params.add_uninitialized_single_output(results1.as_mutable_span());
+  params.add_uninitialized_single_output(results2.as_mutable_span());
+
+  MFContextBuilder context;
+
+  network_fn.call(range, params, context);
+
+  for (const int i : values.index_range()) {
+    if (range.contains(i)) {
+      const int expected = values[i] + offset;
+      EXPECT_EQ(results1[i], expected);
+      EXPECT_EQ(results2[i], expected * expected);
+    }
+    else {
+      EXPECT_EQ(results1[i], -1);
+      EXPECT_EQ(results2[i], -1);
+    }
+  }
+}
+
+TEST(multi_function_network, ElementWiseFusion)
+{
+  CustomMF_SI_SI_SO<float, float, float> add_fn("add", [](float a, float b) { return a + b; });
+  CustomMF_SI_SI_SO<float, float, float> multiply_fn("multiply",
+                                                     [](float a, float b) { return a * b; });
+  CustomMF_Convert<float, int> convert_fn;
+
+  MFNetwork network;
+
+  /* ((a + b) * a) is used by two nodes, so the addition and multiplication are fused into one
+   * function. The two final nodes only share their origin, so they remain separate. */
+  MFNode &node1 = network.add_function(add_fn);
+  MFNode &node2 = network.add_function(multiply_fn);
+  MFNode &node3 = network.add_function(convert_fn);
+  MFNode &node4 = network.add_function(add_fn);
+  MFOutputSocket &input1 = network.add_input("Input 1", MFDataType::ForSingle<float>());
+  MFOutputSocket &input2 = network.add_input("Input 2", MFDataType::ForSingle<float>());
+  MFInputSocket &output1 = network.add_output("Output 1", MFDataType::ForSingle<int>());
+  MFInputSocket &output2 = network.add_output("Output 2", MFDataType::ForSingle<float>());
+  network.add_link(input1, node1.input(0));
+  network.add_link(input2, node1.input(1));
+  network.add_link(node1.output(0), node2.input(0));
+  network.add_link(input1, node2.input(1));
+  network.add_link(node2.output(0), node3.input(0));
+  network.add_link(node2.output(0), node4.input(0));
+  network.add_link(input2, node4.input(1));
+  network.add_link(node3.output(0), output1);
+  network.add_link(node4.output(0), output2);
+
+  ResourceCollector resources;
+  mf_network_optimization::element_wise_fusion(network, resources);
+  EXPECT_EQ(network.function_nodes().size(), 3);
+
+  MFNetworkEvaluator network_fn{{&input1, &input2}, {&output1, &output2}};
+
+  const int size = 1000;
+  Array<float> values1(size);
+  Array<float> values2(size);
+  for (const int i : IndexRange(size)) {
+    values1[i] = i * 0.5f;
+    values2[i] = i % 7;
+  }
+
+  auto check_results = [&](IndexMask mask) {
+    Array<int> results1(size, -1);
+    Array<float> results2(size, -1.0f);
+
+    MFParamsBuilder params(network_fn, size);
+    params.add_readonly_single_input(values1.as_span());
+    params.add_readonly_single_input(values2.as_span());
+    params.add_uninitialized_single_output(results1.as_mutable_span());
+    params.add_uninitialized_single_output(results2.as_mutable_span());
+
+    MFContextBuilder context;
+    network_fn.call(mask, params, context);
+
+    for (const int64_t i : mask) {
+      const float value = (values1[i] + values2[i]) * values1[i];
+      EXPECT_EQ(results1[i], static_cast<int>(value));
+      EXPECT_FLOAT_EQ(results2[i], value + values2[i]);
+    }
+    EXPECT_EQ(results1[0], -1);
+    EXPECT_EQ(results2[0], -1.0f);
+  };
+
+  check_results(IndexRange(1, size - 1));
+
+  Vector<int64_t> indices;
+  for (int64_t i = 1; i < size; i += 3) {
+    indices.append(i);
+  }
+  check_results(indices.as_span());
+}
+
+class CountingAddFunction : public MultiFunction {
+ public:
+  mutable int evaluated_elements = 0;
+
+  CountingAddFunction()
+  {
+    MFSignatureBuilder signature = this->get_builder("Counting Add");
+    signature.single_input<int>("A");
+    signature.single_input<int>("B");
+    signature.single_output<int>("Result");
+  }
+
+  void call(IndexMask mask, MFParams params, MFContext UNUSED(context)) const override
+  {
+    VSpan<int> a = params.readonly_single_input<int>(0, "A");
+    VSpan<int> b = params.readonly_single_input<int>(1, "B");
+    MutableSpan<int> result = params.uninitialized_single_output<int>(2, "Result");
+
+    for (int64_t i : mask) {
+      result[i] = a[i] + b[i];
+    }
+    evaluated_elements += mask.size();
+  }
+};
+
+TEST(multi_function_network, SingleValueBroadcast)
+{
+  CountingAddFunction add_fn;
+
+  MFNetwork network;
+
+  MFNode &node1 = network.add_function(add_fn);
+  MFNode &node2 = network.add_function(add_fn);
+  MFOutputSocket &input1 = network.add_input("Input 1", MFDataType::ForSingle<int>());
+  MFOutputSocket &input2 = network.add_input("Input 2", MFDataType::ForSingle<int>());
+  MFInputSocket &output1 = network.add_output("Output 1", MFDataType::ForSingle<int>());
+  MFInputSocket &output2 = network.add_output("Output 2", MFDataType::ForSingle<int>());
+  network.add_link(input1, node1.input(0));
+  network.add_link(input1, node1.input(1));
+  network.add_link(node1.output(0), node2.input(0));
+  network.add_link(input2, node2.input(1));
+  network.add_link(node1.output(0), output1);
+  network.add_link(node2.output(0), output2);
+
+  MFNetworkEvaluator network_fn{{&input1, &input2}, {&output1, &output2}};
+
+  const int value = 4;
+  Array<int> values2 = {1, 2, 3, 4, 5};
+  {
+    /* All inputs are single values, every function is evaluated once. */
+    Array<int> results1(5, -1);
+    Array<int> results2(5, -1);
+    MFParamsBuilder params(network_fn, 5);
+    params.add_readonly_single_input(&value);
+    params.add_readonly_single_input(&value);
+    params.add_uninitialized_single_output(results1.as_mutable_span());
+    params.add_uninitialized_single_output(results2.as_mutable_span());
+
+    MFContextBuilder context;
+    network_fn.call({0, 2, 3}, params, context);
+
+    EXPECT_EQ(add_fn.evaluated_elements, 2);
+    EXPECT_EQ(results1[0], 8);
+    EXPECT_EQ(results1[1], -1);
+    EXPECT_EQ(results1[2], 8);
+    EXPECT_EQ(results1[3], 8);
+    EXPECT_EQ(results1[4], -1);
+    EXPECT_EQ(results2[0], 12);
+    EXPECT_EQ(results2[1], -1);
+    EXPECT_EQ(results2[2], 12);
+    EXPECT_EQ(results2[3], 12);
+    EXPECT_EQ(results2[4], -1);
+  }
+  add_fn.evaluated_elements = 0;
+  {
+    /* Only the second function depends on the varying input. */
+    Array<int> results1(5, -1);
+    Array<int> results2(5, -1);
+    MFParamsBuilder params(network_fn, 5);
+    params.add_readonly_single_input(&value);
+    params.add_readonly_single_input(values2.as_span());
+    params.add_uninitialized_single_output(results1.as_mutable_span());
+    params.add_uninitialized_single_output(results2.as_mutable_span());
+
+    MFContextBuilder context;
+    network_fn.call({0, 2, 3}, params, context);
+
+    EXPECT_EQ(add_fn.evaluated_elements, 4);
+    EXPECT_EQ(results1[0], 8);
+    EXPECT_EQ(results1[1], -1);
+    EXPECT_EQ(results1[2], 8);
+    EXPECT_EQ(results1[3], 8);
+    EXPECT_EQ(results1[4], -1);
+    EXPECT_EQ(results2[0], 9);
+    EXPECT_EQ(results2[1], -1);
+    EXPECT_EQ(results2[2], 11);
+    EXPECT_EQ(results2[3], 12);
+    EXPECT_EQ(results2[4], -1);
+  }
+}
+
+TEST(multi_function_network, LazySwitch)
+{
+  CountingAddFunction false_fn;
+  CountingAddFunction true_fn1;
+  CountingAddFunction true_fn2;
+  CustomMF_GenericSwitch switch_fn{CPPType::get<int>()};
+
+  MFNetwork network;
+
+  MFNode &false_node = network.add_function(false_fn);
+  MFNode &true_node1 = network.add_function(true_fn1);
+  MFNode &true_node2 = network.add_function(true_fn2);
+  MFNode &switch_node = network.add_function(switch_fn);
+  MFOutputSocket &condition_input = network.add_input("Condition", MFDataType::ForSingle<bool>());
+  MFOutputSocket &value_input = network.add_input("Value", MFDataType::ForSingle<int>());
+  MFInputSocket &output = network.add_output("Result", MFDataType::ForSingle<int>());
+  network.add_link(value_input, false_node.input(0));
+  network.add_link(value_input, false_node.input(1));
+  network.add_link(value_input, true_node1.input(0));
+  network.add_link(value_input, true_node1.input(1));
+  network.add_link(true_node1.output(0), true_node2.input(0));
+  network.add_link(value_input, true_node2.input(1));
+  network.add_link(condition_input, switch_node.input(0));
+  network.add_link(false_node.output(0), switch_node.input(1));
+  network.add_link(true_node2.output(0), switch_node.input(2));
+  network.add_link(switch_node.output(0), output);
+
+  MFNetworkEvaluator network_fn{{&condition_input, &value_input}, {&output}};
+
+  Array<bool> conditions = {true, false, true, true, false, false};
+  Array<int> values = {1, 2, 3, 4, 5, 6};
+  Array<int> results(6, -1);
+
+  MFParamsBuilder params(network_fn, 6);
+  params.add_readonly_single_input(conditions.as_span());
+  params.add_readonly_single_input(values.as_span());
+  params.add_uninitialized_single_output(results.as_mutable_span());
+
+  MFContextBuilder context;
+  network_fn.call({0, 1, 2, 4, 5}, params, context);
+
+  /* Every branch is only evaluated on the indices that select it. */
+  EXPECT_EQ(false_fn.evaluated_elements, 3);
+  EXPECT_EQ(true_fn1.evaluated_elements, 2);
+  EXPECT_EQ(true_fn2.evaluated_elements, 2);
+  EXPECT_EQ(results[0], 3);
+  EXPECT_EQ(results[1], 4);
+  EXPECT_EQ(results[2], 9);
+  EXPECT_EQ(results[3], -1);
+  EXPECT_EQ(results[4], 10);
+  EXPECT_EQ(results[5], 12);
+}
+
 class ConcatVectorsFunction : public MultiFunction {
  public:
   ConcatVectorsFunction()
@@ -0,0 +1,131 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_rand.hh"
+#include "BLI_timeit.hh"
+
+#include "FN_generic_vector_array.hh"
+#include "FN_multi_function_builder.hh"
+#include "FN_multi_function_network.hh"
+#include "FN_multi_function_network_evaluation.hh"
+
+/* Number of times every benchmark is repeated, so that timings can be compared between runs. */
+#define NUM_RUNS 3
+
+namespace blender::fn::tests {
+
+static Array<float> get_random_floats(const int64_t amount)
+{
+  RandomNumberGenerator rng{0};
+  Array<float> values(amount);
+  for (float &value : values) {
+    value = rng.get_float();
+  }
+  return values;
+}
+
+/**
+ * Builds a network with #width parallel chains of #depth nodes each. The chains all start at the
+ * same input and are summed up at the end, so every node has to be evaluated.
+ */
+static void benchmark_network(const int width, const int depth, const int64_t size)
+{
+  static CustomMF_SI_SI_SO<float, float, float> mix_fn{
+      "mix", [](float a, float b) { return a * 0.5f + b * 0.25f; }};
+  static CustomMF_SI_SI_SO<float, float, float> add_fn{"add",
+                                                       [](float a, float b) { return a + b; }};
+
+  MFNetwork network;
+  MFOutputSocket &input = network.add_input("Input", MFDataType::ForSingle<float>());
+  MFInputSocket &output = network.add_output("Output", MFDataType::ForSingle<float>());
+
+  MFOutputSocket *sum = nullptr;
+  for (int i = 0; i < width; i++) {
+    MFOutputSocket *chain = &input;
+    for (int j = 0; j < depth; j++) {
+      MFNode &node = network.add_function(mix_fn);
+      network.add_link(*chain, node.input(0));
+      network.add_link(input, node.input(1));
+      chain = &node.output(0);
+    }
+    if (sum == nullptr) {
+      sum = chain;
+    }
+    else {
+      MFNode &node = network.add_function(add_fn);
+      network.add_link(*sum, node.input(0));
+      network.add_link(*chain, node.input(1));
+      sum = &node.output(0);
+    }
+  }
+  network.add_link(*sum, output);
+
+  MFNetworkEvaluator network_fn{{&input}, {&output}};
+
+  const Array<float> inputs = get_random_floats(size);
+  Array<float> results(size);
+
+  std::stringstream ss;
+  ss << "Network width " << width << " depth " << depth;
+  for (int run = 0; run < NUM_RUNS; run++) {
+    MFParamsBuilder params{network_fn, size};
+    params.add_readonly_single_input(inputs.as_span());
+    params.add_uninitialized_single_output(results.as_mutable_span());
+    MFContextBuilder context;
+
+    SCOPED_THROUGHPUT_TIMER(ss.str(), size);
+    network_fn.call(IndexRange(size), params, context);
+  }
+}
+
+TEST(functions_performance, NetworkDepth)
+{
+  for (const int depth : {1, 4, 16, 64}) {
+    benchmark_network(1, depth, 1000000);
+  }
+}
+
+TEST(functions_performance, NetworkWidth)
+{
+  for (const int width : {1, 4, 16, 64}) {
+    benchmark_network(width, 4, 1000000);
+  }
+}
+
+/* Many small evaluations, which is where the overhead of the evaluator itself shows up. */
+TEST(functions_performance, NetworkSmallMasks)
+{
+  benchmark_network(4, 4, 16);
+}
+
+TEST(functions_performance, GVectorArrayAppend)
+{
+  const int64_t array_size = 10000;
+  const int64_t elements_per_array = 100;
+  const int64_t total_elements = array_size * elements_per_array;
+  const Array<float> values = get_random_floats(elements_per_array);
+
+  for (int run = 0; run < NUM_RUNS; run++) {
+    {
+      GVectorArray vector_array{CPPType::get<float>(), array_size};
+      GVectorArrayRef<float> typed_array{vector_array};
+      SCOPED_THROUGHPUT_TIMER("GVectorArray append", total_elements);
+      for (const int64_t i : IndexRange(array_size)) {
+        for (const float value : values) {
+          typed_array.append(i, value);
+        }
+      }
+    }
+    {
+      GVectorArray vector_array{CPPType::get<float>(), array_size};
+      SCOPED_THROUGHPUT_TIMER("GVectorArray extend", total_elements);
+      for (const int64_t i : IndexRange(array_size)) {
+        vector_array.extend(i, GVSpan(values.as_span()));
+      }
+    }
+  }
+}
+
+}  // namespace blender::fn::tests
@@ -890,6 +890,7 @@ GPUPass *GPU_generate_pass(GPUMaterial *material,
     pass->geometrycode = geometrycode;
     pass->defines = (defines) ? BLI_strdup(defines) : NULL;
     pass->compiled = false;
+    BLI_mutex_init(&pass->compile_lock);
 
     BLI_spin_lock(&pass_cache_spin);
     if (pass_hash != NULL) {
@@ -994,6 +995,7 @@ static bool gpu_pass_shader_validate(GPUPass *pass, GPUShader *shader)
 bool GPU_pass_compile(GPUPass *pass, const char *shname)
 {
   bool success = true;
+  BLI_mutex_lock(&pass->compile_lock);
   if (!pass->compiled) {
     GPUShader *shader = GPU_shader_create(
         pass->vertexcode, pass->fragmentcode, pass->geometrycode, NULL, pass->defines, shname);
@@ -1011,6 +1013,7 @@ bool GPU_pass_compile(GPUPass *pass, const char *shname)
     pass->shader = shader;
     pass->compiled = true;
   }
+  BLI_mutex_unlock(&pass->compile_lock);
 
   return success;
 }
@@ -1027,6 +1030,7 @@ static void gpu_pass_free(GPUPass *pass)
   if (pass->shader) {
     GPU_shader_free(pass->shader);
   }
+  BLI_mutex_end(&pass->compile_lock);
   MEM_SAFE_FREE(pass->fragmentcode);
   MEM_SAFE_FREE(pass->geometrycode);
   MEM_SAFE_FREE(pass->vertexcode);
@@ -212,6 +212,7 @@ static void detect_workarounds()
     /* Turn off extensions. */
     GCaps.shader_image_load_store_support = false;
     GLContext::base_instance_support = false;
+    GLContext::buffer_storage_support = false;
     GLContext::clear_texture_support = false;
     GLContext::copy_image_support = false;
     GLContext::debug_layer_support = false;
@@ -219,6 +220,7 @@ static void detect_workarounds()
     GLContext::fixed_restart_index_support = false;
     GLContext::multi_bind_support = false;
     GLContext::multi_draw_indirect_support = false;
+    GLContext::program_binary_support = false;
     GLContext::shader_draw_parameters_support = false;
     GLContext::texture_cube_map_array_support = false;
     GLContext::texture_filter_anisotropic_support = false;
@@ -359,6 +361,7 @@ GLint GLContext::max_ubo_binds = 0;
 GLint GLContext::max_ubo_size = 0;
 /** Extensions. */
 bool GLContext::base_instance_support = false;
+bool GLContext::buffer_storage_support = false;
 bool GLContext::clear_texture_support = false;
 bool GLContext::copy_image_support = false;
 bool GLContext::debug_layer_support = false;
@@ -366,6 +369,7 @@ bool GLContext::direct_state_access_support = false;
 bool GLContext::fixed_restart_index_support = false;
 bool GLContext::multi_bind_support = false;
 bool GLContext::multi_draw_indirect_support = false;
+bool GLContext::program_binary_support = false;
 bool GLContext::shader_draw_parameters_support = false;
 bool GLContext::texture_cube_map_array_support = false;
 bool GLContext::texture_filter_anisotropic_support = false;
@@ -394,6 +398,7 @@ void GLBackend::capabilities_init()
   glGetIntegerv(GL_MAX_FRAGMENT_UNIFORM_BLOCKS, &GLContext::max_ubo_binds);
   glGetIntegerv(GL_MAX_UNIFORM_BLOCK_SIZE, &GLContext::max_ubo_size);
   GLContext::base_instance_support = GLEW_ARB_base_instance;
+  GLContext::buffer_storage_support = GLEW_ARB_buffer_storage;
   GLContext::clear_texture_support = GLEW_ARB_clear_texture;
   GLContext::copy_image_support = GLEW_ARB_copy_image;
   GLContext::debug_layer_support = GLEW_VERSION_4_3 || GLEW_KHR_debug || GLEW_ARB_debug_output;
@@ -401,6 +406,12 @@ void GLBackend::capabilities_init()
   GLContext::fixed_restart_index_support = GLEW_ARB_ES3_compatibility;
   GLContext::multi_bind_support = GLEW_ARB_multi_bind;
   GLContext::multi_draw_indirect_support = GLEW_ARB_multi_draw_indirect;
+  if (GLEW_ARB_get_program_binary) {
+    /* Some drivers expose the extension without supporting any binary format. */
+    GLint formats_len = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats_len);
+    GLContext::program_binary_support = formats_len > 0;
+  }
   GLContext::shader_draw_parameters_support = GLEW_ARB_shader_draw_parameters;
   GLContext::texture_cube_map_array_support = GLEW_ARB_texture_cube_map_array;
   GLContext::texture_filter_anisotropic_support = GLEW_EXT_texture_filter_anisotropic;
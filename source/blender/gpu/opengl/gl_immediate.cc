@@ -25,6 +25,8 @@
 
 #include "BKE_global.h"
 
+#include "BLI_math_base.h"
+
 #include "gpu_context_private.hh"
 #include "gpu_shader_private.hh"
 #include "gpu_vertex_format_private.h"
@@ -48,29 +50,61 @@ GLImmediate::GLImmediate()
   glBindVertexArray(vao_id_); /* Necessary for glObjectLabel. */
 
   buffer.buffer_size = DEFAULT_INTERNAL_BUFFER_SIZE;
-  glGenBuffers(1, &buffer.vbo_id);
-  glBindBuffer(GL_ARRAY_BUFFER, buffer.vbo_id);
-  glBufferData(GL_ARRAY_BUFFER, buffer.buffer_size, nullptr, GL_DYNAMIC_DRAW);
+  buffer_create(buffer, "ImmediateVbo");
 
   buffer_strict.buffer_size = DEFAULT_INTERNAL_BUFFER_SIZE;
-  glGenBuffers(1, &buffer_strict.vbo_id);
-  glBindBuffer(GL_ARRAY_BUFFER, buffer_strict.vbo_id);
-  glBufferData(GL_ARRAY_BUFFER, buffer_strict.buffer_size, nullptr, GL_DYNAMIC_DRAW);
+  buffer_create(buffer_strict, "ImmediateVboStrict");
 
   glBindBuffer(GL_ARRAY_BUFFER, 0);
   glBindVertexArray(0);
 
   debug::object_label(GL_VERTEX_ARRAY, vao_id_, "Immediate");
-  debug::object_label(GL_BUFFER, buffer.vbo_id, "ImmediateVbo");
-  debug::object_label(GL_BUFFER, buffer_strict.vbo_id, "ImmediateVboStrict");
 }
 
 GLImmediate::~GLImmediate()
 {
   glDeleteVertexArrays(1, &vao_id_);
 
-  glDeleteBuffers(1, &buffer.vbo_id);
-  glDeleteBuffers(1, &buffer_strict.vbo_id);
+  buffer_free(buffer);
+  buffer_free(buffer_strict);
+}
+
+/* Leaves the buffer bound to GL_ARRAY_BUFFER. */
+void GLImmediate::buffer_create(ImmBuffer &buf, const char *name)
+{
+  glGenBuffers(1, &buf.vbo_id);
+  glBindBuffer(GL_ARRAY_BUFFER, buf.vbo_id);
+
+  if (GLContext::buffer_storage_support) {
+    /* Immutable storage that stays mapped for the lifetime of the buffer. Instead of orphaning,
+     * the buffer is used as a ring whose segments are guarded by fences. */
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT;
+    glBufferStorage(GL_ARRAY_BUFFER, buf.buffer_size, nullptr, flags);
+    buf.data_mapped = (uchar *)glMapBufferRange(
+        GL_ARRAY_BUFFER, 0, buf.buffer_size, flags | GL_MAP_FLUSH_EXPLICIT_BIT);
+    BLI_assert(buf.data_mapped != nullptr);
+  }
+  else {
+    glBufferData(GL_ARRAY_BUFFER, buf.buffer_size, nullptr, GL_DYNAMIC_DRAW);
+  }
+  buf.buffer_offset = 0;
+  buf.segment = 0;
+
+  debug::object_label(GL_BUFFER, buf.vbo_id, name);
+}
+
+void GLImmediate::buffer_free(ImmBuffer &buf)
+{
+  for (GLsync &fence : buf.segment_fences) {
+    if (fence != nullptr) {
+      glDeleteSync(fence);
+      fence = nullptr;
+    }
+  }
+  /* Deleting the buffer also unmaps it. */
+  glDeleteBuffers(1, &buf.vbo_id);
+  buf.vbo_id = 0;
+  buf.data_mapped = nullptr;
 }
 
 /** \} */
@@ -79,6 +113,43 @@ GLImmediate::~GLImmediate()
 /** \name Buffer management
  * \{ */
 
+/* Move the write position of a persistently mapped buffer to the next segment of the ring.
+ * Waits for the GPU if the draws using this segment, one lap ago, are still pending. */
+static void ring_segment_step(GLsync *segment_fences, int &segment)
+{
+  /* Protect the segment being left until the GPU is done with its draws. */
+  segment_fences[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  segment = (segment + 1) % IMM_RING_SEGMENT_LEN;
+
+  GLsync &fence = segment_fences[segment];
+  if (fence != nullptr) {
+    while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) ==
+           GL_TIMEOUT_EXPIRED) {
+      /* Keep waiting. */
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+  }
+}
+
+/* Make sure the GPU is not reading the range that is about to be written. */
+void GLImmediate::ring_segments_acquire(ImmBuffer &buf, size_t offset, size_t len)
+{
+  const size_t segment_size = (buf.buffer_size + IMM_RING_SEGMENT_LEN - 1) / IMM_RING_SEGMENT_LEN;
+  const int segment_last = (offset + max_zz(len, 1) - 1) / segment_size;
+
+  if (offset < buf.buffer_offset) {
+    /* Wrapped around: step through the end of the ring into the first segment. */
+    while (buf.segment != IMM_RING_SEGMENT_LEN - 1) {
+      ring_segment_step(buf.segment_fences, buf.segment);
+    }
+    ring_segment_step(buf.segment_fences, buf.segment);
+  }
+  while (buf.segment != segment_last) {
+    ring_segment_step(buf.segment_fences, buf.segment);
+  }
+}
+
 uchar *GLImmediate::begin()
 {
   /* How many bytes do we need for this draw call? */
@@ -107,23 +178,43 @@ uchar *GLImmediate::begin()
   /* Might waste a little space, but it's safe. */
   const uint pre_padding = padding(buffer_offset(), vertex_format.stride);
 
+  ImmBuffer &buf = active_buffer();
+  size_t offset = 0;
   if (!recreate_buffer && ((bytes_needed + pre_padding) <= available_bytes)) {
-    buffer_offset() += pre_padding;
+    offset = buffer_offset() + pre_padding;
   }
-  else {
+  else if (buf.data_mapped == nullptr) {
     /* orphan this buffer & start with a fresh one */
     glBufferData(GL_ARRAY_BUFFER, buffer_size(), nullptr, GL_DYNAMIC_DRAW);
     buffer_offset() = 0;
   }
+  else if (recreate_buffer) {
+    /* Immutable storage cannot be re-specified, replace the whole buffer instead.
+     * The old one is kept alive by the driver until the GPU is done with it. */
+    const size_t new_size = buffer_size();
+    buffer_free(buf);
+    buf.buffer_size = new_size;
+    buffer_create(buf, strict_vertex_len ? "ImmediateVboStrict" : "ImmediateVbo");
+  }
 
 #ifndef NDEBUG
   {
     GLint bufsize;
     glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &bufsize);
-    BLI_assert(buffer_offset() + bytes_needed <= bufsize);
+    BLI_assert(offset + bytes_needed <= bufsize);
   }
 #endif
 
+  bytes_mapped_ = bytes_needed;
+
+  if (buf.data_mapped != nullptr) {
+    ring_segments_acquire(buf, offset, bytes_needed);
+    buffer_offset() = offset;
+    return buf.data_mapped + offset;
+  }
+
+  buffer_offset() = offset;
+
   GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
   if (!strict_vertex_len) {
     access |= GL_MAP_FLUSH_EXPLICIT_BIT;
@@ -131,7 +222,6 @@ uchar *GLImmediate::begin()
   void *data = glMapBufferRange(GL_ARRAY_BUFFER, buffer_offset(), bytes_needed, access);
   BLI_assert(data != nullptr);
 
-  bytes_mapped_ = bytes_needed;
   return (uchar *)data;
 }
 
@@ -146,10 +236,18 @@ void GLImmediate::end()
       buffer_bytes_used = vertex_buffer_size(&vertex_format, vertex_len);
       /* unused buffer bytes are available to the next immBegin */
     }
-    /* tell OpenGL what range was modified so it doesn't copy the whole mapped range */
-    glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, buffer_bytes_used);
   }
-  glUnmapBuffer(GL_ARRAY_BUFFER);
+  if (active_buffer().data_mapped != nullptr) {
+    /* The whole buffer is mapped, flush the range written by this draw. */
+    glFlushMappedBufferRange(GL_ARRAY_BUFFER, buffer_offset(), buffer_bytes_used);
+  }
+  else {
+    if (!strict_vertex_len) {
+      /* tell OpenGL what range was modified so it doesn't copy the whole mapped range */
+      glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, buffer_bytes_used);
+    }
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+  }
 
   if (vertex_len > 0) {
     GLContext::get()->state_manager->apply_state();
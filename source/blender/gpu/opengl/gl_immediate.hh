@@ -35,19 +35,27 @@ namespace blender::gpu {
 
 /* size of internal buffer */
 #define DEFAULT_INTERNAL_BUFFER_SIZE (4 * 1024 * 1024)
+/* Number of fenced segments of a persistently mapped buffer. */
+#define IMM_RING_SEGMENT_LEN 4
 
 class GLImmediate : public Immediate {
  private:
   /* Use two buffers for strict and unstrict vertex count to
    * avoid some huge driver slowdown (see T70922).
    * Use accessor functions to get / modify. */
-  struct {
+  struct ImmBuffer {
     /** Opengl Handle for this buffer. */
     GLuint vbo_id = 0;
     /** Offset of the mapped data in data. */
     size_t buffer_offset = 0;
     /** Size of the whole buffer in bytes. */
     size_t buffer_size = 0;
+    /** Persistent mapping of the whole buffer. Only used if #GLContext::buffer_storage_support. */
+    uchar *data_mapped = nullptr;
+    /** Segment of the ring the last vertices were written to. */
+    int segment = 0;
+    /** Fences signaled when the GPU is done reading each segment. */
+    GLsync segment_fences[IMM_RING_SEGMENT_LEN] = {nullptr};
   } buffer, buffer_strict;
   /** Size in bytes of the mapped region. */
   size_t bytes_mapped_ = 0;
@@ -62,6 +70,15 @@ class GLImmediate : public Immediate {
   void end(void) override;
 
  private:
+  static void buffer_create(ImmBuffer &buf, const char *name);
+  static void buffer_free(ImmBuffer &buf);
+  static void ring_segments_acquire(ImmBuffer &buf, size_t offset, size_t len);
+
+  ImmBuffer &active_buffer(void)
+  {
+    return strict_vertex_len ? buffer_strict : buffer;
+  };
+
   GLuint &vbo_id(void)
   {
     return strict_vertex_len ? buffer_strict.vbo_id : buffer.vbo_id;
@@ -21,11 +21,15 @@
  * \ingroup gpu
  */
 
-#include "BKE_global.h"
-
+#include "BLI_fileops.h"
+#include "BLI_hash_md5.h"
+#include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_vector.hh"
 
+#include "BKE_appdir.h"
+#include "BKE_global.h"
+
 #include "GPU_platform.h"
 
 #include "gl_backend.hh"
@@ -111,8 +115,20 @@ char *GLShader::glsl_patch_get()
   return patch;
 }
 
+/* Join the sources of a stage, patching the shader code using the first source slot. */
+std::string GLShader::shader_stage_source(MutableSpan<const char *> sources)
+{
+  sources[0] = glsl_patch_get();
+
+  std::string source;
+  for (const char *str : sources) {
+    source += str;
+  }
+  return source;
+}
+
 /* Create, compile and attach the shader stage to the shader program. */
-GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources)
+GLuint GLShader::create_shader_stage(GLenum gl_stage, const std::string &source)
 {
   GLuint shader = glCreateShader(gl_stage);
   if (shader == 0) {
@@ -120,10 +136,10 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *>
     return 0;
   }
 
-  /* Patch the shader code using the first source slot. */
-  sources[0] = glsl_patch_get();
+  const char *source_str = source.c_str();
+  Span<const char *> sources(&source_str, 1);
 
-  glShaderSource(shader, sources.size(), sources.data(), nullptr);
+  glShaderSource(shader, 1, &source_str, nullptr);
   glCompileShader(shader);
 
   GLint status;
@@ -159,35 +175,65 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *>
 
 void GLShader::vertex_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  vert_shader_ = this->create_shader_stage(GL_VERTEX_SHADER, sources);
+  vert_source_ = this->shader_stage_source(sources);
 }
 
 void GLShader::geometry_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  geom_shader_ = this->create_shader_stage(GL_GEOMETRY_SHADER, sources);
+  geom_source_ = this->shader_stage_source(sources);
 }
 
 void GLShader::fragment_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  frag_shader_ = this->create_shader_stage(GL_FRAGMENT_SHADER, sources);
+  frag_source_ = this->shader_stage_source(sources);
 }
 
 bool GLShader::finalize()
 {
-  if (compilation_failed_) {
-    return false;
+  const bool use_binary_cache = this->program_binary_cache_use();
+  char cache_filepath[FILE_MAX];
+  bool is_cached = false;
+  if (use_binary_cache) {
+    this->program_binary_cache_filepath(cache_filepath);
+    is_cached = this->program_binary_cache_load(cache_filepath);
   }
 
-  glLinkProgram(shader_program_);
+  if (!is_cached) {
+    if (use_binary_cache) {
+      glProgramParameteri(shader_program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    vert_shader_ = this->create_shader_stage(GL_VERTEX_SHADER, vert_source_);
+    if (!geom_source_.empty()) {
+      geom_shader_ = this->create_shader_stage(GL_GEOMETRY_SHADER, geom_source_);
+    }
+    frag_shader_ = this->create_shader_stage(GL_FRAGMENT_SHADER, frag_source_);
+  }
 
-  GLint status;
-  glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
-  if (!status) {
-    char log[5000];
-    glGetProgramInfoLog(shader_program_, sizeof(log), nullptr, log);
-    Span<const char *> sources;
-    this->print_log(sources, log, "Linking", true);
-    return false;
+  /* Sources are not needed anymore, some of them are fairly big (materials). */
+  for (std::string *source : {&vert_source_, &geom_source_, &frag_source_}) {
+    std::string().swap(*source);
+  }
+
+  if (!is_cached) {
+    if (compilation_failed_) {
+      return false;
+    }
+
+    glLinkProgram(shader_program_);
+
+    GLint status;
+    glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
+    if (!status) {
+      char log[5000];
+      glGetProgramInfoLog(shader_program_, sizeof(log), nullptr, log);
+      Span<const char *> sources;
+      this->print_log(sources, log, "Linking", true);
+      return false;
+    }
+
+    if (use_binary_cache) {
+      this->program_binary_cache_save(cache_filepath);
+    }
   }
 
   interface = new GLShaderInterface(shader_program_);
@@ -197,6 +243,118 @@ bool GLShader::finalize()
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Program binary cache
+ *
+ * Linked programs are stored on disk so that later sessions can skip compiling the
+ * shaders (EEVEE materials in particular take long to compile).
+ * Files are named after a hash of the sources and of the driver identification,
+ * binaries are only valid for the driver which created them.
+ * \{ */
+
+#define PROGRAM_BINARY_CACHE_DIRNAME "blender_shader_cache"
+
+typedef struct GLProgramBinaryHeader {
+  char magic[4];
+  GLenum format;
+  GLint length;
+} GLProgramBinaryHeader;
+
+static const char program_binary_magic[4] = {'B', 'G', 'L', 'P'};
+
+bool GLShader::program_binary_cache_use() const
+{
+  /* Compilation logs are only printed when shaders are actually compiled.
+   * Transform feedback shaders are few and cheap to compile, keep them out of the cache. */
+  return GLContext::program_binary_support && (G.debug & G_DEBUG_GPU) == 0 &&
+         transform_feedback_type_ == GPU_SHADER_TFB_NONE;
+}
+
+void GLShader::program_binary_cache_filepath(char *r_filepath) const
+{
+  std::string key = GPU_platform_support_level_key();
+  for (const std::string *source : {&vert_source_, &geom_source_, &frag_source_}) {
+    /* Separate the stages, a geometry shader could otherwise share the hash of another. */
+    key += '\0';
+    key += *source;
+  }
+
+  uchar digest[16];
+  char hexdigest[33];
+  BLI_hash_md5_buffer(key.data(), key.size(), digest);
+  BLI_hash_md5_to_hexdigest(digest, hexdigest);
+
+  char filename[FILE_MAXFILE];
+  BLI_snprintf(filename, sizeof(filename), "%s.bin", hexdigest);
+  BLI_path_join(
+      r_filepath, FILE_MAX, BKE_tempdir_base(), PROGRAM_BINARY_CACHE_DIRNAME, filename, NULL);
+}
+
+/* Return true if the program was successfully loaded and linked from the cached binary. */
+bool GLShader::program_binary_cache_load(const char *filepath)
+{
+  size_t data_len = 0;
+  char *data = (char *)BLI_file_read_binary_as_mem(filepath, 0, &data_len);
+  if (data == nullptr) {
+    return false;
+  }
+
+  bool success = false;
+  GLProgramBinaryHeader header;
+  if (data_len > sizeof(header)) {
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, program_binary_magic, sizeof(header.magic)) == 0 &&
+        (size_t)header.length == data_len - sizeof(header)) {
+      glProgramBinary(shader_program_, header.format, data + sizeof(header), header.length);
+      /* Fails when the driver changed in a way it can't load its own binary anymore.
+       * The program is then compiled from sources and the cache is overwritten. */
+      GLint status;
+      glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
+      success = status;
+    }
+  }
+  MEM_freeN(data);
+  return success;
+}
+
+void GLShader::program_binary_cache_save(const char *filepath)
+{
+  GLint length = 0;
+  glGetProgramiv(shader_program_, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) {
+    return;
+  }
+
+  GLProgramBinaryHeader header;
+  const size_t data_len = sizeof(header) + (size_t)length;
+  char *data = (char *)MEM_mallocN(data_len, __func__);
+  glGetProgramBinary(shader_program_, length, &length, &header.format, data + sizeof(header));
+  memcpy(header.magic, program_binary_magic, sizeof(header.magic));
+  header.length = length;
+  memcpy(data, &header, sizeof(header));
+
+  char dirpath[FILE_MAX];
+  BLI_split_dir_part(filepath, dirpath, sizeof(dirpath));
+  BLI_dir_create_recursive(dirpath);
+
+  /* Write to a temporary file first: the same shader can be compiled from another thread
+   * (deferred compilation) or instance, which should never read a partially written file. */
+  char filepath_tmp[FILE_MAX];
+  BLI_snprintf(filepath_tmp, sizeof(filepath_tmp), "%s.%p", filepath, (void *)this);
+  FILE *file = BLI_fopen(filepath_tmp, "wb");
+  if (file != nullptr) {
+    const size_t write_len = sizeof(header) + (size_t)length;
+    const bool written = fwrite(data, 1, write_len, file) == write_len;
+    fclose(file);
+    if (!written || BLI_rename(filepath_tmp, filepath) != 0) {
+      BLI_delete(filepath_tmp, false, false);
+    }
+  }
+  MEM_freeN(data);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Binding
  * \{ */
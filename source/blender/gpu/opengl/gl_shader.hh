@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "MEM_guardedalloc.h"
 
 #include "glew-mx.h"
@@ -45,6 +47,13 @@ class GLShader : public Shader {
   GLuint frag_shader_ = 0;
   /** True if any shader failed to compile. */
   bool compilation_failed_ = false;
+  /**
+   * Patched sources of the individual stages. The stages are only compiled when finalizing,
+   * so that a program binary found in the cache can skip compilation entirely.
+   */
+  std::string vert_source_;
+  std::string geom_source_;
+  std::string frag_source_;
 
   eGPUShaderTFBType transform_feedback_type_ = GPU_SHADER_TFB_NONE;
 
@@ -74,7 +83,13 @@ class GLShader : public Shader {
  private:
   char *glsl_patch_get(void);
 
-  GLuint create_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources);
+  std::string shader_stage_source(MutableSpan<const char *> sources);
+  GLuint create_shader_stage(GLenum gl_stage, const std::string &source);
+
+  bool program_binary_cache_use(void) const;
+  void program_binary_cache_filepath(char *r_filepath) const;
+  bool program_binary_cache_load(const char *filepath);
+  void program_binary_cache_save(const char *filepath);
 
   MEM_CXX_CLASS_ALLOC_FUNCS("GLShader");
 };
@@ -47,6 +47,7 @@
 #include "BLI_math_color.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_appdir.h"
@@ -100,12 +101,30 @@ static float imbuf_linear_srgb_to_xyz[3][3] = {{0.0f}};
  */
 static pthread_mutex_t processor_lock = BLI_MUTEX_INITIALIZER;
 
+/* Display transform baked into a 3D LUT, shared by all processors with the same settings. */
+typedef struct ColormanageBakedLUT {
+  struct ColormanageBakedLUT *next, *prev;
+  char key[MAX_COLORSPACE_NAME * 4 + 32];
+  /* Number of processors using this LUT, unused LUTs are kept around for reuse. */
+  int users;
+  /* RGB triplets, red varies fastest. */
+  float *table;
+} ColormanageBakedLUT;
+
 typedef struct ColormanageProcessor {
   OCIO_ConstProcessorRcPtr *processor;
   CurveMapping *curve_mapping;
   bool is_data_result;
+  /* Identifies the baked LUT equivalent of the processor, empty when it can't be baked. */
+  char lut_key[MAX_COLORSPACE_NAME * 4 + 32];
+  /* Acquired on first use with a big enough buffer. */
+  ColormanageBakedLUT *lut;
 } ColormanageProcessor;
 
+static ListBase global_baked_luts = {NULL, NULL};
+
+static void colormanage_baked_luts_free(void);
+
 static struct global_glsl_state {
   /* Actual processor used for GLSL baked LUTs. */
   /* UI colorspace here refers to the display linear color space,
@@ -655,6 +674,9 @@ static void colormanage_free_config(void)
   BLI_freelistN(&global_looks);
   global_tot_looks = 0;
 
+  /* free baked display transforms */
+  colormanage_baked_luts_free();
+
   OCIO_exit();
 }
 
@@ -2264,6 +2286,121 @@ void IMB_colormanagement_colorspace_to_scene_linear(float *buffer,
   }
 }
 
+typedef struct ImbufToTextureData {
+  void *out_buffer;
+  int offset_x, offset_y, width;
+  const struct ImBuf *ibuf;
+  OCIO_ConstProcessorRcPtr *processor;
+  bool use_premultiply;
+  bool use_unpremultiply;
+} ImbufToTextureData;
+
+static void imbuf_to_byte_texture_row_cb(void *__restrict userdata,
+                                         const int y,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ImbufToTextureData *data = userdata;
+  const struct ImBuf *ibuf = data->ibuf;
+  const int width = data->width;
+  const bool use_premultiply = data->use_premultiply;
+
+  const unsigned char *in_buffer = (unsigned char *)ibuf->rect;
+  const size_t in_offset = (data->offset_y + y) * ibuf->x + data->offset_x;
+  const size_t out_offset = y * width;
+  const unsigned char *in = in_buffer + in_offset * 4;
+  unsigned char *out = (unsigned char *)data->out_buffer + out_offset * 4;
+
+  if (data->processor) {
+    /* Convert to scene linear, to sRGB and premultiply. */
+    for (int x = 0; x < width; x++, in += 4, out += 4) {
+      float pixel[4];
+      rgba_uchar_to_float(pixel, in);
+      OCIO_processorApplyRGB(data->processor, pixel);
+      linearrgb_to_srgb_v3_v3(pixel, pixel);
+      if (use_premultiply) {
+        mul_v3_fl(pixel, pixel[3]);
+      }
+      rgba_float_to_uchar(out, pixel);
+    }
+  }
+  else if (use_premultiply) {
+    /* Premultiply only. */
+    for (int x = 0; x < width; x++, in += 4, out += 4) {
+      out[0] = (in[0] * in[3]) >> 8;
+      out[1] = (in[1] * in[3]) >> 8;
+      out[2] = (in[2] * in[3]) >> 8;
+      out[3] = in[3];
+    }
+  }
+  else {
+    /* Copy only. */
+    for (int x = 0; x < width; x++, in += 4, out += 4) {
+      out[0] = in[0];
+      out[1] = in[1];
+      out[2] = in[2];
+      out[3] = in[3];
+    }
+  }
+}
+
+static void imbuf_to_float_texture_row_cb(void *__restrict userdata,
+                                          const int y,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ImbufToTextureData *data = userdata;
+  const struct ImBuf *ibuf = data->ibuf;
+  const int width = data->width;
+  const int in_channels = ibuf->channels;
+
+  const float *in_buffer = ibuf->rect_float;
+  const size_t in_offset = (data->offset_y + y) * ibuf->x + data->offset_x;
+  const size_t out_offset = y * width;
+  const float *in = in_buffer + in_offset * in_channels;
+  float *out = (float *)data->out_buffer + out_offset * 4;
+
+  if (in_channels == 1) {
+    /* Copy single channel. */
+    for (int x = 0; x < width; x++, in += 1, out += 4) {
+      out[0] = in[0];
+      out[1] = in[0];
+      out[2] = in[0];
+      out[3] = in[0];
+    }
+  }
+  else if (in_channels == 3) {
+    /* Copy RGB. */
+    for (int x = 0; x < width; x++, in += 3, out += 4) {
+      out[0] = in[0];
+      out[1] = in[1];
+      out[2] = in[2];
+      out[3] = 1.0f;
+    }
+  }
+  else if (in_channels == 4) {
+    /* Copy or convert RGBA. */
+    if (data->use_unpremultiply) {
+      for (int x = 0; x < width; x++, in += 4, out += 4) {
+        premul_to_straight_v4_v4(out, in);
+      }
+    }
+    else {
+      memcpy(out, in, sizeof(float[4]) * width);
+    }
+  }
+}
+
+static void imbuf_to_texture_threaded(ImbufToTextureData *data,
+                                      const int height,
+                                      TaskParallelRangeFunc func)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  /* Small updates (e.g. texture painting) are not worth the threading overhead. */
+  settings.use_threading = ((size_t)data->width * height) > 64 * 64;
+  settings.min_iter_per_thread = 16;
+  BLI_task_parallel_range(0, height, data, func, &settings);
+}
+
 void IMB_colormanagement_imbuf_to_byte_texture(unsigned char *out_buffer,
                                                const int offset_x,
                                                const int offset_y,
@@ -2284,48 +2421,18 @@ void IMB_colormanagement_imbuf_to_byte_texture(unsigned char *out_buffer,
     processor = colorspace_to_scene_linear_processor(ibuf->rect_colorspace);
   }
 
-  /* TODO(brecht): make this multi-threaded, or at least process in batches. */
-  const unsigned char *in_buffer = (unsigned char *)ibuf->rect;
-  const bool use_premultiply = IMB_alpha_affects_rgb(ibuf) && store_premultiplied;
-
-  for (int y = 0; y < height; y++) {
-    const size_t in_offset = (offset_y + y) * ibuf->x + offset_x;
-    const size_t out_offset = y * width;
-    const unsigned char *in = in_buffer + in_offset * 4;
-    unsigned char *out = out_buffer + out_offset * 4;
-
-    if (processor) {
-      /* Convert to scene linear, to sRGB and premultiply. */
-      for (int x = 0; x < width; x++, in += 4, out += 4) {
-        float pixel[4];
-        rgba_uchar_to_float(pixel, in);
-        OCIO_processorApplyRGB(processor, pixel);
-        linearrgb_to_srgb_v3_v3(pixel, pixel);
-        if (use_premultiply) {
-          mul_v3_fl(pixel, pixel[3]);
-        }
-        rgba_float_to_uchar(out, pixel);
-      }
-    }
-    else if (use_premultiply) {
-      /* Premultiply only. */
-      for (int x = 0; x < width; x++, in += 4, out += 4) {
-        out[0] = (in[0] * in[3]) >> 8;
-        out[1] = (in[1] * in[3]) >> 8;
-        out[2] = (in[2] * in[3]) >> 8;
-        out[3] = in[3];
-      }
-    }
-    else {
-      /* Copy only. */
-      for (int x = 0; x < width; x++, in += 4, out += 4) {
-        out[0] = in[0];
-        out[1] = in[1];
-        out[2] = in[2];
-        out[3] = in[3];
-      }
-    }
-  }
+  /* Rows are converted in parallel, this is the bulk of the CPU time spent when loading large
+   * images to the GPU. */
+  ImbufToTextureData data = {
+      .out_buffer = out_buffer,
+      .offset_x = offset_x,
+      .offset_y = offset_y,
+      .width = width,
+      .ibuf = ibuf,
+      .processor = processor,
+      .use_premultiply = IMB_alpha_affects_rgb(ibuf) && store_premultiplied,
+  };
+  imbuf_to_texture_threaded(&data, height, imbuf_to_byte_texture_row_cb);
 }
 
 void IMB_colormanagement_imbuf_to_float_texture(float *out_buffer,
@@ -2338,46 +2445,15 @@ void IMB_colormanagement_imbuf_to_float_texture(float *out_buffer,
 {
   /* Float texture are stored in scene linear color space, with premultiplied
    * alpha depending on the image alpha mode. */
-  const float *in_buffer = ibuf->rect_float;
-  const int in_channels = ibuf->channels;
-  const bool use_unpremultiply = IMB_alpha_affects_rgb(ibuf) && !store_premultiplied;
-
-  for (int y = 0; y < height; y++) {
-    const size_t in_offset = (offset_y + y) * ibuf->x + offset_x;
-    const size_t out_offset = y * width;
-    const float *in = in_buffer + in_offset * in_channels;
-    float *out = out_buffer + out_offset * 4;
-
-    if (in_channels == 1) {
-      /* Copy single channel. */
-      for (int x = 0; x < width; x++, in += 1, out += 4) {
-        out[0] = in[0];
-        out[1] = in[0];
-        out[2] = in[0];
-        out[3] = in[0];
-      }
-    }
-    else if (in_channels == 3) {
-      /* Copy RGB. */
-      for (int x = 0; x < width; x++, in += 3, out += 4) {
-        out[0] = in[0];
-        out[1] = in[1];
-        out[2] = in[2];
-        out[3] = 1.0f;
-      }
-    }
-    else if (in_channels == 4) {
-      /* Copy or convert RGBA. */
-      if (use_unpremultiply) {
-        for (int x = 0; x < width; x++, in += 4, out += 4) {
-          premul_to_straight_v4_v4(out, in);
-        }
-      }
-      else {
-        memcpy(out, in, sizeof(float[4]) * width);
-      }
-    }
-  }
+  ImbufToTextureData data = {
+      .out_buffer = out_buffer,
+      .offset_x = offset_x,
+      .offset_y = offset_y,
+      .width = width,
+      .ibuf = ibuf,
+      .use_unpremultiply = IMB_alpha_affects_rgb(ibuf) && !store_premultiplied,
+  };
+  imbuf_to_texture_threaded(&data, height, imbuf_to_float_texture_row_cb);
 }
 
 /* Conversion between color picking role. Typically we would expect such a
@@ -3805,6 +3881,211 @@ void IMB_partial_display_buffer_update_delayed(ImBuf *ibuf, int xmin, int ymin,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Baked Display LUTs
+ *
+ * Applying a full display transform (view, look and exposure) through OCIO is expensive per
+ * pixel. For big buffers the transform is baked into a 3D LUT once per settings and applied with
+ * trilinear interpolation instead, like the GLSL display path does. A fourth root shaper gives
+ * the darks more resolution, pixels outside of the LUT domain use the exact transform.
+ * \{ */
+
+#define BAKED_LUT_SIZE 64
+/* Puts 1.0 on a lattice point, so transforms clipping there don't get smoothed. */
+#define BAKED_LUT_MAX_VALUE 81.0f
+/* Unused baked LUTs kept around, they take 3MB each. */
+#define BAKED_LUT_MAX_UNUSED 4
+/* Buffers smaller than this are not worth baking a LUT for. */
+#define BAKED_LUT_MIN_PIXELS (256 * 256)
+
+BLI_INLINE float baked_lut_shaper(const float value)
+{
+  return sqrtf(sqrtf(value * (1.0f / BAKED_LUT_MAX_VALUE)));
+}
+
+static void colormanage_baked_lut_free(ColormanageBakedLUT *lut)
+{
+  MEM_freeN(lut->table);
+  MEM_freeN(lut);
+}
+
+static void colormanage_baked_luts_free(void)
+{
+  ColormanageBakedLUT *lut, *lut_next;
+
+  for (lut = global_baked_luts.first; lut; lut = lut_next) {
+    lut_next = lut->next;
+    BLI_assert(lut->users == 0);
+    colormanage_baked_lut_free(lut);
+  }
+  BLI_listbase_clear(&global_baked_luts);
+}
+
+static float *colormanage_baked_lut_create_table(OCIO_ConstProcessorRcPtr *processor)
+{
+  const int size = BAKED_LUT_SIZE;
+  const size_t num_entries = (size_t)size * size * size;
+  float *table = MEM_mallocN(sizeof(float[3]) * num_entries, "colormanage baked lut");
+  float lattice[BAKED_LUT_SIZE];
+  float *entry = table;
+
+  /* Inverse of the shaper. */
+  for (int i = 0; i < size; i++) {
+    const float t = (float)i / (size - 1);
+    lattice[i] = BAKED_LUT_MAX_VALUE * (t * t) * (t * t);
+  }
+
+  for (int b = 0; b < size; b++) {
+    for (int g = 0; g < size; g++) {
+      for (int r = 0; r < size; r++) {
+        entry[0] = lattice[r];
+        entry[1] = lattice[g];
+        entry[2] = lattice[b];
+        entry += 3;
+      }
+    }
+  }
+
+  OCIO_PackedImageDesc *img = OCIO_createOCIO_PackedImageDesc(table,
+                                                              (long)num_entries,
+                                                              1,
+                                                              3,
+                                                              sizeof(float),
+                                                              sizeof(float[3]),
+                                                              sizeof(float[3]) * num_entries);
+  OCIO_processorApply(processor, img);
+  OCIO_PackedImageDescRelease(img);
+
+  return table;
+}
+
+/* Find or bake the LUT of the processor, must be called with the processor lock held. */
+static ColormanageBakedLUT *colormanage_baked_lut_acquire(ColormanageProcessor *cm_processor)
+{
+  ColormanageBakedLUT *lut = BLI_findstring(
+      &global_baked_luts, cm_processor->lut_key, offsetof(ColormanageBakedLUT, key));
+
+  if (lut) {
+    /* Keep the most recently used LUTs first. */
+    BLI_remlink(&global_baked_luts, lut);
+  }
+  else {
+    lut = MEM_callocN(sizeof(ColormanageBakedLUT), "colormanage baked lut");
+    BLI_strncpy(lut->key, cm_processor->lut_key, sizeof(lut->key));
+    lut->table = colormanage_baked_lut_create_table(cm_processor->processor);
+
+    /* Evict the least recently used LUTs nobody refers to anymore. */
+    int num_unused = 0;
+    LISTBASE_FOREACH (ColormanageBakedLUT *, lut_iter, &global_baked_luts) {
+      if (lut_iter->users == 0) {
+        num_unused++;
+      }
+    }
+    ColormanageBakedLUT *lut_iter, *lut_prev;
+    for (lut_iter = global_baked_luts.last; lut_iter && num_unused >= BAKED_LUT_MAX_UNUSED;
+         lut_iter = lut_prev) {
+      lut_prev = lut_iter->prev;
+      if (lut_iter->users == 0) {
+        BLI_remlink(&global_baked_luts, lut_iter);
+        colormanage_baked_lut_free(lut_iter);
+        num_unused--;
+      }
+    }
+  }
+
+  BLI_addhead(&global_baked_luts, lut);
+  lut->users++;
+
+  return lut;
+}
+
+static void colormanage_baked_lut_release(ColormanageBakedLUT *lut)
+{
+  BLI_mutex_lock(&processor_lock);
+  BLI_assert(lut->users > 0);
+  lut->users--;
+  BLI_mutex_unlock(&processor_lock);
+}
+
+/* Trilinear lookup, the color must be within the LUT domain. */
+BLI_INLINE void baked_lut_evaluate(const float *table, float rgb[3])
+{
+  const int size = BAKED_LUT_SIZE;
+  const size_t stride_g = (size_t)3 * size;
+  const size_t stride_b = stride_g * size;
+  int index[3];
+  float frac[3];
+
+  for (int i = 0; i < 3; i++) {
+    const float t = baked_lut_shaper(rgb[i]) * (size - 1);
+    index[i] = min_ii((int)t, size - 2);
+    frac[i] = t - index[i];
+  }
+
+  const float *c000 = table + index[2] * stride_b + index[1] * stride_g + index[0] * 3;
+  const float *c010 = c000 + stride_g;
+  const float *c001 = c000 + stride_b;
+  const float *c011 = c001 + stride_g;
+
+  for (int i = 0; i < 3; i++) {
+    const float c00 = c000[i] + (c000[i + 3] - c000[i]) * frac[0];
+    const float c10 = c010[i] + (c010[i + 3] - c010[i]) * frac[0];
+    const float c01 = c001[i] + (c001[i + 3] - c001[i]) * frac[0];
+    const float c11 = c011[i] + (c011[i + 3] - c011[i]) * frac[0];
+    const float c0 = c00 + (c10 - c00) * frac[1];
+    const float c1 = c01 + (c11 - c01) * frac[1];
+    rgb[i] = c0 + (c1 - c0) * frac[2];
+  }
+}
+
+BLI_INLINE bool baked_lut_in_domain(const float rgb[3])
+{
+  /* Written so NaN is out of the domain. */
+  return (rgb[0] >= 0.0f && rgb[0] <= BAKED_LUT_MAX_VALUE) &&
+         (rgb[1] >= 0.0f && rgb[1] <= BAKED_LUT_MAX_VALUE) &&
+         (rgb[2] >= 0.0f && rgb[2] <= BAKED_LUT_MAX_VALUE);
+}
+
+static void colormanage_baked_lut_apply(ColormanageProcessor *cm_processor,
+                                        const ColormanageBakedLUT *lut,
+                                        float *buffer,
+                                        const size_t num_pixels,
+                                        const int channels,
+                                        const bool predivide)
+{
+  const bool use_predivide = predivide && channels == 4;
+
+  for (size_t i = 0; i < num_pixels; i++) {
+    float *pixel = buffer + channels * i;
+    float rgb[3];
+    float alpha = 1.0f;
+
+    copy_v3_v3(rgb, pixel);
+    if (use_predivide && !ELEM(pixel[3], 0.0f, 1.0f)) {
+      alpha = pixel[3];
+      mul_v3_fl(rgb, 1.0f / alpha);
+    }
+
+    if (baked_lut_in_domain(rgb)) {
+      baked_lut_evaluate(lut->table, rgb);
+      mul_v3_v3fl(pixel, rgb, alpha);
+    }
+    else if (channels == 4) {
+      if (use_predivide) {
+        OCIO_processorApplyRGBA_predivide(cm_processor->processor, pixel);
+      }
+      else {
+        OCIO_processorApplyRGBA(cm_processor->processor, pixel);
+      }
+    }
+    else {
+      OCIO_processorApplyRGB(cm_processor->processor, pixel);
+    }
+  }
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Pixel Processor Functions
  * \{ */
@@ -3846,6 +4127,18 @@ ColormanageProcessor *IMB_colormanagement_display_processor_new(
     BKE_curvemapping_premultiply(cm_processor->curve_mapping, false);
   }
 
+  /* Gamma is applied to alpha as well, which the RGB only LUT can't represent. */
+  if (cm_processor->processor && applied_view_settings->gamma == 1.0f) {
+    BLI_snprintf(cm_processor->lut_key,
+                 sizeof(cm_processor->lut_key),
+                 "%s|%s|%s|%s|%a",
+                 applied_view_settings->look,
+                 applied_view_settings->view_transform,
+                 display_settings->display_device,
+                 global_role_scene_linear,
+                 applied_view_settings->exposure);
+  }
+
   return cm_processor;
 }
 
@@ -3940,7 +4233,21 @@ void IMB_colormanagement_processor_apply(ColormanageProcessor *cm_processor,
     }
   }
 
-  if (cm_processor->processor && channels >= 3) {
+  if (cm_processor->processor && channels >= 3 && cm_processor->lut_key[0] &&
+      (size_t)width * height >= BAKED_LUT_MIN_PIXELS) {
+    /* Processors are shared between threads. */
+    BLI_mutex_lock(&processor_lock);
+    if (cm_processor->lut == NULL) {
+      cm_processor->lut = colormanage_baked_lut_acquire(cm_processor);
+    }
+    BLI_mutex_unlock(&processor_lock);
+  }
+
+  if (cm_processor->lut && channels >= 3) {
+    colormanage_baked_lut_apply(
+        cm_processor, cm_processor->lut, buffer, (size_t)width * height, channels, predivide);
+  }
+  else if (cm_processor->processor && channels >= 3) {
     OCIO_PackedImageDesc *img;
 
     /* apply OCIO processor */
@@ -3986,6 +4293,9 @@ void IMB_colormanagement_processor_free(ColormanageProcessor *cm_processor)
   if (cm_processor->curve_mapping) {
     BKE_curvemapping_free(cm_processor->curve_mapping);
   }
+  if (cm_processor->lut) {
+    colormanage_baked_lut_release(cm_processor->lut);
+  }
   if (cm_processor->processor) {
     OCIO_processorRelease(cm_processor->processor);
   }
@@ -52,6 +52,8 @@
 
 static MEM_CacheLimiterC *limitor = NULL;
 static pthread_mutex_t limitor_lock = BLI_MUTEX_INITIALIZER;
+/* Incremented on every put and get, protected by limitor_lock. */
+static unsigned int limitor_clock = 0;
 
 typedef struct MovieCache {
   char name[64];
@@ -87,6 +89,8 @@ typedef struct MovieCacheItem {
   ImBuf *ibuf;
   MEM_CacheLimiterHandleC *c_handle;
   void *priority_data;
+  /* Value of limitor_clock when the item was last put or accessed. */
+  unsigned int last_used;
 } MovieCacheItem;
 
 static unsigned int moviecache_hashhash(const void *keyv)
@@ -207,20 +211,22 @@ static size_t get_item_size(void *p)
   return size;
 }
 
-static int get_item_priority(void *item_v, int default_priority)
+static int get_item_priority(void *item_v, int UNUSED(default_priority))
 {
   MovieCacheItem *item = (MovieCacheItem *)item_v;
   MovieCache *cache = item->cache_owner;
   int priority;
 
   if (!cache->getitempriorityfp) {
-    PRINT("%s: cache '%s' item %p use default priority %d\n",
-          __func__,
-          cache->name,
-          item,
-          default_priority);
+    /* Because some caches use a priority callback, the limiter never re-orders its queue on
+     * access and the default priority only reflects insertion order. Use the access time
+     * instead, so caches without a callback are least recently used rather than first in first
+     * out. */
+    priority = -(int)(limitor_clock - item->last_used);
 
-    return default_priority;
+    PRINT("%s: cache '%s' item %p use default priority %d\n", __func__, cache->name, item, priority);
+
+    return priority;
   }
 
   priority = cache->getitempriorityfp(cache->last_userkey, item->priority_data);
@@ -343,6 +349,7 @@ static void do_moviecache_put(MovieCache *cache, void *userkey, ImBuf *ibuf, boo
   }
 
   item->c_handle = MEM_CacheLimiter_insert(limitor, item);
+  item->last_used = ++limitor_clock;
 
   MEM_CacheLimiter_ref(item->c_handle);
   MEM_CacheLimiter_enforce_limits(limitor);
@@ -408,6 +415,7 @@ ImBuf *IMB_moviecache_get(MovieCache *cache, void *userkey)
     if (item->ibuf) {
       BLI_mutex_lock(&limitor_lock);
       MEM_CacheLimiter_touch(item->c_handle);
+      item->last_used = ++limitor_clock;
       BLI_mutex_unlock(&limitor_lock);
 
       IMB_refImBuf(item->ibuf);
@@ -1239,6 +1239,7 @@ void IMB_exr_read_channels(void *handle)
     /* Insert all matching channel into framebuffer. */
     FrameBuffer frameBuffer;
     ExrChannel *echan;
+    int num_slices = 0;
 
     for (echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
       if (echan->m->part_number != i) {
@@ -1270,12 +1271,18 @@ void IMB_exr_read_channels(void *handle)
 
         frameBuffer.insert(echan->m->internal_name,
                            Slice(Imf::FLOAT, (char *)rect, xstride, ystride));
+        num_slices++;
       }
       else {
         printf("warning, channel with no rect set %s\n", echan->m->internal_name.c_str());
       }
     }
 
+    /* OpenEXR still decompresses all scanlines of a part when nothing is read from it. */
+    if (num_slices == 0) {
+      continue;
+    }
+
     /* Read pixels. */
     try {
       in.setFrameBuffer(frameBuffer);
@@ -2100,6 +2107,8 @@ struct ImBuf *imb_load_openexr(const unsigned char *mem,
 
 void imb_initopenexr(void)
 {
+  /* The `--threads` argument is parsed before this, files opened afterwards use the global
+   * pool for decompression by default. */
   int num_threads = BLI_system_thread_count();
 
   setGlobalThreadCount(num_threads);
@@ -26,6 +26,7 @@
 
 #include "BLI_math_color.h"
 #include "BLI_math_interp.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 #include "MEM_guardedalloc.h"
 
@@ -908,21 +909,142 @@ static bool q_scale_linear_interpolation(struct ImBuf *ibuf, int newx, int newy)
   return true;
 }
 
-static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
+typedef struct ScaleDownThreadData {
+  struct ImBuf *ibuf;
+  uchar *newrect;
+  float *newrectf;
+  /* New size along the scaled axis. */
+  int newsize;
+  float add;
+} ScaleDownThreadData;
+
+static void scaledown_parallel(struct ImBuf *ibuf,
+                               const int tot,
+                               ScaleDownThreadData *data,
+                               TaskParallelRangeFunc func)
 {
-  const int do_rect = (ibuf->rect != NULL);
-  const int do_float = (ibuf->rect_float != NULL);
-  const size_t rect_size = ibuf->x * ibuf->y * 4;
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  /* Small images (e.g. icons and previews) are not worth the threading overhead. */
+  settings.use_threading = ((size_t)ibuf->x * ibuf->y) > 64 * 64;
+  settings.min_iter_per_thread = 16;
+  BLI_task_parallel_range(0, tot, data, func, &settings);
+}
 
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y;
+/* Box filter a single row, every row consumes exactly `ibuf->x` source pixels. */
+static void scaledownx_row_cb(void *__restrict userdata,
+                              const int y,
+                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ScaleDownThreadData *data = userdata;
+  const struct ImBuf *ibuf = data->ibuf;
+  const int newx = data->newsize;
+  const float add = data->add;
+  const bool do_rect = (data->newrect != NULL);
+  const bool do_float = (data->newrectf != NULL);
+
+  const uchar *rect = NULL;
+  const float *rectf = NULL;
+  uchar *newrect = NULL;
+  float *newrectf = NULL;
+  float sample, val[4], nval[4], valf[4], nvalf[4];
+  int x;
+
+  if (do_rect) {
+    rect = (uchar *)ibuf->rect + (size_t)y * ibuf->x * 4;
+    newrect = data->newrect + (size_t)y * newx * 4;
+  }
+  if (do_float) {
+    rectf = ibuf->rect_float + (size_t)y * ibuf->x * 4;
+    newrectf = data->newrectf + (size_t)y * newx * 4;
+  }
 
-  rectf = _newrectf = newrectf = NULL;
-  rect = _newrect = newrect = NULL;
   nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
   nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+  sample = 0.0f;
+  val[0] = val[1] = val[2] = val[3] = 0.0f;
+  valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
+
+  for (x = newx; x > 0; x--) {
+    if (do_rect) {
+      nval[0] = -val[0] * sample;
+      nval[1] = -val[1] * sample;
+      nval[2] = -val[2] * sample;
+      nval[3] = -val[3] * sample;
+    }
+    if (do_float) {
+      nvalf[0] = -valf[0] * sample;
+      nvalf[1] = -valf[1] * sample;
+      nvalf[2] = -valf[2] * sample;
+      nvalf[3] = -valf[3] * sample;
+    }
+
+    sample += add;
+
+    while (sample >= 1.0f) {
+      sample -= 1.0f;
+
+      if (do_rect) {
+        nval[0] += rect[0];
+        nval[1] += rect[1];
+        nval[2] += rect[2];
+        nval[3] += rect[3];
+        rect += 4;
+      }
+      if (do_float) {
+        nvalf[0] += rectf[0];
+        nvalf[1] += rectf[1];
+        nvalf[2] += rectf[2];
+        nvalf[3] += rectf[3];
+        rectf += 4;
+      }
+    }
+
+    if (do_rect) {
+      val[0] = rect[0];
+      val[1] = rect[1];
+      val[2] = rect[2];
+      val[3] = rect[3];
+      rect += 4;
+
+      newrect[0] = roundf((nval[0] + sample * val[0]) / add);
+      newrect[1] = roundf((nval[1] + sample * val[1]) / add);
+      newrect[2] = roundf((nval[2] + sample * val[2]) / add);
+      newrect[3] = roundf((nval[3] + sample * val[3]) / add);
+
+      newrect += 4;
+    }
+    if (do_float) {
+
+      valf[0] = rectf[0];
+      valf[1] = rectf[1];
+      valf[2] = rectf[2];
+      valf[3] = rectf[3];
+      rectf += 4;
+
+      newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
+      newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
+      newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
+      newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+
+      newrectf += 4;
+    }
+
+    sample -= 1.0f;
+  }
+
+  /* See bug T26502. */
+  BLI_assert(!do_rect || (rect - (uchar *)ibuf->rect) == (size_t)(y + 1) * ibuf->x * 4);
+  BLI_assert(!do_float || (rectf - ibuf->rect_float) == (size_t)(y + 1) * ibuf->x * 4);
+}
+
+static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
+{
+  const int do_rect = (ibuf->rect != NULL);
+  const int do_float = (ibuf->rect_float != NULL);
+
+  uchar *_newrect = NULL;
+  float *_newrectf = NULL;
 
   if (!do_rect && !do_float) {
     return ibuf;
@@ -944,126 +1066,147 @@ static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
     }
   }
 
-  add = (ibuf->x - 0.01) / newx;
+  /* Rows are independent. */
+  ScaleDownThreadData data = {
+      .ibuf = ibuf,
+      .newrect = _newrect,
+      .newrectf = _newrectf,
+      .newsize = newx,
+      .add = (ibuf->x - 0.01) / newx,
+  };
+  scaledown_parallel(ibuf, ibuf->y, &data, scaledownx_row_cb);
 
   if (do_rect) {
-    rect = (uchar *)ibuf->rect;
-    newrect = _newrect;
+    imb_freerectImBuf(ibuf);
+    ibuf->mall |= IB_rect;
+    ibuf->rect = (unsigned int *)_newrect;
   }
   if (do_float) {
-    rectf = ibuf->rect_float;
-    newrectf = _newrectf;
+    imb_freerectfloatImBuf(ibuf);
+    ibuf->mall |= IB_rectfloat;
+    ibuf->rect_float = _newrectf;
   }
 
-  for (y = ibuf->y; y > 0; y--) {
-    sample = 0.0f;
-    val[0] = val[1] = val[2] = val[3] = 0.0f;
-    valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
+  ibuf->x = newx;
+  return ibuf;
+}
 
-    for (x = newx; x > 0; x--) {
-      if (do_rect) {
-        nval[0] = -val[0] * sample;
-        nval[1] = -val[1] * sample;
-        nval[2] = -val[2] * sample;
-        nval[3] = -val[3] * sample;
-      }
-      if (do_float) {
-        nvalf[0] = -valf[0] * sample;
-        nvalf[1] = -valf[1] * sample;
-        nvalf[2] = -valf[2] * sample;
-        nvalf[3] = -valf[3] * sample;
-      }
+/* Box filter a single column, every column consumes exactly `ibuf->y` source pixels. */
+static void scaledowny_column_cb(void *__restrict userdata,
+                                 const int column,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ScaleDownThreadData *data = userdata;
+  const struct ImBuf *ibuf = data->ibuf;
+  const int newy = data->newsize;
+  const float add = data->add;
+  const bool do_rect = (data->newrect != NULL);
+  const bool do_float = (data->newrectf != NULL);
+  const size_t skipx = 4 * (size_t)ibuf->x;
+  const size_t x = 4 * (size_t)column;
+
+  const uchar *rect = NULL;
+  const float *rectf = NULL;
+  uchar *newrect = NULL;
+  float *newrectf = NULL;
+  float sample, val[4], nval[4], valf[4], nvalf[4];
+  int y;
 
-      sample += add;
+  if (do_rect) {
+    rect = ((uchar *)ibuf->rect) + x;
+    newrect = data->newrect + x;
+  }
+  if (do_float) {
+    rectf = ibuf->rect_float + x;
+    newrectf = data->newrectf + x;
+  }
 
-      while (sample >= 1.0f) {
-        sample -= 1.0f;
+  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
+  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+  sample = 0.0f;
+  val[0] = val[1] = val[2] = val[3] = 0.0f;
+  valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
 
-        if (do_rect) {
-          nval[0] += rect[0];
-          nval[1] += rect[1];
-          nval[2] += rect[2];
-          nval[3] += rect[3];
-          rect += 4;
-        }
-        if (do_float) {
-          nvalf[0] += rectf[0];
-          nvalf[1] += rectf[1];
-          nvalf[2] += rectf[2];
-          nvalf[3] += rectf[3];
-          rectf += 4;
-        }
-      }
+  for (y = newy; y > 0; y--) {
+    if (do_rect) {
+      nval[0] = -val[0] * sample;
+      nval[1] = -val[1] * sample;
+      nval[2] = -val[2] * sample;
+      nval[3] = -val[3] * sample;
+    }
+    if (do_float) {
+      nvalf[0] = -valf[0] * sample;
+      nvalf[1] = -valf[1] * sample;
+      nvalf[2] = -valf[2] * sample;
+      nvalf[3] = -valf[3] * sample;
+    }
 
-      if (do_rect) {
-        val[0] = rect[0];
-        val[1] = rect[1];
-        val[2] = rect[2];
-        val[3] = rect[3];
-        rect += 4;
+    sample += add;
 
-        newrect[0] = roundf((nval[0] + sample * val[0]) / add);
-        newrect[1] = roundf((nval[1] + sample * val[1]) / add);
-        newrect[2] = roundf((nval[2] + sample * val[2]) / add);
-        newrect[3] = roundf((nval[3] + sample * val[3]) / add);
+    while (sample >= 1.0f) {
+      sample -= 1.0f;
 
-        newrect += 4;
+      if (do_rect) {
+        nval[0] += rect[0];
+        nval[1] += rect[1];
+        nval[2] += rect[2];
+        nval[3] += rect[3];
+        rect += skipx;
       }
       if (do_float) {
+        nvalf[0] += rectf[0];
+        nvalf[1] += rectf[1];
+        nvalf[2] += rectf[2];
+        nvalf[3] += rectf[3];
+        rectf += skipx;
+      }
+    }
 
-        valf[0] = rectf[0];
-        valf[1] = rectf[1];
-        valf[2] = rectf[2];
-        valf[3] = rectf[3];
-        rectf += 4;
+    if (do_rect) {
+      val[0] = rect[0];
+      val[1] = rect[1];
+      val[2] = rect[2];
+      val[3] = rect[3];
+      rect += skipx;
+
+      newrect[0] = roundf((nval[0] + sample * val[0]) / add);
+      newrect[1] = roundf((nval[1] + sample * val[1]) / add);
+      newrect[2] = roundf((nval[2] + sample * val[2]) / add);
+      newrect[3] = roundf((nval[3] + sample * val[3]) / add);
+
+      newrect += skipx;
+    }
+    if (do_float) {
 
-        newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
-        newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
-        newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
-        newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+      valf[0] = rectf[0];
+      valf[1] = rectf[1];
+      valf[2] = rectf[2];
+      valf[3] = rectf[3];
+      rectf += skipx;
 
-        newrectf += 4;
-      }
+      newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
+      newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
+      newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
+      newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
 
-      sample -= 1.0f;
+      newrectf += skipx;
     }
-  }
 
-  if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ((uchar *)ibuf->rect), rect_size);
-    BLI_assert((uchar *)rect - ((uchar *)ibuf->rect) == rect_size); /* see bug T26502. */
-    imb_freerectImBuf(ibuf);
-    ibuf->mall |= IB_rect;
-    ibuf->rect = (unsigned int *)_newrect;
-  }
-  if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->rect_float, rect_size);
-    BLI_assert((rectf - ibuf->rect_float) == rect_size); /* see bug T26502. */
-    imb_freerectfloatImBuf(ibuf);
-    ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = _newrectf;
+    sample -= 1.0f;
   }
-  (void)rect_size; /* UNUSED in release builds */
 
-  ibuf->x = newx;
-  return ibuf;
+  /* See bug T26502. */
+  BLI_assert(!do_rect || (rect - (uchar *)ibuf->rect) == skipx * ibuf->y + x);
+  BLI_assert(!do_float || (rectf - ibuf->rect_float) == skipx * ibuf->y + x);
 }
 
 static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
 {
   const int do_rect = (ibuf->rect != NULL);
   const int do_float = (ibuf->rect_float != NULL);
-  const size_t rect_size = ibuf->x * ibuf->y * 4;
-
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y, skipx;
 
-  rectf = _newrectf = newrectf = NULL;
-  rect = _newrect = newrect = NULL;
-  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
-  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+  uchar *_newrect = NULL;
+  float *_newrectf = NULL;
 
   if (!do_rect && !do_float) {
     return ibuf;
@@ -1085,107 +1228,26 @@ static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
     }
   }
 
-  add = (ibuf->y - 0.01) / newy;
-  skipx = 4 * ibuf->x;
-
-  for (x = skipx - 4; x >= 0; x -= 4) {
-    if (do_rect) {
-      rect = ((uchar *)ibuf->rect) + x;
-      newrect = _newrect + x;
-    }
-    if (do_float) {
-      rectf = ibuf->rect_float + x;
-      newrectf = _newrectf + x;
-    }
-
-    sample = 0.0f;
-    val[0] = val[1] = val[2] = val[3] = 0.0f;
-    valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
-
-    for (y = newy; y > 0; y--) {
-      if (do_rect) {
-        nval[0] = -val[0] * sample;
-        nval[1] = -val[1] * sample;
-        nval[2] = -val[2] * sample;
-        nval[3] = -val[3] * sample;
-      }
-      if (do_float) {
-        nvalf[0] = -valf[0] * sample;
-        nvalf[1] = -valf[1] * sample;
-        nvalf[2] = -valf[2] * sample;
-        nvalf[3] = -valf[3] * sample;
-      }
-
-      sample += add;
-
-      while (sample >= 1.0f) {
-        sample -= 1.0f;
-
-        if (do_rect) {
-          nval[0] += rect[0];
-          nval[1] += rect[1];
-          nval[2] += rect[2];
-          nval[3] += rect[3];
-          rect += skipx;
-        }
-        if (do_float) {
-          nvalf[0] += rectf[0];
-          nvalf[1] += rectf[1];
-          nvalf[2] += rectf[2];
-          nvalf[3] += rectf[3];
-          rectf += skipx;
-        }
-      }
-
-      if (do_rect) {
-        val[0] = rect[0];
-        val[1] = rect[1];
-        val[2] = rect[2];
-        val[3] = rect[3];
-        rect += skipx;
-
-        newrect[0] = roundf((nval[0] + sample * val[0]) / add);
-        newrect[1] = roundf((nval[1] + sample * val[1]) / add);
-        newrect[2] = roundf((nval[2] + sample * val[2]) / add);
-        newrect[3] = roundf((nval[3] + sample * val[3]) / add);
-
-        newrect += skipx;
-      }
-      if (do_float) {
-
-        valf[0] = rectf[0];
-        valf[1] = rectf[1];
-        valf[2] = rectf[2];
-        valf[3] = rectf[3];
-        rectf += skipx;
-
-        newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
-        newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
-        newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
-        newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
-
-        newrectf += skipx;
-      }
-
-      sample -= 1.0f;
-    }
-  }
+  /* Columns are independent. */
+  ScaleDownThreadData data = {
+      .ibuf = ibuf,
+      .newrect = _newrect,
+      .newrectf = _newrectf,
+      .newsize = newy,
+      .add = (ibuf->y - 0.01) / newy,
+  };
+  scaledown_parallel(ibuf, ibuf->x, &data, scaledowny_column_cb);
 
   if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ((uchar *)ibuf->rect), rect_size);
-    BLI_assert((uchar *)rect - ((uchar *)ibuf->rect) == rect_size); /* see bug T26502. */
     imb_freerectImBuf(ibuf);
     ibuf->mall |= IB_rect;
     ibuf->rect = (unsigned int *)_newrect;
   }
   if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->rect_float, rect_size);
-    BLI_assert((rectf - ibuf->rect_float) == rect_size); /* see bug T26502. */
     imb_freerectfloatImBuf(ibuf);
     ibuf->mall |= IB_rectfloat;
     ibuf->rect_float = (float *)_newrectf;
   }
-  (void)rect_size; /* UNUSED in release builds */
 
   ibuf->y = newy;
   return ibuf;
@@ -1661,23 +1723,55 @@ struct imbufRGBA {
   float r, g, b, a;
 };
 
+typedef struct ScaleFastThreadData {
+  struct ImBuf *ibuf;
+  unsigned int *newrect;
+  struct imbufRGBA *newrectf;
+  unsigned int newx;
+  /* Source step per destination pixel in 16.16 fixed point. */
+  size_t stepx, stepy;
+} ScaleFastThreadData;
+
+static void scalefast_row_cb(void *__restrict userdata,
+                             const int y,
+                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ScaleFastThreadData *data = userdata;
+  const struct ImBuf *ibuf = data->ibuf;
+  const size_t ofsy = 32768 + (size_t)y * data->stepy;
+  const size_t src_row = (ofsy >> 16) * ibuf->x;
+  size_t ofsx;
+  unsigned int x;
+
+  if (data->newrect) {
+    const unsigned int *rect = ibuf->rect + src_row;
+    unsigned int *newrect = data->newrect + (size_t)y * data->newx;
+    ofsx = 32768;
+
+    for (x = data->newx; x > 0; x--, ofsx += data->stepx) {
+      *newrect++ = rect[ofsx >> 16];
+    }
+  }
+
+  if (data->newrectf) {
+    const struct imbufRGBA *rectf = (struct imbufRGBA *)ibuf->rect_float + src_row;
+    struct imbufRGBA *newrectf = data->newrectf + (size_t)y * data->newx;
+    ofsx = 32768;
+
+    for (x = data->newx; x > 0; x--, ofsx += data->stepx) {
+      *newrectf++ = rectf[ofsx >> 16];
+    }
+  }
+}
+
 /**
  * Return true if \a ibuf is modified.
  */
 bool IMB_scalefastImBuf(struct ImBuf *ibuf, unsigned int newx, unsigned int newy)
 {
-  unsigned int *rect, *_newrect, *newrect;
-  struct imbufRGBA *rectf, *_newrectf, *newrectf;
-  int x, y;
+  unsigned int *_newrect = NULL;
+  struct imbufRGBA *_newrectf = NULL;
   bool do_float = false, do_rect = false;
-  size_t ofsx, ofsy, stepx, stepy;
-
-  rect = NULL;
-  _newrect = NULL;
-  newrect = NULL;
-  rectf = NULL;
-  _newrectf = NULL;
-  newrectf = NULL;
 
   if (ibuf == NULL) {
     return false;
@@ -1701,7 +1795,6 @@ bool IMB_scalefastImBuf(struct ImBuf *ibuf, unsigned int newx, unsigned int newy
     if (_newrect == NULL) {
       return false;
     }
-    newrect = _newrect;
   }
 
   if (do_float) {
@@ -1712,34 +1805,22 @@ bool IMB_scalefastImBuf(struct ImBuf *ibuf, unsigned int newx, unsigned int newy
       }
       return false;
     }
-    newrectf = _newrectf;
   }
 
-  stepx = round(65536.0 * (ibuf->x - 1.0) / (newx - 1.0));
-  stepy = round(65536.0 * (ibuf->y - 1.0) / (newy - 1.0));
-  ofsy = 32768;
-
-  for (y = newy; y > 0; y--, ofsy += stepy) {
-    if (do_rect) {
-      rect = ibuf->rect;
-      rect += (ofsy >> 16) * ibuf->x;
-      ofsx = 32768;
-
-      for (x = newx; x > 0; x--, ofsx += stepx) {
-        *newrect++ = rect[ofsx >> 16];
-      }
-    }
-
-    if (do_float) {
-      rectf = (struct imbufRGBA *)ibuf->rect_float;
-      rectf += (ofsy >> 16) * ibuf->x;
-      ofsx = 32768;
-
-      for (x = newx; x > 0; x--, ofsx += stepx) {
-        *newrectf++ = rectf[ofsx >> 16];
-      }
-    }
-  }
+  ScaleFastThreadData data = {
+      .ibuf = ibuf,
+      .newrect = _newrect,
+      .newrectf = _newrectf,
+      .newx = newx,
+      .stepx = round(65536.0 * (ibuf->x - 1.0) / (newx - 1.0)),
+      .stepy = round(65536.0 * (ibuf->y - 1.0) / (newy - 1.0)),
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = ((size_t)newx * newy) > 64 * 64;
+  settings.min_iter_per_thread = 16;
+  BLI_task_parallel_range(0, newy, &data, scalefast_row_cb, &settings);
 
   if (do_rect) {
     imb_freerectImBuf(ibuf);
@@ -24,6 +24,7 @@
 
 #include "BLI_assert.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 
 #include "BKE_customdata.h"
 #include "BKE_lib_id.h"
@@ -454,11 +455,13 @@ static void get_vertices(struct Mesh *mesh, std::vector<Imath::V3f> &points)
   points.clear();
   points.resize(mesh->totvert);
 
-  MVert *verts = mesh->mvert;
+  const MVert *verts = mesh->mvert;
 
-  for (int i = 0, e = mesh->totvert; i < e; i++) {
-    copy_yup_from_zup(points[i].getValue(), verts[i].co);
-  }
+  threading::parallel_for(IndexRange(mesh->totvert), 4096, [&](IndexRange range) {
+    for (const int64_t i : range) {
+      copy_yup_from_zup(points[i].getValue(), verts[i].co);
+    }
+  });
 }
 
 static void get_topology(struct Mesh *mesh,
@@ -474,22 +477,35 @@ static void get_topology(struct Mesh *mesh,
 
   poly_verts.clear();
   loop_counts.clear();
-  poly_verts.reserve(num_loops);
-  loop_counts.reserve(num_poly);
+  poly_verts.resize(num_loops);
+  loop_counts.resize(num_poly);
 
-  /* NOTE: data needs to be written in the reverse order. */
+  /* The offset of every polygon in the Alembic loop order, so that the polygons can be written in
+   * parallel. This does not rely on the Blender loops being stored in polygon order. */
+  std::vector<int> poly_offsets(num_poly);
+  int offset = 0;
   for (int i = 0; i < num_poly; i++) {
-    MPoly &poly = mpoly[i];
-    loop_counts.push_back(poly.totloop);
+    const MPoly &poly = mpoly[i];
+    loop_counts[i] = poly.totloop;
+    poly_offsets[i] = offset;
+    offset += poly.totloop;
 
     r_has_flat_shaded_poly |= (poly.flag & ME_SMOOTH) == 0;
+  }
+  BLI_assert(offset == num_loops);
 
-    MLoop *loop = mloop + poly.loopstart + (poly.totloop - 1);
-
-    for (int j = 0; j < poly.totloop; j++, loop--) {
-      poly_verts.push_back(loop->v);
+  /* NOTE: data needs to be written in the reverse order. */
+  threading::parallel_for(IndexRange(num_poly), 1024, [&](IndexRange range) {
+    for (const int64_t i : range) {
+      const MPoly &poly = mpoly[i];
+      const MLoop *loop = mloop + poly.loopstart + (poly.totloop - 1);
+      int32_t *dst = &poly_verts[poly_offsets[i]];
+
+      for (int j = 0; j < poly.totloop; j++, loop--) {
+        dst[j] = loop->v;
+      }
     }
-  }
+  });
 }
 
 static void get_creases(struct Mesh *mesh,
@@ -537,15 +553,27 @@ static void get_loop_normals(struct Mesh *mesh,
 
   normals.resize(mesh->totloop);
 
+  const int num_poly = mesh->totpoly;
+  const MPoly *mpoly = mesh->mpoly;
+
+  std::vector<int> poly_offsets(num_poly);
+  int offset = 0;
+  for (int i = 0; i < num_poly; i++) {
+    poly_offsets[i] = offset;
+    offset += mpoly[i].totloop;
+  }
+
   /* NOTE: data needs to be written in the reverse order. */
-  int abc_index = 0;
-  MPoly *mp = mesh->mpoly;
-  for (int i = 0, e = mesh->totpoly; i < e; i++, mp++) {
-    for (int j = mp->totloop - 1; j >= 0; j--, abc_index++) {
-      int blender_index = mp->loopstart + j;
-      copy_yup_from_zup(normals[abc_index].getValue(), lnors[blender_index]);
+  threading::parallel_for(IndexRange(num_poly), 1024, [&](IndexRange range) {
+    for (const int64_t i : range) {
+      const MPoly &poly = mpoly[i];
+      int abc_index = poly_offsets[i];
+      for (int j = poly.totloop - 1; j >= 0; j--, abc_index++) {
+        const int blender_index = poly.loopstart + j;
+        copy_yup_from_zup(normals[abc_index].getValue(), lnors[blender_index]);
+      }
     }
-  }
+  });
 }
 
 ABCMeshWriter::ABCMeshWriter(const ABCWriterConstructorArgs &args) : ABCGenericMeshWriter(args)
@@ -36,6 +36,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math_geom.h"
 
+#include "BKE_lib_id.h"
 #include "BKE_main.h"
 #include "BKE_material.h"
 #include "BKE_mesh.h"
@@ -415,11 +416,10 @@ static void get_weight_and_index(CDStreamConfig &config,
 static void read_mesh_sample(const std::string &iobject_full_name,
                              ImportSettings *settings,
                              const IPolyMeshSchema &schema,
+                             const IPolyMeshSchema::Sample &sample,
                              const ISampleSelector &selector,
                              CDStreamConfig &config)
 {
-  const IPolyMeshSchema::Sample sample = schema.getValue(selector);
-
   AbcMeshData abc_mesh_data;
   abc_mesh_data.face_counts = sample.getFaceCounts();
   abc_mesh_data.face_indices = sample.getFaceIndices();
@@ -546,8 +546,50 @@ template<> bool has_animations(Alembic::AbcGeom::IPolyMeshSchema &schema, Import
   return false;
 }
 
+/* Full name of the object that holds the geometry of the given object. For objects that are part
+ * of an instanced hierarchy this is the corresponding object below the instance source, otherwise
+ * it is the name of the object itself. */
+static std::string instance_source_path(const IObject &iobject)
+{
+  std::string relative_path;
+  IObject object = iobject;
+
+  while (object.valid() && !object.isInstanceRoot()) {
+    if (!object.isInstanceDescendant()) {
+      return iobject.getFullName();
+    }
+    relative_path = "/" + object.getName() + relative_path;
+    object = object.getParent();
+  }
+
+  if (!object.valid()) {
+    return iobject.getFullName();
+  }
+
+  return object.instanceSourcePath() + relative_path;
+}
+
 void AbcMeshReader::readObjectData(Main *bmain, const Alembic::Abc::ISampleSelector &sample_sel)
 {
+  const std::string source_path = instance_source_path(m_iobject);
+  std::map<std::string, Mesh *>::iterator shared_mesh = m_settings->instance_meshes.find(
+      source_path);
+
+  if (shared_mesh != m_settings->instance_meshes.end()) {
+    /* The geometry was already imported for another instance of the same source, share it. */
+    Mesh *mesh = shared_mesh->second;
+
+    m_object = BKE_object_add_only_object(bmain, OB_MESH, m_object_name.c_str());
+    m_object->data = mesh;
+    id_us_plus(&mesh->id);
+    BKE_object_materials_test(bmain, m_object, &mesh->id);
+
+    if (has_animations(m_schema, m_settings)) {
+      addCacheModifier();
+    }
+    return;
+  }
+
   Mesh *mesh = BKE_mesh_add(bmain, m_data_name.c_str());
 
   m_object = BKE_object_add_only_object(bmain, OB_MESH, m_object_name.c_str());
@@ -571,6 +613,8 @@ void AbcMeshReader::readObjectData(Main *bmain, const Alembic::Abc::ISampleSelec
   if (has_animations(m_schema, m_settings)) {
     addCacheModifier();
   }
+
+  m_settings->instance_meshes[source_path] = mesh;
 }
 
 bool AbcMeshReader::accepts_object_type(
@@ -664,7 +708,9 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   ImportSettings settings;
   settings.read_flag |= read_flag;
 
-  if (topology_changed(existing_mesh, sample_sel)) {
+  /* Same test as #topology_changed, using the sample that was already read. */
+  if (positions->size() != existing_mesh->totvert || poly_count != existing_mesh->totpoly ||
+      loop_count != existing_mesh->totloop) {
     new_mesh = BKE_mesh_new_nomain_from_template(
         existing_mesh, positions->size(), 0, 0, face_indices->size(), face_counts->size());
 
@@ -692,7 +738,7 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   config.time = sample_sel.getRequestedTime();
   config.modifier_error_message = err_str;
 
-  read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
+  read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample, sample_sel, config);
 
   if (new_mesh) {
     /* Here we assume that the number of materials doesn't change, i.e. that
@@ -784,11 +830,10 @@ BLI_INLINE MEdge *find_edge(MEdge *edges, int totedge, int v1, int v2)
 static void read_subd_sample(const std::string &iobject_full_name,
                              ImportSettings *settings,
                              const ISubDSchema &schema,
+                             const ISubDSchema::Sample &sample,
                              const ISampleSelector &selector,
                              CDStreamConfig &config)
 {
-  const ISubDSchema::Sample sample = schema.getValue(selector);
-
   AbcMeshData abc_mesh_data;
   abc_mesh_data.face_counts = sample.getFaceCounts();
   abc_mesh_data.face_indices = sample.getFaceIndices();
@@ -982,7 +1027,7 @@ Mesh *AbcSubDReader::read_mesh(Mesh *existing_mesh,
   const bool use_vertex_interpolation = read_flag & MOD_MESHSEQ_INTERPOLATE_VERTICES;
   CDStreamConfig config = get_config(mesh_to_export, use_vertex_interpolation);
   config.time = sample_sel.getRequestedTime();
-  read_subd_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
+  read_subd_sample(m_iobject.getFullName(), &settings, m_schema, sample, sample_sel, config);
 
   return mesh_to_export;
 }
@@ -24,6 +24,9 @@
 
 #include "DNA_ID.h"
 
+#include <map>
+#include <string>
+
 struct CacheFile;
 struct Main;
 struct Mesh;
@@ -54,6 +57,11 @@ struct ImportSettings {
 
   CacheFile *cache_file;
 
+  /* Meshes created on import, keyed by the full name of the Alembic object they were read from.
+   * Instances in the archive resolve to the name of their source object, so all instances of the
+   * same geometry share a single mesh. */
+  std::map<std::string, struct Mesh *> instance_meshes;
+
   ImportSettings()
       : do_convert_mat(false),
         from_up(0),
@@ -111,6 +111,8 @@ struct USDMeshData {
   pxr::VtFloatArray crease_sharpnesses;
 };
 
+static void get_face_groups(const Mesh *mesh, std::map<short, pxr::VtIntArray> &r_groups);
+
 void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh)
 {
   pxr::UsdTimeCode timecode = get_export_time_code();
@@ -155,13 +157,18 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   write_visibility(context, timecode, usd_mesh);
 
   USDMeshData usd_mesh_data;
-  get_geometry_data(mesh, usd_mesh_data);
 
   if (usd_export_context_.export_params.use_instancing && context.is_instance()) {
     if (!mark_as_instance(context, usd_mesh.GetPrim())) {
       return;
     }
 
+    /* The geometry itself comes from the referenced prototype, only the face groups are needed
+     * for the material assignment below. */
+    if (usd_export_context_.export_params.export_materials) {
+      get_face_groups(mesh, usd_mesh_data.face_groups);
+    }
+
     /* The material path will be of the form </_materials/{material name}>, which is outside the
      * sub-tree pointed to by ref_path. As a result, the referenced data is not allowed to point
      * out of its own sub-tree. It does work when we override the material with exactly the same
@@ -173,6 +180,8 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
     return;
   }
 
+  get_geometry_data(mesh, usd_mesh_data);
+
   pxr::UsdAttribute attr_points = usd_mesh.CreatePointsAttr(pxr::VtValue(), true);
   pxr::UsdAttribute attr_face_vertex_counts = usd_mesh.CreateFaceVertexCountsAttr(pxr::VtValue(),
                                                                                   true);
@@ -233,38 +242,53 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   }
 }
 
+/* The arrays below are sized up front and filled through their data pointer, as
+ * `VtArray::push_back()` checks for shared storage on every call. */
+
 static void get_vertices(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
-  usd_mesh_data.points.reserve(mesh->totvert);
+  usd_mesh_data.points.resize(mesh->totvert);
+  pxr::GfVec3f *points = usd_mesh_data.points.data();
 
   const MVert *verts = mesh->mvert;
   for (int i = 0; i < mesh->totvert; ++i) {
-    usd_mesh_data.points.push_back(pxr::GfVec3f(verts[i].co));
+    points[i] = pxr::GfVec3f(verts[i].co);
   }
 }
 
-static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
+static void get_face_groups(const Mesh *mesh, std::map<short, pxr::VtIntArray> &r_groups)
 {
   /* Only construct face groups (a.k.a. geometry subsets) when we need them for material
    * assignments. */
-  bool construct_face_groups = mesh->totcol > 1;
+  if (mesh->totcol <= 1) {
+    return;
+  }
 
-  usd_mesh_data.face_vertex_counts.reserve(mesh->totpoly);
-  usd_mesh_data.face_indices.reserve(mesh->totloop);
+  const MPoly *mpoly = mesh->mpoly;
+  for (int i = 0; i < mesh->totpoly; ++i) {
+    r_groups[mpoly[i].mat_nr].push_back(i);
+  }
+}
 
-  MLoop *mloop = mesh->mloop;
-  MPoly *mpoly = mesh->mpoly;
+static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
+{
+  usd_mesh_data.face_vertex_counts.resize(mesh->totpoly);
+  usd_mesh_data.face_indices.resize(mesh->totloop);
+  int *face_vertex_counts = usd_mesh_data.face_vertex_counts.data();
+  int *face_indices = usd_mesh_data.face_indices.data();
+
+  const MLoop *mloop = mesh->mloop;
+  const MPoly *mpoly = mesh->mpoly;
+  int index = 0;
   for (int i = 0; i < mesh->totpoly; ++i, ++mpoly) {
-    MLoop *loop = mloop + mpoly->loopstart;
-    usd_mesh_data.face_vertex_counts.push_back(mpoly->totloop);
+    const MLoop *loop = mloop + mpoly->loopstart;
+    face_vertex_counts[i] = mpoly->totloop;
     for (int j = 0; j < mpoly->totloop; ++j, ++loop) {
-      usd_mesh_data.face_indices.push_back(loop->v);
-    }
-
-    if (construct_face_groups) {
-      usd_mesh_data.face_groups[mpoly->mat_nr].push_back(i);
+      face_indices[index++] = loop->v;
     }
   }
+
+  get_face_groups(mesh, usd_mesh_data.face_groups);
 }
 
 static void get_creases(const Mesh *mesh, USDMeshData &usd_mesh_data)
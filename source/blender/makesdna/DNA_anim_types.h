@@ -329,6 +329,15 @@ typedef struct DriverTarget {
   short flag;
   /** Type of ID-block that this target can use. */
   int idtype;
+
+  /**
+   * Runtime, result of resolving #rna_path when it points to a static property of the ID itself,
+   * valid for IDs of the given RNA type. Only set on evaluated copies of the drivers.
+   */
+  struct StructRNA *rna_cache_type;
+  struct PropertyRNA *rna_cache_prop;
+  int rna_cache_index;
+  char _pad1[4];
 } DriverTarget;
 
 /** Driver Target flags. */
@@ -170,6 +170,8 @@ typedef struct LightCache {
   int mips_len;
   /** Size of a visibility/reflection sample. */
   int vis_res, ref_res;
+  /** World space bounds of the changes to bake when #LIGHTCACHE_UPDATE_REGION is set. */
+  float dirty_min[3], dirty_max[3];
   char _pad[4][2];
   /* In the future, we could create a bigger texture containing
    * multiple caches (for animation) and interpolate between the
@@ -207,6 +209,8 @@ enum {
   LIGHTCACHE_INVALID = (1 << 8),
   /** The data present in the cache is valid but unusable on this GPU. */
   LIGHTCACHE_NOT_USABLE = (1 << 9),
+  /** Only update the probes whose influence intersects the dirty bounds or that changed. */
+  LIGHTCACHE_UPDATE_REGION = (1 << 10),
 };
 
 /* EEVEE_LightCacheTexture->data_type */
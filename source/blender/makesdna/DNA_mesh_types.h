@@ -105,6 +105,9 @@ typedef struct Mesh_Runtime {
   /** Non-manifold boundary data for Shrinkwrap Target Project. */
   struct ShrinkwrapBoundaryData *shrinkwrap_data;
 
+  /** Lazily built vertex/edge/face adjacency maps, defined in 'mesh_runtime.c'. */
+  struct MeshTopologyMaps *topology_maps;
+
   /** Set by modifier stack if only deformed from original. */
   char deformed_only;
   /**
@@ -177,6 +177,9 @@ typedef struct Object_Runtime {
   /** Runtime evaluated curve-specific data, not stored in the file. */
   struct CurveCache *curve_cache;
 
+  /** Copies of intermediate modifier stack results, see #mesh_calc_modifiers. */
+  struct ModifierStageCache *modifier_stage_cache;
+
   unsigned short local_collections_bits;
   short _pad2[3];
 } Object_Runtime;
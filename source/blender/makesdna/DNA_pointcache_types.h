@@ -160,6 +160,7 @@ typedef struct PointCache {
 #define PTCACHE_COMPRESS_NO 0
 #define PTCACHE_COMPRESS_LZO 1
 #define PTCACHE_COMPRESS_LZMA 2
+#define PTCACHE_COMPRESS_ZLIB_PARALLEL 3
 
 #ifdef __cplusplus
 }
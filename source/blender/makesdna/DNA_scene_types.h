@@ -1881,6 +1881,7 @@ enum {
 #define R_SCEMODE_UNUSED_19 (1 << 19) /* cleared */
 #define R_EXR_CACHE_FILE (1 << 20)
 #define R_MULTIVIEW (1 << 21)
+#define R_WRITE_ASYNC (1 << 22) /* write image sequence files while the next frame renders */
 
 /** #RenderData.stamp */
 #define R_STAMP_TIME (1 << 0)
@@ -158,6 +158,8 @@ typedef struct wmWindowManager {
 
   /** Refresh/redraw wmNotifier structs. */
   ListBase queue;
+  /** Set of the notifiers in `queue`, for fast duplicate checks (runtime only). */
+  struct GSet *notifier_queue_set;
 
   /** Information and error reports. */
   struct ReportList reports;
@@ -1253,6 +1253,24 @@ void *DNA_struct_reconstruct(const DNA_ReconstructInfo *reconstruct_info,
   return new_blocks;
 }
 
+/**
+ * Same as #DNA_struct_reconstruct, but converting into an existing buffer. Since only the given
+ * blocks are written, parts of a big array can be converted from multiple threads at once.
+ *
+ * \param new_struct_nr: Index of the struct within newsdna, see #DNA_struct_find_nr.
+ * \param new_blocks: Zero initialized buffer for \a blocks structs in newsdna format.
+ */
+void DNA_struct_reconstruct_blocks(const DNA_ReconstructInfo *reconstruct_info,
+                                   int old_struct_nr,
+                                   int new_struct_nr,
+                                   int blocks,
+                                   const void *old_blocks,
+                                   void *new_blocks)
+{
+  reconstruct_structs(
+      reconstruct_info, blocks, old_struct_nr, new_struct_nr, old_blocks, new_blocks);
+}
+
 /** Finds a member in the given struct with the given name. */
 static const SDNA_StructMember *find_member_with_matching_name(const SDNA *sdna,
                                                                const SDNA_Struct *struct_info,
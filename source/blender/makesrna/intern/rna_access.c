@@ -4542,8 +4542,33 @@ static int rna_raw_access(ReportList *reports,
         return 1;
       }
 
-      /* could also be faster with non-matching types,
-       * for now we just do slower loop .. */
+      /* Non-matching raw types, convert the elements while still accessing the raw arrays
+       * directly. A double can hold all values of the other raw types exactly. */
+      if (out.type != PROP_RAW_UNSET && in.type != PROP_RAW_UNSET) {
+        const int out_size = RNA_raw_type_sizeof(out.type);
+        RawArray item = out;
+        int a, j, in_index = 0;
+        double value;
+
+        for (a = 0; a < out.len; a++) {
+          item.array = (char *)out.array + a * out.stride;
+          BLI_assert(out_size * arraylen <= out.stride);
+
+          for (j = 0; j < arraylen; j++, in_index++) {
+            if (set) {
+              RAW_GET(double, value, in, in_index);
+              RAW_SET(double, item, j, value);
+            }
+            else {
+              RAW_GET(double, value, item, j);
+              RAW_SET(double, in, in_index, value);
+            }
+          }
+        }
+
+        UNUSED_VARS_NDEBUG(out_size);
+        return 1;
+      }
     }
   }
 
@@ -6712,6 +6737,12 @@ bool RNA_property_is_idprop(const PropertyRNA *prop)
   return (prop->magic != RNA_MAGIC);
 }
 
+/* Property defined at runtime (e.g. from Python), which may be removed later. */
+bool RNA_property_is_runtime(const PropertyRNA *prop)
+{
+  return (prop->flag_internal & PROP_INTERN_RUNTIME) != 0;
+}
+
 /* mainly for the UI */
 bool RNA_property_is_unlink(PropertyRNA *prop)
 {
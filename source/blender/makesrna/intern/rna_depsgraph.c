@@ -252,6 +252,23 @@ static void rna_Depsgraph_debug_stats_gnuplot(Depsgraph *depsgraph,
   fclose(f);
 }
 
+static void rna_Depsgraph_debug_stats_json(Depsgraph *depsgraph, const char *filename)
+{
+  FILE *f = fopen(filename, "w");
+  if (f == NULL) {
+    return;
+  }
+  DEG_debug_stats_json(depsgraph, f);
+  fclose(f);
+}
+
+static void rna_Depsgraph_debug_stats_hottest_operations(Depsgraph *depsgraph,
+                                                        int count,
+                                                        char *result)
+{
+  DEG_debug_stats_hottest_operations(depsgraph, count, result, STATS_MAX_SIZE);
+}
+
 static void rna_Depsgraph_debug_tag_update(Depsgraph *depsgraph)
 {
   DEG_graph_tag_relations_update(depsgraph);
@@ -667,6 +684,23 @@ static void rna_def_depsgraph(BlenderRNA *brna)
                                   "File name where gnuplot script will save the result");
   RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
 
+  func = RNA_def_function(srna, "debug_stats_json", "rna_Depsgraph_debug_stats_json");
+  RNA_def_function_ui_description(
+      func, "Write average evaluation time of every operation of the Dependency Graph");
+  parm = RNA_def_string_file_path(
+      func, "filename", NULL, FILE_MAX, "File Name", "Output path for the JSON file");
+  RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
+
+  func = RNA_def_function(
+      srna, "debug_stats_hottest_operations", "rna_Depsgraph_debug_stats_hottest_operations");
+  RNA_def_function_ui_description(
+      func, "Report operations with the highest average evaluation time");
+  parm = RNA_def_int(
+      func, "count", 10, 1, INT_MAX, "Count", "Number of operations to report", 1, 100);
+  parm = RNA_def_string(func, "result", NULL, STATS_MAX_SIZE, "result", "");
+  RNA_def_parameter_flags(parm, PROP_THICK_WRAP, 0); /* needed for string return value */
+  RNA_def_function_output(func, parm);
+
   func = RNA_def_function(srna, "debug_tag_update", "rna_Depsgraph_debug_tag_update");
 
   func = RNA_def_function(srna, "debug_stats", "rna_Depsgraph_debug_stats");
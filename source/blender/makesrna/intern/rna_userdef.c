@@ -282,9 +282,6 @@ static void rna_userdef_dpi_update(Main *UNUSED(bmain),
                                    Scene *UNUSED(scene),
                                    PointerRNA *UNUSED(ptr))
 {
-  /* font's are stored at each DPI level, without this we can easy load 100's of fonts */
-  BLF_cache_clear();
-
   WM_main_add_notifier(NC_WINDOW, NULL);             /* full redraw */
   WM_main_add_notifier(NC_SCREEN | NA_EDITED, NULL); /* refresh region sizes */
   USERDEF_TAG_DIRTY;
@@ -4954,6 +4951,13 @@ static void rna_def_userdef_edit(BlenderRNA *brna)
       "Global undo works by keeping a full copy of the file itself in memory, "
       "so takes extra memory");
 
+  prop = RNA_def_property(srna, "use_global_undo_spill", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "uiflag", USER_GLOBALUNDO_SPILL);
+  RNA_def_property_ui_text(prop,
+                           "Spill Undo to Disk",
+                           "When the undo memory limit is reached, compress old global undo "
+                           "steps into temporary files instead of removing them");
+
   /* auto keyframing */
   prop = RNA_def_property(srna, "use_auto_keying", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "autokey_mode", AUTOKEY_ON);
@@ -579,7 +579,7 @@ ModifierTypeInfo modifierType_Cast = {
     /* srna */ &RNA_CastModifier,
     /* type */ eModifierTypeType_OnlyDeform,
     /* flags */ eModifierTypeFlag_AcceptsCVs | eModifierTypeFlag_AcceptsVertexCosOnly |
-        eModifierTypeFlag_SupportsEditmode,
+        eModifierTypeFlag_SupportsEditmode | eModifierTypeFlag_SupportsStageCache,
     /* icon */ ICON_MOD_CAST,
 
     /* copyData */ BKE_modifier_copydata_generic,
@@ -288,7 +288,8 @@ ModifierTypeInfo modifierType_Decimate = {
     /* structSize */ sizeof(DecimateModifierData),
     /* srna */ &RNA_DecimateModifier,
     /* type */ eModifierTypeType_Nonconstructive,
-    /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_AcceptsCVs,
+    /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_AcceptsCVs |
+        eModifierTypeFlag_SupportsStageCache,
     /* icon */ ICON_MOD_DECIM,
 
     /* copyData */ BKE_modifier_copydata_generic,
@@ -495,7 +495,8 @@ ModifierTypeInfo modifierType_Displace = {
     /* structSize */ sizeof(DisplaceModifierData),
     /* srna */ &RNA_DisplaceModifier,
     /* type */ eModifierTypeType_OnlyDeform,
-    /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_SupportsEditmode,
+    /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_SupportsEditmode |
+        eModifierTypeFlag_SupportsStageCache,
     /* icon */ ICON_MOD_DISPLACE,
 
     /* copyData */ BKE_modifier_copydata_generic,
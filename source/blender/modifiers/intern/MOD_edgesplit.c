@@ -172,7 +172,7 @@ ModifierTypeInfo modifierType_EdgeSplit = {
     /* type */ eModifierTypeType_Constructive,
     /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_AcceptsCVs |
         eModifierTypeFlag_SupportsMapping | eModifierTypeFlag_SupportsEditmode |
-        eModifierTypeFlag_EnableInEditmode,
+        eModifierTypeFlag_EnableInEditmode | eModifierTypeFlag_SupportsStageCache,
     /* icon */ ICON_MOD_EDGESPLIT,
 
     /* copyData */ BKE_modifier_copydata_generic,
@@ -623,7 +623,8 @@ ModifierTypeInfo modifierType_LaplacianSmooth = {
     /* structSize */ sizeof(LaplacianSmoothModifierData),
     /* srna */ &RNA_LaplacianSmoothModifier,
     /* type */ eModifierTypeType_OnlyDeform,
-    /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_SupportsEditmode,
+    /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_SupportsEditmode |
+        eModifierTypeFlag_SupportsStageCache,
     /* icon */ ICON_MOD_SMOOTH,
 
     /* copyData */ BKE_modifier_copydata_generic,
@@ -18,10 +18,17 @@
  * \ingroup modifiers
  */
 
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
 #include "BLI_utildefines.h"
 
+#include "BLI_endian_switch.h"
 #include "BLI_math.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "DNA_modifier_types.h"
 
 #include "MOD_meshcache_util.h"
@@ -62,3 +69,46 @@ void MOD_meshcache_calc_range(const float frame,
     }
   }
 }
+
+/**
+ * Read the coordinates of one frame at the current position of \a fp with a single read,
+ * blending them into \a vertexCos when \a factor is below one.
+ */
+bool MOD_meshcache_read_frame_coords(FILE *fp,
+                                     float (*vertexCos)[3],
+                                     const int verts_tot,
+                                     const float factor,
+                                     const bool use_endian_switch,
+                                     const char **err_str)
+{
+  float(*frame_cos)[3] = vertexCos;
+  if (factor < 1.0f) {
+    frame_cos = MEM_malloc_arrayN(verts_tot, sizeof(*frame_cos), __func__);
+  }
+
+  if (fread(frame_cos, sizeof(*frame_cos), verts_tot, fp) != (size_t)verts_tot) {
+    *err_str = errno ? strerror(errno) : "Failed to read frame";
+    if (frame_cos != vertexCos) {
+      MEM_freeN(frame_cos);
+    }
+    return false;
+  }
+
+  if (use_endian_switch) {
+    BLI_endian_switch_float_array(frame_cos[0], verts_tot * 3);
+  }
+
+  if (frame_cos != vertexCos) {
+    const float ifactor = 1.0f - factor;
+    for (int i = 0; i < verts_tot; i++) {
+      float *vco = vertexCos[i];
+      const float *tvec = frame_cos[i];
+      vco[0] = (vco[0] * ifactor) + (tvec[0] * factor);
+      vco[1] = (vco[1] * ifactor) + (tvec[1] * factor);
+      vco[2] = (vco[2] * ifactor) + (tvec[2] * factor);
+    }
+    MEM_freeN(frame_cos);
+  }
+
+  return true;
+}
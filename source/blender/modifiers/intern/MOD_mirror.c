@@ -223,7 +223,7 @@ ModifierTypeInfo modifierType_Mirror = {
         eModifierTypeFlag_SupportsEditmode | eModifierTypeFlag_EnableInEditmode |
         eModifierTypeFlag_AcceptsCVs |
         /* this is only the case when 'MOD_MIR_VGROUP' is used */
-        eModifierTypeFlag_UsesPreview,
+        eModifierTypeFlag_UsesPreview | eModifierTypeFlag_SupportsStageCache,
     /* icon */ ICON_MOD_MIRROR,
 
     /* copyData */ BKE_modifier_copydata_generic,
@@ -289,7 +289,7 @@ ModifierTypeInfo modifierType_Remesh = {
     /* srna */ &RNA_RemeshModifier,
     /* type */ eModifierTypeType_Nonconstructive,
     /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_AcceptsCVs |
-        eModifierTypeFlag_SupportsEditmode,
+        eModifierTypeFlag_SupportsEditmode | eModifierTypeFlag_SupportsStageCache,
     /* icon */ ICON_MOD_REMESH,
 
     /* copyData */ BKE_modifier_copydata_generic,
@@ -541,7 +541,7 @@ ModifierTypeInfo modifierType_SimpleDeform = {
 
     /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_AcceptsCVs |
         eModifierTypeFlag_AcceptsVertexCosOnly | eModifierTypeFlag_SupportsEditmode |
-        eModifierTypeFlag_EnableInEditmode,
+        eModifierTypeFlag_EnableInEditmode | eModifierTypeFlag_SupportsStageCache,
     /* icon */ ICON_MOD_SIMPLEDEFORM,
 
     /* copyData */ BKE_modifier_copydata_generic,
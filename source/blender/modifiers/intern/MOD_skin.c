@@ -2032,7 +2032,8 @@ ModifierTypeInfo modifierType_Skin = {
     /* structSize */ sizeof(SkinModifierData),
     /* srna */ &RNA_SkinModifier,
     /* type */ eModifierTypeType_Constructive,
-    /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_SupportsEditmode,
+    /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_SupportsEditmode |
+        eModifierTypeFlag_SupportsStageCache,
     /* icon */ ICON_MOD_SKIN,
 
     /* copyData */ BKE_modifier_copydata_generic,
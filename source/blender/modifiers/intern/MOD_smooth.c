@@ -21,8 +21,6 @@
  * \ingroup modifiers
  */
 
-#include "MEM_guardedalloc.h"
-
 #include "BLI_utildefines.h"
 
 #include "BLI_math.h"
@@ -43,6 +41,8 @@
 #include "BKE_particle.h"
 #include "BKE_screen.h"
 
+#include "DEG_depsgraph_query.h"
+
 #include "UI_interface.h"
 #include "UI_resources.h"
 
@@ -89,27 +89,23 @@ static void requiredDataMask(Object *UNUSED(ob),
   }
 }
 
-static void smoothModifier_do(
-    SmoothModifierData *smd, Object *ob, Mesh *mesh, float (*vertexCos)[3], int numVerts)
+static void smoothModifier_do(SmoothModifierData *smd,
+                              const ModifierEvalContext *ctx,
+                              Mesh *mesh,
+                              float (*vertexCos)[3],
+                              int numVerts)
 {
   if (mesh == NULL) {
     return;
   }
 
-  float(*accumulated_vecs)[3] = MEM_calloc_arrayN(
-      (size_t)numVerts, sizeof(*accumulated_vecs), __func__);
-  if (!accumulated_vecs) {
-    return;
-  }
+  Object *ob = ctx->object;
 
-  uint *num_accumulated_vecs = MEM_calloc_arrayN(
-      (size_t)numVerts, sizeof(*num_accumulated_vecs), __func__);
-  if (!num_accumulated_vecs) {
-    if (accumulated_vecs) {
-      MEM_freeN(accumulated_vecs);
-    }
-    return;
-  }
+  /* Temporary arrays, reset by the depsgraph. */
+  float(*accumulated_vecs)[3] = DEG_scratch_alloc(ctx->depsgraph,
+                                                  sizeof(*accumulated_vecs) * (size_t)numVerts);
+  uint *num_accumulated_vecs = DEG_scratch_alloc(ctx->depsgraph,
+                                                 sizeof(*num_accumulated_vecs) * (size_t)numVerts);
 
   const float fac_new = smd->fac;
   const float fac_orig = 1.0f - fac_new;
@@ -123,10 +119,8 @@ static void smoothModifier_do(
   MOD_get_vgroup(ob, mesh, smd->defgrp_name, &dvert, &defgrp_index);
 
   for (int j = 0; j < smd->repeat; j++) {
-    if (j != 0) {
-      memset(accumulated_vecs, 0, sizeof(*accumulated_vecs) * (size_t)numVerts);
-      memset(num_accumulated_vecs, 0, sizeof(*num_accumulated_vecs) * (size_t)numVerts);
-    }
+    memset(accumulated_vecs, 0, sizeof(*accumulated_vecs) * (size_t)numVerts);
+    memset(num_accumulated_vecs, 0, sizeof(*num_accumulated_vecs) * (size_t)numVerts);
 
     for (int i = 0; i < num_edges; i++) {
       float fvec[3];
@@ -192,8 +186,6 @@ static void smoothModifier_do(
     }
   }
 
-  MEM_freeN(accumulated_vecs);
-  MEM_freeN(num_accumulated_vecs);
 }
 
 static void deformVerts(ModifierData *md,
@@ -208,7 +200,7 @@ static void deformVerts(ModifierData *md,
   /* mesh_src is needed for vgroups, and taking edges into account. */
   mesh_src = MOD_deform_mesh_eval_get(ctx->object, NULL, mesh, NULL, numVerts, false, false);
 
-  smoothModifier_do(smd, ctx->object, mesh_src, vertexCos, numVerts);
+  smoothModifier_do(smd, ctx, mesh_src, vertexCos, numVerts);
 
   if (!ELEM(mesh_src, NULL, mesh)) {
     BKE_id_free(NULL, mesh_src);
@@ -231,7 +223,7 @@ static void deformVertsEM(ModifierData *md,
   /* TODO(campbell): use edit-mode data only (remove this line). */
   BKE_mesh_wrapper_ensure_mdata(mesh_src);
 
-  smoothModifier_do(smd, ctx->object, mesh_src, vertexCos, numVerts);
+  smoothModifier_do(smd, ctx, mesh_src, vertexCos, numVerts);
 
   if (!ELEM(mesh_src, NULL, mesh)) {
     BKE_id_free(NULL, mesh_src);
@@ -275,7 +267,7 @@ ModifierTypeInfo modifierType_Smooth = {
     /* srna */ &RNA_SmoothModifier,
     /* type */ eModifierTypeType_OnlyDeform,
     /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_AcceptsCVs |
-        eModifierTypeFlag_SupportsEditmode,
+        eModifierTypeFlag_SupportsEditmode | eModifierTypeFlag_SupportsStageCache,
     /* icon */ ICON_MOD_SMOOTH,
 
     /* copyData */ BKE_modifier_copydata_generic,
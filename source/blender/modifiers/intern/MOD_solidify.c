@@ -263,7 +263,7 @@ ModifierTypeInfo modifierType_Solidify = {
 
     /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_AcceptsCVs |
         eModifierTypeFlag_SupportsMapping | eModifierTypeFlag_SupportsEditmode |
-        eModifierTypeFlag_EnableInEditmode,
+        eModifierTypeFlag_EnableInEditmode | eModifierTypeFlag_SupportsStageCache,
     /* icon */ ICON_MOD_SOLIDIFY,
 
     /* copyData */ BKE_modifier_copydata_generic,
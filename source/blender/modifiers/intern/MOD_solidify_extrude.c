@@ -395,28 +395,32 @@ Mesh *MOD_solidify_extrude_modifyMesh(ModifierData *md, const ModifierEvalContex
   }
   else {
     int i, j;
+    /* Indices of the copied elements, so their data is copied in one go. */
+    int *src_indices = MEM_malloc_arrayN(MAX2(numVerts, numEdges), sizeof(*src_indices), __func__);
+
     CustomData_copy_data(&mesh->vdata, &result->vdata, 0, 0, (int)numVerts);
-    for (i = 0, j = (int)numVerts; i < numVerts; i++) {
+    for (i = 0, j = 0; i < numVerts; i++) {
       if (old_vert_arr[i] != INVALID_UNUSED) {
-        CustomData_copy_data(&mesh->vdata, &result->vdata, i, j, 1);
-        j++;
+        src_indices[j++] = i;
       }
     }
+    CustomData_copy_data_indices(&mesh->vdata, &result->vdata, src_indices, (int)numVerts, j);
 
     CustomData_copy_data(&mesh->edata, &result->edata, 0, 0, (int)numEdges);
-
-    for (i = 0, j = (int)numEdges; i < numEdges; i++) {
+    for (i = 0, j = 0; i < numEdges; i++) {
       if (!ELEM(edge_users[i], INVALID_UNUSED, INVALID_PAIR)) {
-        MEdge *ed_src, *ed_dst;
-        CustomData_copy_data(&mesh->edata, &result->edata, i, j, 1);
-
-        ed_src = &medge[i];
-        ed_dst = &medge[j];
-        ed_dst->v1 = old_vert_arr[ed_src->v1] + numVerts;
-        ed_dst->v2 = old_vert_arr[ed_src->v2] + numVerts;
-        j++;
+        src_indices[j++] = i;
       }
     }
+    CustomData_copy_data_indices(&mesh->edata, &result->edata, src_indices, (int)numEdges, j);
+    for (i = 0; i < j; i++) {
+      const MEdge *ed_src = &medge[src_indices[i]];
+      MEdge *ed_dst = &medge[numEdges + (uint)i];
+      ed_dst->v1 = old_vert_arr[ed_src->v1] + numVerts;
+      ed_dst->v2 = old_vert_arr[ed_src->v2] + numVerts;
+    }
+
+    MEM_freeN(src_indices);
 
     /* will be created later */
     CustomData_copy_data(&mesh->ldata, &result->ldata, 0, 0, (int)numLoops);
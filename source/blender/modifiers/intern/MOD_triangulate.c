@@ -160,7 +160,7 @@ ModifierTypeInfo modifierType_Triangulate = {
     /* type */ eModifierTypeType_Constructive,
     /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_SupportsEditmode |
         eModifierTypeFlag_SupportsMapping | eModifierTypeFlag_EnableInEditmode |
-        eModifierTypeFlag_AcceptsCVs,
+        eModifierTypeFlag_AcceptsCVs | eModifierTypeFlag_SupportsStageCache,
     /* icon */ ICON_MOD_TRIANGULATE,
 
     /* copyData */ BKE_modifier_copydata_generic,
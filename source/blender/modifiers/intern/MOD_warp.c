@@ -39,6 +39,7 @@
 #include "BKE_context.h"
 #include "BKE_deform.h"
 #include "BKE_editmesh.h"
+#include "BKE_image.h"
 #include "BKE_lib_id.h"
 #include "BKE_lib_query.h"
 #include "BKE_mesh.h"
@@ -212,6 +213,7 @@ static void warpModifier_do(WarpModifierData *wmd,
   MDeformVert *dvert, *dv = NULL;
   const bool invert_vgroup = (wmd->flag & MOD_WARP_INVERT_VGROUP) != 0;
   float(*tex_co)[3] = NULL;
+  struct ImagePool *pool = NULL;
 
   if (!(wmd->object_from && wmd->object_to)) {
     return;
@@ -260,6 +262,10 @@ static void warpModifier_do(WarpModifierData *wmd,
     MOD_get_texture_coords((MappingInfoModifierData *)wmd, ctx, ob, mesh, vertexCos, tex_co);
 
     MOD_init_texture((MappingInfoModifierData *)wmd, ctx);
+
+    /* Acquire images once, instead of locking them for every vertex. */
+    pool = BKE_image_pool_new();
+    BKE_texture_fetch_images_for_pool(tex_target, pool);
   }
 
   for (i = 0; i < numVerts; i++) {
@@ -316,7 +322,7 @@ static void warpModifier_do(WarpModifierData *wmd,
         struct Scene *scene = DEG_get_evaluated_scene(ctx->depsgraph);
         TexResult texres;
         texres.nor = NULL;
-        BKE_texture_get_value(scene, tex_target, tex_co[i], &texres, false);
+        BKE_texture_get_value_ex(scene, tex_target, tex_co[i], &texres, pool, false);
         fac *= texres.tin;
       }
 
@@ -346,6 +352,9 @@ static void warpModifier_do(WarpModifierData *wmd,
     }
   }
 
+  if (pool != NULL) {
+    BKE_image_pool_free(pool);
+  }
   if (tex_co) {
     MEM_freeN(tex_co);
   }
@@ -37,6 +37,7 @@
 #include "BKE_context.h"
 #include "BKE_deform.h"
 #include "BKE_editmesh.h"
+#include "BKE_image.h"
 #include "BKE_lib_id.h"
 #include "BKE_lib_query.h"
 #include "BKE_mesh.h"
@@ -156,6 +157,7 @@ static void waveModifier_do(WaveModifierData *md,
   float minfac = (float)(1.0 / exp(wmd->width * wmd->narrow * wmd->width * wmd->narrow));
   float lifefac = wmd->height;
   float(*tex_co)[3] = NULL;
+  struct ImagePool *pool = NULL;
   const int wmd_axis = wmd->flag & (MOD_WAVE_X | MOD_WAVE_Y);
   const float falloff = wmd->falloff;
   float falloff_fac = 1.0f; /* when falloff == 0.0f this stays at 1.0f */
@@ -203,6 +205,10 @@ static void waveModifier_do(WaveModifierData *md,
     MOD_get_texture_coords((MappingInfoModifierData *)wmd, ctx, ob, mesh, vertexCos, tex_co);
 
     MOD_init_texture((MappingInfoModifierData *)wmd, ctx);
+
+    /* Acquire images once, instead of locking them for every vertex. */
+    pool = BKE_image_pool_new();
+    BKE_texture_fetch_images_for_pool(tex_target, pool);
   }
 
   if (lifefac != 0.0f) {
@@ -276,7 +282,7 @@ static void waveModifier_do(WaveModifierData *md,
           Scene *scene = DEG_get_evaluated_scene(ctx->depsgraph);
           TexResult texres;
           texres.nor = NULL;
-          BKE_texture_get_value(scene, tex_target, tex_co[i], &texres, false);
+          BKE_texture_get_value_ex(scene, tex_target, tex_co[i], &texres, pool, false);
           amplit *= texres.tin;
         }
 
@@ -303,6 +309,9 @@ static void waveModifier_do(WaveModifierData *md,
     }
   }
 
+  if (pool != NULL) {
+    BKE_image_pool_free(pool);
+  }
   MEM_SAFE_FREE(tex_co);
 }
 
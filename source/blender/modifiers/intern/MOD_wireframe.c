@@ -184,7 +184,8 @@ ModifierTypeInfo modifierType_Wireframe = {
     /* structSize */ sizeof(WireframeModifierData),
     /* srna */ &RNA_WireframeModifier,
     /* type */ eModifierTypeType_Constructive,
-    /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_SupportsEditmode,
+    /* flags */ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_SupportsEditmode |
+        eModifierTypeFlag_SupportsStageCache,
     /* icon */ ICON_MOD_WIREFRAME,
 
     /* copyData */ BKE_modifier_copydata_generic,
@@ -166,7 +166,7 @@ class DParentNode : NonCopyable, NonMovable {
   int id() const;
 };
 
-using NodeTreeRefMap = Map<bNodeTree *, std::unique_ptr<const NodeTreeRef>>;
+using NodeTreeRefMap = Map<bNodeTree *, std::unique_ptr<NodeTreeRef>>;
 
 class DerivedNodeTree : NonCopyable, NonMovable {
  private:
@@ -229,6 +229,42 @@ class DerivedNodeTree : NonCopyable, NonMovable {
                                   Vector<DParentNode *> &&all_parent_nodes);
 };
 
+void find_used_node_trees(bNodeTree *btree, Vector<bNodeTree *> &r_used_trees);
+
+/**
+ * Keeps derived node trees and the node tree refs they are built from alive between evaluations,
+ * so that node groups don't have to be inlined again every time.
+ *
+ * Before a cached tree is returned, the topology of the tree and of all node groups it uses is
+ * compared with the topology it was built from. A node tree ref is rebuilt when nodes or sockets
+ * changed. When only links changed, the existing node tree ref is updated in place. A derived
+ * tree is rebuilt when any of the trees it uses changed.
+ */
+class DerivedNodeTreeCache : NonCopyable, NonMovable {
+ private:
+  struct TreeTopology {
+    uint64_t nodes_hash;
+    uint64_t links_hash;
+  };
+
+  struct CachedDerivedTree {
+    std::unique_ptr<DerivedNodeTree> tree;
+    Vector<bNodeTree *> used_trees;
+  };
+
+  NodeTreeRefMap node_tree_refs_;
+  Map<bNodeTree *, TreeTopology> topology_by_tree_;
+  Map<bNodeTree *, CachedDerivedTree> derived_trees_;
+
+ public:
+  const DerivedNodeTree &get(bNodeTree *btree);
+  void clear();
+
+ private:
+  void update_tree(bNodeTree *btree);
+  void remove_derived_trees_using(bNodeTree *btree);
+};
+
 /* --------------------------------------------------------------------
  * DSocket inline methods.
  */
@@ -29,6 +29,9 @@
 
 #include "BLI_resource_collector.hh"
 
+#include <functional>
+#include <memory>
+
 namespace blender::nodes {
 
 /* Maybe this should be moved to BKE_node.h. */
@@ -397,4 +400,46 @@ MFNetworkTreeMap insert_node_tree_into_mf_network(fn::MFNetwork &network,
                                                   const DerivedNodeTree &tree,
                                                   ResourceCollector &resources);
 
+/**
+ * A multi-function network that has been generated from a node tree, together with everything it
+ * references. Instances are immutable once they have been built and can be shared between
+ * threads and between all users of the same node tree.
+ */
+struct NodeTreeMFNetwork : NonCopyable, NonMovable {
+  NodeTreeRefMap tree_refs;
+  std::unique_ptr<DerivedNodeTree> tree;
+  ResourceCollector resources;
+  fn::MFNetwork network;
+  std::unique_ptr<MFNetworkTreeMap> network_map;
+};
+
+/**
+ * Is called after the node tree has been inserted into the network. This is where callers add
+ * their dummy nodes for the outputs they are interested in and run optimization passes.
+ */
+using NodeTreeMFNetworkBuildFn = std::function<void(NodeTreeMFNetwork &network)>;
+
+/**
+ * Returns the multi-function network for the given node tree, building it only when no network
+ * has been built for the current state of the tree yet. Every piece of data that ends up in the
+ * network (nodes, their settings, socket types and default values, links) is hashed, including
+ * that of all node groups used by the tree. Changing anything invalidates the cached network.
+ *
+ * The #build_key has to identify what #build_fn does, so that different callers building
+ * different networks for the same tree don't share results.
+ *
+ * Up to #node_tree_mf_network_cache_size networks are kept alive. The least recently used one is
+ * freed first. The returned pointer keeps the network alive even when it has been evicted.
+ */
+std::shared_ptr<const NodeTreeMFNetwork> get_cached_node_tree_mf_network(
+    bNodeTree *btree, uint64_t build_key, const NodeTreeMFNetworkBuildFn &build_fn);
+
+/**
+ * Frees all cached networks that are not in use anymore. Should be called on exit, before leaks of
+ * guarded allocations are reported.
+ */
+void free_node_tree_mf_network_cache();
+
+constexpr int node_tree_mf_network_cache_size = 64;
+
 }  // namespace blender::nodes
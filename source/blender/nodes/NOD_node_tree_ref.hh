@@ -178,10 +178,13 @@ class NodeTreeRef : NonCopyable, NonMovable {
 
   bNodeTree *btree() const;
 
+  void update_links();
+
   std::string to_dot() const;
 
  private:
   /* Utility functions used during construction. */
+  void init_links();
   InputSocketRef &find_input_socket(Map<bNode *, NodeRef *> &node_mapping,
                                     bNode *bnode,
                                     bNodeSocket *bsocket);
@@ -65,6 +65,25 @@ static void fn_node_switch_update(bNodeTree *UNUSED(ntree), bNode *node)
   }
 }
 
+static void fn_node_switch_expand_in_mf_network(blender::nodes::NodeMFNetworkBuilder &builder)
+{
+  /* The only available output has the type that is selected in the node. */
+  const bNodeSocket *output = nullptr;
+  LISTBASE_FOREACH (const bNodeSocket *, sock, &builder.bnode().outputs) {
+    if (sock->type == builder.bnode().custom1) {
+      output = sock;
+      break;
+    }
+  }
+  if (output == nullptr || !blender::nodes::is_multi_function_data_socket(output)) {
+    builder.set_not_implemented();
+    return;
+  }
+  const blender::fn::MFDataType data_type = output->typeinfo->get_mf_data_type();
+  builder.construct_and_set_matching_fn<blender::fn::CustomMF_GenericSwitch>(
+      data_type.single_type());
+}
+
 void register_node_type_fn_switch()
 {
   static bNodeType ntype;
@@ -72,5 +91,6 @@ void register_node_type_fn_switch()
   fn_node_type_base(&ntype, FN_NODE_SWITCH, "Switch", 0, 0);
   node_type_socket_templates(&ntype, fn_node_switch_in, fn_node_switch_out);
   node_type_update(&ntype, fn_node_switch_update);
+  ntype.expand_in_mf_network = fn_node_switch_expand_in_mf_network;
   nodeRegisterType(&ntype);
 }
@@ -17,6 +17,7 @@
 #include "NOD_derived_node_tree.hh"
 
 #include "BLI_dot_export.hh"
+#include "BLI_ghash.h"
 
 #define UNINITIALIZED_ID UINT32_MAX
 
@@ -375,6 +376,132 @@ static dot::Cluster *get_cluster_for_parent(dot::DirectedGraph &graph,
   });
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Derived Node Tree Cache
+ * \{ */
+
+static uint64_t combine_hash(uint64_t hash, const void *value)
+{
+  return BLI_ghashutil_combine_hash(hash, DefaultHash<const void *>{}(value));
+}
+
+/**
+ * Everything that the structure of a #NodeTreeRef depends on, except for the links.
+ */
+static uint64_t compute_nodes_hash(bNodeTree *btree)
+{
+  uint64_t hash = 0;
+  LISTBASE_FOREACH (bNode *, bnode, &btree->nodes) {
+    hash = combine_hash(hash, bnode);
+    hash = combine_hash(hash, bnode->typeinfo);
+    hash = BLI_ghashutil_combine_hash(hash, static_cast<uint64_t>(bnode->type));
+    hash = combine_hash(hash, bnode->id);
+    LISTBASE_FOREACH (bNodeSocket *, bsocket, &bnode->inputs) {
+      hash = combine_hash(hash, bsocket);
+    }
+    LISTBASE_FOREACH (bNodeSocket *, bsocket, &bnode->outputs) {
+      hash = combine_hash(hash, bsocket);
+    }
+  }
+  return hash;
+}
+
+static uint64_t compute_links_hash(bNodeTree *btree)
+{
+  uint64_t hash = 0;
+  LISTBASE_FOREACH (bNodeLink *, blink, &btree->links) {
+    hash = combine_hash(hash, blink->fromsock);
+    hash = combine_hash(hash, blink->tosock);
+  }
+  return hash;
+}
+
+/**
+ * Collects the given node tree and all node groups it uses, recursively.
+ */
+void find_used_node_trees(bNodeTree *btree, Vector<bNodeTree *> &r_used_trees)
+{
+  if (r_used_trees.contains(btree)) {
+    return;
+  }
+  r_used_trees.append(btree);
+  LISTBASE_FOREACH (bNode *, bnode, &btree->nodes) {
+    if (bnode->type == NODE_GROUP && bnode->id != nullptr) {
+      find_used_node_trees(reinterpret_cast<bNodeTree *>(bnode->id), r_used_trees);
+    }
+  }
+}
+
+/**
+ * Returns the derived tree for the given node tree. The returned reference stays valid until the
+ * next call to #get or #clear.
+ */
+const DerivedNodeTree &DerivedNodeTreeCache::get(bNodeTree *btree)
+{
+  Vector<bNodeTree *> used_trees;
+  find_used_node_trees(btree, used_trees);
+  for (bNodeTree *used_tree : used_trees) {
+    this->update_tree(used_tree);
+  }
+
+  CachedDerivedTree &cached_tree = derived_trees_.lookup_or_add_default(btree);
+  if (!cached_tree.tree) {
+    cached_tree.tree = std::make_unique<DerivedNodeTree>(btree, node_tree_refs_);
+    cached_tree.used_trees = std::move(used_trees);
+  }
+  return *cached_tree.tree;
+}
+
+void DerivedNodeTreeCache::clear()
+{
+  /* Derived trees reference the node tree refs, so they have to be freed first. */
+  derived_trees_.clear();
+  node_tree_refs_.clear();
+  topology_by_tree_.clear();
+}
+
+/**
+ * Compares the current topology of the node tree with the cached one and invalidates everything
+ * that has been built from an outdated topology.
+ */
+void DerivedNodeTreeCache::update_tree(bNodeTree *btree)
+{
+  const TreeTopology topology{compute_nodes_hash(btree), compute_links_hash(btree)};
+  TreeTopology *cached_topology = topology_by_tree_.lookup_ptr(btree);
+  if (cached_topology == nullptr) {
+    topology_by_tree_.add_new(btree, topology);
+    return;
+  }
+
+  if (cached_topology->nodes_hash != topology.nodes_hash) {
+    this->remove_derived_trees_using(btree);
+    node_tree_refs_.remove(btree);
+  }
+  else if (cached_topology->links_hash != topology.links_hash) {
+    this->remove_derived_trees_using(btree);
+    std::unique_ptr<NodeTreeRef> *tree_ref = node_tree_refs_.lookup_ptr(btree);
+    if (tree_ref != nullptr) {
+      (*tree_ref)->update_links();
+    }
+  }
+  *cached_topology = topology;
+}
+
+void DerivedNodeTreeCache::remove_derived_trees_using(bNodeTree *btree)
+{
+  Vector<bNodeTree *> trees_to_remove;
+  for (auto item : derived_trees_.items()) {
+    if (item.value.used_trees.contains(btree)) {
+      trees_to_remove.append(item.key);
+    }
+  }
+  for (bNodeTree *tree : trees_to_remove) {
+    derived_trees_.remove(tree);
+  }
+}
+
+/** \} */
+
 std::string DerivedNodeTree::to_dot() const
 {
   dot::DirectedGraph digraph;
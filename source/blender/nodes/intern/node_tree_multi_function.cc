@@ -18,6 +18,13 @@
 
 #include "BLI_color.hh"
 #include "BLI_float3.hh"
+#include "BLI_ghash.h"
+#include "BLI_hash_mm2a.h"
+#include "BLI_listbase.h"
+
+#include "MEM_guardedalloc.h"
+
+#include <mutex>
 
 namespace blender::nodes {
 
@@ -340,4 +347,188 @@ MFNetworkTreeMap insert_node_tree_into_mf_network(fn::MFNetwork &network,
   return network_map;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Network Cache
+ * \{ */
+
+static uint64_t combine_hash(uint64_t hash, uint64_t value)
+{
+  return BLI_ghashutil_combine_hash(hash, value);
+}
+
+static uint64_t combine_pointer_hash(uint64_t hash, const void *value)
+{
+  return combine_hash(hash, DefaultHash<const void *>{}(value));
+}
+
+/**
+ * DNA data that is referenced by nodes and sockets is always allocated with guarded-alloc, so its
+ * size is known.
+ */
+static uint64_t combine_data_hash(uint64_t hash, const void *data)
+{
+  if (data == nullptr) {
+    return combine_hash(hash, 0);
+  }
+  const size_t size = MEM_allocN_len(data);
+  return combine_hash(hash, BLI_hash_mm2(static_cast<const unsigned char *>(data), size, 0));
+}
+
+static uint64_t combine_socket_hash(uint64_t hash, const bNodeSocket *bsocket)
+{
+  hash = combine_pointer_hash(hash, bsocket);
+  hash = combine_pointer_hash(hash, bsocket->typeinfo);
+  hash = combine_hash(hash, static_cast<uint64_t>(bsocket->flag & SOCK_UNAVAIL));
+  hash = combine_data_hash(hash, bsocket->default_value);
+  return hash;
+}
+
+/**
+ * Hashes everything in a node tree that can have an effect on the generated network. Unlike the
+ * topology hash used for derived trees, this also includes node settings and socket values,
+ * because those are baked into the network.
+ */
+static uint64_t compute_network_hash(bNodeTree *btree)
+{
+  uint64_t hash = 0;
+  LISTBASE_FOREACH (const bNode *, bnode, &btree->nodes) {
+    hash = combine_pointer_hash(hash, bnode);
+    hash = combine_pointer_hash(hash, bnode->typeinfo);
+    hash = combine_pointer_hash(hash, bnode->id);
+    hash = combine_hash(hash, static_cast<uint64_t>(bnode->type));
+    hash = combine_hash(hash, static_cast<uint64_t>(bnode->flag & NODE_MUTED));
+    hash = combine_hash(hash, static_cast<uint64_t>(bnode->custom1));
+    hash = combine_hash(hash, static_cast<uint64_t>(bnode->custom2));
+    hash = combine_hash(hash, DefaultHash<float>{}(bnode->custom3));
+    hash = combine_hash(hash, DefaultHash<float>{}(bnode->custom4));
+    hash = combine_data_hash(hash, bnode->storage);
+    LISTBASE_FOREACH (const bNodeSocket *, bsocket, &bnode->inputs) {
+      hash = combine_socket_hash(hash, bsocket);
+    }
+    LISTBASE_FOREACH (const bNodeSocket *, bsocket, &bnode->outputs) {
+      hash = combine_socket_hash(hash, bsocket);
+    }
+  }
+  LISTBASE_FOREACH (const bNodeLink *, blink, &btree->links) {
+    hash = combine_pointer_hash(hash, blink->fromsock);
+    hash = combine_pointer_hash(hash, blink->tosock);
+  }
+  return hash;
+}
+
+namespace {
+
+struct CachedNetwork {
+  bNodeTree *btree;
+  uint64_t build_key;
+  uint64_t network_hash;
+  std::shared_ptr<const NodeTreeMFNetwork> network;
+};
+
+/**
+ * The networks are ordered from least to most recently used. The cache is small enough for a
+ * linear search to be cheaper than anything more complex.
+ */
+struct NetworkCache {
+  std::mutex mutex;
+  Vector<CachedNetwork> networks;
+
+  /* Expects the mutex to be locked. */
+  std::shared_ptr<const NodeTreeMFNetwork> lookup(bNodeTree *btree,
+                                                  const uint64_t build_key,
+                                                  const uint64_t network_hash)
+  {
+    for (const int i : networks.index_range()) {
+      CachedNetwork &cached_network = networks[i];
+      if (cached_network.btree != btree || cached_network.build_key != build_key) {
+        continue;
+      }
+      if (cached_network.network_hash != network_hash) {
+        /* The node tree has changed since this network has been built, it will not be used
+         * again. */
+        networks.remove(i);
+        return {};
+      }
+      CachedNetwork used_network = std::move(cached_network);
+      networks.remove(i);
+      networks.append(used_network);
+      return used_network.network;
+    }
+    return {};
+  }
+
+  /* Expects the mutex to be locked. */
+  void add(CachedNetwork cached_network)
+  {
+    if (networks.size() >= node_tree_mf_network_cache_size) {
+      networks.remove(0);
+    }
+    networks.append(std::move(cached_network));
+  }
+};
+
+}  // namespace
+
+static NetworkCache &get_network_cache()
+{
+  static NetworkCache cache;
+  return cache;
+}
+
+static std::unique_ptr<NodeTreeMFNetwork> build_node_tree_mf_network(
+    bNodeTree *btree, const NodeTreeMFNetworkBuildFn &build_fn)
+{
+  std::unique_ptr<NodeTreeMFNetwork> network = std::make_unique<NodeTreeMFNetwork>();
+  network->tree = std::make_unique<DerivedNodeTree>(btree, network->tree_refs);
+  network->network_map = std::make_unique<MFNetworkTreeMap>(insert_node_tree_into_mf_network(
+      network->network, *network->tree, network->resources));
+  build_fn(*network);
+  return network;
+}
+
+std::shared_ptr<const NodeTreeMFNetwork> get_cached_node_tree_mf_network(
+    bNodeTree *btree, const uint64_t build_key, const NodeTreeMFNetworkBuildFn &build_fn)
+{
+  Vector<bNodeTree *> used_trees;
+  find_used_node_trees(btree, used_trees);
+  uint64_t network_hash = 0;
+  for (bNodeTree *used_tree : used_trees) {
+    network_hash = combine_pointer_hash(network_hash, used_tree);
+    network_hash = combine_hash(network_hash, compute_network_hash(used_tree));
+  }
+
+  NetworkCache &cache = get_network_cache();
+  {
+    std::lock_guard<std::mutex> lock{cache.mutex};
+    std::shared_ptr<const NodeTreeMFNetwork> network = cache.lookup(
+        btree, build_key, network_hash);
+    if (network) {
+      return network;
+    }
+  }
+
+  /* Build without holding the lock, so that networks for different trees can be built in
+   * parallel. When two threads build the same network at the same time, the one that finishes
+   * first wins. */
+  std::shared_ptr<const NodeTreeMFNetwork> new_network = build_node_tree_mf_network(btree,
+                                                                                    build_fn);
+
+  std::lock_guard<std::mutex> lock{cache.mutex};
+  std::shared_ptr<const NodeTreeMFNetwork> network = cache.lookup(btree, build_key, network_hash);
+  if (network) {
+    return network;
+  }
+  cache.add({btree, build_key, network_hash, new_network});
+  return new_network;
+}
+
+void free_node_tree_mf_network_cache()
+{
+  NetworkCache &cache = get_network_cache();
+  std::lock_guard<std::mutex> lock{cache.mutex};
+  cache.networks.clear();
+}
+
+/** \} */
+
 }  // namespace blender::nodes
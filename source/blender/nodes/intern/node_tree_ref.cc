@@ -22,8 +22,6 @@ namespace blender::nodes {
 
 NodeTreeRef::NodeTreeRef(bNodeTree *btree) : btree_(btree)
 {
-  Map<bNode *, NodeRef *> node_mapping;
-
   LISTBASE_FOREACH (bNode *, bnode, &btree->nodes) {
     NodeRef &node = *allocator_.construct<NodeRef>();
 
@@ -54,11 +52,37 @@ NodeTreeRef::NodeTreeRef(bNodeTree *btree) : btree_(btree)
 
     input_sockets_.extend(node.inputs_.as_span());
     output_sockets_.extend(node.outputs_.as_span());
+  }
 
-    node_mapping.add_new(bnode, &node);
+  this->init_links();
+
+  for (NodeRef *node : nodes_by_id_) {
+    const bNodeType *nodetype = node->bnode_->typeinfo;
+    nodes_by_type_.add(nodetype, node);
   }
+}
 
-  LISTBASE_FOREACH (bNodeLink *, blink, &btree->links) {
+/**
+ * Updates the links after links in the original tree have been added or removed. The nodes and
+ * sockets of the tree have to be unchanged, otherwise a new #NodeTreeRef has to be built.
+ */
+void NodeTreeRef::update_links()
+{
+  for (SocketRef *socket : sockets_by_id_) {
+    socket->directly_linked_sockets_.clear();
+    socket->linked_sockets_.clear();
+  }
+  this->init_links();
+}
+
+void NodeTreeRef::init_links()
+{
+  Map<bNode *, NodeRef *> node_mapping;
+  for (NodeRef *node : nodes_by_id_) {
+    node_mapping.add_new(node->bnode_, node);
+  }
+
+  LISTBASE_FOREACH (bNodeLink *, blink, &btree_->links) {
     OutputSocketRef &from_socket = this->find_output_socket(
         node_mapping, blink->fromnode, blink->fromsock);
     InputSocketRef &to_socket = this->find_input_socket(
@@ -76,11 +100,6 @@ NodeTreeRef::NodeTreeRef(bNodeTree *btree) : btree_(btree)
       }
     }
   }
-
-  for (NodeRef *node : nodes_by_id_) {
-    const bNodeType *nodetype = node->bnode_->typeinfo;
-    nodes_by_type_.add(nodetype, node);
-  }
 }
 
 NodeTreeRef::~NodeTreeRef()
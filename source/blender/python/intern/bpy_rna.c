@@ -5235,6 +5235,44 @@ static bool foreach_compat_buffer(RawPropertyType raw_type, int attr_signed, con
   return 0;
 }
 
+/**
+ * Raw type of a buffer that doesn't match the property type, RNA converts the values while
+ * accessing the raw arrays directly. Only formats that read back the same values as the
+ * corresponding C type are supported, others fall back to the Python sequence.
+ */
+static RawPropertyType foreach_buffer_raw_type(const Py_buffer *buf, const int tot)
+{
+  const char f = buf->format ? *buf->format : 'B'; /* B is assumed when not set */
+  RawPropertyType raw_type;
+
+  switch (f) {
+    case 'h':
+      raw_type = PROP_RAW_SHORT;
+      break;
+    case 'i':
+      raw_type = PROP_RAW_INT;
+      break;
+    case '?':
+      raw_type = PROP_RAW_BOOLEAN;
+      break;
+    case 'f':
+      raw_type = PROP_RAW_FLOAT;
+      break;
+    case 'd':
+      raw_type = PROP_RAW_DOUBLE;
+      break;
+    default:
+      return PROP_RAW_UNSET;
+  }
+
+  if (buf->itemsize != RNA_raw_type_sizeof(raw_type) ||
+      buf->len != (Py_ssize_t)tot * buf->itemsize) {
+    return PROP_RAW_UNSET;
+  }
+
+  return raw_type;
+}
+
 static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
 {
   PyObject *item = NULL;
@@ -5272,6 +5310,14 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
         ok = RNA_property_collection_raw_set(
             NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
       }
+      else {
+        const RawPropertyType buf_raw_type = foreach_buffer_raw_type(&buf, tot);
+        if (buf_raw_type != PROP_RAW_UNSET) {
+          buffer_is_compat = true;
+          ok = RNA_property_collection_raw_set(
+              NULL, &self->ptr, self->prop, attr, buf.buf, buf_raw_type, tot);
+        }
+      }
 
       PyBuffer_Release(&buf);
     }
@@ -5328,6 +5374,14 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
         ok = RNA_property_collection_raw_get(
             NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
       }
+      else {
+        const RawPropertyType buf_raw_type = foreach_buffer_raw_type(&buf, tot);
+        if (buf_raw_type != PROP_RAW_UNSET) {
+          buffer_is_compat = true;
+          ok = RNA_property_collection_raw_get(
+              NULL, &self->ptr, self->prop, attr, buf.buf, buf_raw_type, tot);
+        }
+      }
 
       PyBuffer_Release(&buf);
     }
@@ -72,6 +72,8 @@ extern "C" {
 #define RE_ENGINE_DO_UPDATE 8
 #define RE_ENGINE_RENDERING 16
 #define RE_ENGINE_HIGHLIGHT_TILES 32
+/* Depsgraph kept from the previous frame, only IDs tagged for update changed since. */
+#define RE_ENGINE_DEPSGRAPH_REUSED 64
 
 extern ListBase R_engines;
 
@@ -240,6 +242,7 @@ void RE_bake_engine_set_engine_parameters(struct Render *re,
                                           struct Scene *scene);
 
 void RE_engine_free_blender_memory(struct RenderEngine *engine);
+void RE_engine_free_persistent_depsgraph(struct RenderEngine *engine);
 
 #ifdef __cplusplus
 }
@@ -150,6 +150,11 @@ void RE_engine_free(RenderEngine *engine)
 
   BLI_mutex_end(&engine->update_render_passes_mutex);
 
+  /* Kept between the frames of an animation with persistent data. */
+  if (engine->depsgraph) {
+    DEG_graph_free(engine->depsgraph);
+  }
+
   MEM_freeN(engine);
 }
 
@@ -599,13 +604,45 @@ RenderData *RE_engine_get_render_data(Render *re)
 }
 
 /* Depsgraph */
+
+/* With persistent data the depsgraph is kept between the frames of an animation, so that the
+ * engine only has to update what changed since the previous frame. */
+static bool engine_keep_depsgraph(RenderEngine *engine)
+{
+  Render *re = engine->re;
+  return (re->r.mode & R_PERSISTENT_DATA) && (re->flag & R_ANIMATION) &&
+         !(re->r.scemode & R_BUTS_PREVIEW);
+}
+
+static void engine_depsgraph_free(RenderEngine *engine)
+{
+  DEG_graph_free(engine->depsgraph);
+
+  engine->depsgraph = NULL;
+}
+
 static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
 {
   Main *bmain = engine->re->main;
   Scene *scene = engine->re->scene;
 
-  engine->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
-  DEG_debug_name_set(engine->depsgraph, "RENDER");
+  engine->flag &= ~RE_ENGINE_DEPSGRAPH_REUSED;
+
+  if (engine->depsgraph) {
+    if (DEG_get_bmain(engine->depsgraph) == bmain &&
+        DEG_get_input_scene(engine->depsgraph) == scene &&
+        DEG_get_input_view_layer(engine->depsgraph) == view_layer) {
+      engine->flag |= RE_ENGINE_DEPSGRAPH_REUSED;
+    }
+    else {
+      engine_depsgraph_free(engine);
+    }
+  }
+
+  if (engine->depsgraph == NULL) {
+    engine->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
+    DEG_debug_name_set(engine->depsgraph, "RENDER");
+  }
 
   if (engine->re->r.scemode & R_BUTS_PREVIEW) {
     Depsgraph *depsgraph = engine->depsgraph;
@@ -615,17 +652,34 @@ static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
     DEG_ids_clear_recalc(bmain, depsgraph);
   }
   else {
-    BKE_scene_graph_update_for_newframe(engine->depsgraph);
+    /* A kept depsgraph keeps the recalc flags until the engine synced the frame. */
+    BKE_scene_graph_update_for_newframe_ex(engine->depsgraph, !engine_keep_depsgraph(engine));
   }
 
   engine->has_grease_pencil = DRW_render_check_grease_pencil(engine->depsgraph);
 }
 
-static void engine_depsgraph_free(RenderEngine *engine)
+static void engine_depsgraph_exit(RenderEngine *engine)
 {
-  DEG_graph_free(engine->depsgraph);
+  if (engine->depsgraph == NULL) {
+    return;
+  }
 
-  engine->depsgraph = NULL;
+  if (engine_keep_depsgraph(engine)) {
+    /* The engine handled the updates of this frame. */
+    DEG_ids_clear_recalc(engine->re->main, engine->depsgraph);
+  }
+  else {
+    engine_depsgraph_free(engine);
+  }
+}
+
+void RE_engine_free_persistent_depsgraph(RenderEngine *engine)
+{
+  if (engine->depsgraph && !(engine->flag & RE_ENGINE_RENDERING)) {
+    engine_depsgraph_free(engine);
+  }
+  engine->flag &= ~RE_ENGINE_DEPSGRAPH_REUSED;
 }
 
 void RE_engine_frame_set(RenderEngine *engine, int frame, float subframe)
@@ -801,7 +855,7 @@ static void engine_render_view_layer(Render *re,
   }
 
   /* Free dependency graph, if engine has not done it already. */
-  engine_depsgraph_free(engine);
+  engine_depsgraph_exit(engine);
 }
 
 int RE_engine_render(Render *re, int do_all)
@@ -1027,6 +1081,10 @@ void RE_engine_free_blender_memory(RenderEngine *engine)
   if (engine->has_grease_pencil) {
     return;
   }
+  /* The depsgraph is still needed for the next frame. */
+  if (engine_keep_depsgraph(engine)) {
+    return;
+  }
   DEG_graph_free(engine->depsgraph);
   engine->depsgraph = NULL;
 }
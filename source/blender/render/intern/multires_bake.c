@@ -345,7 +345,13 @@ static int multiresbake_test_break(MultiresBakeRender *bkr)
 
 /* **** Threading routines **** */
 
+/* Number of triangles a thread takes from the queue at once, neighbor triangles are
+ * likely to be close in the image too. */
+#define MULTIRES_BAKE_QUEUE_CHUNK 16
+
 typedef struct MultiresBakeQueue {
+  /* Triangles of the low resolution mesh using the image being baked. */
+  const int *tris;
   int cur_tri;
   int tot_tri;
   SpinLock spin;
@@ -355,7 +361,6 @@ typedef struct MultiresBakeThread {
   /* this data is actually shared between all the threads */
   MultiresBakeQueue *queue;
   MultiresBakeRender *bkr;
-  Image *image;
   void *bake_data;
 
   /* thread-specific data */
@@ -366,51 +371,46 @@ typedef struct MultiresBakeThread {
   float height_min, height_max;
 } MultiresBakeThread;
 
-static int multires_bake_queue_next_tri(MultiresBakeQueue *queue)
+/* Returns the first queue index of the next chunk of triangles, or -1 when the queue is empty. */
+static int multires_bake_queue_next_tris(MultiresBakeQueue *queue, int *r_tot)
 {
-  int face = -1;
-
-  /* TODO: it could worth making it so thread will handle neighbor faces
-   *       for better memory cache utilization
-   */
+  int first = -1;
 
   BLI_spin_lock(&queue->spin);
   if (queue->cur_tri < queue->tot_tri) {
-    face = queue->cur_tri;
-    queue->cur_tri++;
+    first = queue->cur_tri;
+    *r_tot = min_ii(MULTIRES_BAKE_QUEUE_CHUNK, queue->tot_tri - first);
+    queue->cur_tri += *r_tot;
   }
   BLI_spin_unlock(&queue->spin);
 
-  return face;
+  return first;
 }
 
 static void *do_multires_bake_thread(void *data_v)
 {
   MultiresBakeThread *handle = (MultiresBakeThread *)data_v;
+  MultiresBakeQueue *queue = handle->queue;
   MResolvePixelData *data = &handle->data;
   MBakeRast *bake_rast = &handle->bake_rast;
   MultiresBakeRender *bkr = handle->bkr;
-  int tri_index;
-
-  while ((tri_index = multires_bake_queue_next_tri(handle->queue)) >= 0) {
-    const MLoopTri *lt = &data->mlooptri[tri_index];
-    const MPoly *mp = &data->mpoly[lt->poly];
-    const short mat_nr = mp->mat_nr;
-    const MLoopUV *mloopuv = data->mloopuv;
+  const MLoopUV *mloopuv = data->mloopuv;
+  int first, tot;
 
+  while ((first = multires_bake_queue_next_tris(queue, &tot)) >= 0) {
     if (multiresbake_test_break(bkr)) {
       break;
     }
 
-    Image *tri_image = mat_nr < bkr->ob_image.len ? bkr->ob_image.array[mat_nr] : NULL;
-    if (tri_image != handle->image) {
-      continue;
-    }
+    for (int i = first; i < first + tot; i++) {
+      const int tri_index = queue->tris[i];
+      const MLoopTri *lt = &data->mlooptri[tri_index];
 
-    data->tri_index = tri_index;
+      data->tri_index = tri_index;
 
-    bake_rasterize(
-        bake_rast, mloopuv[lt->tri[0]].uv, mloopuv[lt->tri[1]].uv, mloopuv[lt->tri[2]].uv);
+      bake_rasterize(
+          bake_rast, mloopuv[lt->tri[0]].uv, mloopuv[lt->tri[1]].uv, mloopuv[lt->tri[2]].uv);
+    }
 
     /* tag image buffer for refresh */
     if (data->ibuf->rect_float) {
@@ -420,8 +420,8 @@ static void *do_multires_bake_thread(void *data_v)
     data->ibuf->userflags |= IB_DISPLAY_BUFFER_INVALID;
 
     /* update progress */
-    BLI_spin_lock(&handle->queue->spin);
-    bkr->baked_faces++;
+    BLI_spin_lock(&queue->spin);
+    bkr->baked_faces += tot;
 
     if (bkr->do_update) {
       *bkr->do_update = true;
@@ -429,10 +429,10 @@ static void *do_multires_bake_thread(void *data_v)
 
     if (bkr->progress) {
       *bkr->progress = ((float)bkr->baked_objects +
-                        (float)bkr->baked_faces / handle->queue->tot_tri) /
+                        (float)bkr->baked_faces / queue->tot_tri) /
                        bkr->tot_obj;
     }
-    BLI_spin_unlock(&handle->queue->spin);
+    BLI_spin_unlock(&queue->spin);
   }
 
   return NULL;
@@ -510,9 +510,20 @@ static void do_multires_bake(MultiresBakeRender *bkr,
 
     init_ccgdm_arrays(bkr->hires_dm);
 
-    /* faces queue */
+    /* Faces queue, only the triangles using this image are rasterized. */
+    int *tris = MEM_malloc_arrayN(tot_tri, sizeof(*tris), __func__);
+    int tot_image_tri = 0;
+    for (i = 0; i < tot_tri; i++) {
+      const short mat_nr = mpoly[mlooptri[i].poly].mat_nr;
+      Image *tri_image = mat_nr < bkr->ob_image.len ? bkr->ob_image.array[mat_nr] : NULL;
+      if (tri_image == ima) {
+        tris[tot_image_tri++] = i;
+      }
+    }
+
+    queue.tris = tris;
     queue.cur_tri = 0;
-    queue.tot_tri = tot_tri;
+    queue.tot_tri = tot_image_tri;
     BLI_spin_init(&queue.spin);
 
     /* fill in threads handles */
@@ -520,7 +531,6 @@ static void do_multires_bake(MultiresBakeRender *bkr,
       MultiresBakeThread *handle = &handles[i];
 
       handle->bkr = bkr;
-      handle->image = ima;
       handle->queue = &queue;
 
       handle->data.mpoly = mpoly;
@@ -568,6 +578,7 @@ static void do_multires_bake(MultiresBakeRender *bkr,
     }
 
     BLI_spin_end(&queue.spin);
+    MEM_freeN(tris);
 
     /* finalize baking */
     if (freeBakeData) {
@@ -813,12 +824,14 @@ static void apply_heights_callback(DerivedMesh *lores_dm,
                                    const int x,
                                    const int y)
 {
-  const MLoopTri *lt = lores_dm->getLoopTriArray(lores_dm) + tri_index;
-  MLoop *mloop = lores_dm->getLoopArray(lores_dm);
-  MPoly *mpoly = lores_dm->getPolyArray(lores_dm) + lt->poly;
-  MLoopUV *mloopuv = lores_dm->getLoopDataArray(lores_dm, CD_MLOOPUV);
-  MHeightBakeData *height_data = (MHeightBakeData *)bake_data;
   MultiresBakeThread *thread_data = (MultiresBakeThread *)thread_data_v;
+  /* Don't use the DerivedMesh accessors here, the loop triangles one takes a lock. */
+  const MResolvePixelData *data = &thread_data->data;
+  const MLoopTri *lt = &data->mlooptri[tri_index];
+  MLoop *mloop = data->mloop;
+  MPoly *mpoly = &data->mpoly[lt->poly];
+  MLoopUV *mloopuv = data->mloopuv;
+  MHeightBakeData *height_data = (MHeightBakeData *)bake_data;
   float uv[2], *st0, *st1, *st2, *st3;
   int pixel = ibuf->x * y + x;
   float vec[3], p0[3], p1[3], n[3], len;
@@ -917,7 +930,7 @@ static void free_normal_data(void *bake_data)
  */
 static void apply_tangmat_callback(DerivedMesh *lores_dm,
                                    DerivedMesh *hires_dm,
-                                   void *UNUSED(thread_data),
+                                   void *thread_data_v,
                                    void *bake_data,
                                    ImBuf *ibuf,
                                    const int tri_index,
@@ -927,9 +940,10 @@ static void apply_tangmat_callback(DerivedMesh *lores_dm,
                                    const int x,
                                    const int y)
 {
-  const MLoopTri *lt = lores_dm->getLoopTriArray(lores_dm) + tri_index;
-  MPoly *mpoly = lores_dm->getPolyArray(lores_dm) + lt->poly;
-  MLoopUV *mloopuv = lores_dm->getLoopDataArray(lores_dm, CD_MLOOPUV);
+  const MResolvePixelData *data = &((MultiresBakeThread *)thread_data_v)->data;
+  const MLoopTri *lt = &data->mlooptri[tri_index];
+  MPoly *mpoly = &data->mpoly[lt->poly];
+  MLoopUV *mloopuv = data->mloopuv;
   MNormalBakeData *normal_data = (MNormalBakeData *)bake_data;
   float uv[2], *st0, *st1, *st2, *st3;
   int pixel = ibuf->x * y + x;
@@ -47,6 +47,7 @@
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_timecode.h"
 
@@ -157,12 +158,15 @@ static void render_callback_exec_id(Render *re, Main *bmain, ID *id, eCbEvent ev
 
 /* ********* alloc and free ******** */
 
+struct RenderWriteAsync;
+
 static int do_write_image_or_movie(Render *re,
                                    Main *bmain,
                                    Scene *scene,
                                    bMovieHandle *mh,
                                    const int totvideos,
-                                   const char *name_override);
+                                   const char *name_override,
+                                   struct RenderWriteAsync *write_async);
 
 /* default callbacks, set in each new render */
 static void result_nothing(void *UNUSED(arg), RenderResult *UNUSED(rr))
@@ -2031,7 +2035,7 @@ void RE_RenderFrame(Render *re,
                                      NULL);
 
         /* reports only used for Movie */
-        do_write_image_or_movie(re, bmain, scene, NULL, 0, name);
+        do_write_image_or_movie(re, bmain, scene, NULL, 0, name, NULL);
       }
     }
 
@@ -2299,12 +2303,123 @@ bool RE_WriteRenderViewsMovie(ReportList *reports,
   return ok;
 }
 
+/* Image files of one frame, written in a background thread while the next frame renders. */
+typedef struct RenderWriteAsync {
+  TaskPool *pool;
+  /* RenderWriteJob, one for every view. */
+  ListBase jobs;
+} RenderWriteAsync;
+
+typedef struct RenderWriteJob {
+  struct RenderWriteJob *next, *prev;
+  /* Owns its pixels, the render result is reused by the next frame. */
+  ImBuf *ibuf;
+  ImageFormatData imf;
+  char name[FILE_MAX];
+  bool ok;
+  int err;
+} RenderWriteJob;
+
+/* Background writing only covers the common case of one regular image file per view, the other
+ * formats read from the render result while writing. */
+static bool render_write_async_supported(const Scene *scene, RenderResult *rr)
+{
+  const RenderData *rd = &scene->r;
+  const bool is_mono = BLI_listbase_count_at_most(&rr->views, 2) < 2;
+
+  if (BKE_imtype_is_movie(rd->im_format.imtype)) {
+    return false;
+  }
+  if (ELEM(rd->im_format.imtype, R_IMF_IMTYPE_OPENEXR, R_IMF_IMTYPE_MULTILAYER)) {
+    return false;
+  }
+  return is_mono || (rd->im_format.views_format == R_IMF_VIEWS_INDIVIDUAL);
+}
+
+static void render_write_job_run(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  RenderWriteJob *job = taskdata;
+
+  job->ok = BKE_imbuf_write(job->ibuf, job->name, &job->imf);
+  job->err = errno;
+}
+
+/* Same as the mono/individual views branch of #RE_WriteRenderViewsImage, except that saving the
+ * files is pushed to the background. */
+static void render_write_views_image_async(RenderWriteAsync *write_async,
+                                           RenderResult *rr,
+                                           Scene *scene,
+                                           char *name)
+{
+  RenderData *rd = &scene->r;
+  const bool is_mono = BLI_listbase_count_at_most(&rr->views, 2) < 2;
+  RenderView *rv;
+  int view_id;
+  char filepath[FILE_MAX];
+
+  BLI_assert(write_async->pool == NULL);
+  write_async->pool = BLI_task_pool_create_background(NULL, TASK_PRIORITY_LOW);
+
+  BLI_strncpy(filepath, name, sizeof(filepath));
+
+  for (view_id = 0, rv = rr->views.first; rv; rv = rv->next, view_id++) {
+    if (!is_mono) {
+      BKE_scene_multiview_view_filepath_get(&scene->r, filepath, rv->name, name);
+    }
+
+    ImBuf *ibuf = render_result_rect_to_ibuf(rr, rd, view_id);
+    IMB_colormanagement_imbuf_for_write(
+        ibuf, true, false, &scene->view_settings, &scene->display_settings, &rd->im_format);
+
+    RenderWriteJob *job = MEM_callocN(sizeof(*job), __func__);
+    job->ibuf = IMB_dupImBuf(ibuf);
+    job->imf = rd->im_format;
+    BLI_strncpy(job->name, name, sizeof(job->name));
+
+    /* imbuf knows which rects are not part of ibuf */
+    IMB_freeImBuf(ibuf);
+
+    if (rd->stamp & R_STAMP_ALL) {
+      BKE_imbuf_stamp_info(rr, job->ibuf);
+    }
+
+    BLI_addtail(&write_async->jobs, job);
+    BLI_task_pool_push(write_async->pool, render_write_job_run, job, false, NULL);
+  }
+}
+
+/* Wait for the files of the previous frame to be written, returns false if any failed. */
+static bool render_write_async_finish(Render *re, RenderWriteAsync *write_async)
+{
+  bool ok = true;
+
+  if (write_async->pool == NULL) {
+    return ok;
+  }
+
+  BLI_task_pool_work_and_wait(write_async->pool);
+  BLI_task_pool_free(write_async->pool);
+  write_async->pool = NULL;
+
+  LISTBASE_FOREACH_MUTABLE (RenderWriteJob *, job, &write_async->jobs) {
+    render_print_save_message(re->reports, job->name, job->ok, job->err);
+    ok &= job->ok;
+
+    IMB_freeImBuf(job->ibuf);
+    MEM_freeN(job);
+  }
+  BLI_listbase_clear(&write_async->jobs);
+
+  return ok;
+}
+
 static int do_write_image_or_movie(Render *re,
                                    Main *bmain,
                                    Scene *scene,
                                    bMovieHandle *mh,
                                    const int totvideos,
-                                   const char *name_override)
+                                   const char *name_override,
+                                   RenderWriteAsync *write_async)
 {
   char name[FILE_MAX];
   RenderResult rres;
@@ -2333,8 +2448,13 @@ static int do_write_image_or_movie(Render *re,
                                    NULL);
     }
 
-    /* write images as individual images or stereo */
-    ok = RE_WriteRenderViewsImage(re->reports, &rres, scene, true, name);
+    if (write_async && render_write_async_supported(scene, &rres)) {
+      render_write_views_image_async(write_async, &rres, scene, name);
+    }
+    else {
+      /* write images as individual images or stereo */
+      ok = RE_WriteRenderViewsImage(re->reports, &rres, scene, true, name);
+    }
   }
 
   RE_ReleaseResultImageViews(re, &rres);
@@ -2419,6 +2539,8 @@ void RE_RenderAnim(Render *re,
   const bool is_movie = BKE_imtype_is_movie(rd.im_format.imtype);
   const bool is_multiview_name = ((rd.scemode & R_MULTIVIEW) != 0 &&
                                   (rd.im_format.views_format == R_IMF_VIEWS_INDIVIDUAL));
+  const bool use_write_async = !is_movie && (rd.scemode & R_WRITE_ASYNC) != 0;
+  RenderWriteAsync write_async = {NULL};
 
   /* do not fully call for each frame, it initializes & pops output window */
   if (!render_init_from_main(re, &rd, bmain, scene, single_layer, camera_override, 0, 1)) {
@@ -2592,7 +2714,24 @@ void RE_RenderAnim(Render *re,
 
       if (re->test_break(re->tbh) == 0) {
         if (!G.is_break) {
-          if (!do_write_image_or_movie(re, bmain, scene, mh, totvideos, NULL)) {
+          /* The files of the previous frame were written while this frame rendered. */
+          if (write_async.pool) {
+            if (render_write_async_finish(re, &write_async)) {
+              render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+            }
+            else {
+              G.is_break = true;
+            }
+          }
+        }
+        if (!G.is_break) {
+          if (!do_write_image_or_movie(re,
+                                       bmain,
+                                       scene,
+                                       mh,
+                                       totvideos,
+                                       NULL,
+                                       use_write_async ? &write_async : NULL)) {
             G.is_break = true;
           }
         }
@@ -2637,11 +2776,23 @@ void RE_RenderAnim(Render *re,
       if (G.is_break == false) {
         /* keep after file save */
         render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_POST);
-        render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+        if (write_async.pool == NULL) {
+          render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+        }
       }
     }
   }
 
+  if (write_async.pool) {
+    /* The last frame rendered is still being written. */
+    if (render_write_async_finish(re, &write_async)) {
+      render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+    }
+    else {
+      G.is_break = true;
+    }
+  }
+
   /* end movie */
   if (is_movie) {
     re_movie_free_all(re, mh, totvideos);
@@ -2690,6 +2841,9 @@ void RE_CleanAfterRender(Render *re)
 {
   /* Destroy the opengl context in the correct thread. */
   RE_gl_context_destroy(re);
+  if (re->engine != NULL) {
+    RE_engine_free_persistent_depsgraph(re->engine);
+  }
   if (re->pipeline_depsgraph != NULL) {
     DEG_graph_free(re->pipeline_depsgraph);
   }
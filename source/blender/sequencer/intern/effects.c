@@ -28,6 +28,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
 #include "MEM_guardedalloc.h"
 
 #include "BLI_listbase.h"
@@ -189,6 +193,47 @@ static ImBuf *prepare_effect_imbufs(const SeqRenderData *context,
   return out;
 }
 
+/*********************** Float Row Kernels *************************/
+
+/* The float blend effects process one row at a time, the factor alternates between the two
+ * fields on even and odd rows. The SSE2 paths do the same operations per channel in the same
+ * order as the scalar ones, so results don't depend on the instruction set. */
+
+#ifdef __SSE2__
+BLI_INLINE __m128 sse_splat_alpha(const __m128 v)
+{
+  return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+/* Replace the alpha of \a rgb by the one of \a alpha. */
+BLI_INLINE __m128 sse_with_alpha(const __m128 rgb, const __m128 alpha)
+{
+  const __m128 rgb_mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+  return _mm_or_ps(_mm_and_ps(rgb_mask, rgb), _mm_andnot_ps(rgb_mask, alpha));
+}
+#endif
+
+typedef void (*EffectFloatRowFn)(float fac, int x, const float *rt1, const float *rt2, float *rt);
+
+static void do_effect_float_rows(EffectFloatRowFn row_fn,
+                                 float facf0,
+                                 float facf1,
+                                 int x,
+                                 int y,
+                                 const float *rect1,
+                                 const float *rect2,
+                                 float *out)
+{
+  const size_t stride = (size_t)x * 4;
+
+  for (int i = 0; i < y; i++) {
+    row_fn((i & 1) ? facf1 : facf0, x, rect1, rect2, out);
+    rect1 += stride;
+    rect2 += stride;
+    out += stride;
+  }
+}
+
 /*********************** Alpha Over *************************/
 
 static void init_alpha_over_or_under(Sequence *seq)
@@ -285,73 +330,48 @@ static void do_alphaover_effect_byte(float facf0,
   }
 }
 
-static void do_alphaover_effect_float(
-    float facf0, float facf1, int x, int y, float *rect1, float *rect2, float *out)
+static void do_alphaover_effect_float_row(
+    float fac, int x, const float *rt1, const float *rt2, float *rt)
 {
-  float fac2, mfac, fac, fac4;
-  int xo;
-  float *rt1, *rt2, *rt;
-
-  xo = x;
-  rt1 = rect1;
-  rt2 = rect2;
-  rt = out;
-
-  fac2 = facf0;
-  fac4 = facf1;
-
-  while (y--) {
-    x = xo;
-    while (x--) {
-      /* rt = rt1 over rt2  (alpha from rt1) */
-
-      fac = fac2;
-      mfac = 1.0f - (fac2 * rt1[3]);
-
-      if (fac <= 0.0f) {
-        memcpy(rt, rt2, sizeof(float[4]));
-      }
-      else if (mfac <= 0) {
-        memcpy(rt, rt1, sizeof(float[4]));
-      }
-      else {
-        rt[0] = fac * rt1[0] + mfac * rt2[0];
-        rt[1] = fac * rt1[1] + mfac * rt2[1];
-        rt[2] = fac * rt1[2] + mfac * rt2[2];
-        rt[3] = fac * rt1[3] + mfac * rt2[3];
-      }
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+  /* rt = rt1 over rt2  (alpha from rt1) */
+  if (fac <= 0.0f) {
+    memcpy(rt, rt2, sizeof(float[4]) * x);
+    return;
+  }
 
-    if (y == 0) {
-      break;
+#ifdef __SSE2__
+  const __m128 fac_v = _mm_set1_ps(fac);
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 zero = _mm_setzero_ps();
+  for (int i = 0; i < x; i++, rt1 += 4, rt2 += 4, rt += 4) {
+    const __m128 col1 = _mm_loadu_ps(rt1);
+    const __m128 col2 = _mm_loadu_ps(rt2);
+    const __m128 mfac = _mm_sub_ps(one, _mm_mul_ps(fac_v, sse_splat_alpha(col1)));
+    const __m128 mix = _mm_add_ps(_mm_mul_ps(fac_v, col1), _mm_mul_ps(mfac, col2));
+    const __m128 opaque = _mm_cmple_ps(mfac, zero);
+    _mm_storeu_ps(rt, _mm_or_ps(_mm_and_ps(opaque, col1), _mm_andnot_ps(opaque, mix)));
+  }
+#else
+  for (int i = 0; i < x; i++, rt1 += 4, rt2 += 4, rt += 4) {
+    const float mfac = 1.0f - (fac * rt1[3]);
+
+    if (mfac <= 0.0f) {
+      memcpy(rt, rt1, sizeof(float[4]));
     }
-    y--;
-
-    x = xo;
-    while (x--) {
-      fac = fac4;
-      mfac = 1.0f - (fac4 * rt1[3]);
-
-      if (fac <= 0.0f) {
-        memcpy(rt, rt2, sizeof(float[4]));
-      }
-      else if (mfac <= 0.0f) {
-        memcpy(rt, rt1, sizeof(float[4]));
-      }
-      else {
-        rt[0] = fac * rt1[0] + mfac * rt2[0];
-        rt[1] = fac * rt1[1] + mfac * rt2[1];
-        rt[2] = fac * rt1[2] + mfac * rt2[2];
-        rt[3] = fac * rt1[3] + mfac * rt2[3];
-      }
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
+    else {
+      rt[0] = fac * rt1[0] + mfac * rt2[0];
+      rt[1] = fac * rt1[1] + mfac * rt2[1];
+      rt[2] = fac * rt1[2] + mfac * rt2[2];
+      rt[3] = fac * rt1[3] + mfac * rt2[3];
     }
   }
+#endif
+}
+
+static void do_alphaover_effect_float(
+    float facf0, float facf1, int x, int y, float *rect1, float *rect2, float *out)
+{
+  do_effect_float_rows(do_alphaover_effect_float_row, facf0, facf1, x, y, rect1, rect2, out);
 }
 
 static void do_alphaover_effect(const SeqRenderData *context,
@@ -647,53 +667,33 @@ static void do_cross_effect_byte(float facf0,
   }
 }
 
-static void do_cross_effect_float(
-    float facf0, float facf1, int x, int y, float *rect1, float *rect2, float *out)
+static void do_cross_effect_float_row(
+    float fac, int x, const float *rt1, const float *rt2, float *rt)
 {
-  float fac1, fac2, fac3, fac4;
-  int xo;
-  float *rt1, *rt2, *rt;
+  const float mfac = 1.0f - fac;
 
-  xo = x;
-  rt1 = rect1;
-  rt2 = rect2;
-  rt = out;
-
-  fac2 = facf0;
-  fac1 = 1.0f - fac2;
-  fac4 = facf1;
-  fac3 = 1.0f - fac4;
-
-  while (y--) {
-    x = xo;
-    while (x--) {
-      rt[0] = fac1 * rt1[0] + fac2 * rt2[0];
-      rt[1] = fac1 * rt1[1] + fac2 * rt2[1];
-      rt[2] = fac1 * rt1[2] + fac2 * rt2[2];
-      rt[3] = fac1 * rt1[3] + fac2 * rt2[3];
-
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
-
-    if (y == 0) {
-      break;
-    }
-    y--;
-
-    x = xo;
-    while (x--) {
-      rt[0] = fac3 * rt1[0] + fac4 * rt2[0];
-      rt[1] = fac3 * rt1[1] + fac4 * rt2[1];
-      rt[2] = fac3 * rt1[2] + fac4 * rt2[2];
-      rt[3] = fac3 * rt1[3] + fac4 * rt2[3];
-
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+#ifdef __SSE2__
+  const __m128 fac_v = _mm_set1_ps(fac);
+  const __m128 mfac_v = _mm_set1_ps(mfac);
+  for (int i = 0; i < x; i++, rt1 += 4, rt2 += 4, rt += 4) {
+    const __m128 col1 = _mm_loadu_ps(rt1);
+    const __m128 col2 = _mm_loadu_ps(rt2);
+    _mm_storeu_ps(rt, _mm_add_ps(_mm_mul_ps(mfac_v, col1), _mm_mul_ps(fac_v, col2)));
   }
+#else
+  for (int i = 0; i < x; i++, rt1 += 4, rt2 += 4, rt += 4) {
+    rt[0] = mfac * rt1[0] + fac * rt2[0];
+    rt[1] = mfac * rt1[1] + fac * rt2[1];
+    rt[2] = mfac * rt1[2] + fac * rt2[2];
+    rt[3] = mfac * rt1[3] + fac * rt2[3];
+  }
+#endif
+}
+
+static void do_cross_effect_float(
+    float facf0, float facf1, int x, int y, float *rect1, float *rect2, float *out)
+{
+  do_effect_float_rows(do_cross_effect_float_row, facf0, facf1, x, y, rect1, rect2, out);
 }
 
 static void do_cross_effect(const SeqRenderData *context,
@@ -1080,53 +1080,36 @@ static void do_add_effect_byte(float facf0,
   }
 }
 
-static void do_add_effect_float(
-    float facf0, float facf1, int x, int y, float *rect1, float *rect2, float *out)
+static void do_add_effect_float_row(
+    float fac, int x, const float *rt1, const float *rt2, float *rt)
 {
-  int xo;
-  float fac1, fac3;
-  float *rt1, *rt2, *rt;
-
-  xo = x;
-  rt1 = rect1;
-  rt2 = rect2;
-  rt = out;
-
-  fac1 = facf0;
-  fac3 = facf1;
-
-  while (y--) {
-    x = xo;
-    while (x--) {
-      const float m = (1.0f - (rt1[3] * (1.0f - fac1))) * rt2[3];
-      rt[0] = rt1[0] + m * rt2[0];
-      rt[1] = rt1[1] + m * rt2[1];
-      rt[2] = rt1[2] + m * rt2[2];
-      rt[3] = rt1[3];
-
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
-
-    if (y == 0) {
-      break;
-    }
-    y--;
-
-    x = xo;
-    while (x--) {
-      const float m = (1.0f - (rt1[3] * (1.0f - fac3))) * rt2[3];
-      rt[0] = rt1[0] + m * rt2[0];
-      rt[1] = rt1[1] + m * rt2[1];
-      rt[2] = rt1[2] + m * rt2[2];
-      rt[3] = rt1[3];
+  const float mfac = 1.0f - fac;
 
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+#ifdef __SSE2__
+  const __m128 mfac_v = _mm_set1_ps(mfac);
+  const __m128 one = _mm_set1_ps(1.0f);
+  for (int i = 0; i < x; i++, rt1 += 4, rt2 += 4, rt += 4) {
+    const __m128 col1 = _mm_loadu_ps(rt1);
+    const __m128 col2 = _mm_loadu_ps(rt2);
+    const __m128 m = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(sse_splat_alpha(col1), mfac_v)),
+                                sse_splat_alpha(col2));
+    _mm_storeu_ps(rt, sse_with_alpha(_mm_add_ps(col1, _mm_mul_ps(m, col2)), col1));
   }
+#else
+  for (int i = 0; i < x; i++, rt1 += 4, rt2 += 4, rt += 4) {
+    const float m = (1.0f - (rt1[3] * mfac)) * rt2[3];
+    rt[0] = rt1[0] + m * rt2[0];
+    rt[1] = rt1[1] + m * rt2[1];
+    rt[2] = rt1[2] + m * rt2[2];
+    rt[3] = rt1[3];
+  }
+#endif
+}
+
+static void do_add_effect_float(
+    float facf0, float facf1, int x, int y, float *rect1, float *rect2, float *out)
+{
+  do_effect_float_rows(do_add_effect_float_row, facf0, facf1, x, y, rect1, rect2, out);
 }
 
 static void do_add_effect(const SeqRenderData *context,
@@ -1214,54 +1197,39 @@ static void do_sub_effect_byte(float facf0,
   }
 }
 
-static void do_sub_effect_float(
-    float UNUSED(facf0), float facf1, int x, int y, float *rect1, float *rect2, float *out)
+static void do_sub_effect_float_row(
+    float fac, int x, const float *rt1, const float *rt2, float *rt)
 {
-  int xo;
-  float /* fac1, */ fac3_inv;
-  float *rt1, *rt2, *rt;
-
-  xo = x;
-  rt1 = rect1;
-  rt2 = rect2;
-  rt = out;
-
-  /* UNUSED */
-  // fac1 = facf0;
-  fac3_inv = 1.0f - facf1;
-
-  while (y--) {
-    x = xo;
-    while (x--) {
-      const float m = (1.0f - (rt1[3] * fac3_inv)) * rt2[3];
-      rt[0] = max_ff(rt1[0] - m * rt2[0], 0.0f);
-      rt[1] = max_ff(rt1[1] - m * rt2[1], 0.0f);
-      rt[2] = max_ff(rt1[2] - m * rt2[2], 0.0f);
-      rt[3] = rt1[3];
-
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
-
-    if (y == 0) {
-      break;
-    }
-    y--;
+  const float mfac = 1.0f - fac;
 
-    x = xo;
-    while (x--) {
-      const float m = (1.0f - (rt1[3] * fac3_inv)) * rt2[3];
-      rt[0] = max_ff(rt1[0] - m * rt2[0], 0.0f);
-      rt[1] = max_ff(rt1[1] - m * rt2[1], 0.0f);
-      rt[2] = max_ff(rt1[2] - m * rt2[2], 0.0f);
-      rt[3] = rt1[3];
-
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+#ifdef __SSE2__
+  const __m128 mfac_v = _mm_set1_ps(mfac);
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 zero = _mm_setzero_ps();
+  for (int i = 0; i < x; i++, rt1 += 4, rt2 += 4, rt += 4) {
+    const __m128 col1 = _mm_loadu_ps(rt1);
+    const __m128 col2 = _mm_loadu_ps(rt2);
+    const __m128 m = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(sse_splat_alpha(col1), mfac_v)),
+                                sse_splat_alpha(col2));
+    const __m128 rgb = _mm_max_ps(_mm_sub_ps(col1, _mm_mul_ps(m, col2)), zero);
+    _mm_storeu_ps(rt, sse_with_alpha(rgb, col1));
+  }
+#else
+  for (int i = 0; i < x; i++, rt1 += 4, rt2 += 4, rt += 4) {
+    const float m = (1.0f - (rt1[3] * mfac)) * rt2[3];
+    rt[0] = max_ff(rt1[0] - m * rt2[0], 0.0f);
+    rt[1] = max_ff(rt1[1] - m * rt2[1], 0.0f);
+    rt[2] = max_ff(rt1[2] - m * rt2[2], 0.0f);
+    rt[3] = rt1[3];
   }
+#endif
+}
+
+static void do_sub_effect_float(
+    float UNUSED(facf0), float facf1, int x, int y, float *rect1, float *rect2, float *out)
+{
+  /* Both fields use the second factor. */
+  do_effect_float_rows(do_sub_effect_float_row, facf1, facf1, x, y, rect1, rect2, out);
 }
 
 static void do_sub_effect(const SeqRenderData *context,
@@ -1464,55 +1432,35 @@ static void do_mul_effect_byte(float facf0,
   }
 }
 
-static void do_mul_effect_float(
-    float facf0, float facf1, int x, int y, float *rect1, float *rect2, float *out)
+static void do_mul_effect_float_row(
+    float fac, int x, const float *rt1, const float *rt2, float *rt)
 {
-  int xo;
-  float fac1, fac3;
-  float *rt1, *rt2, *rt;
-
-  xo = x;
-  rt1 = rect1;
-  rt2 = rect2;
-  rt = out;
-
-  fac1 = facf0;
-  fac3 = facf1;
-
   /* formula:
    * fac * (a * b) + (1 - fac) * a  =>  fac * a * (b - 1) + a
    */
-
-  while (y--) {
-    x = xo;
-    while (x--) {
-      rt[0] = rt1[0] + fac1 * rt1[0] * (rt2[0] - 1.0f);
-      rt[1] = rt1[1] + fac1 * rt1[1] * (rt2[1] - 1.0f);
-      rt[2] = rt1[2] + fac1 * rt1[2] * (rt2[2] - 1.0f);
-      rt[3] = rt1[3] + fac1 * rt1[3] * (rt2[3] - 1.0f);
-
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
-
-    if (y == 0) {
-      break;
-    }
-    y--;
-
-    x = xo;
-    while (x--) {
-      rt[0] = rt1[0] + fac3 * rt1[0] * (rt2[0] - 1.0f);
-      rt[1] = rt1[1] + fac3 * rt1[1] * (rt2[1] - 1.0f);
-      rt[2] = rt1[2] + fac3 * rt1[2] * (rt2[2] - 1.0f);
-      rt[3] = rt1[3] + fac3 * rt1[3] * (rt2[3] - 1.0f);
-
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+#ifdef __SSE2__
+  const __m128 fac_v = _mm_set1_ps(fac);
+  const __m128 one = _mm_set1_ps(1.0f);
+  for (int i = 0; i < x; i++, rt1 += 4, rt2 += 4, rt += 4) {
+    const __m128 col1 = _mm_loadu_ps(rt1);
+    const __m128 col2 = _mm_loadu_ps(rt2);
+    const __m128 delta = _mm_mul_ps(_mm_mul_ps(fac_v, col1), _mm_sub_ps(col2, one));
+    _mm_storeu_ps(rt, _mm_add_ps(col1, delta));
+  }
+#else
+  for (int i = 0; i < x; i++, rt1 += 4, rt2 += 4, rt += 4) {
+    rt[0] = rt1[0] + fac * rt1[0] * (rt2[0] - 1.0f);
+    rt[1] = rt1[1] + fac * rt1[1] * (rt2[1] - 1.0f);
+    rt[2] = rt1[2] + fac * rt1[2] * (rt2[2] - 1.0f);
+    rt[3] = rt1[3] + fac * rt1[3] * (rt2[3] - 1.0f);
   }
+#endif
+}
+
+static void do_mul_effect_float(
+    float facf0, float facf1, int x, int y, float *rect1, float *rect2, float *out)
+{
+  do_effect_float_rows(do_mul_effect_float_row, facf0, facf1, x, y, rect1, rect2, out);
 }
 
 static void do_mul_effect(const SeqRenderData *context,
@@ -35,6 +35,7 @@
 #include "IMB_imbuf_types.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_compress.h"
 #include "BLI_endian_switch.h"
 #include "BLI_fileops.h"
 #include "BLI_fileops_types.h"
@@ -99,7 +100,7 @@
 /* <cache type>-<resolution X>x<resolution Y>-<rendersize>%(<view_id>)-<frame no>.dcf */
 #define DCACHE_FNAME_FORMAT "%d-%dx%d-%d%%(%d)-%d.dcf"
 #define DCACHE_IMAGES_PER_FILE 100
-#define DCACHE_CURRENT_VERSION 1
+#define DCACHE_CURRENT_VERSION 2
 #define COLORSPACE_NAME_MAX 64 /* XXX: defined in imb intern */
 
 typedef struct DiskCacheHeaderEntry {
@@ -483,29 +484,42 @@ static void seq_disk_cache_invalidate(Scene *scene,
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
 }
 
+/* Image is split into blocks compressed in parallel, see #BLI_compress_blocks. */
 static size_t deflate_imbuf_to_file(ImBuf *ibuf,
                                     FILE *file,
                                     int level,
                                     DiskCacheHeaderEntry *header_entry)
 {
-  if (ibuf->rect) {
-    return BLI_gzip_mem_to_file_at_pos(
-        ibuf->rect, header_entry->size_raw, file, header_entry->offset, level);
+  const void *rect = ibuf->rect ? (const void *)ibuf->rect : (const void *)ibuf->rect_float;
+  size_t compressed_len;
+  void *compressed = BLI_compress_mem(rect, header_entry->size_raw, level, &compressed_len);
+  if (compressed == NULL) {
+    return 0;
   }
 
-  return BLI_gzip_mem_to_file_at_pos(
-      ibuf->rect_float, header_entry->size_raw, file, header_entry->offset, level);
+  size_t bytes_written = 0;
+  if (fseek(file, header_entry->offset, SEEK_SET) == 0 &&
+      fwrite(compressed, 1, compressed_len, file) == compressed_len) {
+    bytes_written = compressed_len;
+  }
+  MEM_freeN(compressed);
+  return bytes_written;
 }
 
 static size_t inflate_file_to_imbuf(ImBuf *ibuf, FILE *file, DiskCacheHeaderEntry *header_entry)
 {
-  if (ibuf->rect) {
-    return BLI_ungzip_file_to_mem_at_pos(
-        ibuf->rect, header_entry->size_raw, file, header_entry->offset);
-  }
-
-  return BLI_ungzip_file_to_mem_at_pos(
-      ibuf->rect_float, header_entry->size_raw, file, header_entry->offset);
+  void *rect = ibuf->rect ? (void *)ibuf->rect : (void *)ibuf->rect_float;
+  void *compressed = MEM_mallocN(header_entry->size_compressed, __func__);
+
+  size_t bytes_read = 0;
+  if (fseek(file, header_entry->offset, SEEK_SET) == 0 &&
+      fread(compressed, 1, header_entry->size_compressed, file) ==
+          header_entry->size_compressed) {
+    bytes_read = BLI_decompress_mem(
+        compressed, header_entry->size_compressed, rect, header_entry->size_raw);
+  }
+  MEM_freeN(compressed);
+  return bytes_read;
 }
 
 static void seq_disk_cache_read_header(FILE *file, DiskCacheHeader *header)
@@ -35,6 +35,7 @@
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 
 #ifdef WIN32
 #  include "BLI_winstuff.h"
@@ -258,63 +259,104 @@ ImBuf *seq_proxy_fetch(const SeqRenderData *context, Sequence *seq, int timeline
   return NULL;
 }
 
-static void seq_proxy_build_frame(const SeqRenderData *context,
-                                  SeqRenderState *state,
-                                  Sequence *seq,
-                                  int timeline_frame,
-                                  int proxy_render_size,
-                                  const bool overwrite)
+typedef struct SeqProxyBuildFrameData {
+  Sequence *seq;
+  /* Full size render of the frame, shared by all proxy sizes. */
+  ImBuf *ibuf_src;
+  int proxy_render_size[IMB_PROXY_MAX_SLOT];
+  char name[IMB_PROXY_MAX_SLOT][PROXY_MAXFILE];
+} SeqProxyBuildFrameData;
+
+static void seq_proxy_build_frame_size_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  char name[PROXY_MAXFILE];
-  int quality;
+  SeqProxyBuildFrameData *data = userdata;
+  ImBuf *ibuf_src = data->ibuf_src;
+  const int proxy_render_size = data->proxy_render_size[i];
   int rectx, recty;
-  ImBuf *ibuf_tmp, *ibuf;
-  Editing *ed = context->scene->ed;
+  ImBuf *ibuf;
 
-  if (!seq_proxy_get_fname(ed, seq, timeline_frame, proxy_render_size, name, context->view_id)) {
-    return;
-  }
+  rectx = (proxy_render_size * ibuf_src->x) / 100;
+  recty = (proxy_render_size * ibuf_src->y) / 100;
 
-  if (!overwrite && BLI_exists(name)) {
-    return;
-  }
-
-  ibuf_tmp = seq_render_strip(context, state, seq, timeline_frame);
-
-  rectx = (proxy_render_size * ibuf_tmp->x) / 100;
-  recty = (proxy_render_size * ibuf_tmp->y) / 100;
-
-  if (ibuf_tmp->x != rectx || ibuf_tmp->y != recty) {
-    ibuf = IMB_dupImBuf(ibuf_tmp);
-    IMB_metadata_copy(ibuf, ibuf_tmp);
-    IMB_freeImBuf(ibuf_tmp);
+  ibuf = IMB_dupImBuf(ibuf_src);
+  IMB_metadata_copy(ibuf, ibuf_src);
+  if (ibuf_src->x != rectx || ibuf_src->y != recty) {
     IMB_scalefastImBuf(ibuf, (short)rectx, (short)recty);
   }
-  else {
-    ibuf = ibuf_tmp;
-  }
 
   /* depth = 32 is intentionally left in, otherwise ALPHA channels
    * won't work... */
-  quality = seq->strip->proxy->quality;
   ibuf->ftype = IMB_FTYPE_JPG;
-  ibuf->foptions.quality = quality;
+  ibuf->foptions.quality = data->seq->strip->proxy->quality;
 
   /* unsupported feature only confuses other s/w */
   if (ibuf->planes == 32) {
     ibuf->planes = 24;
   }
 
-  BLI_make_existing_file(name);
+  BLI_make_existing_file(data->name[i]);
 
-  const bool ok = IMB_saveiff(ibuf, name, IB_rect | IB_zbuf | IB_zbuffloat);
+  const bool ok = IMB_saveiff(ibuf, data->name[i], IB_rect | IB_zbuf | IB_zbuffloat);
   if (ok == false) {
-    perror(name);
+    perror(data->name[i]);
   }
 
   IMB_freeImBuf(ibuf);
 }
 
+/**
+ * Render the strip once and write the proxies of all sizes in \a size_flags from that render,
+ * scaling and encoding them in parallel.
+ */
+static void seq_proxy_build_frame(const SeqRenderData *context,
+                                  SeqRenderState *state,
+                                  Sequence *seq,
+                                  int timeline_frame,
+                                  const int size_flags,
+                                  const bool overwrite)
+{
+  static const int proxy_sizes[IMB_PROXY_MAX_SLOT][2] = {
+      {IMB_PROXY_25, 25},
+      {IMB_PROXY_50, 50},
+      {IMB_PROXY_75, 75},
+      {IMB_PROXY_100, 100},
+  };
+  SeqProxyBuildFrameData data;
+  int sizes_len = 0;
+  Editing *ed = context->scene->ed;
+
+  for (int i = 0; i < IMB_PROXY_MAX_SLOT; i++) {
+    if ((size_flags & proxy_sizes[i][0]) == 0) {
+      continue;
+    }
+    char *name = data.name[sizes_len];
+    if (!seq_proxy_get_fname(ed, seq, timeline_frame, proxy_sizes[i][1], name, context->view_id)) {
+      continue;
+    }
+    if (!overwrite && BLI_exists(name)) {
+      continue;
+    }
+    data.proxy_render_size[sizes_len++] = proxy_sizes[i][1];
+  }
+
+  /* Don't render the strip when all proxies of this frame already exist. */
+  if (sizes_len == 0) {
+    return;
+  }
+
+  data.seq = seq;
+  data.ibuf_src = seq_render_strip(context, state, seq, timeline_frame);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (sizes_len > 1);
+  BLI_task_parallel_range(0, sizes_len, &data, seq_proxy_build_frame_size_cb, &settings);
+
+  IMB_freeImBuf(data.ibuf_src);
+}
+
 /**
  * Returns whether the file this context would read from even exist,
  * if not, don't create the context
@@ -513,18 +555,8 @@ void SEQ_proxy_rebuild(SeqIndexBuildContext *context,
   for (timeline_frame = seq->startdisp + seq->startstill;
        timeline_frame < seq->enddisp - seq->endstill;
        timeline_frame++) {
-    if (context->size_flags & IMB_PROXY_25) {
-      seq_proxy_build_frame(&render_context, &state, seq, timeline_frame, 25, overwrite);
-    }
-    if (context->size_flags & IMB_PROXY_50) {
-      seq_proxy_build_frame(&render_context, &state, seq, timeline_frame, 50, overwrite);
-    }
-    if (context->size_flags & IMB_PROXY_75) {
-      seq_proxy_build_frame(&render_context, &state, seq, timeline_frame, 75, overwrite);
-    }
-    if (context->size_flags & IMB_PROXY_100) {
-      seq_proxy_build_frame(&render_context, &state, seq, timeline_frame, 100, overwrite);
-    }
+    seq_proxy_build_frame(
+        &render_context, &state, seq, timeline_frame, context->size_flags, overwrite);
 
     *progress = (float)(timeline_frame - seq->startdisp - seq->startstill) /
                 (seq->enddisp - seq->endstill - seq->startdisp - seq->startstill);
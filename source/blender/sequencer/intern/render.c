@@ -37,6 +37,7 @@
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
+#include "BLI_task.h"
 
 #include "BKE_anim_data.h"
 #include "BKE_animsys.h"
@@ -1905,6 +1906,88 @@ static ImBuf *seq_render_strip_stack_apply_effect(
   return out;
 }
 
+static bool seq_render_strip_can_run_parallel(Sequence *seq)
+{
+  /* Other strip types render scenes, masks, movie clips or nested strips, which are not safe to
+   * render concurrently. */
+  if (!ELEM(seq->type, SEQ_TYPE_IMAGE, SEQ_TYPE_MOVIE)) {
+    return false;
+  }
+  LISTBASE_FOREACH (SequenceModifierData *, smd, &seq->modifiers) {
+    /* The mask strip could be rendered from another thread at the same time. */
+    if (smd->mask_sequence != NULL) {
+      return false;
+    }
+  }
+  return true;
+}
+
+typedef struct RenderStackThreadData {
+  const SeqRenderData *context;
+  SeqRenderState *state;
+  Sequence **seq_arr;
+  ImBuf **ibufs;
+  float timeline_frame;
+} RenderStackThreadData;
+
+static void seq_render_strip_stack_prerender_cb(void *__restrict userdata,
+                                                const int i,
+                                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RenderStackThreadData *data = userdata;
+  Sequence *seq = data->seq_arr[i];
+
+  if (seq_get_early_out_for_blend_mode(seq) == EARLY_DO_EFFECT) {
+    data->ibufs[i] = seq_render_strip(data->context, data->state, seq, data->timeline_frame);
+  }
+}
+
+/**
+ * Render the strips blended on top of each other from \a start up in parallel. Only the blending
+ * itself depends on the order, so independent strips don't have to wait for each other.
+ *
+ * \return false when the strips have to be rendered one after the other.
+ */
+static bool seq_render_strip_stack_prerender(const SeqRenderData *context,
+                                             SeqRenderState *state,
+                                             Sequence **seq_arr,
+                                             const int start,
+                                             const int count,
+                                             float timeline_frame,
+                                             ImBuf **r_ibufs)
+{
+  int num_effect_inputs = 0;
+
+  for (int i = start; i < count; i++) {
+    if (seq_get_early_out_for_blend_mode(seq_arr[i]) != EARLY_DO_EFFECT) {
+      continue;
+    }
+    if (!seq_render_strip_can_run_parallel(seq_arr[i])) {
+      return false;
+    }
+    num_effect_inputs++;
+  }
+
+  if (num_effect_inputs < 2) {
+    return false;
+  }
+
+  RenderStackThreadData data = {
+      .context = context,
+      .state = state,
+      .seq_arr = seq_arr,
+      .ibufs = r_ibufs,
+      .timeline_frame = timeline_frame,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(start, count, &data, seq_render_strip_stack_prerender_cb, &settings);
+
+  return true;
+}
+
 static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      SeqRenderState *state,
                                      ListBase *seqbasep,
@@ -1973,13 +2056,23 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
   }
 
   i++;
+
+  ImBuf *prerendered[MAXSEQ + 1] = {NULL};
+  begin = seq_estimate_render_cost_begin();
+  const bool use_prerender = seq_render_strip_stack_prerender(
+      context, state, seq_arr, i, count, timeline_frame, prerendered);
+  /* Account the parallel part to the first composite, all following ones depend on it. */
+  float prerender_cost = use_prerender ? seq_estimate_render_cost_end(context->scene, begin) :
+                                         0.0f;
+
   for (; i < count; i++) {
     begin = seq_estimate_render_cost_begin();
     Sequence *seq = seq_arr[i];
 
     if (seq_get_early_out_for_blend_mode(seq) == EARLY_DO_EFFECT) {
       ImBuf *ibuf1 = out;
-      ImBuf *ibuf2 = seq_render_strip(context, state, seq, timeline_frame);
+      ImBuf *ibuf2 = use_prerender ? prerendered[i] :
+                                     seq_render_strip(context, state, seq, timeline_frame);
 
       out = seq_render_strip_stack_apply_effect(context, seq, timeline_frame, ibuf1, ibuf2);
 
@@ -1987,7 +2080,8 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
       IMB_freeImBuf(ibuf2);
     }
 
-    float cost = seq_estimate_render_cost_end(context->scene, begin);
+    float cost = seq_estimate_render_cost_end(context->scene, begin) + prerender_cost;
+    prerender_cost = 0.0f;
     BKE_sequencer_cache_put(
         context, seq_arr[i], timeline_frame, SEQ_CACHE_STORE_COMPOSITE, out, cost, false);
   }
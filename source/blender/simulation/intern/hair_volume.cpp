@@ -24,6 +24,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_texture_types.h"
@@ -53,6 +54,31 @@
 
 static float I[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
 
+template<typename Function>
+static void hair_volume_parallel_range_cb(void *__restrict userdata,
+                                          const int index,
+                                          const TaskParallelTLS *__restrict /*tls*/)
+{
+  (*static_cast<const Function *>(userdata))(index);
+}
+
+/* Run the function for every index in the range, using threads for larger ranges. */
+template<typename Function>
+static void hair_volume_parallel_range(const int start,
+                                       const int stop,
+                                       const int min_iter_per_thread,
+                                       const Function &function)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = min_iter_per_thread;
+  BLI_task_parallel_range(start,
+                          stop,
+                          const_cast<Function *>(&function),
+                          hair_volume_parallel_range_cb<Function>,
+                          &settings);
+}
+
 BLI_INLINE int floor_int(float value)
 {
   return value > 0.0f ? (int)value : ((int)value) - 1;
@@ -686,14 +712,14 @@ void SIM_hair_volume_add_segment(HairGrid *grid,
 
 void SIM_hair_volume_normalize_vertex_grid(HairGrid *grid)
 {
-  int i, size = hair_grid_size(grid->res);
+  const int size = hair_grid_size(grid->res);
   /* divide velocity with density */
-  for (i = 0; i < size; i++) {
+  hair_volume_parallel_range(0, size, 4096, [&](const int i) {
     float density = grid->verts[i].density;
     if (density > 0.0f) {
       mul_v3_fl(grid->verts[i].velocity, 1.0f / density);
     }
-  }
+  });
 }
 
 /* Cells with density below this are considered empty. */
@@ -739,6 +765,8 @@ bool SIM_hair_volume_solve_divergence(HairGrid *grid,
   HairGridVert *vert_start = grid->verts - (stride0 + stride1 + stride2);
   HairGridVert *vert;
   int i, j, k;
+  /* Rows along the z axis are independent, they're processed in parallel. */
+  const int slices_per_thread = 2;
 
 #define MARGIN_i0 (i < 1)
 #define MARGIN_j0 (j < 1)
@@ -758,9 +786,9 @@ bool SIM_hair_volume_solve_divergence(HairGrid *grid,
 
   /* Calculate divergence */
   lVector B(num_cellsA);
-  for (k = 0; k < resA[2]; k++) {
-    for (j = 0; j < resA[1]; j++) {
-      for (i = 0; i < resA[0]; i++) {
+  hair_volume_parallel_range(0, resA[2], slices_per_thread, [&](const int k) {
+    for (int j = 0; j < resA[1]; j++) {
+      for (int i = 0; i < resA[0]; i++) {
         int u = i * strideA0 + j * strideA1 + k * strideA2;
         bool is_margin = MARGIN_i0 || MARGIN_i1 || MARGIN_j0 || MARGIN_j1 || MARGIN_k0 ||
                          MARGIN_k1;
@@ -770,7 +798,7 @@ bool SIM_hair_volume_solve_divergence(HairGrid *grid,
           continue;
         }
 
-        vert = vert_start + i * stride0 + j * stride1 + k * stride2;
+        const HairGridVert *vert = vert_start + i * stride0 + j * stride1 + k * stride2;
 
         const float *v0 = vert->velocity;
         float dx = 0.0f, dy = 0.0f, dz = 0.0f;
@@ -836,7 +864,7 @@ bool SIM_hair_volume_solve_divergence(HairGrid *grid,
 #endif
       }
     }
-  }
+  });
 
   /* Main Poisson equation system:
    * This is derived from the discretezation of the Poisson equation
@@ -919,9 +947,9 @@ bool SIM_hair_volume_solve_divergence(HairGrid *grid,
 
   if (cg.info() == Eigen::Success) {
     /* Calculate velocity = grad(p) */
-    for (k = 0; k < resA[2]; k++) {
-      for (j = 0; j < resA[1]; j++) {
-        for (i = 0; i < resA[0]; i++) {
+    hair_volume_parallel_range(0, resA[2], slices_per_thread, [&](const int k) {
+      for (int j = 0; j < resA[1]; j++) {
+        for (int i = 0; i < resA[0]; i++) {
           int u = i * strideA0 + j * strideA1 + k * strideA2;
           bool is_margin = MARGIN_i0 || MARGIN_i1 || MARGIN_j0 || MARGIN_j1 || MARGIN_k0 ||
                            MARGIN_k1;
@@ -929,7 +957,7 @@ bool SIM_hair_volume_solve_divergence(HairGrid *grid,
             continue;
           }
 
-          vert = vert_start + i * stride0 + j * stride1 + k * stride2;
+          HairGridVert *vert = vert_start + i * stride0 + j * stride1 + k * stride2;
           if (vert->density > density_threshold) {
             float p_left = p[u - strideA0];
             float p_right = p[u + strideA0];
@@ -953,7 +981,7 @@ bool SIM_hair_volume_solve_divergence(HairGrid *grid,
           }
         }
       }
-    }
+    });
 
 #if 0
     {
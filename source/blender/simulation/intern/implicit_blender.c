@@ -34,6 +34,7 @@
 #  include "DNA_texture_types.h"
 
 #  include "BLI_math.h"
+#  include "BLI_task.h"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.h"
@@ -50,6 +51,9 @@
 #    define CLOTH_OPENMP_LIMIT 512
 #  endif
 
+/* Minimum number of vertices to multiply big matrices in parallel. */
+#  define CLOTH_PARALLEL_LIMIT 1024
+
 //#define DEBUG_TIME
 
 #  ifdef DEBUG_TIME
@@ -613,35 +617,114 @@ DO_INLINE void initdiag_bfmatrix(fmatrix3x3 *matrix, float m3[3][3])
   }
 }
 
-/* SPARSE SYMMETRIC multiply big matrix with long vector*/
-/* STATUS: verified */
-DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector *fLongVector)
+/* Blocks of a big matrix grouped per vertex, so the rows can be multiplied in parallel.
+ * All big matrices of a solver share the same blocks. */
+typedef struct BigMatrixRows {
+  /* Blocks in row i (including the diagonal block), in block order. */
+  unsigned int *row_offset, *row_block;
+  /* Lower triangle blocks in column i, multiplied transposed, in block order. */
+  unsigned int *col_offset, *col_block;
+} BigMatrixRows;
+
+static void bigmatrix_rows_init(BigMatrixRows *rows, const fmatrix3x3 *matrix)
 {
-  unsigned int vcount = from[0].vcount;
-  lfVector *temp = create_lfvector(vcount);
+  const unsigned int vcount = matrix[0].vcount;
+  const unsigned int tot = vcount + matrix[0].scount;
+  unsigned int *row_fill = MEM_mallocN(sizeof(*row_fill) * vcount, __func__);
+  unsigned int *col_fill = MEM_mallocN(sizeof(*col_fill) * vcount, __func__);
+  unsigned int i;
 
-  zero_lfvector(to, vcount);
+  rows->row_offset = MEM_callocN(sizeof(*rows->row_offset) * (vcount + 1), __func__);
+  rows->col_offset = MEM_callocN(sizeof(*rows->col_offset) * (vcount + 1), __func__);
+  rows->row_block = MEM_mallocN(sizeof(*rows->row_block) * tot, __func__);
+  rows->col_block = MEM_mallocN(sizeof(*rows->col_block) * max_ii(matrix[0].scount, 1),
+                                __func__);
 
-#  pragma omp parallel sections if (vcount > CLOTH_OPENMP_LIMIT)
-  {
-#  pragma omp section
-    {
-      for (unsigned int i = from[0].vcount; i < from[0].vcount + from[0].scount; i++) {
-        /* This is the lower triangle of the sparse matrix,
-         * therefore multiplication occurs with transposed submatrices. */
-        muladd_fmatrixT_fvector(to[from[i].c], from[i].m, fLongVector[from[i].r]);
-      }
+  for (i = 0; i < tot; i++) {
+    rows->row_offset[matrix[i].r + 1]++;
+    if (i >= vcount) {
+      rows->col_offset[matrix[i].c + 1]++;
     }
-#  pragma omp section
-    {
-      for (unsigned int i = 0; i < from[0].vcount + from[0].scount; i++) {
-        muladd_fmatrix_fvector(temp[from[i].r], from[i].m, fLongVector[from[i].c]);
-      }
+  }
+  for (i = 0; i < vcount; i++) {
+    rows->row_offset[i + 1] += rows->row_offset[i];
+    rows->col_offset[i + 1] += rows->col_offset[i];
+  }
+
+  memcpy(row_fill, rows->row_offset, sizeof(*row_fill) * vcount);
+  memcpy(col_fill, rows->col_offset, sizeof(*col_fill) * vcount);
+  for (i = 0; i < tot; i++) {
+    rows->row_block[row_fill[matrix[i].r]++] = i;
+    if (i >= vcount) {
+      rows->col_block[col_fill[matrix[i].c]++] = i;
     }
   }
-  add_lfvector_lfvector(to, to, temp, from[0].vcount);
 
-  del_lfvector(temp);
+  MEM_freeN(row_fill);
+  MEM_freeN(col_fill);
+}
+
+static void bigmatrix_rows_free(BigMatrixRows *rows)
+{
+  MEM_freeN(rows->row_offset);
+  MEM_freeN(rows->row_block);
+  MEM_freeN(rows->col_offset);
+  MEM_freeN(rows->col_block);
+}
+
+typedef struct MulBigMatrixData {
+  float (*to)[3];
+  const fmatrix3x3 *from;
+  const BigMatrixRows *rows;
+  const lfVector *fLongVector;
+} MulBigMatrixData;
+
+static void mul_bfmatrix_lfvector_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const MulBigMatrixData *data = userdata;
+  const fmatrix3x3 *from = data->from;
+  const BigMatrixRows *rows = data->rows;
+  const lfVector *fLongVector = data->fLongVector;
+  float lower[3] = {0.0f, 0.0f, 0.0f};
+  float upper[3] = {0.0f, 0.0f, 0.0f};
+  unsigned int j;
+
+  /* Sum in the same order as when accumulating over all blocks. */
+  for (j = rows->col_offset[i]; j < rows->col_offset[i + 1]; j++) {
+    const fmatrix3x3 *block = &from[rows->col_block[j]];
+    /* This is the lower triangle of the sparse matrix,
+     * therefore multiplication occurs with transposed submatrices. */
+    muladd_fmatrixT_fvector(lower, block->m, fLongVector[block->r]);
+  }
+  for (j = rows->row_offset[i]; j < rows->row_offset[i + 1]; j++) {
+    const fmatrix3x3 *block = &from[rows->row_block[j]];
+    muladd_fmatrix_fvector(upper, block->m, fLongVector[block->c]);
+  }
+
+  add_v3_v3v3(data->to[i], lower, upper);
+}
+
+/* SPARSE SYMMETRIC multiply big matrix with long vector*/
+/* STATUS: verified */
+DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3],
+                                     fmatrix3x3 *from,
+                                     const BigMatrixRows *rows,
+                                     lfVector *fLongVector)
+{
+  MulBigMatrixData data = {
+      .to = to,
+      .from = from,
+      .rows = rows,
+      .fLongVector = fLongVector,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (from[0].vcount > CLOTH_PARALLEL_LIMIT);
+  settings.min_iter_per_thread = CLOTH_PARALLEL_LIMIT;
+  BLI_task_parallel_range(0, from[0].vcount, &data, mul_bfmatrix_lfvector_cb, &settings);
 }
 
 /* SPARSE SYMMETRIC sub big matrix with big matrix*/
@@ -850,8 +933,35 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 }
 #  endif
 
+/* Jacobi pre-conditioner, the inverse of the diagonal of the matrix. */
+static void cg_precondition_jacobi_init(lfVector *Pinv, fmatrix3x3 *lA)
+{
+  unsigned int i, k;
+
+  for (i = 0; i < lA[0].vcount; i++) {
+    for (k = 0; k < 3; k++) {
+      const float diag = lA[i].m[k][k];
+      /* The diagonal should always be positive, skip rows where it isn't. */
+      Pinv[i][k] = (diag > FLT_EPSILON) ? 1.0f / diag : 1.0f;
+    }
+  }
+}
+
+DO_INLINE void cg_precondition_apply(lfVector *to,
+                                     lfVector *Pinv,
+                                     lfVector *from,
+                                     unsigned int verts)
+{
+  unsigned int i;
+
+  for (i = 0; i < verts; i++) {
+    mul_v3_v3v3(to[i], Pinv[i], from[i]);
+  }
+}
+
 static int cg_filtered(lfVector *ldV,
                        fmatrix3x3 *lA,
+                       const BigMatrixRows *rows,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
@@ -868,23 +978,27 @@ static int cg_filtered(lfVector *ldV,
   lfVector *c = create_lfvector(numverts);
   lfVector *q = create_lfvector(numverts);
   lfVector *s = create_lfvector(numverts);
+  lfVector *Pinv = create_lfvector(numverts);
   float bnorm2, delta_new, delta_old, delta_target, alpha;
 
+  cg_precondition_jacobi_init(Pinv, lA);
+
   cp_lfvector(ldV, z, numverts);
 
   /* d0 = filter(B)^T * P * filter(B) */
   cp_lfvector(fB, lB, numverts);
   filter(fB, S);
-  bnorm2 = dot_lfvector(fB, fB, numverts);
+  cg_precondition_apply(s, Pinv, fB, numverts);
+  bnorm2 = dot_lfvector(fB, s, numverts);
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_lfvector(AdV, lA, rows, ldV);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
   /* c = filter(P^-1 * r) */
-  cp_lfvector(c, r, numverts);
+  cg_precondition_apply(c, Pinv, r, numverts);
   filter(c, S);
 
   /* delta = r^T * c */
@@ -902,7 +1016,7 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+    mul_bfmatrix_lfvector(q, lA, rows, c);
     filter(q, S);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
@@ -912,7 +1026,7 @@ static int cg_filtered(lfVector *ldV,
     add_lfvector_lfvectorS(r, r, q, -alpha, numverts);
 
     /* s = P^-1 * r */
-    cp_lfvector(s, r, numverts);
+    cg_precondition_apply(s, Pinv, r, numverts);
     delta_old = delta_new;
     delta_new = dot_lfvector(r, s, numverts);
 
@@ -934,6 +1048,7 @@ static int cg_filtered(lfVector *ldV,
   del_lfvector(c);
   del_lfvector(q);
   del_lfvector(s);
+  del_lfvector(Pinv);
   // printf("W/O conjgrad_loopcount: %d\n", conjgrad_loopcount);
 
   result->status = conjgrad_loopcount < conjgrad_looplimit ? SIM_SOLVER_SUCCESS :
@@ -1162,7 +1277,10 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  BigMatrixRows rows;
+  bigmatrix_rows_init(&rows, data->A);
+
+  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, &rows, data->V);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1171,7 +1289,7 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(data->dV, data->A, &rows, data->B, data->z, data->S, result);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
@@ -1183,6 +1301,7 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
   /* advance velocities */
   add_lfvector_lfvector(data->Vnew, data->V, data->dV, numverts);
 
+  bigmatrix_rows_free(&rows);
   del_lfvector(dFdXmV);
 
   return result->status == SIM_SOLVER_SUCCESS;
@@ -38,6 +38,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_ghash.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -199,6 +200,7 @@ static void window_manager_blend_read_data(BlendDataReader *reader, ID *id)
   BLI_listbase_clear(&wm->operators);
   BLI_listbase_clear(&wm->paintcursors);
   BLI_listbase_clear(&wm->queue);
+  wm->notifier_queue_set = NULL;
   BKE_reports_init(&wm->reports, RPT_STORE);
 
   BLI_listbase_clear(&wm->keyconfigs);
@@ -588,6 +590,10 @@ void wm_close_and_free(bContext *C, wmWindowManager *wm)
   }
 
   BLI_freelistN(&wm->queue);
+  if (wm->notifier_queue_set) {
+    BLI_gset_free(wm->notifier_queue_set, NULL);
+    wm->notifier_queue_set = NULL;
+  }
 
   if (wm->message_bus != NULL) {
     WM_msgbus_destroy(wm->message_bus);
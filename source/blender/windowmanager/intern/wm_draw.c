@@ -1042,6 +1042,7 @@ void wm_draw_update(bContext *C)
 {
   Main *bmain = CTX_data_main(C);
   wmWindowManager *wm = CTX_wm_manager(C);
+  bool has_drawn = false;
 
   GPU_context_main_lock();
   BKE_image_free_unused_gpu_textures();
@@ -1074,6 +1075,7 @@ void wm_draw_update(bContext *C)
       wm_draw_update_clear_window(C, win);
 
       wm_window_swap_buffers(win);
+      has_drawn = true;
     }
   }
 
@@ -1083,6 +1085,8 @@ void wm_draw_update(bContext *C)
   wm_surfaces_iter(C, wm_draw_surface);
 
   GPU_context_main_unlock();
+
+  wm_event_latency_end(has_drawn);
 }
 
 void wm_draw_region_clear(wmWindow *win, ARegion *UNUSED(region))
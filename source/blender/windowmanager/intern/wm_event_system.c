@@ -43,6 +43,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_dynstr.h"
+#include "BLI_ghash.h"
 #include "BLI_math.h"
 #include "BLI_timer.h"
 #include "BLI_utildefines.h"
@@ -207,36 +208,69 @@ void wm_event_init_from_window(wmWindow *win, wmEvent *event)
 /** \name Notifiers & Listeners
  * \{ */
 
-static bool wm_test_duplicate_notifier(const wmWindowManager *wm, uint type, void *reference)
+/* Notifiers are unique by their type and reference, the window is not taken into account. */
+static uint note_hash_for_queue_fn(const void *ptr)
 {
-  LISTBASE_FOREACH (wmNotifier *, note, &wm->queue) {
-    if ((note->category | note->data | note->subtype | note->action) == type &&
-        note->reference == reference) {
-      return 1;
-    }
-  }
+  const wmNotifier *note = ptr;
+  return (BLI_ghashutil_ptrhash(note->reference) ^
+          (note->category | note->data | note->subtype | note->action));
+}
 
-  return 0;
+static bool note_cmp_for_queue_fn(const void *a, const void *b)
+{
+  const wmNotifier *note_a = a;
+  const wmNotifier *note_b = b;
+  return !(((note_a->category | note_a->data | note_a->subtype | note_a->action) ==
+            (note_b->category | note_b->data | note_b->subtype | note_b->action)) &&
+           (note_a->reference == note_b->reference));
 }
 
-void WM_event_add_notifier_ex(wmWindowManager *wm, const wmWindow *win, uint type, void *reference)
+/**
+ * Add a notifier to the queue unless an identical one is already queued. Scripts that change
+ * many properties add thousands of notifiers before they are handled, so duplicates are found
+ * through a set instead of walking the queue.
+ */
+static wmNotifier *wm_notifier_add_unique(wmWindowManager *wm, uint type, void *reference)
 {
-  if (wm_test_duplicate_notifier(wm, type, reference)) {
-    return;
-  }
+  wmNotifier note_test = {NULL};
 
-  wmNotifier *note = MEM_callocN(sizeof(wmNotifier), "notifier");
+  note_test.category = type & NOTE_CATEGORY;
+  note_test.data = type & NOTE_DATA;
+  note_test.subtype = type & NOTE_SUBTYPE;
+  note_test.action = type & NOTE_ACTION;
+  note_test.reference = reference;
 
+  if (wm->notifier_queue_set == NULL) {
+    wm->notifier_queue_set = BLI_gset_new_ex(
+        note_hash_for_queue_fn, note_cmp_for_queue_fn, __func__, 1024);
+  }
+  else if (BLI_gset_haskey(wm->notifier_queue_set, &note_test)) {
+    return NULL;
+  }
+
+  wmNotifier *note = MEM_mallocN(sizeof(wmNotifier), "notifier");
+  *note = note_test;
   BLI_addtail(&wm->queue, note);
+  BLI_gset_insert(wm->notifier_queue_set, note);
+
+  return note;
+}
 
-  note->window = win;
+/* Remove the notifier from the duplicate check, it may already have been cleared. */
+static void wm_notifier_queue_set_remove(wmWindowManager *wm, wmNotifier *note)
+{
+  if (wm->notifier_queue_set && BLI_gset_lookup(wm->notifier_queue_set, note) == note) {
+    BLI_gset_remove(wm->notifier_queue_set, note, NULL);
+  }
+}
 
-  note->category = type & NOTE_CATEGORY;
-  note->data = type & NOTE_DATA;
-  note->subtype = type & NOTE_SUBTYPE;
-  note->action = type & NOTE_ACTION;
+void WM_event_add_notifier_ex(wmWindowManager *wm, const wmWindow *win, uint type, void *reference)
+{
+  wmNotifier *note = wm_notifier_add_unique(wm, type, reference);
 
-  note->reference = reference;
+  if (note) {
+    note->window = win;
+  }
 }
 
 /* XXX: in future, which notifiers to send to other windows? */
@@ -250,20 +284,11 @@ void WM_main_add_notifier(unsigned int type, void *reference)
   Main *bmain = G_MAIN;
   wmWindowManager *wm = bmain->wm.first;
 
-  if (!wm || wm_test_duplicate_notifier(wm, type, reference)) {
+  if (!wm) {
     return;
   }
 
-  wmNotifier *note = MEM_callocN(sizeof(wmNotifier), "notifier");
-
-  BLI_addtail(&wm->queue, note);
-
-  note->category = type & NOTE_CATEGORY;
-  note->data = type & NOTE_DATA;
-  note->subtype = type & NOTE_SUBTYPE;
-  note->action = type & NOTE_ACTION;
-
-  note->reference = reference;
+  wm_notifier_add_unique(wm, type, reference);
 }
 
 /**
@@ -279,6 +304,7 @@ void WM_main_remove_notifier_reference(const void *reference)
       if (note->reference == reference) {
         /* Don't remove because this causes problems for #wm_event_do_notifiers
          * which may be looping on the data (deleting screens). */
+        wm_notifier_queue_set_remove(wm, note);
         wm_notifier_clear(note);
       }
     }
@@ -511,6 +537,8 @@ void wm_event_do_notifiers(bContext *C)
   /* The notifiers are sent without context, to keep it clean. */
   wmNotifier *note;
   while ((note = BLI_pophead(&wm->queue))) {
+    wm_notifier_queue_set_remove(wm, note);
+
     LISTBASE_FOREACH (wmWindow *, win, &wm->windows) {
       Scene *scene = WM_window_get_active_scene(win);
       bScreen *screen = WM_window_get_active_screen(win);
@@ -4334,6 +4362,56 @@ static wmEvent *wm_event_add_trackpad(wmWindow *win, const wmEvent *event, int d
   return event_new;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Event Latency
+ *
+ * Time from the first event added in a main loop iteration until the windows are redrawn,
+ * logged with `--log "wm.event" --log-level 2`.
+ * \{ */
+
+static struct {
+  /* Time the first event of this main loop iteration was added, zero when there is none. */
+  double time_event;
+  double latency_avg;
+  double latency_max;
+} wm_event_latency = {0.0};
+
+static void wm_event_latency_begin(void)
+{
+  if (wm_event_latency.time_event == 0.0) {
+    wm_event_latency.time_event = PIL_check_seconds_timer();
+  }
+}
+
+/**
+ * Called after drawing, \a has_drawn is false when the events didn't cause any redraw.
+ */
+void wm_event_latency_end(bool has_drawn)
+{
+  if (wm_event_latency.time_event == 0.0) {
+    return;
+  }
+
+  if (has_drawn) {
+    const double latency = PIL_check_seconds_timer() - wm_event_latency.time_event;
+    wm_event_latency.latency_avg = (wm_event_latency.latency_avg == 0.0) ?
+                                       latency :
+                                       (0.9 * wm_event_latency.latency_avg) + (0.1 * latency);
+    wm_event_latency.latency_max = max_dd(wm_event_latency.latency_max, latency);
+
+    CLOG_INFO(WM_LOG_EVENTS,
+              2,
+              "input to draw latency %.2f ms (average %.2f ms, max %.2f ms)",
+              latency * 1000.0,
+              wm_event_latency.latency_avg * 1000.0,
+              wm_event_latency.latency_max * 1000.0);
+  }
+
+  wm_event_latency.time_event = 0.0;
+}
+
+/** \} */
+
 /* Windows store own event queues, no bContext here. */
 /* Time is in 1000s of seconds, from Ghost. */
 void wm_event_add_ghostevent(wmWindowManager *wm, wmWindow *win, int type, void *customdata)
@@ -4352,6 +4430,8 @@ void wm_event_add_ghostevent(wmWindowManager *wm, wmWindow *win, int type, void
    *   but is handled with the next event -> execution delay.
    * - Data added to event and \a evt stays and is handled immediately.
    */
+  wm_event_latency_begin();
+
   wmEvent event, *evt = win->eventstate;
 
   /* Initialize and copy state (only mouse x y and modifiers). */
@@ -117,7 +117,6 @@
 #include "UI_interface.h"
 #include "UI_interface_icons.h"
 #include "UI_resources.h"
-#include "UI_view2d.h"
 
 /* only to report a missing engine */
 #include "RE_engine.h"
@@ -556,10 +555,6 @@ static void wm_file_read_pre(bContext *C, bool use_data, bool UNUSED(use_userdef
     BKE_callback_exec_null(CTX_data_main(C), BKE_CB_EVT_LOAD_PRE);
     BLI_timer_on_file_load();
   }
-
-  /* Always do this as both startup and preferences may have loaded in many font's
-   * at a different zoom level to the file being loaded. */
-  UI_view2d_zoom_cache_reset();
 }
 
 /**
@@ -730,7 +725,8 @@ bool WM_file_read(bContext *C, const char *filepath, ReportList *reports)
          * Further it's just confusing if a user loads a file and various preferences change. */
         &(const struct BlendFileReadParams){
             .is_startup = false,
-            .skip_flags = BLO_READ_SKIP_USERDEF,
+            .skip_flags = BLO_READ_SKIP_USERDEF |
+                          ((G.fileflags & G_FILE_NO_UI) ? BLO_READ_SKIP_UI : 0),
         },
         reports);
 
@@ -43,6 +43,7 @@
 
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
+#include "BLI_profile.h"
 #include "BLI_string.h"
 #include "BLI_task.h"
 #include "BLI_threads.h"
@@ -283,9 +284,11 @@ void WM_init(bContext *C, int argc, const char **argv)
   const bool use_data = true;
   const bool use_userdef = true;
 
-  /* Studio-lights needs to be init before we read the home-file,
-   * otherwise the versioning cannot find the default studio-light. */
-  BKE_studiolight_init();
+  /* Studio-lights are initialized on first use, which includes the versioning of the home-file.
+   * The interface always needs them, background mode only does when rendering with them. */
+  if (!G.background) {
+    BKE_studiolight_init();
+  }
 
   BLI_assert((G.fileflags & G_FILE_NO_UI) == 0);
 
@@ -649,6 +652,9 @@ void WM_exit_ex(bContext *C, const bool do_python)
 
   DNA_sdna_current_free();
 
+  /* Write the trace (when requested) before threads exit, no more zones are recorded. */
+  BLI_profile_exit();
+
   BLI_threadapi_exit();
   BLI_task_scheduler_exit();
 
@@ -1392,8 +1392,6 @@ static int ghost_event_proc(GHOST_EventHandle evt, GHOST_TUserDataPtr C_void_ptr
 
       case GHOST_kEventWindowDPIHintChanged: {
         WM_window_set_dpi(win);
-        /* font's are stored at each DPI level, without this we can easy load 100's of fonts */
-        BLF_cache_clear();
 
         WM_main_add_notifier(NC_WINDOW, NULL);             /* full redraw */
         WM_main_add_notifier(NC_SCREEN | NA_EDITED, NULL); /* refresh region sizes */
@@ -37,6 +37,7 @@
 #  include "BLI_listbase.h"
 #  include "BLI_mempool.h"
 #  include "BLI_path_util.h"
+#  include "BLI_profile.h"
 #  include "BLI_string.h"
 #  include "BLI_string_utf8.h"
 #  include "BLI_system.h"
@@ -597,6 +598,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
 #  endif
   BLI_args_print_arg_doc(ba, "--debug-all");
   BLI_args_print_arg_doc(ba, "--debug-io");
+  BLI_args_print_arg_doc(ba, "--profile");
 
   printf("\n");
   BLI_args_print_arg_doc(ba, "--debug-fpe");
@@ -1091,6 +1093,21 @@ static int arg_handle_debug_fpe_set(int UNUSED(argc),
   return 0;
 }
 
+static const char arg_handle_profile_set_doc[] =
+    "<filename>\n"
+    "\tRecord a timeline of depsgraph evaluation, modifiers, drawing and render sync,\n"
+    "\twritten on exit as a Chrome trace (for 'chrome://tracing' or Perfetto).";
+static int arg_handle_profile_set(int argc, const char **argv, void *UNUSED(data))
+{
+  const char *arg_id = "--profile";
+  if (argc > 1) {
+    BLI_profile_output_set(argv[1]);
+    return 1;
+  }
+  printf("\nError: '%s' no args given.\n", arg_id);
+  return 0;
+}
+
 static const char arg_handle_app_template_doc[] =
     "<template>\n"
     "\tSet the application template (matching the directory name), use 'default' for none.";
@@ -2102,6 +2119,7 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_add(ba, NULL, "--debug-io", CB(arg_handle_debug_mode_io), NULL);
 
   BLI_args_add(ba, NULL, "--debug-fpe", CB(arg_handle_debug_fpe_set), NULL);
+  BLI_args_add(ba, NULL, "--profile", CB(arg_handle_profile_set), NULL);
 
 #  ifdef WITH_LIBMV
   BLI_args_add(ba, NULL, "--debug-libmv", CB(arg_handle_debug_mode_libmv), NULL);